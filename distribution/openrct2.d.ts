@@ -183,12 +183,21 @@ declare global {
          */
         sharedStorage: Configuration;
 
+        /**
+         * The number of bytes currently used by each of the larger subsystems, e.g. tileElements,
+         * entities, imageTables or scriptHeap, and their total.
+         */
+        readonly memoryStats: { [subsystem: string]: number };
+
         /**
          * Render the current state of the map and save to disc.
          * Useful for server administration and timelapse creation.
          * @param options Options that control the capture and output file.
+         * @param callback If set, the image is compressed and written in the background and the
+         * callback is called once that is done, with an error message if it failed. Otherwise the
+         * capture completes before this function returns.
          */
-        captureImage(options: CaptureOptions): void;
+        captureImage(options: CaptureOptions, callback?: (error?: string) => void): void;
 
         /**
          * Gets the loaded object at the given index.
@@ -257,8 +266,12 @@ declare global {
          */
         subscribe(hook: HookType, callback: Function): IDisposable;
 
-        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void): IDisposable;
-        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void): IDisposable;
+        /**
+         * Subscribes to action queries or executions. If options.actions is given, the callback is
+         * only called for those actions and the event arguments are not built for any other action.
+         */
+        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void, options?: ActionHookOptions): IDisposable;
+        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void, options?: ActionHookOptions): IDisposable;
         subscribe(hook: "interval.tick", callback: () => void): IDisposable;
         subscribe(hook: "interval.day", callback: () => void): IDisposable;
         subscribe(hook: "network.chat", callback: (e: NetworkChatEventArgs) => void): IDisposable;
@@ -297,6 +310,44 @@ declare global {
          * @param handle The numerical handle of the registered timeout to remove.
          */
         clearTimeout(handle: number): void;
+
+        /**
+         * Runs the given script in a separate context on a background thread. The worker
+         * has no access to the game or the plugin API, it can only exchange messages with
+         * the plugin. Inside the worker, `postMessage(value)` sends a message back and a
+         * global `onmessage(value)` function receives messages from the plugin.
+         * Messages are copied as JSON, values JSON can not represent are not preserved.
+         * @param code The source code of the worker script.
+         */
+        createWorker(code: string): Worker;
+    }
+
+    /**
+     * A script running in its own context on a background thread, see `context.createWorker`.
+     */
+    interface Worker {
+        /**
+         * Called with each message the worker has posted, delivered during the game tick.
+         */
+        onmessage: ((message: any) => void) | undefined;
+
+        /**
+         * Called with the error message when the worker script throws. If not set, errors
+         * are written to the console.
+         */
+        onerror: ((message: string) => void) | undefined;
+
+        /**
+         * Sends a copy of the value to the worker's `onmessage` function.
+         */
+        postMessage(message: any): void;
+
+        /**
+         * Stops delivering messages to and from the worker and releases its context once
+         * the current message has been handled. A script that never returns keeps its thread
+         * until the game is closed.
+         */
+        terminate(): void;
     }
 
     interface Configuration {
@@ -466,6 +517,13 @@ declare global {
         "waterraise" |
         "watersetheight";
 
+    interface ActionHookOptions {
+        /**
+         * The names of the actions to be called for, custom actions use the name they were registered with.
+         */
+        actions?: (ActionType | string)[];
+    }
+
     interface GameActionEventArgs {
         readonly player: number;
         readonly type: number;
@@ -571,6 +629,19 @@ declare global {
 
         getRide(id: number): Ride;
         getTile(x: number, y: number): Tile;
+        /**
+         * Reads the given fields of every tile in a range in one call, much faster than going
+         * through getTile for large areas. The range is in game coordinates and is clamped to the
+         * map. Each field is returned as an Int32Array of width * height values in row order,
+         * the tile at (x, y) is at index (y - top) * width + (x - left).
+         * surfaceHeight and waterHeight are in game coordinates. elementTypes is a bit mask of the
+         * element types on the tile: surface 1, footpath 2, track 4, small_scenery 8, entrance 16,
+         * wall 32, large_scenery 64 and banner 128.
+         * @param range The range of tiles to read, inclusive.
+         * @param fields The names of the fields to read.
+         */
+        getTileData<T extends TileDataFieldName>(range: MapRange, fields: T[]):
+            { width: number, height: number } & { [K in T]: Int32Array };
         getEntity(id: number): Entity;
         getAllEntities(type: EntityType): Entity[];
         /**
@@ -581,9 +652,24 @@ declare global {
         getAllEntities(type: "staff"): Staff[];
         getAllEntities(type: "car"): Car[];
         getAllEntities(type: "litter"): Litter[];
+        /**
+         * Reads the given fields of all entities of a type in one call, much faster than going
+         * through getAllEntities for large numbers of entities. Each field is returned as an
+         * Int32Array where index i belongs to the same entity for every field, entities are in
+         * the same order as getAllEntities would return them.
+         * The peep fields energy and state can only be requested for "peep", "guest" or "staff",
+         * the guest fields happiness and cash only for "guest". State is the internal numeric state.
+         * @param type The type of entities to read.
+         * @param fields The names of the fields to read.
+         */
+        getEntityFields<T extends EntityFieldName>(type: EntityType, fields: T[]): { [K in T]: Int32Array };
         createEntity(type: EntityType, initializer: object): Entity;
     }
 
+    type TileDataFieldName = "surfaceHeight" | "waterHeight" | "ownership" | "elementTypes" | "hasPath";
+
+    type EntityFieldName = "id" | "x" | "y" | "z" | "happiness" | "energy" | "cash" | "state";
+
     type TileElementType =
         "surface" | "footpath" | "track" | "small_scenery" | "wall" | "entrance" | "large_scenery" | "banner";
 
@@ -1676,6 +1762,7 @@ declare global {
         "forbidMarketingCampaigns" |
         "forbidTreeRemoval" |
         "freeParkEntry" |
+        "guestFlowFieldNavigation" |
         "noMoney" |
         "open" |
         "preferLessIntenseRides" |
@@ -2490,7 +2577,7 @@ declare global {
         destroy(error: object): Socket;
         setNoDelay(noDelay: boolean): Socket;
         end(data?: string): Socket;
-        write(data: string): boolean;
+        write(data: string | Uint8Array): boolean;
 
         on(event: "close", callback: (hadError: boolean) => void): Socket;
         on(event: "error", callback: (hadError: boolean) => void): Socket;
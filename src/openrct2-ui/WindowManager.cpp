@@ -19,6 +19,7 @@
 #include <openrct2/config/Config.h>
 #include <openrct2/core/Console.hpp>
 #include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Peep.h>
 #include <openrct2/interface/Viewport.h>
 #include <openrct2/localisation/Formatter.h>
 #include <openrct2/rct2/T6Exporter.h>
@@ -55,6 +56,8 @@ public:
                 return CustomCurrencyWindowOpen();
             case WC_DEBUG_PAINT:
                 return WindowDebugPaintOpen();
+            case WC_PERFORMANCE:
+                return WindowPerformanceOpen();
             case WC_EDITOR_INVENTION_LIST:
                 return WindowEditorInventionsListOpen();
             case WC_EDITOR_OBJECT_SELECTION:
@@ -382,6 +385,13 @@ public:
                 WindowGuestListRefreshList();
                 break;
 
+            case INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY:
+            {
+                auto peep = static_cast<Peep*>(intent.GetPointerExtra(INTENT_EXTRA_PEEP));
+                WindowGuestListUpdateGuest(peep->sprite_index);
+                break;
+            }
+
             case INTENT_ACTION_REFRESH_STAFF_LIST:
             {
                 WindowStaffListRefresh();
@@ -435,7 +445,6 @@ public:
                 gToolbarDirtyFlags |= BTM_TB_DIRTY_FLAG_PEEP_COUNT;
                 window_invalidate_by_class(WC_GUEST_LIST);
                 window_invalidate_by_class(WC_PARK_INFORMATION);
-                WindowGuestListRefreshList();
                 break;
 
             case INTENT_ACTION_UPDATE_PARK_RATING:
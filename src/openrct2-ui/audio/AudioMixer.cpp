@@ -22,6 +22,7 @@
 #include <openrct2/audio/audio.h>
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/core/SpscRing.h>
 #include <speex/speex_resampler.h>
 #include <vector>
 
@@ -48,6 +49,23 @@ namespace OpenRCT2::Audio
         std::vector<uint8_t> _convertBuffer;
         std::vector<uint8_t> _effectBuffer;
 
+        struct ChannelCommand
+        {
+            enum class Type : uint8_t
+            {
+                Volume,
+                Pan,
+                Rate,
+            };
+
+            IAudioChannel* Channel;
+            Type CommandType;
+            double Value;
+        };
+
+        // Channel parameter updates from the game thread, applied by the audio callback.
+        SpscRing<ChannelCommand, 1024> _commands;
+
     public:
         AudioMixerImpl()
         {
@@ -90,6 +108,11 @@ namespace OpenRCT2::Audio
         {
             // Free channels
             Lock();
+            // Commands still queued refer to the channels about to be freed.
+            ChannelCommand command;
+            while (_commands.TryPop(command))
+            {
+            }
             for (IAudioChannel* channel : _channels)
             {
                 delete channel;
@@ -182,6 +205,21 @@ namespace OpenRCT2::Audio
             _volume = volume;
         }
 
+        void SetChannelVolume(IAudioChannel* channel, int32_t volume) override
+        {
+            PushCommand({ channel, ChannelCommand::Type::Volume, static_cast<double>(volume) });
+        }
+
+        void SetChannelPan(IAudioChannel* channel, float pan) override
+        {
+            PushCommand({ channel, ChannelCommand::Type::Pan, pan });
+        }
+
+        void SetChannelRate(IAudioChannel* channel, double rate) override
+        {
+            PushCommand({ channel, ChannelCommand::Type::Rate, rate });
+        }
+
         IAudioSource* GetSoundSource(SoundId id) override
         {
             return _css1Sources[static_cast<uint32_t>(id)];
@@ -207,8 +245,48 @@ namespace OpenRCT2::Audio
             }
         }
 
+        void PushCommand(const ChannelCommand& command)
+        {
+            if (!_commands.TryPush(command))
+            {
+                // The audio thread has fallen behind, apply the backlog and this command under the device lock instead.
+                Lock();
+                ProcessCommands();
+                ApplyCommand(command);
+                Unlock();
+            }
+        }
+
+        static void ApplyCommand(const ChannelCommand& command)
+        {
+            switch (command.CommandType)
+            {
+                case ChannelCommand::Type::Volume:
+                    command.Channel->SetVolume(static_cast<int32_t>(command.Value));
+                    break;
+                case ChannelCommand::Type::Pan:
+                    command.Channel->SetPan(static_cast<float>(command.Value));
+                    break;
+                case ChannelCommand::Type::Rate:
+                    command.Channel->SetRate(command.Value);
+                    break;
+            }
+        }
+
+        // Only called with the device locked, which makes this the single consumer of the ring.
+        void ProcessCommands()
+        {
+            ChannelCommand command;
+            while (_commands.TryPop(command))
+            {
+                ApplyCommand(command);
+            }
+        }
+
         void GetNextAudioChunk(uint8_t* dst, size_t length)
         {
+            // Apply queued updates before any channel can be freed below.
+            ProcessCommands();
             UpdateAdjustedSound();
 
             // Zero the output buffer
@@ -429,35 +507,37 @@ namespace OpenRCT2::Audio
             return mixVolume;
         }
 
+        // The effect loops below compute the gain from the sample index rather than accumulating it, so there is no
+        // dependency between iterations and the compiler can vectorise them.
+
         static void EffectPanS16(const IAudioChannel* channel, int16_t* data, int32_t length)
         {
             const float dt = 1.0f / static_cast<float>(length * 2.0f);
-            float volumeL = channel->GetOldVolumeL();
-            float volumeR = channel->GetOldVolumeR();
+            const float volumeL = channel->GetOldVolumeL();
+            const float volumeR = channel->GetOldVolumeR();
             const float d_left = dt * (channel->GetVolumeL() - channel->GetOldVolumeL());
             const float d_right = dt * (channel->GetVolumeR() - channel->GetOldVolumeR());
 
-            for (int32_t i = 0; i < length * 2; i += 2)
+            for (int32_t i = 0; i < length; i++)
             {
-                data[i + 0] = static_cast<int16_t>(volumeL * static_cast<float>(data[i + 0]));
-                data[i + 1] = static_cast<int16_t>(volumeR * static_cast<float>(data[i + 1]));
-                volumeL += d_left;
-                volumeR += d_right;
+                const auto t = static_cast<float>(i);
+                data[i * 2 + 0] = static_cast<int16_t>((volumeL + t * d_left) * static_cast<float>(data[i * 2 + 0]));
+                data[i * 2 + 1] = static_cast<int16_t>((volumeR + t * d_right) * static_cast<float>(data[i * 2 + 1]));
             }
         }
 
         static void EffectPanU8(const IAudioChannel* channel, uint8_t* data, int32_t length)
         {
-            float volumeL = channel->GetVolumeL();
-            float volumeR = channel->GetVolumeR();
-            float oldVolumeL = channel->GetOldVolumeL();
-            float oldVolumeR = channel->GetOldVolumeR();
+            const float oldVolumeL = channel->GetOldVolumeL();
+            const float oldVolumeR = channel->GetOldVolumeR();
+            const float d_left = (channel->GetVolumeL() - oldVolumeL) / static_cast<float>(length);
+            const float d_right = (channel->GetVolumeR() - oldVolumeR) / static_cast<float>(length);
 
-            for (int32_t i = 0; i < length * 2; i += 2)
+            for (int32_t i = 0; i < length; i++)
             {
-                float t = static_cast<float>(i) / static_cast<float>(length * 2.0f);
-                data[i] = static_cast<uint8_t>(data[i] * ((1.0 - t) * oldVolumeL + t * volumeL));
-                data[i + 1] = static_cast<uint8_t>(data[i + 1] * ((1.0 - t) * oldVolumeR + t * volumeR));
+                const auto t = static_cast<float>(i);
+                data[i * 2 + 0] = static_cast<uint8_t>(data[i * 2 + 0] * (oldVolumeL + t * d_left));
+                data[i * 2 + 1] = static_cast<uint8_t>(data[i * 2 + 1] * (oldVolumeR + t * d_right));
             }
         }
 
@@ -465,12 +545,11 @@ namespace OpenRCT2::Audio
         {
             static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
 
-            float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-            float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
+            const float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
+            const float step = (static_cast<float>(endvolume - startvolume) / SDL_MIX_MAXVOLUME) / length;
             for (int32_t i = 0; i < length; i++)
             {
-                float t = static_cast<float>(i) / length;
-                data[i] = static_cast<int16_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+                data[i] = static_cast<int16_t>(data[i] * (startvolume_f + static_cast<float>(i) * step));
             }
         }
 
@@ -478,12 +557,11 @@ namespace OpenRCT2::Audio
         {
             static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
 
-            float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
-            float endvolume_f = static_cast<float>(endvolume) / SDL_MIX_MAXVOLUME;
+            const float startvolume_f = static_cast<float>(startvolume) / SDL_MIX_MAXVOLUME;
+            const float step = (static_cast<float>(endvolume - startvolume) / SDL_MIX_MAXVOLUME) / length;
             for (int32_t i = 0; i < length; i++)
             {
-                float t = static_cast<float>(i) / length;
-                data[i] = static_cast<uint8_t>(data[i] * ((1.0f - t) * startvolume_f + t * endvolume_f));
+                data[i] = static_cast<uint8_t>(data[i] * (startvolume_f + static_cast<float>(i) * step));
             }
         }
 
@@ -12,26 +12,51 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
+#include <thread>
+#include <vector>
 
 namespace OpenRCT2::Audio
 {
     /**
      * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * a file. A background thread keeps reading ahead of the playback
+     * position so the audio callback does not have to wait for the disk.
      */
     class FileAudioSource final : public ISDLAudioSource
     {
     private:
+        static constexpr size_t ReadAheadCapacity = 512 * 1024;
+        static constexpr size_t ReadAheadChunkSize = 64 * 1024;
+
         AudioFormat _format = {};
         SDL_RWops* _rw = nullptr;
         uint64_t _dataBegin = 0;
         uint64_t _dataLength = 0;
 
+        // Guards _rw, only held while reading from the file.
+        std::mutex _rwMutex;
+
+        // Guards the read ahead state below, never held while reading from the file.
+        std::mutex _bufferMutex;
+        std::condition_variable _bufferCondition;
+        std::vector<uint8_t> _buffer;
+        // Data offset of the first byte in _buffer.
+        uint64_t _bufferBegin = 0;
+        // Data offset up to which the audio callback has consumed the buffer.
+        uint64_t _consumed = 0;
+        // Changed whenever the buffer is moved to a new position, so reads already in flight are discarded.
+        uint32_t _bufferGeneration = 0;
+        bool _stopReadAhead = false;
+        std::thread _readAheadThread;
+
     public:
         ~FileAudioSource() override
         {
+            StopReadAhead();
             Unload();
         }
 
@@ -47,25 +72,53 @@ namespace OpenRCT2::Audio
 
         size_t Read(void* dst, uint64_t offset, size_t len) override
         {
+            if (offset >= _dataLength)
+            {
+                return 0;
+            }
+            size_t bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
+
+            if (_readAheadThread.joinable())
+            {
+                std::unique_lock<std::mutex> lock(_bufferMutex);
+                if (offset >= _bufferBegin && offset + bytesToRead <= _bufferBegin + _buffer.size())
+                {
+                    std::copy_n(_buffer.data() + (offset - _bufferBegin), bytesToRead, static_cast<uint8_t*>(dst));
+                    _consumed = offset + bytesToRead;
+                    lock.unlock();
+                    _bufferCondition.notify_one();
+                    return bytesToRead;
+                }
+            }
+
+            // Not buffered yet (start of playback, a seek or the read ahead fell behind), read directly.
             size_t bytesRead = 0;
-            int64_t currentPosition = SDL_RWtell(_rw);
-            if (currentPosition != -1)
             {
-                size_t bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
-                int64_t dataOffset = _dataBegin + offset;
-                if (currentPosition != dataOffset)
+                std::lock_guard<std::mutex> rwLock(_rwMutex);
+                bytesRead = ReadFromFile(dst, offset, bytesToRead);
+            }
+
+            if (_readAheadThread.joinable())
+            {
+                // Continue reading ahead from where the direct read stopped.
                 {
-                    int64_t newPosition = SDL_RWseek(_rw, dataOffset, SEEK_SET);
-                    if (newPosition == -1)
-                    {
-                        return 0;
-                    }
+                    std::lock_guard<std::mutex> lock(_bufferMutex);
+                    _buffer.clear();
+                    _bufferBegin = offset + bytesRead;
+                    _consumed = _bufferBegin;
+                    _bufferGeneration++;
                 }
-                bytesRead = SDL_RWread(_rw, dst, 1, bytesToRead);
+                _bufferCondition.notify_one();
             }
             return bytesRead;
         }
 
+        void StartReadAhead()
+        {
+            _buffer.reserve(ReadAheadCapacity);
+            _readAheadThread = std::thread(&FileAudioSource::ReadAhead, this);
+        }
+
         bool LoadWAV(SDL_RWops* rw)
         {
             constexpr uint32_t DATA = 0x61746164;
@@ -144,6 +197,84 @@ namespace OpenRCT2::Audio
         }
 
     private:
+        size_t ReadFromFile(void* dst, uint64_t offset, size_t len)
+        {
+            int64_t currentPosition = SDL_RWtell(_rw);
+            if (currentPosition == -1)
+            {
+                return 0;
+            }
+            int64_t dataOffset = _dataBegin + offset;
+            if (currentPosition != dataOffset)
+            {
+                int64_t newPosition = SDL_RWseek(_rw, dataOffset, SEEK_SET);
+                if (newPosition == -1)
+                {
+                    return 0;
+                }
+            }
+            return SDL_RWread(_rw, dst, 1, len);
+        }
+
+        bool NeedsReadAhead() const
+        {
+            const uint64_t bufferEnd = _bufferBegin + _buffer.size();
+            return bufferEnd < _dataLength && bufferEnd - _consumed < ReadAheadCapacity - ReadAheadChunkSize;
+        }
+
+        void ReadAhead()
+        {
+            std::vector<uint8_t> chunk(ReadAheadChunkSize);
+            while (true)
+            {
+                uint64_t readOffset;
+                uint32_t generation;
+                {
+                    std::unique_lock<std::mutex> lock(_bufferMutex);
+                    _bufferCondition.wait(lock, [this]() { return _stopReadAhead || NeedsReadAhead(); });
+                    if (_stopReadAhead)
+                        return;
+                    readOffset = _bufferBegin + _buffer.size();
+                    generation = _bufferGeneration;
+                }
+
+                size_t bytesRead;
+                {
+                    std::lock_guard<std::mutex> rwLock(_rwMutex);
+                    const auto len = static_cast<size_t>(std::min<uint64_t>(chunk.size(), _dataLength - readOffset));
+                    bytesRead = ReadFromFile(chunk.data(), readOffset, len);
+                }
+
+                std::lock_guard<std::mutex> lock(_bufferMutex);
+                if (generation != _bufferGeneration)
+                    continue;
+                if (bytesRead == 0)
+                {
+                    // Read error, leave the rest to direct reads from the audio callback.
+                    return;
+                }
+
+                // Drop what has already been played before appending so the buffer never grows past its capacity.
+                const auto played = static_cast<size_t>(std::min<uint64_t>(_consumed - _bufferBegin, _buffer.size()));
+                _buffer.erase(_buffer.begin(), _buffer.begin() + played);
+                _bufferBegin += played;
+                _buffer.insert(_buffer.end(), chunk.begin(), chunk.begin() + bytesRead);
+            }
+        }
+
+        void StopReadAhead()
+        {
+            if (_readAheadThread.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_bufferMutex);
+                    _stopReadAhead = true;
+                }
+                _bufferCondition.notify_one();
+                _readAheadThread.join();
+            }
+        }
+
         static uint32_t FindChunk(SDL_RWops* rw, uint32_t wantedId)
         {
             uint32_t subchunkId = SDL_ReadLE32(rw);
@@ -198,8 +329,9 @@ namespace OpenRCT2::Audio
         if (!source->LoadWAV(rw))
         {
             delete source;
-            source = nullptr;
+            return nullptr;
         }
+        source->StartReadAhead();
         return source;
     }
 
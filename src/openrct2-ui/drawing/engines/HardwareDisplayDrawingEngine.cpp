@@ -10,10 +10,12 @@
 #include "DrawingEngineFactory.hpp"
 
 #include <SDL.h>
+#include <array>
 #include <cmath>
 #include <openrct2/Game.h>
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/core/JobPool.h>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/drawing/LightFX.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
@@ -52,6 +54,12 @@ private:
 
     bool smoothNN = false;
 
+    // With frame pipelining a frame is converted into the locked screen texture on a worker while the next frame is
+    // painted, it is presented at the end of the next frame. SDL textures may only be locked on the main thread.
+    std::unique_ptr<JobPool> _pipelineJobs;
+    std::vector<uint8_t> _pipelineBits;
+    bool _pipelineFramePending = false;
+
 public:
     explicit HardwareDisplayDrawingEngine(const std::shared_ptr<IUiContext>& uiContext)
         : X8DrawingEngine(uiContext)
@@ -62,6 +70,7 @@ public:
 
     ~HardwareDisplayDrawingEngine() override
     {
+        FinishPipelinedFrame();
         SDL_FreeFormat(_screenTextureFormat);
         SDL_DestroyRenderer(_sdlRenderer);
     }
@@ -75,6 +84,7 @@ public:
     {
         if (_useVsync != vsync)
         {
+            FinishPipelinedFrame();
             _useVsync = vsync;
             SDL_DestroyRenderer(_sdlRenderer);
             _screenTexture = nullptr;
@@ -91,6 +101,7 @@ public:
             return;
         }
 
+        FinishPipelinedFrame();
         if (_screenTexture != nullptr)
         {
             SDL_DestroyTexture(_screenTexture);
@@ -180,7 +191,15 @@ public:
 
     void EndDraw() override
     {
-        Display();
+        if (UseFramePipelining())
+        {
+            DisplayPipelined();
+        }
+        else
+        {
+            FinishPipelinedFrame();
+            Display();
+        }
         if (gShowDirtyVisuals)
         {
             UpdateDirtyVisuals();
@@ -205,6 +224,62 @@ protected:
     }
 
 private:
+    bool UseFramePipelining() const
+    {
+#ifdef __ENABLE_LIGHTFX__
+        // The light effects are rendered from buffers that are rewritten while the next frame is painted.
+        if (gConfigGeneral.enable_light_fx)
+        {
+            return false;
+        }
+#endif
+        return gConfigGeneral.frame_pipelining;
+    }
+
+    void DisplayPipelined()
+    {
+        // Present the frame converted while this one was painted, then start converting this one.
+        if (_pipelineFramePending)
+        {
+            FinishPipelinedFrame();
+            Present();
+        }
+
+        void* pixels;
+        int32_t pitch;
+        if (SDL_LockTexture(_screenTexture, nullptr, &pixels, &pitch) != 0)
+        {
+            return;
+        }
+
+        if (_pipelineJobs == nullptr)
+        {
+            _pipelineJobs = std::make_unique<JobPool>(1, "Pipeline");
+        }
+        _pipelineBits.assign(_bits, _bits + _bitsSize);
+        std::array<uint32_t, 256> palette;
+        std::copy(std::begin(_paletteHWMapped), std::end(_paletteHWMapped), palette.begin());
+        auto width = static_cast<int32_t>(_width);
+        auto height = static_cast<int32_t>(_height);
+        _pipelineJobs->AddTask([this, pixels, pitch, width, height, palette]() {
+            ConvertBits(pixels, pitch, _pipelineBits.data(), width, height, palette.data());
+        });
+        _pipelineFramePending = true;
+    }
+
+    /**
+     * Waits for the frame being converted and uploads it to the screen texture without presenting it.
+     */
+    void FinishPipelinedFrame()
+    {
+        if (_pipelineFramePending)
+        {
+            _pipelineJobs->Join();
+            SDL_UnlockTexture(_screenTexture);
+            _pipelineFramePending = false;
+        }
+    }
+
     void Display()
     {
 #ifdef __ENABLE_LIGHTFX__
@@ -224,6 +299,11 @@ private:
             CopyBitsToTexture(
                 _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
         }
+        Present();
+    }
+
+    void Present()
+    {
         if (smoothNN)
         {
             SDL_SetRenderTarget(_sdlRenderer, _scaledScreenTexture);
@@ -262,45 +342,51 @@ private:
         int32_t pitch;
         if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
         {
-            int32_t padding = pitch - (width * 4);
-            if (pitch == width * 4)
+            ConvertBits(pixels, pitch, src, width, height, palette);
+            SDL_UnlockTexture(texture);
+        }
+    }
+
+    static void ConvertBits(
+        void* pixels, int32_t pitch, const uint8_t* src, int32_t width, int32_t height, const uint32_t* palette)
+    {
+        int32_t padding = pitch - (width * 4);
+        if (pitch == width * 4)
+        {
+            uint32_t* dst = static_cast<uint32_t*>(pixels);
+            for (int32_t i = width * height; i > 0; i--)
             {
-                uint32_t* dst = static_cast<uint32_t*>(pixels);
-                for (int32_t i = width * height; i > 0; i--)
-                {
-                    *dst++ = palette[*src++];
-                }
+                *dst++ = palette[*src++];
             }
-            else
+        }
+        else
+        {
+            if (pitch == (width * 2) + padding)
             {
-                if (pitch == (width * 2) + padding)
+                uint16_t* dst = static_cast<uint16_t*>(pixels);
+                for (int32_t y = height; y > 0; y--)
                 {
-                    uint16_t* dst = static_cast<uint16_t*>(pixels);
-                    for (int32_t y = height; y > 0; y--)
+                    for (int32_t x = width; x > 0; x--)
                     {
-                        for (int32_t x = width; x > 0; x--)
-                        {
-                            const uint8_t lower = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                            const uint8_t upper = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                            *dst++ = (lower << 8) | upper;
-                        }
-                        dst = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + padding);
+                        const uint8_t lower = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
+                        const uint8_t upper = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
+                        *dst++ = (lower << 8) | upper;
                     }
+                    dst = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + padding);
                 }
-                else if (pitch == width + padding)
+            }
+            else if (pitch == width + padding)
+            {
+                uint8_t* dst = static_cast<uint8_t*>(pixels);
+                for (int32_t y = height; y > 0; y--)
                 {
-                    uint8_t* dst = static_cast<uint8_t*>(pixels);
-                    for (int32_t y = height; y > 0; y--)
+                    for (int32_t x = width; x > 0; x--)
                     {
-                        for (int32_t x = width; x > 0; x--)
-                        {
-                            *dst++ = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
-                        }
-                        dst += padding;
+                        *dst++ = *reinterpret_cast<const uint8_t*>(&palette[*src++]);
                     }
+                    dst += padding;
                 }
             }
-            SDL_UnlockTexture(texture);
         }
     }
 
@@ -28,11 +28,11 @@ constexpr VDStruct VertexData[2] = {
 
 DrawLineShader::DrawLineShader()
     : OpenGLShaderProgram("drawline")
+    , _instanceBuffer(sizeof(DrawLineCommand))
 {
     GetLocations();
 
     glGenBuffers(1, &_vbo);
-    glGenBuffers(1, &_vboInstances);
     glGenVertexArrays(1, &_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -48,14 +48,7 @@ DrawLineShader::DrawLineShader()
     glVertexAttribPointer(
         vVertMat + 3, 2, GL_FLOAT, GL_FALSE, sizeof(VDStruct), reinterpret_cast<void*>(offsetof(VDStruct, mat[3])));
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, clip)));
-    glVertexAttribIPointer(
-        vBounds, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, bounds)));
-    glVertexAttribIPointer(
-        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, colour)));
-    glVertexAttribIPointer(
-        vDepth, 1, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, depth)));
+    BindInstanceAttributes();
 
     glEnableVertexAttribArray(vVertMat + 0);
     glEnableVertexAttribArray(vVertMat + 1);
@@ -93,6 +86,18 @@ void DrawLineShader::GetLocations()
     vVertMat = GetAttributeLocation("vVertMat");
 }
 
+void DrawLineShader::BindInstanceAttributes()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer.GetBuffer());
+    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, clip)));
+    glVertexAttribIPointer(
+        vBounds, 4, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, bounds)));
+    glVertexAttribIPointer(
+        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, colour)));
+    glVertexAttribIPointer(
+        vDepth, 1, GL_INT, sizeof(DrawLineCommand), reinterpret_cast<void*>(offsetof(DrawLineCommand, depth)));
+}
+
 void DrawLineShader::SetScreenSize(int32_t width, int32_t height)
 {
     glUniform2i(uScreenSize, width, height);
@@ -102,10 +107,11 @@ void DrawLineShader::DrawInstances(const LineCommandBatch& instances)
 {
     glBindVertexArray(_vao);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawLineCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
-
-    glDrawArraysInstanced(GL_LINES, 0, 2, static_cast<GLsizei>(instances.size()));
+    if (_instanceBuffer.Upload(instances.data(), instances.size()))
+    {
+        BindInstanceAttributes();
+    }
+    _instanceBuffer.Draw(GL_LINES, 0, 2);
 }
 
 #endif /* DISABLE_OPENGL */
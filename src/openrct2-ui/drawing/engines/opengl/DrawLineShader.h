@@ -11,6 +11,7 @@
 
 #include "DrawCommands.h"
 #include "GLSLTypes.h"
+#include "InstanceBuffer.h"
 #include "OpenGLShaderProgram.h"
 
 class DrawLineShader final : public OpenGLShaderProgram
@@ -26,8 +27,8 @@ private:
     GLuint vVertMat;
 
     GLuint _vbo;
-    GLuint _vboInstances;
     GLuint _vao;
+    InstanceBuffer _instanceBuffer;
 
 public:
     DrawLineShader();
@@ -38,4 +39,5 @@ public:
 
 private:
     void GetLocations();
+    void BindInstanceAttributes();
 };
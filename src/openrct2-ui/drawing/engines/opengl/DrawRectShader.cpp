@@ -29,11 +29,11 @@ constexpr VDStruct VertexData[4] = {
 
 DrawRectShader::DrawRectShader()
     : OpenGLShaderProgram("drawrect")
+    , _instanceBuffer(sizeof(DrawRectCommand))
 {
     GetLocations();
 
     glGenBuffers(1, &_vbo);
-    glGenBuffers(1, &_vboInstances);
     glGenVertexArrays(1, &_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -51,29 +51,7 @@ DrawRectShader::DrawRectShader()
         vVertMat + 3, 2, GL_FLOAT, GL_FALSE, sizeof(VDStruct), reinterpret_cast<void*>(offsetof(VDStruct, mat[3])));
     glVertexAttribPointer(vVertVec, 2, GL_FLOAT, GL_FALSE, sizeof(VDStruct), reinterpret_cast<void*>(offsetof(VDStruct, vec)));
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, clip)));
-    glVertexAttribIPointer(
-        vTexColourAtlas, 1, GL_INT, sizeof(DrawRectCommand),
-        reinterpret_cast<void*>(offsetof(DrawRectCommand, texColourAtlas)));
-    glVertexAttribPointer(
-        vTexColourBounds, 4, GL_FLOAT, GL_FALSE, sizeof(DrawRectCommand),
-        reinterpret_cast<void*>(offsetof(DrawRectCommand, texColourBounds)));
-    glVertexAttribIPointer(
-        vTexMaskAtlas, 1, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, texMaskAtlas)));
-    glVertexAttribPointer(
-        vTexMaskBounds, 4, GL_FLOAT, GL_FALSE, sizeof(DrawRectCommand),
-        reinterpret_cast<void*>(offsetof(DrawRectCommand, texMaskBounds)));
-    glVertexAttribIPointer(
-        vPalettes, 3, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, palettes)));
-    glVertexAttribIPointer(
-        vFlags, 1, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, flags)));
-    glVertexAttribIPointer(
-        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, colour)));
-    glVertexAttribIPointer(
-        vBounds, 4, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, bounds)));
-    glVertexAttribIPointer(
-        vDepth, 1, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, depth)));
+    BindInstanceAttributes();
 
     glEnableVertexAttribArray(vVertMat + 0);
     glEnableVertexAttribArray(vVertMat + 1);
@@ -114,7 +92,6 @@ DrawRectShader::DrawRectShader()
 DrawRectShader::~DrawRectShader()
 {
     glDeleteBuffers(1, &_vbo);
-    glDeleteBuffers(1, &_vboInstances);
     glDeleteVertexArrays(1, &_vao);
 }
 
@@ -142,6 +119,33 @@ void DrawRectShader::GetLocations()
     vVertVec = GetAttributeLocation("vVertVec");
 }
 
+void DrawRectShader::BindInstanceAttributes()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer.GetBuffer());
+    glVertexAttribIPointer(vClip, 4, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, clip)));
+    glVertexAttribIPointer(
+        vTexColourAtlas, 1, GL_INT, sizeof(DrawRectCommand),
+        reinterpret_cast<void*>(offsetof(DrawRectCommand, texColourAtlas)));
+    glVertexAttribPointer(
+        vTexColourBounds, 4, GL_FLOAT, GL_FALSE, sizeof(DrawRectCommand),
+        reinterpret_cast<void*>(offsetof(DrawRectCommand, texColourBounds)));
+    glVertexAttribIPointer(
+        vTexMaskAtlas, 1, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, texMaskAtlas)));
+    glVertexAttribPointer(
+        vTexMaskBounds, 4, GL_FLOAT, GL_FALSE, sizeof(DrawRectCommand),
+        reinterpret_cast<void*>(offsetof(DrawRectCommand, texMaskBounds)));
+    glVertexAttribIPointer(
+        vPalettes, 3, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, palettes)));
+    glVertexAttribIPointer(
+        vFlags, 1, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, flags)));
+    glVertexAttribIPointer(
+        vColour, 1, GL_UNSIGNED_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, colour)));
+    glVertexAttribIPointer(
+        vBounds, 4, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, bounds)));
+    glVertexAttribIPointer(
+        vDepth, 1, GL_INT, sizeof(DrawRectCommand), reinterpret_cast<void*>(offsetof(DrawRectCommand, depth)));
+}
+
 void DrawRectShader::SetScreenSize(int32_t width, int32_t height)
 {
     glUniform2i(uScreenSize, width, height);
@@ -162,16 +166,16 @@ void DrawRectShader::SetInstances(const RectCommandBatch& instances)
 {
     glBindVertexArray(_vao);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawRectCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
-
-    _instanceCount = static_cast<GLsizei>(instances.size());
+    if (_instanceBuffer.Upload(instances.data(), instances.size()))
+    {
+        BindInstanceAttributes();
+    }
 }
 
 void DrawRectShader::DrawInstances()
 {
     glBindVertexArray(_vao);
-    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, _instanceCount);
+    _instanceBuffer.Draw(GL_TRIANGLE_STRIP, 0, 4);
 }
 
 #endif /* DISABLE_OPENGL */
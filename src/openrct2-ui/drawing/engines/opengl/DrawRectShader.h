@@ -11,6 +11,7 @@
 
 #include "DrawCommands.h"
 #include "GLSLTypes.h"
+#include "InstanceBuffer.h"
 #include "OpenGLShaderProgram.h"
 
 #include <SDL_pixels.h>
@@ -40,10 +41,8 @@ private:
     GLuint vDepth;
 
     GLuint _vbo;
-    GLuint _vboInstances;
     GLuint _vao;
-
-    GLsizei _instanceCount = 0;
+    InstanceBuffer _instanceBuffer;
 
 public:
     DrawRectShader();
@@ -58,4 +57,5 @@ public:
 
 private:
     void GetLocations();
+    void BindInstanceAttributes();
 };
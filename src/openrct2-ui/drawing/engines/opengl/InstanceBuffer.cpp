@@ -0,0 +1,149 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_OPENGL
+
+#    include "InstanceBuffer.h"
+
+#    include <cstring>
+
+constexpr GLbitfield PersistentMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+constexpr GLuint64 FenceTimeout = 1000000000; // 1 second in nanoseconds
+
+InstanceBuffer::InstanceBuffer(size_t stride, size_t initialCapacity)
+    : _stride(stride)
+    , _persistent(OpenGLAPI::SupportsBufferStorage())
+{
+    if (_persistent)
+    {
+        CreatePersistentBuffer(initialCapacity);
+    }
+    else
+    {
+        glGenBuffers(1, &_buffer);
+    }
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+    if (_persistent)
+    {
+        DestroyPersistentBuffer();
+    }
+    else
+    {
+        glDeleteBuffers(1, &_buffer);
+    }
+}
+
+bool InstanceBuffer::Upload(const void* instances, size_t count)
+{
+    bool recreated = false;
+    _count = static_cast<GLsizei>(count);
+    if (!_persistent)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+        glBufferData(GL_ARRAY_BUFFER, _stride * count, instances, GL_STREAM_DRAW);
+        _first = 0;
+        return recreated;
+    }
+
+    if (count > _regionCapacity)
+    {
+        // Immutable storage can not be resized, replace the buffer with a larger one.
+        auto regionCapacity = _regionCapacity;
+        while (regionCapacity < count)
+        {
+            regionCapacity *= 2;
+        }
+        DestroyPersistentBuffer();
+        CreatePersistentBuffer(regionCapacity);
+        recreated = true;
+    }
+    else if (_regionUsed + count > _regionCapacity)
+    {
+        AdvanceRegion();
+    }
+
+    auto first = (_region * _regionCapacity) + _regionUsed;
+    std::memcpy(_mapped + (first * _stride), instances, _stride * count);
+    _first = static_cast<GLuint>(first);
+    _regionUsed += count;
+    return recreated;
+}
+
+void InstanceBuffer::Draw(GLenum mode, GLint first, GLsizei count) const
+{
+    if (_persistent)
+    {
+        glDrawArraysInstancedBaseInstance(mode, first, count, _count, _first);
+    }
+    else
+    {
+        glDrawArraysInstanced(mode, first, count, _count);
+    }
+}
+
+void InstanceBuffer::CreatePersistentBuffer(size_t regionCapacity)
+{
+    _regionCapacity = regionCapacity;
+    _region = 0;
+    _regionUsed = 0;
+
+    const auto size = static_cast<GLsizeiptr>(_stride * _regionCapacity * NumRegions);
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, PersistentMapFlags);
+    _mapped = static_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, PersistentMapFlags));
+}
+
+void InstanceBuffer::DestroyPersistentBuffer()
+{
+    // The driver keeps the storage alive until draws that are still in flight have completed.
+    for (auto& fence : _fences)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glDeleteBuffers(1, &_buffer);
+    _mapped = nullptr;
+    _buffer = 0;
+}
+
+void InstanceBuffer::AdvanceRegion()
+{
+    // Draws sourcing this region have all been issued, fence them before writing to the next region.
+    _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _region = (_region + 1) % NumRegions;
+    _regionUsed = 0;
+    WaitForFence(_region);
+}
+
+void InstanceBuffer::WaitForFence(size_t region)
+{
+    auto& fence = _fences[region];
+    if (fence == nullptr)
+    {
+        return;
+    }
+    GLenum result;
+    do
+    {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+    } while (result == GL_TIMEOUT_EXPIRED);
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+#endif /* DISABLE_OPENGL */
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "OpenGLAPI.h"
+
+#include <array>
+#include <openrct2/common.h>
+
+/**
+ * Per-instance vertex data streamed to the GPU every flush.
+ * When ARB_buffer_storage is available the buffer is persistently mapped and split into a ring of regions, each
+ * guarded by a fence, so uploads are plain copies without any driver allocation. Otherwise the buffer is orphaned
+ * with glBufferData on every upload.
+ */
+class InstanceBuffer
+{
+private:
+    static constexpr size_t NumRegions = 3;
+
+    const size_t _stride;
+    const bool _persistent;
+    GLuint _buffer = 0;
+
+    uint8_t* _mapped = nullptr;
+    size_t _regionCapacity = 0;
+    size_t _region = 0;
+    size_t _regionUsed = 0;
+    std::array<GLsync, NumRegions> _fences{};
+
+    GLuint _first = 0;
+    GLsizei _count = 0;
+
+public:
+    InstanceBuffer(size_t stride, size_t initialCapacity = 4096);
+    ~InstanceBuffer();
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    GLuint GetBuffer() const
+    {
+        return _buffer;
+    }
+
+    /**
+     * Copies the instances to the GPU for the next draws.
+     * @return true if the buffer object was recreated, instance attributes must then be bound again.
+     */
+    bool Upload(const void* instances, size_t count);
+
+    /**
+     * Draws the last uploaded instances, the vertex array object must be bound.
+     */
+    void Draw(GLenum mode, GLint first, GLsizei count) const;
+
+private:
+    void CreatePersistentBuffer(size_t regionCapacity);
+    void DestroyPersistentBuffer();
+    void AdvanceRegion();
+    void WaitForFence(size_t region);
+};
@@ -14,7 +14,9 @@
 #    if OPENGL_NO_LINK
 
 #        define OPENGL_PROC(TYPE, PROC) TYPE PROC = nullptr;
+#        define OPENGL_OPTIONAL_PROC(TYPE, PROC) TYPE PROC = nullptr;
 #        include "OpenGLAPIProc.h"
+#        undef OPENGL_OPTIONAL_PROC
 #        undef OPENGL_PROC
 
 #        include <SDL_video.h>
@@ -30,7 +32,9 @@ static const char* TryLoadAllProcAddresses()
                     return #PROC;                                                                                              \
                 }                                                                                                              \
             }
+#        define OPENGL_OPTIONAL_PROC(TYPE, PROC) PROC = reinterpret_cast<TYPE>(SDL_GL_GetProcAddress(#PROC));
 #        include "OpenGLAPIProc.h"
+#        undef OPENGL_OPTIONAL_PROC
 #        undef OPENGL_PROC
 
     return nullptr;
@@ -50,6 +54,8 @@ namespace OpenGLState
     }
 } // namespace OpenGLState
 
+static bool _supportsBufferStorage = false;
+
 void OpenGLAPI::SetTexture(uint16_t index, GLenum type, GLuint texture)
 {
     if (OpenGLState::ActiveTexture != index)
@@ -70,8 +76,16 @@ bool OpenGLAPI::Initialise()
         Console::Error::WriteLine("Failed to load %s.", failedProcName);
         return false;
     }
+
+    _supportsBufferStorage = glBufferStorage != nullptr && glDrawArraysInstancedBaseInstance != nullptr
+        && SDL_GL_ExtensionSupported("GL_ARB_buffer_storage") && SDL_GL_ExtensionSupported("GL_ARB_base_instance");
 #    endif
     return true;
 }
 
+bool OpenGLAPI::SupportsBufferStorage()
+{
+    return _supportsBufferStorage;
+}
+
 #endif /* DISABLE_OPENGL */
@@ -108,7 +108,9 @@ using PFNGLGETINTERGERVPROC = void(APIENTRYP)(GLenum pname, GLint* data);
 using PFNGLGETTEXIMAGEPROC = void(APIENTRYP)(GLenum target, GLint level, GLenum format, GLenum type, GLvoid* img);
 
 #    define OPENGL_PROC(TYPE, PROC) extern TYPE PROC;
+#    define OPENGL_OPTIONAL_PROC(TYPE, PROC) extern TYPE PROC;
 #    include "OpenGLAPIProc.h"
+#    undef OPENGL_OPTIONAL_PROC
 #    undef OPENGL_PROC
 
 #endif /* OPENGL_NO_LINK */
@@ -127,6 +129,12 @@ namespace OpenGLAPI
 {
     bool Initialise();
     void SetTexture(uint16_t index, GLenum type, GLuint texture);
+
+    /**
+     * Whether persistently mapped buffers (ARB_buffer_storage) and instanced draws with a base instance
+     * (ARB_base_instance) are available.
+     */
+    bool SupportsBufferStorage();
 } // namespace OpenGLAPI
 
 namespace OpenGLState
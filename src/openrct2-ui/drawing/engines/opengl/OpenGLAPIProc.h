@@ -7,7 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
-#ifndef OPENGL_PROC
+#if !defined(OPENGL_PROC) || !defined(OPENGL_OPTIONAL_PROC)
 #    error "Do not include OpenGLAPIProc.h directly. Include OpenGLAPI.h instead."
 #endif
 
@@ -84,3 +84,12 @@ OPENGL_PROC(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer)
 OPENGL_PROC(PFNGLDRAWARRAYSINSTANCEDPROC, glDrawArraysInstanced)
 OPENGL_PROC(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor)
 OPENGL_PROC(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate)
+OPENGL_PROC(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange)
+OPENGL_PROC(PFNGLUNMAPBUFFERPROC, glUnmapBuffer)
+OPENGL_PROC(PFNGLFENCESYNCPROC, glFenceSync)
+OPENGL_PROC(PFNGLCLIENTWAITSYNCPROC, glClientWaitSync)
+OPENGL_PROC(PFNGLDELETESYNCPROC, glDeleteSync)
+
+// ARB_buffer_storage and ARB_base_instance function pointers, these may not be available
+OPENGL_OPTIONAL_PROC(PFNGLBUFFERSTORAGEPROC, glBufferStorage)
+OPENGL_OPTIONAL_PROC(PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC, glDrawArraysInstancedBaseInstance)
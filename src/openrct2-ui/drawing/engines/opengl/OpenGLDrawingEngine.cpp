@@ -24,6 +24,9 @@
 #    include <SDL.h>
 #    include <algorithm>
 #    include <cmath>
+#    include <memory>
+#    include <mutex>
+#    include <optional>
 #    include <openrct2-ui/interface/Window.h>
 #    include <openrct2/Intro.h>
 #    include <openrct2/config/Config.h>
@@ -33,11 +36,13 @@
 #    include <openrct2/drawing/IDrawingEngine.h>
 #    include <openrct2/drawing/LightFX.h>
 #    include <openrct2/drawing/Weather.h>
+#    include <openrct2/drawing/X8DrawingEngine.h>
 #    include <openrct2/interface/Screenshot.h>
 #    include <openrct2/ui/UiContext.h>
 #    include <openrct2/util/Util.h>
 #    include <openrct2/world/Climate.h>
 #    include <unordered_map>
+#    include <utility>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -63,6 +68,7 @@ private:
     SwapFramebuffer* _swapFramebuffer = nullptr;
 
     TextureCache* _textureCache = nullptr;
+    bool _ownsTextureCache = true;
 
     int32_t _offsetX = 0;
     int32_t _offsetY = 0;
@@ -83,6 +89,8 @@ private:
 
 public:
     explicit OpenGLDrawingContext(OpenGLDrawingEngine* engine);
+    // Creates a context that only records commands, drawing them is left to the context they are appended to.
+    OpenGLDrawingContext(OpenGLDrawingEngine* engine, TextureCache* textureCache);
     ~OpenGLDrawingContext() override;
 
     IDrawingEngine* GetEngine() override;
@@ -105,6 +113,7 @@ public:
     void FilterRect(
         rct_drawpixelinfo* dpi, FilterPaletteID palette, int32_t left, int32_t top, int32_t right, int32_t bottom) override;
     void DrawLine(rct_drawpixelinfo* dpi, uint32_t colour, const ScreenLine& line) override;
+    void DrawPixelRow(rct_drawpixelinfo* dpi, uint8_t colour, int32_t left, int32_t right, int32_t y, int32_t spacing);
     void DrawSprite(rct_drawpixelinfo* dpi, ImageId imageId, int32_t x, int32_t y) override;
     void DrawSpriteRawMasked(rct_drawpixelinfo* dpi, int32_t x, int32_t y, ImageId maskImage, ImageId colourImage) override;
     void DrawSpriteSolid(rct_drawpixelinfo* dpi, ImageId image, int32_t x, int32_t y, uint8_t colour) override;
@@ -114,6 +123,7 @@ public:
         int32_t y) override;
 
     void FlushCommandBuffers();
+    void AppendCommandBuffers(OpenGLDrawingContext& recordingContext);
 
     void FlushLines();
     void FlushRectangles();
@@ -124,6 +134,7 @@ public:
 class OpenGLWeatherDrawer final : public IWeatherDrawer
 {
     OpenGLDrawingContext* _drawingContext;
+    std::optional<ScreenRect> _drawnArea;
 
 public:
     explicit OpenGLWeatherDrawer(OpenGLDrawingContext* drawingContext)
@@ -135,40 +146,32 @@ public:
         rct_drawpixelinfo* dpi, int32_t x, int32_t y, int32_t width, int32_t height, int32_t xStart, int32_t yStart,
         const uint8_t* weatherpattern) override
     {
-        const uint8_t* pattern = weatherpattern;
-        auto patternXSpace = *pattern++;
-        auto patternYSpace = *pattern++;
-
-        uint8_t patternStartXOffset = xStart % patternXSpace;
-        uint8_t patternStartYOffset = yStart % patternYSpace;
-
-        uint32_t pixelOffset = (dpi->pitch + dpi->width) * y + x;
-        uint8_t patternYPos = patternStartYOffset % patternYSpace;
-
-        for (; height != 0; height--)
+        if (_drawnArea.has_value())
         {
-            auto patternX = pattern[patternYPos * 2];
-            if (patternX != 0xFF)
-            {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
-                auto patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
-                {
-                    int32_t pixelX = xPixelOffset % dpi->width;
-                    int32_t pixelY = (xPixelOffset / dpi->width) % dpi->height;
+            _drawnArea = ScreenRect(
+                std::min(_drawnArea->GetLeft(), x), std::min(_drawnArea->GetTop(), y),
+                std::max(_drawnArea->GetRight(), x + width), std::max(_drawnArea->GetBottom(), y + height));
+        }
+        else
+        {
+            _drawnArea = ScreenRect(x, y, x + width, y + height);
+        }
 
-                    _drawingContext->DrawLine(dpi, patternPixel, { { pixelX, pixelY }, { pixelX + 1, pixelY + 1 } });
-                }
-            }
+        const auto patternXSpace = weatherpattern[0];
+        ForEachWeatherPatternRow(
+            x, width, height, xStart, yStart, weatherpattern, [&](int32_t row, int32_t left, uint8_t patternPixel) {
+                _drawingContext->DrawPixelRow(dpi, patternPixel, left, x + width, y + row, patternXSpace);
+            });
+    }
 
-            pixelOffset += dpi->pitch + dpi->width;
-            patternYPos++;
-            patternYPos %= patternYSpace;
-        }
+    /**
+     * Weather is drawn over the retained canvas, so whatever it covered has to be
+     * repainted by the next frame.
+     * @return The area drawn since the last call, if any.
+     */
+    std::optional<ScreenRect> TakeDrawnArea()
+    {
+        return std::exchange(_drawnArea, std::nullopt);
     }
 };
 
@@ -187,8 +190,18 @@ private:
 
     rct_drawpixelinfo _bitsDPI = {};
 
+    // The canvas is retained between frames, only invalidated blocks are drawn again.
+    DirtyGrid _dirtyGrid = {};
+
     OpenGLDrawingContext* _drawingContext;
 
+    // Viewport columns drawn on several threads record into a context per thread, they are merged once all are drawn.
+    std::vector<std::unique_ptr<OpenGLDrawingContext>> _recordingContexts;
+    size_t _recordingContextsUsed = 0;
+    std::mutex _recordingContextsMutex;
+    uint32_t _parallelDrawGeneration = 0;
+    bool _parallelDrawing = false;
+
     ApplyPaletteShader* _applyPaletteShader = nullptr;
     OpenGLFramebuffer* _screenFramebuffer = nullptr;
     OpenGLFramebuffer* _scaleFramebuffer = nullptr;
@@ -252,7 +265,11 @@ public:
     {
         ConfigureBits(width, height, width);
         ConfigureCanvas();
+        _dirtyGrid.Configure(_width, _height);
         _drawingContext->Resize(width, height);
+
+        // The canvas framebuffers have been recreated.
+        Invalidate(0, 0, width, height);
     }
 
     void SetPalette(const GamePalette& palette) override
@@ -286,12 +303,14 @@ public:
 
     void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom) override
     {
+        _dirtyGrid.Invalidate(left, top, right, bottom);
     }
 
     void BeginDraw() override
     {
         assert(_screenFramebuffer != nullptr);
 
+        _drawingContext->GetTextureCache()->BeginFrame();
         _drawingContext->StartNewDraw();
         _drawingContext->CalculcateClipping(&_bitsDPI);
     }
@@ -332,9 +351,11 @@ public:
     void PaintWindows() override
     {
         _drawingContext->CalculcateClipping(&_bitsDPI);
+        _dirtyGrid.BeginFrame();
 
+        // Viewports that moved invalidate themselves as their pixels can not be shifted.
         window_update_all_viewports();
-        window_draw_all(&_bitsDPI, 0, 0, _width, _height);
+        DrawAllDirtyBlocks();
     }
 
     void PaintWeather() override
@@ -342,6 +363,12 @@ public:
         _drawingContext->CalculcateClipping(&_bitsDPI);
 
         DrawWeather(&_bitsDPI, &_weatherDrawer);
+
+        auto weatherArea = _weatherDrawer.TakeDrawnArea();
+        if (weatherArea.has_value())
+        {
+            Invalidate(weatherArea->GetLeft(), weatherArea->GetTop(), weatherArea->GetRight(), weatherArea->GetBottom());
+        }
     }
 
     std::string Screenshot() override
@@ -360,7 +387,44 @@ public:
 
     IDrawingContext* GetDrawingContext() override
     {
-        return _drawingContext;
+        if (!_parallelDrawing)
+        {
+            return _drawingContext;
+        }
+
+        thread_local const OpenGLDrawingEngine* recordingEngine = nullptr;
+        thread_local uint32_t recordingGeneration = 0;
+        thread_local OpenGLDrawingContext* recordingContext = nullptr;
+        if (recordingEngine != this || recordingGeneration != _parallelDrawGeneration)
+        {
+            std::lock_guard<std::mutex> lock(_recordingContextsMutex);
+            if (_recordingContextsUsed == _recordingContexts.size())
+            {
+                _recordingContexts.push_back(
+                    std::make_unique<OpenGLDrawingContext>(this, _drawingContext->GetTextureCache()));
+            }
+            recordingContext = _recordingContexts[_recordingContextsUsed++].get();
+            recordingEngine = this;
+            recordingGeneration = _parallelDrawGeneration;
+        }
+        return recordingContext;
+    }
+
+    void BeginParallelDraw() override
+    {
+        _parallelDrawGeneration++;
+        _recordingContextsUsed = 0;
+        _parallelDrawing = true;
+    }
+
+    void EndParallelDraw() override
+    {
+        _parallelDrawing = false;
+        for (size_t i = 0; i < _recordingContextsUsed; i++)
+        {
+            _drawingContext->AppendCommandBuffers(*_recordingContexts[i]);
+        }
+        _recordingContextsUsed = 0;
     }
 
     rct_drawpixelinfo* GetDrawingPixelInfo() override
@@ -370,7 +434,12 @@ public:
 
     DRAWING_ENGINE_FLAGS GetFlags() override
     {
-        return DEF_NONE;
+        return DEF_PARALLEL_DRAWING;
+    }
+
+    DirtyGridStats GetDirtyGridStats() override
+    {
+        return _dirtyGrid.GetStats();
     }
 
     void InvalidateImage(uint32_t image) override
@@ -478,6 +547,29 @@ private:
     {
         SDL_GL_SwapWindow(_window);
     }
+
+    void DrawAllDirtyBlocks()
+    {
+        for (const auto& region : _dirtyGrid.TakeRegions())
+        {
+            DrawDirtyBlocks(region.X, region.Y, region.Columns, region.Rows);
+        }
+    }
+
+    void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
+    {
+        uint32_t left = x * _dirtyGrid.BlockWidth;
+        uint32_t top = y * _dirtyGrid.BlockHeight;
+        uint32_t right = std::min(_width, left + (columns * _dirtyGrid.BlockWidth));
+        uint32_t bottom = std::min(_height, top + (rows * _dirtyGrid.BlockHeight));
+        if (right <= left || bottom <= top)
+        {
+            return;
+        }
+
+        // Every command is clipped to the region, so the rest of the canvas keeps last frame's pixels.
+        window_draw_all(&_bitsDPI, left, top, right, bottom);
+    }
 };
 
 std::unique_ptr<IDrawingEngine> OpenRCT2::Ui::CreateOpenGLDrawingEngine(const std::shared_ptr<IUiContext>& uiContext)
@@ -490,6 +582,13 @@ OpenGLDrawingContext::OpenGLDrawingContext(OpenGLDrawingEngine* engine)
     _engine = engine;
 }
 
+OpenGLDrawingContext::OpenGLDrawingContext(OpenGLDrawingEngine* engine, TextureCache* textureCache)
+{
+    _engine = engine;
+    _textureCache = textureCache;
+    _ownsTextureCache = false;
+}
+
 OpenGLDrawingContext::~OpenGLDrawingContext()
 {
     delete _applyTransparencyShader;
@@ -497,7 +596,10 @@ OpenGLDrawingContext::~OpenGLDrawingContext()
     delete _drawRectShader;
     delete _swapFramebuffer;
 
-    delete _textureCache;
+    if (_ownsTextureCache)
+    {
+        delete _textureCache;
+    }
 }
 
 IDrawingEngine* OpenGLDrawingContext::GetEngine()
@@ -617,6 +719,32 @@ void OpenGLDrawingContext::DrawLine(rct_drawpixelinfo* dpi, uint32_t colour, con
     command.depth = _drawCount++;
 }
 
+/**
+ * Draws single pixels from left up to right, spacing pixels apart. The clipping is only calculated once for the row and
+ * pixels outside of it are not drawn at all, every pixel is one instance of the line batch.
+ */
+void OpenGLDrawingContext::DrawPixelRow(
+    rct_drawpixelinfo* dpi, uint8_t colour, int32_t left, int32_t right, int32_t y, int32_t spacing)
+{
+    CalculcateClipping(dpi);
+
+    const auto screenY = y + _offsetY;
+    if (screenY < _clipTop || screenY >= _clipBottom)
+        return;
+
+    for (auto screenX = left + _offsetX; screenX < right + _offsetX && screenX < _clipRight; screenX += spacing)
+    {
+        if (screenX < _clipLeft)
+            continue;
+
+        DrawLineCommand& command = _commandBuffers.lines.allocate();
+        command.clip = { _clipLeft, _clipTop, _clipRight, _clipBottom };
+        command.bounds = { screenX, screenY, screenX + 1, screenY + 1 };
+        command.colour = colour;
+        command.depth = _drawCount++;
+    }
+}
+
 void OpenGLDrawingContext::DrawSprite(rct_drawpixelinfo* dpi, ImageId imageId, int32_t x, int32_t y)
 {
     CalculcateClipping(dpi);
@@ -984,6 +1112,9 @@ void OpenGLDrawingContext::DrawBitmap(
 
 void OpenGLDrawingContext::FlushCommandBuffers()
 {
+    // Images first used by the queued commands are decoded and uploaded now.
+    _textureCache->FlushUploads();
+
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
 
@@ -997,6 +1128,30 @@ void OpenGLDrawingContext::FlushCommandBuffers()
     HandleTransparency();
 }
 
+void OpenGLDrawingContext::AppendCommandBuffers(OpenGLDrawingContext& recordingContext)
+{
+    // The recorded commands are ordered among themselves, they are drawn after everything already queued.
+    auto& recorded = recordingContext._commandBuffers;
+    for (const auto& command : recorded.lines)
+    {
+        _commandBuffers.lines.insert(command).depth += _drawCount;
+    }
+    for (const auto& command : recorded.rects)
+    {
+        _commandBuffers.rects.insert(command).depth += _drawCount;
+    }
+    for (const auto& command : recorded.transparent)
+    {
+        _commandBuffers.transparent.insert(command).depth += _drawCount;
+    }
+    _drawCount += recordingContext._drawCount;
+
+    recorded.lines.clear();
+    recorded.rects.clear();
+    recorded.transparent.clear();
+    recordingContext._drawCount = 0;
+}
+
 void OpenGLDrawingContext::FlushLines()
 {
     if (_commandBuffers.lines.empty())
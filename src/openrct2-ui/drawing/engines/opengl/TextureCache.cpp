@@ -12,6 +12,7 @@
 #    include "TextureCache.h"
 
 #    include <algorithm>
+#    include <openrct2/core/JobPool.h>
 #    include <openrct2/drawing/Drawing.h>
 #    include <openrct2/util/Util.h>
 #    include <openrct2/world/Location.hpp>
@@ -20,7 +21,11 @@
 
 constexpr uint32_t UNUSED_INDEX = 0xFFFFFFFF;
 
+// Number of images to decode at a flush before it is worth spreading them over the job pool
+constexpr size_t PARALLEL_DECODE_THRESHOLD = 32;
+
 TextureCache::TextureCache()
+    : _memoryRegistration("textureCache", [this] { return GetMemoryUsage(); })
 {
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
 }
@@ -30,6 +35,32 @@ TextureCache::~TextureCache()
     FreeTextures();
 }
 
+void TextureCache::BeginFrame()
+{
+    unique_lock lock(_mutex);
+
+    // Textures have to exist before images are loaded, which may happen on threads without a GL context.
+    CreateTextures();
+    _currentFrame++;
+}
+
+size_t TextureCache::GetMemoryUsage()
+{
+    shared_lock lock(_mutex);
+
+    // The atlas array lives in video memory, count it anyway as drivers often keep a copy of it
+    auto atlasBytes = static_cast<size_t>(_atlasesTextureDimensions) * _atlasesTextureDimensions * _atlasesTextureCapacity;
+    return atlasBytes + _stagingPixels.capacity() + _textureCache.capacity() * sizeof(AtlasTextureInfo)
+        + _glyphTextureMap.size() * sizeof(decltype(_glyphTextureMap)::value_type) + sizeof(_indexMap);
+}
+
+void TextureCache::FlushUploads()
+{
+    unique_lock lock(_mutex);
+
+    ProcessPendingUploads();
+}
+
 void TextureCache::InvalidateImage(ImageIndex image)
 {
     unique_lock lock(_mutex);
@@ -38,10 +69,22 @@ void TextureCache::InvalidateImage(ImageIndex image)
     if (index == UNUSED_INDEX)
         return;
 
-    AtlasTextureInfo& elem = _textureCache.at(index);
-
+    const AtlasTextureInfo& elem = _textureCache.at(index);
     _atlases[elem.index].Free(elem);
-    _indexMap[image] = UNUSED_INDEX;
+    RemoveTextureCacheEntry(index);
+
+    // The image data may no longer be valid once invalidated, do not decode it anymore.
+    _pendingUploads.erase(
+        std::remove_if(
+            _pendingUploads.begin(), _pendingUploads.end(),
+            [image](const PendingUpload& upload) { return upload.image.has_value() && upload.image->GetIndex() == image; }),
+        _pendingUploads.end());
+}
+
+void TextureCache::RemoveTextureCacheEntry(uint32_t index)
+{
+    AtlasTextureInfo& elem = _textureCache[index];
+    _indexMap[elem.image] = UNUSED_INDEX;
 
     if (index == _textureCache.size() - 1)
     {
@@ -76,6 +119,7 @@ BasicTextureInfo TextureCache::GetOrLoadImageTexture(ImageId imageId)
         if (index != UNUSED_INDEX)
         {
             const auto& info = _textureCache[index];
+            MarkAtlasUsed(info.index);
             return {
                 info.index,
                 info.normalizedBounds,
@@ -83,9 +127,18 @@ BasicTextureInfo TextureCache::GetOrLoadImageTexture(ImageId imageId)
         }
     }
 
-    // Load new texture.
+    // Load new texture, unless another thread loaded it in the meantime.
     unique_lock lock(_mutex);
 
+    index = _indexMap[imageId.GetIndex()];
+    if (index != UNUSED_INDEX)
+    {
+        const auto& info = _textureCache[index];
+        return {
+            info.index,
+            info.normalizedBounds,
+        };
+    }
     index = static_cast<uint32_t>(_textureCache.size());
 
     AtlasTextureInfo info = LoadImageTexture(imageId);
@@ -116,6 +169,7 @@ BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(ImageId imageId, const Pale
         if (kvp != _glyphTextureMap.end())
         {
             const auto& info = kvp->second;
+            MarkAtlasUsed(info.index);
             return {
                 info.index,
                 info.normalizedBounds,
@@ -123,9 +177,15 @@ BasicTextureInfo TextureCache::GetOrLoadGlyphTexture(ImageId imageId, const Pale
         }
     }
 
-    // Load new texture.
+    // Load new texture, unless another thread loaded it in the meantime.
     unique_lock lock(_mutex);
 
+    auto kvp = _glyphTextureMap.find(glyphId);
+    if (kvp != _glyphTextureMap.end())
+    {
+        return kvp->second;
+    }
+
     auto cacheInfo = LoadGlyphTexture(imageId, paletteMap);
     auto it = _glyphTextureMap.insert(std::make_pair(glyphId, cacheInfo));
 
@@ -144,6 +204,7 @@ BasicTextureInfo TextureCache::GetOrLoadBitmapTexture(ImageIndex image, const vo
         if (index != UNUSED_INDEX)
         {
             const auto& info = _textureCache[index];
+            MarkAtlasUsed(info.index);
             return {
                 info.index,
                 info.normalizedBounds,
@@ -151,9 +212,18 @@ BasicTextureInfo TextureCache::GetOrLoadBitmapTexture(ImageIndex image, const vo
         }
     }
 
-    // Load new texture.
+    // Load new texture, unless another thread loaded it in the meantime.
     unique_lock lock(_mutex);
 
+    index = _indexMap[image];
+    if (index != UNUSED_INDEX)
+    {
+        const auto& info = _textureCache[index];
+        return {
+            info.index,
+            info.normalizedBounds,
+        };
+    }
     index = uint32_t(_textureCache.size());
 
     AtlasTextureInfo info = LoadBitmapTexture(image, pixels, width, height);
@@ -179,6 +249,9 @@ void TextureCache::CreateTextures()
         glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &_atlasesTextureIndicesLimit);
         if (_atlasesTextureDimensions < _atlasesTextureIndicesLimit)
             _atlasesTextureIndicesLimit = _atlasesTextureDimensions;
+        if (_atlasesTextureIndicesLimit > TEXTURE_CACHE_MAX_ATLAS_COUNT)
+            _atlasesTextureIndicesLimit = TEXTURE_CACHE_MAX_ATLAS_COUNT;
+        _atlasLastUsedFrame = std::vector<std::atomic<uint32_t>>(_atlasesTextureIndicesLimit);
 
         glGenTextures(1, &_atlasesTexture);
         glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
@@ -229,56 +302,53 @@ void TextureCache::GeneratePaletteTexture()
     DeleteDPI(dpi);
 }
 
-void TextureCache::EnlargeAtlasesTexture(GLuint newEntries)
+void TextureCache::EnlargeAtlasesTexture()
 {
-    CreateTextures();
-
-    GLuint newIndices = _atlasesTextureIndices + newEntries;
-
-    std::vector<char> oldPixels;
+    // Atlases may be added while commands are recorded on other threads, the texture only grows on the GL thread.
+    if (_atlasesTextureIndices <= _atlasesTextureCapacity)
+    {
+        return;
+    }
 
-    if (newIndices > _atlasesTextureCapacity)
+    // Retrieve current array data, growing buffer. Queued pixels are uploaded after the texture has grown.
+    const auto oldCapacity = _atlasesTextureCapacity;
+    std::vector<char> oldPixels(_atlasesTextureDimensions * _atlasesTextureDimensions * oldCapacity);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
+    if (!oldPixels.empty())
     {
-        // Retrieve current array data, growing buffer.
-        oldPixels.resize(_atlasesTextureDimensions * _atlasesTextureDimensions * _atlasesTextureCapacity);
-        if (!oldPixels.empty())
-        {
-            glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
-        }
+        glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+    }
 
-        // Initial capacity will be 12 which covers most cases of a fully visible park.
+    // Initial capacity will be 12 which covers most cases of a fully visible park.
+    while (_atlasesTextureCapacity < _atlasesTextureIndices)
+    {
         _atlasesTextureCapacity = (_atlasesTextureCapacity + 6) << 1UL;
+    }
 
-        glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-        glTexImage3D(
-            GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
-            GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+    glTexImage3D(
+        GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureCapacity, 0,
+        GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
 
-        // Restore old data
-        if (!oldPixels.empty())
-        {
-            glTexSubImage3D(
-                GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, _atlasesTextureDimensions, _atlasesTextureDimensions, _atlasesTextureIndices,
-                GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
-        }
+    // Restore old data
+    if (!oldPixels.empty())
+    {
+        glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, _atlasesTextureDimensions, _atlasesTextureDimensions, oldCapacity,
+            GL_RED_INTEGER, GL_UNSIGNED_BYTE, oldPixels.data());
+        _stats.UploadedBytes += oldPixels.size();
+        _stats.Uploads++;
     }
-
-    _atlasesTextureIndices = newIndices;
 }
 
 AtlasTextureInfo TextureCache::LoadImageTexture(ImageId imageId)
 {
-    rct_drawpixelinfo dpi = GetImageAsDPI(ImageId(imageId.GetIndex()));
+    auto g1Element = gfx_get_g1_element(ImageId(imageId.GetIndex()));
 
-    auto cacheInfo = AllocateImage(dpi.width, dpi.height);
+    auto cacheInfo = AllocateImage(g1Element->width, g1Element->height);
     cacheInfo.image = imageId.GetIndex();
 
-    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-    glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
-
-    DeleteDPI(dpi);
+    // Only reserve the space, the image is decoded together with the other new images in the frame when flushing.
+    QueueUpload(cacheInfo, ImageId(imageId.GetIndex()));
 
     return cacheInfo;
 }
@@ -290,10 +360,7 @@ AtlasTextureInfo TextureCache::LoadGlyphTexture(ImageId imageId, const PaletteMa
     auto cacheInfo = AllocateImage(dpi.width, dpi.height);
     cacheInfo.image = imageId.GetIndex();
 
-    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-    glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
+    std::copy_n(dpi.bits, dpi.width * dpi.height, QueueUpload(cacheInfo, std::nullopt));
 
     DeleteDPI(dpi);
 
@@ -304,58 +371,216 @@ AtlasTextureInfo TextureCache::LoadBitmapTexture(ImageIndex image, const void* p
 {
     auto cacheInfo = AllocateImage(int32_t(width), int32_t(height));
     cacheInfo.image = image;
-    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
-    glTexSubImage3D(
-        GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, GLsizei(width), GLsizei(height), 1,
-        GL_RED_INTEGER, GL_UNSIGNED_BYTE, reinterpret_cast<const GLvoid*>(pixels));
+    std::copy_n(static_cast<const uint8_t*>(pixels), width * height, QueueUpload(cacheInfo, std::nullopt));
     return cacheInfo;
 }
 
+uint8_t* TextureCache::QueueUpload(const AtlasTextureInfo& info, std::optional<ImageId> image)
+{
+    const auto offset = _stagingPixels.size();
+    const auto size = static_cast<size_t>(info.bounds.z - info.bounds.x) * (info.bounds.w - info.bounds.y);
+    _stagingPixels.resize(offset + size);
+    _pendingUploads.push_back({ info.bounds, info.index, offset, image });
+    return _stagingPixels.data() + offset;
+}
+
+void TextureCache::ProcessPendingUploads()
+{
+    EnlargeAtlasesTexture();
+    if (_pendingUploads.empty())
+    {
+        return;
+    }
+
+    DecodePendingImages();
+    UploadPendingPixels();
+
+    _pendingUploads.clear();
+    _stagingPixels.clear();
+}
+
+void TextureCache::DecodePendingImages()
+{
+    auto numImages = std::count_if(_pendingUploads.begin(), _pendingUploads.end(), [](const PendingUpload& upload) {
+        return upload.image.has_value();
+    });
+    if (numImages == 0)
+    {
+        return;
+    }
+
+    // Every image decodes into its own part of the staging buffer.
+    if (static_cast<size_t>(numImages) < PARALLEL_DECODE_THRESHOLD)
+    {
+        for (const auto& upload : _pendingUploads)
+        {
+            if (upload.image.has_value())
+            {
+                DrawImageToBuffer(*upload.image, _stagingPixels.data() + upload.offset);
+            }
+        }
+    }
+    else
+    {
+        if (_decodeJobs == nullptr)
+        {
+            _decodeJobs = std::make_unique<JobPool>(255, "Texture");
+        }
+        for (const auto& upload : _pendingUploads)
+        {
+            if (upload.image.has_value())
+            {
+                auto* pixels = _stagingPixels.data() + upload.offset;
+                _decodeJobs->AddTask([image = *upload.image, pixels]() { DrawImageToBuffer(image, pixels); });
+            }
+        }
+        _decodeJobs->Join();
+    }
+}
+
+void TextureCache::UploadPendingPixels()
+{
+    // Stream all pixels of the flush through one pixel buffer so the texture transfers do not stall drawing.
+    if (_pixelUnpackBuffer == 0)
+    {
+        glGenBuffers(1, &_pixelUnpackBuffer);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelUnpackBuffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, _stagingPixels.size(), _stagingPixels.data(), GL_STREAM_DRAW);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _atlasesTexture);
+    for (const auto& upload : _pendingUploads)
+    {
+        const auto& bounds = upload.bounds;
+        glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY, 0, bounds.x, bounds.y, upload.index, bounds.z - bounds.x, bounds.w - bounds.y, 1,
+            GL_RED_INTEGER, GL_UNSIGNED_BYTE, reinterpret_cast<const GLvoid*>(upload.offset));
+    }
+
+    // Other uploads read from client memory, which requires no pixel buffer to be bound.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    _stats.UploadedBytes += _stagingPixels.size();
+    _stats.Uploads += static_cast<uint32_t>(_pendingUploads.size());
+}
+
 AtlasTextureInfo TextureCache::AllocateImage(int32_t imageWidth, int32_t imageHeight)
 {
     CreateTextures();
 
+    if (imageWidth > _atlasesTextureDimensions || imageHeight > _atlasesTextureDimensions)
+    {
+        throw std::runtime_error("image does not fit into a texture atlas!");
+    }
+
     // Find an atlas that fits this image
     for (Atlas& atlas : _atlases)
     {
-        if (atlas.GetFreeSlots() > 0 && atlas.IsImageSuitable(imageWidth, imageHeight))
+        auto info = atlas.Allocate(imageWidth, imageHeight);
+        if (info.has_value())
         {
-            return atlas.Allocate(imageWidth, imageHeight);
+            MarkAtlasUsed(info->index);
+            return *info;
         }
     }
 
-    // If there is no such atlas, then create a new one
-    if (static_cast<int32_t>(_atlases.size()) >= _atlasesTextureIndicesLimit)
+    GLuint atlasIndex;
+    if (static_cast<int32_t>(_atlases.size()) < _atlasesTextureIndicesLimit)
     {
-        throw std::runtime_error("more texture atlases required, but device limit reached!");
-    }
-
-    auto atlasIndex = static_cast<int32_t>(_atlases.size());
-    int32_t atlasSize = powf(2, static_cast<float>(Atlas::CalculateImageSizeOrder(imageWidth, imageHeight)));
+        // If there is no such atlas, then create a new one
+        atlasIndex = static_cast<GLuint>(_atlases.size());
 
 #    ifdef DEBUG
-    log_verbose("new texture atlas #%d (size %d) allocated", atlasIndex, atlasSize);
+        log_verbose("new texture atlas #%u allocated", atlasIndex);
 #    endif
 
-    _atlases.emplace_back(atlasIndex, atlasSize);
-    _atlases.back().Initialise(_atlasesTextureDimensions, _atlasesTextureDimensions);
+        _atlases.emplace_back(atlasIndex);
+        _atlases.back().Initialise(_atlasesTextureDimensions, _atlasesTextureDimensions);
 
-    // Enlarge texture array to support new atlas
-    EnlargeAtlasesTexture(1);
+        // The texture array is enlarged to support the new atlas at the next flush.
+        _atlasesTextureIndices++;
+    }
+    else
+    {
+        // All atlases are full, reuse the one that has not been drawn from for the longest time
+        auto lruAtlas = FindLeastRecentlyUsedAtlas();
+        if (!lruAtlas.has_value())
+        {
+            throw std::runtime_error("more texture atlases required, but all of them are used by the current frame!");
+        }
+        atlasIndex = *lruAtlas;
+        EvictAtlas(atlasIndex);
+    }
 
     // And allocate from the new atlas
-    return _atlases.back().Allocate(imageWidth, imageHeight);
+    MarkAtlasUsed(atlasIndex);
+    return _atlases[atlasIndex].Allocate(imageWidth, imageHeight).value();
+}
+
+void TextureCache::MarkAtlasUsed(GLuint atlasIndex)
+{
+    _atlasLastUsedFrame[atlasIndex].store(_currentFrame, std::memory_order_relaxed);
+}
+
+std::optional<GLuint> TextureCache::FindLeastRecentlyUsedAtlas() const
+{
+    // Atlases used by the current frame can not be evicted, their images may still be waiting to be drawn.
+    std::optional<GLuint> result;
+    uint32_t oldestFrame = _currentFrame;
+    for (GLuint i = 0; i < _atlases.size(); i++)
+    {
+        auto lastUsedFrame = _atlasLastUsedFrame[i].load(std::memory_order_relaxed);
+        if (lastUsedFrame < oldestFrame)
+        {
+            oldestFrame = lastUsedFrame;
+            result = i;
+        }
+    }
+    return result;
 }
 
-rct_drawpixelinfo TextureCache::GetImageAsDPI(ImageId imageId)
+void TextureCache::EvictAtlas(GLuint atlasIndex)
+{
+    // Iterate backwards, removing an entry moves the last entry into its place which has already been checked.
+    for (auto i = _textureCache.size(); i > 0; i--)
+    {
+        if (_textureCache[i - 1].index == atlasIndex)
+        {
+            RemoveTextureCacheEntry(static_cast<uint32_t>(i - 1));
+        }
+    }
+    for (auto it = _glyphTextureMap.begin(); it != _glyphTextureMap.end();)
+    {
+        if (it->second.index == atlasIndex)
+        {
+            it = _glyphTextureMap.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    _atlases[atlasIndex].Reset();
+    _stats.Evictions++;
+
+    log_verbose(
+        "texture atlas #%u evicted, %u evictions, %llu bytes uploaded", atlasIndex, _stats.Evictions,
+        static_cast<unsigned long long>(_stats.UploadedBytes));
+}
+
+void TextureCache::DrawImageToBuffer(ImageId imageId, uint8_t* pixels)
 {
     auto g1Element = gfx_get_g1_element(imageId);
-    int32_t width = g1Element->width;
-    int32_t height = g1Element->height;
 
-    rct_drawpixelinfo dpi = CreateDPI(width, height);
+    rct_drawpixelinfo dpi;
+    dpi.bits = pixels;
+    dpi.pitch = 0;
+    dpi.x = 0;
+    dpi.y = 0;
+    dpi.width = g1Element->width;
+    dpi.height = g1Element->height;
+    dpi.zoom_level = ZoomLevel{ 0 };
     gfx_draw_sprite_software(&dpi, imageId, { -g1Element->x_offset, -g1Element->y_offset });
-    return dpi;
 }
 
 rct_drawpixelinfo TextureCache::GetGlyphAsDPI(ImageId imageId, const PaletteMap& palette)
@@ -375,6 +600,9 @@ void TextureCache::FreeTextures()
 {
     // Free array texture
     glDeleteTextures(1, &_atlasesTexture);
+    glDeleteBuffers(1, &_pixelUnpackBuffer);
+    _pendingUploads.clear();
+    _stagingPixels.clear();
     _textureCache.clear();
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
 }
@@ -411,6 +639,22 @@ GLuint TextureCache::GetPaletteTexture()
     return _paletteTexture;
 }
 
+TextureCacheStats TextureCache::GetStats()
+{
+    shared_lock lock(_mutex);
+
+    auto stats = _stats;
+    stats.Atlases = static_cast<uint32_t>(_atlases.size());
+    stats.AtlasCapacity = _atlasesTextureCapacity;
+    stats.UsedPixels = 0;
+    for (const auto& atlas : _atlases)
+    {
+        stats.UsedPixels += atlas.GetUsedPixels();
+    }
+    stats.TotalPixels = static_cast<uint64_t>(_atlasesTextureDimensions) * _atlasesTextureDimensions * _atlases.size();
+    return stats;
+}
+
 GLint TextureCache::PaletteToY(FilterPaletteID palette)
 {
     return palette > FilterPaletteID::PaletteWater ? EnumValue(palette) + 5 : EnumValue(palette) + 1;
@@ -15,16 +15,21 @@
 #include <SDL_pixels.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <openrct2/common.h>
+#include <openrct2/core/MemoryAccounting.h>
 #include <openrct2/drawing/Drawing.h>
 #include <openrct2/sprites.h>
+#include <optional>
 #ifndef __MACOSX__
 #    include <shared_mutex>
 #endif
 #include <unordered_map>
 #include <vector>
 
+class JobPool;
 struct rct_drawpixelinfo;
 struct PaletteMap;
 enum class FilterPaletteID : int32_t;
@@ -58,9 +63,12 @@ struct GlyphId
 // granularity at which new atlases are allocated (2048 -> 4 MB of VRAM)
 constexpr int32_t TEXTURE_CACHE_MAX_ATLAS_SIZE = 2048;
 
-// Pixel dimensions of smallest supported slots in texture atlases
-// Must be a power of 2!
-constexpr int32_t TEXTURE_CACHE_SMALLEST_SLOT = 32;
+// Maximum number of atlases, once reached the least recently used atlas is evicted
+// instead of growing the texture array (36 * 4 MB -> 144 MB of VRAM)
+constexpr int32_t TEXTURE_CACHE_MAX_ATLAS_COUNT = 36;
+
+// Shelf heights are rounded up to a multiple of this so images of similar heights share a shelf
+constexpr int32_t TEXTURE_CACHE_SHELF_GRANULARITY = 8;
 
 struct BasicTextureInfo
 {
@@ -68,33 +76,55 @@ struct BasicTextureInfo
     vec4 normalizedBounds;
 };
 
-// Location of an image (texture atlas index, slot and normalized coordinates)
+// Location of an image (texture atlas index and normalized coordinates)
 struct AtlasTextureInfo : public BasicTextureInfo
 {
-    GLuint slot;
     ivec4 bounds;
     ImageIndex image;
 };
 
-// Represents a texture atlas that images of a given maximum size can be allocated from
+struct TextureCacheStats
+{
+    uint32_t Atlases;
+    uint32_t AtlasCapacity;
+    uint64_t UsedPixels;
+    uint64_t TotalPixels;
+    uint64_t UploadedBytes;
+    uint32_t Uploads;
+    uint32_t Evictions;
+};
+
+// Represents a texture atlas that images of any size can be allocated from
 // Atlases are all stored in the same 2D texture array, occupying the specified index
-// Slots in atlases are always squares.
+// Images are packed left to right on shelves, rows spanning the atlas width that hold
+// images of a similar height. Space freed on a shelf is reused by images that fit in it.
 class Atlas final
 {
 private:
+    struct Span
+    {
+        int32_t x;
+        int32_t width;
+    };
+
+    struct Shelf
+    {
+        int32_t y;
+        int32_t height;
+        int32_t used;
+        int32_t numImages;
+        std::vector<Span> freeSpans;
+    };
+
     GLuint _index = 0;
-    int32_t _imageSize = 0;
     int32_t _atlasWidth = 0;
     int32_t _atlasHeight = 0;
-    std::vector<GLuint> _freeSlots;
-
-    int32_t _cols = 0;
-    int32_t _rows = 0;
+    std::vector<Shelf> _shelves;
+    uint64_t _usedPixels = 0;
 
 public:
-    Atlas(GLuint index, int32_t imageSize)
+    explicit Atlas(GLuint index)
         : _index(index)
-        , _imageSize(imageSize)
     {
     }
 
@@ -102,32 +132,47 @@ public:
     {
         _atlasWidth = atlasWidth;
         _atlasHeight = atlasHeight;
+        Reset();
+    }
 
-        _cols = std::max(1, _atlasWidth / _imageSize);
-        _rows = std::max(1, _atlasHeight / _imageSize);
-
-        _freeSlots.resize(_cols * _rows);
-        for (size_t i = 0; i < _freeSlots.size(); i++)
-        {
-            _freeSlots[i] = static_cast<GLuint>(i);
-        }
+    void Reset()
+    {
+        _shelves.clear();
+        _usedPixels = 0;
     }
 
-    AtlasTextureInfo Allocate(int32_t actualWidth, int32_t actualHeight)
+    std::optional<AtlasTextureInfo> Allocate(int32_t actualWidth, int32_t actualHeight)
     {
-        assert(!_freeSlots.empty());
+        const auto width = std::max(1, actualWidth);
+        const auto height = std::max(1, actualHeight);
+        const auto shelfHeight = GetShelfHeight(height);
+
+        // Prefer a shelf of the right height, then a new shelf and only then waste space on a taller shelf
+        auto x = AllocateOnShelf(width, [shelfHeight](const Shelf& shelf) { return shelf.height == shelfHeight; });
+        if (!x)
+        {
+            x = AllocateOnNewShelf(width, shelfHeight);
+        }
+        if (!x)
+        {
+            x = AllocateOnShelf(width, [height](const Shelf& shelf) { return shelf.height >= height; });
+        }
+        if (!x)
+        {
+            return std::nullopt;
+        }
 
-        GLuint slot = _freeSlots.back();
-        _freeSlots.pop_back();
+        const auto& [shelfIndex, shelfX] = *x;
+        auto& shelf = _shelves[shelfIndex];
+        shelf.numImages++;
+        _usedPixels += static_cast<uint64_t>(width) * height;
 
-        auto bounds = GetSlotCoordinates(slot, actualWidth, actualHeight);
+        ivec4 bounds{ shelfX, shelf.y, shelfX + actualWidth, shelf.y + actualHeight };
 
         AtlasTextureInfo info{};
         info.index = _index;
-        info.slot = slot;
         info.bounds = bounds;
         info.normalizedBounds = NormalizeCoordinates(bounds);
-
         return info;
     }
 
@@ -135,48 +180,97 @@ public:
     {
         assert(_index == info.index);
 
-        _freeSlots.push_back(info.slot);
+        const auto width = std::max(1, info.bounds.z - info.bounds.x);
+        const auto height = std::max(1, info.bounds.w - info.bounds.y);
+        auto it = std::find_if(_shelves.begin(), _shelves.end(), [&info](const Shelf& shelf) {
+            return shelf.y == info.bounds.y;
+        });
+        assert(it != _shelves.end());
+
+        auto& shelf = *it;
+        _usedPixels -= static_cast<uint64_t>(width) * height;
+        shelf.numImages--;
+        if (shelf.numImages == 0)
+        {
+            shelf.used = 0;
+            shelf.freeSpans.clear();
+        }
+        else if (info.bounds.x + width == shelf.used)
+        {
+            shelf.used = info.bounds.x;
+        }
+        else
+        {
+            shelf.freeSpans.push_back({ info.bounds.x, width });
+        }
+
+        // Give the vertical space of empty shelves at the end back to the atlas
+        while (!_shelves.empty() && _shelves.back().numImages == 0)
+        {
+            _shelves.pop_back();
+        }
     }
 
-    // Checks if specified image would be tightly packed in this atlas
-    // by checking if it is within the right power of 2 range
-    [[nodiscard]] bool IsImageSuitable(int32_t actualWidth, int32_t actualHeight) const
+    [[nodiscard]] uint64_t GetUsedPixels() const
     {
-        int32_t imageOrder = CalculateImageSizeOrder(actualWidth, actualHeight);
-        int32_t atlasOrder = log2(_imageSize);
-
-        return imageOrder == atlasOrder;
+        return _usedPixels;
     }
 
-    [[nodiscard]] int32_t GetFreeSlots() const
+private:
+    static int32_t GetShelfHeight(int32_t height)
     {
-        return static_cast<int32_t>(_freeSlots.size());
+        return (height + TEXTURE_CACHE_SHELF_GRANULARITY - 1) / TEXTURE_CACHE_SHELF_GRANULARITY
+            * TEXTURE_CACHE_SHELF_GRANULARITY;
     }
 
-    static int32_t CalculateImageSizeOrder(int32_t actualWidth, int32_t actualHeight)
+    template<typename TPredicate>
+    std::optional<std::pair<size_t, int32_t>> AllocateOnShelf(int32_t width, TPredicate predicate)
     {
-        int32_t actualSize = std::max(actualWidth, actualHeight);
-
-        if (actualSize < TEXTURE_CACHE_SMALLEST_SLOT)
+        for (size_t i = 0; i < _shelves.size(); i++)
         {
-            actualSize = TEXTURE_CACHE_SMALLEST_SLOT;
+            auto& shelf = _shelves[i];
+            if (!predicate(shelf))
+            {
+                continue;
+            }
+
+            // Reuse freed space first to keep the shelf compact
+            for (auto& span : shelf.freeSpans)
+            {
+                if (span.width >= width)
+                {
+                    auto x = span.x;
+                    span.x += width;
+                    span.width -= width;
+                    if (span.width == 0)
+                    {
+                        span = shelf.freeSpans.back();
+                        shelf.freeSpans.pop_back();
+                    }
+                    return std::make_pair(i, x);
+                }
+            }
+
+            if (shelf.used + width <= _atlasWidth)
+            {
+                auto x = shelf.used;
+                shelf.used += width;
+                return std::make_pair(i, x);
+            }
         }
-
-        return static_cast<int32_t>(ceil(log2f(static_cast<float>(actualSize))));
+        return std::nullopt;
     }
 
-private:
-    [[nodiscard]] ivec4 GetSlotCoordinates(GLuint slot, int32_t actualWidth, int32_t actualHeight) const
+    std::optional<std::pair<size_t, int32_t>> AllocateOnNewShelf(int32_t width, int32_t shelfHeight)
     {
-        int32_t row = slot / _cols;
-        int32_t col = slot % _cols;
-
-        return ivec4{
-            _imageSize * col,
-            _imageSize * row,
-            _imageSize * col + actualWidth,
-            _imageSize * row + actualHeight,
-        };
+        const auto y = _shelves.empty() ? 0 : _shelves.back().y + _shelves.back().height;
+        if (width > _atlasWidth || y + shelfHeight > _atlasHeight)
+        {
+            return std::nullopt;
+        }
+
+        _shelves.push_back({ y, shelfHeight, width, 0, {} });
+        return std::make_pair(_shelves.size() - 1, 0);
     }
 
     [[nodiscard]] vec4 NormalizeCoordinates(const ivec4& coords) const
@@ -193,6 +287,16 @@ private:
 class TextureCache final
 {
 private:
+    // Pixels for a region of an atlas that are uploaded at the next flush
+    struct PendingUpload
+    {
+        ivec4 bounds;
+        GLuint index;
+        size_t offset;
+        // Image that still has to be decoded into the staging buffer
+        std::optional<ImageId> image;
+    };
+
     bool _initialized = false;
 
     GLuint _atlasesTexture = 0;
@@ -201,12 +305,22 @@ private:
     GLuint _atlasesTextureIndices = 0;
     GLint _atlasesTextureIndicesLimit = 0;
     std::vector<Atlas> _atlases;
+    // Frame each atlas was last drawn from, written by concurrent readers
+    std::vector<std::atomic<uint32_t>> _atlasLastUsedFrame;
+    uint32_t _currentFrame = 1;
+    TextureCacheStats _stats{};
     std::unordered_map<GlyphId, AtlasTextureInfo, GlyphId::Hash, GlyphId::Equal> _glyphTextureMap;
     std::vector<AtlasTextureInfo> _textureCache;
     std::array<uint32_t, SPR_IMAGE_LIST_END> _indexMap;
 
     GLuint _paletteTexture = 0;
 
+    std::vector<PendingUpload> _pendingUploads;
+    std::vector<uint8_t> _stagingPixels;
+    GLuint _pixelUnpackBuffer = 0;
+    std::unique_ptr<JobPool> _decodeJobs;
+    OpenRCT2::MemoryAccounting::Registration _memoryRegistration;
+
 #ifndef __MACOSX__
     std::shared_mutex _mutex;
     using shared_lock = std::shared_lock<std::shared_mutex>;
@@ -220,6 +334,9 @@ private:
 public:
     TextureCache();
     ~TextureCache();
+    void BeginFrame();
+    size_t GetMemoryUsage();
+    void FlushUploads();
     void InvalidateImage(ImageIndex image);
     BasicTextureInfo GetOrLoadImageTexture(ImageId imageId);
     BasicTextureInfo GetOrLoadGlyphTexture(ImageId imageId, const PaletteMap& paletteMap);
@@ -227,17 +344,26 @@ public:
 
     GLuint GetAtlasesTexture();
     GLuint GetPaletteTexture();
+    TextureCacheStats GetStats();
     static GLint PaletteToY(FilterPaletteID palette);
 
 private:
     void CreateTextures();
     void GeneratePaletteTexture();
-    void EnlargeAtlasesTexture(GLuint newEntries);
+    void EnlargeAtlasesTexture();
     AtlasTextureInfo LoadImageTexture(ImageId image);
     AtlasTextureInfo LoadGlyphTexture(ImageId image, const PaletteMap& paletteMap);
     AtlasTextureInfo AllocateImage(int32_t imageWidth, int32_t imageHeight);
+    void MarkAtlasUsed(GLuint atlasIndex);
+    std::optional<GLuint> FindLeastRecentlyUsedAtlas() const;
+    void EvictAtlas(GLuint atlasIndex);
+    void RemoveTextureCacheEntry(uint32_t index);
+    uint8_t* QueueUpload(const AtlasTextureInfo& info, std::optional<ImageId> image);
+    void ProcessPendingUploads();
+    void DecodePendingImages();
+    void UploadPendingPixels();
     AtlasTextureInfo LoadBitmapTexture(ImageIndex image, const void* pixels, size_t width, size_t height);
-    static rct_drawpixelinfo GetImageAsDPI(ImageId imageId);
+    static void DrawImageToBuffer(ImageId imageId, uint8_t* pixels);
     static rct_drawpixelinfo GetGlyphAsDPI(ImageId imageId, const PaletteMap& paletteMap);
     void FreeTextures();
 
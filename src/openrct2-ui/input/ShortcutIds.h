@@ -116,5 +116,6 @@ namespace OpenRCT2::Ui::ShortcutId
     // Debug
     constexpr std::string_view DebugToggleConsole = "debug.console";
     constexpr std::string_view DebugTogglePaintDebugWindow = "debug.toggle_paint_debug_window";
+    constexpr std::string_view DebugTogglePerformanceWindow = "debug.toggle_performance_window";
     constexpr std::string_view DebugAdvanceTick = "debug.advance_tick";
 } // namespace OpenRCT2::Ui::ShortcutId
@@ -905,5 +905,19 @@ void ShortcutManager::RegisterDefaultShortcuts()
             }
         }
     });
+    RegisterShortcut(ShortcutId::DebugTogglePerformanceWindow, STR_SHORTCUT_DEBUG_PERFORMANCE_TOGGLE, []() {
+        if (!(gScreenFlags & SCREEN_FLAGS_TITLE_DEMO))
+        {
+            auto window = window_find_by_class(WC_PERFORMANCE);
+            if (window != nullptr)
+            {
+                window_close(window);
+            }
+            else
+            {
+                context_open_window(WC_PERFORMANCE);
+            }
+        }
+    });
     // clang-format on
 }
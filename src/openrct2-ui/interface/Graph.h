@@ -15,7 +15,7 @@
 
 namespace Graph
 {
-    void Draw(rct_drawpixelinfo* dpi, uint8_t* history, int32_t count, const ScreenCoordsXY& screenPos);
+    void Draw(rct_drawpixelinfo* dpi, const uint8_t* history, int32_t count, const ScreenCoordsXY& screenPos);
     void Draw(
         rct_drawpixelinfo* dpi, const money64* history, const int32_t count, const ScreenCoordsXY& coords,
         const int32_t modifier, const int32_t offset);
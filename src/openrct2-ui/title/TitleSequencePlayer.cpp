@@ -12,6 +12,7 @@
 #include "../interface/Window.h"
 
 #include <algorithm>
+#include <future>
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
@@ -28,6 +29,8 @@
 #include <openrct2/interface/Window.h>
 #include <openrct2/management/NewsItem.h>
 #include <openrct2/object/ObjectManager.h>
+#include <openrct2/object/ObjectRepository.h>
+#include <openrct2/object/PackedObjectRecorder.h>
 #include <openrct2/scenario/ScenarioRepository.h>
 #include <openrct2/scenario/ScenarioSources.h>
 #include <openrct2/title/TitleScreen.h>
@@ -42,6 +45,23 @@
 
 using namespace OpenRCT2;
 
+/**
+ * A park of the sequence read and decoded on a worker thread, so only the import is left when its load command is reached.
+ */
+struct TitleSequencePreloadedPark
+{
+    std::string HintPath;
+    // Declared before the importer which keeps a reference to it.
+    PackedObjectRecorder PackedObjects;
+    std::unique_ptr<IParkImporter> Importer;
+    ObjectList RequiredObjects;
+
+    explicit TitleSequencePreloadedPark(IObjectRepository& objectRepository)
+        : PackedObjects(objectRepository)
+    {
+    }
+};
+
 class TitleSequencePlayer final : public ITitleSequencePlayer
 {
 private:
@@ -51,6 +71,9 @@ private:
     int32_t _position = 0;
     int32_t _waitCounter = 0;
 
+    int32_t _preloadPosition = -1;
+    std::future<std::unique_ptr<TitleSequencePreloadedPark>> _preloadedPark;
+
     int32_t _lastScreenWidth = 0;
     int32_t _lastScreenHeight = 0;
     CoordsXY _viewCentreLocation = {};
@@ -73,6 +96,8 @@ public:
 
     void Eject() override
     {
+        // The worker reads from the sequence, so it has to finish first.
+        DiscardPreloadedPark();
         _sequence = nullptr;
     }
 
@@ -283,11 +308,20 @@ private:
             {
                 bool loadSuccess = false;
                 uint8_t saveIndex = command.SaveIndex;
-                auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
-                if (parkHandle != nullptr)
+                auto preloadedPark = TakePreloadedPark(_position);
+                if (preloadedPark != nullptr)
+                {
+                    loadSuccess = LoadPreloadedPark(*preloadedPark);
+                }
+                else
                 {
-                    loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
+                    if (parkHandle != nullptr)
+                    {
+                        loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    }
                 }
+                PreloadNextPark();
                 if (!loadSuccess)
                 {
                     if (_sequence->Saves.size() > saveIndex)
@@ -429,6 +463,108 @@ private:
         return success;
     }
 
+    /**
+     * Starts reading the park of the next load command after the current position in the background.
+     * Parks are not preloaded when previewing in game, as those are loaded like any other park.
+     */
+    void PreloadNextPark()
+    {
+        if (gPreviewingTitleSequenceInGame)
+            return;
+
+        const auto numCommands = static_cast<int32_t>(_sequence->Commands.size());
+        for (int32_t i = 1; i <= numCommands; i++)
+        {
+            auto position = (_position + i) % numCommands;
+            const auto& command = _sequence->Commands[position];
+            if (!TitleSequenceIsLoadCommand(command))
+                continue;
+
+            // Scenarios are loaded from the scenario repository instead of the sequence
+            if (command.Type != TitleScript::Load || position == _preloadPosition)
+                return;
+
+            DiscardPreloadedPark();
+            const auto* sequence = _sequence.get();
+            auto* objectRepository = &GetContext()->GetObjectRepository();
+            auto saveIndex = command.SaveIndex;
+            _preloadPosition = position;
+            _preloadedPark = std::async(std::launch::async, [sequence, saveIndex, objectRepository]() {
+                return PreloadPark(*sequence, saveIndex, *objectRepository);
+            });
+            return;
+        }
+    }
+
+    static std::unique_ptr<TitleSequencePreloadedPark> PreloadPark(
+        const TitleSequence& sequence, uint8_t saveIndex, IObjectRepository& objectRepository)
+    {
+        auto parkHandle = TitleSequenceGetParkHandle(sequence, saveIndex);
+        if (parkHandle == nullptr)
+            return nullptr;
+
+        auto park = std::make_unique<TitleSequencePreloadedPark>(objectRepository);
+        try
+        {
+            park->HintPath = parkHandle->HintPath;
+            bool isScenario = ParkImporter::ExtensionIsScenario(park->HintPath);
+            park->Importer = ParkImporter::Create(park->HintPath, park->PackedObjects);
+            auto result = park->Importer->LoadFromStream(parkHandle->Stream.get(), isScenario);
+            park->RequiredObjects = std::move(result.RequiredObjects);
+        }
+        catch (const std::exception&)
+        {
+            // Loading it again when its command is reached reports the error.
+            return nullptr;
+        }
+        return park;
+    }
+
+    /**
+     * @return the park preloaded for the load command at the given position, or nullptr if it was not preloaded.
+     */
+    std::unique_ptr<TitleSequencePreloadedPark> TakePreloadedPark(int32_t position)
+    {
+        if (position != _preloadPosition || !_preloadedPark.valid())
+            return nullptr;
+
+        _preloadPosition = -1;
+        return _preloadedPark.get();
+    }
+
+    void DiscardPreloadedPark()
+    {
+        if (_preloadedPark.valid())
+        {
+            _preloadedPark.wait();
+            _preloadedPark = {};
+        }
+        _preloadPosition = -1;
+    }
+
+    bool LoadPreloadedPark(TitleSequencePreloadedPark& park)
+    {
+        log_verbose("TitleSequencePlayer::LoadPreloadedPark(%s)", park.HintPath.c_str());
+        bool success = false;
+        try
+        {
+            park.PackedObjects.AddPackedObjects();
+
+            // Objects still loaded from the previous park are kept, only the missing ones are read.
+            auto& objectManager = GetContext()->GetObjectManager();
+            objectManager.LoadObjects(park.RequiredObjects);
+
+            park.Importer->Import();
+            PrepareParkForPlayback();
+            success = true;
+        }
+        catch (const std::exception&)
+        {
+            Console::Error::WriteLine("Unable to load park: %s", park.HintPath.c_str());
+        }
+        return success;
+    }
+
     void CloseParkSpecificWindows()
     {
         window_close_by_class(WC_CONSTRUCT_RIDE);
@@ -16,6 +16,7 @@
 #include <openrct2/localisation/Localisation.h>
 #include <openrct2/localisation/LocalisationService.h>
 #include <openrct2/paint/Paint.h>
+#include <openrct2/paint/Painter.h>
 #include <openrct2/paint/tile_element/Paint.TileElement.h>
 #include <openrct2/ride/TrackPaint.h>
 
@@ -30,10 +31,11 @@ enum WindowDebugPaintWidgetIdx
     WIDX_TOGGLE_SHOW_SEGMENT_HEIGHTS,
     WIDX_TOGGLE_SHOW_BOUND_BOXES,
     WIDX_TOGGLE_SHOW_DIRTY_VISUALS,
+    WIDX_TOGGLE_SHOW_WINDOW_REPAINTS,
 };
 
 constexpr int32_t WINDOW_WIDTH = 200;
-constexpr int32_t WINDOW_HEIGHT = 8 + 15 + 15 + 15 + 15 + 11 + 8;
+constexpr int32_t WINDOW_HEIGHT = 8 + 15 + 15 + 15 + 15 + 15 + 15 + 11 + 8;
 
 static rct_widget window_debug_paint_widgets[] = {
     MakeWidget({0,          0}, {WINDOW_WIDTH, WINDOW_HEIGHT}, WindowWidgetType::Frame,    WindowColour::Primary                                        ),
@@ -42,16 +44,19 @@ static rct_widget window_debug_paint_widgets[] = {
     MakeWidget({8, 8 + 15 * 2}, {         185,            12}, WindowWidgetType::Checkbox, WindowColour::Secondary, STR_DEBUG_PAINT_SHOW_SEGMENT_HEIGHTS),
     MakeWidget({8, 8 + 15 * 3}, {         185,            12}, WindowWidgetType::Checkbox, WindowColour::Secondary, STR_DEBUG_PAINT_SHOW_BOUND_BOXES    ),
     MakeWidget({8, 8 + 15 * 4}, {         185,            12}, WindowWidgetType::Checkbox, WindowColour::Secondary, STR_DEBUG_PAINT_SHOW_DIRTY_VISUALS  ),
+    MakeWidget({8, 8 + 15 * 5}, {         185,            12}, WindowWidgetType::Checkbox, WindowColour::Secondary, STR_DEBUG_PAINT_SHOW_WINDOW_REPAINTS),
     WIDGETS_END,
 };
 
 static void WindowDebugPaintMouseup(rct_window * w, rct_widgetindex widgetIndex);
+static void WindowDebugPaintUpdate(rct_window * w);
 static void WindowDebugPaintInvalidate(rct_window * w);
 static void WindowDebugPaintPaint(rct_window * w, rct_drawpixelinfo * dpi);
 
 static rct_window_event_list window_debug_paint_events([](auto& events)
 {
     events.mouse_up = &WindowDebugPaintMouseup;
+    events.update = &WindowDebugPaintUpdate;
     events.invalidate = &WindowDebugPaintInvalidate;
     events.paint = &WindowDebugPaintPaint;
 });
@@ -73,7 +78,7 @@ rct_window* WindowDebugPaintOpen()
     window->widgets = window_debug_paint_widgets;
     window->enabled_widgets = (1ULL << WIDX_TOGGLE_SHOW_WIDE_PATHS) | (1ULL << WIDX_TOGGLE_SHOW_BLOCKED_TILES)
         | (1ULL << WIDX_TOGGLE_SHOW_BOUND_BOXES) | (1ULL << WIDX_TOGGLE_SHOW_SEGMENT_HEIGHTS)
-        | (1ULL << WIDX_TOGGLE_SHOW_DIRTY_VISUALS);
+        | (1ULL << WIDX_TOGGLE_SHOW_DIRTY_VISUALS) | (1ULL << WIDX_TOGGLE_SHOW_WINDOW_REPAINTS);
     WindowInitScrollWidgets(window);
     window_push_others_below(window);
 
@@ -112,9 +117,22 @@ static void WindowDebugPaintMouseup([[maybe_unused]] rct_window* w, rct_widgetin
             gShowDirtyVisuals = !gShowDirtyVisuals;
             gfx_invalidate_screen();
             break;
+
+        case WIDX_TOGGLE_SHOW_WINDOW_REPAINTS:
+            gShowWindowRepaints = !gShowWindowRepaints;
+            gfx_invalidate_screen();
+            break;
     }
 }
 
+static void WindowDebugPaintUpdate(rct_window* w)
+{
+    // Only repaint when the paint entry usage changes
+    const auto stats = OpenRCT2::GetContext()->GetPainter()->GetPaintEntryStats();
+    w->InvalidateIfChanged(
+        WindowContentHash().Add(stats.LastFrameEntries).Add(stats.PeakFrameEntries).Add(stats.ReservedEntries));
+}
+
 static void WindowDebugPaintInvalidate(rct_window* w)
 {
     const auto& ls = OpenRCT2::GetContext()->GetLocalisationService();
@@ -126,7 +144,7 @@ static void WindowDebugPaintInvalidate(rct_window* w)
 
         // Find the width of the longest string
         int16_t newWidth = 0;
-        for (size_t widgetIndex = WIDX_TOGGLE_SHOW_WIDE_PATHS; widgetIndex <= WIDX_TOGGLE_SHOW_DIRTY_VISUALS; widgetIndex++)
+        for (size_t widgetIndex = WIDX_TOGGLE_SHOW_WIDE_PATHS; widgetIndex <= WIDX_TOGGLE_SHOW_WINDOW_REPAINTS; widgetIndex++)
         {
             auto stringIdx = w->widgets[widgetIndex].text;
             auto string = ls.GetString(stringIdx);
@@ -147,6 +165,7 @@ static void WindowDebugPaintInvalidate(rct_window* w)
         w->widgets[WIDX_TOGGLE_SHOW_SEGMENT_HEIGHTS].right = newWidth - 8;
         w->widgets[WIDX_TOGGLE_SHOW_BOUND_BOXES].right = newWidth - 8;
         w->widgets[WIDX_TOGGLE_SHOW_DIRTY_VISUALS].right = newWidth - 8;
+        w->widgets[WIDX_TOGGLE_SHOW_WINDOW_REPAINTS].right = newWidth - 8;
 
         w->Invalidate();
     }
@@ -156,9 +175,20 @@ static void WindowDebugPaintInvalidate(rct_window* w)
     WidgetSetCheckboxValue(w, WIDX_TOGGLE_SHOW_SEGMENT_HEIGHTS, gShowSupportSegmentHeights);
     WidgetSetCheckboxValue(w, WIDX_TOGGLE_SHOW_BOUND_BOXES, gPaintBoundingBoxes);
     WidgetSetCheckboxValue(w, WIDX_TOGGLE_SHOW_DIRTY_VISUALS, gShowDirtyVisuals);
+    WidgetSetCheckboxValue(w, WIDX_TOGGLE_SHOW_WINDOW_REPAINTS, gShowWindowRepaints);
 }
 
 static void WindowDebugPaintPaint(rct_window* w, rct_drawpixelinfo* dpi)
 {
     WindowDrawWidgets(w, dpi);
+
+    const auto stats = OpenRCT2::GetContext()->GetPainter()->GetPaintEntryStats();
+    auto ft = Formatter();
+    ft.Add<uint32_t>(static_cast<uint32_t>(stats.LastFrameEntries));
+    ft.Add<uint32_t>(static_cast<uint32_t>(stats.PeakFrameEntries));
+    ft.Add<uint32_t>(static_cast<uint32_t>(stats.ReservedEntries));
+    const auto& lastWidget = w->widgets[WIDX_TOGGLE_SHOW_WINDOW_REPAINTS];
+    DrawTextBasic(
+        dpi, w->windowPos + ScreenCoordsXY{ lastWidget.left, lastWidget.bottom + 4 }, STR_DEBUG_PAINT_ENTRY_USAGE, ft,
+        { COLOUR_WHITE });
 }
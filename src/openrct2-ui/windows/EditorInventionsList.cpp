@@ -159,6 +159,7 @@ static void MoveResearchItem(ResearchItem* beforeItem, int32_t scrollIndex)
     ResearchRemove(_editorInventionsListDraggedItem);
 
     auto& researchList = scrollIndex == 0 ? gResearchItemsInvented : gResearchItemsUninvented;
+    ResearchInvalidateIndex();
     if (beforeItem != nullptr)
     {
         for (size_t i = 0; i < researchList.size(); i++)
@@ -226,10 +226,20 @@ class EditorObjectSelectionWindow final : public Window
     using sortFunc_t = bool (*)(const ObjectListItem&, const ObjectListItem&);
 
 private:
+    struct SearchText
+    {
+        std::string Name;
+        std::string RideType;
+        std::string Path;
+    };
+
     std::vector<ObjectListItem> _listItems;
     int32_t _listSortType = RIDE_SORT_TYPE;
     bool _listSortDescending = false;
     std::unique_ptr<Object> _loadedObject;
+    // Upper case texts the filter searches, by repository index. Converting them is slow, so it is only done once.
+    std::vector<SearchText> _searchTexts;
+    std::string _filterStringUpper;
 
 public:
     /**
@@ -1110,6 +1120,7 @@ private:
     {
         int32_t numObjects = static_cast<int32_t>(object_repository_get_items_count());
 
+        UpdateSearchTexts();
         VisibleListDispose();
         selected_list_item = -1;
 
@@ -1303,6 +1314,30 @@ private:
         return false;
     }
 
+    void UpdateSearchTexts()
+    {
+        _filterStringUpper = String::ToUpper(_filter_string);
+
+        size_t numObjects = object_repository_get_items_count();
+        if (_searchTexts.size() == numObjects)
+            return;
+
+        const ObjectRepositoryItem* items = object_repository_get_items();
+        _searchTexts.clear();
+        _searchTexts.reserve(numObjects);
+        for (size_t i = 0; i < numObjects; i++)
+        {
+            const auto* item = &items[i];
+            auto& searchText = _searchTexts.emplace_back();
+            searchText.Name = String::ToUpper(item->Name);
+            if (item->Type == ObjectType::Ride)
+            {
+                searchText.RideType = String::ToUpper(language_get_string(GetRideTypeStringId(item)));
+            }
+            searchText.Path = String::ToUpper(item->Path);
+        }
+    }
+
     bool FilterString(const ObjectRepositoryItem* item)
     {
         // Nothing to search for
@@ -1313,19 +1348,11 @@ private:
         if (item->Name.empty())
             return false;
 
-        // Get ride type
-        const char* rideTypeName = language_get_string(GetRideTypeStringId(item));
-
-        // Get object name (ride/vehicle for rides) and type name (rides only) in uppercase
-        const auto nameUpper = String::ToUpper(item->Name);
-        const auto typeUpper = String::ToUpper(rideTypeName);
-        const auto pathUpper = String::ToUpper(item->Path);
-        const auto filterUpper = String::ToUpper(_filter_string);
-
-        // Check if the searched string exists in the name, ride type, or filename
-        bool inName = nameUpper.find(filterUpper) != std::string::npos;
-        bool inRideType = (item->Type == ObjectType::Ride) && typeUpper.find(filterUpper) != std::string::npos;
-        bool inPath = pathUpper.find(filterUpper) != std::string::npos;
+        // Check if the searched string exists in the name, ride type (rides only), or filename
+        const auto& searchText = _searchTexts[item - object_repository_get_items()];
+        bool inName = searchText.Name.find(_filterStringUpper) != std::string::npos;
+        bool inRideType = searchText.RideType.find(_filterStringUpper) != std::string::npos;
+        bool inPath = searchText.Path.find(_filterStringUpper) != std::string::npos;
 
         return inName || inRideType || inPath;
     }
@@ -1387,6 +1414,7 @@ private:
     {
         if (!_FILTER_ALL || strlen(_filter_string) > 0)
         {
+            UpdateSearchTexts();
             const auto& selectionFlags = _objectSelectionFlags;
             std::fill(std::begin(_filter_object_counts), std::end(_filter_object_counts), 0);
 
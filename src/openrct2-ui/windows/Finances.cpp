@@ -666,6 +666,25 @@ static void WindowFinancesSummaryScrollpaint(rct_window* w, rct_drawpixelinfo* d
 
 #pragma region Financial graph page
 
+/**
+ * Calculates the Y axis scale (log2 of highest [+/-]value) that makes the visible part of a history fit the graph.
+ */
+static int32_t WindowFinancesGetGraphAxisScale(const MoneyHistory& history, money64 maxHeight)
+{
+    const auto minimum = history.GetMinimum();
+    const auto maximum = history.GetMaximum();
+    if (maximum == MONEY64_UNDEFINED)
+        return 0;
+
+    const auto largest = std::max(std::abs(minimum), std::abs(maximum));
+    int32_t yAxisScale = 0;
+    while ((largest >> yAxisScale) > maxHeight)
+    {
+        yAxisScale++;
+    }
+    return yAxisScale;
+}
+
 /**
  *
  *  rct2: 0x0069CF70
@@ -687,8 +706,10 @@ static void WindowFinancesFinancialGraphUpdate(rct_window* w)
     // Tab animation
     if (++w->frame_no >= WindowFinancesTabAnimationLoops[w->page])
         w->frame_no = 0;
+    widget_invalidate(w, WIDX_TAB_2);
 
-    w->Invalidate();
+    w->InvalidateIfChanged(
+        WindowContentHash().AddBytes(gCashHistory.data(), gCashHistory.size() * sizeof(money64)).Add(gCash).Add(gBankLoan));
 }
 
 /**
@@ -733,22 +754,8 @@ static void WindowFinancesFinancialGraphPaint(rct_window* w, rct_drawpixelinfo*
     // Graph
     gfx_fill_rect_inset(dpi, { graphTopLeft, graphBottomRight }, w->colours[1], INSET_RECT_F_30);
 
-    // Calculate the Y axis scale (log2 of highest [+/-]balance)
-    int32_t yAxisScale = 0;
-    for (int32_t i = 0; i < 64; i++)
-    {
-        auto balance = gCashHistory[i];
-        if (balance == MONEY64_UNDEFINED)
-            continue;
-
-        // Modifier balance then keep halving until less than 127 pixels
-        balance = std::abs(balance) >> yAxisScale;
-        while (balance > 127)
-        {
-            balance /= 2;
-            yAxisScale++;
-        }
-    }
+    // Keep halving the highest [+/-]balance until it is less than 127 pixels
+    int32_t yAxisScale = WindowFinancesGetGraphAxisScale(gCashHistory, 127);
 
     // Y axis labels
     auto coords = graphTopLeft + ScreenCoordsXY{ 18, 14 };
@@ -769,7 +776,7 @@ static void WindowFinancesFinancialGraphPaint(rct_window* w, rct_drawpixelinfo*
 
     // X axis labels and values
     coords = graphTopLeft + ScreenCoordsXY{ 98, 17 };
-    Graph::Draw(dpi, gCashHistory, 64, coords, yAxisScale, 128);
+    Graph::Draw(dpi, gCashHistory.data(), FINANCE_GRAPH_VISIBLE_SIZE, coords, yAxisScale, 128);
 }
 
 #pragma endregion
@@ -797,8 +804,10 @@ static void WindowFinancesParkValueGraphUpdate(rct_window* w)
     // Tab animation
     if (++w->frame_no >= WindowFinancesTabAnimationLoops[w->page])
         w->frame_no = 0;
+    widget_invalidate(w, WIDX_TAB_3);
 
-    w->Invalidate();
+    w->InvalidateIfChanged(
+        WindowContentHash().AddBytes(gParkValueHistory.data(), gParkValueHistory.size() * sizeof(money64)).Add(gParkValue));
 }
 
 /**
@@ -837,22 +846,8 @@ static void WindowFinancesParkValueGraphPaint(rct_window* w, rct_drawpixelinfo*
     // Graph
     gfx_fill_rect_inset(dpi, { graphTopLeft, graphBottomRight }, w->colours[1], INSET_RECT_F_30);
 
-    // Calculate the Y axis scale (log2 of highest [+/-]balance)
-    int32_t yAxisScale = 0;
-    for (int32_t i = 0; i < 64; i++)
-    {
-        auto balance = gParkValueHistory[i];
-        if (balance == MONEY64_UNDEFINED)
-            continue;
-
-        // Modifier balance then keep halving until less than 255 pixels
-        balance = std::abs(balance) >> yAxisScale;
-        while (balance > 255)
-        {
-            balance /= 2;
-            yAxisScale++;
-        }
-    }
+    // Keep halving the highest [+/-]balance until it is less than 255 pixels
+    int32_t yAxisScale = WindowFinancesGetGraphAxisScale(gParkValueHistory, 255);
 
     // Y axis labels
     auto coords = graphTopLeft + ScreenCoordsXY{ 18, 14 };
@@ -873,7 +868,7 @@ static void WindowFinancesParkValueGraphPaint(rct_window* w, rct_drawpixelinfo*
 
     // X axis labels and values
     coords = graphTopLeft + ScreenCoordsXY{ 98, 17 };
-    Graph::Draw(dpi, gParkValueHistory, 64, coords, yAxisScale, 0);
+    Graph::Draw(dpi, gParkValueHistory.data(), FINANCE_GRAPH_VISIBLE_SIZE, coords, yAxisScale, 0);
 }
 
 #pragma endregion
@@ -942,22 +937,8 @@ static void WindowFinancesProfitGraphPaint(rct_window* w, rct_drawpixelinfo* dpi
     // Graph
     gfx_fill_rect_inset(dpi, { graphTopLeft, graphBottomRight }, w->colours[1], INSET_RECT_F_30);
 
-    // Calculate the Y axis scale (log2 of highest [+/-]balance)
-    int32_t yAxisScale = 0;
-    for (int32_t i = 0; i < 64; i++)
-    {
-        auto balance = gWeeklyProfitHistory[i];
-        if (balance == MONEY64_UNDEFINED)
-            continue;
-
-        // Modifier balance then keep halving until less than 127 pixels
-        balance = std::abs(balance) >> yAxisScale;
-        while (balance > 127)
-        {
-            balance /= 2;
-            yAxisScale++;
-        }
-    }
+    // Keep halving the highest [+/-]balance until it is less than 127 pixels
+    int32_t yAxisScale = WindowFinancesGetGraphAxisScale(gWeeklyProfitHistory, 127);
 
     // Y axis labels
     auto screenPos = graphTopLeft + ScreenCoordsXY{ 18, 14 };
@@ -978,7 +959,7 @@ static void WindowFinancesProfitGraphPaint(rct_window* w, rct_drawpixelinfo* dpi
 
     // X axis labels and values
     screenPos = graphTopLeft + ScreenCoordsXY{ 98, 17 };
-    Graph::Draw(dpi, gWeeklyProfitHistory, 64, screenPos, yAxisScale, 128);
+    Graph::Draw(dpi, gWeeklyProfitHistory.data(), FINANCE_GRAPH_VISIBLE_SIZE, screenPos, yAxisScale, 128);
 }
 
 #pragma endregion
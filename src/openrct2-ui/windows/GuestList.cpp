@@ -8,6 +8,8 @@
  *****************************************************************************/
 
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
@@ -15,6 +17,7 @@
 #include <openrct2/Game.h>
 #include <openrct2/config/Config.h>
 #include <openrct2/drawing/Drawing.h>
+#include <openrct2/entity/EntityList.h>
 #include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/entity/Guest.h>
 #include <openrct2/localisation/Formatter.h>
@@ -25,6 +28,8 @@
 #include <openrct2/util/Math.hpp>
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_GUESTS;
@@ -100,14 +105,23 @@ private:
             return firstStrId;
         }
 
-        bool operator==(const FilterArguments& other)
+        bool operator==(const FilterArguments& other) const
         {
             return std::memcmp(args, other.args, sizeof(args)) == 0;
         }
-        bool operator!=(const FilterArguments& other)
+        bool operator!=(const FilterArguments& other) const
         {
             return !(*this == other);
         }
+
+        struct Hash
+        {
+            size_t operator()(const FilterArguments& arguments) const
+            {
+                const auto bytes = std::string_view(reinterpret_cast<const char*>(arguments.args), sizeof(arguments.args));
+                return std::hash<std::string_view>()(bytes);
+            }
+        };
     };
 
     struct GuestGroup
@@ -125,10 +139,20 @@ private:
         char Name[256];
     };
 
+    enum class GuestEntryState : uint8_t
+    {
+        None,
+        Listed,
+        // Still in the list until the next compaction
+        Removed,
+    };
+
     static constexpr const uint8_t SUMMARISED_GUEST_ROW_HEIGHT = SCROLLABLE_ROW_HEIGHT + 11;
     static constexpr const auto GUESTS_PER_PAGE = 2000;
     static constexpr const auto GUEST_PAGE_HEIGHT = GUESTS_PER_PAGE * SCROLLABLE_ROW_HEIGHT;
     static constexpr size_t MaxGroups = 240;
+    // Number of guests re-evaluated or grouped per window update
+    static constexpr size_t GuestsPerUpdate = 512;
 
     TabId _selectedTab{};
     GuestViewType _selectedView{};
@@ -144,8 +168,17 @@ private:
     uint32_t _lastFindGroupsTick{};
     uint32_t _lastFindGroupsWait{};
     std::vector<GuestGroup> _groups;
+    std::vector<GuestGroup> _pendingGroups;
+    std::unordered_map<FilterArguments, size_t, FilterArguments::Hash> _pendingGroupIndex;
+    std::optional<uint16_t> _groupsCursor;
 
     std::vector<GuestItem> _guestList;
+    // Leading entries of the guest list that are in sort order, the entries after them were added since the last sort
+    size_t _guestListSortedCount{};
+    std::vector<GuestEntryState> _guestListStates;
+    std::vector<uint16_t> _pendingGuests;
+    bool _guestListRemovalPending{};
+    uint16_t _revalidateCursor{};
     std::optional<size_t> _highlightedIndex;
 
     uint32_t _tabAnimationIndex{};
@@ -169,6 +202,7 @@ public:
         min_height = 330;
         max_width = 500;
         max_height = 450;
+        _guestListStates.resize(MAX_ENTITIES);
         RefreshList();
     }
 
@@ -267,6 +301,15 @@ public:
             _lastFindGroupsWait--;
         }
 
+        if (_selectedTab == TabId::Individual)
+        {
+            UpdateGuestList();
+        }
+        else if (_groupsCursor)
+        {
+            ContinueRefreshGroups(GuestsPerUpdate);
+        }
+
         // Current tab image animation
         _tabAnimationIndex++;
         if (_tabAnimationIndex >= (_selectedTab == TabId::Individual ? 24UL : 32UL))
@@ -514,7 +557,11 @@ public:
                 // Find the groups
                 if (IsRefreshOfGroupsRequired())
                 {
-                    RefreshGroups();
+                    // A changed view is grouped straight away, the periodic refresh is spread over the next updates
+                    if (_selectedView != _lastFindGroupsSelectedView)
+                        RefreshGroups();
+                    else
+                        BeginRefreshGroups();
                 }
                 y = static_cast<int32_t>(_groups.size() * SUMMARISED_GUEST_ROW_HEIGHT);
                 break;
@@ -558,18 +605,14 @@ public:
             {
                 auto i = screenCoords.y / SCROLLABLE_ROW_HEIGHT;
                 i += static_cast<int32_t>(_selectedPage * GUESTS_PER_PAGE);
-                for (const auto& guestItem : _guestList)
+                EnsureGuestListSorted();
+                if (i >= 0 && static_cast<size_t>(i) < _guestList.size())
                 {
-                    if (i == 0)
+                    auto guest = GetEntity<Guest>(_guestList[i].Id);
+                    if (guest != nullptr)
                     {
-                        auto guest = GetEntity<Guest>(guestItem.Id);
-                        if (guest != nullptr)
-                        {
-                            WindowGuestOpen(guest);
-                        }
-                        break;
+                        WindowGuestOpen(guest);
                     }
-                    i--;
                 }
                 break;
             }
@@ -618,6 +661,9 @@ public:
         else
         {
             _guestList.clear();
+            std::fill(_guestListStates.begin(), _guestListStates.end(), GuestEntryState::None);
+            _pendingGuests.clear();
+            _guestListRemovalPending = false;
 
             for (auto peep : EntityList<Guest>())
             {
@@ -633,15 +679,23 @@ public:
                 if (!GuestShouldBeVisible(*peep))
                     continue;
 
-                auto& item = _guestList.emplace_back();
-                item.Id = peep->sprite_index;
-
-                Formatter ft;
-                peep->FormatNameTo(ft);
-                format_string(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
+                AddGuestItem(*peep);
             }
 
             std::sort(_guestList.begin(), _guestList.end(), GetGuestCompareFunc());
+            _guestListSortedCount = _guestList.size();
+        }
+    }
+
+    /**
+     * Queues a guest whose entry has to be re-evaluated, e.g. because it entered the park or had a new thought.
+     */
+    void QueueGuest(uint16_t spriteIndex)
+    {
+        // The summarised tab does not keep the list, it is rebuilt when switching back
+        if (_selectedTab == TabId::Individual)
+        {
+            _pendingGuests.push_back(spriteIndex);
         }
     }
 
@@ -665,13 +719,18 @@ private:
 
     void DrawScrollIndividual(rct_drawpixelinfo& dpi)
     {
-        size_t index = 0;
-        auto y = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
-        for (const auto& guestItem : _guestList)
+        EnsureGuestListSorted();
+
+        // Start at the first row overlapping the clip area rather than walking the whole list
+        const auto pageTop = static_cast<int32_t>(_selectedPage) * GUEST_PAGE_HEIGHT;
+        auto index = static_cast<size_t>(std::max(0, (dpi.y + pageTop) / SCROLLABLE_ROW_HEIGHT - 1));
+        auto y = static_cast<int32_t>(index) * SCROLLABLE_ROW_HEIGHT - pageTop;
+        for (; index < _guestList.size() && y < dpi.y + dpi.height; index++, y += SCROLLABLE_ROW_HEIGHT)
         {
+            const auto& guestItem = _guestList[index];
+
             // Check if y is beyond the scroll control
-            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y && y < 0x7FFF
-                && y < dpi.y + dpi.height)
+            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y && y < 0x7FFF)
             {
                 // Highlight backcolour and text colour (format)
                 rct_string_id format = STR_BLACK_STRING;
@@ -725,8 +784,6 @@ private:
                         break;
                 }
             }
-            y += SCROLLABLE_ROW_HEIGHT;
-            index++;
         }
     }
 
@@ -830,55 +887,210 @@ private:
 
     GuestGroup& FindOrAddGroup(FilterArguments&& arguments)
     {
-        auto foundGroup = std::find_if(
-            std::begin(_groups), std::end(_groups), [&arguments](GuestGroup& group) { return group.Arguments == arguments; });
-        if (foundGroup != std::end(_groups))
+        auto [foundGroup, added] = _pendingGroupIndex.try_emplace(arguments, _pendingGroups.size());
+        if (added)
         {
-            return *foundGroup;
+            auto& newGroup = _pendingGroups.emplace_back();
+            newGroup.Arguments = arguments;
         }
-        auto& newGroup = _groups.emplace_back();
-        newGroup.Arguments = arguments;
-        return newGroup;
+        return _pendingGroups[foundGroup->second];
     }
 
     void RefreshGroups()
+    {
+        BeginRefreshGroups();
+        ContinueRefreshGroups(std::numeric_limits<size_t>::max());
+    }
+
+    void BeginRefreshGroups()
     {
         _lastFindGroupsTick = floor2(gCurrentTicks, 256);
         _lastFindGroupsSelectedView = _selectedView;
         _lastFindGroupsWait = 320;
-        _groups.clear();
+        _pendingGroups.clear();
+        _pendingGroupIndex.clear();
+        _groupsCursor = 0;
+    }
 
-        for (auto peep : EntityList<Guest>())
+    /**
+     * Groups up to maxGuests more guests, the groups shown are replaced once every guest has been visited.
+     */
+    void ContinueRefreshGroups(size_t maxGuests)
+    {
+        // The guest list is in sprite index order so the pass can resume from the last index even if guests were
+        // added or removed in between
+        const auto& guests = GetEntityList(EntityType::Guest);
+        auto it = std::lower_bound(guests.begin(), guests.end(), *_groupsCursor);
+        for (size_t n = 0; n < maxGuests && it != guests.end(); n++, it++)
         {
-            if (peep->OutsideOfPark)
+            auto peep = GetEntity<Guest>(*it);
+            if (peep == nullptr || peep->OutsideOfPark)
                 continue;
 
-            auto& group = FindOrAddGroup(GetArgumentsFromPeep(*peep, _selectedView));
+            auto& group = FindOrAddGroup(GetArgumentsFromPeep(*peep, _lastFindGroupsSelectedView));
             if (group.NumGuests < std::size(group.Faces))
             {
                 group.Faces[group.NumGuests] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
             }
             group.NumGuests++;
         }
+        if (it != guests.end())
+        {
+            _groupsCursor = *it;
+            return;
+        }
+        _groupsCursor = std::nullopt;
+        _pendingGroupIndex.clear();
 
         // Remove empty group (basically guests with no thoughts)
-        auto foundGroup = std::find_if(std::begin(_groups), std::end(_groups), [](GuestGroup& group) {
+        auto foundGroup = std::find_if(std::begin(_pendingGroups), std::end(_pendingGroups), [](GuestGroup& group) {
             return group.Arguments.GetFirstStringId() == STR_EMPTY;
         });
-        if (foundGroup != std::end(_groups))
+        if (foundGroup != std::end(_pendingGroups))
         {
-            _groups.erase(foundGroup);
+            _pendingGroups.erase(foundGroup);
         }
 
         // Sort groups by number of guests
-        std::sort(
-            _groups.begin(), _groups.end(), [](const GuestGroup& a, const GuestGroup& b) { return a.NumGuests > b.NumGuests; });
+        std::sort(_pendingGroups.begin(), _pendingGroups.end(), [](const GuestGroup& a, const GuestGroup& b) {
+            return a.NumGuests > b.NumGuests;
+        });
 
         // Remove up to MaxGroups
-        if (_groups.size() > MaxGroups)
+        if (_pendingGroups.size() > MaxGroups)
+        {
+            _pendingGroups.resize(MaxGroups);
+        }
+
+        std::swap(_groups, _pendingGroups);
+        _pendingGroups.clear();
+        Invalidate();
+    }
+
+    void AddGuestItem(const Guest& peep)
+    {
+        auto& item = _guestList.emplace_back();
+        item.Id = peep.sprite_index;
+
+        Formatter ft;
+        peep.FormatNameTo(ft);
+        format_string(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
+
+        _guestListStates[peep.sprite_index] = GuestEntryState::Listed;
+    }
+
+    /**
+     * Adds or removes the entry of a single guest.
+     * @return true if the list changed.
+     */
+    bool UpdateGuestEntry(uint16_t spriteIndex)
+    {
+        auto* peep = GetEntity<Guest>(spriteIndex);
+        bool listed = false;
+        if (peep != nullptr)
         {
-            _groups.resize(MaxGroups);
+            const bool inFilter = !peep->OutsideOfPark && (!_selectedFilter || IsPeepInFilter(*peep));
+            EntitySetFlashing(peep, _selectedFilter.has_value() && inFilter);
+            listed = inFilter && GuestShouldBeVisible(*peep);
+        }
+
+        auto state = _guestListStates[spriteIndex];
+        if (!listed)
+        {
+            if (state != GuestEntryState::Listed)
+                return false;
+
+            _guestListStates[spriteIndex] = GuestEntryState::Removed;
+            _guestListRemovalPending = true;
+            return true;
+        }
+
+        if (state == GuestEntryState::Listed)
+            return false;
+
+        if (state == GuestEntryState::Removed)
+        {
+            // The sprite index may belong to another guest by now, replace the entry so its name is up to date
+            auto found = std::find_if(
+                _guestList.begin(), _guestList.end(), [spriteIndex](const GuestItem& item) { return item.Id == spriteIndex; });
+            if (found != _guestList.end())
+            {
+                if (static_cast<size_t>(found - _guestList.begin()) < _guestListSortedCount)
+                    _guestListSortedCount--;
+                _guestList.erase(found);
+            }
         }
+        AddGuestItem(*peep);
+        return true;
+    }
+
+    /**
+     * Applies the queued guest events and re-evaluates a slice of all guests, as guests also move in and out of a
+     * filter without any event, e.g. when boarding a ride.
+     */
+    void UpdateGuestList()
+    {
+        bool changed = false;
+        for (auto spriteIndex : _pendingGuests)
+        {
+            changed |= UpdateGuestEntry(spriteIndex);
+        }
+        _pendingGuests.clear();
+
+        const auto& guests = GetEntityList(EntityType::Guest);
+        auto it = std::lower_bound(guests.begin(), guests.end(), _revalidateCursor);
+        for (size_t n = 0; n < GuestsPerUpdate && it != guests.end(); n++, it++)
+        {
+            changed |= UpdateGuestEntry(*it);
+        }
+        _revalidateCursor = it != guests.end() ? *it : 0;
+
+        if (_guestListRemovalPending)
+        {
+            CompactGuestList();
+        }
+        if (changed)
+        {
+            Invalidate();
+        }
+    }
+
+    void CompactGuestList()
+    {
+        size_t kept = 0;
+        size_t keptSorted = 0;
+        for (size_t i = 0; i < _guestList.size(); i++)
+        {
+            auto& state = _guestListStates[_guestList[i].Id];
+            if (state == GuestEntryState::Removed)
+            {
+                state = GuestEntryState::None;
+                continue;
+            }
+            if (i < _guestListSortedCount)
+                keptSorted++;
+            if (kept != i)
+                _guestList[kept] = _guestList[i];
+            kept++;
+        }
+        _guestList.resize(kept);
+        _guestListSortedCount = keptSorted;
+        _guestListRemovalPending = false;
+    }
+
+    /**
+     * Sorts the entries added since the last sort and merges them into the sorted part of the list.
+     */
+    void EnsureGuestListSorted()
+    {
+        if (_guestListSortedCount == _guestList.size())
+            return;
+
+        auto compare = GetGuestCompareFunc();
+        auto middle = _guestList.begin() + _guestListSortedCount;
+        std::sort(middle, _guestList.end(), compare);
+        std::inplace_merge(_guestList.begin(), middle, _guestList.end(), compare);
+        _guestListSortedCount = _guestList.size();
     }
 
     /**
@@ -994,3 +1206,12 @@ void WindowGuestListRefreshList()
         static_cast<GuestListWindow*>(w)->RefreshList();
     }
 }
+
+void WindowGuestListUpdateGuest(uint16_t spriteIndex)
+{
+    auto* w = window_find_by_class(WC_GUEST_LIST);
+    if (w != nullptr)
+    {
+        static_cast<GuestListWindow*>(w)->QueueGuest(spriteIndex);
+    }
+}
@@ -192,6 +192,32 @@ static uint32_t _currentLine;
 /** rct2: 0x00F1AD68 */
 static std::vector<uint8_t> _mapImageData;
 
+// Set until every line of the minimap has been drawn after opening, rotating or switching tabs.
+static bool _mapFillPending;
+static std::vector<TileCoordsXY> _mapDirtyTiles;
+
+namespace MapOverlayFlags
+{
+    constexpr uint8_t Guest = (1 << 0);
+    constexpr uint8_t GuestFlashing = (1 << 1);
+    constexpr uint8_t Staff = (1 << 2);
+    constexpr uint8_t StaffFlashing = (1 << 3);
+    constexpr uint8_t Vehicle = (1 << 4);
+} // namespace MapOverlayFlags
+
+/**
+ * A tile occupied by one or more guests, staff or vehicles, drawn as a single overlay pixel.
+ */
+struct MapOverlayTile
+{
+    TileCoordsXY Tile;
+    uint8_t Flags;
+};
+
+// Occupied tiles rebuilt every update, the index holds the position in the list + 1 for each tile of the map.
+static std::vector<MapOverlayTile> _mapOverlayTiles;
+static std::vector<uint32_t> _mapOverlayTileIndex;
+
 static uint16_t _landRightsToolSize;
 
 static void WindowMapInitMap();
@@ -201,6 +227,7 @@ static void WindowMapDrawTabImages(rct_window* w, rct_drawpixelinfo* dpi);
 static void WindowMapPaintPeepOverlay(rct_drawpixelinfo* dpi);
 static void WindowMapPaintTrainOverlay(rct_drawpixelinfo* dpi);
 static void WindowMapPaintHudRectangle(rct_drawpixelinfo* dpi);
+static void WindowMapUpdateOverlay(rct_window* w);
 static void WindowMapInputsizeLand(rct_window* w);
 static void WindowMapInputsizeMap(rct_window* w);
 
@@ -212,6 +239,7 @@ static void WindowMapSetPeepSpawnToolDown(const ScreenCoordsXY& screenCoords);
 static void MapWindowIncreaseMapSize();
 static void MapWindowDecreaseMapSize();
 static void MapWindowSetPixels(rct_window* w);
+static void MapWindowSetTilePixel(rct_window* w, const TileCoordsXY& tile);
 
 static CoordsXY MapWindowScreenToMap(ScreenCoordsXY screenCoords);
 
@@ -235,6 +263,7 @@ rct_window* WindowMapOpen()
     try
     {
         _mapImageData.resize(MAP_WINDOW_MAP_SIZE * MAP_WINDOW_MAP_SIZE);
+        _mapOverlayTileIndex.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
     }
     catch (const std::bad_alloc&)
     {
@@ -258,6 +287,7 @@ rct_window* WindowMapOpen()
 
     w->map.rotation = get_current_rotation();
 
+    map_dirty_tiles_set_tracking(true);
     WindowMapInitMap();
     gWindowSceneryRotation = 0;
     WindowMapCentreOnViewPoint();
@@ -291,6 +321,11 @@ static void WindowMapClose(rct_window* w)
 {
     _mapImageData.clear();
     _mapImageData.shrink_to_fit();
+    _mapOverlayTiles.clear();
+    _mapOverlayTiles.shrink_to_fit();
+    _mapOverlayTileIndex.clear();
+    _mapOverlayTileIndex.shrink_to_fit();
+    map_dirty_tiles_set_tracking(false);
     if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) && gCurrentToolWidget.window_classification == w->classification
         && gCurrentToolWidget.window_number == w->number)
     {
@@ -393,6 +428,11 @@ static void WindowMapMouseup(rct_window* w, rct_widgetindex widgetIndex)
 
                 w->selected_tab = widgetIndex;
                 w->list_information_type = 0;
+
+                // Redraw every line in the colours of the new tab
+                _mapFillPending = true;
+                _currentLine = 0;
+                WindowMapUpdateOverlay(w);
             }
     }
 }
@@ -452,8 +492,23 @@ static void WindowMapUpdate(rct_window* w)
         WindowMapCentreOnViewPoint();
     }
 
-    for (int32_t i = 0; i < 16; i++)
+    if (_mapFillPending)
+    {
+        for (int32_t i = 0; i < 16 && _mapFillPending; i++)
+            MapWindowSetPixels(w);
+    }
+    else
+    {
+        map_dirty_tiles_take(_mapDirtyTiles);
+        for (const auto& tile : _mapDirtyTiles)
+        {
+            MapWindowSetTilePixel(w, tile);
+        }
+
+        // Keep refreshing one line per update for changes that do not invalidate their tile, e.g. loading a park.
         MapWindowSetPixels(w);
+    }
+    WindowMapUpdateOverlay(w);
 
     w->Invalidate();
 
@@ -903,6 +958,8 @@ static void WindowMapInitMap()
 {
     std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
     _currentLine = 0;
+    _mapFillPending = true;
+    map_dirty_tiles_take(_mapDirtyTiles);
 }
 
 /**
@@ -1048,16 +1105,13 @@ static MapCoordsXY WindowMapTransformToMapCoords(CoordsXY c)
     return { -x + y + MAXIMUM_MAP_SIZE_TECHNICAL - 8, x + y - 8 };
 }
 
-static void DrawMapPeepPixel(Peep* peep, const uint8_t flashColour, rct_drawpixelinfo* dpi)
+static void DrawMapPeepPixel(const TileCoordsXY& tile, bool flashing, const uint8_t flashColour, rct_drawpixelinfo* dpi)
 {
-    if (peep->x == LOCATION_NULL)
-        return;
-
-    MapCoordsXY c = WindowMapTransformToMapCoords({ peep->x, peep->y });
+    MapCoordsXY c = WindowMapTransformToMapCoords(tile.ToCoordsXY());
     auto leftTop = ScreenCoordsXY{ c.x, c.y };
     auto rightBottom = leftTop;
     uint8_t colour = DefaultPeepMapColour;
-    if (EntityGetFlashing(peep))
+    if (flashing)
     {
         colour = flashColour;
         // If flashing then map peep pixel size is increased (by moving left top downwards)
@@ -1100,15 +1154,22 @@ static uint8_t MapGetStaffFlashColour()
  */
 static void WindowMapPaintPeepOverlay(rct_drawpixelinfo* dpi)
 {
+    // All guests are drawn before the staff so staff stay visible on crowded tiles
     auto flashColour = MapGetGuestFlashColour();
-    for (auto guest : EntityList<Guest>())
+    for (const auto& overlayTile : _mapOverlayTiles)
     {
-        DrawMapPeepPixel(guest, flashColour, dpi);
+        if (overlayTile.Flags & MapOverlayFlags::Guest)
+        {
+            DrawMapPeepPixel(overlayTile.Tile, overlayTile.Flags & MapOverlayFlags::GuestFlashing, flashColour, dpi);
+        }
     }
     flashColour = MapGetStaffFlashColour();
-    for (auto staff : EntityList<Staff>())
+    for (const auto& overlayTile : _mapOverlayTiles)
     {
-        DrawMapPeepPixel(staff, flashColour, dpi);
+        if (overlayTile.Flags & MapOverlayFlags::Staff)
+        {
+            DrawMapPeepPixel(overlayTile.Tile, overlayTile.Flags & MapOverlayFlags::StaffFlashing, flashColour, dpi);
+        }
     }
 }
 
@@ -1118,16 +1179,65 @@ static void WindowMapPaintPeepOverlay(rct_drawpixelinfo* dpi)
  */
 static void WindowMapPaintTrainOverlay(rct_drawpixelinfo* dpi)
 {
-    for (auto train : TrainManager::View())
+    for (const auto& overlayTile : _mapOverlayTiles)
     {
-        for (Vehicle* vehicle = train; vehicle != nullptr; vehicle = GetEntity<Vehicle>(vehicle->next_vehicle_on_train))
-        {
-            if (vehicle->x == LOCATION_NULL)
-                continue;
+        MapCoordsXY c = WindowMapTransformToMapCoords(overlayTile.Tile.ToCoordsXY());
+        gfx_fill_rect(dpi, { { c.x, c.y }, { c.x, c.y } }, PALETTE_INDEX_171);
+    }
+}
+
+static void WindowMapAddOverlayTile(const EntityBase& entity, uint8_t flags)
+{
+    if (entity.x == LOCATION_NULL)
+        return;
+
+    const CoordsXY location{ entity.x, entity.y };
+    if (!map_is_location_valid(location))
+        return;
+
+    const auto tile = TileCoordsXY(location);
+    auto& index = _mapOverlayTileIndex[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x];
+    if (index == 0)
+    {
+        _mapOverlayTiles.push_back({ tile, 0 });
+        index = static_cast<uint32_t>(_mapOverlayTiles.size());
+    }
+    _mapOverlayTiles[index - 1].Flags |= flags;
+}
 
-            MapCoordsXY c = WindowMapTransformToMapCoords({ vehicle->x, vehicle->y });
+/**
+ * Collects the tiles occupied by peeps or vehicles once per update, so painting the overlay only has to draw
+ * one pixel per occupied tile rather than one per entity.
+ */
+static void WindowMapUpdateOverlay(rct_window* w)
+{
+    for (const auto& overlayTile : _mapOverlayTiles)
+    {
+        _mapOverlayTileIndex[overlayTile.Tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + overlayTile.Tile.x] = 0;
+    }
+    _mapOverlayTiles.clear();
 
-            gfx_fill_rect(dpi, { { c.x, c.y }, { c.x, c.y } }, PALETTE_INDEX_171);
+    if (w->selected_tab == PAGE_PEEPS)
+    {
+        for (auto guest : EntityList<Guest>())
+        {
+            auto flashing = EntityGetFlashing(guest) ? MapOverlayFlags::GuestFlashing : 0;
+            WindowMapAddOverlayTile(*guest, MapOverlayFlags::Guest | flashing);
+        }
+        for (auto staff : EntityList<Staff>())
+        {
+            auto flashing = EntityGetFlashing(staff) ? MapOverlayFlags::StaffFlashing : 0;
+            WindowMapAddOverlayTile(*staff, MapOverlayFlags::Staff | flashing);
+        }
+    }
+    else
+    {
+        for (auto train : TrainManager::View())
+        {
+            for (Vehicle* vehicle = train; vehicle != nullptr; vehicle = GetEntity<Vehicle>(vehicle->next_vehicle_on_train))
+            {
+                WindowMapAddOverlayTile(*vehicle, MapOverlayFlags::Vehicle);
+            }
         }
     }
 }
@@ -1504,14 +1614,36 @@ static uint16_t MapWindowGetPixelColourRide(const CoordsXY& c)
     return colourB;
 }
 
-static void MapWindowSetPixels(rct_window* w)
+/**
+ * Recolours the pixel of the tile at index along the given minimap line, lines run diagonally across the image.
+ */
+static void MapWindowSetPixel(rct_window* w, int32_t line, int32_t index, const CoordsXY& c)
 {
+    if (map_is_edge(c))
+        return;
+
     uint16_t colour = 0;
-    int32_t x = 0, y = 0, dx = 0, dy = 0;
+    switch (w->selected_tab)
+    {
+        case PAGE_PEEPS:
+            colour = MapWindowGetPixelColourPeep(c);
+            break;
+        case PAGE_RIDES:
+            colour = MapWindowGetPixelColourRide(c);
+            break;
+    }
 
-    int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE };
+    int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE + index, pos / MAP_WINDOW_MAP_SIZE + index };
     auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+    destination[0] = (colour >> 8) & 0xFF;
+    destination[1] = colour;
+}
+
+static void MapWindowSetPixels(rct_window* w)
+{
+    int32_t x = 0, y = 0, dx = 0, dy = 0;
+
     switch (get_current_rotation())
     {
         case 0:
@@ -1542,30 +1674,45 @@ static void MapWindowSetPixels(rct_window* w)
 
     for (int32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
     {
-        if (!map_is_edge({ x, y }))
-        {
-            switch (w->selected_tab)
-            {
-                case PAGE_PEEPS:
-                    colour = MapWindowGetPixelColourPeep({ x, y });
-                    break;
-                case PAGE_RIDES:
-                    colour = MapWindowGetPixelColourRide({ x, y });
-                    break;
-            }
-            destination[0] = (colour >> 8) & 0xFF;
-            destination[1] = colour;
-        }
+        MapWindowSetPixel(w, _currentLine, i, { x, y });
         x += dx;
         y += dy;
-
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
     }
     _currentLine++;
     if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
         _currentLine = 0;
+        _mapFillPending = false;
+    }
+}
+
+/**
+ * Recolours a single tile, the inverse of the line walk in MapWindowSetPixels.
+ */
+static void MapWindowSetTilePixel(rct_window* w, const TileCoordsXY& tile)
+{
+    constexpr int32_t lastTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    int32_t line = 0, index = 0;
+    switch (get_current_rotation())
+    {
+        case 0:
+            line = tile.x;
+            index = tile.y;
+            break;
+        case 1:
+            line = tile.y;
+            index = lastTile - tile.x;
+            break;
+        case 2:
+            line = lastTile - tile.x;
+            index = lastTile - tile.y;
+            break;
+        case 3:
+            line = lastTile - tile.y;
+            index = tile.x;
+            break;
+    }
+    MapWindowSetPixel(w, line, index, tile.ToCoordsXY());
 }
 
 static CoordsXY MapWindowScreenToMap(ScreenCoordsXY screenCoords)
@@ -16,6 +16,7 @@
 #include <openrct2/drawing/Drawing.h>
 #include <openrct2/localisation/Formatter.h>
 #include <openrct2/localisation/Localisation.h>
+#include <openrct2/localisation/LocalisationService.h>
 
 // clang-format off
 static rct_widget window_map_tooltip_widgets[] = {
@@ -129,7 +130,9 @@ static void WindowMapTooltipOpen()
  */
 static void WindowMapTooltipUpdate(rct_window* w)
 {
-    w->Invalidate();
+    const auto& ls = OpenRCT2::GetContext()->GetLocalisationService();
+    w->InvalidateIfChanged(
+        WindowContentHash().AddBytes(_mapTooltipArgs.Data(), _mapTooltipArgs.NumBytes()).Add(ls.GetStringsVersion()));
 }
 
 /**
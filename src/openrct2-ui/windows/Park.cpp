@@ -913,7 +913,7 @@ static void WindowParkRatingPaint(rct_window* w, rct_drawpixelinfo* dpi)
     // Graph
     screenPos = w->windowPos + ScreenCoordsXY{ widget->left + 47, widget->top + 26 };
 
-    Graph::Draw(dpi, gParkRatingHistory, 32, screenPos);
+    Graph::Draw(dpi, gParkRatingHistory.data(), static_cast<int32_t>(gParkRatingHistory.size()), screenPos);
 }
 
 #pragma endregion
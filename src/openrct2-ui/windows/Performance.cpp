@@ -0,0 +1,246 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <openrct2-ui/interface/Widget.h>
+#include <openrct2-ui/windows/Window.h>
+#include <openrct2/Context.h>
+#include <openrct2/GameState.h>
+#include <openrct2/core/PerformanceCounters.h>
+#include <openrct2/drawing/IDrawingEngine.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/localisation/Localisation.h>
+#include <openrct2/network/network.h>
+#include <openrct2/paint/Painter.h>
+
+using namespace OpenRCT2;
+
+// clang-format off
+enum WindowPerformanceWidgetIdx
+{
+    WIDX_BACKGROUND,
+};
+
+static constexpr const int32_t ROW_HEIGHT = 11;
+static constexpr const int32_t PART_NAME_WIDTH = 230;
+static constexpr const int32_t SPARKLINE_SAMPLES = 64;
+static constexpr const int32_t PARTS_WIDTH = PART_NAME_WIDTH + SPARKLINE_SAMPLES + 8;
+static constexpr const int32_t ENTITIES_WIDTH = 160;
+static constexpr const int32_t SUMMARY_ROWS = 6;
+static constexpr const int32_t WINDOW_WIDTH = 8 + PARTS_WIDTH + ENTITIES_WIDTH + 8;
+static constexpr const int32_t WINDOW_HEIGHT = 8 + (SUMMARY_ROWS + LogicTimePartNames.size()) * ROW_HEIGHT + 4 + 8;
+
+// Number of updates between the rates being measured, about a second.
+static constexpr const uint32_t RATE_UPDATES = 40;
+// Number of updates between repaints.
+static constexpr const uint32_t REPAINT_UPDATES = 10;
+
+static constexpr const std::array<const char*, EnumValue(EntityType::Count)> EntityTypeNames = {
+    "Vehicle", "Guest", "Staff", "Litter", "SteamParticle", "MoneyEffect", "CrashedVehicleParticle", "ExplosionCloud",
+    "CrashSplash", "ExplosionFlare", "JumpingFountain", "Balloon", "Duck",
+};
+
+static rct_widget window_performance_widgets[] = {
+    MakeWidget({0, 0}, {WINDOW_WIDTH, WINDOW_HEIGHT}, WindowWidgetType::Frame, WindowColour::Primary),
+    WIDGETS_END,
+};
+
+static void WindowPerformanceUpdate(rct_window * w);
+static void WindowPerformancePaint(rct_window * w, rct_drawpixelinfo * dpi);
+
+static rct_window_event_list window_performance_events([](auto& events)
+{
+    events.update = &WindowPerformanceUpdate;
+    events.paint = &WindowPerformancePaint;
+});
+// clang-format on
+
+/**
+ * Rates worked out from the counters once every RATE_UPDATES updates.
+ */
+struct PerformanceRates
+{
+    std::chrono::steady_clock::time_point Time;
+    NetworkStats_t NetworkStats{};
+    uint64_t JobBusyNanoseconds{};
+    uint32_t BytesReceivedPerSecond{};
+    uint32_t BytesSentPerSecond{};
+    uint32_t JobBusyPercent{};
+};
+
+static PerformanceRates _rates;
+static uint32_t _updates;
+
+rct_window* WindowPerformanceOpen()
+{
+    rct_window* window = window_find_by_class(WC_PERFORMANCE);
+    if (window != nullptr)
+        return window;
+
+    window = WindowCreate(
+        ScreenCoordsXY(context_get_width() - 16 - WINDOW_WIDTH, 16 + 28), WINDOW_WIDTH, WINDOW_HEIGHT,
+        &window_performance_events, WC_PERFORMANCE, WF_STICK_TO_FRONT | WF_TRANSPARENT);
+
+    window->widgets = window_performance_widgets;
+    WindowInitScrollWidgets(window);
+    window_push_others_below(window);
+
+    window->colours[0] = TRANSLUCENT(COLOUR_BLACK);
+    window->colours[1] = COLOUR_GREY;
+
+    _rates = {};
+    _rates.Time = std::chrono::steady_clock::now();
+    _rates.NetworkStats = network_get_stats();
+    _rates.JobBusyNanoseconds = PerformanceCounters::GetJobStats().BusyNanoseconds;
+    _updates = 0;
+    return window;
+}
+
+static uint32_t GetBytesPerSecond(uint64_t previous, uint64_t current, double seconds)
+{
+    // Connections that have closed are no longer part of the totals.
+    return current > previous ? static_cast<uint32_t>((current - previous) / seconds) : 0;
+}
+
+static void UpdateRates()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(now - _rates.Time).count();
+    if (seconds <= 0)
+        return;
+
+    const auto networkStats = network_get_stats();
+    constexpr auto total = EnumValue(NetworkStatisticsGroup::Total);
+    _rates.BytesReceivedPerSecond = GetBytesPerSecond(
+        _rates.NetworkStats.bytesReceived[total], networkStats.bytesReceived[total], seconds);
+    _rates.BytesSentPerSecond = GetBytesPerSecond(_rates.NetworkStats.bytesSent[total], networkStats.bytesSent[total], seconds);
+
+    // Tasks run by the thread that joins a pool count as well, so the pools can be busier than their workers.
+    const auto jobStats = PerformanceCounters::GetJobStats();
+    const auto busySeconds = (jobStats.BusyNanoseconds - _rates.JobBusyNanoseconds) / 1e9;
+    _rates.JobBusyPercent = jobStats.Workers == 0
+        ? 0
+        : static_cast<uint32_t>(std::min(100.0, busySeconds * 100.0 / (seconds * jobStats.Workers)));
+
+    _rates.Time = now;
+    _rates.NetworkStats = networkStats;
+    _rates.JobBusyNanoseconds = jobStats.BusyNanoseconds;
+}
+
+static void WindowPerformanceUpdate(rct_window* w)
+{
+    _updates++;
+    if (_updates % RATE_UPDATES == 0)
+    {
+        UpdateRates();
+    }
+    if (_updates % REPAINT_UPDATES == 0)
+    {
+        w->Invalidate();
+    }
+}
+
+static int32_t ToHundredths(double milliseconds)
+{
+    return static_cast<int32_t>(milliseconds * 100.0);
+}
+
+static void DrawPercentiles(
+    rct_drawpixelinfo* dpi, const ScreenCoordsXY& screenCoords, rct_string_id format,
+    const PerformanceCounters::Percentiles& percentiles)
+{
+    auto ft = Formatter();
+    ft.Add<int32_t>(ToHundredths(percentiles.P50));
+    ft.Add<int32_t>(ToHundredths(percentiles.P95));
+    ft.Add<int32_t>(ToHundredths(percentiles.P99));
+    DrawTextBasic(dpi, screenCoords, format, ft, { COLOUR_WHITE });
+}
+
+static void WindowPerformancePaint(rct_window* w, rct_drawpixelinfo* dpi)
+{
+    WindowDrawWidgets(w, dpi);
+
+    auto screenCoords = w->windowPos + ScreenCoordsXY{ 8, 8 };
+    DrawPercentiles(dpi, screenCoords, STR_PERFORMANCE_TICK_TIMES, PerformanceCounters::GetTickPercentiles());
+    screenCoords.y += ROW_HEIGHT;
+    DrawPercentiles(dpi, screenCoords, STR_PERFORMANCE_FRAME_TIMES, PerformanceCounters::GetFramePercentiles());
+    screenCoords.y += ROW_HEIGHT;
+
+    const auto paintStats = GetContext()->GetPainter()->GetPaintEntryStats();
+    auto ft = Formatter();
+    ft.Add<uint32_t>(static_cast<uint32_t>(paintStats.LastFrameEntries));
+    ft.Add<uint32_t>(static_cast<uint32_t>(paintStats.PeakFrameEntries));
+    ft.Add<uint32_t>(static_cast<uint32_t>(paintStats.ReservedEntries));
+    DrawTextBasic(dpi, screenCoords, STR_DEBUG_PAINT_ENTRY_USAGE, ft, { COLOUR_WHITE });
+    screenCoords.y += ROW_HEIGHT;
+
+    auto* drawingEngine = GetContext()->GetDrawingEngine();
+    const auto dirtyStats = drawingEngine != nullptr ? drawingEngine->GetDirtyGridStats() : DirtyGridStats{};
+    ft = Formatter();
+    ft.Add<uint32_t>(dirtyStats.DirtyBlocks);
+    ft.Add<uint32_t>(dirtyStats.DrawnBlocks);
+    ft.Add<uint32_t>(dirtyStats.Regions);
+    DrawTextBasic(dpi, screenCoords, STR_PERFORMANCE_DIRTY_BLOCKS, ft, { COLOUR_WHITE });
+    screenCoords.y += ROW_HEIGHT;
+
+    ft = Formatter();
+    ft.Add<uint32_t>(static_cast<uint32_t>(PerformanceCounters::GetJobStats().Workers));
+    ft.Add<uint32_t>(_rates.JobBusyPercent);
+    DrawTextBasic(dpi, screenCoords, STR_PERFORMANCE_JOB_POOLS, ft, { COLOUR_WHITE });
+    screenCoords.y += ROW_HEIGHT;
+
+    ft = Formatter();
+    ft.Add<uint32_t>(_rates.BytesReceivedPerSecond);
+    ft.Add<uint32_t>(_rates.BytesSentPerSecond);
+    DrawTextBasic(dpi, screenCoords, STR_PERFORMANCE_NETWORK, ft, { COLOUR_WHITE });
+    screenCoords.y += ROW_HEIGHT + 4;
+
+    // Every part of the tick with its average time and a bar per recent tick, all bars share the same scale.
+    std::array<std::array<float, SPARKLINE_SAMPLES>, LogicTimePartNames.size()> history;
+    std::array<size_t, LogicTimePartNames.size()> historyCount;
+    float maxTime = 1.0f;
+    for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+    {
+        historyCount[i] = PerformanceCounters::GetTickPartHistory(i, history[i].data(), history[i].size());
+        maxTime = std::max(maxTime, *std::max_element(history[i].begin(), history[i].begin() + historyCount[i]));
+    }
+
+    const auto partsTop = screenCoords.y;
+    for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+    {
+        ft = Formatter();
+        ft.Add<const char*>(LogicTimePartNames[i]);
+        ft.Add<int32_t>(ToHundredths(PerformanceCounters::GetTickPartAverage(i)));
+        DrawTextBasic(dpi, screenCoords, STR_PERFORMANCE_TICK_PART, ft, { COLOUR_WHITE });
+
+        const auto barBottom = screenCoords.y + ROW_HEIGHT - 2;
+        auto barX = screenCoords.x + PART_NAME_WIDTH + SPARKLINE_SAMPLES - static_cast<int32_t>(historyCount[i]);
+        for (size_t j = 0; j < historyCount[i]; j++, barX++)
+        {
+            const auto barHeight = static_cast<int32_t>(history[i][j] / maxTime * (ROW_HEIGHT - 3));
+            if (barHeight > 0)
+            {
+                gfx_fill_rect(dpi, { { barX, barBottom - barHeight }, { barX, barBottom } }, PALETTE_INDEX_102);
+            }
+        }
+        screenCoords.y += ROW_HEIGHT;
+    }
+
+    screenCoords = { w->windowPos.x + 8 + PARTS_WIDTH, partsTop };
+    for (size_t i = 0; i < EntityTypeNames.size(); i++)
+    {
+        ft = Formatter();
+        ft.Add<const char*>(EntityTypeNames[i]);
+        ft.Add<uint32_t>(GetEntityListCount(static_cast<EntityType>(i)));
+        DrawTextBasic(dpi, screenCoords, STR_PERFORMANCE_ENTITY_COUNT, ft, { COLOUR_WHITE });
+        screenCoords.y += ROW_HEIGHT;
+    }
+}
@@ -5912,24 +5912,42 @@ static void WindowRideGraphsUpdate(rct_window* w)
     w->frame_no++;
     window_event_invalidate_call(w);
     widget_invalidate(w, WIDX_TAB_8);
-    window_event_invalidate_call(w);
-    widget_invalidate(w, WIDX_GRAPH);
+
+    // Fetching the measurement every tick also keeps it from being freed while the window is open
+    RideMeasurement* measurement{};
+    OpenRCT2String message{};
+    auto ride = get_ride(w->rideId);
+    if (ride != nullptr)
+    {
+        std::tie(measurement, message) = ride->GetMeasurement();
+    }
 
     widget = &window_ride_graphs_widgets[WIDX_GRAPH];
     x = w->scrolls[0].h_left;
-    if (!(w->list_information_type & 0x8000))
+    if (!(w->list_information_type & 0x8000) && ride != nullptr)
     {
-        auto ride = get_ride(w->rideId);
-        if (ride != nullptr)
-        {
-            RideMeasurement* measurement{};
-            std::tie(measurement, std::ignore) = ride->GetMeasurement();
-            x = measurement == nullptr ? 0 : measurement->current_item - ((widget->width() / 4) * 3);
-        }
+        x = measurement == nullptr ? 0 : measurement->current_item - ((widget->width() / 4) * 3);
     }
 
     w->scrolls[0].h_left = std::clamp(x, 0, w->scrolls[0].h_right - (widget->width() - 2));
     WidgetScrollUpdateThumbs(w, WIDX_GRAPH);
+
+    // Only repaint the graph when a sample has been recorded or the view has moved
+    auto contentHash = WindowContentHash().Add(w->list_information_type).Add(w->scrolls[0].h_left).Add(message.str);
+    if (measurement != nullptr)
+    {
+        const auto current = measurement->current_item;
+        contentHash.Add(measurement->flags).Add(measurement->num_items).Add(current);
+        if (current < RideMeasurement::MAX_ITEMS)
+        {
+            // The current sample is averaged in place before the measurement moves on
+            contentHash.Add(measurement->vertical[current])
+                .Add(measurement->lateral[current])
+                .Add(measurement->velocity[current])
+                .Add(measurement->altitude[current]);
+        }
+    }
+    w->InvalidateIfChanged(contentHash);
 }
 
 /**
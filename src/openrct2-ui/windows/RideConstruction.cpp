@@ -182,6 +182,8 @@ static bool _autoRotatingShop;
 static uint8_t _currentlyShowingBrakeOrBoosterSpeed;
 
 static uint32_t _currentDisabledSpecialTrackPieces;
+// The first piece of the last place mode search that found no height to place it at.
+static std::optional<ProvisionalTrackPlacement> _lastFailedPlacementSearch;
 
 static void WindowRideConstructionConstruct(rct_window* w);
 static void WindowRideConstructionMouseupDemolish(rct_window* w);
@@ -3163,6 +3165,18 @@ static void RideConstructionSetBrakesSpeed(int32_t brakesSpeed)
     window_ride_construction_update_active_elements();
 }
 
+static void RememberPlacementSearch(ProvisionalTrackPlacement search)
+{
+    // Searches that placed a ghost are not repeated either way, the ghost stays until the cursor moves.
+    if (_currentTrackSelectionFlags & TRACK_SELECTION_FLAG_TRACK)
+    {
+        _lastFailedPlacementSearch.reset();
+        return;
+    }
+    search.MapRevision = MapGetRevision();
+    _lastFailedPlacementSearch = search;
+}
+
 /**
  *
  *  rct2: 0x006CC6A8
@@ -3257,6 +3271,20 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
     }
 
     _previousTrackPiece = _currentTrackBegin;
+
+    // Trying every height is expensive, a search that found nothing is not repeated until the piece or the map changes.
+    CoordsXYZ searchPos{};
+    window_ride_construction_update_state(
+        &trackType, &trackDirection, &rideIndex, &liftHillAndAlternativeState, &searchPos, nullptr);
+    ProvisionalTrackPlacement search{
+        rideIndex, trackType, trackDirection, liftHillAndAlternativeState, searchPos, MapGetRevision(),
+    };
+    if (_lastFailedPlacementSearch == search)
+    {
+        map_invalidate_map_selection_tiles();
+        return;
+    }
+
     // search for appropriate z value for ghost, up to max ride height
     int numAttempts = (z <= MAX_TRACK_HEIGHT ? ((MAX_TRACK_HEIGHT - z) / COORDS_Z_STEP + 1) : 2);
 
@@ -3278,6 +3306,7 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
 
             _currentTrackBegin.z += 16;
         }
+        RememberPlacementSearch(search);
 
         auto intent = Intent(INTENT_ACTION_UPDATE_MAZE_CONSTRUCTION);
         context_broadcast_intent(&intent);
@@ -3363,6 +3392,7 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
             }
         }
     }
+    RememberPlacementSearch(search);
 
     window_ride_construction_update_active_elements();
     map_invalidate_map_selection_tiles();
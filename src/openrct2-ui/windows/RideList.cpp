@@ -149,7 +149,21 @@ class RideListWindow final : public Window
 private:
     bool _quickDemolishMode = false;
     int32_t _windowRideListInformationType = INFORMATION_TYPE_STATUS;
+    /**
+     * Value of the column the list is sorted by, worked out once per ride before sorting rather than for every
+     * comparison. Rides are sorted by name when the status column is shown, highest value first otherwise.
+     */
+    struct RideListEntry
+    {
+        ride_id_t Id;
+        int64_t Value;
+        std::string Name;
+    };
+
     std::vector<ride_id_t> _rideList;
+    // Reused by RefreshList so the periodic refresh does not allocate.
+    std::vector<RideListEntry> _rideListEntries;
+    size_t _listedRideCount{};
 
 public:
     void OnOpen() override
@@ -198,7 +212,7 @@ public:
         // Refreshing the list can be a very intensive operation
         // owing to its use of ride_has_any_track_elements().
         // This makes sure it's only refreshed every 64 ticks.
-        if (!(gCurrentRealTimeTicks & 0x3f))
+        if (!(gCurrentRealTimeTicks & 0x3f) && NeedsPeriodicRefresh())
         {
             RefreshList();
         }
@@ -744,140 +758,112 @@ private:
             dpi, ImageId(sprite_idx), windowPos + ScreenCoordsXY{ widgets[WIDX_TAB_3].left, widgets[WIDX_TAB_3].top });
     }
 
+    static int64_t GetSortValue(const Ride& ride, int32_t informationType)
+    {
+        switch (informationType)
+        {
+            case INFORMATION_TYPE_POPULARITY:
+                return ride.popularity;
+            case INFORMATION_TYPE_SATISFACTION:
+                return ride.satisfaction;
+            case INFORMATION_TYPE_PROFIT:
+                return ride.profit;
+            case INFORMATION_TYPE_TOTAL_CUSTOMERS:
+                return ride.total_customers;
+            case INFORMATION_TYPE_TOTAL_PROFIT:
+                return ride.total_profit;
+            case INFORMATION_TYPE_CUSTOMERS:
+                return ride_customers_per_hour(&ride);
+            case INFORMATION_TYPE_AGE:
+                return ride.build_date;
+            case INFORMATION_TYPE_INCOME:
+                return ride.income_per_hour;
+            case INFORMATION_TYPE_RUNNING_COST:
+                return ride.upkeep_cost;
+            case INFORMATION_TYPE_QUEUE_LENGTH:
+                return ride.GetTotalQueueLength();
+            case INFORMATION_TYPE_QUEUE_TIME:
+                return ride.GetMaxQueueTime();
+            case INFORMATION_TYPE_RELIABILITY:
+                return ride.reliability_percentage;
+            case INFORMATION_TYPE_DOWN_TIME:
+                return ride.downtime;
+            case INFORMATION_TYPE_GUESTS_FAVOURITE:
+                return ride.guests_favourite;
+            default:
+                return 0;
+        }
+    }
+
     /**
-     * Used in RefreshList() to handle the sorting of the list.
-     * Uses a lambda function (predicate) as exit criteria for the algorithm.
+     * The name order only changes when a ride is added, removed, renamed or changes status, all of which flag the ride
+     * for the list. The other columns change all the time and are always refreshed.
      */
-    template<typename TSortPred> int32_t SortList(int32_t currentListPosition, const Ride& thisRide, const TSortPred& pred)
+    bool NeedsPeriodicRefresh() const
     {
-        while (--currentListPosition >= 0)
+        if (list_information_type != INFORMATION_TYPE_STATUS || _listedRideCount != GetRideManager().size())
+        {
+            return true;
+        }
+        for (const auto& rideRef : GetRideManager())
         {
-            const auto* otherRide = get_ride(_rideList[currentListPosition]);
-            if (otherRide != nullptr)
+            if (rideRef.window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
             {
-                if (pred(thisRide, *otherRide))
-                    break;
-                std::swap(_rideList[currentListPosition], _rideList[currentListPosition + 1]);
+                return true;
             }
         }
-        return currentListPosition;
+        return false;
     }
+
     /**
      *
      *  rct2: 0x006B39A8
      */
     void RefreshList()
     {
-        _rideList.clear();
+        auto rideManager = GetRideManager();
+        _listedRideCount = rideManager.size();
 
-        size_t listIndex = 0;
-        for (auto& rideRef : GetRideManager())
+        _rideListEntries.clear();
+        for (auto& rideRef : rideManager)
         {
+            rideRef.window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
+
             if (rideRef.GetClassification() != static_cast<RideClassification>(page)
                 || (rideRef.status == RideStatus::Closed && !ride_has_any_track_elements(&rideRef)))
                 continue;
 
-            if (rideRef.window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
+            auto& entry = _rideListEntries.emplace_back();
+            entry.Id = rideRef.id;
+            if (list_information_type == INFORMATION_TYPE_STATUS)
             {
-                rideRef.window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
+                entry.Value = 0;
+                entry.Name = rideRef.GetName();
             }
-
-            _rideList.push_back(rideRef.id);
-            auto currentListPosition = static_cast<int32_t>(listIndex);
-            switch (list_information_type)
+            else
             {
-                case INFORMATION_TYPE_STATUS:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return 0 <= strlogicalcmp(thisRide.GetName().c_str(), otherRide.GetName().c_str());
-                        });
-                    break;
-                case INFORMATION_TYPE_POPULARITY:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.popularity * 4 <= otherRide.popularity * 4;
-                        });
-                    break;
-                case INFORMATION_TYPE_SATISFACTION:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.satisfaction * 5 <= otherRide.satisfaction * 5;
-                        });
-                    break;
-                case INFORMATION_TYPE_PROFIT:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.profit <= otherRide.profit;
-                        });
-                    break;
-                case INFORMATION_TYPE_TOTAL_CUSTOMERS:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.total_customers <= otherRide.total_customers;
-                        });
-                    break;
-                case INFORMATION_TYPE_TOTAL_PROFIT:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.total_profit <= otherRide.total_profit;
-                        });
-                    break;
-                case INFORMATION_TYPE_CUSTOMERS:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return ride_customers_per_hour(&thisRide) <= ride_customers_per_hour(&otherRide);
-                        });
-                    break;
-                case INFORMATION_TYPE_AGE:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.build_date <= otherRide.build_date;
-                        });
-                    break;
-                case INFORMATION_TYPE_INCOME:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.income_per_hour <= otherRide.income_per_hour;
-                        });
-                    break;
-                case INFORMATION_TYPE_RUNNING_COST:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.upkeep_cost <= otherRide.upkeep_cost;
-                        });
-                    break;
-                case INFORMATION_TYPE_QUEUE_LENGTH:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.GetTotalQueueLength() <= otherRide.GetTotalQueueLength();
-                        });
-                    break;
-                case INFORMATION_TYPE_QUEUE_TIME:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.GetMaxQueueTime() <= otherRide.GetMaxQueueTime();
-                        });
-                    break;
-                case INFORMATION_TYPE_RELIABILITY:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.reliability_percentage <= otherRide.reliability_percentage;
-                        });
-                    break;
-                case INFORMATION_TYPE_DOWN_TIME:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.downtime <= otherRide.downtime;
-                        });
-                    break;
-                case INFORMATION_TYPE_GUESTS_FAVOURITE:
-                    currentListPosition = SortList(
-                        currentListPosition, rideRef, [](const Ride& thisRide, const Ride& otherRide) -> bool {
-                            return thisRide.guests_favourite <= otherRide.guests_favourite;
-                        });
-                    break;
+                entry.Value = GetSortValue(rideRef, list_information_type);
             }
-            listIndex++;
+        }
+
+        // Stable so rides that compare equal stay in ride index order.
+        if (list_information_type == INFORMATION_TYPE_STATUS)
+        {
+            std::stable_sort(_rideListEntries.begin(), _rideListEntries.end(), [](const auto& a, const auto& b) {
+                return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
+            });
+        }
+        else
+        {
+            std::stable_sort(_rideListEntries.begin(), _rideListEntries.end(), [](const auto& a, const auto& b) {
+                return a.Value > b.Value;
+            });
+        }
+
+        _rideList.clear();
+        for (const auto& entry : _rideListEntries)
+        {
+            _rideList.push_back(entry.Id);
         }
 
         selected_list_item = -1;
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <limits>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Viewport.h>
@@ -25,12 +26,15 @@
 #include <openrct2/entity/Staff.h>
 #include <openrct2/localisation/Formatter.h>
 #include <openrct2/localisation/Localisation.h>
+#include <openrct2/localisation/LocalisationService.h>
 #include <openrct2/management/Finance.h>
 #include <openrct2/sprites.h>
 #include <openrct2/util/Util.h>
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Park.h>
+#include <string>
+#include <string_view>
 #include <vector>
 
 enum
@@ -93,7 +97,38 @@ private:
         rct_string_id ActionHire;
     };
 
+    /**
+     * What the order of the list depends on, compared every update so the list is only sorted again when staff are
+     * hired, fired or renamed.
+     */
+    struct StaffListKey
+    {
+        uint16_t SpriteIndex;
+        uint32_t Id;
+        bool HasCustomName;
+        size_t NameHash;
+
+        bool operator==(const StaffListKey& other) const
+        {
+            return SpriteIndex == other.SpriteIndex && Id == other.Id && HasCustomName == other.HasCustomName
+                && NameHash == other.NameHash;
+        }
+    };
+
+    struct StaffListEntry
+    {
+        uint16_t SpriteIndex;
+        uint32_t Id;
+        bool HasCustomName;
+        std::string Name;
+    };
+
     std::vector<uint16_t> _staffList;
+    std::vector<StaffListKey> _staffListKeys;
+    std::vector<StaffListKey> _sortedStaffListKeys;
+    std::vector<StaffListEntry> _staffListEntries;
+    bool _sortedWithRealNames{};
+    uint32_t _sortedStringsVersion{};
     bool _quickFireMode{};
     std::optional<size_t> _highlightedIndex{};
     int32_t _selectedTab{};
@@ -483,20 +518,61 @@ public:
 
     void RefreshList()
     {
-        _staffList.clear();
-
+        _staffListKeys.clear();
         for (auto peep : EntityList<Staff>())
         {
             EntitySetFlashing(peep, false);
             if (peep->AssignedStaffType == GetSelectedStaffType())
             {
                 EntitySetFlashing(peep, true);
-                _staffList.push_back(peep->sprite_index);
+                bool hasCustomName = peep->Name != nullptr;
+                size_t nameHash = hasCustomName ? std::hash<std::string_view>{}(peep->Name) : 0;
+                _staffListKeys.push_back({ peep->sprite_index, peep->Id, hasCustomName, nameHash });
             }
         }
 
-        std::sort(
-            _staffList.begin(), _staffList.end(), [](const uint16_t a, const uint16_t b) { return peep_compare(a, b) < 0; });
+        const bool realNames = (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES) != 0;
+        const auto stringsVersion = OpenRCT2::GetContext()->GetLocalisationService().GetStringsVersion();
+        if (_staffListKeys == _sortedStaffListKeys && realNames == _sortedWithRealNames
+            && stringsVersion == _sortedStringsVersion)
+        {
+            return;
+        }
+        _sortedStaffListKeys = _staffListKeys;
+        _sortedWithRealNames = realNames;
+        _sortedStringsVersion = stringsVersion;
+
+        // Format each name once rather than twice per comparison, same order as peep_compare. Staff with generated names
+        // are ordered by id amongst themselves, their names are only needed to order them against custom names.
+        const bool anyCustomNames = std::any_of(
+            _staffListKeys.begin(), _staffListKeys.end(), [](const StaffListKey& key) { return key.HasCustomName; });
+        _staffListEntries.clear();
+        for (const auto& key : _staffListKeys)
+        {
+            auto peep = GetEntity<Staff>(key.SpriteIndex);
+            auto& entry = _staffListEntries.emplace_back();
+            entry.SpriteIndex = key.SpriteIndex;
+            entry.Id = key.Id;
+            entry.HasCustomName = key.HasCustomName;
+            if (anyCustomNames || realNames)
+            {
+                entry.Name = peep->GetName();
+            }
+        }
+
+        std::sort(_staffListEntries.begin(), _staffListEntries.end(), [realNames](const auto& a, const auto& b) {
+            if (!a.HasCustomName && !b.HasCustomName && !realNames)
+            {
+                return a.Id < b.Id;
+            }
+            return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
+        });
+
+        _staffList.clear();
+        for (const auto& entry : _staffListEntries)
+        {
+            _staffList.push_back(entry.SpriteIndex);
+        }
     }
 
 private:
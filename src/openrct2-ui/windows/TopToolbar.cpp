@@ -52,6 +52,7 @@
 #include <openrct2/interface/InteractiveConsole.h>
 #include <openrct2/interface/Screenshot.h>
 #include <openrct2/localisation/Formatter.h>
+#include <openrct2/management/Finance.h>
 #include <openrct2/network/network.h>
 #include <openrct2/paint/VirtualFloor.h>
 #include <openrct2/scenario/Scenario.h>
@@ -65,6 +66,7 @@
 #include <openrct2/world/SmallScenery.h>
 #include <openrct2/world/Surface.h>
 #include <openrct2/world/Wall.h>
+#include <optional>
 #include <string>
 
 using namespace OpenRCT2;
@@ -156,6 +158,7 @@ enum TopToolbarDebugDdidx
 {
     DDIDX_CONSOLE = 0,
     DDIDX_DEBUG_PAINT = 1,
+    DDIDX_PERFORMANCE = 2,
 
     TOP_TOOLBAR_DEBUG_COUNT,
 };
@@ -2612,6 +2615,47 @@ static money64 TryPlaceGhostBanner(CoordsXYZD loc, ObjectEntryIndex entryIndex)
     return res.Cost;
 }
 
+/**
+ * A scenery ghost the tool tried to place. Placements that failed are not tried again while the cursor stays on the
+ * same spot, unless the map or the cash the placement depends on changed.
+ */
+struct SceneryGhostAttempt
+{
+    uint8_t SceneryType{};
+    ObjectEntryIndex EntryIndex{};
+    CoordsXYZD Location{};
+    uint8_t QuadrantOrEdge{};
+    bool ShiftPressed{};
+    money64 Cash{};
+    uint32_t MapRevision{};
+
+    bool operator==(const SceneryGhostAttempt& other) const
+    {
+        return SceneryType == other.SceneryType && EntryIndex == other.EntryIndex && Location == other.Location
+            && QuadrantOrEdge == other.QuadrantOrEdge && ShiftPressed == other.ShiftPressed && Cash == other.Cash
+            && MapRevision == other.MapRevision;
+    }
+};
+
+static std::optional<SceneryGhostAttempt> _lastFailedSceneryGhost;
+
+static SceneryGhostAttempt GetSceneryGhostAttempt(
+    uint8_t sceneryType, ObjectEntryIndex entryIndex, const CoordsXYZD& loc, uint8_t quadrantOrEdge = 0)
+{
+    return { sceneryType, entryIndex, loc, quadrantOrEdge, gSceneryShiftPressed != 0, gCash, MapGetRevision() };
+}
+
+static void SetSceneryGhostResult(SceneryGhostAttempt attempt, money64 cost)
+{
+    if (cost != MONEY64_UNDEFINED)
+    {
+        _lastFailedSceneryGhost.reset();
+        return;
+    }
+    attempt.MapRevision = MapGetRevision();
+    _lastFailedSceneryGhost = attempt;
+}
+
 /**
  *
  *  rct2: 0x006E287B
@@ -2704,6 +2748,11 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            auto attempt = GetSceneryGhostAttempt(
+                SCENERY_TYPE_SMALL, selection.EntryIndex, { mapTile, gSceneryPlaceZ, rotation }, quadrant);
+            if (_lastFailedSceneryGhost == attempt)
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             _unkF64F0E = quadrant;
@@ -2726,6 +2775,7 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 gSceneryPlaceZ += 8;
             }
 
+            SetSceneryGhostResult(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2757,10 +2807,15 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            auto attempt = GetSceneryGhostAttempt(SCENERY_TYPE_PATH_ITEM, selection.EntryIndex, { mapTile, z, 0 });
+            if (_lastFailedSceneryGhost == attempt)
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             cost = TryPlaceGhostPathAddition({ mapTile, z }, selection.EntryIndex);
 
+            SetSceneryGhostResult(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2793,6 +2848,11 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            auto attempt = GetSceneryGhostAttempt(
+                SCENERY_TYPE_WALL, selection.EntryIndex, { mapTile, gSceneryPlaceZ, 0 }, edge);
+            if (_lastFailedSceneryGhost == attempt)
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             gSceneryGhostWallRotation = edge;
@@ -2816,6 +2876,7 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 gSceneryPlaceZ += 8;
             }
 
+            SetSceneryGhostResult(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2858,6 +2919,11 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            auto attempt = GetSceneryGhostAttempt(
+                SCENERY_TYPE_LARGE, selection.EntryIndex, { mapTile, gSceneryPlaceZ, direction });
+            if (_lastFailedSceneryGhost == attempt)
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             gSceneryPlaceObject.SceneryType = SCENERY_TYPE_LARGE;
@@ -2882,6 +2948,7 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 gSceneryPlaceZ += COORDS_Z_STEP;
             }
 
+            SetSceneryGhostResult(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2915,10 +2982,15 @@ static void TopToolbarToolUpdateScenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            auto attempt = GetSceneryGhostAttempt(SCENERY_TYPE_BANNER, selection.EntryIndex, { mapTile, z, direction });
+            if (_lastFailedSceneryGhost == attempt)
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             cost = TryPlaceGhostBanner({ mapTile, z, direction }, selection.EntryIndex);
 
+            SetSceneryGhostResult(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -3558,12 +3630,15 @@ static void TopToolbarInitDebugMenu(rct_window* w, rct_widget* widget)
     gDropdownItemsArgs[DDIDX_CONSOLE] = STR_DEBUG_DROPDOWN_CONSOLE;
     gDropdownItemsFormat[DDIDX_DEBUG_PAINT] = STR_TOGGLE_OPTION;
     gDropdownItemsArgs[DDIDX_DEBUG_PAINT] = STR_DEBUG_DROPDOWN_DEBUG_PAINT;
+    gDropdownItemsFormat[DDIDX_PERFORMANCE] = STR_TOGGLE_OPTION;
+    gDropdownItemsArgs[DDIDX_PERFORMANCE] = STR_DEBUG_DROPDOWN_PERFORMANCE;
 
     WindowDropdownShowText(
         { w->windowPos.x + widget->left, w->windowPos.y + widget->top }, widget->height() + 1, w->colours[0] | 0x80,
         Dropdown::Flag::StayOpen, TOP_TOOLBAR_DEBUG_COUNT);
 
     Dropdown::SetChecked(DDIDX_DEBUG_PAINT, window_find_by_class(WC_DEBUG_PAINT) != nullptr);
+    Dropdown::SetChecked(DDIDX_PERFORMANCE, window_find_by_class(WC_PERFORMANCE) != nullptr);
 }
 
 static void TopToolbarInitNetworkMenu(rct_window* w, rct_widget* widget)
@@ -3603,6 +3678,16 @@ static void TopToolbarDebugMenuDropdown(int16_t dropdownIndex)
                     window_close_by_class(WC_DEBUG_PAINT);
                 }
                 break;
+            case DDIDX_PERFORMANCE:
+                if (window_find_by_class(WC_PERFORMANCE) == nullptr)
+                {
+                    context_open_window(WC_PERFORMANCE);
+                }
+                else
+                {
+                    window_close_by_class(WC_PERFORMANCE);
+                }
+                break;
         }
     }
 }
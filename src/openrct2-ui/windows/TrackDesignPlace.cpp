@@ -29,6 +29,7 @@
 #include <openrct2/ui/UiContext.h>
 #include <openrct2/ui/WindowManager.h>
 #include <openrct2/windows/Intent.h>
+#include <openrct2/world/ConstructionClearance.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Surface.h>
 #include <vector>
@@ -228,6 +229,7 @@ static void WindowTrackPlaceUpdate(rct_window* w)
 static GameActions::Result FindValidTrackDesignPlaceHeight(CoordsXYZ& loc, uint32_t flags)
 {
     GameActions::Result res;
+    ConstructionClearanceQueryScope clearanceScope;
     for (int32_t i = 0; i < 7; i++, loc.z += 8)
     {
         auto tdAction = TrackDesignAction(CoordsXYZD{ loc.x, loc.y, loc.z, _currentTrackPieceDirection }, *_trackDesign);
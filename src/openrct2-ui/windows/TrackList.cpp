@@ -25,6 +25,7 @@
 #include <openrct2/ride/TrackDesignRepository.h>
 #include <openrct2/sprites.h>
 #include <openrct2/windows/Intent.h>
+#include <string>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_SELECT_DESIGN;
@@ -65,6 +66,7 @@ static rct_widget window_track_list_widgets[] = {
 // clang-format on
 
 constexpr uint16_t TRACK_DESIGN_INDEX_UNLOADED = UINT16_MAX;
+constexpr size_t MAX_CACHED_TRACK_DESIGN_PREVIEWS = 8;
 
 RideSelection _window_track_list_item;
 
@@ -76,8 +78,18 @@ private:
     std::vector<uint16_t> _filteredTrackIds;
     uint16_t _loadedTrackDesignIndex;
     std::unique_ptr<TrackDesign> _loadedTrackDesign;
+    std::string _loadedTrackDesignPath;
     std::vector<uint8_t> _trackDesignPreviewPixels;
 
+    struct CachedPreview
+    {
+        std::string Path;
+        std::unique_ptr<TrackDesign> Design;
+        std::vector<uint8_t> Pixels;
+    };
+    // Previews drawn recently, oldest first, so moving back over the list does not import and draw them again
+    std::vector<CachedPreview> _previewCache;
+
     void FilterList()
     {
         _filteredTrackIds.clear();
@@ -188,6 +200,29 @@ private:
 
     bool LoadDesignPreview(utf8* path)
     {
+        if (_loadedTrackDesign != nullptr && !_loadedTrackDesignPath.empty())
+        {
+            if (_previewCache.size() >= MAX_CACHED_TRACK_DESIGN_PREVIEWS)
+            {
+                _previewCache.erase(_previewCache.begin());
+            }
+            _previewCache.push_back(
+                { std::move(_loadedTrackDesignPath), std::move(_loadedTrackDesign), std::move(_trackDesignPreviewPixels) });
+        }
+        _loadedTrackDesignPath = path;
+
+        auto it = std::find_if(_previewCache.begin(), _previewCache.end(), [path](const CachedPreview& preview) {
+            return preview.Path == path;
+        });
+        if (it != _previewCache.end())
+        {
+            _loadedTrackDesign = std::move(it->Design);
+            _trackDesignPreviewPixels = std::move(it->Pixels);
+            _previewCache.erase(it);
+            return true;
+        }
+
+        _trackDesignPreviewPixels.resize(4 * TRACK_PREVIEW_IMAGE_SIZE);
         _loadedTrackDesign = TrackDesignImport(path);
         if (_loadedTrackDesign != nullptr)
         {
@@ -197,6 +232,14 @@ private:
         return false;
     }
 
+    void ClearPreviewCache()
+    {
+        _previewCache.clear();
+        // The loaded design stays in use but is not kept once another design is shown
+        _loadedTrackDesignPath.clear();
+        _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
+    }
+
 public:
     void OnOpen() override
     {
@@ -241,6 +284,7 @@ public:
         _loadedTrackDesign = nullptr;
         _trackDesignPreviewPixels.clear();
         _trackDesignPreviewPixels.shrink_to_fit();
+        _previewCache.clear();
 
         // Dispose track list
         for (auto& trackDesign : _trackDesigns)
@@ -277,7 +321,7 @@ public:
                 break;
             case WIDX_TOGGLE_SCENERY:
                 gTrackDesignSceneryToggle = !gTrackDesignSceneryToggle;
-                _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
+                ClearPreviewCache();
                 Invalidate();
                 break;
             case WIDX_BACK:
@@ -436,6 +480,7 @@ public:
         if (track_list.reload_track_designs)
         {
             LoadDesignsList(_window_track_list_item);
+            ClearPreviewCache();
             selected_list_item = 0;
             Invalidate();
             track_list.reload_track_designs = false;
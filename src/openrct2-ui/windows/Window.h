@@ -42,6 +42,7 @@ rct_window* WindowCheatsOpen();
 rct_window* WindowClearSceneryOpen();
 rct_window* CustomCurrencyWindowOpen();
 rct_window* WindowDebugPaintOpen();
+rct_window* WindowPerformanceOpen();
 rct_window* WindowEditorInventionsListOpen();
 rct_window* WindowEditorMainOpen();
 rct_window* WindowEditorObjectiveOptionsOpen();
@@ -96,6 +97,7 @@ rct_window* WindowNewCampaignOpen(int16_t campaignType);
 
 rct_window* WindowInstallTrackOpen(const utf8* path);
 void WindowGuestListRefreshList();
+void WindowGuestListUpdateGuest(uint16_t spriteIndex);
 rct_window* WindowGuestListOpen();
 rct_window* WindowGuestListOpenWithFilter(GuestListFilterType type, int32_t index);
 rct_window* WindowStaffFirePromptOpen(Peep* peep);
@@ -32,8 +32,12 @@
 #include "core/File.h"
 #include "core/FileScanner.h"
 #include "core/FileStream.h"
+#include "core/FileWatcher.h"
 #include "core/Guard.hpp"
 #include "core/Http.h"
+#include "core/JobPool.h"
+#include "core/LargePageAllocator.h"
+#include "core/MemoryAccounting.h"
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
@@ -59,7 +63,6 @@
 #include "platform/Crash.h"
 #include "platform/Platform2.h"
 #include "platform/platform.h"
-#include "ride/TrackData.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/Scenario.h"
 #include "scenario/ScenarioRepository.h"
@@ -78,6 +81,7 @@
 #include <future>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 
 using namespace OpenRCT2;
@@ -102,6 +106,7 @@ namespace OpenRCT2
         std::unique_ptr<LocalisationService> _localisationService;
         std::unique_ptr<IObjectRepository> _objectRepository;
         std::unique_ptr<IObjectManager> _objectManager;
+        std::unique_ptr<FileWatcher> _objectFileWatcher;
         std::unique_ptr<ITrackDesignRepository> _trackDesignRepository;
         std::unique_ptr<IScenarioRepository> _scenarioRepository;
         std::unique_ptr<IReplayManager> _replayManager;
@@ -141,6 +146,10 @@ namespace OpenRCT2
         NewVersionInfo _newVersionInfo;
         bool _hasNewVersionInfo = false;
 
+        // Time taken by each phase of Initialise, phases may run concurrently so they are recorded under a lock.
+        std::mutex _startupPhasesMutex;
+        std::vector<std::pair<std::string, float>> _startupPhases;
+
     public:
         // Singleton of Context.
         // Remove this when GetContext() is no longer called so that
@@ -175,6 +184,7 @@ namespace OpenRCT2
             //       If objects use GetContext() in their destructor things won't go well.
 
             GameActions::ClearQueue();
+            scenario_wait_for_autosave();
 #ifndef DISABLE_NETWORK
             _network.Close();
 #endif
@@ -366,9 +376,22 @@ namespace OpenRCT2
                 throw std::runtime_error("Context already initialised.");
             }
             _initialised = true;
+            Timer startupTimer;
 
             crash_init();
 
+            // The game loop runs on the thread that initialises the context.
+            auto gameThreadCores = Platform::ParseCoreList(gConfigGeneral.game_thread_cores);
+            if (!gameThreadCores.empty() && !Platform::SetCurrentThreadAffinity(gameThreadCores))
+            {
+                log_warning("Unable to confine the game thread to cores %s.", gConfigGeneral.game_thread_cores.c_str());
+            }
+            if (gConfigGeneral.high_priority_game_thread && !Platform::SetCurrentThreadPriority(ThreadPriority::High))
+            {
+                log_warning("Unable to raise the priority of the game thread.");
+            }
+            LargePages::Initialise(gConfigGeneral.large_pages);
+
             if (gConfigGeneral.last_run_version != nullptr && String::Equals(gConfigGeneral.last_run_version, OPENRCT2_VERSION))
             {
                 gOpenRCT2ShowChangelog = false;
@@ -382,7 +405,7 @@ namespace OpenRCT2
 
             try
             {
-                _localisationService->OpenLanguage(gConfigGeneral.language);
+                RunStartupPhase("language", [this]() { _localisationService->OpenLanguage(gConfigGeneral.language); });
             }
             catch (const std::exception& e)
             {
@@ -415,7 +438,6 @@ namespace OpenRCT2
                 }
                 _env->SetBasePath(DIRBASE::RCT2, rct2InstallPath);
             }
-            TrackMetaData::Init();
 
             _objectRepository = CreateObjectRepository(_env);
             _objectManager = CreateObjectManager(*_objectRepository);
@@ -466,21 +488,19 @@ namespace OpenRCT2
             // TODO Ideally we want to delay this until we show the title so that we can
             //      still open the game window and draw a progress screen for the creation
             //      of the object cache.
-            _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
-
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
+            LoadRepositories();
+            if (gConfigGeneral.enable_object_hot_reloading && !gOpenRCT2Headless)
+            {
+                SetupObjectHotReloading();
+            }
 
             if (!gOpenRCT2Headless)
             {
-                Init();
-                PopulateDevices();
-                InitRideSoundsAndInfo();
+                RunStartupPhase("audio", []() {
+                    Init();
+                    PopulateDevices();
+                    InitRideSoundsAndInfo();
+                });
                 gGameSoundsOff = !gConfigSound.master_sound_enabled;
             }
 
@@ -489,7 +509,9 @@ namespace OpenRCT2
 
             if (!gOpenRCT2NoGraphics)
             {
-                if (!LoadBaseGraphics())
+                bool graphicsLoaded = false;
+                RunStartupPhase("base graphics", [this, &graphicsLoaded]() { graphicsLoaded = LoadBaseGraphics(); });
+                if (!graphicsLoaded)
                 {
                     return false;
                 }
@@ -501,15 +523,124 @@ namespace OpenRCT2
             input_reset_place_obj_modifier();
             viewport_init_all();
 
-            _gameState = std::make_unique<GameState>();
-            _gameState->InitAll(150);
+            RunStartupPhase("game state", [this]() {
+                _gameState = std::make_unique<GameState>();
+                _gameState->InitAll(150);
+            });
 
             _titleScreen = std::make_unique<TitleScreen>(*_gameState);
             _uiContext->Initialise();
 
+            if (gOpenRCT2StartupProfile)
+            {
+                PrintStartupProfile(startupTimer.GetElapsedTime().count());
+            }
             return true;
         }
 
+        /**
+         * Loads the object repository and scans for track designs, scenarios and title sequences. Track designs and
+         * scenarios look up objects while they are indexed, so they wait for the object repository. Title sequences do
+         * not depend on anything and are scanned alongside the objects.
+         */
+        void LoadRepositories()
+        {
+            const auto language = _localisationService->GetCurrentLanguage();
+
+            JobPool jobPool;
+            jobPool.AddTask([this]() { RunStartupPhase("title sequences", []() { TitleSequenceManager::Scan(); }); });
+
+            RunStartupPhase("object repository", [this, language]() { _objectRepository->LoadOrConstruct(language); });
+
+            // TODO Like objects, this can take a while if there are a lot of track designs
+            //      its also really something really we might want to do in the background
+            //      as its not required until the player wants to place a new ride.
+            jobPool.AddTask([this, language]() {
+                RunStartupPhase("track design index", [this, language]() { _trackDesignRepository->Scan(language); });
+            });
+            jobPool.AddTask([this, language]() {
+                RunStartupPhase("scenario index", [this, language]() { _scenarioRepository->Scan(language); });
+            });
+            jobPool.Join();
+        }
+
+        void SetupObjectHotReloading()
+        {
+            try
+            {
+                auto base = _env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT);
+                _objectFileWatcher = std::make_unique<FileWatcher>(base);
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to enable hot reloading of objects: %s", e.what());
+            }
+        }
+
+        /**
+         * Updates the repository entries of the object files that changed and reloads the objects that are in use.
+         * Other files, such as images, reload the objects in the same directory as they are most likely used by them.
+         */
+        void ReloadChangedObjects()
+        {
+            // Changing objects would desynchronise the other players, they are kept until the game is single player.
+            if (_objectFileWatcher == nullptr || network_get_mode() != NETWORK_MODE_NONE)
+                return;
+
+            bool anyReloaded = false;
+            for (const auto& path : _objectFileWatcher->GetChangedFiles())
+            {
+                auto extension = Path::GetExtension(path);
+                if (String::Equals(extension, ".json", true) || String::Equals(extension, ".parkobj", true)
+                    || String::Equals(extension, ".dat", true) || String::Equals(extension, ".pob", true))
+                {
+                    const auto* ori = _objectRepository->UpdateObjectFromFile(path);
+                    if (ori != nullptr && ori->LoadedObject != nullptr)
+                    {
+                        _objectManager->ReloadObject(ori);
+                        anyReloaded = true;
+                    }
+                    continue;
+                }
+
+                const auto directory = Path::GetDirectory(path);
+                const auto* items = _objectRepository->GetObjects();
+                for (size_t i = 0; i < _objectRepository->GetNumObjects(); i++)
+                {
+                    if (items[i].LoadedObject != nullptr && Path::Equals(Path::GetDirectory(items[i].Path), directory))
+                    {
+                        _objectManager->ReloadObject(&items[i]);
+                        anyReloaded = true;
+                    }
+                }
+            }
+            if (anyReloaded)
+            {
+                gfx_invalidate_screen();
+            }
+        }
+
+        template<typename TFn> void RunStartupPhase(const char* name, TFn&& fn)
+        {
+            Timer timer;
+            fn();
+            auto elapsed = timer.GetElapsedTime().count();
+
+            std::lock_guard<std::mutex> lock(_startupPhasesMutex);
+            _startupPhases.emplace_back(name, elapsed);
+        }
+
+        void PrintStartupProfile(float totalTime)
+        {
+            std::lock_guard<std::mutex> lock(_startupPhasesMutex);
+            Console::WriteLine("Startup profile:");
+            for (const auto& [name, elapsed] : _startupPhases)
+            {
+                Console::WriteLine("  %-20s %8.3f s", name.c_str(), elapsed);
+            }
+            Console::WriteLine("  %-20s %8.3f s", "total", totalTime);
+        }
+
         void InitialiseDrawingEngine() final override
         {
             assert(_drawingEngine == nullptr);
@@ -543,6 +674,8 @@ namespace OpenRCT2
                 {
                     drawingEngine->Initialise();
                     drawingEngine->SetVSync(gConfigGeneral.use_vsync);
+                    // The palette is only pushed to the drawing engine when it changes.
+                    drawingEngine->SetPalette(gPalette);
                     _drawingEngine = std::move(drawingEngine);
                 }
                 catch (const std::exception& ex)
@@ -943,7 +1076,10 @@ namespace OpenRCT2
                 {
                     gNetworkStartPort = gConfigNetwork.default_port;
                 }
-                _network.BeginClient(gNetworkStartHost, gNetworkStartPort);
+                if (_network.BeginClient(gNetworkStartHost, gNetworkStartPort) && gNetworkRelayPort != 0)
+                {
+                    _network.BeginRelay(gNetworkRelayPort, gNetworkStartAddress);
+                }
             }
 #endif // DISABLE_NETWORK
 
@@ -1139,11 +1275,13 @@ namespace OpenRCT2
 #endif
 
             chat_update();
+            ReloadChangedObjects();
 #ifdef ENABLE_SCRIPTING
             _scriptEngine.Tick();
 #endif
             _stdInOutConsole.ProcessEvalQueue();
             _uiContext->Tick();
+            MemoryAccounting::Update();
         }
 
         /**
@@ -9,14 +9,20 @@
 
 #include "Diagnostic.h"
 
+#include "core/AsyncLogWriter.h"
 #include "core/Console.hpp"
 #include "core/String.hpp"
 
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 
 #ifdef __ANDROID__
 #    include <android/log.h>
+#elif defined(_WIN32)
+#    include <io.h>
+#else
+#    include <unistd.h>
 #endif
 
 [[maybe_unused]] static bool _log_location_enabled = true;
@@ -70,15 +76,69 @@ void diagnostic_log_with_location(
     va_end(args);
 }
 
+void diagnostic_set_async_output(bool enabled)
+{
+}
+
 #else
 
 static constexpr const char* _level_strings[] = {
     "FATAL", "ERROR", "WARNING", "VERBOSE", "INFO",
 };
 
+static std::atomic_bool _asyncOutput = { false };
+static AsyncLogTarget* _asyncStdout = nullptr;
+static AsyncLogTarget* _asyncStderr = nullptr;
+
+static bool diagnostic_is_terminal(FILE* stream)
+{
+#    ifdef _WIN32
+    return _isatty(_fileno(stream)) != 0;
+#    else
+    return isatty(fileno(stream)) != 0;
+#    endif
+}
+
+/**
+ * Writes the log through the shared log writer instead of on the logging thread. Only applies when the output is not
+ * a terminal, the interactive console has to redraw its prompt around the lines.
+ */
+void diagnostic_set_async_output(bool enabled)
+{
+    if (enabled)
+    {
+        if (diagnostic_is_terminal(stdout) || diagnostic_is_terminal(stderr))
+            return;
+
+        auto& writer = AsyncLogWriter::GetShared();
+        if (_asyncStdout == nullptr)
+        {
+            _asyncStdout = writer.OpenStream(stdout);
+            _asyncStderr = writer.OpenStream(stderr);
+        }
+        _asyncOutput = true;
+    }
+    else if (_asyncOutput.exchange(false))
+    {
+        AsyncLogWriter::GetShared().Flush();
+    }
+}
+
 static void diagnostic_print(DiagnosticLevel level, const std::string& prefix, const std::string& msg)
 {
     auto stream = diagnostic_get_stream(level);
+    if (_asyncOutput)
+    {
+        auto& writer = AsyncLogWriter::GetShared();
+        if (level != DiagnosticLevel::Fatal)
+        {
+            writer.Write(stream == stdout ? _asyncStdout : _asyncStderr, prefix + msg + "\n");
+            return;
+        }
+
+        // A fatal error may be the last thing logged before exiting, it is written right away after what is queued.
+        writer.Flush();
+    }
     if (stream == stdout)
         Console::WriteLine("%s%s", prefix.c_str(), msg.c_str());
     else
@@ -71,6 +71,7 @@ enum class DiagnosticLevel
 extern bool _log_levels[static_cast<uint8_t>(DiagnosticLevel::Count)];
 
 void diagnostic_log(DiagnosticLevel diagnosticLevel, const char* format, ...);
+void diagnostic_set_async_output(bool enabled);
 void diagnostic_log_with_location(
     DiagnosticLevel diagnosticLevel, const char* file, const char* function, int32_t line, const char* format, ...);
 
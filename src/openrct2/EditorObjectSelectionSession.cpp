@@ -31,6 +31,7 @@
 #include "world/Scenery.h"
 
 #include <iterator>
+#include <unordered_map>
 #include <vector>
 
 bool _maxObjectsWasHit;
@@ -113,6 +114,8 @@ void setup_in_use_selection_flags()
 {
     auto& objectMgr = OpenRCT2::GetContext()->GetObjectManager();
 
+    // Entry indices of the loaded objects, looking them up in the object manager is a linear search
+    std::unordered_map<const Object*, ObjectEntryIndex> loadedEntryIndices;
     for (uint8_t objectType = 0; objectType < EnumValue(ObjectType::Count); objectType++)
     {
         for (int32_t i = 0; i < object_entry_group_counts[objectType]; i++)
@@ -123,101 +126,106 @@ void setup_in_use_selection_flags()
             if (loadedObj != nullptr)
             {
                 Editor::SetSelectedObject(static_cast<ObjectType>(objectType), i, OBJECT_SELECTION_FLAG_2);
+                loadedEntryIndices.emplace(loadedObj, static_cast<ObjectEntryIndex>(i));
             }
         }
     }
 
-    tile_element_iterator iter;
-    tile_element_iterator_begin(&iter);
-    do
-    {
-        ObjectEntryIndex type;
-
-        switch (iter.element->GetType())
+    // Only the objects used matter, not where, so the elements are visited in storage order
+    VisitAllTileElements([](const TileElement* elements, size_t count) {
+        for (const auto* element = elements; element < elements + count; element++)
         {
-            default:
-            case TileElementType::Surface:
-            {
-                auto surfaceEl = iter.element->AsSurface();
-                auto surfaceIndex = surfaceEl->GetSurfaceStyle();
-                auto edgeIndex = surfaceEl->GetEdgeStyle();
+            ObjectEntryIndex type;
 
-                Editor::SetSelectedObject(ObjectType::TerrainSurface, surfaceIndex, OBJECT_SELECTION_FLAG_SELECTED);
-                Editor::SetSelectedObject(ObjectType::TerrainEdge, edgeIndex, OBJECT_SELECTION_FLAG_SELECTED);
-                break;
-            }
-            case TileElementType::Track:
-                break;
-            case TileElementType::Path:
+            switch (element->GetType())
             {
-                auto footpathEl = iter.element->AsPath();
-                auto legacyPathEntryIndex = footpathEl->GetLegacyPathEntryIndex();
-                if (legacyPathEntryIndex == OBJECT_ENTRY_INDEX_NULL)
-                {
-                    auto surfaceEntryIndex = footpathEl->GetSurfaceEntryIndex();
-                    auto railingEntryIndex = footpathEl->GetRailingsEntryIndex();
-                    Editor::SetSelectedObject(ObjectType::FootpathSurface, surfaceEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
-                    Editor::SetSelectedObject(ObjectType::FootpathRailings, railingEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
-                }
-                else
+                default:
+                case TileElementType::Surface:
                 {
-                    Editor::SetSelectedObject(ObjectType::Paths, legacyPathEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    auto surfaceEl = element->AsSurface();
+                    auto surfaceIndex = surfaceEl->GetSurfaceStyle();
+                    auto edgeIndex = surfaceEl->GetEdgeStyle();
+
+                    Editor::SetSelectedObject(ObjectType::TerrainSurface, surfaceIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    Editor::SetSelectedObject(ObjectType::TerrainEdge, edgeIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    break;
                 }
-                if (footpathEl->HasAddition())
+                case TileElementType::Track:
+                    break;
+                case TileElementType::Path:
                 {
-                    auto pathAdditionEntryIndex = footpathEl->GetAdditionEntryIndex();
-                    Editor::SetSelectedObject(ObjectType::PathBits, pathAdditionEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    auto footpathEl = element->AsPath();
+                    auto legacyPathEntryIndex = footpathEl->GetLegacyPathEntryIndex();
+                    if (legacyPathEntryIndex == OBJECT_ENTRY_INDEX_NULL)
+                    {
+                        auto surfaceEntryIndex = footpathEl->GetSurfaceEntryIndex();
+                        auto railingEntryIndex = footpathEl->GetRailingsEntryIndex();
+                        Editor::SetSelectedObject(
+                            ObjectType::FootpathSurface, surfaceEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                        Editor::SetSelectedObject(
+                            ObjectType::FootpathRailings, railingEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    }
+                    else
+                    {
+                        Editor::SetSelectedObject(ObjectType::Paths, legacyPathEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    }
+                    if (footpathEl->HasAddition())
+                    {
+                        auto pathAdditionEntryIndex = footpathEl->GetAdditionEntryIndex();
+                        Editor::SetSelectedObject(ObjectType::PathBits, pathAdditionEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    }
+                    break;
                 }
-                break;
-            }
-            case TileElementType::SmallScenery:
-                type = iter.element->AsSmallScenery()->GetEntryIndex();
-                Editor::SetSelectedObject(ObjectType::SmallScenery, type, OBJECT_SELECTION_FLAG_SELECTED);
-                break;
-            case TileElementType::Entrance:
-            {
-                auto parkEntranceEl = iter.element->AsEntrance();
-                if (parkEntranceEl->GetEntranceType() != ENTRANCE_TYPE_PARK_ENTRANCE)
+                case TileElementType::SmallScenery:
+                    type = element->AsSmallScenery()->GetEntryIndex();
+                    Editor::SetSelectedObject(ObjectType::SmallScenery, type, OBJECT_SELECTION_FLAG_SELECTED);
                     break;
+                case TileElementType::Entrance:
+                {
+                    auto parkEntranceEl = element->AsEntrance();
+                    if (parkEntranceEl->GetEntranceType() != ENTRANCE_TYPE_PARK_ENTRANCE)
+                        break;
 
-                Editor::SetSelectedObject(ObjectType::ParkEntrance, 0, OBJECT_SELECTION_FLAG_SELECTED);
+                    Editor::SetSelectedObject(ObjectType::ParkEntrance, 0, OBJECT_SELECTION_FLAG_SELECTED);
 
-                // Skip if not the middle part
-                if (parkEntranceEl->GetSequenceIndex() != 0)
-                    break;
+                    // Skip if not the middle part
+                    if (parkEntranceEl->GetSequenceIndex() != 0)
+                        break;
 
-                auto legacyPathEntryIndex = parkEntranceEl->GetLegacyPathEntryIndex();
-                if (legacyPathEntryIndex == OBJECT_ENTRY_INDEX_NULL)
-                {
-                    auto surfaceEntryIndex = parkEntranceEl->GetSurfaceEntryIndex();
-                    Editor::SetSelectedObject(ObjectType::FootpathSurface, surfaceEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
-                }
-                else
-                {
-                    Editor::SetSelectedObject(ObjectType::Paths, legacyPathEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    auto legacyPathEntryIndex = parkEntranceEl->GetLegacyPathEntryIndex();
+                    if (legacyPathEntryIndex == OBJECT_ENTRY_INDEX_NULL)
+                    {
+                        auto surfaceEntryIndex = parkEntranceEl->GetSurfaceEntryIndex();
+                        Editor::SetSelectedObject(
+                            ObjectType::FootpathSurface, surfaceEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    }
+                    else
+                    {
+                        Editor::SetSelectedObject(ObjectType::Paths, legacyPathEntryIndex, OBJECT_SELECTION_FLAG_SELECTED);
+                    }
+                    break;
                 }
-                break;
-            }
-            case TileElementType::Wall:
-                type = iter.element->AsWall()->GetEntryIndex();
-                Editor::SetSelectedObject(ObjectType::Walls, type, OBJECT_SELECTION_FLAG_SELECTED);
-                break;
-            case TileElementType::LargeScenery:
-                type = iter.element->AsLargeScenery()->GetEntryIndex();
-                Editor::SetSelectedObject(ObjectType::LargeScenery, type, OBJECT_SELECTION_FLAG_SELECTED);
-                break;
-            case TileElementType::Banner:
-            {
-                auto banner = iter.element->AsBanner()->GetBanner();
-                if (banner != nullptr)
+                case TileElementType::Wall:
+                    type = element->AsWall()->GetEntryIndex();
+                    Editor::SetSelectedObject(ObjectType::Walls, type, OBJECT_SELECTION_FLAG_SELECTED);
+                    break;
+                case TileElementType::LargeScenery:
+                    type = element->AsLargeScenery()->GetEntryIndex();
+                    Editor::SetSelectedObject(ObjectType::LargeScenery, type, OBJECT_SELECTION_FLAG_SELECTED);
+                    break;
+                case TileElementType::Banner:
                 {
-                    type = banner->type;
-                    Editor::SetSelectedObject(ObjectType::Banners, type, OBJECT_SELECTION_FLAG_SELECTED);
+                    auto banner = element->AsBanner()->GetBanner();
+                    if (banner != nullptr)
+                    {
+                        type = banner->type;
+                        Editor::SetSelectedObject(ObjectType::Banners, type, OBJECT_SELECTION_FLAG_SELECTED);
+                    }
+                    break;
                 }
-                break;
             }
         }
-    } while (tile_element_iterator_next(&iter));
+    });
 
     for (auto& ride : GetRideManager())
     {
@@ -255,7 +263,8 @@ void setup_in_use_selection_flags()
         if (item->LoadedObject != nullptr)
         {
             auto objectType = item->LoadedObject->GetObjectType();
-            auto entryIndex = objectMgr.GetLoadedObjectEntryIndex(item->LoadedObject.get());
+            auto it = loadedEntryIndices.find(item->LoadedObject.get());
+            auto entryIndex = it != loadedEntryIndices.end() ? it->second : OBJECT_ENTRY_INDEX_NULL;
             auto flags = Editor::GetSelectedObjectFlags(objectType, entryIndex);
             if (flags & OBJECT_SELECTION_FLAG_SELECTED)
             {
@@ -40,6 +40,7 @@
 #include "network/network.h"
 #include "object/Object.h"
 #include "object/ObjectList.h"
+#include "park/ParkFile.h"
 #include "platform/Platform2.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
@@ -403,6 +404,9 @@ void game_fix_save_vars()
         ptr->Remove();
     }
 
+    ride_rebuild_queues();
+    ride_update_favourited_stat();
+
     // Fixes broken saves where a surface element could be null
     // and broken saves with incorrect invisible map border tiles
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
@@ -654,11 +658,27 @@ static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processL
     // Calculate how many saves we need to delete.
     numAutosavesToDelete = autosavesCount - numberOfFilesToKeep;
 
-    for (size_t i = 0; numAutosavesToDelete > 0; i++, numAutosavesToDelete--)
+    // Delta autosaves can not be loaded without the full autosave before them, so an autosave is only deleted together
+    // with the deltas that follow it. More autosaves are kept than asked for when that would delete too many.
+    size_t i = 0;
+    while (i < autosavesCount)
     {
-        if (!File::Delete(autosaveFiles[i].data()))
+        size_t groupEnd = i + 1;
+        while (groupEnd < autosavesCount && IsParkFileDelta(autosaveFiles[groupEnd].c_str()))
+        {
+            groupEnd++;
+        }
+        if (groupEnd - i > numAutosavesToDelete)
+        {
+            break;
+        }
+
+        for (; i < groupEnd; i++, numAutosavesToDelete--)
         {
-            log_warning("Failed to delete autosave file: %s", autosaveFiles[i].data());
+            if (!File::Delete(autosaveFiles[i].data()))
+            {
+                log_warning("Failed to delete autosave file: %s", autosaveFiles[i].data());
+            }
         }
     }
 }
@@ -684,6 +704,9 @@ void game_autosave()
         timeName, sizeof(timeName), "autosave_%04u-%02u-%02u_%02u-%02u-%02u%s", currentDate.year, currentDate.month,
         currentDate.day, currentTime.hour, currentTime.minute, currentTime.second, fileExtension);
 
+    // The previous autosave may still be writing the file that is about to be removed or backed up.
+    scenario_wait_for_autosave();
+
     int32_t autosavesToKeep = gConfigGeneral.autosave_amount;
     limit_autosave_count(autosavesToKeep - 1, (gScreenFlags & SCREEN_FLAGS_EDITOR));
 
@@ -18,7 +18,10 @@
 #include "OpenRCT2.h"
 #include "ReplayManager.h"
 #include "actions/GameAction.h"
+#include "audio/audio.h"
 #include "config/Config.h"
+#include "core/PerformanceCounters.h"
+#include "core/Profiler.h"
 #include "entity/EntityRegistry.h"
 #include "entity/Staff.h"
 #include "interface/Screenshot.h"
@@ -35,16 +38,27 @@
 #include "ui/UiContext.h"
 #include "windows/Intent.h"
 #include "world/Climate.h"
+#include "world/Footpath.h"
 #include "world/MapAnimation.h"
 #include "world/Park.h"
 #include "world/Scenery.h"
 
 #include <algorithm>
 #include <chrono>
+#include <limits>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
+static_assert(LogicTimePartNames.size() <= PerformanceCounters::MaxTickParts);
+
+// Clients further behind the server than this switch to catching up instead of running at most 10 ticks per frame.
+static constexpr uint32_t CatchUpStartTicks = 80;
+// Catching up ends once the client is within the normal per frame limit again.
+static constexpr uint32_t CatchUpEndTicks = 10;
+// Upper bound of time spent simulating per frame while catching up, so the client still processes input and packets.
+static constexpr auto CatchUpFrameBudget = std::chrono::milliseconds(250);
+
 GameState::GameState()
 {
     _park = std::make_unique<Park>();
@@ -116,10 +130,33 @@ void GameState::Tick()
     if (network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED
         && network_get_authstatus() == NetworkAuth::Ok)
     {
-        numUpdates = std::clamp<uint32_t>(network_get_server_tick() - gCurrentTicks, 0, 10);
+        const uint32_t ticksBehind = network_get_server_tick() - gCurrentTicks;
+        if (!_catchingUp && ticksBehind > CatchUpStartTicks && ticksBehind < std::numeric_limits<int32_t>::max())
+        {
+            BeginCatchUp();
+        }
+        else if (_catchingUp && ticksBehind <= CatchUpEndTicks)
+        {
+            EndCatchUp();
+            context_force_close_window_by_class(WC_NETWORK_STATUS);
+        }
+
+        if (_catchingUp)
+        {
+            numUpdates = ticksBehind;
+        }
+        else
+        {
+            numUpdates = std::clamp<uint32_t>(ticksBehind, 0, 10);
+        }
     }
     else
     {
+        if (_catchingUp)
+        {
+            EndCatchUp();
+        }
+
         // Determine how many times we need to update the game
         if (gGameSpeed > 1)
         {
@@ -172,9 +209,19 @@ void GameState::Tick()
     }
 
     // Update the game one or more times
+    const auto updateStart = std::chrono::steady_clock::now();
     for (uint32_t i = 0; i < numUpdates; i++)
     {
         UpdateLogic();
+        if (_catchingUp)
+        {
+            // Skip the input checks below, only stop once the frame budget is used up.
+            if (std::chrono::steady_clock::now() - updateStart >= CatchUpFrameBudget)
+            {
+                break;
+            }
+            continue;
+        }
         if (gGameSpeed == 1)
         {
             if (input_get_state() == InputState::Reset || input_get_state() == InputState::Normal)
@@ -194,6 +241,11 @@ void GameState::Tick()
 
     network_flush();
 
+    if (_catchingUp)
+    {
+        UpdateCatchUpStatus(network_get_server_tick() - gCurrentTicks);
+    }
+
     if (!gOpenRCT2Headless)
     {
         input_set_flag(INPUT_FLAG_VIEWPORT_SCROLLING, false);
@@ -241,12 +293,18 @@ void GameState::Tick()
 
 void GameState::UpdateLogic(LogicTimings* timings)
 {
+    PROFILE_ZONE(Tick);
+
     auto start_time = std::chrono::high_resolution_clock::now();
+    auto part_start_time = start_time;
 
-    auto report_time = [timings, start_time](LogicTimePart part) {
+    auto report_time = [timings, start_time, &part_start_time](LogicTimePart part) {
+        const auto now = std::chrono::high_resolution_clock::now();
+        PerformanceCounters::RecordTickPart(EnumValue(part), now - part_start_time);
+        part_start_time = now;
         if (timings != nullptr)
         {
-            timings->TimingInfo[part][timings->CurrentIdx] = std::chrono::high_resolution_clock::now() - start_time;
+            timings->TimingInfo[part][timings->CurrentIdx] = now - start_time;
         }
     };
 
@@ -358,6 +416,14 @@ void GameState::UpdateLogic(LogicTimings* timings)
     }
 
     GameActions::ProcessQueue();
+    if (footpath_has_dirty_wide_flags())
+    {
+        // Bring the wide flags changed by the actions up to date before the tick ends, so a map sent to a joining
+        // client does not depend on pending updates.
+        map_remove_provisional_elements();
+        map_update_path_wide_flags();
+        map_restore_provisional_elements();
+    }
     report_time(LogicTimePart::GameActions);
 
     network_process_pending();
@@ -382,6 +448,42 @@ void GameState::UpdateLogic(LogicTimings* timings)
     {
         timings->CurrentIdx = (timings->CurrentIdx + 1) % LOGIC_UPDATE_MEASUREMENTS_COUNT;
     }
+    PerformanceCounters::RecordTick(std::chrono::high_resolution_clock::now() - start_time);
+}
+
+void GameState::BeginCatchUp()
+{
+    log_verbose("Client is %u ticks behind the server, catching up", network_get_server_tick() - gCurrentTicks);
+    _catchingUp = true;
+
+    // Sounds would only be played in bursts while simulating many ticks per frame.
+    _catchUpPausedAudio = !OpenRCT2::Audio::gGameSoundsOff;
+    if (_catchUpPausedAudio)
+    {
+        OpenRCT2::Audio::Pause();
+    }
+}
+
+void GameState::EndCatchUp()
+{
+    _catchingUp = false;
+    if (_catchUpPausedAudio)
+    {
+        _catchUpPausedAudio = false;
+        OpenRCT2::Audio::Resume();
+    }
+}
+
+void GameState::UpdateCatchUpStatus(uint32_t ticksBehind)
+{
+    char message[256];
+    uint32_t args[1] = { ticksBehind };
+    format_string(message, sizeof(message), STR_MULTIPLAYER_CATCHING_UP, args);
+
+    auto intent = Intent(WC_NETWORK_STATUS);
+    intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ message });
+    intent.putExtra(INTENT_EXTRA_CALLBACK, []() -> void { network_shutdown_client(); });
+    context_open_intent(&intent);
 }
 
 void GameState::CreateStateSnapshot()
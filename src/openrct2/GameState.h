@@ -47,6 +47,32 @@ namespace OpenRCT2
         Scripts,
     };
 
+    // Names of the logic parts in LogicTimePart order
+    constexpr std::array<const char*, static_cast<size_t>(LogicTimePart::Scripts) + 1> LogicTimePartNames = {
+        "NetworkUpdate",
+        "Date",
+        "Scenario",
+        "Climate",
+        "MapTiles",
+        "MapStashProvisionalElements",
+        "MapPathWideFlags",
+        "Peep",
+        "MapRestoreProvisionalElements",
+        "Vehicle",
+        "Misc",
+        "Ride",
+        "Park",
+        "Research",
+        "RideRatings",
+        "RideMeasurements",
+        "News",
+        "MapAnimation",
+        "Sounds",
+        "GameActions",
+        "NetworkFlush",
+        "Scripts",
+    };
+
     // ~6.5s at 40Hz
     constexpr size_t LOGIC_UPDATE_MEASUREMENTS_COUNT = 256;
 
@@ -68,6 +94,9 @@ namespace OpenRCT2
     private:
         std::unique_ptr<Park> _park;
         Date _date;
+        // Set while a network client is far behind the server and simulates without the usual per frame limit.
+        bool _catchingUp{};
+        bool _catchUpPausedAudio{};
 
     public:
         GameState();
@@ -88,5 +117,8 @@ namespace OpenRCT2
 
     private:
         void CreateStateSnapshot();
+        void BeginCatchUp();
+        void EndCatchUp();
+        void UpdateCatchUpStatus(uint32_t ticksBehind);
     };
 } // namespace OpenRCT2
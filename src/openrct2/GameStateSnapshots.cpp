@@ -9,7 +9,6 @@
 
 #include "GameStateSnapshots.h"
 
-#include "core/CircularBuffer.h"
 #include "entity/Balloon.h"
 #include "entity/Duck.h"
 #include "entity/EntityList.h"
@@ -22,7 +21,17 @@
 #include "entity/Staff.h"
 #include "ride/Vehicle.h"
 
-static constexpr size_t MaximumGameStateSnapshots = 32;
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// One minute of history at 40 ticks per second.
+static constexpr size_t MaximumGameStateSnapshots = 2400;
+// Every n-th snapshot keeps its full sprite data, the ones in between only store the delta to their predecessor.
+static constexpr size_t SnapshotKeyframeInterval = 40;
+// Shorter runs of unchanged bytes stay part of the literal as a new run header would not be any smaller.
+static constexpr size_t MinDeltaZeroRun = 4;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
 #pragma pack(push, 1)
@@ -53,6 +62,9 @@ struct GameStateSnapshot_t
     OpenRCT2::MemoryStream storedSprites;
     OpenRCT2::MemoryStream parkParameters;
 
+    // When set, storedSprites holds the delta to the sprite data of this snapshot rather than the sprite data itself.
+    const GameStateSnapshot_t* deltaBase{};
+
     template<typename T> bool EntitySizeCheck(DataSerialiser& ds)
     {
         uint32_t size = sizeof(T);
@@ -165,13 +177,35 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _snapshotsSinceKeyframe = 0;
+        _lastSpriteData.clear();
+        _lastSpriteDataOwner = nullptr;
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
+        // The previous snapshot is complete now, only keep what changed since the one before it.
+        if (!_snapshots.empty())
+        {
+            CompressSnapshot(_snapshots.size() - 1);
+        }
+
         auto snapshot = std::make_unique<GameStateSnapshot_t>();
         _snapshots.push_back(std::move(snapshot));
 
+        if (_snapshots.size() > MaximumGameStateSnapshots)
+        {
+            // Deltas can not be decoded without their keyframe, drop them together.
+            do
+            {
+                if (_lastSpriteDataOwner == _snapshots.front().get())
+                {
+                    _lastSpriteDataOwner = nullptr;
+                }
+                _snapshots.pop_front();
+            } while (_snapshots.size() > 1 && _snapshots.front()->deltaBase != nullptr);
+        }
+
         return *_snapshots.back();
     }
 
@@ -183,6 +217,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
+        snapshot.deltaBase = nullptr;
         snapshot.SerialiseSprites(
             [](const size_t index) { return reinterpret_cast<EntitySnapshot*>(GetEntity(index)); }, MAX_ENTITIES, true);
 
@@ -203,12 +238,169 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     {
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+        if (ds.IsSaving() && snapshot.deltaBase != nullptr)
+        {
+            // Always transferred with the full sprite data.
+            OpenRCT2::MemoryStream spriteData(GetSpriteData(snapshot));
+            ds << spriteData;
+        }
+        else
+        {
+            if (ds.IsLoading())
+            {
+                snapshot.deltaBase = nullptr;
+            }
+            ds << snapshot.storedSprites;
+        }
         ds << snapshot.parkParameters;
     }
 
-    std::vector<EntitySnapshot> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    static const uint8_t* GetStreamData(const OpenRCT2::MemoryStream& stream)
+    {
+        return static_cast<const uint8_t*>(stream.GetData());
+    }
+
+    static void WriteVarInt(std::vector<uint8_t>& out, size_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static size_t ReadVarInt(const uint8_t*& pos, const uint8_t* end)
+    {
+        size_t value = 0;
+        int32_t shift = 0;
+        while (pos < end && shift < 64)
+        {
+            const auto b = *pos++;
+            value |= static_cast<size_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+                break;
+            shift += 7;
+        }
+        return value;
+    }
+
+    /**
+     * Encodes data as the XOR against base, stored as the total length followed by pairs of a run of unchanged bytes
+     * and a run of literal XOR bytes.
+     */
+    static std::vector<uint8_t> EncodeDelta(const std::vector<uint8_t>& base, const uint8_t* data, size_t length)
+    {
+        const auto xorAt = [&](size_t i) -> uint8_t { return data[i] ^ (i < base.size() ? base[i] : 0); };
+
+        std::vector<uint8_t> out;
+        WriteVarInt(out, length);
+        size_t i = 0;
+        while (i < length)
+        {
+            const auto zeroStart = i;
+            while (i < length && xorAt(i) == 0)
+                i++;
+
+            const auto literalStart = i;
+            auto literalEnd = i;
+            for (auto j = i; j < length; j++)
+            {
+                if (xorAt(j) != 0)
+                    literalEnd = j + 1;
+                else if (j - literalEnd + 1 >= MinDeltaZeroRun)
+                    break;
+            }
+
+            WriteVarInt(out, literalStart - zeroStart);
+            WriteVarInt(out, literalEnd - literalStart);
+            for (i = literalStart; i < literalEnd; i++)
+            {
+                out.push_back(xorAt(i));
+            }
+        }
+        return out;
+    }
+
+    static std::vector<uint8_t> DecodeDelta(const std::vector<uint8_t>& base, const uint8_t* delta, size_t deltaLength)
+    {
+        const auto* pos = delta;
+        const auto* end = delta + deltaLength;
+        const auto baseAt = [&](size_t i) -> uint8_t { return i < base.size() ? base[i] : 0; };
+
+        std::vector<uint8_t> out(ReadVarInt(pos, end));
+        size_t i = 0;
+        while (i < out.size() && pos < end)
+        {
+            const auto zeroRun = std::min(ReadVarInt(pos, end), out.size() - i);
+            for (size_t n = 0; n < zeroRun; n++, i++)
+            {
+                out[i] = baseAt(i);
+            }
+            const auto literalRun = std::min({ ReadVarInt(pos, end), out.size() - i, static_cast<size_t>(end - pos) });
+            for (size_t n = 0; n < literalRun; n++, i++)
+            {
+                out[i] = *pos++ ^ baseAt(i);
+            }
+        }
+        return out;
+    }
+
+    /**
+     * Reconstructs the full sprite data by applying the deltas from the nearest keyframe onwards.
+     */
+    std::vector<uint8_t> GetSpriteData(const GameStateSnapshot_t& snapshot) const
     {
+        std::vector<const GameStateSnapshot_t*> chain;
+        for (auto* current = &snapshot; current != nullptr; current = current->deltaBase)
+        {
+            chain.push_back(current);
+        }
+
+        const auto& keyframe = chain.back()->storedSprites;
+        std::vector<uint8_t> data(GetStreamData(keyframe), GetStreamData(keyframe) + keyframe.GetLength());
+        for (auto it = chain.rbegin() + 1; it != chain.rend(); it++)
+        {
+            const auto& delta = (*it)->storedSprites;
+            data = DecodeDelta(data, GetStreamData(delta), static_cast<size_t>(delta.GetLength()));
+        }
+        return data;
+    }
+
+    void CompressSnapshot(size_t index)
+    {
+        auto& snapshot = *_snapshots[index];
+        if (snapshot.deltaBase != nullptr)
+            return;
+
+        std::vector<uint8_t> spriteData(
+            GetStreamData(snapshot.storedSprites), GetStreamData(snapshot.storedSprites) + snapshot.storedSprites.GetLength());
+
+        if (index > 0 && _snapshotsSinceKeyframe + 1 < SnapshotKeyframeInterval)
+        {
+            const auto& base = *_snapshots[index - 1];
+            if (_lastSpriteDataOwner != &base)
+            {
+                _lastSpriteData = GetSpriteData(base);
+            }
+            snapshot.storedSprites = OpenRCT2::MemoryStream(EncodeDelta(_lastSpriteData, spriteData.data(), spriteData.size()));
+            snapshot.deltaBase = &base;
+            _snapshotsSinceKeyframe++;
+        }
+        else
+        {
+            _snapshotsSinceKeyframe = 0;
+        }
+
+        _lastSpriteData = std::move(spriteData);
+        _lastSpriteDataOwner = &snapshot;
+    }
+
+    std::vector<EntitySnapshot> BuildSpriteList(const GameStateSnapshot_t& snapshot) const
+    {
+        GameStateSnapshot_t expanded;
+        expanded.storedSprites = OpenRCT2::MemoryStream(GetSpriteData(snapshot));
+
         std::vector<EntitySnapshot> spriteList;
         spriteList.resize(MAX_ENTITIES);
 
@@ -218,7 +410,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
             sprite.base.Type = EntityType::Null;
         }
 
-        snapshot.SerialiseSprites([&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
+        expanded.SerialiseSprites([&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
 
         return spriteList;
     }
@@ -632,8 +824,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<EntitySnapshot> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<EntitySnapshot> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        std::vector<EntitySnapshot> spritesBase = BuildSpriteList(base);
+        std::vector<EntitySnapshot> spritesCmp = BuildSpriteList(cmp);
 
         for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
         {
@@ -662,6 +854,11 @@ struct GameStateSnapshots final : public IGameStateSnapshots
                 // Do nothing.
                 changeData.changeType = GameStateSpriteChange_t::EQUAL;
             }
+            else if (std::memcmp(&spriteBase, &spriteCmp, sizeof(EntitySnapshot)) == 0)
+            {
+                // Both are read into zeroed slots, identical bytes means no field can differ.
+                changeData.changeType = GameStateSpriteChange_t::EQUAL;
+            }
             else
             {
                 CompareSpriteData(spriteBase, spriteCmp, changeData);
@@ -789,7 +986,11 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     }
 
 private:
-    CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    std::deque<std::unique_ptr<GameStateSnapshot_t>> _snapshots;
+    size_t _snapshotsSinceKeyframe{};
+    // Full sprite data of the most recently compressed snapshot, the base for the next delta.
+    std::vector<uint8_t> _lastSpriteData;
+    const GameStateSnapshot_t* _lastSpriteDataOwner{};
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
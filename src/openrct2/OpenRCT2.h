@@ -47,6 +47,7 @@ extern bool gOpenRCT2Headless;
 extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
+extern bool gOpenRCT2StartupProfile;
 extern utf8 gSilentRecordingName[MAX_PATH];
 
 #ifndef DISABLE_NETWORK
@@ -54,6 +55,7 @@ extern int32_t gNetworkStart;
 extern std::string gNetworkStartHost;
 extern int32_t gNetworkStartPort;
 extern std::string gNetworkStartAddress;
+extern int32_t gNetworkRelayPort;
 #endif
 
 extern uint32_t gCurrentDrawCount;
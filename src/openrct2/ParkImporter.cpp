@@ -20,13 +20,17 @@
 namespace ParkImporter
 {
     std::unique_ptr<IParkImporter> Create(const std::string& hintPath)
+    {
+        return Create(hintPath, OpenRCT2::GetContext()->GetObjectRepository());
+    }
+
+    std::unique_ptr<IParkImporter> Create(const std::string& hintPath, IObjectRepository& objectRepository)
     {
         std::unique_ptr<IParkImporter> parkImporter;
         std::string extension = Path::GetExtension(hintPath);
-        auto* context = OpenRCT2::GetContext();
         if (ExtensionIsOpenRCT2ParkFile(extension))
         {
-            parkImporter = CreateParkFile(context->GetObjectRepository());
+            parkImporter = CreateParkFile(objectRepository);
         }
         else if (ExtensionIsRCT1(extension))
         {
@@ -34,7 +38,7 @@ namespace ParkImporter
         }
         else
         {
-            parkImporter = CreateS6(context->GetObjectRepository());
+            parkImporter = CreateS6(objectRepository);
         }
         return parkImporter;
     }
@@ -55,11 +55,18 @@ public:
 
     virtual void Import() abstract;
     virtual bool GetDetails(scenario_index_entry* dst) abstract;
+
+    /**
+     * Reads only what GetDetails needs from a scenario file, without loading the rest of the park.
+     * Import can not be called afterwards.
+     */
+    virtual bool LoadScenarioDetails(const utf8* path, scenario_index_entry* dst) abstract;
 };
 
 namespace ParkImporter
 {
     [[nodiscard]] std::unique_ptr<IParkImporter> Create(const std::string& hintPath);
+    [[nodiscard]] std::unique_ptr<IParkImporter> Create(const std::string& hintPath, IObjectRepository& objectRepository);
     [[nodiscard]] std::unique_ptr<IParkImporter> CreateS4();
     [[nodiscard]] std::unique_ptr<IParkImporter> CreateS6(IObjectRepository& objectRepository);
     [[nodiscard]] std::unique_ptr<IParkImporter> CreateParkFile(IObjectRepository& objectRepository);
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -35,6 +36,7 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -78,6 +80,14 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    // Snapshot of the park part way through a replay, playback can be restored from it instead of simulating from the start.
+    struct ReplayKeyframe
+    {
+        uint32_t tick;
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -95,15 +105,18 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 10;
+        static constexpr uint16_t ReplayVersion = 11;
+        static constexpr uint16_t ReplayVersionWithoutKeyframes = 10;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
+        static constexpr uint32_t NormalRecordingKeyframeTicks = 40 * 60 * 5; // About five minutes of game time
 
         enum class ReplayMode
         {
@@ -167,6 +180,14 @@ namespace OpenRCT2
                 _nextChecksumTick = gCurrentTicks + ChecksumTicksDelta();
             }
 
+            // Silent recordings are not meant for playback, skip the cost of saving the park for them
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && _recordType == RecordType::NORMAL
+                && gCurrentTicks == _nextKeyframeTick)
+            {
+                AddKeyframe();
+                _nextKeyframeTick = gCurrentTicks + NormalRecordingKeyframeTicks;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (gCurrentTicks >= _currentRecording->tickEnd)
@@ -208,6 +229,19 @@ namespace OpenRCT2
             }
         }
 
+        void AddKeyframe()
+        {
+            auto& keyframe = _currentRecording->keyframes.emplace_back();
+            keyframe.tick = gCurrentTicks;
+
+            // The objects are already packed with the park data at the start of the recording
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->Export(keyframe.parkData);
+
+            DataSerialiser parkParamsDs(true, keyframe.parkParams);
+            SerialiseParkParameters(parkParamsDs);
+        }
+
         void TakeGameStateSnapshot(MemoryStream& snapshotStream)
         {
             IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
@@ -267,6 +301,7 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = gCurrentTicks + 1;
+            _nextKeyframeTick = gCurrentTicks + NormalRecordingKeyframeTicks;
 
             return true;
         }
@@ -427,7 +462,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (!LoadReplayDataMap(replayData->parkData, replayData->parkParams))
             {
                 log_error("Unable to load map.");
                 return false;
@@ -450,6 +485,84 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            const uint32_t targetTick = _currentReplay->tickStart + replayTick;
+            if (targetTick > _currentReplay->tickEnd)
+                return false;
+
+            // Use the last keyframe before the target, if there is none playback has to restart from the beginning
+            const ReplayKeyframe* keyframe = nullptr;
+            for (const auto& replayKeyframe : _currentReplay->keyframes)
+            {
+                if (replayKeyframe.tick <= targetTick)
+                    keyframe = &replayKeyframe;
+            }
+            const uint32_t restoreTick = keyframe != nullptr ? keyframe->tick : _currentReplay->tickStart;
+
+            // Seeking forward past no keyframes is quicker by simulating from where playback already is
+            if (targetTick < gCurrentTicks || restoreTick > gCurrentTicks)
+            {
+                // Commands are removed from the replay as they are executed, so it has to be read again
+                auto replayData = std::make_unique<ReplayRecordData>();
+                if (!ReadReplayData(_currentReplay->filePath, *replayData))
+                {
+                    log_error("Unable to read replay data.");
+                    return false;
+                }
+
+                bool loaded = false;
+                if (restoreTick == replayData->tickStart)
+                {
+                    loaded = LoadReplayDataMap(replayData->parkData, replayData->parkParams);
+                }
+                else
+                {
+                    auto it = std::find_if(
+                        replayData->keyframes.begin(), replayData->keyframes.end(),
+                        [restoreTick](const ReplayKeyframe& item) { return item.tick == restoreTick; });
+                    loaded = it != replayData->keyframes.end() && LoadReplayDataMap(it->parkData, it->parkParams);
+                }
+                if (!loaded)
+                {
+                    // The park may be partly loaded, the replay can not continue
+                    log_error("Unable to load map.");
+                    _currentReplay.reset();
+                    _mode = ReplayMode::NONE;
+                    return false;
+                }
+
+                gCurrentTicks = restoreTick;
+
+                auto& commands = replayData->commands;
+                commands.erase(
+                    commands.begin(),
+                    std::find_if(commands.begin(), commands.end(), [restoreTick](const ReplayCommand& command) {
+                        return command.tick >= restoreTick;
+                    }));
+
+                const auto& checksums = replayData->checksums;
+                replayData->checksumIndex = static_cast<uint32_t>(
+                    std::find_if(
+                        checksums.begin(), checksums.end(),
+                        [restoreTick](const std::pair<uint32_t, EntitiesChecksum>& item) { return item.first >= restoreTick; })
+                    - checksums.begin());
+
+                _currentReplay = std::move(replayData);
+                _faultyChecksumIndex = -1;
+            }
+
+            auto* gameState = GetContext()->GetGameState();
+            while (IsReplaying() && gCurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+            return IsReplaying();
+        }
+
         virtual bool IsPlaybackStateMismatching() const override
         {
             return _faultyChecksumIndex != -1;
@@ -513,17 +626,18 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        bool LoadReplayDataMap(MemoryStream& parkData, MemoryStream& parkParams)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateParkFile(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects);
 
                 importer->Import();
@@ -531,7 +645,7 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 game_load_init();
@@ -704,7 +818,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version == ReplayVersion || data.version == ReplayVersionWithoutKeyframes;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -777,6 +891,24 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            if (data.version != ReplayVersionWithoutKeyframes)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                }
+            }
             return true;
         }
 
@@ -869,6 +1001,7 @@ namespace OpenRCT2
         int32_t _faultyChecksumIndex = -1;
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
+        uint32_t _nextKeyframeTick = 0;
         uint32_t _nextReplayTick = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
@@ -59,6 +59,8 @@ namespace OpenRCT2
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
+        // Moves playback to the given tick from the start of the replay, restoring the closest keyframe before it.
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
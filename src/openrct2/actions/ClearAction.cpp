@@ -75,6 +75,9 @@ GameActions::Result ClearAction::QueryExecute(bool executing) const
     auto x1 = std::min(_range.GetRight(), GetMapSizeMaxXY());
     auto y1 = std::min(_range.GetBottom(), GetMapSizeMaxXY());
 
+    // Removing an element changes the ones left on its tile, every removal is still queried before it is made.
+    GameActions::RegionBatch batch;
+
     for (int32_t y = y0; y <= y1; y += COORDS_XY_STEP)
     {
         for (int32_t x = x0; x <= x1; x += COORDS_XY_STEP)
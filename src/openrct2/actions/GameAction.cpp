@@ -15,20 +15,25 @@
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
 #include "../entity/MoneyEffect.h"
+#include "../interface/Viewport.h"
 #include "../localisation/Formatter.h"
 #include "../localisation/Localisation.h"
 #include "../network/network.h"
+#include "../peep/GuestPathfinding.h"
 #include "../platform/platform.h"
+#include "../ride/RideRatings.h"
 #include "../scenario/Scenario.h"
 #include "../scripting/Duktape.hpp"
 #include "../scripting/HookEngine.h"
 #include "../scripting/ScriptEngine.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
+#include "../world/Map.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 
 #include <algorithm>
+#include <deque>
 #include <iterator>
 
 using namespace OpenRCT2;
@@ -61,7 +66,8 @@ namespace GameActions
         }
     };
 
-    static std::multiset<QueuedGameAction> _actionQueue;
+    // Kept sorted by tick and id. Actions almost always arrive in order so inserting is an append at the back.
+    static std::deque<QueuedGameAction> _actionQueue;
     static uint32_t _nextUniqueId = 0;
     static bool _suspended = false;
 
@@ -89,7 +95,16 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        QueuedGameAction queued(tick, std::move(ga), _nextUniqueId++);
+        if (_actionQueue.empty() || !(queued < _actionQueue.back()))
+        {
+            _actionQueue.push_back(std::move(queued));
+        }
+        else
+        {
+            auto it = std::upper_bound(_actionQueue.begin(), _actionQueue.end(), queued);
+            _actionQueue.insert(it, std::move(queued));
+        }
     }
 
     void ProcessQueue()
@@ -102,14 +117,14 @@ namespace GameActions
 
         const uint32_t currentTick = gCurrentTicks;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        while (!_actionQueue.empty())
         {
             // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
+            const QueuedGameAction& front = _actionQueue.front();
 
             if (network_get_mode() == NETWORK_MODE_CLIENT)
             {
-                if (queued.tick < currentTick)
+                if (front.tick < currentTick)
                 {
                     // This should never happen.
                     Guard::Assert(
@@ -117,14 +132,18 @@ namespace GameActions
                         "Discarding game action %s (%u) from tick behind current tick, ID: %08X, Action Tick: %08X, Current "
                         "Tick: "
                         "%08X\n",
-                        queued.action->GetName(), queued.action->GetType(), queued.uniqueId, queued.tick, currentTick);
+                        front.action->GetName(), front.action->GetType(), front.uniqueId, front.tick, currentTick);
                 }
-                else if (queued.tick > currentTick)
+                else if (front.tick > currentTick)
                 {
                     return;
                 }
             }
 
+            // Take the action out first, executing it may queue new actions.
+            auto queued = std::move(_actionQueue.front());
+            _actionQueue.pop_front();
+
             // Remove ghost scenery so it doesn't interfere with incoming network command
             switch (queued.action->GetType())
             {
@@ -149,8 +168,6 @@ namespace GameActions
                 // Relay this action to all other clients.
                 network_send_game_action(action);
             }
-
-            _actionQueue.erase(_actionQueue.begin());
         }
     }
 
@@ -207,7 +224,9 @@ namespace GameActions
 
         auto result = action->Query();
 
-        if (result.Error == GameActions::Status::Ok)
+        // The action issuing a batch checks the cost of the whole region.
+        const bool isBatched = !topLevel && RegionBatch::GetCurrent() != nullptr;
+        if (result.Error == GameActions::Status::Ok && !isBatched)
         {
             if (!finance_check_affordability(result.Cost, action->GetFlags()))
             {
@@ -307,6 +326,21 @@ namespace GameActions
             }
         }
 
+        auto* batch = topLevel ? nullptr : RegionBatch::GetCurrent();
+        if (batch != nullptr)
+        {
+            auto result = batch->IsValidated() ? action->Execute() : QueryInternal(action, false);
+            if (!batch->IsValidated() && result.Error == GameActions::Status::Ok)
+            {
+                result = action->Execute();
+            }
+            if (result.Error == GameActions::Status::Ok)
+            {
+                batch->SetHasExecuted();
+            }
+            return result;
+        }
+
         GameActions::Result result = QueryInternal(action, topLevel);
 #ifdef ENABLE_SCRIPTING
         if (result.Error == GameActions::Status::Ok
@@ -352,6 +386,11 @@ namespace GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+
+            // The action may have changed paths, entrances or rides the guest flow fields were built on
+            GuestFlowFieldInvalidate();
+            ViewportInteractionInvalidate();
+            MapChanged();
 #ifdef ENABLE_SCRIPTING
             if (result.Error == GameActions::Status::Ok)
             {
@@ -376,6 +415,12 @@ namespace GameActions
 
             if (!(actionFlags & GameActions::Flags::ClientOnly) && result.Error == GameActions::Status::Ok)
             {
+                // Rides next to the change may have different proximity scores now
+                if (!(flags & GAME_COMMAND_FLAG_GHOST))
+                {
+                    ride_ratings_invalidate_near(result.Position);
+                }
+
                 if (network_get_mode() != NETWORK_MODE_NONE)
                 {
                     NetworkPlayerId_t playerId = action->GetPlayer();
@@ -461,6 +506,60 @@ namespace GameActions
     {
         return ExecuteInternal(action, false);
     }
+
+    static RegionBatch* _currentRegionBatch = nullptr;
+
+    RegionBatch::RegionBatch()
+        : _previous(_currentRegionBatch)
+    {
+        _currentRegionBatch = this;
+    }
+
+    RegionBatch::RegionBatch(const MapRange& validatedRange)
+        : _previous(_currentRegionBatch)
+        , _validatedRange(validatedRange)
+    {
+        _currentRegionBatch = this;
+    }
+
+    RegionBatch::~RegionBatch()
+    {
+        _currentRegionBatch = _previous;
+        if (!_hasExecuted)
+            return;
+
+        if (_validatedRange.has_value())
+        {
+            map_invalidate_region(_validatedRange->Point1, _validatedRange->Point2);
+        }
+        GuestFlowFieldInvalidate();
+        ViewportInteractionInvalidate();
+        MapChanged();
+        if (_previous != nullptr)
+        {
+            _previous->SetHasExecuted();
+        }
+    }
+
+    RegionBatch* RegionBatch::GetCurrent()
+    {
+        return _currentRegionBatch;
+    }
+
+    bool RegionBatch::IsValidated() const
+    {
+        return _validatedRange.has_value();
+    }
+
+    void RegionBatch::SetHasExecuted()
+    {
+        _hasExecuted = true;
+    }
+
+    bool IsRegionInvalidationBatched()
+    {
+        return _currentRegionBatch != nullptr && _currentRegionBatch->IsValidated();
+    }
 } // namespace GameActions
 
 const char* GameAction::GetName() const
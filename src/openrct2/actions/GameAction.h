@@ -19,6 +19,7 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 
 namespace GameActions
@@ -285,4 +286,38 @@ namespace GameActions
     GameActions::Result QueryNested(const GameAction* action);
     GameActions::Result ExecuteNested(const GameAction* action);
 
+    /**
+     * Groups the nested actions an action issues for the tiles of a region, e.g. a land drag. While the batch is alive,
+     * nested actions are not logged, hooked or checked for affordability one by one, the action as a whole is. Guest flow
+     * fields and viewport interaction are invalidated once the batch ends.
+     *
+     * With a validated range, the action has queried all of its nested actions against the same map right before it is
+     * executed. Nested actions then only touch their own tile, so they are executed without being queried again and the
+     * range is invalidated at once instead of tile by tile.
+     */
+    class RegionBatch
+    {
+    private:
+        RegionBatch* _previous{};
+        std::optional<MapRange> _validatedRange;
+        bool _hasExecuted{};
+
+    public:
+        RegionBatch();
+        explicit RegionBatch(const MapRange& validatedRange);
+        RegionBatch(const RegionBatch&) = delete;
+        RegionBatch& operator=(const RegionBatch&) = delete;
+        ~RegionBatch();
+
+        static RegionBatch* GetCurrent();
+
+        bool IsValidated() const;
+        void SetHasExecuted();
+    };
+
+    /**
+     * @return true if nested actions are run in a batch that invalidates their tiles, they must not invalidate them.
+     */
+    bool IsRegionInvalidationBatched();
+
 } // namespace GameActions
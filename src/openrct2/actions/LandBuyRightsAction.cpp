@@ -20,6 +20,7 @@
 #include "../ride/RideData.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "../world/MapOwnership.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
@@ -78,6 +79,13 @@ GameActions::Result LandBuyRightsAction::QueryExecute(bool isExecuting) const
     res.Position = centre;
     res.Expenditure = ExpenditureType::LandPurchase;
 
+    // The ownership layer follows the changed tiles, so the remaining land rights are counted without a rebuild.
+    auto& ownershipLayer = GetMapOwnershipLayer();
+    if (isExecuting)
+    {
+        ownershipLayer.Refresh();
+    }
+
     // Game command modified to accept selection size
     for (auto y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
     {
@@ -90,10 +98,15 @@ GameActions::Result LandBuyRightsAction::QueryExecute(bool isExecuting) const
             {
                 res.Cost += result.Cost;
             }
+            if (isExecuting)
+            {
+                ownershipLayer.UpdateTile(TileCoordsXY{ CoordsXY{ x, y } });
+            }
         }
     }
     if (isExecuting)
     {
+        ownershipLayer.MarkUpToDate();
         map_count_remaining_land_rights();
     }
     return res;
@@ -79,6 +79,9 @@ GameActions::Result LandLowerAction::QueryExecute(bool isExecuting) const
     }
 
     uint8_t maxHeight = map_get_highest_land_height(validRange);
+    // Every tile has been queried against the same map right before the region is executed.
+    auto batch = isExecuting ? GameActions::RegionBatch(validRange) : GameActions::RegionBatch();
+
     bool withinOwnership = false;
 
     for (int32_t y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
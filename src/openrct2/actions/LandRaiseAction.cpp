@@ -80,6 +80,9 @@ GameActions::Result LandRaiseAction::QueryExecute(bool isExecuting) const
     }
 
     uint8_t minHeight = map_get_lowest_land_height(validRange);
+    // Every tile has been queried against the same map right before the region is executed.
+    auto batch = isExecuting ? GameActions::RegionBatch(validRange) : GameActions::RegionBatch();
+
     bool withinOwnership = false;
 
     for (int32_t y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
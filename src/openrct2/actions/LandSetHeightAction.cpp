@@ -375,7 +375,10 @@ void LandSetHeightAction::SetSurfaceHeight(TileElement* surfaceElement) const
         surfaceElement->AsSurface()->SetWaterHeight(0);
     }
 
-    map_invalidate_tile_full(_coords);
+    if (!GameActions::IsRegionInvalidationBatched())
+    {
+        map_invalidate_tile_full(_coords);
+    }
 }
 
 int32_t LandSetHeightAction::map_set_land_height_clear_func(
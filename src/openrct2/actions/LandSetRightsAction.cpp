@@ -20,6 +20,7 @@
 #include "../ride/RideData.h"
 #include "../util/Math.hpp"
 #include "../windows/Intent.h"
+#include "../world/MapOwnership.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
@@ -88,6 +89,13 @@ GameActions::Result LandSetRightsAction::QueryExecute(bool isExecuting) const
         return GameActions::Result(GameActions::Status::NotInEditorMode, STR_NONE, STR_LAND_NOT_FOR_SALE);
     }
 
+    // The ownership layer follows the changed tiles, so the remaining land rights are counted without a rebuild.
+    auto& ownershipLayer = GetMapOwnershipLayer();
+    if (isExecuting)
+    {
+        ownershipLayer.Refresh();
+    }
+
     // Game command modified to accept selection size
     for (auto y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
     {
@@ -100,11 +108,16 @@ GameActions::Result LandSetRightsAction::QueryExecute(bool isExecuting) const
             {
                 res.Cost += result.Cost;
             }
+            if (isExecuting)
+            {
+                ownershipLayer.UpdateTile(TileCoordsXY{ CoordsXY{ x, y } });
+            }
         }
     }
 
     if (isExecuting)
     {
+        ownershipLayer.MarkUpToDate();
         map_count_remaining_land_rights();
         OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, centre);
     }
@@ -330,6 +330,9 @@ GameActions::Result LandSmoothAction::SmoothLand(bool isExecuting) const
     auto b = std::clamp(normRange.GetBottom(), 0, MAXIMUM_TILE_START_XY);
     auto validRange = MapRange{ l, t, r, b };
 
+    // Smoothing may change a tile outside of the range more than once, every change is still queried before it is made.
+    GameActions::RegionBatch batch;
+
     int32_t centreZ = tile_element_height(_coords);
 
     auto res = GameActions::Result();
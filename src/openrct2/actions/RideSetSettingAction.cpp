@@ -230,6 +230,8 @@ GameActions::Result RideSetSettingAction::Execute() const
             break;
     }
 
+    ride_ratings_invalidate(ride->id);
+
     auto res = GameActions::Result();
     if (!ride->overall_view.IsNull())
     {
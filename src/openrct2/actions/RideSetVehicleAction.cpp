@@ -191,6 +191,7 @@ GameActions::Result RideSetVehicleAction::Execute() const
 
     ride->num_circuits = 1;
     ride->UpdateMaxVehicles();
+    ride_ratings_invalidate(ride->id);
 
     auto res = GameActions::Result();
     if (!ride->overall_view.IsNull())
@@ -632,8 +632,7 @@ void SetCheatAction::RemoveAllGuests() const
 
         for (size_t stationIndex = 0; stationIndex < MAX_STATIONS; stationIndex++)
         {
-            ride.stations[stationIndex].QueueLength = 0;
-            ride.stations[stationIndex].LastPeepInQueue = SPRITE_INDEX_NULL;
+            ride.QueueClear(static_cast<StationIndex>(stationIndex));
         }
 
         for (auto trainIndex : ride.vehicles)
@@ -17,6 +17,7 @@
 #include "../rct12/RCT12.h"
 #include "../ride/RideConstruction.h"
 #include "../ride/TrackDesign.h"
+#include "../world/ConstructionClearance.h"
 #include "RideCreateAction.h"
 #include "RideDemolishAction.h"
 #include "RideSetNameAction.h"
@@ -100,6 +101,8 @@ GameActions::Result TrackDesignAction::Query() const
     if (GetFlags() & GAME_COMMAND_FLAG_REPLAY)
         flags |= GAME_COMMAND_FLAG_REPLAY;
 
+    // The design is queried with and possibly without scenery, reuse the clearance index of the tiles between them.
+    ConstructionClearanceQueryScope clearanceScope;
     auto queryRes = TrackDesignPlace(const_cast<TrackDesign*>(&_td), flags, placeScenery, ride, _loc);
     if (_trackDesignPlaceStateSceneryUnavailable)
     {
@@ -65,6 +65,9 @@ GameActions::Result WaterLowerAction::QueryExecute(bool isExecuting) const
     res.Expenditure = ExpenditureType::Landscaping;
 
     uint8_t minHeight = GetLowestHeight(validRange);
+    // Every tile has been queried against the same map right before the region is executed.
+    auto batch = isExecuting ? GameActions::RegionBatch(validRange) : GameActions::RegionBatch();
+
     bool hasChanged = false;
     bool withinOwnership = false;
     for (int32_t y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
@@ -65,6 +65,9 @@ GameActions::Result WaterRaiseAction::QueryExecute(bool isExecuting) const
     res.Expenditure = ExpenditureType::Landscaping;
 
     auto maxHeight = GetHighestHeight(validRange) / COORDS_Z_STEP;
+    // Every tile has been queried against the same map right before the region is executed.
+    auto batch = isExecuting ? GameActions::RegionBatch(validRange) : GameActions::RegionBatch();
+
     bool hasChanged = false;
     bool withinOwnership = false;
     for (int32_t y = validRange.GetTop(); y <= validRange.GetBottom(); y += COORDS_XY_STEP)
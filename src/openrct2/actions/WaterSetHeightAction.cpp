@@ -124,7 +124,10 @@ GameActions::Result WaterSetHeightAction::Execute() const
     {
         surfaceElement->SetWaterHeight(0);
     }
-    map_invalidate_tile_full(_coords);
+    if (!GameActions::IsRegionInvalidationBatched())
+    {
+        map_invalidate_tile_full(_coords);
+    }
 
     res.Cost = 250;
 
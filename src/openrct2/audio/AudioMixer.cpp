@@ -81,9 +81,7 @@ void Mixer_Channel_Volume(void* channel, int32_t volume)
     IAudioMixer* audioMixer = GetMixer();
     if (audioMixer != nullptr)
     {
-        audioMixer->Lock();
-        static_cast<IAudioChannel*>(channel)->SetVolume(volume);
-        audioMixer->Unlock();
+        audioMixer->SetChannelVolume(static_cast<IAudioChannel*>(channel), volume);
     }
 }
 
@@ -92,9 +90,7 @@ void Mixer_Channel_Pan(void* channel, float pan)
     IAudioMixer* audioMixer = GetMixer();
     if (audioMixer != nullptr)
     {
-        audioMixer->Lock();
-        static_cast<IAudioChannel*>(channel)->SetPan(pan);
-        audioMixer->Unlock();
+        audioMixer->SetChannelPan(static_cast<IAudioChannel*>(channel), pan);
     }
 }
 
@@ -103,9 +99,7 @@ void Mixer_Channel_Rate(void* channel, double rate)
     IAudioMixer* audioMixer = GetMixer();
     if (audioMixer != nullptr)
     {
-        audioMixer->Lock();
-        static_cast<IAudioChannel*>(channel)->SetRate(rate);
-        audioMixer->Unlock();
+        audioMixer->SetChannelRate(static_cast<IAudioChannel*>(channel), rate);
     }
 }
 
@@ -48,6 +48,11 @@ namespace OpenRCT2::Audio
         virtual bool LoadMusic(size_t pathid) abstract;
         virtual void SetVolume(float volume) abstract;
 
+        // Queued and applied by the audio thread at the start of its next chunk, so the caller never waits on the device.
+        virtual void SetChannelVolume(IAudioChannel* channel, int32_t volume) abstract;
+        virtual void SetChannelPan(IAudioChannel* channel, float pan) abstract;
+        virtual void SetChannelRate(IAudioChannel* channel, double rate) abstract;
+
         virtual IAudioSource* GetSoundSource(SoundId id) abstract;
         virtual IAudioSource* GetMusicSource(int32_t id) abstract;
     };
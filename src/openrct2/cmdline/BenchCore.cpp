@@ -0,0 +1,353 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../ParkImporter.h"
+#    include "../core/DataSerialiser.h"
+#    include "../core/File.h"
+#    include "../core/MemoryStream.h"
+#    include "../entity/EntityList.h"
+#    include "../entity/Guest.h"
+#    include "../object/ObjectManager.h"
+#    include "../park/ParkFile.h"
+#    include "../peep/GuestPathfinding.h"
+#    include "../platform/platform.h"
+#    include "../ride/Vehicle.h"
+#    include "../scenario/Scenario.h"
+#    include "../world/Entrance.h"
+#    include "../world/Map.h"
+#    include "../world/TileElementsView.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+/**
+ * Creates a context with the given park loaded, on failure the benchmark is skipped and nullptr is returned.
+ */
+static std::unique_ptr<IContext> LoadPark(benchmark::State& state, const std::string& filename)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return nullptr;
+    }
+    if (!context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return nullptr;
+    }
+    return context;
+}
+
+template<typename TFunc> static void ForEachTile(TFunc&& func)
+{
+    for (int32_t y = 0; y < gMapSize; y++)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            func(TileCoordsXY{ x, y }.ToCoordsXY());
+        }
+    }
+}
+
+template<typename T> static void BM_tile_elements_view(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    size_t elements = 0;
+    for (auto _ : state)
+    {
+        ForEachTile([&elements](const CoordsXY& loc) {
+            for (auto* element : TileElementsView<T>(loc))
+            {
+                benchmark::DoNotOptimize(element);
+                elements++;
+            }
+        });
+    }
+    state.SetItemsProcessed(elements);
+}
+
+static void BM_map_get_element_at(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    size_t lookups = 0;
+    for (auto _ : state)
+    {
+        ForEachTile([&lookups](const CoordsXY& loc) {
+            auto* surfaceElement = map_get_surface_element_at(loc);
+            benchmark::DoNotOptimize(surfaceElement);
+            lookups++;
+            if (surfaceElement != nullptr)
+            {
+                auto* pathElement = map_get_path_element_at({ TileCoordsXY(loc), surfaceElement->base_height });
+                benchmark::DoNotOptimize(pathElement);
+                lookups++;
+            }
+        });
+    }
+    state.SetItemsProcessed(lookups);
+}
+
+static void BM_entity_tile_list(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    size_t entities = 0;
+    for (auto _ : state)
+    {
+        ForEachTile([&entities](const CoordsXY& loc) {
+            for (auto* entity : EntityTileList(loc))
+            {
+                benchmark::DoNotOptimize(entity);
+                entities++;
+            }
+        });
+    }
+    state.SetItemsProcessed(entities);
+}
+
+template<typename T> static void BM_entity_list(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    size_t entities = 0;
+    for (auto _ : state)
+    {
+        for (auto* entity : EntityList<T>())
+        {
+            benchmark::DoNotOptimize(entity);
+            entities++;
+        }
+    }
+    state.SetItemsProcessed(entities);
+}
+
+// Has every walking guest pick a direction towards the first park entrance. The guests keep their pathfinding history
+// between iterations, like they would between ticks.
+static void BM_pathfind(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    if (gParkEntrances.empty())
+    {
+        state.SkipWithError("Park has no entrance!");
+        return;
+    }
+
+    std::vector<Guest*> guests;
+    for (auto* guest : EntityList<Guest>())
+    {
+        if (guest->State == PeepState::Walking && !guest->OutsideOfPark)
+        {
+            guests.push_back(guest);
+        }
+    }
+
+    scenario_rand_seed(0x12345678, 0x87654321);
+    const TileCoordsXYZ goal(gParkEntrances[0]);
+    for (auto _ : state)
+    {
+        for (auto* guest : guests)
+        {
+            gPeepPathFindGoalPosition = goal;
+            benchmark::DoNotOptimize(peep_pathfind_choose_direction(TileCoordsXYZ(guest->NextLoc), guest));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * guests.size());
+    state.counters["Guests"] = static_cast<double>(guests.size());
+}
+
+// Round trips the elements of every tile, one vector per tile as the length of a vector is limited to 16 bits.
+static void BM_data_serialiser(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    std::vector<std::vector<TileElement>> tiles;
+    ForEachTile([&tiles](const CoordsXY& loc) {
+        auto& elements = tiles.emplace_back();
+        for (auto* element : TileElementsView(loc))
+        {
+            elements.push_back(*element);
+        }
+    });
+
+    size_t bytes = 0;
+    std::vector<TileElement> loaded;
+    for (auto _ : state)
+    {
+        MemoryStream stream;
+        DataSerialiser saver(true, stream);
+        for (auto& elements : tiles)
+        {
+            saver << elements;
+        }
+
+        stream.SetPosition(0);
+        DataSerialiser loader(false, stream);
+        for (size_t i = 0; i < tiles.size(); i++)
+        {
+            loaded.clear();
+            loader << loaded;
+            benchmark::DoNotOptimize(loaded.data());
+        }
+        bytes += stream.GetLength();
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void BM_park_file_save(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        MemoryStream stream;
+        ParkFileExporter().Export(stream);
+        bytes += stream.GetLength();
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void BM_park_file_load(benchmark::State& state, const std::string& filename)
+{
+    auto context = LoadPark(state, filename);
+    if (context == nullptr)
+        return;
+
+    MemoryStream parkData;
+    ParkFileExporter().Export(parkData);
+
+    auto& objectManager = context->GetObjectManager();
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        parkData.SetPosition(0);
+        auto importer = ParkImporter::CreateParkFile(context->GetObjectRepository());
+        auto loadResult = importer->LoadFromStream(&parkData, false);
+        objectManager.LoadObjects(loadResult.RequiredObjects);
+        importer->Import();
+        bytes += parkData.GetLength();
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void RegisterParkBenchmarks(const std::string& filename)
+{
+    auto registerBenchmark = [&filename](const char* name, void (*func)(benchmark::State&, const std::string&)) {
+        auto fullName = filename + "/" + name;
+        benchmark::RegisterBenchmark(fullName.c_str(), func, filename);
+    };
+    registerBenchmark("tile_elements_view", BM_tile_elements_view<TileElement>);
+    registerBenchmark("tile_elements_view_path", BM_tile_elements_view<PathElement>);
+    registerBenchmark("map_get_element_at", BM_map_get_element_at);
+    registerBenchmark("entity_tile_list", BM_entity_tile_list);
+    registerBenchmark("entity_list_guest", BM_entity_list<Guest>);
+    registerBenchmark("entity_list_vehicle", BM_entity_list<Vehicle>);
+    registerBenchmark("pathfind", BM_pathfind);
+    registerBenchmark("data_serialiser", BM_data_serialiser);
+    registerBenchmark("park_file_save", BM_park_file_save);
+    registerBenchmark("park_file_load", BM_park_file_load);
+}
+
+static int CmdlineForBenchCore(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (File::Exists(argv[i]))
+        {
+            RegisterParkBenchmarks(argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchCore(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchCore(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchCore(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchCoreCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchCore),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchCore), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,283 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static utf8* _outputPath = nullptr;
+static utf8* _baselinePath = nullptr;
+static float _tolerance = 10.0f;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition BenchReplayOptions[]
+{
+    { CMDLINE_TYPE_STRING, &_outputPath,   NAC, "output",    "write the results as JSON to this file"                              },
+    { CMDLINE_TYPE_STRING, &_baselinePath, NAC, "baseline",  "compare the results against a JSON file written with --output"      },
+    { CMDLINE_TYPE_REAL,   &_tolerance,    NAC, "tolerance", "slowdown against the baseline in percent that fails (default 10)" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleBenchReplay(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::BenchReplayCommands[]
+{
+    // Main commands
+    DefineCommand("", "<replay_file_or_directory>...", BenchReplayOptions, HandleBenchReplay),
+    CommandTableEnd
+};
+// clang-format on
+
+struct ReplayBenchResult
+{
+    std::string Name;
+    uint32_t Ticks{};
+    double Seconds{};
+    std::array<double, LogicTimePartNames.size()> PartSeconds{};
+
+    double GetTicksPerSecond() const
+    {
+        return Seconds > 0 ? Ticks / Seconds : 0;
+    }
+};
+
+std::vector<std::string> CommandLine::GetReplayFiles(const std::vector<std::string>& paths)
+{
+    std::vector<std::string> result;
+    for (const auto& path : paths)
+    {
+        if (Path::DirectoryExists(path))
+        {
+            auto scanner = Path::ScanDirectory(Path::Combine(path, "*.parkrep"), true);
+            while (scanner->Next())
+            {
+                result.push_back(scanner->GetPath());
+            }
+        }
+        else
+        {
+            result.push_back(path);
+        }
+    }
+    return result;
+}
+
+static bool RunReplay(IContext& context, const std::string& path, ReplayBenchResult& result)
+{
+    auto* replayManager = context.GetReplayManager();
+    if (!replayManager->StartPlayback(path))
+    {
+        Console::Error::WriteLine("Unable to start replay: %s", path.c_str());
+        return false;
+    }
+
+    result.Name = Path::GetFileNameWithoutExtension(path);
+
+    // Every part reports the time since the start of the tick, parts not run in a tick keep a zero.
+    LogicTimings timings;
+    auto* gameState = context.GetGameState();
+    const auto start = std::chrono::high_resolution_clock::now();
+    while (replayManager->IsReplaying())
+    {
+        const auto index = timings.CurrentIdx;
+        for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+        {
+            timings.TimingInfo[static_cast<LogicTimePart>(i)][index] = {};
+        }
+
+        gameState->UpdateLogic(&timings);
+        result.Ticks++;
+
+        std::chrono::duration<double> previous{};
+        for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+        {
+            auto elapsed = timings.TimingInfo[static_cast<LogicTimePart>(i)][index];
+            if (elapsed.count() > 0)
+            {
+                result.PartSeconds[i] += (elapsed - previous).count();
+                previous = elapsed;
+            }
+        }
+
+        if (replayManager->IsPlaybackStateMismatching())
+        {
+            Console::Error::WriteLine("Replay %s desynchronised at tick %u.", result.Name.c_str(), result.Ticks);
+            replayManager->StopPlayback();
+            return false;
+        }
+    }
+    result.Seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return true;
+}
+
+static json_t ResultsToJson(const std::vector<ReplayBenchResult>& results)
+{
+    json_t jsonReplays = json_t::array();
+    for (const auto& result : results)
+    {
+        json_t jsonParts = json_t::object();
+        for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+        {
+            jsonParts[LogicTimePartNames[i]] = result.PartSeconds[i] * 1000.0;
+        }
+        json_t jsonReplay = {
+            { "name", result.Name },
+            { "ticks", result.Ticks },
+            { "timeMs", result.Seconds * 1000.0 },
+            { "ticksPerSecond", result.GetTicksPerSecond() },
+            { "partsMs", jsonParts },
+        };
+        jsonReplays.push_back(std::move(jsonReplay));
+    }
+    return { { "replays", jsonReplays } };
+}
+
+/**
+ * Compares the tick rate of every replay that is also in the baseline.
+ * @return false if any replay is slower than the baseline by more than the tolerance.
+ */
+static bool CompareWithBaseline(const std::vector<ReplayBenchResult>& results, const json_t& baseline)
+{
+    bool passed = true;
+    for (const auto& result : results)
+    {
+        const json_t* baselineReplay = nullptr;
+        for (const auto& jsonReplay : baseline["replays"])
+        {
+            if (Json::GetString(jsonReplay["name"]) == result.Name)
+            {
+                baselineReplay = &jsonReplay;
+                break;
+            }
+        }
+        if (baselineReplay == nullptr)
+        {
+            Console::WriteLine("%-32s not in baseline", result.Name.c_str());
+            continue;
+        }
+
+        const auto baselineTicksPerSecond = Json::GetNumber<double>((*baselineReplay)["ticksPerSecond"]);
+        if (baselineTicksPerSecond <= 0)
+            continue;
+
+        const auto slowdown = (1.0 - result.GetTicksPerSecond() / baselineTicksPerSecond) * 100.0;
+        const bool regressed = slowdown > _tolerance;
+        Console::WriteLine(
+            "%-32s %10.1f ticks/s, baseline %10.1f ticks/s (%+.1f%%)%s", result.Name.c_str(), result.GetTicksPerSecond(),
+            baselineTicksPerSecond, -slowdown, regressed ? " REGRESSION" : "");
+        if (!regressed)
+            continue;
+
+        // Point at the parts that got slower to narrow down the cause.
+        passed = false;
+        const auto& baselineParts = (*baselineReplay)["partsMs"];
+        for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+        {
+            const auto baselineMsPerTick = Json::GetNumber<double>(baselineParts[LogicTimePartNames[i]])
+                / std::max(Json::GetNumber<double>((*baselineReplay)["ticks"]), 1.0);
+            const auto msPerTick = result.PartSeconds[i] * 1000.0 / std::max<double>(result.Ticks, 1);
+            if (baselineMsPerTick > 0 && msPerTick > baselineMsPerTick * (1.0 + _tolerance / 100.0))
+            {
+                Console::WriteLine(
+                    "    %-30s %8.4f ms/tick, baseline %8.4f ms/tick", LogicTimePartNames[i], msPerTick, baselineMsPerTick);
+            }
+        }
+    }
+    return passed;
+}
+
+static exitcode_t HandleBenchReplay(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    // Options have already been parsed, they all follow the paths.
+    std::vector<std::string> paths;
+    for (int32_t i = 0; i < argc && argv[i][0] != '-'; i++)
+    {
+        paths.emplace_back(argv[i]);
+    }
+    auto replayFiles = CommandLine::GetReplayFiles(paths);
+    if (replayFiles.empty())
+    {
+        Console::Error::WriteLine("Missing arguments <replay_file_or_directory>...");
+        return EXITCODE_FAIL;
+    }
+
+    json_t baseline;
+    if (_baselinePath != nullptr)
+    {
+        try
+        {
+            baseline = Json::ReadFromFile(_baselinePath);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to read baseline %s: %s", _baselinePath, e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<ReplayBenchResult> results;
+    for (const auto& replayFile : replayFiles)
+    {
+        ReplayBenchResult result;
+        if (!RunReplay(*context, replayFile, result))
+        {
+            return EXITCODE_FAIL;
+        }
+        Console::WriteLine(
+            "%-32s %8u ticks in %8.1f ms, %10.1f ticks/s", result.Name.c_str(), result.Ticks, result.Seconds * 1000.0,
+            result.GetTicksPerSecond());
+        results.push_back(std::move(result));
+    }
+
+    if (_outputPath != nullptr)
+    {
+        Json::WriteToFile(_outputPath, ResultsToJson(results));
+    }
+    else
+    {
+        Console::WriteLine("%s", ResultsToJson(results).dump(4).c_str());
+    }
+
+    if (_baselinePath != nullptr && !CompareWithBaseline(results, baseline))
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
@@ -16,10 +16,14 @@
 #    include "../Intro.h"
 #    include "../OpenRCT2.h"
 #    include "../audio/audio.h"
+#    include "../config/Config.h"
 #    include "../core/Console.hpp"
 #    include "../core/File.h"
 #    include "../core/Imaging.h"
+#    include "../core/JobPool.h"
 #    include "../drawing/Drawing.h"
+#    include "../drawing/NewDrawing.h"
+#    include "../drawing/X8DrawingEngine.h"
 #    include "../interface/Viewport.h"
 #    include "../localisation/Localisation.h"
 #    include "../paint/Paint.h"
@@ -30,11 +34,19 @@
 #    include "../world/Park.h"
 #    include "../world/Surface.h"
 
+#    include <algorithm>
 #    include <benchmark/benchmark.h>
+#    include <chrono>
 #    include <cstdint>
 #    include <iterator>
+#    include <memory>
+#    include <string>
+#    include <thread>
 #    include <vector>
 
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
 static void fixup_pointers(std::vector<RecordedPaintSession>& s)
 {
     for (size_t i = 0; i < s.size(); i++)
@@ -68,25 +80,33 @@ static void fixup_pointers(std::vector<RecordedPaintSession>& s)
     }
 }
 
-static std::vector<RecordedPaintSession> extract_paint_session(std::string_view parkFileName)
+static std::unique_ptr<IContext> _benchContext;
+static std::string _loadedParkFileName;
+
+static bool load_park(const std::string& parkFileName)
+{
+    if (_loadedParkFileName == parkFileName)
+    {
+        return true;
+    }
+    _loadedParkFileName.clear();
+    if (!_benchContext->LoadParkFromFile(parkFileName))
+    {
+        log_error("Failed to load park!");
+        return false;
+    }
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    _loadedParkFileName = parkFileName;
+    return true;
+}
+
+static std::vector<RecordedPaintSession> extract_paint_session(const std::string& parkFileName)
 {
-    core_init();
-    gOpenRCT2Headless = true;
-    auto context = OpenRCT2::CreateContext();
     std::vector<RecordedPaintSession> sessions;
     log_info("Starting...");
-    if (context->Initialise())
+    if (load_park(parkFileName))
     {
-        drawing_engine_init();
-        if (!context->LoadParkFromFile(std::string(parkFileName)))
-        {
-            log_error("Failed to load park!");
-            return {};
-        }
-
-        gIntroState = IntroState::None;
-        gScreenFlags = SCREEN_FLAGS_PLAYING;
-
         int32_t mapSize = gMapSize;
         int32_t resolutionWidth = (mapSize * 32 * 2);
         int32_t resolutionHeight = (mapSize * 32 * 1);
@@ -130,7 +150,6 @@ static std::vector<RecordedPaintSession> extract_paint_session(std::string_view
         viewport_render(&dpi, &viewport, { { 0, 0 }, { viewport.width, viewport.height } }, &sessions);
 
         free(dpi.bits);
-        drawing_engine_dispose();
     }
     log_info("Got %u paint sessions.", std::size(sessions));
     return sessions;
@@ -158,6 +177,320 @@ static void BM_paint_session_arrange(benchmark::State& state, const std::vector<
     delete[] local_s;
 }
 
+/**
+ * A screen sized view of the middle of the park at the zoom and rotation given by the benchmark arguments,
+ * with a pixel buffer to draw it into.
+ */
+struct PaintBenchView
+{
+    static constexpr int32_t Width = 1920;
+    static constexpr int32_t Height = 1080;
+
+    rct_viewport Viewport{};
+    rct_drawpixelinfo DPI{};
+    std::vector<uint8_t> Pixels;
+    std::unique_ptr<JobPool> Jobs;
+
+    PaintBenchView(const benchmark::State& state, IDrawingEngine* drawingEngine)
+    {
+        const auto zoom = ZoomLevel{ static_cast<int8_t>(state.range(0)) };
+        const auto rotation = static_cast<uint8_t>(state.range(1));
+        const auto threadCount = static_cast<size_t>(state.range(2));
+
+        gCurrentRotation = rotation;
+        // Ensure sprites appear regardless of rotation
+        reset_all_sprite_quadrant_placements();
+
+        const auto centre = CoordsXY{ (gMapSize / 2) * 32 + 16, (gMapSize / 2) * 32 + 16 };
+        const auto centrePos = translate_3d_to_2d_with_z(rotation, CoordsXYZ{ centre, tile_element_height(centre) });
+
+        Viewport.width = Width;
+        Viewport.height = Height;
+        Viewport.view_width = Width * zoom;
+        Viewport.view_height = Height * zoom;
+        Viewport.zoom = zoom;
+        Viewport.viewPos = { floor2(centrePos.x - Viewport.view_width / 2, 32),
+                             floor2(centrePos.y - Viewport.view_height / 2, 32) };
+
+        Pixels.resize(static_cast<size_t>(Width) * Height);
+        DPI.DrawingEngine = drawingEngine;
+        DPI.bits = Pixels.data();
+        DPI.x = Viewport.viewPos.x;
+        DPI.y = Viewport.viewPos.y;
+        DPI.width = Viewport.view_width;
+        DPI.height = Viewport.view_height;
+        DPI.pitch = 0;
+        DPI.zoom_level = zoom;
+
+        if (threadCount > 1)
+        {
+            Jobs = std::make_unique<JobPool>(threadCount - 1);
+        }
+    }
+
+    // Splits the view into the same 32 pixel wide columns as viewport_paint.
+    std::vector<paint_session*> CreateColumns()
+    {
+        std::vector<paint_session*> columns;
+        const auto rightBorder = DPI.x + DPI.width;
+        for (auto x = floor2(DPI.x, 32); x < rightBorder; x += 32)
+        {
+            paint_session* session = PaintSessionAlloc(&DPI, Viewport.flags);
+            columns.push_back(session);
+
+            rct_drawpixelinfo& dpi2 = session->DPI;
+            if (x >= dpi2.x)
+            {
+                auto leftPitch = x - dpi2.x;
+                dpi2.width -= leftPitch;
+                dpi2.bits += leftPitch / dpi2.zoom_level;
+                dpi2.pitch += leftPitch / dpi2.zoom_level;
+                dpi2.x = x;
+            }
+
+            auto paintRight = dpi2.x + dpi2.width;
+            if (paintRight >= x + 32)
+            {
+                auto rightPitch = paintRight - x - 32;
+                paintRight -= rightPitch;
+                dpi2.pitch += rightPitch / dpi2.zoom_level;
+            }
+            dpi2.width = paintRight - dpi2.x;
+        }
+        return columns;
+    }
+
+    template<typename TFn> void ForEachColumn(const std::vector<paint_session*>& columns, const TFn& fn)
+    {
+        for (auto* session : columns)
+        {
+            if (Jobs != nullptr)
+            {
+                Jobs->AddTask([session, &fn]() { fn(*session); });
+            }
+            else
+            {
+                fn(*session);
+            }
+        }
+        if (Jobs != nullptr)
+        {
+            Jobs->Join();
+        }
+    }
+
+    static void ReleaseColumns(std::vector<paint_session*>& columns)
+    {
+        for (auto* session : columns)
+        {
+            PaintSessionFree(session);
+        }
+        columns.clear();
+    }
+
+    // Counts every paint struct, attached paint struct and string struct of the view.
+    size_t CountPaintStructs()
+    {
+        auto columns = CreateColumns();
+        ForEachColumn(columns, [](paint_session& session) { PaintSessionGenerate(session); });
+        size_t count = 0;
+        for (auto* session : columns)
+        {
+            count += session->PaintEntryChain.GetCount();
+        }
+        ReleaseColumns(columns);
+        return count;
+    }
+};
+
+static void set_paint_counters(benchmark::State& state, size_t paintStructCount, std::chrono::nanoseconds elapsed)
+{
+    const auto totalStructs = static_cast<double>(paintStructCount) * static_cast<double>(state.iterations());
+    state.counters["paint_structs"] = static_cast<double>(paintStructCount);
+    state.counters["ns/struct"] = totalStructs > 0 ? static_cast<double>(elapsed.count()) / totalStructs : 0.0;
+    state.SetItemsProcessed(static_cast<int64_t>(totalStructs));
+}
+
+static void BM_paint_generate(benchmark::State& state, const std::string& parkFileName)
+{
+    if (!load_park(parkFileName))
+    {
+        state.SkipWithError("Failed to load park");
+        return;
+    }
+
+    PaintBenchView view(state, nullptr);
+    size_t paintStructCount = 0;
+    std::chrono::nanoseconds elapsed{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto columns = view.CreateColumns();
+        state.ResumeTiming();
+
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        view.ForEachColumn(columns, [](paint_session& session) { PaintSessionGenerate(session); });
+        elapsed += std::chrono::high_resolution_clock::now() - startTime;
+
+        state.PauseTiming();
+        paintStructCount = 0;
+        for (auto* session : columns)
+        {
+            paintStructCount += session->PaintEntryChain.GetCount();
+        }
+        PaintBenchView::ReleaseColumns(columns);
+        state.ResumeTiming();
+    }
+    set_paint_counters(state, paintStructCount, elapsed);
+}
+
+static void BM_paint_arrange(benchmark::State& state, const std::string& parkFileName)
+{
+    if (!load_park(parkFileName))
+    {
+        state.SkipWithError("Failed to load park");
+        return;
+    }
+
+    PaintBenchView view(state, nullptr);
+    const auto paintStructCount = view.CountPaintStructs();
+    std::chrono::nanoseconds elapsed{};
+    for (auto _ : state)
+    {
+        // Arranging links the structs in place, so every iteration needs freshly generated columns.
+        state.PauseTiming();
+        auto columns = view.CreateColumns();
+        view.ForEachColumn(columns, [](paint_session& session) { PaintSessionGenerate(session); });
+        state.ResumeTiming();
+
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        view.ForEachColumn(columns, [](paint_session& session) { PaintSessionArrange(session); });
+        elapsed += std::chrono::high_resolution_clock::now() - startTime;
+
+        state.PauseTiming();
+        PaintBenchView::ReleaseColumns(columns);
+        state.ResumeTiming();
+    }
+    set_paint_counters(state, paintStructCount, elapsed);
+}
+
+static void BM_paint_draw(benchmark::State& state, const std::string& parkFileName)
+{
+    if (!load_park(parkFileName))
+    {
+        state.SkipWithError("Failed to load park");
+        return;
+    }
+
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+    PaintBenchView view(state, &drawingEngine);
+    auto columns = view.CreateColumns();
+    view.ForEachColumn(columns, [](paint_session& session) {
+        PaintSessionGenerate(session);
+        PaintSessionArrange(session);
+    });
+    size_t paintStructCount = 0;
+    for (auto* session : columns)
+    {
+        paintStructCount += session->PaintEntryChain.GetCount();
+    }
+
+    std::chrono::nanoseconds elapsed{};
+    for (auto _ : state)
+    {
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        view.ForEachColumn(columns, [](paint_session& session) { PaintDrawStructs(session); });
+        elapsed += std::chrono::high_resolution_clock::now() - startTime;
+        benchmark::DoNotOptimize(view.Pixels.data());
+    }
+    PaintBenchView::ReleaseColumns(columns);
+    set_paint_counters(state, paintStructCount, elapsed);
+}
+
+static void BM_viewport_paint(benchmark::State& state, const std::string& parkFileName, DrawingEngine engine)
+{
+    if (!load_park(parkFileName))
+    {
+        state.SkipWithError("Failed to load park");
+        return;
+    }
+
+    std::unique_ptr<IDrawingEngine> drawingEngine;
+    if (engine == DrawingEngine::Software)
+    {
+        drawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
+    }
+    PaintBenchView view(state, drawingEngine.get());
+    const auto paintStructCount = view.CountPaintStructs();
+
+    // viewport_paint runs on its own job pool, so only the thread count is passed on.
+    const auto threadCount = static_cast<size_t>(state.range(2));
+    const auto multithreading = gConfigGeneral.multithreading;
+    gConfigGeneral.multithreading = threadCount > 1;
+    viewport_set_paint_thread_count(threadCount);
+    view.Jobs.reset();
+
+    rct_drawpixelinfo dpi{};
+    dpi.DrawingEngine = drawingEngine.get();
+    dpi.bits = view.Pixels.data();
+    dpi.width = view.Viewport.width;
+    dpi.height = view.Viewport.height;
+
+    std::chrono::nanoseconds elapsed{};
+    for (auto _ : state)
+    {
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        viewport_render(&dpi, &view.Viewport, { { 0, 0 }, { view.Viewport.width, view.Viewport.height } });
+        elapsed += std::chrono::high_resolution_clock::now() - startTime;
+        benchmark::DoNotOptimize(view.Pixels.data());
+    }
+
+    viewport_set_paint_thread_count(0);
+    gConfigGeneral.multithreading = multithreading;
+    set_paint_counters(state, paintStructCount, elapsed);
+}
+
+// Every zoom level and rotation, with thread counts doubling up to the hardware thread count.
+static void apply_paint_arguments(benchmark::internal::Benchmark* benchmark)
+{
+    std::vector<int64_t> threadCounts;
+    const auto hardwareThreads = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    for (int64_t threadCount = 1; threadCount < hardwareThreads; threadCount *= 2)
+    {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    benchmark->ArgNames({ "zoom", "rotation", "threads" });
+    for (ZoomLevel zoom{ 0 }; zoom <= ZoomLevel::max(); zoom++)
+    {
+        for (int64_t rotation = 0; rotation < 4; rotation++)
+        {
+            for (auto threadCount : threadCounts)
+            {
+                benchmark->Args({ static_cast<int8_t>(zoom), rotation, threadCount });
+            }
+        }
+    }
+    // Work also runs on the job pool threads, which the CPU time of the main thread would not include.
+    benchmark->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+static void register_paint_benchmarks(const std::string& parkFileName)
+{
+    apply_paint_arguments(benchmark::RegisterBenchmark((parkFileName + "/generate").c_str(), BM_paint_generate, parkFileName));
+    apply_paint_arguments(benchmark::RegisterBenchmark((parkFileName + "/arrange").c_str(), BM_paint_arrange, parkFileName));
+    apply_paint_arguments(benchmark::RegisterBenchmark((parkFileName + "/draw").c_str(), BM_paint_draw, parkFileName));
+
+    // The hardware accelerated engines need a window, so only the software engine can run here.
+    for (auto engine : { DrawingEngine::Software })
+    {
+        const auto engineName = format_string(DrawingEngineStringIds[EnumValue(engine)], nullptr);
+        apply_paint_arguments(benchmark::RegisterBenchmark(
+            (parkFileName + "/viewport_paint/" + engineName).c_str(), BM_viewport_paint, parkFileName, engine));
+    }
+}
+
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
     {
@@ -181,6 +514,17 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
     // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
     argv_for_benchmark.push_back(nullptr);
 
+    // The parks stay loaded in a single context while the benchmarks run.
+    core_init();
+    gOpenRCT2Headless = true;
+    _benchContext = OpenRCT2::CreateContext();
+    if (!_benchContext->Initialise())
+    {
+        _benchContext.reset();
+        return -1;
+    }
+    drawing_engine_init();
+
     // Extract file names from argument list. If there is no such file, consider it benchmark option.
     for (int i = 0; i < argc; i++)
     {
@@ -189,7 +533,10 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
             // Register benchmark for sv6 if valid
             std::vector<RecordedPaintSession> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
+            {
                 benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+                register_paint_benchmarks(argv[i]);
+            }
         }
         else
         {
@@ -202,6 +549,10 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
     if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
         return -1;
     ::benchmark::RunSpecifiedBenchmarks();
+
+    drawing_engine_dispose();
+    _loadedParkFileName.clear();
+    _benchContext.reset();
     return 0;
 }
 
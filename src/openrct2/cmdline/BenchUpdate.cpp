@@ -15,9 +15,12 @@
 #    include "../GameState.h"
 #    include "../OpenRCT2.h"
 #    include "../core/File.h"
+#    include "../entity/EntityList.h"
 #    include "../platform/Platform2.h"
 #    include "../platform/platform.h"
+#    include "../ride/Vehicle.h"
 
+#    include <algorithm>
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
@@ -88,6 +91,46 @@ static void BM_update(benchmark::State& state, const std::string& filename)
     }
 }
 
+// Looks up the collision candidates of every vehicle the same way the dodgems and boat hire checks do.
+static void BM_vehicle_neighbours(benchmark::State& state, const std::string& filename)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return;
+    }
+    if (!context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return;
+    }
+
+    size_t candidates = 0;
+    for (auto _ : state)
+    {
+        for (auto* vehicle : EntityList<Vehicle>())
+        {
+            if (vehicle->x == LOCATION_NULL)
+                continue;
+
+            for (int32_t offsetY = -COORDS_XY_STEP; offsetY <= COORDS_XY_STEP; offsetY += COORDS_XY_STEP)
+            {
+                for (int32_t offsetX = -COORDS_XY_STEP; offsetX <= COORDS_XY_STEP; offsetX += COORDS_XY_STEP)
+                {
+                    for (auto* otherVehicle : EntityTileList<Vehicle>({ vehicle->x + offsetX, vehicle->y + offsetY }))
+                    {
+                        benchmark::DoNotOptimize(otherVehicle);
+                        candidates++;
+                    }
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["Candidates"] = static_cast<double>(candidates) / std::max<int64_t>(state.iterations(), 1);
+}
+
 static int CmdlineForBenchSpriteSort(int argc, const char* const* argv)
 {
     // Add a baseline test on an empty park
@@ -107,6 +150,8 @@ static int CmdlineForBenchSpriteSort(int argc, const char* const* argv)
         {
             // Register benchmark for sv6 if valid
             benchmark::RegisterBenchmark(argv[i], BM_update, argv[i]);
+            auto neighboursName = std::string(argv[i]) + "/vehicle_neighbours";
+            benchmark::RegisterBenchmark(neighboursName.c_str(), BM_vehicle_neighbours, argv[i]);
         }
         else
         {
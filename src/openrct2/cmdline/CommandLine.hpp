@@ -11,6 +11,10 @@
 
 #include "../common.h"
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 /**
  * Class for enumerating and retrieving values for a set of command line arguments.
  */
@@ -119,7 +123,11 @@ namespace CommandLine
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
     extern const CommandLineCommand BenchUpdateCommands[];
+    extern const CommandLineCommand BenchReplayCommands[];
+    extern const CommandLineCommand BenchCoreCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand VerifyReplayCommands[];
+    extern const CommandLineCommand ConvertBatchCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -128,4 +136,14 @@ namespace CommandLine
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
+
+    /**
+     * Expands directories to the replay files they contain, other paths are kept as they are.
+     */
+    std::vector<std::string> GetReplayFiles(const std::vector<std::string>& paths);
+
+    /**
+     * Quotes an argument so it is passed on as is when running a command through the shell.
+     */
+    std::string QuoteArgument(std::string_view argument);
 } // namespace CommandLine
@@ -13,14 +13,54 @@
 #include "../ParkImporter.h"
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/FileSystem.hpp"
+#include "../core/Json.hpp"
 #include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../interface/Window.h"
 #include "../object/ObjectManager.h"
+#include "../object/ObjectRepository.h"
+#include "../object/PackedObjectRecorder.h"
 #include "../park/ParkFile.h"
+#include "../platform/platform.h"
 #include "../scenario/Scenario.h"
 #include "CommandLine.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _batchJobs = 0;
+static utf8* _batchOutputPath = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition ConvertBatchOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_batchJobs,       'j', "jobs",   "number of parks loaded at once (default: number of cores)" },
+    { CMDLINE_TYPE_STRING,  &_batchOutputPath, NAC, "output", "write the results as JSON to this file"                    },
+    OptionTableEnd
+};
+
+static exitcode_t HandleConvertBatch(CommandLineArgEnumerator* enumerator);
+
+const CommandLineCommand CommandLine::ConvertBatchCommands[]
+{
+    // Main commands
+    DefineCommand("", "<source_directory_or_manifest> <destination_directory>", ConvertBatchOptions, HandleConvertBatch),
+    CommandTableEnd
+};
+// clang-format on
 
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType);
 static const utf8* GetFileTypeFriendlyName(uint32_t fileType);
@@ -166,3 +206,292 @@ static const utf8* GetFileTypeFriendlyName(uint32_t fileType)
     assert(false);
     return nullptr;
 }
+
+struct ConvertBatchEntry
+{
+    std::string SourcePath;
+    std::string DestinationPath;
+};
+
+struct ConvertBatchPark
+{
+    size_t Index{};
+    // Declared before the importer which keeps a reference to it.
+    PackedObjectRecorder PackedObjects;
+    std::unique_ptr<IParkImporter> Importer;
+    ObjectList RequiredObjects;
+    std::string Error;
+
+    explicit ConvertBatchPark(IObjectRepository& objectRepository)
+        : PackedObjects(objectRepository)
+    {
+    }
+};
+
+struct ConvertBatchState
+{
+    // Held shared by the workers while loading and exclusively by the main thread while adding packed objects.
+    std::shared_mutex RepositoryMutex;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::deque<std::unique_ptr<ConvertBatchPark>> Loaded;
+    std::atomic<size_t> NextIndex = { 0 };
+    size_t MaxLoaded{};
+    bool Stopped{};
+};
+
+static std::string GetBatchDestinationPath(const std::string& destinationDirectory, const std::string& relativePath)
+{
+    auto directory = Path::GetDirectory(relativePath);
+    auto fileName = Path::GetFileNameWithoutExtension(relativePath) + ".park";
+    return directory.empty() ? Path::Combine(destinationDirectory, fileName)
+                             : Path::Combine(destinationDirectory, directory, fileName);
+}
+
+/**
+ * Lists the parks to convert, either every RCT1 and RCT2 park below a directory or the paths listed in a manifest file
+ * with one path per line. The destination keeps the path relative to the directory or manifest.
+ */
+static std::vector<ConvertBatchEntry> GetConvertBatchEntries(const std::string& source, const std::string& destinationDirectory)
+{
+    std::vector<ConvertBatchEntry> entries;
+    if (Path::DirectoryExists(source))
+    {
+        auto scanner = Path::ScanDirectory(Path::Combine(source, "*.sc4;*.sv4;*.sc6;*.sv6"), true);
+        while (scanner->Next())
+        {
+            auto destinationPath = GetBatchDestinationPath(destinationDirectory, scanner->GetPathRelative());
+            entries.push_back({ scanner->GetPath(), destinationPath });
+        }
+    }
+    else
+    {
+        auto manifestDirectory = Path::GetDirectory(source);
+        for (auto line : File::ReadAllLines(source))
+        {
+            line = String::Trim(line);
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            // Absolute paths are written straight into the destination directory.
+            if (u8path(line).is_absolute())
+            {
+                entries.push_back({ line, GetBatchDestinationPath(destinationDirectory, Path::GetFileName(line)) });
+            }
+            else
+            {
+                auto sourcePath = Path::GetAbsolute(Path::Combine(manifestDirectory, line));
+                entries.push_back({ sourcePath, GetBatchDestinationPath(destinationDirectory, line) });
+            }
+        }
+    }
+    return entries;
+}
+
+static std::unique_ptr<ConvertBatchPark> LoadConvertBatchPark(
+    ConvertBatchState& state, IObjectRepository& objectRepository, const ConvertBatchEntry& entry)
+{
+    auto park = std::make_unique<ConvertBatchPark>(objectRepository);
+    try
+    {
+        std::shared_lock<std::shared_mutex> lock(state.RepositoryMutex);
+        switch (get_file_extension_type(entry.SourcePath.c_str()))
+        {
+            case FILE_EXTENSION_SC4:
+            case FILE_EXTENSION_SV4:
+                park->Importer = ParkImporter::CreateS4();
+                break;
+            case FILE_EXTENSION_SC6:
+            case FILE_EXTENSION_SV6:
+                park->Importer = ParkImporter::CreateS6(park->PackedObjects);
+                break;
+            default:
+                throw std::runtime_error("Only conversion from .SC4, .SV4, .SC6 or .SV6 is supported.");
+        }
+        auto result = park->Importer->Load(entry.SourcePath.c_str());
+        park->RequiredObjects = std::move(result.RequiredObjects);
+    }
+    catch (const std::exception& e)
+    {
+        park->Importer = nullptr;
+        park->Error = e.what();
+    }
+    return park;
+}
+
+/**
+ * Loads parks on a worker thread. Loading only fills the importer, so it can run ahead of the main thread which owns
+ * the game state and imports and exports the parks one at a time.
+ */
+static void RunConvertBatchWorker(
+    ConvertBatchState& state, IObjectRepository& objectRepository, const std::vector<ConvertBatchEntry>& entries)
+{
+    while (true)
+    {
+        const auto index = state.NextIndex++;
+        if (index >= entries.size())
+            break;
+
+        auto park = LoadConvertBatchPark(state, objectRepository, entries[index]);
+        park->Index = index;
+        {
+            std::unique_lock<std::mutex> lock(state.Mutex);
+            state.Condition.wait(lock, [&state]() { return state.Stopped || state.Loaded.size() < state.MaxLoaded; });
+            if (state.Stopped)
+                break;
+            state.Loaded.push_back(std::move(park));
+        }
+        state.Condition.notify_all();
+    }
+}
+
+static void ConvertBatchParkToFile(
+    ConvertBatchState& state, IContext& context, ConvertBatchPark& park, const ConvertBatchEntry& entry)
+{
+    if (park.PackedObjects.HasPackedObjects())
+    {
+        std::unique_lock<std::shared_mutex> lock(state.RepositoryMutex);
+        park.PackedObjects.AddPackedObjects();
+    }
+
+    context.GetObjectManager().LoadObjects(park.RequiredObjects);
+    park.Importer->Import();
+
+    const auto sourceFileType = get_file_extension_type(entry.SourcePath.c_str());
+    if (sourceFileType == FILE_EXTENSION_SC4 || sourceFileType == FILE_EXTENSION_SC6)
+    {
+        // We are converting a scenario, so reset the park
+        scenario_begin();
+    }
+
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    window_close_by_class(WC_MAIN_WINDOW);
+
+    Path::CreateDirectory(Path::GetDirectory(entry.DestinationPath));
+    ParkFileExporter().Export(entry.DestinationPath);
+}
+
+static exitcode_t HandleConvertBatch(CommandLineArgEnumerator* enumerator)
+{
+    const utf8* rawSourcePath;
+    if (!enumerator->TryPopString(&rawSourcePath))
+    {
+        Console::Error::WriteLine("Expected a source directory or manifest.");
+        return EXITCODE_FAIL;
+    }
+
+    const utf8* rawDestinationPath;
+    if (!enumerator->TryPopString(&rawDestinationPath))
+    {
+        Console::Error::WriteLine("Expected a destination directory.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<ConvertBatchEntry> entries;
+    try
+    {
+        entries = GetConvertBatchEntries(Path::GetAbsolute(rawSourcePath), Path::GetAbsolute(rawDestinationPath));
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to read %s: %s", rawSourcePath, e.what());
+        return EXITCODE_FAIL;
+    }
+    if (entries.empty())
+    {
+        Console::Error::WriteLine("No parks to convert.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    size_t jobs = _batchJobs > 0 ? _batchJobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min(jobs, entries.size());
+    Console::WriteLine("Converting %zu parks using %zu workers.", entries.size(), jobs);
+
+    // Every loaded park holds a full copy of its file, so limit how far the workers can run ahead.
+    ConvertBatchState state;
+    state.MaxLoaded = jobs * 2;
+    auto& objectRepository = context->GetObjectRepository();
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < jobs; i++)
+    {
+        workers.emplace_back(RunConvertBatchWorker, std::ref(state), std::ref(objectRepository), std::cref(entries));
+    }
+
+    json_t jsonFailures = json_t::array();
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t converted = 0; converted < entries.size(); converted++)
+    {
+        std::unique_ptr<ConvertBatchPark> park;
+        {
+            std::unique_lock<std::mutex> lock(state.Mutex);
+            state.Condition.wait(lock, [&state]() { return !state.Loaded.empty(); });
+            park = std::move(state.Loaded.front());
+            state.Loaded.pop_front();
+        }
+        state.Condition.notify_all();
+
+        const auto& entry = entries[park->Index];
+        if (park->Importer != nullptr)
+        {
+            try
+            {
+                ConvertBatchParkToFile(state, *context, *park, entry);
+            }
+            catch (const std::exception& e)
+            {
+                park->Error = e.what();
+            }
+        }
+        if (!park->Error.empty())
+        {
+            Console::Error::WriteLine("%s: %s", entry.SourcePath.c_str(), park->Error.c_str());
+            json_t jsonFailure = {
+                { "source", entry.SourcePath },
+                { "error", park->Error },
+            };
+            jsonFailures.push_back(std::move(jsonFailure));
+        }
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        state.Stopped = true;
+    }
+    state.Condition.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    json_t jsonResult = {
+        { "parks", entries.size() },
+        { "converted", entries.size() - jsonFailures.size() },
+        { "failed", jsonFailures.size() },
+        { "workers", jobs },
+        { "timeMs", seconds * 1000.0 },
+        { "parksPerSecond", seconds > 0 ? entries.size() / seconds : 0 },
+        { "failures", jsonFailures },
+    };
+    if (_batchOutputPath != nullptr)
+    {
+        Json::WriteToFile(_batchOutputPath, jsonResult);
+    }
+    else
+    {
+        Console::WriteLine("%s", jsonResult.dump(4).c_str());
+    }
+    return jsonFailures.empty() ? EXITCODE_OK : EXITCODE_FAIL;
+}
@@ -42,9 +42,11 @@ int32_t gNetworkStart = NETWORK_MODE_NONE;
 std::string gNetworkStartHost;
 int32_t gNetworkStartPort = NETWORK_DEFAULT_PORT;
 std::string gNetworkStartAddress;
+int32_t gNetworkRelayPort = 0;
 
 static uint32_t _port = 0;
 static char* _address = nullptr;
+static uint32_t _relayPort = 0;
 #endif
 
 static bool _help = false;
@@ -60,6 +62,7 @@ static utf8* _openrct2DataPath = nullptr;
 static utf8* _rct1DataPath = nullptr;
 static utf8* _rct2DataPath = nullptr;
 static bool _silentBreakpad = false;
+static bool _startupProfile = false;
 
 // clang-format off
 static constexpr const CommandLineOptionDefinition StandardOptions[]
@@ -73,13 +76,15 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_SWITCH,  &_headless,         NAC, "headless",           "run " OPENRCT2_NAME " headless" IMPLIES_SILENT_BREAKPAD     },
 #ifndef DISABLE_NETWORK                                                    
     { CMDLINE_TYPE_INTEGER, &_port,             NAC, "port",               "port to use for hosting or joining a server"                },
-    { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting a server"                 },
+    { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting or relaying a server"     },
+    { CMDLINE_TYPE_INTEGER, &_relayPort,        NAC, "relay-port",         "port to relay a joined server to spectators on"             },
 #endif                                                                     
     { CMDLINE_TYPE_STRING,  &_password,         NAC, "password",           "password needed to join the server"                         },
     { CMDLINE_TYPE_STRING,  &_userDataPath,     NAC, "user-data-path",     "path to the user data directory (containing config.ini)"    },
     { CMDLINE_TYPE_STRING,  &_openrct2DataPath, NAC, "openrct2-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,     NAC, "rct1-data-path",     "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,     NAC, "rct2-data-path",     "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_SWITCH,  &_startupProfile,   NAC, "startup-profile",    "print the time taken by each startup phase"                 },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -143,7 +148,11 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
     DefineSubCommand("benchsimulate",   CommandLine::BenchUpdateCommands      ),
+    DefineSubCommand("benchreplay",     CommandLine::BenchReplayCommands      ),
+    DefineSubCommand("benchcore",       CommandLine::BenchCoreCommands        ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("verifyreplay",    CommandLine::VerifyReplayCommands     ),
+    DefineSubCommand("convertbatch",    CommandLine::ConvertBatchCommands     ),
     CommandTableEnd
 };
 
@@ -198,6 +207,7 @@ exitcode_t CommandLine::HandleCommandDefault()
     gOpenRCT2Headless = _headless;
     gOpenRCT2NoGraphics = _headless;
     gOpenRCT2SilentBreakpad = _silentBreakpad || _headless;
+    gOpenRCT2StartupProfile = _startupProfile;
 
     if (_userDataPath != nullptr)
     {
@@ -331,6 +341,8 @@ exitcode_t HandleCommandJoin(CommandLineArgEnumerator* enumerator)
     gNetworkStart = NETWORK_MODE_CLIENT;
     gNetworkStartPort = _port;
     gNetworkStartHost = hostname;
+    gNetworkStartAddress = String::ToStd(_address);
+    gNetworkRelayPort = _relayPort;
     return EXITCODE_CONTINUE;
 }
 
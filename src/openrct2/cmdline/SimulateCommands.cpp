@@ -12,64 +12,312 @@
 #include "../GameState.h"
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileSystem.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../entity/EntityRegistry.h"
 #include "../network/network.h"
+#include "../platform/Platform2.h"
 #include "../platform/platform.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace OpenRCT2;
 
+static int32_t _simulateJobs = 0;
+static utf8* _simulateOutputPath = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_simulateJobs,       'j', "jobs",   "number of parks simulated at once (default: number of cores)" },
+    { CMDLINE_TYPE_STRING,  &_simulateOutputPath, NAC, "output", "write the results as JSON to this file"                       },
+    OptionTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<sv6-file>... <ticks>", SimulateOptions, HandleSimulate),
+    CommandTableEnd
 };
+// clang-format on
 
-static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
+struct SimulateResult
 {
-    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
-    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    std::string Path;
+    uint32_t Ticks{};
+    double Seconds{};
+    std::vector<double> TickSeconds;
+    std::array<double, LogicTimePartNames.size()> PartSeconds{};
+    std::string Checksum;
 
-    if (argc < 2)
+    double GetTicksPerSecond() const
     {
-        Console::Error::WriteLine("Missing arguments <sv6-file> <ticks>.");
-        return EXITCODE_FAIL;
+        return Seconds > 0 ? Ticks / Seconds : 0;
     }
+};
 
-    core_init();
+static bool RunSimulation(IContext& context, const std::string& path, uint32_t ticks, SimulateResult& result)
+{
+    if (!context.LoadParkFromFile(path))
+    {
+        Console::Error::WriteLine("Unable to load park: %s", path.c_str());
+        return false;
+    }
 
-    const char* inputPath = argv[0];
-    uint32_t ticks = atol(argv[1]);
+    result.Path = path;
+    result.Ticks = ticks;
+    result.TickSeconds.reserve(ticks);
 
-    gOpenRCT2Headless = true;
+    // Every part reports the time since the start of the tick, parts not run in a tick keep a zero.
+    LogicTimings timings;
+    auto* gameState = context.GetGameState();
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        const auto index = timings.CurrentIdx;
+        for (size_t j = 0; j < LogicTimePartNames.size(); j++)
+        {
+            timings.TimingInfo[static_cast<LogicTimePart>(j)][index] = {};
+        }
 
+        const auto tickStart = std::chrono::high_resolution_clock::now();
+        gameState->UpdateLogic(&timings);
+        const auto tickSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - tickStart).count();
+        result.TickSeconds.push_back(tickSeconds);
+        result.Seconds += tickSeconds;
+
+        std::chrono::duration<double> previous{};
+        for (size_t j = 0; j < LogicTimePartNames.size(); j++)
+        {
+            auto elapsed = timings.TimingInfo[static_cast<LogicTimePart>(j)][index];
+            if (elapsed.count() > 0)
+            {
+                result.PartSeconds[j] += (elapsed - previous).count();
+                previous = elapsed;
+            }
+        }
+    }
+    result.Checksum = GetAllEntitiesChecksum().ToString();
+    return true;
+}
+
+static double GetPercentile(const std::vector<double>& sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+    auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+static json_t ResultToJson(const SimulateResult& result)
+{
+    auto sorted = result.TickSeconds;
+    std::sort(sorted.begin(), sorted.end());
+    json_t jsonTicks = {
+        { "p50", GetPercentile(sorted, 50) * 1000.0 },
+        { "p90", GetPercentile(sorted, 90) * 1000.0 },
+        { "p99", GetPercentile(sorted, 99) * 1000.0 },
+        { "max", GetPercentile(sorted, 100) * 1000.0 },
+    };
+    json_t jsonParts = json_t::object();
+    for (size_t i = 0; i < LogicTimePartNames.size(); i++)
+    {
+        jsonParts[LogicTimePartNames[i]] = result.PartSeconds[i] * 1000.0;
+    }
+    return {
+        { "name", Path::GetFileNameWithoutExtension(result.Path) },
+        { "path", result.Path },
+        { "ticks", result.Ticks },
+        { "timeMs", result.Seconds * 1000.0 },
+        { "ticksPerSecond", result.GetTicksPerSecond() },
+        { "tickMs", jsonTicks },
+        { "partsMs", jsonParts },
+        { "checksum", result.Checksum },
+    };
+}
+
+static void PrintResult(const json_t& jsonPark)
+{
+    const auto& jsonTicks = jsonPark["tickMs"];
+    Console::WriteLine(
+        "%-32s %8u ticks in %8.1f ms, %10.1f ticks/s, p50 %.3f ms, p99 %.3f ms, checksum %s",
+        Json::GetString(jsonPark["name"]).c_str(), Json::GetNumber<uint32_t>(jsonPark["ticks"]),
+        Json::GetNumber<double>(jsonPark["timeMs"]), Json::GetNumber<double>(jsonPark["ticksPerSecond"]),
+        Json::GetNumber<double>(jsonTicks["p50"]), Json::GetNumber<double>(jsonTicks["p99"]),
+        Json::GetString(jsonPark["checksum"]).c_str());
+}
+
+std::string CommandLine::QuoteArgument(std::string_view argument)
+{
+#ifdef _WIN32
+    return "\"" + std::string(argument) + "\"";
+#else
+    std::string result = "'";
+    for (auto c : argument)
+    {
+        if (c == '\'')
+            result += "'\\''";
+        else
+            result += c;
+    }
+    return result + "'";
+#endif
+}
+
+/**
+ * The game state is global, so parks can only be simulated at the same time in separate processes.
+ * Every park is simulated by running this command for it alone, the results are read back from a temporary file.
+ */
+static bool RunSimulationsInProcesses(const std::vector<std::string>& paths, uint32_t ticks, size_t jobs, json_t& jsonParks)
+{
+    const auto executable = CommandLine::QuoteArgument(Platform::GetCurrentExecutablePath());
+    const auto tempDirectory = fs::temp_directory_path().u8string();
+    const auto runId = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::vector<std::string> outputPaths(paths.size());
+    std::vector<int32_t> exitCodes(paths.size(), -1);
+    std::atomic<size_t> nextPark{};
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < jobs; i++)
+    {
+        workers.emplace_back([&]() {
+            for (auto parkIndex = nextPark++; parkIndex < paths.size(); parkIndex = nextPark++)
+            {
+                outputPaths[parkIndex] = Path::Combine(
+                    tempDirectory, String::StdFormat("openrct2-simulate-%lld-%zu.json", static_cast<long long>(runId), parkIndex));
+                // The results are read from the file, nothing reads the output of the process.
+                auto command = String::StdFormat(
+                    "%s simulate %s %u --jobs=1 --output=%s > /dev/null", executable.c_str(),
+                    CommandLine::QuoteArgument(paths[parkIndex]).c_str(), ticks,
+                    CommandLine::QuoteArgument(outputPaths[parkIndex]).c_str());
+                exitCodes[parkIndex] = Platform::Execute(command);
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (!File::Exists(outputPaths[i]))
+        {
+            Console::Error::WriteLine("Simulating %s failed.", paths[i].c_str());
+            success = false;
+            continue;
+        }
+        if (exitCodes[i] != 0)
+        {
+            Console::Error::WriteLine("Simulating %s failed.", paths[i].c_str());
+            File::Delete(outputPaths[i]);
+            success = false;
+            continue;
+        }
+        auto jsonResult = Json::ReadFromFile(outputPaths[i]);
+        for (auto& jsonPark : jsonResult["parks"])
+        {
+            PrintResult(jsonPark);
+            jsonParks.push_back(std::move(jsonPark));
+        }
+        File::Delete(outputPaths[i]);
+    }
+    return success;
+}
+
+static bool RunSimulationsInContext(const std::vector<std::string>& paths, uint32_t ticks, json_t& jsonParks)
+{
 #ifndef DISABLE_NETWORK
     gNetworkStart = NETWORK_MODE_SERVER;
 #endif
 
     std::unique_ptr<IContext> context(CreateContext());
-    if (context->Initialise())
+    if (!context->Initialise())
     {
-        if (!context->LoadParkFromFile(inputPath))
-        {
-            return EXITCODE_FAIL;
-        }
+        Console::Error::WriteLine("Context initialization failed.");
+        return false;
+    }
 
+    for (const auto& path : paths)
+    {
         Console::WriteLine("Running %d ticks...", ticks);
-        for (uint32_t i = 0; i < ticks; i++)
+        SimulateResult result;
+        if (!RunSimulation(*context, path, ticks, result))
         {
-            context->GetGameState()->UpdateLogic();
+            return false;
         }
-        Console::WriteLine("Completed: %s", GetAllEntitiesChecksum().ToString().c_str());
+        Console::WriteLine("Completed: %s", result.Checksum.c_str());
+        auto jsonPark = ResultToJson(result);
+        PrintResult(jsonPark);
+        jsonParks.push_back(std::move(jsonPark));
     }
-    else
+    return true;
+}
+
+static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    // Options have already been parsed, they all follow the parks and the tick count.
+    std::vector<std::string> paths;
+    for (int32_t i = 0; i < argc && argv[i][0] != '-'; i++)
     {
-        Console::Error::WriteLine("Context initialization failed.");
+        paths.emplace_back(argv[i]);
+    }
+    if (paths.size() < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <sv6-file>... <ticks>.");
         return EXITCODE_FAIL;
     }
+    uint32_t ticks = atol(paths.back().c_str());
+    paths.pop_back();
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    size_t jobs = _simulateJobs > 0 ? _simulateJobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min(jobs, paths.size());
+
+    json_t jsonParks = json_t::array();
+    bool success;
+#ifdef _WIN32
+    // Platform::Execute is not implemented for Windows.
+    jobs = 1;
+#endif
+    if (jobs > 1)
+    {
+        Console::WriteLine("Simulating %zu parks using %zu processes.", paths.size(), jobs);
+        success = RunSimulationsInProcesses(paths, ticks, jobs, jsonParks);
+    }
+    else
+    {
+        success = RunSimulationsInContext(paths, ticks, jsonParks);
+    }
 
-    return EXITCODE_OK;
+    json_t jsonResults = { { "parks", jsonParks } };
+    if (_simulateOutputPath != nullptr)
+    {
+        Json::WriteToFile(_simulateOutputPath, jsonResults);
+    }
+    else if (paths.size() > 1)
+    {
+        Console::WriteLine("%s", jsonResults.dump(4).c_str());
+    }
+    return success ? EXITCODE_OK : EXITCODE_FAIL;
 }
@@ -0,0 +1,244 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileSystem.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _verifyReplayJobs = 0;
+static utf8* _verifyReplayOutputPath = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition VerifyReplayOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_verifyReplayJobs,       'j', "jobs",   "number of replays verified at once (default: number of cores)" },
+    { CMDLINE_TYPE_STRING,  &_verifyReplayOutputPath, NAC, "output", "write the results as JSON to this file"                         },
+    OptionTableEnd
+};
+
+static exitcode_t HandleVerifyReplay(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::VerifyReplayCommands[]
+{
+    // Main commands
+    DefineCommand("", "<replay_file_or_directory>...", VerifyReplayOptions, HandleVerifyReplay),
+    CommandTableEnd
+};
+// clang-format on
+
+/**
+ * Plays the replay back as fast as the logic runs, nothing is drawn and no frame limit applies.
+ */
+static json_t VerifyReplay(IContext& context, const std::string& path)
+{
+    json_t jsonReplay = {
+        { "name", Path::GetFileNameWithoutExtension(path) },
+        { "path", path },
+        { "ticks", 0 },
+        { "passed", false },
+        { "divergedAtTick", nullptr },
+    };
+
+    auto* replayManager = context.GetReplayManager();
+    if (!replayManager->StartPlayback(path))
+    {
+        Console::Error::WriteLine("Unable to start replay: %s", path.c_str());
+        return jsonReplay;
+    }
+
+    auto* gameState = context.GetGameState();
+    uint32_t ticks = 0;
+    while (replayManager->IsReplaying())
+    {
+        gameState->UpdateLogic();
+        ticks++;
+
+        if (replayManager->IsPlaybackStateMismatching())
+        {
+            // The checksum is compared at the start of the last tick, before its logic ran.
+            jsonReplay["ticks"] = ticks;
+            jsonReplay["divergedAtTick"] = ticks - 1;
+            replayManager->StopPlayback();
+            return jsonReplay;
+        }
+    }
+    jsonReplay["ticks"] = ticks;
+    jsonReplay["passed"] = true;
+    return jsonReplay;
+}
+
+static void PrintResult(const json_t& jsonReplay)
+{
+    const auto name = Json::GetString(jsonReplay["name"]);
+    const auto ticks = Json::GetNumber<uint32_t>(jsonReplay["ticks"]);
+    if (Json::GetBoolean(jsonReplay["passed"]))
+    {
+        Console::WriteLine("%-32s %8u ticks, passed", name.c_str(), ticks);
+    }
+    else if (jsonReplay["divergedAtTick"].is_number())
+    {
+        Console::WriteLine(
+            "%-32s %8u ticks, FAILED: diverged at tick %u", name.c_str(), ticks,
+            Json::GetNumber<uint32_t>(jsonReplay["divergedAtTick"]));
+    }
+    else
+    {
+        Console::WriteLine("%-32s FAILED: unable to play back", name.c_str());
+    }
+}
+
+/**
+ * The game state is global, so replays can only be played back at the same time in separate processes.
+ * Every replay is verified by running this command for it alone, the results are read back from a temporary file.
+ */
+static void VerifyReplaysInProcesses(const std::vector<std::string>& paths, size_t jobs, json_t& jsonReplays)
+{
+    const auto executable = CommandLine::QuoteArgument(Platform::GetCurrentExecutablePath());
+    const auto tempDirectory = fs::temp_directory_path().u8string();
+    const auto runId = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::vector<std::string> outputPaths(paths.size());
+    std::atomic<size_t> nextReplay{};
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < jobs; i++)
+    {
+        workers.emplace_back([&]() {
+            for (auto replayIndex = nextReplay++; replayIndex < paths.size(); replayIndex = nextReplay++)
+            {
+                outputPaths[replayIndex] = Path::Combine(
+                    tempDirectory,
+                    String::StdFormat("openrct2-verifyreplay-%lld-%zu.json", static_cast<long long>(runId), replayIndex));
+                // A failed replay also exits with an error, only the results file tells whether it was played back.
+                auto command = String::StdFormat(
+                    "%s verifyreplay %s --jobs=1 --output=%s > /dev/null", executable.c_str(),
+                    CommandLine::QuoteArgument(paths[replayIndex]).c_str(),
+                    CommandLine::QuoteArgument(outputPaths[replayIndex]).c_str());
+                Platform::Execute(command);
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (!File::Exists(outputPaths[i]))
+        {
+            json_t jsonReplay = {
+                { "name", Path::GetFileNameWithoutExtension(paths[i]) },
+                { "path", paths[i] },
+                { "ticks", 0 },
+                { "passed", false },
+                { "divergedAtTick", nullptr },
+            };
+            PrintResult(jsonReplay);
+            jsonReplays.push_back(std::move(jsonReplay));
+            continue;
+        }
+        auto jsonResult = Json::ReadFromFile(outputPaths[i]);
+        for (auto& jsonReplay : jsonResult["replays"])
+        {
+            PrintResult(jsonReplay);
+            jsonReplays.push_back(std::move(jsonReplay));
+        }
+        File::Delete(outputPaths[i]);
+    }
+}
+
+static bool VerifyReplaysInContext(const std::vector<std::string>& paths, json_t& jsonReplays)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return false;
+    }
+
+    for (const auto& path : paths)
+    {
+        auto jsonReplay = VerifyReplay(*context, path);
+        PrintResult(jsonReplay);
+        jsonReplays.push_back(std::move(jsonReplay));
+    }
+    return true;
+}
+
+static exitcode_t HandleVerifyReplay(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    // Options have already been parsed, they all follow the paths.
+    std::vector<std::string> paths;
+    for (int32_t i = 0; i < argc && argv[i][0] != '-'; i++)
+    {
+        paths.emplace_back(argv[i]);
+    }
+    auto replayFiles = CommandLine::GetReplayFiles(paths);
+    if (replayFiles.empty())
+    {
+        Console::Error::WriteLine("Missing arguments <replay_file_or_directory>...");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    size_t jobs = _verifyReplayJobs > 0 ? _verifyReplayJobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min(jobs, replayFiles.size());
+#ifdef _WIN32
+    // Platform::Execute is not implemented for Windows.
+    jobs = 1;
+#endif
+
+    json_t jsonReplays = json_t::array();
+    if (jobs > 1)
+    {
+        Console::WriteLine("Verifying %zu replays using %zu processes.", replayFiles.size(), jobs);
+        VerifyReplaysInProcesses(replayFiles, jobs, jsonReplays);
+    }
+    else if (!VerifyReplaysInContext(replayFiles, jsonReplays))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    json_t jsonResults = { { "replays", jsonReplays } };
+    if (_verifyReplayOutputPath != nullptr)
+    {
+        Json::WriteToFile(_verifyReplayOutputPath, jsonResults);
+    }
+
+    size_t failed = std::count_if(jsonReplays.begin(), jsonReplays.end(), [](const json_t& jsonReplay) {
+        return !Json::GetBoolean(jsonReplay["passed"]);
+    });
+    Console::WriteLine("%zu of %zu replays passed.", jsonReplays.size() - failed, jsonReplays.size());
+    return failed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
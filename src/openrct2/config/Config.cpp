@@ -149,6 +149,7 @@ namespace Config
             model->always_show_gridlines = reader->GetBoolean("always_show_gridlines", false);
             model->autosave_frequency = reader->GetInt32("autosave", AUTOSAVE_EVERY_5MINUTES);
             model->autosave_amount = reader->GetInt32("autosave_amount", DEFAULT_NUM_AUTOSAVES_TO_KEEP);
+            model->autosave_keyframe_interval = reader->GetInt32("autosave_keyframe_interval", 1);
             model->confirmation_prompt = reader->GetBoolean("confirmation_prompt", false);
             model->currency_format = reader->GetEnum<CurrencyType>(
                 "currency_format", Platform::GetLocaleCurrency(), Enum_Currency);
@@ -206,7 +207,14 @@ namespace Config
             model->scale_quality = reader->GetEnum<ScaleQuality>(
                 "scale_quality", ScaleQuality::SmoothNearestNeighbour, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
+            model->frame_pipelining = reader->GetBoolean("frame_pipelining", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->parallel_tile_updates = reader->GetBoolean("parallel_tile_updates", false);
+            model->parallel_peep_updates = reader->GetBoolean("parallel_peep_updates", false);
+            model->game_thread_cores = reader->GetString("game_thread_cores", "");
+            model->paint_thread_cores = reader->GetString("paint_thread_cores", "");
+            model->high_priority_game_thread = reader->GetBoolean("high_priority_game_thread", false);
+            model->large_pages = reader->GetBoolean("large_pages", false);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -221,12 +229,15 @@ namespace Config
             model->zoom_to_cursor = reader->GetBoolean("zoom_to_cursor", true);
             model->render_weather_effects = reader->GetBoolean("render_weather_effects", true);
             model->render_weather_gloom = reader->GetBoolean("render_weather_gloom", true);
+            model->zoomed_out_detail_culling = reader->GetBoolean("zoomed_out_detail_culling", false);
             model->show_guest_purchases = reader->GetBoolean("show_guest_purchases", false);
             model->show_real_names_of_guests = reader->GetBoolean("show_real_names_of_guests", true);
             model->allow_early_completion = reader->GetBoolean("allow_early_completion", false);
             model->transparent_screenshot = reader->GetBoolean("transparent_screenshot", true);
             model->transparent_water = reader->GetBoolean("transparent_water", true);
             model->last_version_check_time = reader->GetInt64("last_version_check_time", 0);
+            model->memory_stats_log_interval = reader->GetInt32("memory_stats_log_interval", 0);
+            model->enable_object_hot_reloading = reader->GetBoolean("enable_object_hot_reloading", false);
         }
     }
 
@@ -237,6 +248,7 @@ namespace Config
         writer->WriteBoolean("always_show_gridlines", model->always_show_gridlines);
         writer->WriteInt32("autosave", model->autosave_frequency);
         writer->WriteInt32("autosave_amount", model->autosave_amount);
+        writer->WriteInt32("autosave_keyframe_interval", model->autosave_keyframe_interval);
         writer->WriteBoolean("confirmation_prompt", model->confirmation_prompt);
         writer->WriteEnum<CurrencyType>("currency_format", model->currency_format, Enum_Currency);
         writer->WriteInt32("custom_currency_rate", model->custom_currency_rate);
@@ -283,7 +295,14 @@ namespace Config
         writer->WriteFloat("window_scale", model->window_scale);
         writer->WriteEnum<ScaleQuality>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
+        writer->WriteBoolean("frame_pipelining", model->frame_pipelining);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteBoolean("parallel_tile_updates", model->parallel_tile_updates);
+        writer->WriteBoolean("parallel_peep_updates", model->parallel_peep_updates);
+        writer->WriteString("game_thread_cores", model->game_thread_cores);
+        writer->WriteString("paint_thread_cores", model->paint_thread_cores);
+        writer->WriteBoolean("high_priority_game_thread", model->high_priority_game_thread);
+        writer->WriteBoolean("large_pages", model->large_pages);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -298,6 +317,7 @@ namespace Config
         writer->WriteBoolean("zoom_to_cursor", model->zoom_to_cursor);
         writer->WriteBoolean("render_weather_effects", model->render_weather_effects);
         writer->WriteBoolean("render_weather_gloom", model->render_weather_gloom);
+        writer->WriteBoolean("zoomed_out_detail_culling", model->zoomed_out_detail_culling);
         writer->WriteBoolean("show_guest_purchases", model->show_guest_purchases);
         writer->WriteBoolean("show_real_names_of_guests", model->show_real_names_of_guests);
         writer->WriteBoolean("allow_early_completion", model->allow_early_completion);
@@ -305,6 +325,8 @@ namespace Config
         writer->WriteBoolean("transparent_screenshot", model->transparent_screenshot);
         writer->WriteBoolean("transparent_water", model->transparent_water);
         writer->WriteInt64("last_version_check_time", model->last_version_check_time);
+        writer->WriteInt32("memory_stats_log_interval", model->memory_stats_log_interval);
+        writer->WriteBoolean("enable_object_hot_reloading", model->enable_object_hot_reloading);
     }
 
     static void ReadInterface(IIniReader* reader)
@@ -548,6 +570,7 @@ namespace Config
             auto model = &gConfigPlugin;
             model->enable_hot_reloading = reader->GetBoolean("enable_hot_reloading", false);
             model->allowed_hosts = reader->GetString("allowed_hosts", "");
+            model->interval_time_budget = reader->GetInt32("interval_time_budget", 0);
         }
     }
 
@@ -557,6 +580,7 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->enable_hot_reloading);
         writer->WriteString("allowed_hosts", model->allowed_hosts);
+        writer->WriteInt32("interval_time_budget", model->interval_time_budget);
     }
 
     static bool SetDefaults()
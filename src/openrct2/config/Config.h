@@ -40,8 +40,17 @@ struct GeneralConfiguration
     ScaleQuality scale_quality;
     bool uncap_fps;
     bool use_vsync;
+    bool frame_pipelining;
     bool show_fps;
     bool multithreading;
+    bool parallel_tile_updates;
+    bool parallel_peep_updates;
+    // Lists of cores such as "0-3,6", empty for all cores.
+    std::string game_thread_cores;
+    std::string paint_thread_cores;
+    bool high_priority_game_thread;
+    // Back the map and entities with large pages where the system has them.
+    bool large_pages;
     bool minimize_fullscreen_focus_loss;
     bool disable_screensaver;
 
@@ -55,6 +64,7 @@ struct GeneralConfiguration
     bool upper_case_banners;
     bool render_weather_effects;
     bool render_weather_gloom;
+    bool zoomed_out_detail_culling;
     bool disable_lightning_effect;
     bool show_guest_purchases;
     bool transparent_screenshot;
@@ -86,6 +96,7 @@ struct GeneralConfiguration
     bool debugging_tools;
     int32_t autosave_frequency;
     int32_t autosave_amount;
+    int32_t autosave_keyframe_interval;
     bool auto_staff_placement;
     bool handymen_mow_default;
     bool auto_open_shops;
@@ -108,6 +119,12 @@ struct GeneralConfiguration
     utf8* last_run_version;
     bool use_native_browse_dialog;
     int64_t last_version_check_time;
+
+    // Diagnostics
+    int32_t memory_stats_log_interval;
+
+    // Content authoring
+    bool enable_object_hot_reloading;
 };
 
 struct InterfaceConfiguration
@@ -208,6 +225,7 @@ struct PluginConfiguration
 {
     bool enable_hot_reloading;
     std::string allowed_hosts;
+    int32_t interval_time_budget;
 };
 
 enum class Sort : int32_t
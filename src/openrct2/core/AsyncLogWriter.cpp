@@ -0,0 +1,288 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "AsyncLogWriter.h"
+
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
+#include "String.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+struct AsyncLogTarget
+{
+    std::ofstream File;
+    FILE* Stream{};
+    std::atomic<uint32_t> DroppedLines = { 0 };
+    bool Dirty{};
+
+    void Write(std::string_view text)
+    {
+        if (Stream != nullptr)
+        {
+            std::fwrite(text.data(), 1, text.size(), Stream);
+        }
+        else
+        {
+            File.write(text.data(), text.size());
+        }
+        Dirty = true;
+    }
+
+    void WriteDroppedLines()
+    {
+        auto dropped = DroppedLines.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0)
+        {
+            Write(String::StdFormat("(%u log lines dropped)" PLATFORM_NEWLINE, dropped));
+        }
+    }
+
+    void Flush()
+    {
+        if (Stream != nullptr)
+        {
+            std::fflush(Stream);
+        }
+        else
+        {
+            File.flush();
+        }
+        Dirty = false;
+    }
+};
+
+AsyncLogWriter::AsyncLogWriter(size_t maxQueuedBytes, std::chrono::milliseconds flushInterval)
+    : _maxQueuedBytes(maxQueuedBytes)
+    , _flushInterval(flushInterval)
+{
+    _thread = std::thread([this]() { Run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    auto* entry = new Entry();
+    entry->Kind = EntryKind::Stop;
+    Push(entry);
+    _thread.join();
+}
+
+AsyncLogWriter& AsyncLogWriter::GetShared()
+{
+    static AsyncLogWriter writer;
+    return writer;
+}
+
+AsyncLogTarget* AsyncLogWriter::OpenFile(const std::string& path, bool binary)
+{
+    auto mode = std::ios::out | std::ios::app;
+    if (binary)
+        mode |= std::ios::binary;
+
+    auto target = std::make_unique<AsyncLogTarget>();
+#if defined(_WIN32) && !defined(__MINGW32__)
+    auto pathW = String::ToWideChar(path.c_str());
+    target->File.open(pathW.c_str(), mode);
+#else
+    target->File.open(path, mode);
+#endif
+    if (!target->File.is_open())
+        return nullptr;
+    return target.release();
+}
+
+AsyncLogTarget* AsyncLogWriter::OpenStream(FILE* stream)
+{
+    auto* target = new AsyncLogTarget();
+    target->Stream = stream;
+    return target;
+}
+
+bool AsyncLogWriter::Write(AsyncLogTarget* target, std::string_view text)
+{
+    // Reserve the memory first so concurrent writers can not go over the limit together.
+    if (_queuedBytes.fetch_add(text.size(), std::memory_order_relaxed) + text.size() > _maxQueuedBytes)
+    {
+        _queuedBytes.fetch_sub(text.size(), std::memory_order_relaxed);
+        target->DroppedLines.fetch_add(1, std::memory_order_relaxed);
+        _droppedLines.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto* entry = new Entry();
+    entry->Target = target;
+    entry->Kind = EntryKind::Line;
+    entry->Text = text;
+    Push(entry);
+    return true;
+}
+
+void AsyncLogWriter::Close(AsyncLogTarget* target)
+{
+    if (target == nullptr)
+        return;
+
+    auto* entry = new Entry();
+    entry->Target = target;
+    entry->Kind = EntryKind::Close;
+    Push(entry);
+}
+
+void AsyncLogWriter::Flush()
+{
+    auto* entry = new Entry();
+    entry->Kind = EntryKind::Flush;
+    PushAndWait(entry);
+}
+
+AsyncLogWriter::Stats AsyncLogWriter::GetStats() const
+{
+    Stats stats;
+    stats.WrittenLines = _writtenLines.load(std::memory_order_relaxed);
+    stats.DroppedLines = _droppedLines.load(std::memory_order_relaxed);
+    stats.Batches = _batches.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AsyncLogWriter::Push(Entry* entry)
+{
+    auto* head = _head.load(std::memory_order_relaxed);
+    do
+    {
+        entry->Next = head;
+    } while (!_head.compare_exchange_weak(head, entry, std::memory_order_release, std::memory_order_relaxed));
+
+    // Only the entry that makes the queue non empty has to wake the writer, the writer checks for entries while
+    // holding the mutex so taking it here can not miss the writer going to sleep.
+    if (head == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _wake.notify_one();
+    }
+}
+
+void AsyncLogWriter::PushAndWait(Entry* entry)
+{
+    std::atomic_bool done = { false };
+    entry->Done = &done;
+    Push(entry);
+
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    _done.wait(lock, [&done]() { return done.load(); });
+}
+
+AsyncLogWriter::Entry* AsyncLogWriter::TakeBatch()
+{
+    // The list is newest first, reverse it to write the entries in the order they were queued.
+    auto* entry = _head.exchange(nullptr, std::memory_order_acquire);
+    Entry* batch = nullptr;
+    while (entry != nullptr)
+    {
+        auto* next = entry->Next;
+        entry->Next = batch;
+        batch = entry;
+        entry = next;
+    }
+    return batch;
+}
+
+void AsyncLogWriter::FlushTargets(bool streamsOnly)
+{
+    auto flushTarget = [streamsOnly](AsyncLogTarget* target) {
+        if (streamsOnly && target->Stream == nullptr)
+            return false;
+        target->Flush();
+        return true;
+    };
+    _dirtyTargets.erase(std::remove_if(_dirtyTargets.begin(), _dirtyTargets.end(), flushTarget), _dirtyTargets.end());
+}
+
+bool AsyncLogWriter::WriteBatch(Entry* batch)
+{
+    bool stop = false;
+    while (batch != nullptr)
+    {
+        std::unique_ptr<Entry> entry(batch);
+        batch = entry->Next;
+
+        auto* target = entry->Target;
+        switch (entry->Kind)
+        {
+            case EntryKind::Line:
+            {
+                if (!target->Dirty)
+                {
+                    _dirtyTargets.push_back(target);
+                }
+                target->WriteDroppedLines();
+                target->Write(entry->Text);
+                _queuedBytes.fetch_sub(entry->Text.size(), std::memory_order_relaxed);
+                _writtenLines.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            case EntryKind::Close:
+                target->WriteDroppedLines();
+                _dirtyTargets.erase(std::remove(_dirtyTargets.begin(), _dirtyTargets.end(), target), _dirtyTargets.end());
+                delete target;
+                break;
+            case EntryKind::Flush:
+                FlushTargets(false);
+                _lastFlush = std::chrono::steady_clock::now();
+                break;
+            case EntryKind::Stop:
+                FlushTargets(false);
+                stop = true;
+                break;
+        }
+
+        if (entry->Done != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            entry->Done->store(true);
+            _done.notify_all();
+        }
+    }
+    return stop;
+}
+
+void AsyncLogWriter::Run()
+{
+    Platform::SetCurrentThreadName("Log writer");
+    _lastFlush = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    while (true)
+    {
+        _wake.wait_for(lock, _flushInterval, [this]() { return _head.load(std::memory_order_acquire) != nullptr; });
+        lock.unlock();
+
+        bool stop = false;
+        auto* batch = TakeBatch();
+        if (batch != nullptr)
+        {
+            stop = WriteBatch(batch);
+            _batches.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Someone may be watching the console, files only have to reach the disk eventually.
+        const auto now = std::chrono::steady_clock::now();
+        FlushTargets(now - _lastFlush < _flushInterval);
+        if (now - _lastFlush >= _flushInterval)
+        {
+            _lastFlush = now;
+        }
+
+        lock.lock();
+        if (stop)
+            break;
+    }
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct AsyncLogTarget;
+
+/**
+ * Writes log lines to files and console streams on a thread of its own, so a slow disk does not stall the threads
+ * logging. Any thread can write, lines are queued in a lock free list and written in batches. The memory of the queued
+ * lines is bounded, lines written while the queue is full are dropped and the number dropped is noted in the log once
+ * there is room again. Targets are flushed periodically rather than after every line.
+ */
+class AsyncLogWriter
+{
+public:
+    static constexpr size_t DefaultMaxQueuedBytes = 4 * 1024 * 1024;
+    static constexpr std::chrono::milliseconds DefaultFlushInterval{ 1000 };
+
+    struct Stats
+    {
+        uint64_t WrittenLines{};
+        uint64_t DroppedLines{};
+        uint64_t Batches{};
+    };
+
+private:
+    enum class EntryKind : uint8_t
+    {
+        Line,
+        Flush,
+        Close,
+        Stop,
+    };
+
+    struct Entry
+    {
+        Entry* Next{};
+        AsyncLogTarget* Target{};
+        EntryKind Kind{};
+        std::string Text;
+        std::atomic_bool* Done{};
+    };
+
+    const size_t _maxQueuedBytes;
+    const std::chrono::milliseconds _flushInterval;
+    // Most recently queued entry first, the writer takes the whole list at once.
+    std::atomic<Entry*> _head = { nullptr };
+    std::atomic<size_t> _queuedBytes = { 0 };
+    std::atomic<uint64_t> _writtenLines = { 0 };
+    std::atomic<uint64_t> _droppedLines = { 0 };
+    std::atomic<uint64_t> _batches = { 0 };
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    // Only used by the writer thread.
+    std::vector<AsyncLogTarget*> _dirtyTargets;
+    std::chrono::steady_clock::time_point _lastFlush;
+    // Started last so everything the thread uses is constructed before it.
+    std::thread _thread;
+
+public:
+    AsyncLogWriter(
+        size_t maxQueuedBytes = DefaultMaxQueuedBytes, std::chrono::milliseconds flushInterval = DefaultFlushInterval);
+    ~AsyncLogWriter();
+
+    /**
+     * The writer shared by the logs of the game.
+     */
+    static AsyncLogWriter& GetShared();
+
+    /**
+     * Opens a file to append lines to.
+     * @return nullptr if the file could not be opened.
+     */
+    AsyncLogTarget* OpenFile(const std::string& path, bool binary = false);
+
+    /**
+     * Wraps a stream such as stdout, the stream is flushed after every batch but never closed.
+     */
+    AsyncLogTarget* OpenStream(FILE* stream);
+
+    /**
+     * Queues text to be written to the target as it is, lines must include their line break.
+     * @return false if the text was dropped as the queue is full.
+     */
+    bool Write(AsyncLogTarget* target, std::string_view text);
+
+    /**
+     * Writes what is queued for the target and closes it, the target must not be used afterwards.
+     */
+    void Close(AsyncLogTarget* target);
+
+    /**
+     * Waits until everything queued so far has been written and flushed.
+     */
+    void Flush();
+
+    Stats GetStats() const;
+
+private:
+    void Push(Entry* entry);
+    void PushAndWait(Entry* entry);
+    Entry* TakeBatch();
+    void FlushTargets(bool streamsOnly);
+    bool WriteBatch(Entry* batch);
+    void Run();
+};
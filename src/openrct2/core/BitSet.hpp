@@ -89,19 +89,21 @@ namespace OpenRCT2
             static_assert(ComputeBlockSize<33>() == sizeof(uintptr_t));
 
             // TODO: Replace with std::popcount when C++20 is enabled.
+            // Counts the bits of each byte in parallel and sums the bytes with a multiplication, compilers turn this
+            // into a single popcnt instruction where the target has one.
             template<typename T> static constexpr size_t popcount(const T val)
             {
-                size_t res = 0;
-                auto x = static_cast<std::make_unsigned_t<T>>(val);
-                while (x > 0u)
-                {
-                    if (x & 1u)
-                        res++;
-                    x >>= 1u;
-                }
-                return res;
+                auto x = static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(val));
+                x = x - ((x >> 1) & 0x5555555555555555ull);
+                x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+                x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+                return static_cast<size_t>((x * 0x0101010101010101ull) >> 56);
             }
 
+            static_assert(popcount<uint8_t>(0xFF) == 8);
+            static_assert(popcount<uint16_t>(0x8001) == 2);
+            static_assert(popcount<uint64_t>(0xFFFFFFFFFFFFFFFFull) == 64);
+
             template<size_t TByteSize> struct StorageBlockType;
 
             template<> struct StorageBlockType<1>
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ContentSplitter.h"
+
+#include "Crypt.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// A piece ends where the top bits of the hash of the bytes before it are all zero, 12 bits give pieces of about 4 KiB
+// past the minimum size.
+static constexpr uint64_t BoundaryMask = 0xFFF0000000000000ULL;
+
+// Random values to hash each byte value with, the same in every build so both sides of a comparison agree.
+static constexpr std::array<uint64_t, 256> GearTable = []() {
+    std::array<uint64_t, 256> table{};
+    uint64_t state = 0x4F70656E52435432ULL;
+    for (auto& value : table)
+    {
+        // SplitMix64
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}();
+
+static size_t GetPieceLength(const uint8_t* data, size_t length)
+{
+    if (length <= ContentSplitter::MinPieceSize)
+        return length;
+
+    // Shifting the hash left for every byte means its top bits only depend on the last 64 bytes, so a boundary is found
+    // in the same place whatever came before it.
+    const auto end = std::min(length, ContentSplitter::MaxPieceSize);
+    uint64_t hash = 0;
+    for (size_t i = ContentSplitter::MinPieceSize - 64; i < end; i++)
+    {
+        hash = (hash << 1) + GearTable[data[i]];
+        if (i >= ContentSplitter::MinPieceSize && (hash & BoundaryMask) == 0)
+        {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+std::vector<ContentPiece> ContentSplitter::Split(const uint8_t* data, size_t length)
+{
+    std::vector<ContentPiece> pieces;
+    size_t offset = 0;
+    while (offset < length)
+    {
+        const auto pieceLength = GetPieceLength(data + offset, length - offset);
+        const auto hash = Hash(data + offset, pieceLength);
+        pieces.push_back({ static_cast<uint32_t>(offset), static_cast<uint32_t>(pieceLength), hash });
+        offset += pieceLength;
+    }
+    return pieces;
+}
+
+uint64_t ContentSplitter::Hash(const uint8_t* data, size_t length)
+{
+    const auto result = Crypt::FNV1a(data, length);
+    uint64_t hash;
+    std::memcpy(&hash, result.data(), sizeof(hash));
+    return hash;
+}
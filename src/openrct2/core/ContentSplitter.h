@@ -0,0 +1,42 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A piece of data cut out by ContentSplitter.
+ */
+struct ContentPiece
+{
+    uint32_t Offset{};
+    uint32_t Length{};
+    uint64_t Hash{};
+};
+
+/**
+ * Cuts data into pieces where the content says so rather than at fixed offsets, so bytes inserted into or removed from
+ * the data only change the pieces around them. Two copies of mostly the same data can be compared piece by piece even
+ * when parts of one have moved.
+ */
+namespace ContentSplitter
+{
+    constexpr size_t MinPieceSize = 1024;
+    constexpr size_t MaxPieceSize = 32 * 1024;
+
+    /**
+     * @return the pieces covering all of the data in order, about 4 KiB each.
+     */
+    std::vector<ContentPiece> Split(const uint8_t* data, size_t length);
+
+    uint64_t Hash(const uint8_t* data, size_t length);
+} // namespace ContentSplitter
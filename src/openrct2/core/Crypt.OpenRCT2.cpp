@@ -43,6 +43,7 @@ public:
     HashAlgorithm* Clear() override
     {
         _data = Offset;
+        _remLen = 0;
         return this;
     }
 
@@ -51,27 +52,33 @@ public:
         if (dataLen == 0)
             return this;
 
-        auto src = reinterpret_cast<const uint64_t*>(data);
+        auto src = static_cast<const uint8_t*>(data);
         if (_remLen > 0)
         {
             // We have remainder, so fill rest of it with bytes from src
-            auto fillLen = sizeof(uint64_t) - _remLen;
+            auto fillLen = std::min(sizeof(uint64_t) - _remLen, dataLen);
             assert(_remLen + fillLen <= sizeof(uint64_t));
             std::memcpy(_rem + _remLen, src, fillLen);
-            src = reinterpret_cast<const uint64_t*>(reinterpret_cast<const uint8_t*>(src) + fillLen);
+            src += fillLen;
             _remLen += fillLen;
             dataLen -= fillLen;
+            if (_remLen < sizeof(uint64_t))
+                return this;
             ProcessRemainder();
         }
 
-        // Process every block of 8 bytes
+        // Process every block of 8 bytes, the loads may be unaligned
+        auto hash = _data;
         while (dataLen >= sizeof(uint64_t))
         {
-            auto temp = *src++;
-            _data ^= temp;
-            _data *= Prime;
+            uint64_t temp;
+            std::memcpy(&temp, src, sizeof(temp));
+            hash ^= temp;
+            hash *= Prime;
+            src += sizeof(uint64_t);
             dataLen -= sizeof(uint64_t);
         }
+        _data = hash;
 
         // Store the remaining data (< 8 bytes)
         if (dataLen > 0)
@@ -98,4 +105,10 @@ namespace Crypt
     {
         return std::make_unique<OpenRCT2FNV1aAlgorithm>();
     }
+
+    FNV1aAlgorithm::Result FNV1a(const void* data, size_t dataLen)
+    {
+        OpenRCT2FNV1aAlgorithm algorithm;
+        return algorithm.Update(data, dataLen)->Finish();
+    }
 } // namespace Crypt
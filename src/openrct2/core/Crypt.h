@@ -57,10 +57,10 @@ namespace Crypt
     [[nodiscard]] std::unique_ptr<RsaAlgorithm> CreateRSA();
     [[nodiscard]] std::unique_ptr<RsaKey> CreateRSAKey();
 
-    inline FNV1aAlgorithm::Result FNV1a(const void* data, size_t dataLen)
-    {
-        return CreateFNV1a()->Update(data, dataLen)->Finish();
-    }
+    /**
+     * Hashes a single buffer without allocating an algorithm instance.
+     */
+    [[nodiscard]] FNV1aAlgorithm::Result FNV1a(const void* data, size_t dataLen);
 
     inline Sha1Algorithm::Result SHA1(const void* data, size_t dataLen)
     {
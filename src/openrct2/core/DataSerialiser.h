@@ -12,6 +12,7 @@
 #include "DataSerialiserTraits.h"
 #include "MemoryStream.h"
 
+#include <cstdint>
 #include <type_traits>
 
 class DataSerialiser
@@ -21,6 +22,59 @@ private:
     OpenRCT2::IStream& _activeStream;
     bool _isSaving = false;
     bool _isLogging = false;
+    bool _compactIntegers = false;
+
+    // Single bytes and bools gain nothing from a variable length encoding.
+    template<typename T>
+    static constexpr bool IsCompactInteger = (std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>
+        && sizeof(T) > 1;
+
+    template<typename T> struct IntegerOf
+    {
+        using type = T;
+    };
+
+    template<typename T> using CompactInteger = typename std::conditional_t<
+        std::is_enum_v<T>, std::underlying_type<T>, IntegerOf<T>>::type;
+
+    template<typename T> void EncodeCompact(T value)
+    {
+        using TUnsigned = std::make_unsigned_t<CompactInteger<T>>;
+        auto bits = static_cast<TUnsigned>(value);
+        if constexpr (std::is_signed_v<CompactInteger<T>>)
+        {
+            // Zigzag, so small negative values stay short as well.
+            const auto sign = (bits >> (sizeof(T) * 8 - 1)) != 0 ? static_cast<TUnsigned>(~TUnsigned{}) : TUnsigned{};
+            bits = static_cast<TUnsigned>(static_cast<TUnsigned>(bits << 1) ^ sign);
+        }
+        do
+        {
+            auto byte = static_cast<uint8_t>(bits & 0x7F);
+            bits = static_cast<TUnsigned>(bits >> 7);
+            if (bits != 0)
+                byte |= 0x80;
+            _activeStream.WriteValue(byte);
+        } while (bits != 0);
+    }
+
+    template<typename T> void DecodeCompact(T& value)
+    {
+        using TUnsigned = std::make_unsigned_t<CompactInteger<T>>;
+        TUnsigned bits = 0;
+        for (size_t shift = 0; shift < sizeof(T) * 8; shift += 7)
+        {
+            auto byte = _activeStream.ReadValue<uint8_t>();
+            bits |= static_cast<TUnsigned>(static_cast<TUnsigned>(byte & 0x7F) << shift);
+            if ((byte & 0x80) == 0)
+                break;
+        }
+        if constexpr (std::is_signed_v<CompactInteger<T>>)
+        {
+            const auto sign = (bits & 1) != 0 ? static_cast<TUnsigned>(~TUnsigned{}) : TUnsigned{};
+            bits = static_cast<TUnsigned>(static_cast<TUnsigned>(bits >> 1) ^ sign);
+        }
+        value = static_cast<T>(bits);
+    }
 
 public:
     DataSerialiser(bool isSaving)
@@ -57,10 +111,30 @@ public:
         return _activeStream;
     }
 
+    /**
+     * Writes plain integers and enums wider than a byte as little endian base 128 varints, signed ones zigzag encoded.
+     * Used for data sent over the network, where most values are small. Composite types keep their fixed layout.
+     */
+    void SetCompactIntegers(bool value)
+    {
+        _compactIntegers = value;
+    }
+
     template<typename T> DataSerialiser& operator<<(const T& data)
     {
         if (!_isLogging)
         {
+            if constexpr (IsCompactInteger<T>)
+            {
+                if (_compactIntegers)
+                {
+                    if (_isSaving)
+                        EncodeCompact(data);
+                    else
+                        DecodeCompact(const_cast<T&>(data));
+                    return *this;
+                }
+            }
             if (_isSaving)
                 DataSerializerTraits<T>::encode(&_activeStream, data);
             else
@@ -78,6 +152,17 @@ public:
     {
         if (!_isLogging)
         {
+            if constexpr (IsCompactInteger<T>)
+            {
+                if (_compactIntegers)
+                {
+                    if (_isSaving)
+                        EncodeCompact(data.Data());
+                    else
+                        DecodeCompact(data.Data());
+                    return *this;
+                }
+            }
             if (_isSaving)
                 DataSerializerTraits<DataSerialiserTag<T>>::encode(&_activeStream, data);
             else
@@ -24,11 +24,14 @@
 #include "Endianness.h"
 #include "MemoryStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 template<typename T> struct DataSerializerTraits_t
 {
@@ -266,6 +269,89 @@ template<> struct DataSerializerTraits_t<OpenRCT2::MemoryStream>
     }
 };
 
+/**
+ * Types that are serialised as their bytes in memory, so ranges of them can be copied in one go.
+ */
+template<typename T> struct DataSerializerIsRawBytes : std::false_type
+{
+};
+
+template<> struct DataSerializerIsRawBytes<uint8_t> : std::true_type
+{
+};
+
+template<> struct DataSerializerIsRawBytes<int8_t> : std::true_type
+{
+};
+
+template<> struct DataSerializerIsRawBytes<utf8> : std::true_type
+{
+};
+
+// Every field of a tile element is a byte, see DataSerializerTraits_t<TileElement>.
+static_assert(sizeof(TileElement) == 16);
+template<> struct DataSerializerIsRawBytes<TileElement> : std::true_type
+{
+};
+
+// Integers and enums are only byte swapped, so ranges of them can be swapped in bulk.
+template<typename T>
+constexpr bool DataSerializerIsBulk = DataSerializerIsRawBytes<T>::value || std::is_enum_v<T>
+    || (std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
+template<typename T> static void DataSerializerEncodeRange(OpenRCT2::IStream* stream, const T* data, size_t count)
+{
+    if constexpr (DataSerializerIsRawBytes<T>::value)
+    {
+        stream->Write(data, count * sizeof(T));
+    }
+    else if constexpr (DataSerializerIsBulk<T>)
+    {
+        // Swap through a small buffer so the range still ends up in a few large writes.
+        T block[256];
+        for (size_t i = 0; i < count; i += std::size(block))
+        {
+            const auto blockCount = std::min(count - i, std::size(block));
+            for (size_t j = 0; j < blockCount; j++)
+            {
+                block[j] = ByteSwapBE(data[i + j]);
+            }
+            stream->Write(block, blockCount * sizeof(T));
+        }
+    }
+    else
+    {
+        DataSerializerTraits<T> s;
+        for (size_t i = 0; i < count; i++)
+        {
+            s.encode(stream, data[i]);
+        }
+    }
+}
+
+template<typename T> static void DataSerializerDecodeRange(OpenRCT2::IStream* stream, T* data, size_t count)
+{
+    if constexpr (DataSerializerIsBulk<T>)
+    {
+        stream->Read(data, count * sizeof(T));
+        if constexpr (!DataSerializerIsRawBytes<T>::value)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                data[i] = ByteSwapBE(data[i]);
+            }
+        }
+    }
+    else
+    {
+        DataSerializerTraits<T> s;
+        for (size_t i = 0; i < count; i++)
+        {
+            s.decode(stream, data[i]);
+        }
+    }
+}
+
 template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
 {
     static void encode(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -274,11 +360,7 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
-        {
-            s.encode(stream, sub);
-        }
+        DataSerializerEncodeRange(stream, std::data(val), std::size(val));
     }
     static void decode(OpenRCT2::IStream* stream, _Ty (&val)[_Size])
     {
@@ -289,11 +371,7 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
-        {
-            s.decode(stream, sub);
-        }
+        DataSerializerDecodeRange(stream, std::data(val), std::size(val));
     }
     static void log(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
     {
@@ -336,11 +414,7 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
-        {
-            s.encode(stream, sub);
-        }
+        DataSerializerEncodeRange(stream, std::data(val), std::size(val));
     }
     static void decode(OpenRCT2::IStream* stream, std::array<_Ty, _Size>& val)
     {
@@ -351,11 +425,7 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
-        {
-            s.decode(stream, sub);
-        }
+        DataSerializerDecodeRange(stream, std::data(val), std::size(val));
     }
     static void log(OpenRCT2::IStream* stream, const std::array<_Ty, _Size>& val)
     {
@@ -378,10 +448,17 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsBulk<_Ty>)
+        {
+            DataSerializerEncodeRange(stream, val.data(), val.size());
+        }
+        else
         {
-            s.encode(stream, sub);
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::vector<_Ty>& val)
@@ -390,12 +467,21 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         stream->Read(&len);
         len = ByteSwapBE(len);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto i = 0; i < len; ++i)
+        if constexpr (DataSerializerIsBulk<_Ty>)
         {
-            _Ty sub{};
-            s.decode(stream, sub);
-            val.push_back(std::move(sub));
+            const auto start = val.size();
+            val.resize(start + len);
+            DataSerializerDecodeRange(stream, val.data() + start, len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto i = 0; i < len; ++i)
+            {
+                _Ty sub{};
+                s.decode(stream, sub);
+                val.push_back(std::move(sub));
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
@@ -20,9 +20,11 @@
 #include "Path.hpp"
 
 #include <chrono>
-#include <list>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -36,14 +38,25 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    /**
+     * A file that was found by the scan, along with the item created from it when it is part of the index.
+     */
+    struct FileRecord
+    {
+        std::string Path;
+        uint64_t Size{};
+        uint64_t LastModified{};
+        std::optional<TItem> Item;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<FileRecord> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<FileRecord> files)
             : Stats(stats)
-            , Files(files)
+            , Files(std::move(files))
         {
         }
     };
@@ -56,11 +69,11 @@ private:
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
         DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -96,25 +109,22 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries and directories and loads the index. If the index is up to date, the items are
+     * loaded from the index and returned, otherwise only the files that were added or changed
+     * since the index was written are indexed again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
         auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
         if (std::get<0>(readIndexResult))
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
+            return GetItems(std::get<1>(readIndexResult));
         }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
-        }
-        return items;
+
+        // Index was not loaded or is out of date
+        return Build(language, scanResult, std::get<1>(readIndexResult));
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
@@ -140,7 +150,7 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<FileRecord> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -160,52 +170,85 @@ private:
                 stats.FileDateModifiedChecksum = Numerics::ror32(stats.FileDateModifiedChecksum, 5);
                 stats.PathChecksum += GetPathChecksum(path);
 
-                files.push_back(std::move(path));
+                auto& file = files.emplace_back();
+                file.Path = std::move(path);
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
             }
         }
-        return ScanResult(stats, files);
+        return ScanResult(stats, std::move(files));
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, std::vector<FileRecord>& files, const std::vector<size_t>& fileIndices, size_t rangeStart,
+        size_t rangeEnd, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            auto& file = files[fileIndices[i]];
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
                 std::lock_guard<std::mutex> lock(printLock);
-                log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
             }
 
-            auto item = Create(language, filePath);
+            auto item = Create(language, file.Path);
             if (std::get<0>(item))
             {
-                items.push_back(std::get<1>(item));
+                file.Item = std::move(std::get<1>(item));
             }
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    /**
+     * Creates the items for all scanned files, items of files that are unchanged since they were
+     * stored in the previous index are reused instead of being created again.
+     */
+    std::vector<TItem> Build(
+        int32_t language, const ScanResult& scanResult, const std::vector<FileRecord>& indexedFiles = {}) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        std::unordered_map<std::string_view, const FileRecord*> indexedFileMap;
+        for (const auto& indexedFile : indexedFiles)
+        {
+            indexedFileMap.emplace(indexedFile.Path, &indexedFile);
+        }
+
+        auto files = scanResult.Files;
+        std::vector<size_t> changedFiles;
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            auto& file = files[i];
+            auto it = indexedFileMap.find(file.Path);
+            if (it != indexedFileMap.end() && it->second->Size == file.Size && it->second->LastModified == file.LastModified)
+            {
+                file.Item = it->second->Item;
+            }
+            else
+            {
+                changedFiles.push_back(i);
+            }
+        }
+
+        if (indexedFiles.empty())
+        {
+            Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
+        }
+        else
+        {
+            Console::WriteLine("Updating %s (%zu of %zu items)", _name.c_str(), changedFiles.size(), files.size());
+        }
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
+        const size_t totalCount = changedFiles.size();
         if (totalCount > 0)
         {
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -222,36 +265,34 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
                 jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                    &FileIndex<TItem>::BuildRange, this, language, std::ref(files), std::cref(changedFiles), rangeStart,
+                    rangeStart + stepSize, std::ref(processed), std::ref(printLock)));
 
                 reportProgress();
             }
 
             jobPool.Join(reportProgress);
-
-            for (const auto& itr : containers)
-            {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
-            }
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        WriteIndexFile(language, scanResult.Stats, files);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<float>(endTime - startTime);
         Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
 
-        return allItems;
+        return GetItems(files);
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    /**
+     * Reads the files stored in the index file. The result is only up to date when the search
+     * directories have not changed since the index was written, otherwise the files can still be
+     * used to avoid indexing unchanged files again.
+     */
+    std::tuple<bool, std::vector<FileRecord>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        bool upToDate = false;
+        std::vector<FileRecord> files;
         if (File::Exists(_indexPath))
         {
             try
@@ -259,26 +300,32 @@ private:
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, check if the saved items can be used
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
+                    files.reserve(header.NumFiles);
                     DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    for (uint32_t i = 0; i < header.NumFiles; i++)
                     {
-                        TItem item;
-                        Serialise(ds, item);
-                        items.emplace_back(std::move(item));
+                        auto& file = files.emplace_back();
+                        bool hasItem = false;
+                        ds << file.Path << file.Size << file.LastModified << hasItem;
+                        if (hasItem)
+                        {
+                            TItem item;
+                            Serialise(ds, item);
+                            file.Item = std::move(item);
+                        }
                     }
-                    loadedItems = true;
+
+                    // If the directories are the same, just use the saved items
+                    upToDate = header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
+                        && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
+                        && header.Stats.PathChecksum == stats.PathChecksum;
                 }
-                else
+                if (!upToDate)
                 {
                     Console::WriteLine("%s out of date", _name.c_str());
                 }
@@ -287,12 +334,14 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                upToDate = false;
+                files.clear();
             }
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        return std::make_tuple(upToDate, std::move(files));
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const DirectoryStats& stats, std::vector<FileRecord>& files) const
     {
         try
         {
@@ -307,14 +356,19 @@ private:
             header.VersionB = _version;
             header.LanguageId = language;
             header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumFiles = static_cast<uint32_t>(files.size());
             fs.WriteValue(header);
 
             DataSerialiser ds(true, fs);
-            // Write items
-            for (auto& item : items)
+            // Write files and their items
+            for (auto& file : files)
             {
-                Serialise(ds, item);
+                bool hasItem = file.Item.has_value();
+                ds << file.Path << file.Size << file.LastModified << hasItem;
+                if (hasItem)
+                {
+                    Serialise(ds, *file.Item);
+                }
             }
         }
         catch (const std::exception& e)
@@ -324,6 +378,20 @@ private:
         }
     }
 
+    static std::vector<TItem> GetItems(const std::vector<FileRecord>& files)
+    {
+        std::vector<TItem> items;
+        items.reserve(files.size());
+        for (const auto& file : files)
+        {
+            if (file.Item)
+            {
+                items.push_back(*file.Item);
+            }
+        }
+        return items;
+    }
+
     static uint32_t GetPathChecksum(const std::string& path)
     {
         uint32_t hash = 0xD8430DED;
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <stdexcept>
@@ -81,7 +82,8 @@ FileWatcher::WatchDescriptor::~WatchDescriptor()
 }
 #endif
 
-FileWatcher::FileWatcher(const std::string& directoryPath)
+FileWatcher::FileWatcher(const std::string& directoryPath, std::chrono::milliseconds debounceTime)
+    : _debounceTime(debounceTime)
 {
 #ifdef _WIN32
     _path = directoryPath;
@@ -137,22 +139,18 @@ void FileWatcher::WatchDirectory()
         _directoryHandle, eventData.data(), static_cast<DWORD>(eventData.size()), TRUE, FILE_NOTIFY_CHANGE_LAST_WRITE,
         &bytesReturned, nullptr, nullptr))
     {
-        auto onFileChanged = OnFileChanged;
-        if (onFileChanged)
+        FILE_NOTIFY_INFORMATION* notifyInfo;
+        size_t offset = 0;
+        do
         {
-            FILE_NOTIFY_INFORMATION* notifyInfo;
-            size_t offset = 0;
-            do
-            {
-                notifyInfo = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(eventData.data() + offset);
-                offset += notifyInfo->NextEntryOffset;
-
-                std::wstring fileNameW(notifyInfo->FileName, notifyInfo->FileNameLength / sizeof(wchar_t));
-                auto fileName = String::ToUtf8(fileNameW);
-                auto path = fs::path(_path) / fs::path(fileName);
-                onFileChanged(path.u8string());
-            } while (notifyInfo->NextEntryOffset != 0);
-        }
+            notifyInfo = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(eventData.data() + offset);
+            offset += notifyInfo->NextEntryOffset;
+
+            std::wstring fileNameW(notifyInfo->FileName, notifyInfo->FileNameLength / sizeof(wchar_t));
+            auto fileName = String::ToUtf8(fileNameW);
+            auto path = fs::path(_path) / fs::path(fileName);
+            OnFileChanged(path.u8string());
+        } while (notifyInfo->NextEntryOffset != 0);
     }
 #elif defined(__linux__)
     log_verbose("FileWatcher: reading event data...");
@@ -163,31 +161,27 @@ void FileWatcher::WatchDirectory()
         if (length >= 0)
         {
             log_verbose("FileWatcher: inotify event data received");
-            auto onFileChanged = OnFileChanged;
-            if (onFileChanged)
+            int offset = 0;
+            while (offset < length)
             {
-                int offset = 0;
-                while (offset < length)
+                auto e = reinterpret_cast<inotify_event*>(eventData.data() + offset);
+                if ((e->mask & IN_CLOSE_WRITE) && !(e->mask & IN_ISDIR))
                 {
-                    auto e = reinterpret_cast<inotify_event*>(eventData.data() + offset);
-                    if ((e->mask & IN_CLOSE_WRITE) && !(e->mask & IN_ISDIR))
+                    log_verbose("FileWatcher: inotify event received for %s", e->name);
+
+                    // Find watch descriptor
+                    int wd = e->wd;
+                    auto findResult = std::find_if(
+                        _watchDescs.begin(), _watchDescs.end(),
+                        [wd](const WatchDescriptor& watchDesc) { return wd == watchDesc.Wd; });
+                    if (findResult != _watchDescs.end())
                     {
-                        log_verbose("FileWatcher: inotify event received for %s", e->name);
-
-                        // Find watch descriptor
-                        int wd = e->wd;
-                        auto findResult = std::find_if(
-                            _watchDescs.begin(), _watchDescs.end(),
-                            [wd](const WatchDescriptor& watchDesc) { return wd == watchDesc.Wd; });
-                        if (findResult != _watchDescs.end())
-                        {
-                            auto directory = findResult->Path;
-                            auto path = fs::path(directory) / fs::path(e->name);
-                            onFileChanged(path);
-                        }
+                        auto directory = findResult->Path;
+                        auto path = fs::path(directory) / fs::path(e->name);
+                        OnFileChanged(path.u8string());
                     }
-                    offset += sizeof(inotify_event) + e->len;
                 }
+                offset += sizeof(inotify_event) + e->len;
             }
         }
 
@@ -196,3 +190,29 @@ void FileWatcher::WatchDirectory()
     }
 #endif
 }
+
+void FileWatcher::OnFileChanged(const std::string& path)
+{
+    std::lock_guard<std::mutex> guard(_changedFilesMutex);
+    _changedFiles[path] = std::chrono::steady_clock::now();
+}
+
+std::vector<std::string> FileWatcher::GetChangedFiles()
+{
+    std::vector<std::string> result;
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> guard(_changedFilesMutex);
+    for (auto it = _changedFiles.begin(); it != _changedFiles.end();)
+    {
+        if (now - it->second >= _debounceTime)
+        {
+            result.push_back(it->first);
+            it = _changedFiles.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    return result;
+}
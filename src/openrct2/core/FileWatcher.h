@@ -9,9 +9,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _WIN32
@@ -20,11 +23,16 @@ typedef void* HANDLE;
 
 /**
  * Creates a new thread that watches a directory tree for file modifications.
+ * A file is only reported once it has not been written to for the debounce time, so that a file saved in several
+ * writes is reported once the writes have finished.
  */
 class FileWatcher
 {
 private:
     std::thread _watchThread;
+    std::chrono::milliseconds const _debounceTime;
+    std::mutex _changedFilesMutex;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> _changedFiles;
 #if defined(_WIN32)
     std::string _path;
     HANDLE _directoryHandle{};
@@ -53,15 +61,22 @@ private:
 #endif
 
 public:
-    std::function<void(const std::string& path)> OnFileChanged;
+    static constexpr std::chrono::milliseconds DefaultDebounceTime{ 500 };
 
-    FileWatcher(const std::string& directoryPath);
+    FileWatcher(const std::string& directoryPath, std::chrono::milliseconds debounceTime = DefaultDebounceTime);
     ~FileWatcher();
 
+    /**
+     * Gets the files that have changed and have not been written to since for the debounce time.
+     * Every change is only returned once, files that are still being written to are returned by a later call.
+     */
+    std::vector<std::string> GetChangedFiles();
+
 private:
 #if defined(_WIN32) || defined(__linux__)
     bool _finished{};
 #endif
 
     void WatchDirectory();
+    void OnFileChanged(const std::string& path);
 };
@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * Fixed size history of values, index 0 being the most recent one. Slots that have never been recorded hold TUndefined.
+ * Every value is stored twice, TSize items apart, so the whole history can always be read as one contiguous array
+ * while recording a new value only moves the start of the buffer.
+ * The smallest and largest of the TExtremaSize most recent values are kept up to date as values are recorded.
+ */
+template<typename T, size_t TSize, T TUndefined, size_t TExtremaSize = TSize> class HistoryBuffer
+{
+    static_assert(TSize != 0, "HistoryBuffer size must not be zero");
+    static_assert(TExtremaSize != 0 && TExtremaSize <= TSize, "HistoryBuffer extrema must cover part of the history");
+
+private:
+    std::array<T, TSize * 2> _items;
+    size_t _start = 0;
+    mutable T _minimum = TUndefined;
+    mutable T _maximum = TUndefined;
+    mutable bool _extremaValid = true;
+
+public:
+    HistoryBuffer()
+    {
+        Fill(TUndefined);
+    }
+
+    static constexpr size_t size()
+    {
+        return TSize;
+    }
+
+    const T* data() const
+    {
+        return &_items[_start];
+    }
+
+    const T* begin() const
+    {
+        return data();
+    }
+
+    const T* end() const
+    {
+        return data() + TSize;
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return _items[_start + index];
+    }
+
+    /**
+     * Records a new value as the most recent one, dropping the oldest.
+     */
+    void Push(T value)
+    {
+        const auto dropped = (*this)[TExtremaSize - 1];
+        _start = (_start + TSize - 1) % TSize;
+        _items[_start] = value;
+        _items[_start + TSize] = value;
+
+        if (!_extremaValid)
+            return;
+        if (dropped != TUndefined && (dropped == _minimum || dropped == _maximum))
+        {
+            // The dropped value may have been the only one at an extreme
+            _extremaValid = false;
+            return;
+        }
+        if (value != TUndefined)
+        {
+            if (_minimum == TUndefined || value < _minimum)
+                _minimum = value;
+            if (_maximum == TUndefined || value > _maximum)
+                _maximum = value;
+        }
+    }
+
+    void Set(size_t index, T value)
+    {
+        auto slot = (_start + index) % TSize;
+        _items[slot] = value;
+        _items[slot + TSize] = value;
+        if (index < TExtremaSize)
+            _extremaValid = false;
+    }
+
+    void Fill(T value)
+    {
+        _items.fill(value);
+        _start = 0;
+        _extremaValid = false;
+    }
+
+    /**
+     * @return the smallest of the TExtremaSize most recent values, or TUndefined if none were recorded.
+     */
+    T GetMinimum() const
+    {
+        UpdateExtrema();
+        return _minimum;
+    }
+
+    /**
+     * @return the largest of the TExtremaSize most recent values, or TUndefined if none were recorded.
+     */
+    T GetMaximum() const
+    {
+        UpdateExtrema();
+        return _maximum;
+    }
+
+private:
+    void UpdateExtrema() const
+    {
+        if (_extremaValid)
+            return;
+
+        _minimum = TUndefined;
+        _maximum = TUndefined;
+        for (auto it = begin(); it != begin() + TExtremaSize; it++)
+        {
+            const auto value = *it;
+            if (value == TUndefined)
+                continue;
+            if (_minimum == TUndefined || value < _minimum)
+                _minimum = value;
+            if (_maximum == TUndefined || value > _maximum)
+                _maximum = value;
+        }
+        _extremaValid = true;
+    }
+};
@@ -17,6 +17,7 @@
 
 #    include <cstdio>
 #    include <stdexcept>
+#    include <thread>
 #    include <windows.h>
 #    include <winhttp.h>
 
@@ -235,6 +236,24 @@ namespace Http
             throw;
         }
     }
+
+    void DoAsync(const Request& req, std::function<void(Response& res)> fn)
+    {
+        auto thread = std::thread([=]() {
+            Response res{};
+            try
+            {
+                res = Do(req);
+            }
+            catch (std::exception& e)
+            {
+                res.status = Status::Invalid;
+                res.error = e.what();
+            }
+            fn(res);
+        });
+        thread.detach();
+    }
 } // namespace Http
 
 #endif
@@ -14,10 +14,14 @@
 #    include "../Version.h"
 #    include "../core/Console.hpp"
 
+#    include <condition_variable>
 #    include <cstring>
 #    include <memory>
+#    include <mutex>
 #    include <stdexcept>
 #    include <thread>
+#    include <unordered_map>
+#    include <vector>
 
 #    if defined(_WIN32) && !defined(WIN32_LEAN_AND_MEAN)
 // cURL includes windows.h, but we don't need all of it.
@@ -82,25 +86,49 @@ namespace Http
         return 0;
     }
 
-    Response Do(const Request& req)
+    /**
+     * The state of a single transfer, it must stay at the same address while curl uses it.
+     */
+    struct Transfer
     {
-        CURL* curl = curl_easy_init();
-        std::shared_ptr<void> _(nullptr, [curl](...) { curl_easy_cleanup(curl); });
+        Request Req;
+        Response Res;
+        WriteThis Upload{};
+        curl_slist* Headers{};
+        CURL* Handle{};
+        std::function<void(Response& res)> Callback;
+
+        explicit Transfer(const Request& req)
+            : Req(req)
+        {
+        }
+
+        ~Transfer()
+        {
+            curl_slist_free_all(Headers);
+            curl_easy_cleanup(Handle);
+        }
+
+        Transfer(const Transfer&) = delete;
+        Transfer& operator=(const Transfer&) = delete;
+    };
 
+    static void SetupTransfer(Transfer& transfer)
+    {
+        auto& req = transfer.Req;
+        auto* curl = curl_easy_init();
         if (!curl)
             throw std::runtime_error("Failed to initialize curl");
-
-        Response res;
-        WriteThis wt;
+        transfer.Handle = curl;
 
         if (req.method == Method::POST || req.method == Method::PUT)
         {
-            wt.readptr = req.body.c_str();
-            wt.sizeleft = req.body.size();
+            transfer.Upload.readptr = req.body.c_str();
+            transfer.Upload.sizeleft = req.body.size();
 
             curl_easy_setopt(curl, CURLOPT_READFUNCTION, read_callback);
-            curl_easy_setopt(curl, CURLOPT_READDATA, &wt);
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(wt.sizeleft));
+            curl_easy_setopt(curl, CURLOPT_READDATA, &transfer.Upload);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(transfer.Upload.sizeleft));
         }
 
         if (req.forceIPv4)
@@ -115,50 +143,201 @@ namespace Http
         curl_easy_setopt(curl, CURLOPT_URL, req.url.c_str());
         curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, true);
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeData);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, static_cast<void*>(&res));
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, static_cast<void*>(&transfer.Res));
         curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_callback);
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, static_cast<void*>(&res));
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, true);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, static_cast<void*>(&transfer.Res));
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, true);
         curl_easy_setopt(curl, CURLOPT_USERAGENT, OPENRCT2_USER_AGENT);
+        // Pooled connections sit idle between requests, keep them from being dropped along the way.
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
 
-        curl_slist* chunk = nullptr;
-        std::shared_ptr<void> __(nullptr, [chunk](...) { curl_slist_free_all(chunk); });
-        for (auto header : req.header)
+        for (const auto& header : req.header)
         {
             std::string hs = header.first + ": " + header.second;
-            chunk = curl_slist_append(chunk, hs.c_str());
-        }
-        if (req.header.size() != 0)
-        {
-            if (chunk == nullptr)
+            auto* headers = curl_slist_append(transfer.Headers, hs.c_str());
+            if (headers == nullptr)
             {
                 throw std::runtime_error("Failed to set headers");
             }
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
+            transfer.Headers = headers;
+        }
+        if (transfer.Headers != nullptr)
+        {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.Headers);
         }
+    }
 
-        CURLcode curl_code = curl_easy_perform(curl);
+    static void FinishTransfer(Transfer& transfer, CURLcode curl_code)
+    {
+        auto& res = transfer.Res;
         if (curl_code != CURLE_OK)
         {
             using namespace std::literals;
-            throw std::runtime_error(
-                "Failed to perform request. curl error code: "s + std::to_string(curl_code) + ": "
-                + curl_easy_strerror(curl_code));
+            res.status = Status::Invalid;
+            res.error = "Failed to perform request. curl error code: "s + std::to_string(curl_code) + ": "
+                + curl_easy_strerror(curl_code);
+            return;
         }
 
         // gets freed by curl_easy_cleanup
-        char* content_type;
-        long code;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
-        curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &content_type);
+        char* content_type = nullptr;
+        long code = 0;
+        curl_easy_getinfo(transfer.Handle, CURLINFO_RESPONSE_CODE, &code);
+        curl_easy_getinfo(transfer.Handle, CURLINFO_CONTENT_TYPE, &content_type);
         res.status = static_cast<Status>(code);
         if (content_type != nullptr)
         {
             res.content_type = std::string(content_type);
         }
+    }
+
+    /**
+     * Runs asynchronous requests on a single thread using the cURL multi interface. Connections are kept open in the
+     * cache of the multi handle, so repeated requests to the same host, like the heartbeats of the server advertiser,
+     * reuse the connection and TLS session of the previous one.
+     */
+    class Client
+    {
+    private:
+        // Limits the transfers waiting on their sockets, so new requests are noticed without a wakeup call.
+        static constexpr int32_t WaitTimeoutMs = 50;
+        static constexpr long MaxCachedConnections = 8;
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        CURLM* _multi{};
+        std::vector<std::unique_ptr<Transfer>> _pending;
+        std::thread _thread;
+        bool _stopping = false;
 
-        return res;
+    public:
+        ~Client()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _condition.notify_one();
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        void Add(std::unique_ptr<Transfer> transfer)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_multi == nullptr)
+                {
+                    _multi = curl_multi_init();
+                    if (_multi == nullptr)
+                    {
+                        FinishTransfer(*transfer, CURLE_FAILED_INIT);
+                        transfer->Callback(transfer->Res);
+                        return;
+                    }
+                    curl_multi_setopt(_multi, CURLMOPT_MAXCONNECTS, MaxCachedConnections);
+                    _thread = std::thread([this]() { Run(_multi); });
+                }
+                _pending.push_back(std::move(transfer));
+            }
+            _condition.notify_one();
+        }
+
+    private:
+        void Run(CURLM* multi)
+        {
+            std::unordered_map<CURL*, std::unique_ptr<Transfer>> running;
+            while (true)
+            {
+                std::vector<std::unique_ptr<Transfer>> added;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    // Only sleep when there is nothing to do, open connections stay in the cache meanwhile.
+                    _condition.wait(lock, [&]() { return _stopping || !_pending.empty() || !running.empty(); });
+                    if (_stopping)
+                        break;
+                    added = std::move(_pending);
+                    _pending.clear();
+                }
+
+                for (auto& transfer : added)
+                {
+                    auto* handle = transfer->Handle;
+                    if (curl_multi_add_handle(multi, handle) != CURLM_OK)
+                    {
+                        FinishTransfer(*transfer, CURLE_FAILED_INIT);
+                        transfer->Callback(transfer->Res);
+                        continue;
+                    }
+                    running.emplace(handle, std::move(transfer));
+                }
+
+                int stillRunning = 0;
+                curl_multi_perform(multi, &stillRunning);
+
+                int messagesLeft = 0;
+                while (auto* msg = curl_multi_info_read(multi, &messagesLeft))
+                {
+                    if (msg->msg != CURLMSG_DONE)
+                        continue;
+
+                    auto it = running.find(msg->easy_handle);
+                    if (it == running.end())
+                        continue;
+
+                    auto transfer = std::move(it->second);
+                    running.erase(it);
+                    FinishTransfer(*transfer, msg->data.result);
+                    curl_multi_remove_handle(multi, transfer->Handle);
+                    transfer->Callback(transfer->Res);
+                }
+
+                if (!running.empty())
+                {
+                    curl_multi_wait(multi, nullptr, 0, WaitTimeoutMs, nullptr);
+                }
+            }
+
+            for (auto& [handle, transfer] : running)
+            {
+                curl_multi_remove_handle(multi, handle);
+            }
+            running.clear();
+            curl_multi_cleanup(multi);
+        }
+    };
+
+    static Client _client;
+
+    Response Do(const Request& req)
+    {
+        Transfer transfer(req);
+        SetupTransfer(transfer);
+        FinishTransfer(transfer, curl_easy_perform(transfer.Handle));
+        if (!transfer.Res.error.empty())
+        {
+            throw std::runtime_error(transfer.Res.error);
+        }
+        return std::move(transfer.Res);
+    }
+
+    void DoAsync(const Request& req, std::function<void(Response& res)> fn)
+    {
+        auto transfer = std::make_unique<Transfer>(req);
+        transfer->Callback = std::move(fn);
+        try
+        {
+            SetupTransfer(*transfer);
+        }
+        catch (const std::exception& e)
+        {
+            transfer->Res.error = e.what();
+            transfer->Callback(transfer->Res);
+            return;
+        }
+        _client.Add(std::move(transfer));
     }
 
 } // namespace Http
@@ -16,7 +16,6 @@
 #    include <functional>
 #    include <map>
 #    include <string>
-#    include <thread>
 
 namespace Http
 {
@@ -54,23 +53,11 @@ namespace Http
 
     Response Do(const Request& req);
 
-    inline void DoAsync(const Request& req, std::function<void(Response& res)> fn)
-    {
-        auto thread = std::thread([=]() {
-            Response res{};
-            try
-            {
-                res = Do(req);
-            }
-            catch (std::exception& e)
-            {
-                res.error = e.what();
-                return;
-            }
-            fn(res);
-        });
-        thread.detach();
-    }
+    /**
+     * Performs the request in the background and passes the response to the callback. Callbacks are run on a background
+     * thread, also when the request failed.
+     */
+    void DoAsync(const Request& req, std::function<void(Response& res)> fn);
 } // namespace Http
 
 #endif // DISABLE_HTTP
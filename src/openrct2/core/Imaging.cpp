@@ -15,14 +15,19 @@
 #include "../drawing/Drawing.h"
 #include "Guard.hpp"
 #include "IStream.hpp"
+#include "JobPool.h"
 #include "Memory.hpp"
 #include "String.hpp"
 
 #include <algorithm>
+#include <exception>
 #include <fstream>
+#include <iterator>
 #include <png.h>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
+#include <zlib.h>
 
 namespace Imaging
 {
@@ -36,18 +41,6 @@ namespace Imaging
         istream->read(reinterpret_cast<char*>(data), length);
     }
 
-    static void PngWriteData(png_structp png_ptr, png_bytep data, png_size_t length)
-    {
-        auto ostream = static_cast<std::ostream*>(png_get_io_ptr(png_ptr));
-        ostream->write(reinterpret_cast<const char*>(data), length);
-    }
-
-    static void PngFlush(png_structp png_ptr)
-    {
-        auto ostream = static_cast<std::ostream*>(png_get_io_ptr(png_ptr));
-        ostream->flush();
-    }
-
     static void PngWarning(png_structp, const char* b)
     {
         log_warning(b);
@@ -162,95 +155,302 @@ namespace Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    // Amount of filtered image data deflated by a single task. Every block is compressed as an
+    // independent deflate stream, so blocks can be encoded in parallel and concatenated afterwards.
+    constexpr size_t PNG_DEFLATE_BLOCK_SIZE = 256 * 1024;
+
+    static void WriteUInt32BE(uint8_t* dst, uint32_t value)
     {
-        png_structp png_ptr = nullptr;
-        png_colorp png_palette = nullptr;
-        try
+        dst[0] = static_cast<uint8_t>(value >> 24);
+        dst[1] = static_cast<uint8_t>(value >> 16);
+        dst[2] = static_cast<uint8_t>(value >> 8);
+        dst[3] = static_cast<uint8_t>(value);
+    }
+
+    static void WritePngChunk(std::ostream& stream, const char* type, const uint8_t* data, size_t length)
+    {
+        uint8_t header[8];
+        WriteUInt32BE(header, static_cast<uint32_t>(length));
+        std::copy_n(type, 4, header + 4);
+
+        auto crc = crc32(0L, header + 4, 4);
+        if (length != 0)
         {
-            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
-            if (png_ptr == nullptr)
-            {
-                throw std::runtime_error("png_create_write_struct failed.");
-            }
+            crc = crc32(crc, data, static_cast<uInt>(length));
+        }
+        uint8_t footer[4];
+        WriteUInt32BE(footer, static_cast<uint32_t>(crc));
 
-            png_text text_ptr[1];
-            text_ptr[0].key = const_cast<char*>("Software");
-            text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
-            text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+        stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(data), length);
+        stream.write(reinterpret_cast<const char*>(footer), sizeof(footer));
+    }
 
-            auto info_ptr = png_create_info_struct(png_ptr);
-            if (info_ptr == nullptr)
+    struct PngRowWriter::State
+    {
+        struct Block
+        {
+            const uint8_t* Pixels{};
+            uint32_t NumRows{};
+            bool IsLast{};
+            std::vector<uint8_t> Filtered;
+            std::vector<uint8_t> Compressed;
+            uLong Adler{};
+            std::exception_ptr Error;
+
+            void Deflate(uint32_t width, uint32_t depth, uint32_t stride);
+        };
+
+        std::ofstream File;
+        std::ostream* Stream{};
+        uint32_t Width{};
+        uint32_t Height{};
+        uint32_t Depth{};
+        uint32_t RowsWritten{};
+        uLong Adler = adler32(0L, Z_NULL, 0);
+        std::vector<Block> Blocks;
+        std::unique_ptr<JobPool> Pool;
+    };
+
+    /**
+     * Filters and deflates the rows of a block. 32-bit images use the sub filter which is cheap and
+     * compresses screenshots well, paletted images are stored unfiltered like libpng does.
+     */
+    void PngRowWriter::State::Block::Deflate(uint32_t width, uint32_t depth, uint32_t stride)
+    {
+        const size_t bytesPerPixel = depth / 8;
+        const size_t rowBytes = width * bytesPerPixel;
+        Filtered.resize((rowBytes + 1) * NumRows);
+        auto* dst = Filtered.data();
+        for (uint32_t y = 0; y < NumRows; y++)
+        {
+            const auto* src = Pixels + static_cast<size_t>(y) * stride;
+            if (depth == 8)
             {
-                throw std::runtime_error("png_create_info_struct failed.");
+                *dst++ = 0;
+                dst = std::copy_n(src, rowBytes, dst);
             }
-
-            if (image.Depth == 8)
+            else
             {
-                if (image.Palette == nullptr)
+                *dst++ = 1;
+                dst = std::copy_n(src, bytesPerPixel, dst);
+                for (size_t i = bytesPerPixel; i < rowBytes; i++)
                 {
-                    throw std::runtime_error("Expected a palette for 8-bit image.");
+                    *dst++ = static_cast<uint8_t>(src[i] - src[i - bytesPerPixel]);
                 }
+            }
+        }
+        Adler = adler32(adler32(0L, Z_NULL, 0), Filtered.data(), static_cast<uInt>(Filtered.size()));
 
-                // Set the palette
-                png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
-                if (png_palette == nullptr)
-                {
-                    throw std::runtime_error("png_malloc failed.");
-                }
-                for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
-                {
-                    const auto& entry = (*image.Palette)[static_cast<uint16_t>(i)];
-                    png_palette[i].blue = entry.Blue;
-                    png_palette[i].green = entry.Green;
-                    png_palette[i].red = entry.Red;
-                }
-                png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+        z_stream strm{};
+        const auto strategy = depth == 8 ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+        if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, strategy) != Z_OK)
+        {
+            throw std::runtime_error("deflateInit2 failed.");
+        }
+
+        // Sync flushing ends the block on a byte boundary without marking it as the final one.
+        const auto flush = IsLast ? Z_FINISH : Z_SYNC_FLUSH;
+        Compressed.resize(deflateBound(&strm, static_cast<uLong>(Filtered.size())) + 16);
+        strm.next_in = Filtered.data();
+        strm.avail_in = static_cast<uInt>(Filtered.size());
+        strm.next_out = Compressed.data();
+        strm.avail_out = static_cast<uInt>(Compressed.size());
+        const auto ret = deflate(&strm, flush);
+        const auto compressedSize = strm.total_out;
+        deflateEnd(&strm);
+        if (ret != (IsLast ? Z_STREAM_END : Z_OK) || strm.avail_in != 0)
+        {
+            throw std::runtime_error("deflate failed.");
+        }
+        Compressed.resize(compressedSize);
+    }
+
+    static std::ofstream OpenOutputFile(std::string_view path)
+    {
+#if defined(_WIN32) && !defined(__MINGW32__)
+        auto pathW = String::ToWideChar(path);
+        return std::ofstream(pathW, std::ios::binary);
+#else
+        return std::ofstream(std::string(path), std::ios::binary);
+#endif
+    }
+
+    PngRowWriter::PngRowWriter(
+        std::ostream& stream, uint32_t width, uint32_t height, uint32_t depth, const GamePalette* palette)
+        : _state(std::make_unique<State>())
+    {
+        Begin(stream, width, height, depth, palette);
+    }
+
+    PngRowWriter::PngRowWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette)
+        : _state(std::make_unique<State>())
+    {
+        _state->File = OpenOutputFile(path);
+        if (!_state->File.is_open())
+        {
+            throw std::runtime_error("Unable to open file for writing.");
+        }
+        Begin(_state->File, width, height, 8, &palette);
+    }
+
+    PngRowWriter::~PngRowWriter() = default;
+
+    void PngRowWriter::Begin(std::ostream& stream, uint32_t width, uint32_t height, uint32_t depth, const GamePalette* palette)
+    {
+        if (width == 0 || height == 0)
+        {
+            throw std::runtime_error("Invalid image size.");
+        }
+        if (depth != 8 && depth != 32)
+        {
+            throw std::runtime_error("Unsupported bit depth.");
+        }
+        if (depth == 8 && palette == nullptr)
+        {
+            throw std::runtime_error("Expected a palette for 8-bit image.");
+        }
+
+        _state->Stream = &stream;
+        _state->Width = width;
+        _state->Height = height;
+        _state->Depth = depth;
+
+        static constexpr uint8_t signature[] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+        stream.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+        uint8_t header[13]{};
+        WriteUInt32BE(header, width);
+        WriteUInt32BE(header + 4, height);
+        header[8] = 8;
+        header[9] = depth == 8 ? PNG_COLOR_TYPE_PALETTE : PNG_COLOR_TYPE_RGB_ALPHA;
+        WritePngChunk(stream, "IHDR", header, sizeof(header));
+
+        if (depth == 8)
+        {
+            uint8_t entries[PNG_MAX_PALETTE_LENGTH * 3];
+            for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+            {
+                const auto& entry = (*palette)[static_cast<uint16_t>(i)];
+                entries[i * 3 + 0] = entry.Red;
+                entries[i * 3 + 1] = entry.Green;
+                entries[i * 3 + 2] = entry.Blue;
             }
+            WritePngChunk(stream, "PLTE", entries, sizeof(entries));
 
-            png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
+            // Palette index 0 is transparent
+            const uint8_t transparentIndex = 0;
+            WritePngChunk(stream, "tRNS", &transparentIndex, 1);
+        }
 
-            // Set error handler
-            if (setjmp(png_jmpbuf(png_ptr)))
+        std::string text = std::string("Software") + '\0' + gVersionInfoFull;
+        WritePngChunk(stream, "tEXt", reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    }
+
+    void PngRowWriter::WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride)
+    {
+        auto& state = *_state;
+        if (state.RowsWritten + numRows > state.Height)
+        {
+            throw std::runtime_error("Too many rows written to PNG.");
+        }
+        if (numRows == 0)
+        {
+            return;
+        }
+
+        const auto isLastBatch = state.RowsWritten + numRows == state.Height;
+        const size_t filteredRowBytes = static_cast<size_t>(state.Width) * (state.Depth / 8) + 1;
+        const auto rowsPerBlock = static_cast<uint32_t>(std::max<size_t>(1, PNG_DEFLATE_BLOCK_SIZE / filteredRowBytes));
+        const auto numBlocks = (numRows + rowsPerBlock - 1) / rowsPerBlock;
+
+        state.Blocks.resize(numBlocks);
+        for (uint32_t i = 0; i < numBlocks; i++)
+        {
+            auto& block = state.Blocks[i];
+            block.Pixels = pixels + static_cast<size_t>(i) * rowsPerBlock * stride;
+            block.NumRows = std::min(rowsPerBlock, numRows - i * rowsPerBlock);
+            block.IsLast = isLastBatch && i == numBlocks - 1;
+            block.Error = nullptr;
+        }
+
+        auto deflateBlock = [&state, stride](State::Block& block) {
+            try
+            {
+                block.Deflate(state.Width, state.Depth, stride);
+            }
+            catch (const std::exception&)
             {
-                throw std::runtime_error("PNG ERROR");
+                block.Error = std::current_exception();
             }
+        };
+        if (numBlocks == 1)
+        {
+            deflateBlock(state.Blocks[0]);
+        }
+        else
+        {
+            if (state.Pool == nullptr)
+            {
+                state.Pool = std::make_unique<JobPool>();
+            }
+            for (uint32_t i = 0; i < numBlocks; i++)
+            {
+                state.Pool->AddTask([&deflateBlock, &block = state.Blocks[i]]() { deflateBlock(block); });
+            }
+            state.Pool->Join();
+        }
 
-            // Write header
-            auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
-            if (image.Depth == 8)
+        // Blocks are written in order, the zlib header goes in front of the first one and the combined
+        // checksum of all blocks after the last one.
+        for (uint32_t i = 0; i < numBlocks; i++)
+        {
+            auto& block = state.Blocks[i];
+            if (block.Error != nullptr)
             {
-                png_byte transparentIndex = 0;
-                png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
-                colourType = PNG_COLOR_TYPE_PALETTE;
+                std::rethrow_exception(block.Error);
             }
-            png_set_text(png_ptr, info_ptr, text_ptr, 1);
-            png_set_IHDR(
-                png_ptr, info_ptr, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
-                PNG_FILTER_TYPE_DEFAULT);
-            png_write_info(png_ptr, info_ptr);
-
-            // Write pixels
-            auto pixels = image.Pixels.data();
-            for (uint32_t y = 0; y < image.Height; y++)
+            state.Adler = adler32_combine(state.Adler, block.Adler, static_cast<z_off_t>(block.Filtered.size()));
+
+            if (state.RowsWritten == 0 && i == 0)
             {
-                png_write_row(png_ptr, const_cast<png_byte*>(pixels));
-                pixels += image.Stride;
+                static constexpr uint8_t zlibHeader[] = { 0x78, 0x9C };
+                block.Compressed.insert(block.Compressed.begin(), std::begin(zlibHeader), std::end(zlibHeader));
             }
+            if (block.IsLast)
+            {
+                uint8_t checksum[4];
+                WriteUInt32BE(checksum, static_cast<uint32_t>(state.Adler));
+                block.Compressed.insert(block.Compressed.end(), std::begin(checksum), std::end(checksum));
+            }
+            WritePngChunk(*state.Stream, "IDAT", block.Compressed.data(), block.Compressed.size());
+        }
+        state.RowsWritten += numRows;
+    }
 
-            png_write_end(png_ptr, nullptr);
-            png_destroy_info_struct(png_ptr, &info_ptr);
-            png_free(png_ptr, png_palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
+    void PngRowWriter::Finish()
+    {
+        auto& state = *_state;
+        if (state.RowsWritten != state.Height)
+        {
+            throw std::runtime_error("Not all rows written to PNG.");
         }
-        catch (const std::exception&)
+
+        WritePngChunk(*state.Stream, "IEND", nullptr, 0);
+        state.Stream->flush();
+        if (!state.Stream->good())
         {
-            png_free(png_ptr, png_palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
-            throw;
+            throw std::runtime_error("Unable to write PNG.");
         }
     }
 
+    static void WritePng(std::ostream& ostream, const Image& image)
+    {
+        PngRowWriter writer(ostream, image.Width, image.Height, image.Depth, image.Palette.get());
+        writer.WriteRows(image.Pixels.data(), image.Height, image.Stride);
+        writer.Finish();
+    }
+
     IMAGE_FORMAT GetImageFormatFromPath(std::string_view path)
     {
         if (String::EndsWith(path, ".png", true))
@@ -337,12 +537,7 @@ namespace Imaging
                 break;
             case IMAGE_FORMAT::PNG:
             {
-#if defined(_WIN32) && !defined(__MINGW32__)
-                auto pathW = String::ToWideChar(path);
-                std::ofstream fs(pathW, std::ios::binary);
-#else
-                std::ofstream fs(std::string(path), std::ios::binary);
-#endif
+                auto fs = OpenOutputFile(path);
                 WritePng(fs, image);
                 break;
             }
@@ -15,6 +15,7 @@
 #include <functional>
 #include <istream>
 #include <memory>
+#include <ostream>
 #include <string_view>
 #include <vector>
 
@@ -52,4 +53,28 @@ namespace Imaging
     void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
+
+    /**
+     * Encodes a PNG row by row, so that an image can be written while it is still being
+     * produced without ever holding all of its pixels in memory.
+     */
+    class PngRowWriter
+    {
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+
+    public:
+        PngRowWriter(std::ostream& stream, uint32_t width, uint32_t height, uint32_t depth, const GamePalette* palette);
+        PngRowWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette);
+        PngRowWriter(const PngRowWriter&) = delete;
+        PngRowWriter& operator=(const PngRowWriter&) = delete;
+        ~PngRowWriter();
+
+        void WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride);
+        void Finish();
+
+    private:
+        void Begin(std::ostream& stream, uint32_t width, uint32_t height, uint32_t depth, const GamePalette* palette);
+    };
 } // namespace Imaging
@@ -9,117 +9,237 @@
 
 #include "JobPool.h"
 
+#include "../platform/Platform2.h"
+#include "PerformanceCounters.h"
+#include "String.hpp"
+
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+
+static thread_local const JobPool* _currentPool = nullptr;
+static thread_local size_t _currentSlot = 0;
 
-JobPool::TaskData::TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-    : WorkFn(workFn)
-    , CompletionFn(completionFn)
+JobPool::TaskData* JobPool::Slot::AllocateTask()
 {
+    const auto blockIndex = Used / BlockSize;
+    if (blockIndex >= Blocks.size())
+    {
+        Blocks.push_back(std::make_unique<TaskData[]>(BlockSize));
+    }
+    auto* result = &Blocks[blockIndex][Used % BlockSize];
+    Used++;
+    return result;
 }
 
-JobPool::JobPool(size_t maxThreads)
+JobPool::JobPool(size_t maxThreads, std::string_view threadName, std::vector<int32_t> threadCores)
+    : _threadName(threadName)
+    , _threadCores(std::move(threadCores))
 {
     maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
+    for (size_t n = 0; n <= maxThreads; n++)
+    {
+        _slots.push_back(std::make_unique<Slot>());
+    }
     for (size_t n = 0; n < maxThreads; n++)
     {
-        _threads.emplace_back(&JobPool::ProcessQueue, this);
+        _threads.emplace_back(&JobPool::ProcessQueue, this, n + 1);
     }
+    OpenRCT2::PerformanceCounters::AddJobWorkers(static_cast<int32_t>(_threads.size()));
 }
 
 JobPool::~JobPool()
 {
     {
-        unique_lock lock(_mutex);
+        unique_lock lock(_pendingMutex);
         _shouldStop = true;
-        _condPending.notify_all();
     }
+    _condPending.notify_all();
 
     for (auto& th : _threads)
     {
         assert(th.joinable() != false);
         th.join();
     }
+    OpenRCT2::PerformanceCounters::AddJobWorkers(-static_cast<int32_t>(_threads.size()));
 }
 
 void JobPool::AddTask(std::function<void()> workFn, std::function<void()> completionFn)
 {
-    unique_lock lock(_mutex);
-    _pending.emplace_back(workFn, completionFn);
-    _condPending.notify_one();
+    auto& slot = GetCurrentSlot();
+    auto* task = slot.AllocateTask();
+    task->WorkFn = std::move(workFn);
+    task->CompletionFn = std::move(completionFn);
+
+    _pending++;
+    slot.Queue.Push(task);
+
+    // Pairs with the fence in ProcessQueue so either the worker sees the task or we see the sleeping worker.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping > 0)
+    {
+        unique_lock lock(_pendingMutex);
+        _condPending.notify_one();
+    }
 }
 
 void JobPool::Join(std::function<void()> reportFn)
 {
-    unique_lock lock(_mutex);
+    assert(_currentPool != this);
     while (true)
     {
-        // Wait for the queue to become empty or having completed tasks.
-        _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
-
-        // Dispatch all completion callbacks if there are any.
-        while (!_completed.empty())
+        // Help out with the remaining work instead of only waiting for it.
+        const size_t finished = _finished;
+        auto* task = FindTask(0);
+        if (task != nullptr)
         {
-            auto taskData = _completed.front();
-            _completed.pop_front();
-
-            if (taskData.CompletionFn)
-            {
-                lock.unlock();
-
-                taskData.CompletionFn();
-
-                lock.lock();
-            }
+            RunTask(task);
         }
 
+        DispatchCompletions();
+
         if (reportFn)
         {
-            lock.unlock();
-
             reportFn();
-
-            lock.lock();
         }
 
         // If everything is empty and no more work has to be done we can stop waiting.
-        if (_completed.empty() && _pending.empty() && _processing == 0)
+        if (_pending == 0)
         {
+            DispatchCompletions();
             break;
         }
+
+        if (task == nullptr)
+        {
+            // Nothing left to steal, wait for the workers to finish their current tasks.
+            unique_lock lock(_completeMutex);
+            _joinWaiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _condComplete.wait(lock, [this, finished]() { return _finished != finished || HasQueuedTasks(); });
+            _joinWaiting = false;
+        }
+    }
+
+    // All tasks are done, task storage can be reused for the next batch.
+    for (auto& slot : _slots)
+    {
+        slot->Used = 0;
     }
 }
 
 size_t JobPool::CountPending()
 {
-    return _pending.size();
+    size_t count = 0;
+    for (const auto& slot : _slots)
+    {
+        count += slot->Queue.GetCount();
+    }
+    return count;
 }
 
-void JobPool::ProcessQueue()
+JobPool::Slot& JobPool::GetCurrentSlot()
 {
-    unique_lock lock(_mutex);
-    do
+    if (_currentPool == this)
     {
-        // Wait for work or cancellation.
-        _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
+        return *_slots[_currentSlot];
+    }
+    return *_slots[0];
+}
+
+JobPool::TaskData* JobPool::FindTask(size_t slotIndex)
+{
+    auto* task = _slots[slotIndex]->Queue.Take();
+    if (task != nullptr)
+    {
+        return task;
+    }
 
-        if (!_pending.empty())
+    const auto slotCount = _slots.size();
+    for (size_t i = 1; i < slotCount; i++)
+    {
+        task = _slots[(slotIndex + i) % slotCount]->Queue.Steal();
+        if (task != nullptr)
         {
-            _processing++;
+            return task;
+        }
+    }
+    return nullptr;
+}
 
-            auto taskData = _pending.front();
-            _pending.pop_front();
+bool JobPool::HasQueuedTasks() const
+{
+    return std::any_of(_slots.begin(), _slots.end(), [](const auto& slot) { return !slot->Queue.IsEmpty(); });
+}
 
-            lock.unlock();
+void JobPool::RunTask(TaskData* task)
+{
+    const auto start = std::chrono::steady_clock::now();
+    task->WorkFn();
+    task->WorkFn = nullptr;
+    OpenRCT2::PerformanceCounters::AddJobTime(std::chrono::steady_clock::now() - start);
 
-            taskData.WorkFn();
+    if (task->CompletionFn)
+    {
+        std::lock_guard<std::mutex> lock(_completedMutex);
+        _completed.push_back(task);
+    }
 
-            lock.lock();
+    _pending--;
+    _finished++;
+    if (_joinWaiting)
+    {
+        unique_lock lock(_completeMutex);
+        _condComplete.notify_one();
+    }
+}
 
-            _completed.push_back(std::move(taskData));
+void JobPool::DispatchCompletions()
+{
+    std::vector<TaskData*> completed;
+    {
+        std::lock_guard<std::mutex> lock(_completedMutex);
+        if (_completed.empty())
+        {
+            return;
+        }
+        completed.swap(_completed);
+    }
+
+    for (auto* task : completed)
+    {
+        task->CompletionFn();
+        task->CompletionFn = nullptr;
+    }
+}
+
+void JobPool::ProcessQueue(size_t slotIndex)
+{
+    _currentPool = this;
+    _currentSlot = slotIndex;
 
-            _processing--;
-            _condComplete.notify_one();
+    // Threads may start out with the cores and priority of the thread that created them, which is often the game
+    // thread.
+    Platform::SetCurrentThreadName(String::StdFormat("%s %zu", _threadName.c_str(), slotIndex));
+    Platform::SetCurrentThreadAffinity(_threadCores);
+    Platform::SetCurrentThreadPriority(ThreadPriority::Normal);
+
+    while (!_shouldStop)
+    {
+        auto* task = FindTask(slotIndex);
+        if (task != nullptr)
+        {
+            RunTask(task);
+            continue;
         }
-    } while (!_shouldStop);
+
+        // Wait for work or cancellation.
+        unique_lock lock(_pendingMutex);
+        _sleeping++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        _condPending.wait(lock, [this]() { return _shouldStop || HasQueuedTasks(); });
+        _sleeping--;
+    }
+
+    _currentPool = nullptr;
 }
@@ -9,38 +9,74 @@
 
 #pragma once
 
+#include "WorkStealingDeque.h"
+
 #include <atomic>
 #include <condition_variable>
-#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+/**
+ * Work stealing thread pool.
+ * Every worker owns a deque, tasks added by the thread owning the pool go into a
+ * separate submission deque that the workers steal from. Join runs pending tasks
+ * on the calling thread while waiting. AddTask and Join must be called from the
+ * thread that owns the pool or from within a task.
+ */
 class JobPool
 {
 private:
     struct TaskData
     {
-        const std::function<void()> WorkFn;
-        const std::function<void()> CompletionFn;
+        std::function<void()> WorkFn;
+        std::function<void()> CompletionFn;
+    };
+
+    /**
+     * Deque and task storage owned by a single thread. Task storage is reused
+     * once the pool is joined so steady state submission does not allocate.
+     */
+    struct Slot
+    {
+        static constexpr size_t BlockSize = 256;
+
+        WorkStealingDeque<TaskData*> Queue;
+        std::vector<std::unique_ptr<TaskData[]>> Blocks;
+        size_t Used{};
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn);
+        TaskData* AllocateTask();
     };
 
     std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
+    std::atomic<size_t> _pending = { 0 };
+    std::atomic<size_t> _finished = { 0 };
+    std::atomic<size_t> _sleeping = { 0 };
+    std::atomic_bool _joinWaiting = { false };
     std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
-    std::deque<TaskData> _completed;
+    std::string _threadName;
+    std::vector<int32_t> _threadCores;
+    // Slot 0 is the submission slot of the owning thread, the rest belong to the workers.
+    std::vector<std::unique_ptr<Slot>> _slots;
+    std::vector<TaskData*> _completed;
+    std::mutex _completedMutex;
     std::condition_variable _condPending;
+    std::mutex _pendingMutex;
     std::condition_variable _condComplete;
-    std::mutex _mutex;
+    std::mutex _completeMutex;
 
     using unique_lock = std::unique_lock<std::mutex>;
 
 public:
-    JobPool(size_t maxThreads = 255);
+    /**
+     * @param threadName the workers are named after it, followed by their number.
+     * @param threadCores the cores the workers are confined to, empty for all of them.
+     */
+    JobPool(size_t maxThreads = 255, std::string_view threadName = "Worker", std::vector<int32_t> threadCores = {});
     ~JobPool();
 
     void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr);
@@ -48,5 +84,10 @@ public:
     size_t CountPending();
 
 private:
-    void ProcessQueue();
+    Slot& GetCurrentSlot();
+    TaskData* FindTask(size_t slotIndex);
+    bool HasQueuedTasks() const;
+    void RunTask(TaskData* task);
+    void DispatchCompletions();
+    void ProcessQueue(size_t slotIndex);
 };
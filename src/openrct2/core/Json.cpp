@@ -13,9 +13,28 @@
 #include "Memory.hpp"
 #include "String.hpp"
 
+#include <algorithm>
+
 namespace Json
 {
-    json_t ReadFromFile(const utf8* path, size_t maxSize)
+    /**
+     * Creates a parser callback that drops the given members of the root object. Returning false for every event inside
+     * a dropped member, rather than just for its key, stops nlohmann from building and then discarding its children.
+     */
+    static json_t::parser_callback_t CreateSkipKeysCallback(std::initializer_list<std::string_view> skipKeys)
+    {
+        return [skipKeys, skipping = false](int depth, json_t::parse_event_t event, json_t& parsed) mutable {
+            if (depth == 1 && event == json_t::parse_event_t::key)
+            {
+                const auto& key = parsed.get_ref<const std::string&>();
+                skipping = std::find(skipKeys.begin(), skipKeys.end(), key) != skipKeys.end();
+                return !skipping;
+            }
+            return !skipping || depth == 0;
+        };
+    }
+
+    static std::string ReadFileData(const utf8* path, size_t maxSize)
     {
         auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
 
@@ -27,6 +46,12 @@ namespace Json
 
         auto fileData = std::string(static_cast<size_t>(fileLength) + 1, '\0');
         fs.Read(static_cast<void*>(fileData.data()), fileLength);
+        return fileData;
+    }
+
+    json_t ReadFromFile(const utf8* path, size_t maxSize)
+    {
+        auto fileData = ReadFileData(path, maxSize);
 
         json_t json;
 
@@ -48,6 +73,24 @@ namespace Json
         return ReadFromFile(path8.c_str(), maxSize);
     }
 
+    json_t ReadFromFile(const utf8* path, std::initializer_list<std::string_view> skipKeys, size_t maxSize)
+    {
+        auto fileData = ReadFileData(path, maxSize);
+
+        json_t json;
+
+        try
+        {
+            json = json_t::parse(fileData, CreateSkipKeysCallback(skipKeys));
+        }
+        catch (const json_t::exception& e)
+        {
+            throw JsonException(String::Format("Unable to parse JSON file (%s)\n\t%s", path, e.what()));
+        }
+
+        return json;
+    }
+
     void WriteToFile(const utf8* path, const json_t& jsonData, int indentSize)
     {
         // Serialise JSON
@@ -96,6 +139,22 @@ namespace Json
         return json;
     }
 
+    json_t FromVector(const std::vector<uint8_t>& vec, std::initializer_list<std::string_view> skipKeys)
+    {
+        json_t json;
+
+        try
+        {
+            json = json_t::parse(vec.begin(), vec.end(), CreateSkipKeysCallback(skipKeys));
+        }
+        catch (const json_t::exception& e)
+        {
+            log_error("Unable to parse JSON vector (%s)\n\t%s", vec.data(), e.what());
+        }
+
+        return json;
+    }
+
     std::string GetString(const json_t& jsonObj, const std::string& defaultValue)
     {
         return jsonObj.is_string() ? jsonObj.get<std::string>() : defaultValue;
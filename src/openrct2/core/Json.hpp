@@ -37,6 +37,16 @@ namespace Json
     json_t ReadFromFile(const utf8* path, size_t maxSize = MAX_JSON_SIZE);
     json_t ReadFromFile(const fs::path& path, size_t maxSize = MAX_JSON_SIZE);
 
+    /**
+     * Read JSON file and parse contents, leaving out the given members of the root object
+     * @param path Path to the source file
+     * @param skipKeys Members of the root object to leave out, they are still validated but no nodes are built for them
+     * @param maxSize Max file size in bytes allowed
+     * @return A JSON representation of the file
+     * @note This function will throw an exception if the JSON file cannot be parsed
+     */
+    json_t ReadFromFile(const utf8* path, std::initializer_list<std::string_view> skipKeys, size_t maxSize = MAX_JSON_SIZE);
+
     /**
      * Read JSON file and parse the contents
      * @param path Path to the destination file
@@ -62,6 +72,15 @@ namespace Json
      */
     json_t FromVector(const std::vector<uint8_t>& vec);
 
+    /**
+     * Parse JSON from a vector of characters, leaving out the given members of the root object
+     * @param vec Vector of characters containing JSON
+     * @param skipKeys Members of the root object to leave out, they are still validated but no nodes are built for them
+     * @return A JSON representation of the vector
+     * @note This function will throw an exception if the JSON vector cannot be parsed
+     */
+    json_t FromVector(const std::vector<uint8_t>& vec, std::initializer_list<std::string_view> skipKeys);
+
     /**
      * Explicit type conversion between a JSON object and a compatible number value
      * @param T Destination numeric type
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "LargePageAllocator.h"
+
+#include "../Diagnostic.h"
+#include "../platform/Platform2.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace OpenRCT2::LargePages
+{
+    struct Mapping
+    {
+        size_t Size{};
+        LargePageKind Kind{};
+    };
+
+    static std::mutex _mutex;
+    static bool _enabled = false;
+    static bool _fallbackReported = false;
+    static Stats _stats;
+    // Allocations that were mapped rather than taken from the heap, only large allocations ever end up in here.
+    static std::unordered_map<void*, Mapping> _mappings;
+
+    static void AddStats(size_t size, LargePageKind kind, bool add)
+    {
+        auto* bytes = &_stats.FallbackBytes;
+        if (kind == LargePageKind::Explicit)
+            bytes = &_stats.ExplicitBytes;
+        else if (kind == LargePageKind::Transparent)
+            bytes = &_stats.TransparentBytes;
+
+        if (add)
+            *bytes += size;
+        else
+            *bytes -= size;
+    }
+
+    void Initialise(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _enabled = false;
+        _stats.PageSize = 0;
+        if (!enabled)
+        {
+            log_verbose("Large pages are disabled.");
+            return;
+        }
+
+        auto pageSize = Platform::InitialiseLargePages();
+        if (pageSize == 0)
+        {
+            log_info("Large pages are enabled but not supported by this system, using regular pages.");
+            return;
+        }
+
+        _enabled = true;
+        _stats.PageSize = pageSize;
+        log_info("Large pages are enabled, backing the map and entities with %zu KiB pages.", pageSize / 1024);
+    }
+
+    bool IsEnabled()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _enabled;
+    }
+
+    void* Allocate(size_t size)
+    {
+        if (size >= MinAllocationSize)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_enabled)
+            {
+                const auto mappedSize = (size + _stats.PageSize - 1) / _stats.PageSize * _stats.PageSize;
+                auto kind = LargePageKind::None;
+                auto* ptr = Platform::AllocateLargePages(mappedSize, kind);
+                if ((ptr == nullptr || kind == LargePageKind::None) && !_fallbackReported)
+                {
+                    log_warning("No large pages available for %zu bytes, falling back to regular pages.", size);
+                    _fallbackReported = true;
+                }
+                if (ptr != nullptr)
+                {
+                    _mappings[ptr] = { mappedSize, kind };
+                    AddStats(mappedSize, kind, true);
+                    return ptr;
+                }
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void Free(void* ptr, size_t size)
+    {
+        if (ptr == nullptr)
+            return;
+
+        if (size >= MinAllocationSize)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _mappings.find(ptr);
+            if (it != _mappings.end())
+            {
+                Platform::FreeLargePages(ptr, it->second.Size);
+                AddStats(it->second.Size, it->second.Kind, false);
+                _mappings.erase(it);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+    Stats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _stats;
+    }
+} // namespace OpenRCT2::LargePages
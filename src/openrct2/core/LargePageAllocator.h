@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+ * Memory for large arrays that are accessed all over, such as the tile elements and the entities. Backing them with
+ * large pages means far fewer TLB misses. Large pages are only used once enabled by general.large_pages, anything
+ * allocated before that or where the system has no large pages to give comes from the heap as usual.
+ */
+namespace OpenRCT2::LargePages
+{
+    // Smaller allocations would waste most of a large page.
+    constexpr size_t MinAllocationSize = 1024 * 1024;
+
+    struct Stats
+    {
+        // Size of a large page, 0 if large pages are disabled or the system has none.
+        size_t PageSize{};
+        // Bytes in explicitly reserved large pages, e.g. hugetlbfs on Linux or large pages on Windows.
+        size_t ExplicitBytes{};
+        // Bytes the kernel has been advised to back with transparent huge pages.
+        size_t TransparentBytes{};
+        // Bytes that were meant for large pages but got regular pages.
+        size_t FallbackBytes{};
+    };
+
+    /**
+     * Enables or disables large pages for the allocations that follow and reports what the system supports. Must be
+     * called once the configuration has been loaded.
+     */
+    void Initialise(bool enabled);
+
+    bool IsEnabled();
+
+    /**
+     * @return memory aligned for any type, throws std::bad_alloc if there is none.
+     */
+    void* Allocate(size_t size);
+
+    /**
+     * Frees memory from Allocate, size must be the size that was allocated.
+     */
+    void Free(void* ptr, size_t size);
+
+    Stats GetStats();
+} // namespace OpenRCT2::LargePages
+
+namespace OpenRCT2
+{
+    /**
+     * Allocator for containers whose storage should be backed by large pages.
+     */
+    template<typename T> class LargePageAllocator
+    {
+    public:
+        using value_type = T;
+
+        LargePageAllocator() = default;
+
+        template<typename U> LargePageAllocator(const LargePageAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(LargePages::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            LargePages::Free(ptr, n * sizeof(T));
+        }
+
+        template<typename U> bool operator==(const LargePageAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+
+        template<typename U> bool operator!=(const LargePageAllocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+} // namespace OpenRCT2
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MappedFile.h"
+
+#include "IStream.hpp"
+#include "String.hpp"
+
+#include <string>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenRCT2
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(std::string_view path)
+    {
+        auto pathW = String::ToWideChar(path);
+        auto file = CreateFileW(
+            pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw IOException("Unable to open " + std::string(path));
+        }
+        _fileHandle = file;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            Close();
+            throw IOException("Unable to get size of " + std::string(path));
+        }
+        _length = static_cast<size_t>(fileSize.QuadPart);
+        if (_length == 0)
+        {
+            // Empty files can not be mapped, there is nothing to read anyway.
+            return;
+        }
+
+        _mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mappingHandle == nullptr)
+        {
+            Close();
+            throw IOException("Unable to map " + std::string(path));
+        }
+        _data = static_cast<const uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (_data == nullptr)
+        {
+            Close();
+            throw IOException("Unable to map " + std::string(path));
+        }
+    }
+
+    void MappedFile::Close()
+    {
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+            _data = nullptr;
+        }
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+            _mappingHandle = nullptr;
+        }
+        if (_fileHandle != nullptr)
+        {
+            CloseHandle(_fileHandle);
+            _fileHandle = nullptr;
+        }
+        _length = 0;
+    }
+#else
+    MappedFile::MappedFile(std::string_view path)
+    {
+        auto pathStr = std::string(path);
+        auto fd = open(pathStr.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            throw IOException("Unable to open " + pathStr);
+        }
+
+        struct stat statInfo
+        {
+        };
+        if (fstat(fd, &statInfo) != 0)
+        {
+            close(fd);
+            throw IOException("Unable to get size of " + pathStr);
+        }
+        _length = static_cast<size_t>(statInfo.st_size);
+        if (_length == 0)
+        {
+            // Empty files can not be mapped, there is nothing to read anyway.
+            close(fd);
+            return;
+        }
+
+        auto data = mmap(nullptr, _length, PROT_READ, MAP_SHARED, fd, 0);
+        // The mapping keeps its own reference to the file.
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            _length = 0;
+            throw IOException("Unable to map " + pathStr);
+        }
+        _data = static_cast<const uint8_t*>(data);
+    }
+
+    void MappedFile::Close()
+    {
+        if (_data != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(_data), _length);
+            _data = nullptr;
+        }
+        _length = 0;
+    }
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+} // namespace OpenRCT2
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace OpenRCT2
+{
+    /**
+     * Read only view of a whole file mapped into memory. Pages are only read from disk when they are first touched and
+     * are shared with every other process mapping the same file.
+     */
+    class MappedFile final
+    {
+    private:
+        const uint8_t* _data = nullptr;
+        size_t _length = 0;
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+
+    public:
+        /**
+         * Maps the file at the given path, throws IOException if it can not be opened or mapped.
+         */
+        explicit MappedFile(std::string_view path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        const uint8_t* GetData() const
+        {
+            return _data;
+        }
+
+        size_t GetLength() const
+        {
+            return _length;
+        }
+
+    private:
+        void Close();
+    };
+} // namespace OpenRCT2
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryAccounting.h"
+
+#include "../Diagnostic.h"
+#include "../config/Config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace OpenRCT2::MemoryAccounting
+{
+    struct Provider
+    {
+        std::string Name;
+        SizeFunc GetSize;
+    };
+
+    struct Registry
+    {
+        std::mutex Mutex;
+        std::map<uint32_t, Provider> Providers;
+        uint32_t NextId = 1;
+    };
+
+    static Registry& GetRegistry()
+    {
+        // Constructed on first use as registrations may happen during static initialisation.
+        static Registry registry;
+        return registry;
+    }
+
+    Registration::Registration(std::string_view name, SizeFunc sizeFunc)
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+        _id = registry.NextId++;
+        registry.Providers.emplace(_id, Provider{ std::string(name), std::move(sizeFunc) });
+    }
+
+    Registration::Registration(Registration&& other) noexcept
+        : _id(std::exchange(other._id, 0))
+    {
+    }
+
+    Registration& Registration::operator=(Registration&& other) noexcept
+    {
+        if (this != &other)
+        {
+            this->~Registration();
+            _id = std::exchange(other._id, 0);
+        }
+        return *this;
+    }
+
+    Registration::~Registration()
+    {
+        if (_id != 0)
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+            registry.Providers.erase(_id);
+            _id = 0;
+        }
+    }
+
+    std::vector<Entry> Query()
+    {
+        std::vector<Entry> result;
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+            for (const auto& [id, provider] : registry.Providers)
+            {
+                auto bytes = provider.GetSize();
+                auto it = std::find_if(
+                    result.begin(), result.end(), [&provider](const Entry& entry) { return entry.Name == provider.Name; });
+                if (it != result.end())
+                {
+                    it->Bytes += bytes;
+                }
+                else
+                {
+                    result.push_back({ provider.Name, bytes });
+                }
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) {
+            return a.Bytes != b.Bytes ? a.Bytes > b.Bytes : a.Name < b.Name;
+        });
+        return result;
+    }
+
+    size_t GetTotal(const std::vector<Entry>& entries)
+    {
+        size_t total = 0;
+        for (const auto& entry : entries)
+        {
+            total += entry.Bytes;
+        }
+        return total;
+    }
+
+    void Update()
+    {
+        using Clock = std::chrono::steady_clock;
+        static Clock::time_point lastLog = Clock::now();
+
+        const auto interval = gConfigGeneral.memory_stats_log_interval;
+        if (interval <= 0)
+            return;
+
+        const auto now = Clock::now();
+        if (now - lastLog < std::chrono::seconds(interval))
+            return;
+        lastLog = now;
+
+        auto entries = Query();
+        std::string line = "Memory: total " + std::to_string(GetTotal(entries) / 1024) + " KiB";
+        for (const auto& entry : entries)
+        {
+            line += ", " + entry.Name + " " + std::to_string(entry.Bytes / 1024) + " KiB";
+        }
+        log_info("%s", line.c_str());
+    }
+} // namespace OpenRCT2::MemoryAccounting
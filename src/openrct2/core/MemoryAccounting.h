@@ -0,0 +1,62 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Registry of the larger memory consumers. Every subsystem registers a function returning the bytes it currently holds,
+ * the functions are only called when the stats are queried, so this adds nothing to allocation paths.
+ */
+namespace OpenRCT2::MemoryAccounting
+{
+    using SizeFunc = std::function<size_t()>;
+
+    struct Entry
+    {
+        std::string Name;
+        size_t Bytes{};
+    };
+
+    /**
+     * Keeps a size function registered for the lifetime of the object. Registrations with the same name are summed.
+     */
+    class Registration
+    {
+        uint32_t _id{};
+
+    public:
+        Registration() = default;
+        Registration(std::string_view name, SizeFunc sizeFunc);
+        Registration(const Registration&) = delete;
+        Registration(Registration&& other) noexcept;
+        Registration& operator=(const Registration&) = delete;
+        Registration& operator=(Registration&& other) noexcept;
+        ~Registration();
+    };
+
+    /**
+     * Calls every registered size function, must be called from the game thread.
+     * @return The entries sorted by descending size.
+     */
+    std::vector<Entry> Query();
+
+    size_t GetTotal(const std::vector<Entry>& entries);
+
+    /**
+     * Writes the stats as a single log line when general.memory_stats_log_interval seconds have passed since the last.
+     */
+    void Update();
+} // namespace OpenRCT2::MemoryAccounting
@@ -24,22 +24,25 @@ namespace OpenRCT2
 
         if (_access & MEMORY_ACCESS::OWNER)
         {
-            _data = Memory::Allocate<void>(_dataCapacity);
-            std::memcpy(_data, copy._data, _dataCapacity);
+            _buffer = copy._buffer;
+            _data = _buffer.data();
             _position = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_data) + copy.GetPosition());
         }
+        else
+        {
+            _data = copy._data;
+            _position = copy._position;
+        }
     }
 
     MemoryStream::MemoryStream(size_t capacity)
     {
-        _dataCapacity = capacity;
-        _data = Memory::Allocate<void>(capacity);
-        _position = _data;
+        Reserve(capacity);
     }
 
     MemoryStream::MemoryStream(void* data, size_t dataSize, uint8_t access)
     {
-        _access = access;
+        _access = access & ~MEMORY_ACCESS::OWNER;
         _dataCapacity = dataSize;
         _dataSize = dataSize;
         _data = data;
@@ -52,19 +55,19 @@ namespace OpenRCT2
     }
 
     MemoryStream::MemoryStream(std::vector<uint8_t>&& v)
+        : _dataCapacity(v.size())
+        , _dataSize(v.size())
+        , _buffer(std::move(v))
     {
-        _access = MEMORY_ACCESS::OWNER;
-        _dataCapacity = v.size();
-        _dataSize = v.size();
-        _data = Memory::Allocate<void>(v.size());
+        _data = _buffer.data();
         _position = _data;
-        std::memcpy(_data, v.data(), v.size());
     }
 
     MemoryStream::MemoryStream(MemoryStream&& mv) noexcept
         : _access(mv._access)
         , _dataCapacity(mv._dataCapacity)
         , _dataSize(mv._dataSize)
+        , _buffer(std::move(mv._buffer))
         , _data(mv._data)
         , _position(mv._position)
     {
@@ -76,10 +79,6 @@ namespace OpenRCT2
 
     MemoryStream::~MemoryStream()
     {
-        if (_access & MEMORY_ACCESS::OWNER)
-        {
-            Memory::Free(_data);
-        }
         _dataCapacity = 0;
         _dataSize = 0;
         _data = nullptr;
@@ -91,6 +90,7 @@ namespace OpenRCT2
         {
             _access = mv._access;
             _dataCapacity = mv._dataCapacity;
+            _buffer = std::move(mv._buffer);
             _data = mv._data;
             _dataSize = mv._dataSize;
             _position = mv._position;
@@ -116,10 +116,42 @@ namespace OpenRCT2
         return result;
     }
 
-    void* MemoryStream::TakeData()
+    std::vector<uint8_t> MemoryStream::TakeBuffer()
     {
-        _access &= ~MEMORY_ACCESS::OWNER;
-        return _data;
+        std::vector<uint8_t> result;
+        if (_access & MEMORY_ACCESS::OWNER)
+        {
+            // Shrinking the size keeps the allocation, the unused capacity goes along with the data.
+            _buffer.resize(_dataSize);
+            result = std::move(_buffer);
+            _buffer = {};
+            _dataCapacity = 0;
+            _dataSize = 0;
+            _data = nullptr;
+            _position = nullptr;
+        }
+        else
+        {
+            const auto* data = static_cast<const uint8_t*>(_data);
+            result.assign(data, data + _dataSize);
+        }
+        return result;
+    }
+
+    void MemoryStream::Reserve(size_t capacity)
+    {
+        if (!(_access & MEMORY_ACCESS::OWNER))
+        {
+            throw IOException("Unable to resize a borrowed buffer.");
+        }
+        if (_dataCapacity < capacity)
+        {
+            uint64_t position = GetPosition();
+            _dataCapacity = capacity;
+            _buffer.resize(_dataCapacity);
+            _data = _buffer.data();
+            _position = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_data) + static_cast<uintptr_t>(position));
+        }
     }
 
     bool MemoryStream::CanRead() const
@@ -220,16 +252,9 @@ namespace OpenRCT2
     {
         uint64_t position = GetPosition();
         uint64_t nextPosition = position + length;
-        if (nextPosition > _dataCapacity)
+        if (nextPosition > _dataCapacity || !(_access & MEMORY_ACCESS::WRITE))
         {
-            if (_access & MEMORY_ACCESS::OWNER)
-            {
-                EnsureCapacity(static_cast<size_t>(nextPosition));
-            }
-            else
-            {
-                throw IOException("Attempted to write past end of stream.");
-            }
+            PrepareWrite(static_cast<size_t>(nextPosition));
         }
 
         std::memcpy(_position, buffer, length);
@@ -277,12 +302,21 @@ namespace OpenRCT2
             {
                 newCapacity *= 2;
             }
+            Reserve(newCapacity);
+        }
+    }
 
-            uint64_t position = GetPosition();
-            _dataCapacity = newCapacity;
-            _data = Memory::Reallocate(_data, _dataCapacity);
-            _position = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(_data) + static_cast<uintptr_t>(position));
+    void MemoryStream::PrepareWrite(size_t nextPosition)
+    {
+        if (!(_access & MEMORY_ACCESS::WRITE))
+        {
+            throw IOException("Attempted to write to a read only stream.");
+        }
+        if (!(_access & MEMORY_ACCESS::OWNER))
+        {
+            throw IOException("Attempted to write past end of stream.");
         }
+        EnsureCapacity(nextPosition);
     }
 
 } // namespace OpenRCT2
@@ -25,6 +25,8 @@ namespace OpenRCT2
 
     /**
      * A stream for reading and writing to a buffer in memory. By default this buffer can grow.
+     * Constructing the stream from a pointer borrows the memory instead, a read only view can be used to read a mapped
+     * file or a network chunk without copying it first.
      */
     class MemoryStream final : public IStream
     {
@@ -32,6 +34,8 @@ namespace OpenRCT2
         uint8_t _access = MEMORY_ACCESS::READ | MEMORY_ACCESS::WRITE | MEMORY_ACCESS::OWNER;
         size_t _dataCapacity = 0;
         size_t _dataSize = 0;
+        // Storage when the stream owns its memory, _data points into it.
+        std::vector<uint8_t> _buffer;
         void* _data = nullptr;
         void* _position = nullptr;
 
@@ -42,6 +46,9 @@ namespace OpenRCT2
         explicit MemoryStream(size_t capacity);
         MemoryStream(void* data, size_t dataSize, uint8_t access = MEMORY_ACCESS::READ);
         MemoryStream(const void* data, size_t dataSize);
+        /**
+         * Takes over the vector without copying it.
+         */
         MemoryStream(std::vector<uint8_t>&& v);
         virtual ~MemoryStream();
 
@@ -49,7 +56,18 @@ namespace OpenRCT2
 
         const void* GetData() const override;
         void* GetDataCopy() const;
-        void* TakeData();
+
+        /**
+         * Moves the written data out of the stream without copying it and leaves the stream empty.
+         * A stream that borrows its memory returns a copy instead.
+         */
+        std::vector<uint8_t> TakeBuffer();
+
+        /**
+         * Grows the buffer to hold at least the given number of bytes, avoids growing repeatedly when the size of
+         * the data to write is known up front.
+         */
+        void Reserve(size_t capacity);
 
         ///////////////////////////////////////////////////////////////////////////
         // ISteam methods
@@ -92,16 +110,9 @@ namespace OpenRCT2
         {
             uint64_t position = GetPosition();
             uint64_t nextPosition = position + N;
-            if (nextPosition > _dataCapacity)
+            if (nextPosition > _dataCapacity || !(_access & MEMORY_ACCESS::WRITE))
             {
-                if (_access & MEMORY_ACCESS::OWNER)
-                {
-                    EnsureCapacity(static_cast<size_t>(nextPosition));
-                }
-                else
-                {
-                    throw IOException("Attempted to write past end of stream.");
-                }
+                PrepareWrite(static_cast<size_t>(nextPosition));
             }
 
             std::memcpy(_position, buffer, N);
@@ -115,6 +126,7 @@ namespace OpenRCT2
 
     private:
         void EnsureCapacity(size_t capacity);
+        void PrepareWrite(size_t nextPosition);
     };
 
 } // namespace OpenRCT2
@@ -13,15 +13,24 @@
 #include "Crypt.h"
 #include "FileStream.h"
 #include "Identifier.hpp"
+#include "JobPool.h"
 #include "MemoryStream.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stack>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace OpenRCT2
@@ -37,6 +46,9 @@ namespace OpenRCT2
 
         static constexpr uint32_t COMPRESSION_NONE = 0;
         static constexpr uint32_t COMPRESSION_GZIP = 1;
+        // Every chunk is its own gzip stream so chunks can be compressed and uncompressed in parallel.
+        // The compressed data starts with a table of the compressed length of each chunk.
+        static constexpr uint32_t COMPRESSION_GZIP_CHUNKED = 2;
 
     private:
 #pragma pack(push, 1)
@@ -69,8 +81,33 @@ namespace OpenRCT2
         MemoryStream _buffer;
         ChunkEntry _currentChunk;
 
+        // Streams read per chunk keep every chunk in its own buffer, the stored data of chunk i is found at
+        // _chunkDataPosition + _chunkDataOffsets[i] in the stream.
+        bool _readPerChunk{};
+        uint64_t _chunkDataPosition{};
+        std::vector<uint64_t> _chunkDataOffsets;
+        std::vector<uint64_t> _chunkDataLengths;
+        std::vector<std::unique_ptr<MemoryStream>> _chunkBuffers;
+
+        // Once a chunk is written on another thread, every chunk is written into a buffer of its own until they are
+        // all appended to _buffer, in the order they were started.
+        struct PendingChunk
+        {
+            uint32_t Id{};
+            std::unique_ptr<MemoryStream> Buffer;
+        };
+        std::vector<PendingChunk> _pendingChunks;
+        std::unique_ptr<JobPool> _writeJobs;
+        std::exception_ptr _writeError;
+        std::mutex _writeErrorMutex;
+
     public:
-        OrcaStream(IStream& stream, const Mode mode)
+        /**
+         * @param readChunksOnDemand When reading a stream that is uncompressed or compressed per chunk, only read and
+         *                           uncompress each chunk once it is requested. The stream must then stay alive for
+         *                           as long as this does.
+         */
+        OrcaStream(IStream& stream, const Mode mode, const bool readChunksOnDemand = false)
         {
             _stream = &stream;
             _mode = mode;
@@ -85,8 +122,19 @@ namespace OpenRCT2
                     _chunks.push_back(entry);
                 }
 
+                if (_header.Compression == COMPRESSION_NONE || _header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    ReadChunkDataTable();
+                    if (!readChunksOnDemand)
+                    {
+                        LoadAllChunks();
+                    }
+                    return;
+                }
+
                 // Read compressed data into buffer (read in blocks)
                 _buffer = MemoryStream{};
+                _buffer.Reserve(static_cast<size_t>(_header.CompressedSize));
                 uint8_t temp[2048];
                 uint64_t bytesLeft = _header.CompressedSize;
                 do
@@ -105,8 +153,11 @@ namespace OpenRCT2
                     {
                         // Warning?
                     }
-                    _buffer.Clear();
-                    _buffer.Write(uncompressedData.data(), uncompressedData.size());
+                    _buffer = MemoryStream(std::move(uncompressedData));
+                }
+                else
+                {
+                    throw std::runtime_error("Unsupported compression.");
                 }
             }
             else
@@ -122,73 +173,150 @@ namespace OpenRCT2
 
         ~OrcaStream()
         {
-            if (_mode == Mode::WRITING)
+            if (_mode == Mode::WRITING && _stream != nullptr)
             {
-                const void* uncompressedData = _buffer.GetData();
-                const uint64_t uncompressedSize = _buffer.GetLength();
+                FinishWritingChunks();
+                WriteStream(*_stream, _header, _chunks, _buffer);
+            }
+        }
 
-                _header.NumChunks = static_cast<uint32_t>(_chunks.size());
-                _header.UncompressedSize = uncompressedSize;
-                _header.CompressedSize = uncompressedSize;
-                _header.FNV1a = Crypt::FNV1a(uncompressedData, uncompressedSize);
+        /**
+         * Takes the chunks written so far so compressing and writing them to the stream can happen later, the stream
+         * is then no longer written on destruction. The returned function may be called on any thread, the stream must
+         * stay alive until it has been called.
+         */
+        std::function<void()> DeferWrite()
+        {
+            if (_mode != Mode::WRITING || _stream == nullptr)
+            {
+                throw std::runtime_error("Incorrect mode");
+            }
+            FinishWritingChunks();
+            auto* stream = std::exchange(_stream, nullptr);
+            auto buffer = std::make_shared<MemoryStream>(std::move(_buffer));
+            return [stream, header = _header, chunks = std::move(_chunks), buffer]() {
+                WriteStream(*stream, header, chunks, *buffer);
+            };
+        }
 
-                // Compress data
-                std::optional<std::vector<uint8_t>> compressedBytes;
-                if (_header.Compression == COMPRESSION_GZIP)
+        Mode GetMode() const
+        {
+            return _mode;
+        }
+
+        Header& GetHeader()
+        {
+            return _header;
+        }
+
+        const Header& GetHeader() const
+        {
+            return _header;
+        }
+
+        /**
+         * Reads and uncompresses all chunks that have not been requested yet, chunks are uncompressed in parallel.
+         */
+        void LoadAllChunks()
+        {
+            if (!_readPerChunk)
+                return;
+
+            std::vector<std::vector<uint8_t>> chunkData(_chunks.size());
+            for (size_t i = 0; i < _chunks.size(); i++)
+            {
+                if (_chunkBuffers[i] == nullptr)
                 {
-                    compressedBytes = Gzip(uncompressedData, uncompressedSize);
-                    if (compressedBytes)
-                    {
-                        _header.CompressedSize = compressedBytes->size();
-                    }
-                    else
-                    {
-                        // Compression failed
-                        _header.Compression = COMPRESSION_NONE;
-                    }
+                    chunkData[i] = ReadChunkData(i);
                 }
+            }
 
-                // Write header and chunk table
-                _stream->WriteValue(_header);
-                for (const auto& chunk : _chunks)
+            if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+            {
+                std::atomic_bool failed = false;
                 {
-                    _stream->WriteValue(chunk);
+                    JobPool jobPool;
+                    for (size_t i = 0; i < _chunks.size(); i++)
+                    {
+                        if (_chunkBuffers[i] != nullptr)
+                            continue;
+
+                        jobPool.AddTask([&data = chunkData[i], length = _chunks[i].Length, &failed]() {
+                            try
+                            {
+                                data = UngzipChunk(data, length);
+                            }
+                            catch (const std::exception&)
+                            {
+                                failed = true;
+                            }
+                        });
+                    }
+                    jobPool.Join();
                 }
-
-                // Write chunk data
-                if (compressedBytes)
+                if (failed)
                 {
-                    _stream->Write(compressedBytes->data(), compressedBytes->size());
+                    throw std::runtime_error("Unable to uncompress chunk.");
                 }
-                else
+            }
+
+            for (size_t i = 0; i < _chunks.size(); i++)
+            {
+                if (_chunkBuffers[i] == nullptr)
                 {
-                    _stream->Write(uncompressedData, uncompressedSize);
+                    _chunkBuffers[i] = std::make_unique<MemoryStream>(std::move(chunkData[i]));
                 }
             }
         }
 
-        Mode GetMode() const
+        /**
+         * @return the ids of the chunks in the stream, in the order they are stored.
+         */
+        std::vector<uint32_t> GetChunkIds() const
         {
-            return _mode;
+            std::vector<uint32_t> result;
+            result.reserve(_chunks.size());
+            for (const auto& chunk : _chunks)
+            {
+                result.push_back(chunk.Id);
+            }
+            return result;
         }
 
-        Header& GetHeader()
+        bool HasChunk(const uint32_t chunkId) const
         {
-            return _header;
+            return std::any_of(_chunks.begin(), _chunks.end(), [chunkId](const ChunkEntry& e) { return e.Id == chunkId; });
         }
 
-        const Header& GetHeader() const
+        /**
+         * Reads the uncompressed data of a chunk as it is stored, so it can be stored in another stream unchanged.
+         */
+        std::optional<std::vector<uint8_t>> GetChunkData(const uint32_t chunkId)
         {
-            return _header;
+            if (_mode != Mode::READING)
+            {
+                throw std::runtime_error("Incorrect mode");
+            }
+
+            auto* buffer = SeekChunk(chunkId);
+            if (buffer == nullptr)
+            {
+                return std::nullopt;
+            }
+            const auto& chunk = *std::find_if(
+                _chunks.begin(), _chunks.end(), [chunkId](const ChunkEntry& e) { return e.Id == chunkId; });
+            const auto* data = static_cast<const uint8_t*>(buffer->GetData()) + buffer->GetPosition();
+            return std::vector<uint8_t>(data, data + chunk.Length);
         }
 
         template<typename TFunc> bool ReadWriteChunk(const uint32_t chunkId, TFunc f)
         {
             if (_mode == Mode::READING)
             {
-                if (SeekChunk(chunkId))
+                auto* buffer = SeekChunk(chunkId);
+                if (buffer != nullptr)
                 {
-                    ChunkStream stream(_buffer, _mode);
+                    ChunkStream stream(*buffer, _mode);
                     f(stream);
                     return true;
                 }
@@ -196,6 +324,16 @@ namespace OpenRCT2
                 return false;
             }
 
+            if (!_pendingChunks.empty())
+            {
+                auto& pending = _pendingChunks.emplace_back();
+                pending.Id = chunkId;
+                pending.Buffer = std::make_unique<MemoryStream>();
+                ChunkStream stream(*pending.Buffer, _mode);
+                f(stream);
+                return true;
+            }
+
             _currentChunk.Id = chunkId;
             _currentChunk.Offset = _buffer.GetPosition();
             _currentChunk.Length = 0;
@@ -206,17 +344,268 @@ namespace OpenRCT2
             return true;
         }
 
+        /**
+         * Writes a chunk on another thread while the following chunks are written. The chunk must only read state
+         * that is not changed until FinishWritingChunks returns, f is copied and must not refer to locals of the
+         * caller.
+         */
+        template<typename TFunc> void WriteChunkAsync(const uint32_t chunkId, TFunc f)
+        {
+            if (_mode != Mode::WRITING)
+            {
+                throw std::runtime_error("Incorrect mode");
+            }
+
+            auto& pending = _pendingChunks.emplace_back();
+            pending.Id = chunkId;
+            pending.Buffer = std::make_unique<MemoryStream>();
+            if (_writeJobs == nullptr)
+            {
+                _writeJobs = std::make_unique<JobPool>(255, "Park save");
+            }
+            _writeJobs->AddTask([this, buffer = pending.Buffer.get(), f]() mutable {
+                try
+                {
+                    ChunkStream stream(*buffer, Mode::WRITING);
+                    f(stream);
+                }
+                catch (const std::exception&)
+                {
+                    std::lock_guard<std::mutex> lock(_writeErrorMutex);
+                    if (_writeError == nullptr)
+                    {
+                        _writeError = std::current_exception();
+                    }
+                }
+            });
+        }
+
+        /**
+         * Waits for the chunks written on other threads and puts all chunks into the stream, in the order they were
+         * started. Rethrows the first error a chunk written on another thread ran into.
+         */
+        void FinishWritingChunks()
+        {
+            if (_writeJobs != nullptr)
+            {
+                _writeJobs->Join();
+                _writeJobs.reset();
+            }
+
+            auto pendingChunks = std::move(_pendingChunks);
+            _pendingChunks.clear();
+            if (auto error = std::exchange(_writeError, nullptr); error != nullptr)
+            {
+                std::rethrow_exception(error);
+            }
+
+            for (const auto& pending : pendingChunks)
+            {
+                ChunkEntry entry;
+                entry.Id = pending.Id;
+                entry.Offset = _buffer.GetPosition();
+                entry.Length = pending.Buffer->GetLength();
+                _buffer.Write(pending.Buffer->GetData(), static_cast<size_t>(entry.Length));
+                _chunks.push_back(entry);
+            }
+        }
+
     private:
-        bool SeekChunk(const uint32_t id)
+        static void WriteStream(
+            IStream& stream, Header header, const std::vector<ChunkEntry>& chunks, const MemoryStream& buffer)
+        {
+            const void* uncompressedData = buffer.GetData();
+            const uint64_t uncompressedSize = buffer.GetLength();
+
+            header.NumChunks = static_cast<uint32_t>(chunks.size());
+            header.UncompressedSize = uncompressedSize;
+            header.CompressedSize = uncompressedSize;
+            header.FNV1a = Crypt::FNV1a(uncompressedData, uncompressedSize);
+
+            // Compress data
+            std::optional<std::vector<uint8_t>> compressedBytes;
+            if (header.Compression == COMPRESSION_GZIP)
+            {
+                compressedBytes = Gzip(uncompressedData, uncompressedSize);
+                if (compressedBytes)
+                {
+                    header.CompressedSize = compressedBytes->size();
+                }
+                else
+                {
+                    // Compression failed
+                    header.Compression = COMPRESSION_NONE;
+                }
+            }
+            else if (header.Compression == COMPRESSION_GZIP_CHUNKED)
+            {
+                compressedBytes = GzipChunks(chunks, uncompressedData);
+                if (compressedBytes)
+                {
+                    header.CompressedSize = compressedBytes->size();
+                }
+                else
+                {
+                    // Compression failed
+                    header.Compression = COMPRESSION_NONE;
+                }
+            }
+
+            // Write header and chunk table
+            stream.WriteValue(header);
+            for (const auto& chunk : chunks)
+            {
+                stream.WriteValue(chunk);
+            }
+
+            // Write chunk data
+            if (compressedBytes)
+            {
+                stream.Write(compressedBytes->data(), compressedBytes->size());
+            }
+            else
+            {
+                stream.Write(uncompressedData, uncompressedSize);
+            }
+        }
+
+        static std::optional<std::vector<uint8_t>> GzipChunks(
+            const std::vector<ChunkEntry>& chunks, const void* uncompressedData)
+        {
+            const auto* src = static_cast<const uint8_t*>(uncompressedData);
+            std::vector<std::vector<uint8_t>> compressedChunks(chunks.size());
+            std::atomic_bool failed = false;
+            {
+                JobPool jobPool;
+                for (size_t i = 0; i < chunks.size(); i++)
+                {
+                    const auto& chunk = chunks[i];
+                    if (chunk.Length == 0)
+                        continue;
+
+                    auto& dst = compressedChunks[i];
+                    jobPool.AddTask([src, &chunk, &dst, &failed]() {
+                        try
+                        {
+                            dst = Gzip(src + chunk.Offset, static_cast<size_t>(chunk.Length));
+                        }
+                        catch (const std::exception&)
+                        {
+                            failed = true;
+                        }
+                    });
+                }
+                jobPool.Join();
+            }
+            if (failed)
+            {
+                return std::nullopt;
+            }
+
+            std::vector<uint8_t> result(chunks.size() * sizeof(uint64_t));
+            for (size_t i = 0; i < compressedChunks.size(); i++)
+            {
+                const uint64_t length = compressedChunks[i].size();
+                std::memcpy(result.data() + i * sizeof(uint64_t), &length, sizeof(length));
+                result.insert(result.end(), compressedChunks[i].begin(), compressedChunks[i].end());
+            }
+            return result;
+        }
+
+        void ReadChunkDataTable()
+        {
+            const auto numChunks = _chunks.size();
+            _readPerChunk = true;
+            _chunkDataOffsets.resize(numChunks);
+            _chunkDataLengths.resize(numChunks);
+            _chunkBuffers.resize(numChunks);
+
+            uint64_t dataOffset = 0;
+            if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+            {
+                dataOffset = numChunks * sizeof(uint64_t);
+                if (_header.CompressedSize < dataOffset)
+                {
+                    throw std::runtime_error("Chunk table is incomplete.");
+                }
+                for (size_t i = 0; i < numChunks; i++)
+                {
+                    _chunkDataLengths[i] = _stream->ReadValue<uint64_t>();
+                }
+            }
+            _chunkDataPosition = _stream->GetPosition() - dataOffset;
+
+            for (size_t i = 0; i < numChunks; i++)
+            {
+                const auto& chunk = _chunks[i];
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    _chunkDataOffsets[i] = dataOffset;
+                    dataOffset += _chunkDataLengths[i];
+                }
+                else
+                {
+                    _chunkDataOffsets[i] = chunk.Offset;
+                    _chunkDataLengths[i] = chunk.Length;
+                }
+
+                if (_chunkDataOffsets[i] > _header.CompressedSize
+                    || _chunkDataLengths[i] > _header.CompressedSize - _chunkDataOffsets[i])
+                {
+                    throw std::runtime_error("Chunk is out of bounds.");
+                }
+            }
+        }
+
+        std::vector<uint8_t> ReadChunkData(const size_t index)
+        {
+            std::vector<uint8_t> result(static_cast<size_t>(_chunkDataLengths[index]));
+            _stream->SetPosition(_chunkDataPosition + _chunkDataOffsets[index]);
+            _stream->Read(result.data(), result.size());
+            return result;
+        }
+
+        static std::vector<uint8_t> UngzipChunk(const std::vector<uint8_t>& compressedData, const uint64_t length)
+        {
+            if (length == 0)
+            {
+                return {};
+            }
+            auto result = Ungzip(compressedData.data(), compressedData.size());
+            if (result.size() != length)
+            {
+                throw std::runtime_error("Chunk has an unexpected length.");
+            }
+            return result;
+        }
+
+        MemoryStream* SeekChunk(const uint32_t id)
         {
             const auto result = std::find_if(_chunks.begin(), _chunks.end(), [id](const ChunkEntry& e) { return e.Id == id; });
-            if (result != _chunks.end())
+            if (result == _chunks.end())
             {
-                const auto offset = result->Offset;
-                _buffer.SetPosition(offset);
-                return true;
+                return nullptr;
+            }
+
+            if (!_readPerChunk)
+            {
+                _buffer.SetPosition(result->Offset);
+                return &_buffer;
+            }
+
+            const auto index = static_cast<size_t>(std::distance(_chunks.begin(), result));
+            auto& buffer = _chunkBuffers[index];
+            if (buffer == nullptr)
+            {
+                auto data = ReadChunkData(index);
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    data = UngzipChunk(data, result->Length);
+                }
+                buffer = std::make_unique<MemoryStream>(std::move(data));
             }
-            return false;
+            buffer->SetPosition(0);
+            return buffer.get();
         }
 
     public:
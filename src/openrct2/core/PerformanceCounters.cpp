@@ -0,0 +1,146 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PerformanceCounters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace OpenRCT2::PerformanceCounters
+{
+    /**
+     * The most recent samples in milliseconds, Next is the slot written next.
+     */
+    struct SampleRing
+    {
+        std::array<float, SampleCount> Samples{};
+        size_t Next{};
+        size_t Count{};
+
+        void Push(Duration time)
+        {
+            Samples[Next] = static_cast<float>(time.count() * 1000.0);
+            Next = (Next + 1) % SampleCount;
+            Count = std::min(Count + 1, SampleCount);
+        }
+
+        Percentiles GetPercentiles() const
+        {
+            Percentiles result;
+            if (Count == 0)
+            {
+                return result;
+            }
+
+            std::array<float, SampleCount> sorted;
+            std::copy_n(Samples.begin(), Count, sorted.begin());
+            std::sort(sorted.begin(), sorted.begin() + Count);
+            auto getPercentile = [&sorted, this](double percentile) {
+                auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * Count));
+                return sorted[std::clamp<size_t>(rank, 1, Count) - 1];
+            };
+            result.P50 = getPercentile(50);
+            result.P95 = getPercentile(95);
+            result.P99 = getPercentile(99);
+            return result;
+        }
+    };
+
+    static SampleRing _ticks;
+    static SampleRing _frames;
+    // Times of the parts of each tick, in the same slots as the tick times.
+    static std::array<std::array<float, SampleCount>, MaxTickParts> _tickParts{};
+    static std::atomic<uint64_t> _jobBusyNanoseconds = { 0 };
+    static std::atomic<int32_t> _jobWorkers = { 0 };
+
+    void RecordTickPart(size_t part, Duration time)
+    {
+        if (part < MaxTickParts)
+        {
+            _tickParts[part][_ticks.Next] = static_cast<float>(time.count() * 1000.0);
+        }
+    }
+
+    void RecordTick(Duration time)
+    {
+        _ticks.Push(time);
+
+        // Parts that are not run in the next tick are left at zero.
+        for (auto& part : _tickParts)
+        {
+            part[_ticks.Next] = 0;
+        }
+    }
+
+    void RecordFrame(Duration time)
+    {
+        _frames.Push(time);
+    }
+
+    void AddJobTime(std::chrono::nanoseconds time)
+    {
+        _jobBusyNanoseconds.fetch_add(static_cast<uint64_t>(time.count()), std::memory_order_relaxed);
+    }
+
+    void AddJobWorkers(int32_t count)
+    {
+        _jobWorkers.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    Percentiles GetTickPercentiles()
+    {
+        return _ticks.GetPercentiles();
+    }
+
+    Percentiles GetFramePercentiles()
+    {
+        return _frames.GetPercentiles();
+    }
+
+    size_t GetTickPartHistory(size_t part, float* buffer, size_t bufferSize)
+    {
+        if (part >= MaxTickParts)
+        {
+            return 0;
+        }
+
+        const auto count = std::min(bufferSize, _ticks.Count);
+        const auto first = (_ticks.Next + SampleCount - count) % SampleCount;
+        for (size_t i = 0; i < count; i++)
+        {
+            buffer[i] = _tickParts[part][(first + i) % SampleCount];
+        }
+        return count;
+    }
+
+    double GetTickPartAverage(size_t part)
+    {
+        if (part >= MaxTickParts || _ticks.Count == 0)
+        {
+            return 0;
+        }
+
+        const auto first = (_ticks.Next + SampleCount - _ticks.Count) % SampleCount;
+        double total = 0;
+        for (size_t i = 0; i < _ticks.Count; i++)
+        {
+            total += _tickParts[part][(first + i) % SampleCount];
+        }
+        return total / _ticks.Count;
+    }
+
+    JobStats GetJobStats()
+    {
+        JobStats result;
+        result.BusyNanoseconds = _jobBusyNanoseconds.load(std::memory_order_relaxed);
+        result.Workers = static_cast<size_t>(std::max(0, _jobWorkers.load(std::memory_order_relaxed)));
+        return result;
+    }
+} // namespace OpenRCT2::PerformanceCounters
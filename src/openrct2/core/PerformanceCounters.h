@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counters that are always collected, cheap enough to leave on, for showing how the game is performing while it runs.
+ * Unlike the profiler these only keep the most recent samples. Ticks and frames are recorded and read by the main
+ * thread, job counters can be updated from any thread.
+ */
+namespace OpenRCT2::PerformanceCounters
+{
+    // Number of ticks and frames kept, ~6.4s of ticks at 40Hz.
+    constexpr size_t SampleCount = 256;
+    // Upper bound of the number of parts a tick is split into.
+    constexpr size_t MaxTickParts = 32;
+
+    using Duration = std::chrono::duration<double>;
+
+    struct Percentiles
+    {
+        double P50{};
+        double P95{};
+        double P99{};
+    };
+
+    struct JobStats
+    {
+        // Time spent running tasks by all job pools since the start.
+        uint64_t BusyNanoseconds{};
+        // Worker threads of the job pools that currently exist.
+        size_t Workers{};
+    };
+
+    /**
+     * Records the time taken by a part of the tick that is being run, it is stored with that tick.
+     */
+    void RecordTickPart(size_t part, Duration time);
+
+    /**
+     * Records the time taken by a whole tick and starts the next one.
+     */
+    void RecordTick(Duration time);
+
+    /**
+     * Records the time since the previous frame was drawn.
+     */
+    void RecordFrame(Duration time);
+
+    void AddJobTime(std::chrono::nanoseconds time);
+    void AddJobWorkers(int32_t count);
+
+    /**
+     * @return the percentiles of the recorded tick times, in milliseconds.
+     */
+    Percentiles GetTickPercentiles();
+
+    /**
+     * @return the percentiles of the recorded frame times, in milliseconds.
+     */
+    Percentiles GetFramePercentiles();
+
+    /**
+     * Gets the most recent times of a part of the tick, oldest first, in milliseconds.
+     * @return the number of samples written, at most the size of the buffer.
+     */
+    size_t GetTickPartHistory(size_t part, float* buffer, size_t bufferSize);
+
+    /**
+     * @return the average time of a part of the tick over the recorded ticks, in milliseconds.
+     */
+    double GetTickPartAverage(size_t part);
+
+    JobStats GetJobStats();
+} // namespace OpenRCT2::PerformanceCounters
@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Profiler.h"
+
+#include "../Diagnostic.h"
+#include "File.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2::Profiler
+{
+    std::atomic_bool gEnabled = { false };
+
+    static constexpr std::array<const char*, static_cast<size_t>(Zone::Count)> ZoneNames = {
+        "Tick", "PeepUpdate", "Pathfinding", "VehicleUpdate", "RideRatings", "PaintSetup", "PaintSort", "PaintDraw", "Network",
+    };
+
+    struct Event
+    {
+        // Nanoseconds since the profiler epoch
+        uint64_t Begin;
+        uint64_t Duration;
+        Zone Id;
+    };
+
+    /**
+     * Ring buffer only written by its owning thread. Buffers are never freed so they can still be exported after the
+     * thread has exited.
+     */
+    struct ThreadBuffer
+    {
+        static constexpr uint64_t Capacity = 1 << 16;
+
+        uint32_t ThreadIndex;
+        std::unique_ptr<Event[]> Events = std::make_unique<Event[]>(Capacity);
+        // Total number of events written
+        std::atomic<uint64_t> Head = { 0 };
+        // Events before this were discarded by Reset
+        std::atomic<uint64_t> Tail = { 0 };
+    };
+
+    static const Clock::time_point _epoch = Clock::now();
+    static std::mutex _buffersMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    static thread_local ThreadBuffer* _threadBuffer = nullptr;
+
+    static ThreadBuffer& GetThreadBuffer()
+    {
+        if (_threadBuffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            auto& buffer = _buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            buffer->ThreadIndex = static_cast<uint32_t>(_buffers.size());
+            _threadBuffer = buffer.get();
+        }
+        return *_threadBuffer;
+    }
+
+    /**
+     * Index of the oldest event that can be read safely, the slot after the newest one may be written by a zone that
+     * was still open when recording was paused.
+     */
+    static uint64_t GetFirstReadableEvent(const ThreadBuffer& buffer, uint64_t head)
+    {
+        auto first = buffer.Tail.load(std::memory_order_relaxed);
+        if (head >= ThreadBuffer::Capacity)
+        {
+            first = std::max(first, head - ThreadBuffer::Capacity + 1);
+        }
+        return first;
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        gEnabled = enabled;
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        for (auto& buffer : _buffers)
+        {
+            buffer->Tail = buffer->Head.load(std::memory_order_acquire);
+        }
+    }
+
+    size_t GetEventCount()
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        size_t count = 0;
+        for (const auto& buffer : _buffers)
+        {
+            auto head = buffer->Head.load(std::memory_order_acquire);
+            count += static_cast<size_t>(head - GetFirstReadableEvent(*buffer, head));
+        }
+        return count;
+    }
+
+    void RecordZone(Zone zone, Clock::time_point begin, Clock::time_point end)
+    {
+        auto& buffer = GetThreadBuffer();
+        auto head = buffer.Head.load(std::memory_order_relaxed);
+        auto& event = buffer.Events[head & (ThreadBuffer::Capacity - 1)];
+        event.Begin = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(begin - _epoch).count());
+        event.Duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        event.Id = zone;
+        buffer.Head.store(head + 1, std::memory_order_release);
+    }
+
+    static void AppendEvent(std::string& out, const Event& event, uint32_t threadIndex)
+    {
+        char line[192];
+        snprintf(
+            line, sizeof(line),
+            ",\n{\"name\":\"%s\",\"cat\":\"openrct2\",\"ph\":\"X\",\"ts\":%" PRIu64 ".%03" PRIu64 ",\"dur\":%" PRIu64
+            ".%03" PRIu64 ",\"pid\":1,\"tid\":%" PRIu32 "}",
+            ZoneNames[static_cast<size_t>(event.Id)], event.Begin / 1000, event.Begin % 1000, event.Duration / 1000,
+            event.Duration % 1000, threadIndex);
+        out += line;
+    }
+
+    bool ExportChromeTrace(std::string_view path)
+    {
+        const bool wasEnabled = gEnabled.exchange(false);
+
+        std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"OpenRCT2\"}}";
+        {
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            for (const auto& buffer : _buffers)
+            {
+                char line[128];
+                snprintf(
+                    line, sizeof(line),
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32
+                    ",\"args\":{\"name\":\"Thread %" PRIu32 "\"}}",
+                    buffer->ThreadIndex, buffer->ThreadIndex);
+                out += line;
+
+                auto head = buffer->Head.load(std::memory_order_acquire);
+                for (auto i = GetFirstReadableEvent(*buffer, head); i < head; i++)
+                {
+                    AppendEvent(out, buffer->Events[i & (ThreadBuffer::Capacity - 1)], buffer->ThreadIndex);
+                }
+            }
+        }
+        out += "\n]}\n";
+
+        bool result = true;
+        try
+        {
+            File::WriteAllBytes(path, out.data(), out.size());
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to write profiler trace: %s", e.what());
+            result = false;
+        }
+
+        gEnabled = wasEnabled;
+        return result;
+    }
+} // namespace OpenRCT2::Profiler
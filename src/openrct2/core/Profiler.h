@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Built-in instrumentation for finding spikes in the game loop. Zones are recorded into a ring buffer per thread while
+ * the profiler is enabled, which can be done at runtime through the "profiler" console command, and exported as a
+ * Chrome trace that can be opened in chrome://tracing or Perfetto.
+ */
+namespace OpenRCT2::Profiler
+{
+    enum class Zone : uint8_t
+    {
+        Tick,
+        PeepUpdate,
+        Pathfinding,
+        VehicleUpdate,
+        RideRatings,
+        PaintSetup,
+        PaintSort,
+        PaintDraw,
+        Network,
+        Count,
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    extern std::atomic_bool gEnabled;
+
+    inline bool IsEnabled()
+    {
+        return gEnabled.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool enabled);
+
+    /**
+     * Discards all recorded zones.
+     */
+    void Reset();
+
+    /**
+     * @return The number of zones currently held in all ring buffers.
+     */
+    size_t GetEventCount();
+
+    /**
+     * Writes the recorded zones in the Chrome trace event format, recording is paused while writing.
+     * @return true if the file was written.
+     */
+    bool ExportChromeTrace(std::string_view path);
+
+    void RecordZone(Zone zone, Clock::time_point begin, Clock::time_point end);
+
+    class ScopedZone
+    {
+        Zone _zone;
+        bool _active;
+        Clock::time_point _begin;
+
+    public:
+        explicit ScopedZone(Zone zone)
+            : _zone(zone)
+            , _active(IsEnabled())
+        {
+            if (_active)
+            {
+                _begin = Clock::now();
+            }
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+        ~ScopedZone()
+        {
+            if (_active)
+            {
+                RecordZone(_zone, _begin, Clock::now());
+            }
+        }
+    };
+} // namespace OpenRCT2::Profiler
+
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone)                                                                                                     \
+    OpenRCT2::Profiler::ScopedZone PROFILE_ZONE_CONCAT(_profileZone, __LINE__)(OpenRCT2::Profiler::Zone::zone)
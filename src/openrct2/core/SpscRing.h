@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Fixed size lock free ring buffer for a single producer thread and a single consumer thread.
+ * Neither side ever blocks, pushing to a full ring or popping from an empty one fails instead.
+ */
+template<typename T, size_t TCapacity> class SpscRing
+{
+    static_assert(TCapacity != 0 && (TCapacity & (TCapacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+private:
+    static constexpr size_t Mask = TCapacity - 1;
+
+    std::array<T, TCapacity> _items{};
+    // Kept on separate cache lines so the producer and consumer do not invalidate each other.
+    alignas(64) std::atomic<size_t> _head = { 0 };
+    alignas(64) std::atomic<size_t> _tail = { 0 };
+
+public:
+    /**
+     * Adds an item, must only be called by the producer.
+     * @return false if the ring is full.
+     */
+    bool TryPush(const T& item)
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == TCapacity)
+        {
+            return false;
+        }
+        _items[tail & Mask] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Removes the oldest item, must only be called by the consumer.
+     * @return false if the ring is empty.
+     */
+    bool TryPop(T& item)
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = _items[head & Mask];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity()
+    {
+        return TCapacity;
+    }
+};
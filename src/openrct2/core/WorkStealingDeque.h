@@ -0,0 +1,176 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Chase-Lev work stealing deque of pointers.
+ * The owning thread pushes and takes at the bottom without any locking, any
+ * other thread may steal from the top. The ring buffer grows when full, old
+ * buffers are kept alive until the deque is destroyed as thieves may still be
+ * reading from them.
+ * See "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al. 2013).
+ */
+template<typename T> class WorkStealingDeque
+{
+    static_assert(std::is_pointer_v<T>, "WorkStealingDeque only stores pointers");
+
+private:
+    struct RingBuffer
+    {
+        const int64_t Capacity;
+        const int64_t Mask;
+        std::unique_ptr<std::atomic<T>[]> Items;
+
+        explicit RingBuffer(int64_t capacity)
+            : Capacity(capacity)
+            , Mask(capacity - 1)
+            , Items(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)))
+        {
+        }
+
+        T Get(int64_t index) const
+        {
+            return Items[index & Mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(int64_t index, T item)
+        {
+            Items[index & Mask].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    std::atomic<int64_t> _top = { 0 };
+    std::atomic<int64_t> _bottom = { 0 };
+    std::atomic<RingBuffer*> _buffer;
+    std::vector<std::unique_ptr<RingBuffer>> _buffers;
+
+public:
+    explicit WorkStealingDeque(size_t initialCapacity = 256)
+    {
+        // Capacity must be a power of two for the index mask
+        int64_t capacity = 1;
+        while (capacity < static_cast<int64_t>(initialCapacity))
+        {
+            capacity <<= 1;
+        }
+        _buffers.push_back(std::make_unique<RingBuffer>(capacity));
+        _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * Pushes an item to the bottom of the deque, must only be called by the owner.
+     */
+    void Push(T item)
+    {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_acquire);
+        auto* buffer = _buffer.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->Capacity - 1)
+        {
+            buffer = Grow(buffer, bottom, top);
+        }
+        buffer->Put(bottom, item);
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * Takes the most recently pushed item, must only be called by the owner.
+     * @return The item or nullptr if the deque is empty.
+     */
+    T Take()
+    {
+        auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        auto* buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = _top.load(std::memory_order_relaxed);
+
+        T result = nullptr;
+        if (top <= bottom)
+        {
+            result = buffer->Get(bottom);
+            if (top == bottom)
+            {
+                // Last item, race against thieves for it.
+                if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    result = nullptr;
+                }
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    /**
+     * Steals the oldest item, may be called from any thread.
+     * @return The item or nullptr if the deque is empty or another thread won the race.
+     */
+    T Steal()
+    {
+        auto top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top < bottom)
+        {
+            auto* buffer = _buffer.load(std::memory_order_acquire);
+            T result = buffer->Get(top);
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return result;
+        }
+        return nullptr;
+    }
+
+    bool IsEmpty() const
+    {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_relaxed);
+        return bottom <= top;
+    }
+
+    size_t GetCount() const
+    {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    RingBuffer* Grow(RingBuffer* buffer, int64_t bottom, int64_t top)
+    {
+        auto newBuffer = std::make_unique<RingBuffer>(buffer->Capacity * 2);
+        for (auto i = top; i < bottom; i++)
+        {
+            newBuffer->Put(i, buffer->Get(i));
+        }
+        auto* result = newBuffer.get();
+        _buffers.push_back(std::move(newBuffer));
+        _buffer.store(result, std::memory_order_release);
+        return result;
+    }
+};
@@ -13,6 +13,11 @@
 
 #include <algorithm>
 #ifndef __ANDROID__
+#    include "MappedFile.h"
+#    include "MemoryStream.h"
+
+#    include <cstring>
+#    include <unordered_map>
 #    include <zip.h>
 #endif
 
@@ -67,30 +72,59 @@ bool IZipArchive::Exists(std::string_view path) const
 
 #ifndef __ANDROID__
 
+template<typename T> static T ReadZipValue(const uint8_t* data)
+{
+    // Zip headers are little endian, like every supported platform.
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
 class ZipArchive final : public IZipArchive
 {
 private:
+    struct StoredEntry
+    {
+        const uint8_t* Data;
+        size_t Length;
+    };
+
     zip_t* _zip;
     ZIP_ACCESS _access;
     std::vector<std::vector<uint8_t>> _writeBuffers;
 
+    // Only used when reading, the archive does not change so the lookups can be built once.
+    std::unique_ptr<MappedFile> _mappedFile;
+    std::unordered_map<std::string, size_t> _index;
+    std::unordered_map<std::string, StoredEntry> _storedEntries;
+
 public:
     ZipArchive(std::string_view path, ZIP_ACCESS access)
     {
-        auto zipOpenMode = ZIP_RDONLY;
-        if (access == ZIP_ACCESS::WRITE)
+        _access = access;
+        if (access == ZIP_ACCESS::READ)
+        {
+            _zip = OpenMapped(path);
+            if (_zip == nullptr)
+            {
+                int32_t error;
+                _zip = zip_open(std::string(path).c_str(), ZIP_RDONLY, &error);
+            }
+        }
+        else
         {
-            zipOpenMode = ZIP_CREATE;
+            int32_t error;
+            _zip = zip_open(std::string(path).c_str(), ZIP_CREATE, &error);
         }
-
-        int32_t error;
-        _zip = zip_open(std::string(path).c_str(), zipOpenMode, &error);
         if (_zip == nullptr)
         {
             throw IOException("Unable to open zip file.");
         }
 
-        _access = access;
+        if (access == ZIP_ACCESS::READ)
+        {
+            BuildIndex();
+        }
     }
 
     ~ZipArchive() override
@@ -125,9 +159,31 @@ public:
         return 0;
     }
 
+    std::optional<size_t> GetIndexFromPath(std::string_view path) const override
+    {
+        if (_access != ZIP_ACCESS::READ)
+        {
+            return IZipArchive::GetIndexFromPath(path);
+        }
+
+        auto it = _index.find(NormalisePath(path));
+        if (it == _index.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
     std::vector<uint8_t> GetFileData(std::string_view path) const override
     {
         std::vector<uint8_t> result;
+        auto storedEntry = GetStoredEntry(path);
+        if (storedEntry != nullptr)
+        {
+            result.assign(storedEntry->Data, storedEntry->Data + storedEntry->Length);
+            return result;
+        }
+
         auto index = GetIndexFromPath(path);
         if (index.has_value())
         {
@@ -152,6 +208,13 @@ public:
 
     std::unique_ptr<IStream> GetFileStream(std::string_view path) const override
     {
+        // Stored entries are read straight from the mapped file, the stream is only valid while the archive is open.
+        auto storedEntry = GetStoredEntry(path);
+        if (storedEntry != nullptr)
+        {
+            return std::make_unique<MemoryStream>(storedEntry->Data, storedEntry->Length);
+        }
+
         auto index = GetIndexFromPath(path);
         if (index.has_value())
         {
@@ -206,6 +269,138 @@ public:
     }
 
 private:
+    zip_t* OpenMapped(std::string_view path)
+    {
+        try
+        {
+            _mappedFile = std::make_unique<MappedFile>(path);
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+
+        zip_error_t error;
+        zip_error_init(&error);
+        auto source = zip_source_buffer_create(_mappedFile->GetData(), _mappedFile->GetLength(), 0, &error);
+        zip_t* zip = nullptr;
+        if (source != nullptr)
+        {
+            zip = zip_open_from_source(source, ZIP_RDONLY, &error);
+            if (zip == nullptr)
+            {
+                zip_source_free(source);
+            }
+        }
+        zip_error_fini(&error);
+        if (zip == nullptr)
+        {
+            _mappedFile = nullptr;
+        }
+        return zip;
+    }
+
+    void BuildIndex()
+    {
+        auto numFiles = GetNumFiles();
+        _index.reserve(numFiles);
+        for (size_t i = 0; i < numFiles; i++)
+        {
+            // Keep the first match, like the linear lookup.
+            _index.emplace(NormalisePath(GetFileName(i)), i);
+        }
+
+        if (_mappedFile != nullptr)
+        {
+            FindStoredEntries(_mappedFile->GetData(), _mappedFile->GetLength());
+        }
+    }
+
+    /**
+     * Finds the data of every stored (uncompressed, unencrypted) entry by reading the central directory.
+     * Archives using zip64 or spanning several disks are left to libzip.
+     */
+    void FindStoredEntries(const uint8_t* data, size_t length)
+    {
+        constexpr uint32_t EndOfCentralDirectorySignature = 0x06054B50;
+        constexpr uint32_t CentralDirectorySignature = 0x02014B50;
+        constexpr uint32_t LocalHeaderSignature = 0x04034B50;
+        constexpr size_t EndOfCentralDirectorySize = 22;
+        constexpr size_t CentralDirectoryHeaderSize = 46;
+        constexpr size_t LocalHeaderSize = 30;
+
+        if (length < EndOfCentralDirectorySize)
+            return;
+
+        // The end of central directory record is followed by a comment of up to 65535 bytes.
+        const uint8_t* eocd = nullptr;
+        const auto searchEnd = length > EndOfCentralDirectorySize + UINT16_MAX
+            ? length - EndOfCentralDirectorySize - UINT16_MAX
+            : 0;
+        for (size_t offset = length - EndOfCentralDirectorySize + 1; offset-- > searchEnd;)
+        {
+            if (ReadZipValue<uint32_t>(data + offset) == EndOfCentralDirectorySignature)
+            {
+                eocd = data + offset;
+                break;
+            }
+        }
+        if (eocd == nullptr || ReadZipValue<uint16_t>(eocd + 4) != 0 || ReadZipValue<uint16_t>(eocd + 6) != 0)
+            return;
+
+        const auto numEntries = ReadZipValue<uint16_t>(eocd + 10);
+        const size_t directorySize = ReadZipValue<uint32_t>(eocd + 12);
+        const size_t directoryOffset = ReadZipValue<uint32_t>(eocd + 16);
+        if (directoryOffset > length || directorySize > length - directoryOffset)
+            return;
+
+        const auto* header = data + directoryOffset;
+        const auto* directoryEnd = header + directorySize;
+        for (uint16_t i = 0; i < numEntries; i++)
+        {
+            if (directoryEnd - header < static_cast<ptrdiff_t>(CentralDirectoryHeaderSize)
+                || ReadZipValue<uint32_t>(header) != CentralDirectorySignature)
+                return;
+
+            const auto flags = ReadZipValue<uint16_t>(header + 8);
+            const auto method = ReadZipValue<uint16_t>(header + 10);
+            const size_t compressedSize = ReadZipValue<uint32_t>(header + 20);
+            const size_t size = ReadZipValue<uint32_t>(header + 24);
+            const size_t nameLength = ReadZipValue<uint16_t>(header + 28);
+            const size_t extraLength = ReadZipValue<uint16_t>(header + 30);
+            const size_t commentLength = ReadZipValue<uint16_t>(header + 32);
+            const size_t localOffset = ReadZipValue<uint32_t>(header + 42);
+            const auto headerLength = CentralDirectoryHeaderSize + nameLength + extraLength + commentLength;
+            if (static_cast<size_t>(directoryEnd - header) < headerLength)
+                return;
+
+            const bool isStored = method == ZIP_CM_STORE && !(flags & 1) && compressedSize == size && size != UINT32_MAX
+                && localOffset != UINT32_MAX;
+            if (isStored && localOffset <= length - LocalHeaderSize
+                && ReadZipValue<uint32_t>(data + localOffset) == LocalHeaderSignature)
+            {
+                const auto* local = data + localOffset;
+                const size_t dataOffset = localOffset + LocalHeaderSize + ReadZipValue<uint16_t>(local + 26)
+                    + ReadZipValue<uint16_t>(local + 28);
+                if (dataOffset <= length && size <= length - dataOffset)
+                {
+                    std::string name(reinterpret_cast<const char*>(header + CentralDirectoryHeaderSize), nameLength);
+                    _storedEntries.emplace(NormalisePath(name), StoredEntry{ data + dataOffset, size });
+                }
+            }
+            header += headerLength;
+        }
+    }
+
+    const StoredEntry* GetStoredEntry(std::string_view path) const
+    {
+        if (_storedEntries.empty())
+            return nullptr;
+
+        auto it = _storedEntries.find(NormalisePath(path));
+        return it != _storedEntries.end() ? &it->second : nullptr;
+    }
+
     class ZipItemStream final : public IStream
     {
     private:
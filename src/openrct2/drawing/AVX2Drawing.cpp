@@ -9,6 +9,7 @@
 
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../interface/Colour.h"
 #include "Drawing.h"
 
 #ifdef __AVX2__
@@ -42,6 +43,144 @@ void mask_avx2(
     }
 }
 
+template<bool TRemapDst>
+static void rle_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    const __m256i zero = {};
+    alignas(32) uint8_t remapped[32];
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        // There is no byte gather, so only the lookups stay scalar and the transparency tests are done as a blend.
+        const uint8_t* lookup = TRemapDst ? dst + i : src + i;
+        for (int32_t j = 0; j < 32; j++)
+        {
+            remapped[j] = map[lookup[j]];
+        }
+        const __m256i source = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i pixels = _mm256_load_si256(reinterpret_cast<const __m256i*>(remapped));
+        const __m256i skip = _mm256_or_si256(_mm256_cmpeq_epi8(source, zero), _mm256_cmpeq_epi8(pixels, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, skip));
+    }
+
+    if constexpr (TRemapDst)
+    {
+        rle_remap_dst_scalar(src + i, dst + i, map, count - i);
+    }
+    else
+    {
+        rle_remap_src_scalar(src + i, dst + i, map, count - i);
+    }
+}
+
+void rle_remap_src_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    rle_remap_avx2<false>(src, dst, map, count);
+}
+
+void rle_remap_dst_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    rle_remap_avx2<true>(src, dst, map, count);
+}
+
+#    ifndef NO_TTF
+void ttf_stamp_row_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour)
+{
+    const __m256i zero = {};
+    const __m256i colour256 = _mm256_set1_epi8(static_cast<char>(colour));
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i source = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i blended = _mm256_blendv_epi8(colour256, dest, _mm256_cmpeq_epi8(source, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), blended);
+    }
+    ttf_stamp_row_scalar(src + i, dst + i, count - i, colour);
+}
+
+void ttf_glyph_row_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith)
+{
+    const __m256i zero = {};
+    const __m256i colour256 = _mm256_set1_epi8(static_cast<char>(colour));
+    const __m256i fullAbove256 = _mm256_set1_epi8(static_cast<char>(fullAbove));
+    const __m256i blendAbove256 = _mm256_set1_epi8(static_cast<char>(blendAbove));
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        // There is no unsigned byte compare, a saturated subtraction is only zero when source is not above the limit.
+        const __m256i source = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i notFull = _mm256_cmpeq_epi8(_mm256_subs_epu8(source, fullAbove256), zero);
+        const __m256i blend = _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_subs_epu8(source, blendAbove256), zero), notFull);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(colour256, dest, notFull));
+
+        // Only the edges of hinted glyphs blend, the blend goes through the palette so these pixels stay scalar.
+        uint32_t blendMask = static_cast<uint32_t>(_mm256_movemask_epi8(blend));
+        for (int32_t j = 0; blendMask != 0; j++, blendMask >>= 1)
+        {
+            if (blendMask & 1)
+            {
+                dst[i + j] = blendColours(colour, blendWith < 0 ? dst[i + j] : static_cast<uint8_t>(blendWith));
+            }
+        }
+    }
+    ttf_glyph_row_scalar(src + i, dst + i, count - i, colour, fullAbove, blendAbove, blendWith);
+}
+#    endif
+
+#    ifdef __ENABLE_LIGHTFX__
+void lightfx_add_row_avx2(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale)
+{
+    const __m256i zero = {};
+    const __m256i scale256 = _mm256_set1_epi16(static_cast<int16_t>(scale));
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        // (src * scale) >> 8 is the high half of (src << 8) * scale, unpack and pack both work per lane
+        const __m256i source = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i lo = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_unpacklo_epi8(source, zero), 8), scale256);
+        const __m256i hi = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_unpackhi_epi8(source, zero), 8), scale256);
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_adds_epu8(dest, _mm256_packus_epi16(lo, hi)));
+    }
+    lightfx_add_row_scalar(dst + i, src + i, count - i, scale);
+}
+
+void lightfx_mix_row_avx2(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    const __m256i zero = {};
+    const __m256i six = _mm256_set1_epi32(6);
+    int32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bits + i)));
+        const __m256i dark = _mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), indices, 4);
+        const __m256i lit = _mm256_i32gather_epi32(reinterpret_cast<const int*>(lightPalette), indices, 4);
+
+        // Spread the intensity of each pixel over its four channels
+        const __m256i factor = _mm256_mullo_epi32(
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(light + i))), six);
+        const __m256i factorPairs = _mm256_or_si256(factor, _mm256_slli_epi32(factor, 16));
+        const __m256i factorLo = _mm256_unpacklo_epi32(factorPairs, factorPairs);
+        const __m256i factorHi = _mm256_unpackhi_epi32(factorPairs, factorPairs);
+
+        // dark + ((lit * intensity * 6) >> 8), saturated by the pack
+        const __m256i litLo = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_unpacklo_epi8(lit, zero), 8), factorLo);
+        const __m256i litHi = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_unpackhi_epi8(lit, zero), 8), factorHi);
+        const __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(dark, zero), litLo);
+        const __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(dark, zero), litHi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    lightfx_mix_row_scalar(dst + i, bits + i, light + i, count - i, palette, lightPalette);
+}
+#    endif
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +194,42 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void rle_remap_src_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void rle_remap_dst_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#    ifndef NO_TTF
+void ttf_stamp_row_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void ttf_glyph_row_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+#    endif
+
+#    ifdef __ENABLE_LIGHTFX__
+void lightfx_add_row_avx2(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void lightfx_mix_row_avx2(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+#    endif
+
 #endif // __AVX2__
@@ -0,0 +1,243 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "DirtyGrid.h"
+
+#include "../util/Util.h"
+
+#include <algorithm>
+
+using namespace OpenRCT2::Drawing;
+
+static constexpr uint32_t BitsPerWord = 64;
+
+// Mask of the bits from first to last inclusive, both within the same word.
+static uint64_t GetWordMask(uint32_t first, uint32_t last)
+{
+    const uint64_t upTo = last == BitsPerWord - 1 ? ~0ULL : (1ULL << (last + 1)) - 1;
+    return upTo & ~((1ULL << first) - 1);
+}
+
+static uint32_t CountBits(uint64_t word)
+{
+    return bitcount(static_cast<uint32_t>(word)) + bitcount(static_cast<uint32_t>(word >> 32));
+}
+
+static uint32_t GetArea(const DirtyRegion& region)
+{
+    return region.Columns * region.Rows;
+}
+
+static bool Contains(const DirtyRegion& outer, const DirtyRegion& inner)
+{
+    return inner.X >= outer.X && inner.Y >= outer.Y && inner.X + inner.Columns <= outer.X + outer.Columns
+        && inner.Y + inner.Rows <= outer.Y + outer.Rows;
+}
+
+static bool Intersects(const DirtyRegion& a, const DirtyRegion& b)
+{
+    return a.X < b.X + b.Columns && b.X < a.X + a.Columns && a.Y < b.Y + b.Rows && b.Y < a.Y + a.Rows;
+}
+
+static DirtyRegion GetBounds(const DirtyRegion& a, const DirtyRegion& b)
+{
+    const auto left = std::min(a.X, b.X);
+    const auto top = std::min(a.Y, b.Y);
+    const auto right = std::max(a.X + a.Columns, b.X + b.Columns);
+    const auto bottom = std::max(a.Y + a.Rows, b.Y + b.Rows);
+    return { left, top, right - left, bottom - top };
+}
+
+void DirtyGrid::Configure(uint32_t width, uint32_t height)
+{
+    BlockShiftX = 7;
+    BlockShiftY = 6;
+    BlockWidth = 1 << BlockShiftX;
+    BlockHeight = 1 << BlockShiftY;
+    BlockColumns = (width >> BlockShiftX) + 1;
+    BlockRows = (height >> BlockShiftY) + 1;
+
+    _width = width;
+    _height = height;
+    _wordsPerRow = (BlockColumns + BitsPerWord - 1) / BitsPerWord;
+    _bits.assign(static_cast<size_t>(_wordsPerRow) * BlockRows, 0);
+    for (uint32_t y = 0; y < BlockRows; y++)
+    {
+        SetRange(y, 0, BlockColumns, true);
+    }
+}
+
+void DirtyGrid::Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    left = std::max(left, 0);
+    top = std::max(top, 0);
+    right = std::min(right, static_cast<int32_t>(_width));
+    bottom = std::min(bottom, static_cast<int32_t>(_height));
+
+    if (left >= right)
+        return;
+    if (top >= bottom)
+        return;
+
+    const uint32_t firstColumn = left >> BlockShiftX;
+    const uint32_t lastColumn = (right - 1) >> BlockShiftX;
+    const uint32_t firstRow = top >> BlockShiftY;
+    const uint32_t lastRow = (bottom - 1) >> BlockShiftY;
+    for (uint32_t y = firstRow; y <= lastRow; y++)
+    {
+        SetRange(y, firstColumn, lastColumn - firstColumn + 1, true);
+    }
+}
+
+uint64_t* DirtyGrid::GetRow(uint32_t y)
+{
+    return &_bits[static_cast<size_t>(y) * _wordsPerRow];
+}
+
+uint32_t DirtyGrid::GetRunLength(uint32_t y, uint32_t x)
+{
+    const auto* row = GetRow(y);
+    uint32_t end = x;
+    while (end < BlockColumns)
+    {
+        const auto word = end / BitsPerWord;
+        const auto clean = ~row[word] & ~((1ULL << (end % BitsPerWord)) - 1);
+        if (clean != 0)
+        {
+            end = word * BitsPerWord + bitscanforward(static_cast<int64_t>(clean));
+            break;
+        }
+        end = (word + 1) * BitsPerWord;
+    }
+    return std::min(end, BlockColumns) - x;
+}
+
+bool DirtyGrid::IsRangeDirty(uint32_t y, uint32_t x, uint32_t columns)
+{
+    const auto* row = GetRow(y);
+    const auto last = x + columns - 1;
+    for (auto word = x / BitsPerWord; word <= last / BitsPerWord; word++)
+    {
+        const auto first = word == x / BitsPerWord ? x % BitsPerWord : 0;
+        const auto end = word == last / BitsPerWord ? last % BitsPerWord : BitsPerWord - 1;
+        const auto mask = GetWordMask(first, end);
+        if ((row[word] & mask) != mask)
+            return false;
+    }
+    return true;
+}
+
+void DirtyGrid::SetRange(uint32_t y, uint32_t x, uint32_t columns, bool dirty)
+{
+    auto* row = GetRow(y);
+    const auto last = x + columns - 1;
+    for (auto word = x / BitsPerWord; word <= last / BitsPerWord; word++)
+    {
+        const auto first = word == x / BitsPerWord ? x % BitsPerWord : 0;
+        const auto end = word == last / BitsPerWord ? last % BitsPerWord : BitsPerWord - 1;
+        const auto mask = GetWordMask(first, end);
+        row[word] = dirty ? row[word] | mask : row[word] & ~mask;
+    }
+}
+
+const std::vector<DirtyRegion>& DirtyGrid::TakeRegions()
+{
+    for (auto word : _bits)
+    {
+        _frameStats.DirtyBlocks += CountBits(word);
+    }
+
+    _regions.clear();
+    for (uint32_t y = 0; y < BlockRows; y++)
+    {
+        const auto* row = GetRow(y);
+        for (uint32_t word = 0; word < _wordsPerRow; word++)
+        {
+            // Taking a region clears its blocks, so the word is scanned until it is clean.
+            while (row[word] != 0)
+            {
+                const uint32_t x = word * BitsPerWord + bitscanforward(static_cast<int64_t>(row[word]));
+                const uint32_t columns = GetRunLength(y, x);
+                uint32_t rows = 1;
+                while (y + rows < BlockRows && IsRangeDirty(y + rows, x, columns))
+                {
+                    rows++;
+                }
+
+                for (uint32_t yy = y; yy < y + rows; yy++)
+                {
+                    SetRange(yy, x, columns, false);
+                }
+                _regions.push_back({ x, y, columns, rows });
+            }
+        }
+    }
+
+    MergeRegions();
+
+    for (const auto& region : _regions)
+    {
+        _frameStats.DrawnBlocks += GetArea(region);
+    }
+    _frameStats.Regions += static_cast<uint32_t>(_regions.size());
+    return _regions;
+}
+
+void DirtyGrid::MergeRegions()
+{
+    if (_regions.size() > MaxRegionsToMerge)
+        return;
+
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (size_t i = 0; i < _regions.size() && !merged; i++)
+        {
+            for (size_t j = i + 1; j < _regions.size() && !merged; j++)
+            {
+                const auto bounds = GetBounds(_regions[i], _regions[j]);
+
+                // The regions inside the bounds are drawn with them, a region only partly inside would be drawn twice.
+                uint32_t coveredArea = 0;
+                bool overlapsOther = false;
+                for (size_t k = 0; k < _regions.size(); k++)
+                {
+                    if (Contains(bounds, _regions[k]))
+                    {
+                        coveredArea += GetArea(_regions[k]);
+                    }
+                    else if (Intersects(bounds, _regions[k]))
+                    {
+                        overlapsOther = true;
+                        break;
+                    }
+                }
+                if (overlapsOther || GetArea(bounds) - coveredArea > RegionCostInBlocks)
+                    continue;
+
+                auto isCovered = [&bounds](const DirtyRegion& region) { return Contains(bounds, region); };
+                _regions.erase(std::remove_if(_regions.begin(), _regions.end(), isCovered), _regions.end());
+                _regions.push_back(bounds);
+                merged = true;
+            }
+        }
+    }
+}
+
+void DirtyGrid::BeginFrame()
+{
+    _lastFrameStats = _frameStats;
+    _frameStats = {};
+}
+
+DirtyGridStats DirtyGrid::GetStats() const
+{
+    return _lastFrameStats;
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "IDrawingEngine.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace OpenRCT2::Drawing
+{
+    /**
+     * A rectangle of blocks of the dirty grid.
+     */
+    struct DirtyRegion
+    {
+        uint32_t X{};
+        uint32_t Y{};
+        uint32_t Columns{};
+        uint32_t Rows{};
+    };
+
+    /**
+     * Tracks which blocks of the screen have to be redrawn, one bit per block and the blocks of a row in consecutive
+     * words, so invalidating and finding the dirty blocks work on whole words instead of single blocks.
+     */
+    class DirtyGrid
+    {
+    public:
+        uint32_t BlockShiftX{};
+        uint32_t BlockShiftY{};
+        uint32_t BlockWidth{};
+        uint32_t BlockHeight{};
+        uint32_t BlockColumns{};
+        uint32_t BlockRows{};
+
+        /**
+         * Sizes the grid for a screen of the given size, every block starts dirty.
+         */
+        void Configure(uint32_t width, uint32_t height);
+
+        /**
+         * Marks the blocks covering the given pixels as dirty, right and bottom are exclusive.
+         */
+        void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom);
+
+        /**
+         * Takes the dirty blocks as regions to redraw and marks them as clean. Neighbouring regions are merged when
+         * drawing the clean blocks between them costs less than drawing another region.
+         */
+        const std::vector<DirtyRegion>& TakeRegions();
+
+        /**
+         * Starts counting the statistics of a new frame.
+         */
+        void BeginFrame();
+
+        /**
+         * @return the statistics of the last complete frame.
+         */
+        DirtyGridStats GetStats() const;
+
+    private:
+        // Drawing a region has a fixed cost on top of its area, about that of drawing this many blocks.
+        static constexpr uint32_t RegionCostInBlocks = 4;
+        // Beyond this many regions the screen is mostly dirty anyway and merging is not worth its own cost.
+        static constexpr size_t MaxRegionsToMerge = 64;
+
+        uint32_t _width{};
+        uint32_t _height{};
+        uint32_t _wordsPerRow{};
+        std::vector<uint64_t> _bits;
+        std::vector<DirtyRegion> _regions;
+        DirtyGridStats _frameStats{};
+        DirtyGridStats _lastFrameStats{};
+
+        uint64_t* GetRow(uint32_t y);
+        uint32_t GetRunLength(uint32_t y, uint32_t x);
+        bool IsRangeDirty(uint32_t y, uint32_t x, uint32_t columns);
+        void SetRange(uint32_t y, uint32_t x, uint32_t columns, bool dirty);
+        void MergeRegions();
+    };
+} // namespace OpenRCT2::Drawing
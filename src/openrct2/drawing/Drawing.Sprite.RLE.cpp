@@ -8,10 +8,41 @@
  *****************************************************************************/
 
 #include "Drawing.h"
+#include "SpriteMipCache.h"
 
 #include <algorithm>
 #include <cstring>
 
+void rle_remap_src_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = map[src[i]];
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
+void rle_remap_dst_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = map[dst[i]];
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
 template<DrawBlendOp TBlendOp, size_t TZoom>
 static void FASTCALL DrawRLESpriteMagnify(rct_drawpixelinfo& dpi, const DrawSpriteArgs& args)
 {
@@ -163,6 +194,33 @@ static void FASTCALL DrawRLESpriteMinify(rct_drawpixelinfo& dpi, const DrawSprit
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (((TBlendOp & BLEND_SRC) == 0) != ((TBlendOp & BLEND_DST) == 0) && TZoom == 0)
+            {
+                // Whole runs are remapped through the vectorised blitters when the map allows it
+                if (numPixels > 0)
+                {
+                    auto& paletteMap = args.PalMap;
+                    const auto* map = paletteMap.GetFullMap();
+                    if (map != nullptr)
+                    {
+                        if constexpr ((TBlendOp & BLEND_SRC) != 0)
+                        {
+                            rle_remap_src_fn(src, dst, map, numPixels);
+                        }
+                        else
+                        {
+                            rle_remap_dst_fn(src, dst, map, numPixels);
+                        }
+                    }
+                    else
+                    {
+                        for (int32_t j = 0; j < numPixels; j++)
+                        {
+                            BlitPixel<TBlendOp>(src + j, dst + j, paletteMap);
+                        }
+                    }
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -178,6 +236,62 @@ static void FASTCALL DrawRLESpriteMinify(rct_drawpixelinfo& dpi, const DrawSprit
     }
 }
 
+/**
+ * Draws a zoomed out sprite from its cached zoomed copy, which samples the same pixels as DrawRLESpriteMinify but can
+ * copy whole runs. Only used when the columns drawn are multiples of the zoom, as the cached copies assume.
+ * @return false if the sprite has to be drawn by DrawRLESpriteMinify instead.
+ */
+template<DrawBlendOp TBlendOp, size_t TZoom>
+static bool FASTCALL DrawRLESpriteMipCached(rct_drawpixelinfo& dpi, const DrawSpriteArgs& args)
+{
+    constexpr int32_t zoom = 1 << TZoom;
+    auto srcX = args.SrcX;
+    auto srcY = args.SrcY;
+    auto height = args.Height;
+    auto dst0 = args.DestinationBits;
+    auto dstLineWidth = (static_cast<size_t>(dpi.width) >> TZoom) + dpi.pitch;
+    if (srcX < 0 || (srcX & (zoom - 1)) != 0)
+    {
+        return false;
+    }
+
+    // Same adjustment as DrawRLESpriteMinify
+    if (srcY < 0)
+    {
+        srcY += zoom;
+        height -= zoom;
+        dst0 += dstLineWidth;
+    }
+    if (height <= 0)
+    {
+        return true;
+    }
+
+    auto zoomedSprite = SpriteMipCacheGet(args.Image.GetIndex(), args.SourceImage, TZoom, srcY & (zoom - 1));
+    if (zoomedSprite == nullptr)
+    {
+        return false;
+    }
+
+    auto zoomedDpi = dpi;
+    zoomedDpi.width = dpi.width >> TZoom;
+    zoomedDpi.zoom_level = ZoomLevel{ 0 };
+    DrawSpriteArgs zoomedArgs(
+        args.Image, args.PalMap, zoomedSprite->Element, srcX >> TZoom, srcY >> TZoom, (args.Width + zoom - 1) >> TZoom,
+        (height + zoom - 1) >> TZoom, dst0);
+    DrawRLESpriteMinify<TBlendOp, 0>(zoomedDpi, zoomedArgs);
+    return true;
+}
+
+template<DrawBlendOp TBlendOp, size_t TZoom>
+static void FASTCALL DrawRLESpriteZoomedOut(rct_drawpixelinfo& dpi, const DrawSpriteArgs& args)
+{
+    if (!DrawRLESpriteMipCached<TBlendOp, TZoom>(dpi, args))
+    {
+        DrawRLESpriteMinify<TBlendOp, TZoom>(dpi, args);
+    }
+}
+
 template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(rct_drawpixelinfo& dpi, const DrawSpriteArgs& args)
 {
     auto zoom_level = static_cast<int8_t>(dpi.zoom_level);
@@ -193,13 +307,13 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(rct_drawpixeli
             DrawRLESpriteMinify<TBlendOp, 0>(dpi, args);
             break;
         case 1:
-            DrawRLESpriteMinify<TBlendOp, 1>(dpi, args);
+            DrawRLESpriteZoomedOut<TBlendOp, 1>(dpi, args);
             break;
         case 2:
-            DrawRLESpriteMinify<TBlendOp, 2>(dpi, args);
+            DrawRLESpriteZoomedOut<TBlendOp, 2>(dpi, args);
             break;
         case 3:
-            DrawRLESpriteMinify<TBlendOp, 3>(dpi, args);
+            DrawRLESpriteZoomedOut<TBlendOp, 3>(dpi, args);
             break;
         default:
             assert(false);
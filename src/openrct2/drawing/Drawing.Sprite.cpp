@@ -14,14 +14,20 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.h"
+#include "../core/MappedFile.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
+#include "Image.h"
 #include "ScrollingText.h"
+#include "SpriteMipCache.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -179,6 +185,21 @@ void mask_scalar(
     }
 }
 
+/**
+ * Returns the sprite data that follows the element headers in a mapped gx file. The data is left in the page cache
+ * rather than copied so it is only read from disk once a sprite is drawn.
+ */
+static uint8_t* gx_get_mapped_data(const MappedFile& file, uint64_t offset, uint32_t size)
+{
+    if (offset > file.GetLength() || file.GetLength() - offset < size)
+    {
+        throw IOException("Sprite data is truncated");
+    }
+    // Sprite data is never written to, the pointer is only non-const because rct_g1_element is shared with images that
+    // are built at runtime.
+    return const_cast<uint8_t*>(file.GetData()) + offset;
+}
+
 static rct_gx _g1 = {};
 static rct_gx _g2 = {};
 static rct_gx _csg = {};
@@ -189,6 +210,28 @@ static rct_g1_element _g1Temp = {};
 static std::vector<rct_g1_element> _imageListElements;
 bool gTinyFontAntiAliased = false;
 
+/**
+ * Palette maps composed for recoloured sprites, most sprites in a frame are drawn with a few colour combinations. Each
+ * thread keeps its own entries so the maps can be handed out without locking. An entry is only valid for the generation
+ * of the g1 palettes it was composed from.
+ */
+struct RemapPaletteCacheEntry
+{
+    uint32_t Key{};
+    uint32_t Generation{};
+    uint8_t Data[256]{};
+};
+
+static constexpr size_t RemapPaletteCacheShift = 26;
+static constexpr size_t RemapPaletteCacheSize = 1 << (32 - RemapPaletteCacheShift);
+static thread_local std::array<RemapPaletteCacheEntry, RemapPaletteCacheSize> _remapPaletteCache;
+static std::atomic<uint32_t> _remapPaletteGeneration = { 1 };
+
+static void RemapPaletteCacheInvalidate()
+{
+    _remapPaletteGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
 /**
  *
  *  rct2: 0x00678998
@@ -199,7 +242,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _g1.data = std::make_unique<MappedFile>(path);
+        auto fs = MemoryStream(_g1.data->GetData(), _g1.data->GetLength());
         _g1.header = fs.ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
@@ -215,20 +259,20 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
         // Fix entry data offsets
+        auto data = gx_get_mapped_data(*_g1.data, fs.GetPosition(), _g1.header.total_size);
         for (uint32_t i = 0; i < _g1.header.num_entries; i++)
         {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data.get());
+            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(data);
         }
+        RemapPaletteCacheInvalidate();
         return true;
     }
     catch (const std::exception&)
     {
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
+        _g1.data.reset();
 
         log_fatal("Unable to load g1 graphics");
         if (!gOpenRCT2Headless)
@@ -242,6 +286,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
+    SpriteMipCacheClear();
+    RemapPaletteCacheInvalidate();
     _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -249,6 +295,7 @@ void gfx_unload_g1()
 
 void gfx_unload_g2()
 {
+    SpriteMipCacheClear();
     _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -256,6 +303,7 @@ void gfx_unload_g2()
 
 void gfx_unload_csg()
 {
+    SpriteMipCacheClear();
     _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -271,20 +319,19 @@ bool gfx_load_g2()
 
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _g2.data = std::make_unique<MappedFile>(path);
+        auto fs = MemoryStream(_g2.data->GetData(), _g2.data->GetLength());
         _g2.header = fs.ReadValue<rct_g1_header>();
 
         // Read element headers
         _g2.elements.resize(_g2.header.num_entries);
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
-
         // Fix entry data offsets
+        auto data = gx_get_mapped_data(*_g2.data, fs.GetPosition(), _g2.header.total_size);
         for (uint32_t i = 0; i < _g2.header.num_entries; i++)
         {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data.get());
+            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(data);
         }
         return true;
     }
@@ -292,6 +339,7 @@ bool gfx_load_g2()
     {
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
+        _g2.data.reset();
 
         log_fatal("Unable to load g2 graphics");
         if (!gOpenRCT2Headless)
@@ -318,9 +366,9 @@ bool gfx_load_csg()
     try
     {
         auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        auto fileData = std::make_unique<MappedFile>(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        size_t fileDataSize = fileData->GetLength();
 
         _csg.header.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(rct_g1_element_32bit));
         _csg.header.total_size = static_cast<uint32_t>(fileDataSize);
@@ -335,13 +383,12 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
-
         // Fix entry data offsets
+        auto data = gx_get_mapped_data(*fileData, 0, _csg.header.total_size);
+        _csg.data = std::move(fileData);
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data.get());
+            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(data);
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -355,6 +402,7 @@ bool gfx_load_csg()
     {
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
+        _csg.data.reset();
 
         log_error("Unable to load csg graphics");
         return false;
@@ -373,10 +421,21 @@ static std::optional<PaletteMap> FASTCALL gfx_draw_sprite_get_palette(ImageId im
         return GetPaletteMapForColour(paletteId);
     }
 
-    auto paletteMap = PaletteMap(gPeepPalette);
-    if (imageId.HasTertiary())
+    const bool hasTertiary = imageId.HasTertiary();
+    const uint32_t key = (hasTertiary ? (1u << 24) | (imageId.GetTertiary() << 16) : 0)
+        | (imageId.GetSecondary() << 8) | imageId.GetPrimary();
+    const auto generation = _remapPaletteGeneration.load(std::memory_order_relaxed);
+    auto& entry = _remapPaletteCache[(key * 0x9E3779B1u) >> RemapPaletteCacheShift];
+    if (entry.Key == key && entry.Generation == generation)
+    {
+        return PaletteMap(entry.Data);
+    }
+
+    const auto& basePalette = hasTertiary ? gOtherPalette : gPeepPalette;
+    std::copy(std::begin(basePalette), std::end(basePalette), entry.Data);
+    auto paletteMap = PaletteMap(entry.Data);
+    if (hasTertiary)
     {
-        paletteMap = PaletteMap(gOtherPalette);
         auto tertiaryPaletteMap = GetPaletteMapForColour(imageId.GetTertiary());
         if (tertiaryPaletteMap.has_value())
         {
@@ -399,6 +458,8 @@ static std::optional<PaletteMap> FASTCALL gfx_draw_sprite_get_palette(ImageId im
             PALETTE_OFFSET_REMAP_SECONDARY, secondaryPaletteMap.value(), PALETTE_OFFSET_REMAP_PRIMARY, PALETTE_LENGTH_REMAP);
     }
 
+    entry.Key = key;
+    entry.Generation = generation;
     return paletteMap;
 }
 
@@ -713,6 +774,10 @@ const rct_g1_element* gfx_get_g1_element(ImageIndex image_id)
         size_t idx = offset - SPR_IMAGE_LIST_BEGIN;
         if (idx < _imageListElements.size())
         {
+            if (_imageListElements[idx].offset == nullptr)
+            {
+                gfx_object_load_pending_images(static_cast<uint32_t>(offset));
+            }
             return &_imageListElements[idx];
         }
     }
@@ -766,6 +831,9 @@ void gfx_set_g1_element(ImageIndex imageId, const rct_g1_element* g1)
             }
         }
     }
+
+    // After the element is replaced, so no drawing thread can cache the old image again.
+    SpriteMipCacheInvalidate(imageId);
 }
 
 bool is_csg_loaded()
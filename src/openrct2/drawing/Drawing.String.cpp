@@ -620,89 +620,88 @@ static void ttf_draw_string_raw_ttf(rct_drawpixelinfo* dpi, std::string_view tex
     dst += skipX;
     dst += skipY * (dpi->width + dpi->pitch);
 
-    int32_t srcScanSkip = surface->pitch - width;
-    int32_t dstScanSkip = dpi->width + dpi->pitch - width;
-    uint8_t* dst_orig = dst;
-    const uint8_t* src_orig = src;
+    const int32_t dstStride = dpi->width + dpi->pitch;
 
     // Draw shadow/outline
     if (info->flags & TEXT_DRAW_FLAG_OUTLINE)
     {
-        for (int32_t yy = 0; yy < height - 0; yy++)
+        // Every glyph pixel sets its four neighbours to the outline colour, as they all get the same colour the
+        // neighbours can be stamped a row at a time for each direction.
+        const uint8_t outlineColour = info->palette[3];
+        const int32_t rightCount = std::min(width, dstStride - 1 - skipX);
+        const int32_t leftStart = std::max(0, 2 - skipX);
+        for (int32_t yy = 0; yy < height; yy++)
         {
-            for (int32_t xx = 0; xx < width - 0; xx++)
+            const uint8_t* srcRow = src + yy * surface->pitch;
+            uint8_t* dstRow = dst + yy * dstStride;
+            // right
+            if (rightCount > 0)
             {
-                if (*src != 0)
-                {
-                    // right
-                    if (xx + skipX < dpi->width + dpi->pitch - 1)
-                    {
-                        *(dst + 1) = info->palette[3];
-                    }
-                    // left
-                    if (xx + skipX > 1)
-                    {
-                        *(dst - 1) = info->palette[3];
-                    }
-                    // top
-                    if (yy + skipY > 1)
-                    {
-                        *(dst - width - dstScanSkip) = info->palette[3];
-                    }
-                    // bottom
-                    if (yy + skipY < dpi->height - 1)
-                    {
-                        *(dst + width + dstScanSkip) = info->palette[3];
-                    }
-                }
-                src++;
-                dst++;
+                ttf_stamp_row_fn(srcRow, dstRow + 1, rightCount, outlineColour);
+            }
+            // left
+            if (width > leftStart)
+            {
+                ttf_stamp_row_fn(srcRow + leftStart, dstRow + leftStart - 1, width - leftStart, outlineColour);
+            }
+            // top
+            if (yy + skipY > 1)
+            {
+                ttf_stamp_row_fn(srcRow, dstRow - dstStride, width, outlineColour);
+            }
+            // bottom
+            if (yy + skipY < dpi->height - 1)
+            {
+                ttf_stamp_row_fn(srcRow, dstRow + dstStride, width, outlineColour);
             }
-            // Skip any remaining bits
-            src += srcScanSkip;
-            dst += dstScanSkip;
         }
     }
 
-    dst = dst_orig;
-    src = src_orig;
-    bool use_hinting = gConfigFonts.enable_hinting && fontDesc->hinting_threshold > 0;
+    // Without hinting every glyph pixel gets the full colour, with hinting only the centre of the glyph does and the
+    // edges above the threshold shade the background colour instead. As outlines are black, outlined texts always use
+    // a darker shade of the foreground colour for font hinting.
+    const bool useHinting = gConfigFonts.enable_hinting && fontDesc->hinting_threshold > 0;
+    const uint8_t fullAbove = useHinting ? 180 : 0;
+    const uint8_t blendAbove = static_cast<uint8_t>(std::min(useHinting ? fontDesc->hinting_threshold : 255, 255));
+    const int32_t blendWith = (info->flags & TEXT_DRAW_FLAG_OUTLINE) ? PALETTE_INDEX_0 : -1;
     for (int32_t yy = 0; yy < height; yy++)
     {
-        for (int32_t xx = 0; xx < width; xx++)
+        const uint8_t* srcRow = src + yy * surface->pitch;
+        uint8_t* dstRow = dst + yy * dstStride;
+        if (info->flags & TEXT_DRAW_FLAG_INSET)
         {
-            if (*src != 0)
-            {
-                if (info->flags & TEXT_DRAW_FLAG_INSET)
-                {
-                    *(dst + width + dstScanSkip + 1) = info->palette[3];
-                }
+            // Only reaches the next row, which is drawn after this one like it was drawn pixel by pixel.
+            ttf_stamp_row_fn(srcRow, dstRow + dstStride + 1, width, info->palette[3]);
+        }
+        ttf_glyph_row_fn(srcRow, dstRow, width, colour, fullAbove, blendAbove, blendWith);
+    }
+}
 
-                if (*src > 180 || !use_hinting)
-                {
-                    // Centre of the glyph: use full colour.
-                    *dst = colour;
-                }
-                else if (use_hinting && *src > fontDesc->hinting_threshold)
-                {
-                    // Simulate font hinting by shading the background colour instead.
-                    if (info->flags & TEXT_DRAW_FLAG_OUTLINE)
-                    {
-                        // As outlines are black, these texts should always use a darker shade
-                        // of the foreground colour for font hinting.
-                        *dst = blendColours(colour, PALETTE_INDEX_0);
-                    }
-                    else
-                    {
-                        *dst = blendColours(colour, *dst);
-                    }
-                }
-            }
-            src++;
-            dst++;
+void ttf_stamp_row_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            dst[i] = colour;
+        }
+    }
+}
+
+void ttf_glyph_row_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] > fullAbove)
+        {
+            dst[i] = colour;
+        }
+        else if (src[i] > blendAbove)
+        {
+            dst[i] = blendColours(colour, blendWith < 0 ? dst[i] : static_cast<uint8_t>(blendWith));
         }
-        src += srcScanSkip;
-        dst += dstScanSkip;
     }
 }
 
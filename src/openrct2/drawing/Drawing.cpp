@@ -552,25 +552,107 @@ void (*mask_fn)(
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap)
     = nullptr;
 
-void mask_init()
+void (*rle_remap_src_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+    = rle_remap_src_scalar;
+void (*rle_remap_dst_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+    = rle_remap_dst_scalar;
+
+#ifndef NO_TTF
+void (*ttf_stamp_row_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour)
+    = ttf_stamp_row_scalar;
+void (*ttf_glyph_row_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith)
+    = ttf_glyph_row_scalar;
+#endif
+
+#ifdef __ENABLE_LIGHTFX__
+void (*lightfx_add_row_fn)(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale)
+    = lightfx_add_row_scalar;
+void (*lightfx_mix_row_fn)(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+    = lightfx_mix_row_scalar;
+#endif
+
+DrawingSimd drawing_simd_get_best()
 {
     if (avx2_available())
     {
-        log_verbose("registering AVX2 mask function");
-        mask_fn = mask_avx2;
+        return DrawingSimd::AVX2;
     }
-    else if (sse41_available())
+    if (sse41_available())
     {
-        log_verbose("registering SSE4.1 mask function");
-        mask_fn = mask_sse4_1;
+        return DrawingSimd::SSE4_1;
     }
-    else
+    return DrawingSimd::Scalar;
+}
+
+const char* drawing_simd_get_name(DrawingSimd simd)
+{
+    switch (simd)
     {
-        log_verbose("registering scalar mask function");
-        mask_fn = mask_scalar;
+        case DrawingSimd::AVX2:
+            return "AVX2";
+        case DrawingSimd::SSE4_1:
+            return "SSE4.1";
+        default:
+            return "scalar";
     }
 }
 
+void drawing_simd_select(DrawingSimd simd)
+{
+    log_verbose("registering %s drawing functions", drawing_simd_get_name(simd));
+    switch (simd)
+    {
+        case DrawingSimd::AVX2:
+            mask_fn = mask_avx2;
+            rle_remap_src_fn = rle_remap_src_avx2;
+            rle_remap_dst_fn = rle_remap_dst_avx2;
+#ifndef NO_TTF
+            ttf_stamp_row_fn = ttf_stamp_row_avx2;
+            ttf_glyph_row_fn = ttf_glyph_row_avx2;
+#endif
+#ifdef __ENABLE_LIGHTFX__
+            lightfx_add_row_fn = lightfx_add_row_avx2;
+            lightfx_mix_row_fn = lightfx_mix_row_avx2;
+#endif
+            break;
+        case DrawingSimd::SSE4_1:
+            mask_fn = mask_sse4_1;
+            rle_remap_src_fn = rle_remap_src_sse4_1;
+            rle_remap_dst_fn = rle_remap_dst_sse4_1;
+#ifndef NO_TTF
+            ttf_stamp_row_fn = ttf_stamp_row_sse4_1;
+            ttf_glyph_row_fn = ttf_glyph_row_sse4_1;
+#endif
+#ifdef __ENABLE_LIGHTFX__
+            lightfx_add_row_fn = lightfx_add_row_sse4_1;
+            lightfx_mix_row_fn = lightfx_mix_row_sse4_1;
+#endif
+            break;
+        default:
+            mask_fn = mask_scalar;
+            rle_remap_src_fn = rle_remap_src_scalar;
+            rle_remap_dst_fn = rle_remap_dst_scalar;
+#ifndef NO_TTF
+            ttf_stamp_row_fn = ttf_stamp_row_scalar;
+            ttf_glyph_row_fn = ttf_glyph_row_scalar;
+#endif
+#ifdef __ENABLE_LIGHTFX__
+            lightfx_add_row_fn = lightfx_add_row_scalar;
+            lightfx_mix_row_fn = lightfx_mix_row_scalar;
+#endif
+            break;
+    }
+}
+
+void mask_init()
+{
+    drawing_simd_select(drawing_simd_get_best());
+}
+
 void gfx_filter_pixel(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     gfx_filter_rect(dpi, { coords, coords }, palette);
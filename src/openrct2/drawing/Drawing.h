@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/MappedFile.h"
 #include "../interface/Colour.h"
 #include "../interface/ZoomLevel.h"
 #include "../world/Location.hpp"
@@ -99,7 +100,8 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    std::unique_ptr<uint8_t[]> data;
+    // The element offsets point into the mapped file, so it must outlive them.
+    std::unique_ptr<OpenRCT2::MappedFile> data;
 };
 
 struct rct_drawpixelinfo
@@ -358,6 +360,15 @@ public:
     uint8_t& operator[](size_t index);
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    /**
+     * Raw access to the map for the vectorised blitters.
+     * @return The map data or nullptr if the map does not cover every palette index.
+     */
+    const uint8_t* GetFullMap() const
+    {
+        return _dataLength >= 256 ? _data : nullptr;
+    }
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -474,6 +485,8 @@ void FASTCALL BlitPixels(const uint8_t* src, uint8_t* dst, const PaletteMap& pal
 #define MAX_SCROLLING_TEXT_MODES 38
 
 extern GamePalette gPalette;
+// Incremented whenever gPalette changes, drawing engines use it to skip applying a palette they already have.
+extern uint32_t gPaletteGeneration;
 extern uint8_t gGamePalette[256 * 4];
 extern uint32_t gPaletteEffectFrame;
 extern const FilterPaletteID GlassPaletteIds[COLOUR_COUNT];
@@ -597,6 +610,75 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+// Transparent RLE run blitters, remapping either the source or the destination pixel through a full 256 entry map.
+void rle_remap_src_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+void rle_remap_src_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+void rle_remap_src_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+void rle_remap_dst_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+void rle_remap_dst_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+void rle_remap_dst_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+
+extern void (*rle_remap_src_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+extern void (*rle_remap_dst_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count);
+
+#ifndef NO_TTF
+// TrueType text rows: stamping a colour wherever the glyph surface is set, used for outlines and insets, and drawing
+// the glyph itself, where coverage above fullAbove gets the full colour and coverage above blendAbove is blended with
+// blendWith, or with the destination pixel when blendWith is negative.
+void ttf_stamp_row_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour);
+void ttf_stamp_row_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour);
+void ttf_stamp_row_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour);
+void ttf_glyph_row_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith);
+void ttf_glyph_row_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith);
+void ttf_glyph_row_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith);
+
+extern void (*ttf_stamp_row_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour);
+extern void (*ttf_glyph_row_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith);
+#endif
+
+#ifdef __ENABLE_LIGHTFX__
+// Light map rows: saturating accumulation of a light texture scaled by scale / 256, and mixing of the lit palette
+// colours into the unlit ones by the accumulated light.
+void lightfx_add_row_scalar(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale);
+void lightfx_add_row_sse4_1(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale);
+void lightfx_add_row_avx2(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale);
+void lightfx_mix_row_scalar(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+void lightfx_mix_row_sse4_1(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+void lightfx_mix_row_avx2(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+
+extern void (*lightfx_add_row_fn)(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale);
+extern void (*lightfx_mix_row_fn)(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+#endif
+
+enum class DrawingSimd : uint8_t
+{
+    Scalar,
+    SSE4_1,
+    AVX2,
+};
+
+DrawingSimd drawing_simd_get_best();
+const char* drawing_simd_get_name(DrawingSimd simd);
+void drawing_simd_select(DrawingSimd simd);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 
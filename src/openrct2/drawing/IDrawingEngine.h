@@ -42,6 +42,18 @@ enum DRAWING_ENGINE_FLAGS
 struct rct_drawpixelinfo;
 struct GamePalette;
 
+/**
+ * How much of the screen a frame had to redraw, for engines that only redraw what changed.
+ */
+struct DirtyGridStats
+{
+    // Blocks that were invalidated.
+    uint32_t DirtyBlocks{};
+    // Blocks that were redrawn, clean blocks between dirty ones are redrawn when that is cheaper than more regions.
+    uint32_t DrawnBlocks{};
+    uint32_t Regions{};
+};
+
 namespace OpenRCT2::Ui
 {
     struct IUiContext;
@@ -72,11 +84,23 @@ namespace OpenRCT2::Drawing
         virtual std::string Screenshot() abstract;
 
         virtual IDrawingContext* GetDrawingContext() abstract;
+
+        /**
+         * Called before and after viewport columns are drawn on several threads at once, only used by engines
+         * with DEF_PARALLEL_DRAWING.
+         */
+        virtual void BeginParallelDraw() abstract;
+        virtual void EndParallelDraw() abstract;
         virtual rct_drawpixelinfo* GetDrawingPixelInfo() abstract;
 
         virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
         virtual void InvalidateImage(uint32_t image) abstract;
+
+        /**
+         * @return the redraw statistics of the last frame, all zero for engines that redraw the whole screen.
+         */
+        virtual DirtyGridStats GetDirtyGridStats() abstract;
     };
 
     struct IDrawingEngineFactory
@@ -12,11 +12,15 @@
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
+#include "../object/ImageTable.h"
 #include "../sprites.h"
 #include "Drawing.h"
 
 #include <algorithm>
+#include <atomic>
 #include <list>
+#include <mutex>
+#include <vector>
 
 constexpr uint32_t BASE_IMAGE_ID = SPR_IMAGE_LIST_BEGIN;
 constexpr uint32_t MAX_IMAGES = SPR_IMAGE_LIST_END - BASE_IMAGE_ID;
@@ -26,6 +30,16 @@ static bool _initialised = false;
 static std::list<ImageList> _freeLists;
 static uint32_t _allocatedImageCount;
 
+// Image lists whose image data has not been loaded yet
+struct PendingImageList
+{
+    ImageList Images;
+    const ImageTable* Table;
+};
+static std::vector<PendingImageList> _pendingImageLists;
+static std::atomic<size_t> _pendingImageListCount;
+static std::mutex _pendingImageListsMutex;
+
 #ifdef DEBUG_LEVEL_1
 static std::list<ImageList> _allocatedLists;
 
@@ -211,10 +225,78 @@ uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count
     return baseImageId;
 }
 
+/**
+ * Allocates the images of an image table, image data that is still pending is loaded once one of the images is first
+ * requested from gfx_get_g1_element.
+ */
+uint32_t gfx_object_allocate_images(const ImageTable& imageTable)
+{
+    if (imageTable.IsLoaded())
+    {
+        return gfx_object_allocate_images(imageTable.GetImages(), imageTable.GetCount());
+    }
+
+    auto count = imageTable.GetCount();
+    auto baseImageId = gfx_object_allocate_images(imageTable.GetImageHeaders(), count);
+    if (baseImageId != INVALID_IMAGE_ID)
+    {
+        std::lock_guard<std::mutex> lock(_pendingImageListsMutex);
+        _pendingImageLists.push_back({ { baseImageId, count }, &imageTable });
+        _pendingImageListCount = _pendingImageLists.size();
+    }
+    return baseImageId;
+}
+
+/**
+ * Loads the image data of the pending image list containing the given image, may be called from any drawing thread.
+ */
+void gfx_object_load_pending_images(uint32_t imageId)
+{
+    if (_pendingImageListCount == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_pendingImageListsMutex);
+    auto it = std::find_if(_pendingImageLists.begin(), _pendingImageLists.end(), [imageId](const PendingImageList& list) {
+        return imageId >= list.Images.BaseId && imageId < list.Images.BaseId + list.Images.Count;
+    });
+    if (it != _pendingImageLists.end())
+    {
+        const auto* images = it->Table->GetImages();
+        for (uint32_t i = 0; i < it->Images.Count; i++)
+        {
+            gfx_set_g1_element(it->Images.BaseId + i, &images[i]);
+        }
+        _pendingImageLists.erase(it);
+        _pendingImageListCount = _pendingImageLists.size();
+    }
+}
+
+static void RemovePendingImageList(uint32_t baseImageId)
+{
+    if (_pendingImageListCount == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_pendingImageListsMutex);
+    auto it = std::find_if(_pendingImageLists.begin(), _pendingImageLists.end(), [baseImageId](const PendingImageList& list) {
+        return list.Images.BaseId == baseImageId;
+    });
+    if (it != _pendingImageLists.end())
+    {
+        _pendingImageLists.erase(it);
+        _pendingImageListCount = _pendingImageLists.size();
+    }
+}
+
 void gfx_object_free_images(uint32_t baseImageId, uint32_t count)
 {
     if (baseImageId != 0 && baseImageId != INVALID_IMAGE_ID)
     {
+        RemovePendingImageList(baseImageId);
+
         // Zero the G1 elements so we don't have invalid pointers
         // and data lying about
         for (uint32_t i = 0; i < count; i++)
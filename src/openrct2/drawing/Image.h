@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <list>
 
+class ImageTable;
 struct rct_g1_element;
 
 struct ImageList
@@ -22,6 +23,8 @@ struct ImageList
 };
 
 uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count);
+uint32_t gfx_object_allocate_images(const ImageTable& imageTable);
+void gfx_object_load_pending_images(uint32_t imageId);
 void gfx_object_free_images(uint32_t baseImageId, uint32_t count);
 void gfx_object_check_all_images_freed();
 size_t ImageListGetUsedCount();
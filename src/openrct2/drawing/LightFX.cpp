@@ -14,6 +14,7 @@
 #    include "../Game.h"
 #    include "../common.h"
 #    include "../config/Config.h"
+#    include "../core/JobPool.h"
 #    include "../entity/EntityRegistry.h"
 #    include "../interface/Viewport.h"
 #    include "../interface/Window.h"
@@ -29,6 +30,8 @@
 #    include <algorithm>
 #    include <cmath>
 #    include <cstring>
+#    include <memory>
+#    include <vector>
 
 static uint8_t _bakedLightTexture_lantern_0[32 * 32];
 static uint8_t _bakedLightTexture_lantern_1[64 * 64];
@@ -86,6 +89,23 @@ static ZoomLevel _current_view_zoom_back_delay{ 0 };
 
 static GamePalette gPalette_light;
 
+struct LightBlit
+{
+    const uint8_t* Src;
+    uint32_t SrcWidth;
+    int32_t X;
+    int32_t Y;
+    int32_t Width;
+    int32_t Height;
+    uint32_t Scale;
+};
+
+// Rows of the light buffer accumulated and composited by a single task
+constexpr int32_t LIGHTFX_BAND_HEIGHT = 64;
+
+static std::vector<LightBlit> _lightBlits;
+static std::unique_ptr<JobPool> _lightJobs;
+
 static uint8_t calc_light_intensity_lantern(int32_t x, int32_t y)
 {
     double distance = static_cast<double>(x * x + y * y);
@@ -445,6 +465,82 @@ void lightfx_update_viewport_settings()
     }
 }
 
+void lightfx_add_row_scalar(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        dst[i] = std::min<uint32_t>(0xFF, dst[i] + ((src[i] * scale) >> 8));
+    }
+}
+
+static uint8_t mix_light(uint32_t a, uint32_t b, uint32_t intensity)
+{
+    intensity = intensity * 6;
+    uint32_t bMul = (b * intensity) >> 8;
+    uint32_t ab = a + bMul;
+    uint8_t result = std::min<uint32_t>(255, ab);
+    return result;
+}
+
+void lightfx_mix_row_scalar(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    for (int32_t x = 0; x < count; x++)
+    {
+        uint32_t darkColour = palette[bits[x]];
+        uint32_t lightColour = lightPalette[bits[x]];
+        uint8_t lightIntensity = light[x];
+
+        uint32_t colour = 0;
+        if (lightIntensity == 0)
+        {
+            colour = darkColour;
+        }
+        else
+        {
+            colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+            colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+            colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+            colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+        }
+        dst[x] = colour;
+    }
+}
+
+/**
+ * Runs fn for every band of LIGHTFX_BAND_HEIGHT rows of the light buffer, on the job pool when
+ * multithreading is enabled. Bands never overlap so they can be written without synchronisation.
+ */
+template<typename TFn> static void lightfx_for_each_band(int32_t height, TFn&& fn)
+{
+    if (gConfigGeneral.multithreading && _lightJobs == nullptr)
+    {
+        _lightJobs = std::make_unique<JobPool>(255, "Light");
+    }
+    else if (!gConfigGeneral.multithreading && _lightJobs != nullptr)
+    {
+        _lightJobs.reset();
+    }
+
+    for (int32_t top = 0; top < height; top += LIGHTFX_BAND_HEIGHT)
+    {
+        const auto bottom = std::min(top + LIGHTFX_BAND_HEIGHT, height);
+        if (_lightJobs != nullptr)
+        {
+            _lightJobs->AddTask([&fn, top, bottom]() { fn(top, bottom); });
+        }
+        else
+        {
+            fn(top, bottom);
+        }
+    }
+    if (_lightJobs != nullptr)
+    {
+        _lightJobs->Join();
+    }
+}
+
 void lightfx_render_lights_to_frontbuffer()
 {
     if (_light_rendered_buffer_front == nullptr)
@@ -452,20 +548,18 @@ void lightfx_render_lights_to_frontbuffer()
         return;
     }
 
-    std::memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
-
     _lightPolution_back = 0;
+    _lightBlits.clear();
 
     //  log_warning("%i lights", LightListCurrentCountFront);
 
+    // Clip every light against the screen first, the bands then only have to intersect the rows.
     for (uint32_t light = 0; light < LightListCurrentCountFront; light++)
     {
         const uint8_t* bufReadBase = nullptr;
-        uint8_t* bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
         uint32_t bufReadWidth, bufReadHeight;
         int32_t bufWriteX, bufWriteY;
         int32_t bufWriteWidth, bufWriteHeight;
-        uint32_t bufReadSkip, bufWriteSkip;
 
         LightListEntry* entry = &_LightListFront[light];
 
@@ -536,10 +630,7 @@ void lightfx_render_lights_to_frontbuffer()
         {
             bufReadBase += -bufWriteX;
             bufWriteWidth += bufWriteX;
-        }
-        else
-        {
-            bufWriteBase += bufWriteX;
+            bufWriteX = 0;
         }
 
         if (bufWriteWidth <= 0)
@@ -549,10 +640,7 @@ void lightfx_render_lights_to_frontbuffer()
         {
             bufReadBase += -bufWriteY * bufReadWidth;
             bufWriteHeight += bufWriteY;
-        }
-        else
-        {
-            bufWriteBase += bufWriteY * _pixelInfo.width;
+            bufWriteY = 0;
         }
 
         if (bufWriteHeight <= 0)
@@ -577,40 +665,25 @@ void lightfx_render_lights_to_frontbuffer()
 
         _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
 
-        bufReadSkip = bufReadWidth - bufWriteWidth;
-        bufWriteSkip = _pixelInfo.width - bufWriteWidth;
-
-        if (entry->LightIntensity == 0xFF)
-        {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
+        _lightBlits.push_back({ bufReadBase, bufReadWidth, bufWriteX, bufWriteY, bufWriteWidth, bufWriteHeight,
+                                1u + entry->LightIntensity });
+    }
 
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
-        }
-        else
+    auto* bufWriteBase = static_cast<uint8_t*>(_light_rendered_buffer_front);
+    const int32_t width = _pixelInfo.width;
+    lightfx_for_each_band(_pixelInfo.height, [bufWriteBase, width](int32_t top, int32_t bottom) {
+        std::memset(bufWriteBase + top * width, 0, static_cast<size_t>(bottom - top) * width);
+        for (const auto& blit : _lightBlits)
         {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
+            const auto y0 = std::max(blit.Y, top);
+            const auto y1 = std::min(blit.Y + blit.Height, bottom);
+            for (int32_t y = y0; y < y1; y++)
             {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->LightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
+                lightfx_add_row_fn(
+                    bufWriteBase + y * width + blit.X, blit.Src + (y - blit.Y) * blit.SrcWidth, blit.Width, blit.Scale);
             }
         }
-    }
+    });
 }
 
 void* lightfx_get_front_buffer()
@@ -1014,15 +1087,6 @@ void lightfx_apply_palette_filter(uint8_t i, uint8_t* r, uint8_t* g, uint8_t* b)
     }
 }
 
-static uint8_t mix_light(uint32_t a, uint32_t b, uint32_t intensity)
-{
-    intensity = intensity * 6;
-    uint32_t bMul = (b * intensity) >> 8;
-    uint32_t ab = a + bMul;
-    uint8_t result = std::min<uint32_t>(255, ab);
-    return result;
-}
-
 void lightfx_render_to_texture(
     void* dstPixels, uint32_t dstPitch, uint8_t* bits, uint32_t width, uint32_t height, const uint32_t* palette,
     const uint32_t* lightPalette)
@@ -1038,32 +1102,14 @@ void lightfx_render_to_texture(
         return;
     }
 
-    for (uint32_t y = 0; y < height; y++)
-    {
-        uintptr_t dstOffset = static_cast<uintptr_t>(y * dstPitch);
-        uint32_t* dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(dstPixels) + dstOffset);
-        for (uint32_t x = 0; x < width; x++)
+    lightfx_for_each_band(static_cast<int32_t>(height), [=](int32_t top, int32_t bottom) {
+        for (int32_t y = top; y < bottom; y++)
         {
-            uint8_t* src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
-
-            uint32_t colour = 0;
-            if (lightIntensity == 0)
-            {
-                colour = darkColour;
-            }
-            else
-            {
-                colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-                colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-                colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-                colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
-            }
-            *dst++ = colour;
+            auto* dst = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(dstPixels) + static_cast<size_t>(y) * dstPitch);
+            const auto offset = static_cast<size_t>(y) * width;
+            lightfx_mix_row_fn(dst, bits + offset, lightBits + offset, static_cast<int32_t>(width), palette, lightPalette);
         }
-    }
+    });
 }
 
 #endif // __ENABLE_LIGHTFX__
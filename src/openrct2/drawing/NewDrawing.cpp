@@ -76,6 +76,8 @@ void drawing_engine_resize()
         {
             auto uiContext = context->GetUiContext();
             drawingEngine->Resize(uiContext->GetWidth(), uiContext->GetHeight());
+            // Engines recreate their palette surfaces when resized, the palette is not pushed again until it changes.
+            drawingEngine->SetPalette(gPalette);
         }
     }
 }
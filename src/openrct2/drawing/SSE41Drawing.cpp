@@ -9,10 +9,12 @@
 
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../interface/Colour.h"
 #include "Drawing.h"
 
 #ifdef __SSE4_1__
 
+#    include <cstring>
 #    include <immintrin.h>
 
 void mask_sse4_1(
@@ -56,6 +58,146 @@ void mask_sse4_1(
     }
 }
 
+template<bool TRemapDst>
+static void rle_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    const __m128i zero128 = {};
+    alignas(16) uint8_t remapped[16];
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // There is no byte gather, so only the lookups stay scalar and the transparency tests are done as a blend.
+        const uint8_t* lookup = TRemapDst ? dst + i : src + i;
+        for (int32_t j = 0; j < 16; j++)
+        {
+            remapped[j] = map[lookup[j]];
+        }
+        const __m128i source = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i pixels = _mm_load_si128(reinterpret_cast<const __m128i*>(remapped));
+        const __m128i skip = _mm_or_si128(_mm_cmpeq_epi8(source, zero128), _mm_cmpeq_epi8(pixels, zero128));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, skip));
+    }
+
+    if constexpr (TRemapDst)
+    {
+        rle_remap_dst_scalar(src + i, dst + i, map, count - i);
+    }
+    else
+    {
+        rle_remap_src_scalar(src + i, dst + i, map, count - i);
+    }
+}
+
+void rle_remap_src_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    rle_remap_sse4_1<false>(src, dst, map, count);
+}
+
+void rle_remap_dst_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    rle_remap_sse4_1<true>(src, dst, map, count);
+}
+
+#    ifndef NO_TTF
+void ttf_stamp_row_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour)
+{
+    const __m128i zero128 = {};
+    const __m128i colour128 = _mm_set1_epi8(static_cast<char>(colour));
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i source = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i blended = _mm_blendv_epi8(colour128, dest, _mm_cmpeq_epi8(source, zero128));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), blended);
+    }
+    ttf_stamp_row_scalar(src + i, dst + i, count - i, colour);
+}
+
+void ttf_glyph_row_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith)
+{
+    const __m128i zero128 = {};
+    const __m128i colour128 = _mm_set1_epi8(static_cast<char>(colour));
+    const __m128i fullAbove128 = _mm_set1_epi8(static_cast<char>(fullAbove));
+    const __m128i blendAbove128 = _mm_set1_epi8(static_cast<char>(blendAbove));
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // There is no unsigned byte compare, a saturated subtraction is only zero when source is not above the limit.
+        const __m128i source = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i notFull = _mm_cmpeq_epi8(_mm_subs_epu8(source, fullAbove128), zero128);
+        const __m128i blend = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_subs_epu8(source, blendAbove128), zero128), notFull);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(colour128, dest, notFull));
+
+        // Only the edges of hinted glyphs blend, the blend goes through the palette so these pixels stay scalar.
+        uint32_t blendMask = static_cast<uint32_t>(_mm_movemask_epi8(blend));
+        for (int32_t j = 0; blendMask != 0; j++, blendMask >>= 1)
+        {
+            if (blendMask & 1)
+            {
+                dst[i + j] = blendColours(colour, blendWith < 0 ? dst[i + j] : static_cast<uint8_t>(blendWith));
+            }
+        }
+    }
+    ttf_glyph_row_scalar(src + i, dst + i, count - i, colour, fullAbove, blendAbove, blendWith);
+}
+#    endif
+
+#    ifdef __ENABLE_LIGHTFX__
+void lightfx_add_row_sse4_1(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale)
+{
+    const __m128i zero128 = {};
+    const __m128i scale128 = _mm_set1_epi16(static_cast<int16_t>(scale));
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // (src * scale) >> 8 is the high half of (src << 8) * scale
+        const __m128i source = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo = _mm_mulhi_epu16(_mm_slli_epi16(_mm_unpacklo_epi8(source, zero128), 8), scale128);
+        const __m128i hi = _mm_mulhi_epu16(_mm_slli_epi16(_mm_unpackhi_epi8(source, zero128), 8), scale128);
+        const __m128i dest = _mm_lddqu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(dest, _mm_packus_epi16(lo, hi)));
+    }
+    lightfx_add_row_scalar(dst + i, src + i, count - i, scale);
+}
+
+void lightfx_mix_row_sse4_1(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    const __m128i zero128 = {};
+    const __m128i six = _mm_set1_epi16(6);
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i dark = _mm_setr_epi32(
+            palette[bits[i]], palette[bits[i + 1]], palette[bits[i + 2]], palette[bits[i + 3]]);
+        const __m128i lit = _mm_setr_epi32(
+            lightPalette[bits[i]], lightPalette[bits[i + 1]], lightPalette[bits[i + 2]], lightPalette[bits[i + 3]]);
+
+        // Spread the intensity of each pixel over its four channels
+        int32_t intensities;
+        std::memcpy(&intensities, light + i, sizeof(intensities));
+        const __m128i factor = _mm_mullo_epi16(_mm_cvtepu8_epi16(_mm_cvtsi32_si128(intensities)), six);
+        const __m128i factorPairs = _mm_unpacklo_epi16(factor, factor);
+        const __m128i factorLo = _mm_unpacklo_epi32(factorPairs, factorPairs);
+        const __m128i factorHi = _mm_unpackhi_epi32(factorPairs, factorPairs);
+
+        // dark + ((lit * intensity * 6) >> 8), saturated by the pack
+        const __m128i litLo = _mm_mulhi_epu16(_mm_slli_epi16(_mm_unpacklo_epi8(lit, zero128), 8), factorLo);
+        const __m128i litHi = _mm_mulhi_epu16(_mm_slli_epi16(_mm_unpackhi_epi8(lit, zero128), 8), factorHi);
+        const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(dark, zero128), litLo);
+        const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(dark, zero128), litHi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    lightfx_mix_row_scalar(dst + i, bits + i, light + i, count - i, palette, lightPalette);
+}
+#    endif
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +211,42 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void rle_remap_src_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void rle_remap_dst_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT map, int32_t count)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#    ifndef NO_TTF
+void ttf_stamp_row_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void ttf_glyph_row_sse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, uint8_t colour, uint8_t fullAbove, uint8_t blendAbove,
+    int32_t blendWith)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+#    endif
+
+#    ifdef __ENABLE_LIGHTFX__
+void lightfx_add_row_sse4_1(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, int32_t count, uint32_t scale)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void lightfx_mix_row_sse4_1(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT bits, const uint8_t* RESTRICT light, int32_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+#    endif
+
 #endif // __SSE4_1__
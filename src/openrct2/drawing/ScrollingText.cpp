@@ -22,7 +22,10 @@
 #include "TTF.h"
 
 #include <algorithm>
+#include <array>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -42,10 +45,78 @@ static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8
 static uint32_t _drawSCrollNextIndex = 0;
 static std::mutex _scrollingTextMutex;
 
-static void scrolling_text_set_bitmap_for_sprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
-static void scrolling_text_set_bitmap_for_ttf(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
+/**
+ * Identifies the formatted text of a scrolling text strip, independent of its scroll position and mode.
+ */
+struct ScrollingTextStripKey
+{
+    rct_string_id StringId{};
+    std::array<uint8_t, 32> StringArgs{};
+    colour_t Colour{};
+    bool UpperCase{};
+    bool TrueType{};
+    bool Hinting{};
+
+    bool operator==(const ScrollingTextStripKey& other) const
+    {
+        return StringId == other.StringId && StringArgs == other.StringArgs && Colour == other.Colour
+            && UpperCase == other.UpperCase && TrueType == other.TrueType && Hinting == other.Hinting;
+    }
+};
+
+struct ScrollingTextStripKeyHash
+{
+    size_t operator()(const ScrollingTextStripKey& key) const
+    {
+        // FNV-1a
+        size_t hash = 2166136261u;
+        auto addByte = [&hash](uint8_t value) {
+            hash ^= value;
+            hash *= 16777619u;
+        };
+        addByte(key.StringId & 0xFF);
+        addByte(key.StringId >> 8);
+        for (auto value : key.StringArgs)
+            addByte(value);
+        addByte(key.Colour);
+        addByte((key.UpperCase ? 1 : 0) | (key.TrueType ? 2 : 0) | (key.Hinting ? 4 : 0));
+        return hash;
+    }
+};
+
+struct ScrollingTextColumn
+{
+    colour_t Colour;
+    // Bit n is set for the pixels of row n
+    uint8_t Solid;
+    uint8_t Hinted;
+};
+
+/**
+ * The columns of the rendered text, a scroll position is drawn by copying the columns starting at that position.
+ * Sprite font strips hold the text repeated four times and end there, TrueType strips hold it once and wrap around.
+ */
+struct ScrollingTextStrip
+{
+    std::vector<ScrollingTextColumn> Columns;
+    bool Wraps{};
+    uint32_t LastUsed{};
+};
+
+// Each column takes three bytes, this keeps the cache below a megabyte.
+static constexpr size_t MaxScrollingTextStripColumns = 320 * 1024;
+
+static std::unordered_map<ScrollingTextStripKey, ScrollingTextStrip, ScrollingTextStripKeyHash> _scrollingTextStrips;
+static size_t _scrollingTextStripColumns = 0;
+
+static void scrolling_text_build_strip_for_sprite(std::string_view text, colour_t colour, ScrollingTextStrip& strip);
+static void scrolling_text_build_strip_for_ttf(std::string_view text, colour_t colour, ScrollingTextStrip& strip);
+
+static void scrolling_text_clear_strips()
+{
+    _scrollingTextStrips.clear();
+    _scrollingTextStripColumns = 0;
+}
 
 void scrolling_text_initialise_bitmaps()
 {
@@ -99,6 +170,12 @@ void scrolling_text_initialise_bitmaps()
         }
     }
 
+    {
+        // The glyphs or the font may have changed
+        std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+        scrolling_text_clear_strips();
+    }
+
     for (int32_t i = 0; i < OpenRCT2::MaxScrollingTextEntries; i++)
     {
         const int32_t imageId = SPR_SCROLLING_TEXT_START + i;
@@ -1439,11 +1516,124 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void scrolling_text_invalidate()
 {
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
     for (auto& scrollText : _drawScrollTextList)
     {
         scrollText.string_id = 0;
         std::memset(scrollText.string_args, 0, sizeof(scrollText.string_args));
     }
+    scrolling_text_clear_strips();
+}
+
+/**
+ * Drops the least recently used strips until the cache is back to three quarters of its budget.
+ */
+static void scrolling_text_evict_strips()
+{
+    std::vector<std::pair<uint32_t, const ScrollingTextStripKey*>> strips;
+    strips.reserve(_scrollingTextStrips.size());
+    for (const auto& [key, strip] : _scrollingTextStrips)
+    {
+        strips.emplace_back(strip.LastUsed, &key);
+    }
+    std::sort(strips.begin(), strips.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [lastUsed, key] : strips)
+    {
+        if (_scrollingTextStripColumns <= MaxScrollingTextStripColumns * 3 / 4)
+            break;
+
+        auto it = _scrollingTextStrips.find(*key);
+        _scrollingTextStripColumns -= it->second.Columns.size();
+        _scrollingTextStrips.erase(it);
+    }
+}
+
+static const ScrollingTextStrip& scrolling_text_get_strip(rct_draw_scroll_text* scrollText)
+{
+    ScrollingTextStripKey key;
+    key.StringId = scrollText->string_id;
+    std::copy_n(scrollText->string_args, key.StringArgs.size(), key.StringArgs.begin());
+    key.Colour = scrollText->colour;
+    key.UpperCase = gConfigGeneral.upper_case_banners;
+    key.TrueType = LocalisationService_UseTrueTypeFont();
+    key.Hinting = gConfigFonts.enable_hinting;
+
+    auto it = _scrollingTextStrips.find(key);
+    if (it == _scrollingTextStrips.end())
+    {
+        if (_scrollingTextStripColumns > MaxScrollingTextStripColumns)
+        {
+            scrolling_text_evict_strips();
+        }
+
+        // Create the string to draw
+        utf8 scrollString[256];
+        scrolling_text_format(scrollString, 256, scrollText);
+
+        ScrollingTextStrip strip;
+        if (key.TrueType)
+        {
+            scrolling_text_build_strip_for_ttf(scrollString, key.Colour, strip);
+        }
+        else
+        {
+            scrolling_text_build_strip_for_sprite(scrollString, key.Colour, strip);
+        }
+        _scrollingTextStripColumns += strip.Columns.size();
+        it = _scrollingTextStrips.emplace(key, std::move(strip)).first;
+    }
+    it->second.LastUsed = _drawSCrollNextIndex;
+    return it->second;
+}
+
+static void scrolling_text_draw_strip(
+    const ScrollingTextStrip& strip, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets)
+{
+    const auto numColumns = strip.Columns.size();
+    if (numColumns == 0)
+        return;
+
+    // Skip any non-displayed columns
+    size_t column = scroll;
+    if (strip.Wraps)
+        column %= numColumns;
+
+    for (;; column++, scrollPositionOffsets++)
+    {
+        if (column >= numColumns)
+        {
+            if (!strip.Wraps)
+                return;
+            column = 0;
+        }
+
+        int16_t scrollPosition = *scrollPositionOffsets;
+        if (scrollPosition == -1)
+            return;
+
+        if (scrollPosition > -1)
+        {
+            const auto& stripColumn = strip.Columns[column];
+            auto dst = &bitmap[scrollPosition];
+            for (uint8_t row = 0; row < 8; row++)
+            {
+                const uint8_t rowBit = 1 << row;
+                if (stripColumn.Solid & rowBit)
+                {
+                    *dst = stripColumn.Colour;
+                }
+                else if (stripColumn.Hinted & rowBit)
+                {
+                    // Simulate font hinting by shading the background colour instead.
+                    *dst = blendColours(stripColumn.Colour, *dst);
+                }
+
+                // Jump to next row
+                dst += 64;
+            }
+        }
+    }
 }
 
 int32_t scrolling_text_setup(
@@ -1473,29 +1663,18 @@ int32_t scrolling_text_setup(
     scrollText->mode = scrollingMode;
     scrollText->id = _drawSCrollNextIndex;
 
-    // Create the string to draw
-    utf8 scrollString[256];
-    scrolling_text_format(scrollString, 256, scrollText);
-
-    const int16_t* scrollingModePositions = _scrollPositions[scrollingMode];
+    // The text is only formatted and rendered once, every scroll position is copied from the same strip.
+    const auto& strip = scrolling_text_get_strip(scrollText);
 
     std::fill_n(scrollText->bitmap, 320 * 8, 0x00);
-    if (LocalisationService_UseTrueTypeFont())
-    {
-        scrolling_text_set_bitmap_for_ttf(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
-    }
-    else
-    {
-        scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
-    }
+    scrolling_text_draw_strip(strip, scroll, scrollText->bitmap, _scrollPositions[scrollingMode]);
 
     uint32_t imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
     drawing_engine_invalidate_image(imageId);
     return imageId;
 }
 
-static void scrolling_text_set_bitmap_for_sprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void scrolling_text_build_strip_for_sprite(std::string_view text, colour_t colour, ScrollingTextStrip& strip)
 {
     auto characterColour = colour;
     auto fmt = FmtString(text);
@@ -1514,30 +1693,7 @@ static void scrolling_text_set_bitmap_for_sprite(
                     auto characterBitmap = font_sprite_get_codepoint_bitmap(codepoint);
                     for (; characterWidth != 0; characterWidth--, characterBitmap++)
                     {
-                        // Skip any non-displayed columns
-                        if (scroll != 0)
-                        {
-                            scroll--;
-                            continue;
-                        }
-
-                        int16_t scrollPosition = *scrollPositionOffsets;
-                        if (scrollPosition == -1)
-                            return;
-
-                        if (scrollPosition > -1)
-                        {
-                            auto dst = &bitmap[scrollPosition];
-                            for (uint8_t char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1)
-                            {
-                                if (char_bitmap & 1)
-                                    *dst = characterColour;
-
-                                // Jump to next row
-                                dst += 64;
-                            }
-                        }
-                        scrollPositionOffsets++;
+                        strip.Columns.push_back({ characterColour, *characterBitmap, 0 });
                     }
                 }
             }
@@ -1552,16 +1708,16 @@ static void scrolling_text_set_bitmap_for_sprite(
             }
         }
     }
+    strip.Wraps = false;
 }
 
-static void scrolling_text_set_bitmap_for_ttf(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void scrolling_text_build_strip_for_ttf(std::string_view text, colour_t colour, ScrollingTextStrip& strip)
 {
 #ifndef NO_TTF
     auto fontDesc = ttf_get_font_from_sprite_base(FontSpriteBase::TINY);
     if (fontDesc->font == nullptr)
     {
-        scrolling_text_set_bitmap_for_sprite(text, scroll, bitmap, scrollPositionOffsets, colour);
+        scrolling_text_build_strip_for_sprite(text, colour, strip);
         return;
     }
 
@@ -1605,46 +1761,25 @@ static void scrolling_text_set_bitmap_for_ttf(
 
     bool use_hinting = gConfigFonts.enable_hinting && fontDesc->hinting_threshold > 0;
 
-    for (int32_t x = 0;; x++)
+    strip.Columns.resize(width, { colour, 0, 0 });
+    for (int32_t x = 0; x < width; x++)
     {
-        if (x >= width)
-            x = 0;
-
-        // Skip any non-displayed columns
-        if (scroll == 0)
+        auto& column = strip.Columns[x];
+        for (int32_t y = min_vpos; y < max_vpos; y++)
         {
-            int16_t scrollPosition = *scrollPositionOffsets;
-            if (scrollPosition == -1)
-                return;
-
-            if (scrollPosition > -1)
+            const uint8_t rowBit = 1 << (y - min_vpos);
+            uint8_t src_pixel = src[y * pitch + x];
+            if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
             {
-                uint8_t* dst = &bitmap[scrollPosition];
-
-                for (int32_t y = min_vpos; y < max_vpos; y++)
-                {
-                    uint8_t src_pixel = src[y * pitch + x];
-                    if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
-                    {
-                        // Centre of the glyph: use full colour.
-                        *dst = colour;
-                    }
-                    else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
-                    {
-                        // Simulate font hinting by shading the background colour instead.
-                        *dst = blendColours(colour, *dst);
-                    }
-
-                    // Jump to next row
-                    dst += 64;
-                }
+                // Centre of the glyph: use full colour.
+                column.Solid |= rowBit;
+            }
+            else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
+            {
+                column.Hinted |= rowBit;
             }
-            scrollPositionOffsets++;
-        }
-        else
-        {
-            scroll--;
         }
     }
+    strip.Wraps = true;
 #endif // NO_TTF
 }
@@ -0,0 +1,251 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SpriteMipCache.h"
+
+#include "../core/MemoryAccounting.h"
+#include "../sprites.h"
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// Zoom 1 has 2 possible first rows, zoom 2 has 4 and zoom 3 has 8.
+static constexpr int32_t MaxZoomShift = 3;
+static constexpr size_t NumVariants = 2 + 4 + 8;
+static constexpr size_t NumShards = 16;
+static constexpr size_t MemoryBudget = 16 * 1024 * 1024;
+
+static std::atomic<size_t> _memoryUsage;
+static OpenRCT2::MemoryAccounting::Registration _memoryRegistration("spriteMipCache", [] { return _memoryUsage.load(); });
+
+struct CachedSprite
+{
+    ImageIndex Index{};
+    // The source is compared on every lookup so replaced images are never drawn from a stale copy.
+    const uint8_t* SourceData{};
+    int16_t SourceWidth{};
+    int16_t SourceHeight{};
+    std::array<std::shared_ptr<const ZoomedSprite>, NumVariants> Variants;
+    size_t Size{};
+};
+
+struct SpriteMipCacheShard
+{
+    std::mutex Mutex;
+    // Most recently used first
+    std::list<CachedSprite> Sprites;
+    std::unordered_map<ImageIndex, std::list<CachedSprite>::iterator> Map;
+    size_t Size{};
+
+    void Erase(std::list<CachedSprite>::iterator it)
+    {
+        Size -= it->Size;
+        _memoryUsage -= it->Size;
+        Map.erase(it->Index);
+        Sprites.erase(it);
+    }
+};
+
+static std::array<SpriteMipCacheShard, NumShards> _shards;
+
+static SpriteMipCacheShard& GetShard(ImageIndex imageIndex)
+{
+    return _shards[imageIndex % NumShards];
+}
+
+static size_t GetVariantIndex(int32_t zoomShift, int32_t firstRow)
+{
+    // Variants of zoom n start after the 2 + ... + 2^(n-1) variants of the lower zooms.
+    return static_cast<size_t>((1 << zoomShift) - 2 + firstRow);
+}
+
+static bool IsCacheable(ImageIndex imageIndex)
+{
+    // Scrolling text and the temporary image are redrawn into the same buffer.
+    if (imageIndex == SPR_TEMP)
+        return false;
+    return imageIndex < SPR_SCROLLING_TEXT_START || (imageIndex >= SPR_IMAGE_LIST_BEGIN && imageIndex < SPR_IMAGE_LIST_END);
+}
+
+std::unique_ptr<ZoomedSprite> SpriteMipCacheCreate(const rct_g1_element& source, int32_t zoomShift, int32_t firstRow)
+{
+    const int32_t zoom = 1 << zoomShift;
+    const int32_t width = (source.width + zoom - 1) >> zoomShift;
+    const int32_t height = source.height > firstRow ? (source.height - firstRow + zoom - 1) >> zoomShift : 0;
+
+    auto result = std::make_unique<ZoomedSprite>();
+    auto& data = result->Data;
+    data.resize(static_cast<size_t>(height) * 2);
+    for (int32_t row = 0; row < height; row++)
+    {
+        if (data.size() > UINT16_MAX)
+        {
+            return nullptr;
+        }
+        data[row * 2] = static_cast<uint8_t>(data.size() & 0xFF);
+        data[row * 2 + 1] = static_cast<uint8_t>(data.size() >> 8);
+
+        const int32_t y = firstRow + (row << zoomShift);
+        const uint8_t* src0 = source.offset;
+        const uint8_t* nextRun = src0 + (src0[y * 2] | (src0[y * 2 + 1] << 8));
+        size_t lastHeader = SIZE_MAX;
+        bool isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            const uint8_t* src = nextRun;
+            int32_t dataSize = *src++;
+            int32_t firstPixelX = *src++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+            nextRun = src + dataSize;
+
+            // Keep the pixels on columns that are a multiple of the zoom
+            const int32_t firstColumn = (firstPixelX + zoom - 1) >> zoomShift;
+            const int32_t endColumn = (firstPixelX + dataSize + zoom - 1) >> zoomShift;
+            if (endColumn > firstColumn)
+            {
+                lastHeader = data.size();
+                data.push_back(static_cast<uint8_t>(endColumn - firstColumn));
+                data.push_back(static_cast<uint8_t>(firstColumn));
+                for (int32_t column = firstColumn; column < endColumn; column++)
+                {
+                    data.push_back(src[(column << zoomShift) - firstPixelX]);
+                }
+            }
+        }
+
+        if (lastHeader == SIZE_MAX)
+        {
+            data.push_back(0x80);
+            data.push_back(0);
+        }
+        else
+        {
+            data[lastHeader] |= 0x80;
+        }
+    }
+
+    result->Element = source;
+    result->Element.offset = data.data();
+    result->Element.width = static_cast<int16_t>(width);
+    result->Element.height = static_cast<int16_t>(height);
+    result->Element.flags &= ~G1_FLAG_HAS_ZOOM_SPRITE;
+    result->Element.zoomed_offset = 0;
+    return result;
+}
+
+std::shared_ptr<const ZoomedSprite> SpriteMipCacheGet(
+    ImageIndex imageIndex, const rct_g1_element& source, int32_t zoomShift, int32_t firstRow)
+{
+    if (!IsCacheable(imageIndex) || source.offset == nullptr || zoomShift < 1 || zoomShift > MaxZoomShift)
+    {
+        return nullptr;
+    }
+
+    const auto variantIndex = GetVariantIndex(zoomShift, firstRow);
+    auto& shard = GetShard(imageIndex);
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        auto it = shard.Map.find(imageIndex);
+        if (it != shard.Map.end())
+        {
+            auto& cached = *it->second;
+            if (cached.SourceData == source.offset && cached.SourceWidth == source.width
+                && cached.SourceHeight == source.height)
+            {
+                shard.Sprites.splice(shard.Sprites.begin(), shard.Sprites, it->second);
+                if (cached.Variants[variantIndex] != nullptr)
+                {
+                    return cached.Variants[variantIndex];
+                }
+            }
+            else
+            {
+                shard.Erase(it->second);
+            }
+        }
+    }
+
+    // Created without holding the lock, if another thread got there first its copy is used instead.
+    std::shared_ptr<const ZoomedSprite> variant = SpriteMipCacheCreate(source, zoomShift, firstRow);
+    if (variant == nullptr)
+    {
+        return nullptr;
+    }
+    const auto variantSize = variant->Data.size() + sizeof(ZoomedSprite);
+
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    auto it = shard.Map.find(imageIndex);
+    if (it == shard.Map.end())
+    {
+        CachedSprite cached;
+        cached.Index = imageIndex;
+        cached.SourceData = source.offset;
+        cached.SourceWidth = source.width;
+        cached.SourceHeight = source.height;
+        shard.Sprites.push_front(std::move(cached));
+        it = shard.Map.emplace(imageIndex, shard.Sprites.begin()).first;
+    }
+    else if (it->second->SourceData != source.offset)
+    {
+        // Replaced while the copy was being made, the copy belongs to the old image.
+        return variant;
+    }
+
+    auto& cached = *it->second;
+    auto& slot = cached.Variants[variantIndex];
+    if (slot == nullptr)
+    {
+        slot = variant;
+        cached.Size += variantSize;
+        shard.Size += variantSize;
+        _memoryUsage += variantSize;
+    }
+    auto result = slot;
+
+    // Keep the sprite being drawn at the front so it is evicted last.
+    shard.Sprites.splice(shard.Sprites.begin(), shard.Sprites, it->second);
+    constexpr size_t shardBudget = MemoryBudget / NumShards;
+    while (shard.Size > shardBudget && shard.Sprites.size() > 1)
+    {
+        shard.Erase(std::prev(shard.Sprites.end()));
+    }
+    return result;
+}
+
+void SpriteMipCacheInvalidate(ImageIndex imageIndex)
+{
+    if (!IsCacheable(imageIndex))
+    {
+        return;
+    }
+
+    auto& shard = GetShard(imageIndex);
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    auto it = shard.Map.find(imageIndex);
+    if (it != shard.Map.end())
+    {
+        shard.Erase(it->second);
+    }
+}
+
+void SpriteMipCacheClear()
+{
+    for (auto& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        _memoryUsage -= shard.Size;
+        shard.Map.clear();
+        shard.Sprites.clear();
+        shard.Size = 0;
+    }
+}
@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Drawing.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * An RLE sprite reduced to every zoom'th column and row, starting at the given row.
+ */
+struct ZoomedSprite
+{
+    rct_g1_element Element{};
+    std::vector<uint8_t> Data;
+};
+
+/**
+ * Returns the zoomed copy of an RLE sprite for the given zoom (as a power of two, 1 to 3) and first row, creating it
+ * if it is not cached yet. The cache is shared by all drawing threads and bounded by a memory budget, the least
+ * recently used sprites are evicted first. Returns nullptr for sprites that are not cached, such as temporary images.
+ */
+std::shared_ptr<const ZoomedSprite> SpriteMipCacheGet(
+    ImageIndex imageIndex, const rct_g1_element& source, int32_t zoomShift, int32_t firstRow);
+
+/**
+ * Creates the zoomed copy of an RLE sprite, returns nullptr if the copy can not be represented.
+ */
+std::unique_ptr<ZoomedSprite> SpriteMipCacheCreate(const rct_g1_element& source, int32_t zoomShift, int32_t firstRow);
+
+void SpriteMipCacheInvalidate(ImageIndex imageIndex);
+void SpriteMipCacheClear();
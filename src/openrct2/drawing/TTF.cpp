@@ -10,7 +10,12 @@
 #ifndef NO_TTF
 
 #    include <atomic>
+#    include <iterator>
+#    include <list>
+#    include <memory>
 #    include <mutex>
+#    include <string>
+#    include <unordered_map>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
 #    include <ft2build.h>
@@ -28,42 +33,124 @@
 
 static bool _ttfInitialised = false;
 
-#    define TTF_SURFACE_CACHE_SIZE 256
-#    define TTF_GETWIDTH_CACHE_SIZE 1024
+// Memory budgets of the string caches. Entries used during the current draw are kept even when over
+// budget, as other threads drawing the same frame may still be reading their surfaces.
+static constexpr size_t TTF_SURFACE_CACHE_BUDGET = 4 * 1024 * 1024;
+static constexpr size_t TTF_GETWIDTH_CACHE_BUDGET = 256 * 1024;
 
-struct ttf_cache_entry
+struct TTFSurfaceDeleter
 {
-    TTFSurface* surface;
-    TTF_Font* font;
-    utf8* text;
-    uint32_t lastUseTick;
+    void operator()(TTFSurface* surface) const
+    {
+        ttf_free_surface(surface);
+    }
 };
+using TTFSurfacePtr = std::unique_ptr<TTFSurface, TTFSurfaceDeleter>;
 
-struct ttf_getwidth_cache_entry
+/**
+ * Least recently used cache of a value per font and string, bounded by a memory budget.
+ */
+template<typename TValue> class TTFStringCache
 {
-    uint32_t width;
-    TTF_Font* font;
-    utf8* text;
-    uint32_t lastUseTick;
-};
+private:
+    struct Entry
+    {
+        TTF_Font* Font;
+        std::string Text;
+        uint32_t Hash;
+        uint32_t LastUseTick;
+        size_t Size;
+        TValue Value;
+    };
+    using EntryIterator = typename std::list<Entry>::iterator;
+
+    const size_t _budget;
+    std::list<Entry> _entries;
+    std::unordered_multimap<uint32_t, EntryIterator> _index;
+    size_t _size{};
 
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
-static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
+public:
+    uint32_t Hits{};
+    uint32_t Misses{};
 
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
-static int32_t _ttfGetWidthCacheCount = 0;
-static int32_t _ttfGetWidthCacheHitCount = 0;
-static int32_t _ttfGetWidthCacheMissCount = 0;
+    explicit TTFStringCache(size_t budget)
+        : _budget(budget)
+    {
+    }
+
+    TValue* Find(TTF_Font* font, std::string_view text, uint32_t hash)
+    {
+        auto [begin, end] = _index.equal_range(hash);
+        for (auto it = begin; it != end; it++)
+        {
+            auto entry = it->second;
+            if (entry->Font == font && entry->Text == text)
+            {
+                Hits++;
+                entry->LastUseTick = gCurrentDrawCount;
+                _entries.splice(_entries.begin(), _entries, entry);
+                return &entry->Value;
+            }
+        }
+        return nullptr;
+    }
+
+    TValue& Add(TTF_Font* font, std::string_view text, uint32_t hash, TValue&& value, size_t valueSize)
+    {
+        Misses++;
+        const auto size = sizeof(Entry) + text.size() + valueSize;
+        _entries.push_front({ font, std::string(text), hash, gCurrentDrawCount, size, std::move(value) });
+        _index.emplace(hash, _entries.begin());
+        _size += size;
+        Evict();
+        return _entries.front().Value;
+    }
+
+    void Clear()
+    {
+        _index.clear();
+        _entries.clear();
+        _size = 0;
+    }
+
+    size_t GetCount() const
+    {
+        return _entries.size();
+    }
+
+    size_t GetSize() const
+    {
+        return _size;
+    }
+
+private:
+    void Evict()
+    {
+        while (_size > _budget && !_entries.empty() && _entries.back().LastUseTick != gCurrentDrawCount)
+        {
+            auto lru = std::prev(_entries.end());
+            auto [begin, end] = _index.equal_range(lru->Hash);
+            for (auto it = begin; it != end; it++)
+            {
+                if (it->second == lru)
+                {
+                    _index.erase(it);
+                    break;
+                }
+            }
+            _size -= lru->Size;
+            _entries.erase(lru);
+        }
+    }
+};
+
+static TTFStringCache<TTFSurfacePtr> _ttfSurfaceCache(TTF_SURFACE_CACHE_BUDGET);
+static TTFStringCache<uint32_t> _ttfGetWidthCache(TTF_GETWIDTH_CACHE_BUDGET);
 
 static std::mutex _mutex;
 
 static TTF_Font* ttf_open_font(const utf8* fontPath, int32_t ptSize);
 static void ttf_close_font(TTF_Font* font);
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry);
-static void ttf_surface_cache_dispose_all();
-static void ttf_getwidth_cache_dispose_all();
 static bool ttf_get_size(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
 static void ttf_toggle_hinting(bool);
 static TTFSurface* ttf_render(TTF_Font* font, std::string_view text);
@@ -102,10 +189,7 @@ static void ttf_toggle_hinting(bool)
         TTF_SetFontHinting(fontDesc->font, use_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        ttf_surface_cache_dispose_all();
-    }
+    _ttfSurfaceCache.Clear();
 }
 
 bool ttf_initialise()
@@ -154,8 +238,8 @@ void ttf_dispose()
     if (!_ttfInitialised)
         return;
 
-    ttf_surface_cache_dispose_all();
-    ttf_getwidth_cache_dispose_all();
+    _ttfSurfaceCache.Clear();
+    _ttfGetWidthCache.Clear();
 
     for (int32_t i = 0; i < FONT_SIZE_COUNT; i++)
     {
@@ -192,28 +276,6 @@ static uint32_t ttf_surface_cache_hash(TTF_Font* font, std::string_view text)
     return hash;
 }
 
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
-{
-    if (entry->surface != nullptr)
-    {
-        ttf_free_surface(entry->surface);
-        free(entry->text);
-
-        entry->surface = nullptr;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
-
-static void ttf_surface_cache_dispose_all()
-{
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
-    {
-        ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
-    }
-}
-
 void ttf_toggle_hinting()
 {
     FontLockHelper<std::mutex> lock(_mutex);
@@ -222,129 +284,68 @@ void ttf_toggle_hinting()
 
 TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
 {
-    ttf_cache_entry* entry;
-
     uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_SURFACE_CACHE_SIZE;
 
     FontLockHelper<std::mutex> lock(_mutex);
 
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    auto* cached = _ttfSurfaceCache.Find(font, text, hash);
+    if (cached != nullptr)
     {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
-        {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE)
-            index = 0;
+        return cached->get();
     }
 
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    ttf_surface_cache_dispose(entry);
-
-    TTFSurface* surface = ttf_render(font, text);
+    // Cache miss, render the string from the glyph cache
+    TTFSurfacePtr surface(ttf_render(font, text));
     if (surface == nullptr)
     {
         return nullptr;
     }
 
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = strndup(text.data(), text.size());
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
+    const auto size = static_cast<size_t>(surface->pitch) * surface->h;
+    return _ttfSurfaceCache.Add(font, text, hash, std::move(surface), size).get();
 }
 
-static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry* entry)
+uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text)
 {
-    if (entry->text != nullptr)
-    {
-        free(entry->text);
+    uint32_t hash = ttf_surface_cache_hash(font, text);
 
-        entry->width = 0;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
+    FontLockHelper<std::mutex> lock(_mutex);
 
-static void ttf_getwidth_cache_dispose_all()
-{
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    auto* cached = _ttfGetWidthCache.Find(font, text, hash);
+    if (cached != nullptr)
     {
-        ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
+        return *cached;
     }
+
+    int32_t width, height;
+    ttf_get_size(font, text, &width, &height);
+    return _ttfGetWidthCache.Add(font, text, hash, static_cast<uint32_t>(width), 0);
 }
 
-uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text)
+TTFCacheStats ttf_get_cache_stats()
 {
-    ttf_getwidth_cache_entry* entry;
-
-    uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_GETWIDTH_CACHE_SIZE;
-
     FontLockHelper<std::mutex> lock(_mutex);
 
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
+    TTFCacheStats stats{};
+    stats.SurfaceHits = _ttfSurfaceCache.Hits;
+    stats.SurfaceMisses = _ttfSurfaceCache.Misses;
+    stats.SurfaceCount = _ttfSurfaceCache.GetCount();
+    stats.SurfaceSize = _ttfSurfaceCache.GetSize();
+    stats.WidthHits = _ttfGetWidthCache.Hits;
+    stats.WidthMisses = _ttfGetWidthCache.Misses;
+    stats.WidthCount = _ttfGetWidthCache.GetCount();
+    if (_ttfInitialised)
     {
-        entry = &_ttfGetWidthCache[index];
-
-        // Check if entry is a hit
-        if (entry->text == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
+        for (int32_t i = 0; i < FONT_SIZE_COUNT; i++)
         {
-            _ttfGetWidthCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->width;
+            auto glyphs = TTF_GetGlyphCacheStats(gCurrentTTFFontSet->size[i].font);
+            stats.Glyphs.Hits += glyphs.Hits;
+            stats.Glyphs.Misses += glyphs.Misses;
+            stats.Glyphs.Count += glyphs.Count;
+            stats.Glyphs.Size += glyphs.Size;
         }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_GETWIDTH_CACHE_SIZE)
-            index = 0;
     }
-
-    // Cache miss, replace entry with new width
-    entry = &_ttfGetWidthCache[index];
-    ttf_getwidth_cache_dispose(entry);
-
-    int32_t width, height;
-    ttf_get_size(font, text, &width, &height);
-
-    _ttfGetWidthCacheMissCount++;
-
-    _ttfGetWidthCacheCount++;
-    entry->width = width;
-    entry->font = font;
-    entry->text = strndup(text.data(), text.size());
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->width;
+    return stats;
 }
 
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase)
@@ -26,12 +26,33 @@ struct TTFSurface
     int32_t pitch;
 };
 
+struct TTFGlyphCacheStats
+{
+    uint32_t Hits;
+    uint32_t Misses;
+    size_t Count;
+    size_t Size;
+};
+
+struct TTFCacheStats
+{
+    uint32_t SurfaceHits;
+    uint32_t SurfaceMisses;
+    size_t SurfaceCount;
+    size_t SurfaceSize;
+    uint32_t WidthHits;
+    uint32_t WidthMisses;
+    size_t WidthCount;
+    TTFGlyphCacheStats Glyphs;
+};
+
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase);
 void ttf_toggle_hinting();
 TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text);
 uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text);
 bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint);
 void ttf_free_surface(TTFSurface* surface);
+TTFCacheStats ttf_get_cache_stats();
 
 // TTF_SDLPORT
 int TTF_Init(void);
@@ -43,6 +64,7 @@ TTFSurface* TTF_RenderUTF8_Shaded(TTF_Font* font, const char* text, uint32_t fg,
 void TTF_CloseFont(TTF_Font* font);
 void TTF_SetFontHinting(TTF_Font* font, int hinting);
 int TTF_GetFontHinting(const TTF_Font* font);
+TTFGlyphCacheStats TTF_GetGlyphCacheStats(const TTF_Font* font);
 void TTF_Quit(void);
 
 #endif // NO_TTF
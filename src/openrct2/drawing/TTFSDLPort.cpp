@@ -38,9 +38,11 @@ misrepresented as being the original software.
 #    include <algorithm>
 #    include <cmath>
 #    include <cstring>
+#    include <list>
 #    include <stdio.h>
 #    include <stdlib.h>
 #    include <string.h>
+#    include <unordered_map>
 
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
@@ -102,6 +104,18 @@ struct c_glyph
     uint16_t cached;
 };
 
+/* Glyphs by codepoint, evicted least recently used first once the bitmaps exceed the memory budget */
+struct GlyphCache
+{
+    std::list<std::pair<uint16_t, c_glyph>> Glyphs;
+    std::unordered_map<uint16_t, std::list<std::pair<uint16_t, c_glyph>>::iterator> Index;
+    size_t Size;
+    uint32_t Hits;
+    uint32_t Misses;
+};
+
+static constexpr size_t TTF_GLYPH_CACHE_BUDGET = 1024 * 1024;
+
 /* The structure used to hold internal font information */
 struct InternalTTFFont
 {
@@ -130,9 +144,9 @@ struct InternalTTFFont
     int underline_offset;
     int underline_height;
 
-    /* Cache for style-transformed glyphs */
+    /* Cache for style-transformed glyphs, most recently used first */
     c_glyph* current;
-    c_glyph cache[257]; /* 257 is a prime */
+    GlyphCache* cache;
 
     /* We are responsible for closing the font stream */
     FILE* src;
@@ -402,6 +416,7 @@ static TTF_Font* TTF_OpenFontIndexRW(FILE* src, int freesrc, int ptsize, long in
 
     font->src = src;
     font->freesrc = freesrc;
+    font->cache = new GlyphCache{};
 
     stream = static_cast<FT_Stream>(malloc(sizeof(*stream)));
     if (stream == NULL)
@@ -563,18 +578,26 @@ static void Flush_Glyph(c_glyph* glyph)
     glyph->cached = 0;
 }
 
-static void Flush_Cache(TTF_Font* font)
+static size_t Glyph_Size(const c_glyph* glyph)
 {
-    int i;
-    int size = sizeof(font->cache) / sizeof(font->cache[0]);
+    return sizeof(*glyph) + glyph->bitmap.rows * std::abs(glyph->bitmap.pitch)
+        + glyph->pixmap.rows * std::abs(glyph->pixmap.pitch);
+}
 
-    for (i = 0; i < size; ++i)
+static void Flush_Cache(TTF_Font* font)
+{
+    if (font->cache == nullptr)
     {
-        if (font->cache[i].cached)
-        {
-            Flush_Glyph(&font->cache[i]);
-        }
+        return;
+    }
+    for (auto& [ch, glyph] : font->cache->Glyphs)
+    {
+        Flush_Glyph(&glyph);
     }
+    font->cache->Glyphs.clear();
+    font->cache->Index.clear();
+    font->cache->Size = 0;
+    font->current = nullptr;
 }
 
 static FT_Error Load_Glyph(TTF_Font* font, uint16_t ch, c_glyph* cached, int want)
@@ -969,27 +992,62 @@ static FT_Error Load_Glyph(TTF_Font* font, uint16_t ch, c_glyph* cached, int wan
 
 static FT_Error Find_Glyph(TTF_Font* font, uint16_t ch, int want)
 {
-    int retval = 0;
-    int hsize = sizeof(font->cache) / sizeof(font->cache[0]);
+    auto& cache = *font->cache;
+    auto it = cache.Index.find(ch);
+    if (it == cache.Index.end())
+    {
+        cache.Glyphs.emplace_front(ch, c_glyph{});
+        it = cache.Index.emplace(ch, cache.Glyphs.begin()).first;
+        cache.Size += sizeof(c_glyph);
+    }
+    else if (it->second != cache.Glyphs.begin())
+    {
+        cache.Glyphs.splice(cache.Glyphs.begin(), cache.Glyphs, it->second);
+    }
+    font->current = &it->second->second;
 
-    int h = ch % hsize;
-    font->current = &font->cache[h];
+    if ((font->current->stored & want) == want)
+    {
+        cache.Hits++;
+        return 0;
+    }
 
-    if (font->current->cached != ch)
-        Flush_Glyph(font->current);
+    cache.Misses++;
+    const auto oldSize = Glyph_Size(font->current);
+    const auto retval = Load_Glyph(font, ch, font->current, want);
+    cache.Size += Glyph_Size(font->current) - oldSize;
 
-    if ((font->current->stored & want) != want)
+    // Only the current glyph is in use by the caller, anything behind it can go.
+    while (cache.Size > TTF_GLYPH_CACHE_BUDGET && cache.Glyphs.size() > 1)
     {
-        retval = Load_Glyph(font, ch, font->current, want);
+        auto& [lruCh, lruGlyph] = cache.Glyphs.back();
+        cache.Size -= Glyph_Size(&lruGlyph);
+        Flush_Glyph(&lruGlyph);
+        cache.Index.erase(lruCh);
+        cache.Glyphs.pop_back();
     }
     return retval;
 }
 
+TTFGlyphCacheStats TTF_GetGlyphCacheStats(const TTF_Font* font)
+{
+    TTFGlyphCacheStats stats{};
+    if (font != nullptr && font->cache != nullptr)
+    {
+        stats.Hits = font->cache->Hits;
+        stats.Misses = font->cache->Misses;
+        stats.Count = font->cache->Glyphs.size();
+        stats.Size = font->cache->Size;
+    }
+    return stats;
+}
+
 void TTF_CloseFont(TTF_Font* font)
 {
     if (font)
     {
         Flush_Cache(font);
+        delete font->cache;
         if (font->face)
         {
             FT_Done_Face(font->face);
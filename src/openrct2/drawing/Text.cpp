@@ -1,41 +1,218 @@
-/*****************************************************************************
- * Copyright (c) 2014-2020 OpenRCT2 developers
- *
- * For a complete list of all authors, please refer to contributors.md
- * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
- *
- * OpenRCT2 is licensed under the GNU General Public License version 3.
- *****************************************************************************/
-
 #include "Text.h"
 
+#include "../Context.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../core/Numerics.hpp"
+#include "../localisation/Currency.h"
 #include "../localisation/Formatter.h"
+#include "../localisation/Formatting.h"
 #include "../localisation/Localisation.h"
+#include "../localisation/LocalisationService.h"
 #include "Drawing.h"
 
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Number of formatted strings kept by the layout cache, enough for the visible rows of several large list windows.
+static constexpr size_t TEXT_LAYOUT_CACHE_CAPACITY = 2048;
+
+// Wrap width used for layouts of text that is drawn on a single line.
+static constexpr int32_t TEXT_LAYOUT_NO_WRAP = -1;
+
+/**
+ * Formatted text split into lines, every line is terminated by a null character.
+ */
+struct TextLayout
+{
+    std::string Text;
+    std::vector<int32_t> LineWidths;
+    int32_t MaxWidth{};
+};
+
+/**
+ * Least recently used cache of text layouts by string id, argument bytes, font and wrap width.
+ * Text is only cached when the bytes added to the formatter fully describe it, i.e. no string pointers are
+ * read and nothing is read past the end of the added arguments.
+ * The cache is flushed whenever the strings, fonts or formatting settings change.
+ */
+class TextLayoutCache
+{
+private:
+    struct Entry
+    {
+        rct_string_id Format;
+        FontSpriteBase SpriteBase;
+        int32_t WrapWidth;
+        std::string Args;
+        uint32_t Hash;
+        TextLayout Layout;
+    };
+    using EntryIterator = std::list<Entry>::iterator;
+
+    std::list<Entry> _entries;
+    std::unordered_multimap<uint32_t, EntryIterator> _index;
+
+    uint32_t _stringsVersion{};
+    CurrencyType _currency{};
+    MeasurementFormat _measurement{};
+    TemperatureUnit _temperature{};
+    bool _heightAsUnits{};
+    int32_t _dateFormat{};
+    int32_t _customCurrencyRate{};
+    CurrencyAffix _customCurrencyAffix{};
+    std::string _customCurrencySymbol;
+
+public:
+    const TextLayout& Get(rct_string_id format, const Formatter& ft, FontSpriteBase spriteBase, int32_t wrapWidth)
+    {
+        Validate();
+
+        const std::string_view args(reinterpret_cast<const char*>(ft.Data()), ft.NumBytes());
+        const auto hash = GetHash(format, args, spriteBase, wrapWidth);
+        auto [begin, end] = _index.equal_range(hash);
+        for (auto it = begin; it != end; it++)
+        {
+            auto entry = it->second;
+            if (entry->Format == format && entry->SpriteBase == spriteBase && entry->WrapWidth == wrapWidth
+                && entry->Args == args)
+            {
+                _entries.splice(_entries.begin(), _entries, entry);
+                return entry->Layout;
+            }
+        }
+
+        thread_local TextLayout uncached;
+        TextLayout layout;
+        auto cacheable = OpenRCT2::FormatStringLegacy(layout.Text, format, ft.Data(), args.size());
+        Measure(layout, spriteBase, wrapWidth);
+        if (!cacheable)
+        {
+            uncached = std::move(layout);
+            return uncached;
+        }
+
+        _entries.push_front({ format, spriteBase, wrapWidth, std::string(args), hash, std::move(layout) });
+        _index.emplace(hash, _entries.begin());
+        if (_entries.size() > TEXT_LAYOUT_CACHE_CAPACITY)
+        {
+            Evict();
+        }
+        return _entries.front().Layout;
+    }
+
+    void Clear()
+    {
+        _index.clear();
+        _entries.clear();
+    }
+
+private:
+    static uint32_t GetHash(rct_string_id format, std::string_view args, FontSpriteBase spriteBase, int32_t wrapWidth)
+    {
+        uint32_t hash = (format * 23) ^ (static_cast<uint32_t>(spriteBase) << 16) ^ static_cast<uint32_t>(wrapWidth);
+        for (auto c : args)
+        {
+            hash = Numerics::ror32(hash, 3) ^ (static_cast<uint8_t>(c) * 13);
+        }
+        return hash;
+    }
+
+    static void Measure(TextLayout& layout, FontSpriteBase spriteBase, int32_t wrapWidth)
+    {
+        if (wrapWidth == TEXT_LAYOUT_NO_WRAP)
+        {
+            layout.MaxWidth = gfx_get_string_width(layout.Text, spriteBase);
+            layout.LineWidths.push_back(layout.MaxWidth);
+            // Keep the terminator as part of the text so lines can be walked the same way as wrapped text.
+            layout.Text.push_back('\0');
+            return;
+        }
+
+        // Wrapping may insert a line break for each character that is not a space.
+        const auto length = layout.Text.size();
+        layout.Text.resize(length * 2 + 1);
+        int32_t lineCount = 0;
+        layout.MaxWidth = gfx_wrap_string(layout.Text.data(), wrapWidth, spriteBase, &lineCount);
+
+        size_t offset = 0;
+        for (int32_t line = 0; line <= lineCount; line++)
+        {
+            const auto* lineText = layout.Text.data() + offset;
+            const auto lineLength = std::strlen(lineText);
+            layout.LineWidths.push_back(gfx_get_string_width(std::string_view(lineText, lineLength), spriteBase));
+            offset += lineLength + 1;
+        }
+        layout.Text.resize(offset);
+    }
+
+    void Validate()
+    {
+        const auto stringsVersion = OpenRCT2::GetContext()->GetLocalisationService().GetStringsVersion();
+        const auto& customCurrency = CurrencyDescriptors[EnumValue(CurrencyType::Custom)];
+        if (stringsVersion == _stringsVersion && gConfigGeneral.currency_format == _currency
+            && gConfigGeneral.measurement_format == _measurement && gConfigGeneral.temperature_format == _temperature
+            && gConfigGeneral.show_height_as_units == _heightAsUnits && gConfigGeneral.date_format == _dateFormat
+            && customCurrency.rate == _customCurrencyRate && customCurrency.affix_unicode == _customCurrencyAffix
+            && _customCurrencySymbol == customCurrency.symbol_unicode)
+        {
+            return;
+        }
+
+        Clear();
+        _stringsVersion = stringsVersion;
+        _currency = gConfigGeneral.currency_format;
+        _measurement = gConfigGeneral.measurement_format;
+        _temperature = gConfigGeneral.temperature_format;
+        _heightAsUnits = gConfigGeneral.show_height_as_units;
+        _dateFormat = gConfigGeneral.date_format;
+        _customCurrencyRate = customCurrency.rate;
+        _customCurrencyAffix = customCurrency.affix_unicode;
+        _customCurrencySymbol = customCurrency.symbol_unicode;
+    }
+
+    void Evict()
+    {
+        auto lru = std::prev(_entries.end());
+        auto [begin, end] = _index.equal_range(lru->Hash);
+        for (auto it = begin; it != end; it++)
+        {
+            if (it->second == lru)
+            {
+                _index.erase(it);
+                break;
+            }
+        }
+        _entries.erase(lru);
+    }
+};
+
+static TextLayoutCache _textLayoutCache;
+
 static void DrawText(
     rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, const TextPaint& paint, const_utf8string text,
     bool noFormatting = false);
 static void DrawText(
-    rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, const TextPaint& paint, rct_string_id format, const void* args);
+    rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, const TextPaint& paint, const_utf8string text, int32_t width,
+    bool noFormatting);
 
 class StaticLayout
 {
 private:
-    utf8string Buffer;
+    const TextLayout& Layout;
     TextPaint Paint;
-    int32_t LineCount = 0;
     int32_t LineHeight;
-    int32_t MaxWidth;
 
 public:
-    StaticLayout(utf8string source, const TextPaint& paint, int32_t width)
+    StaticLayout(const TextLayout& layout, const TextPaint& paint)
+        : Layout(layout)
+        , Paint(paint)
     {
-        Buffer = source;
-        Paint = paint;
-
-        MaxWidth = gfx_wrap_string(Buffer, width, paint.SpriteBase, &LineCount);
-        LineCount += 1;
         LineHeight = font_get_line_height(paint.SpriteBase);
     }
 
@@ -49,16 +226,16 @@ public:
             case TextAlignment::LEFT:
                 break;
             case TextAlignment::CENTRE:
-                lineCoords.x += MaxWidth / 2;
+                lineCoords.x += Layout.MaxWidth / 2;
                 break;
             case TextAlignment::RIGHT:
-                lineCoords.x += MaxWidth;
+                lineCoords.x += Layout.MaxWidth;
                 break;
         }
-        utf8* buffer = Buffer;
-        for (int32_t line = 0; line < LineCount; ++line)
+        const utf8* buffer = Layout.Text.c_str();
+        for (auto lineWidth : Layout.LineWidths)
         {
-            DrawText(dpi, lineCoords, tempPaint, buffer);
+            DrawText(dpi, lineCoords, tempPaint, buffer, lineWidth, false);
             tempPaint.Colour = TEXT_COLOUR_254;
             buffer = get_string_end(buffer) + 1;
             lineCoords.y += LineHeight;
@@ -67,17 +244,17 @@ public:
 
     int32_t GetHeight() const
     {
-        return LineHeight * LineCount;
+        return LineHeight * GetLineCount();
     }
 
     int32_t GetWidth() const
     {
-        return MaxWidth;
+        return Layout.MaxWidth;
     }
 
     int32_t GetLineCount() const
     {
-        return LineCount;
+        return static_cast<int32_t>(Layout.LineWidths.size());
     }
 };
 
@@ -86,7 +263,13 @@ static void DrawText(
 {
     int32_t width = noFormatting ? gfx_get_string_width_no_formatting(text, paint.SpriteBase)
                                  : gfx_get_string_width(text, paint.SpriteBase);
+    DrawText(dpi, coords, paint, text, width, noFormatting);
+}
 
+static void DrawText(
+    rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, const TextPaint& paint, const_utf8string text, int32_t width,
+    bool noFormatting)
+{
     auto alignedCoords = coords;
     switch (paint.Alignment)
     {
@@ -116,14 +299,6 @@ static void DrawText(
     }
 }
 
-static void DrawText(
-    rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, const TextPaint& paint, rct_string_id format, const void* args)
-{
-    utf8 buffer[512];
-    format_string(buffer, sizeof(buffer), format, args);
-    DrawText(dpi, coords, paint, buffer);
-}
-
 void DrawTextBasic(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, rct_string_id format)
 {
     Formatter ft{};
@@ -134,7 +309,8 @@ void DrawTextBasic(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, rct_str
 void DrawTextBasic(
     rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, rct_string_id format, const Formatter& ft, TextPaint textPaint)
 {
-    DrawText(dpi, coords, textPaint, format, ft.Data());
+    const auto& layout = _textLayoutCache.Get(format, ft, textPaint.SpriteBase, TEXT_LAYOUT_NO_WRAP);
+    DrawText(dpi, coords, textPaint, layout.Text.c_str(), layout.MaxWidth, false);
 }
 
 void DrawTextEllipsised(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, int32_t width, rct_string_id format)
@@ -177,11 +353,7 @@ int32_t DrawTextWrapped(
     rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, int32_t width, rct_string_id format, const Formatter& ft,
     TextPaint textPaint)
 {
-    const void* args = ft.Data();
-
-    // TODO: Refactor StaticLayout to take a std::string_view instead. It shouldn't have to write to the buffer.
-    const std::string buffer = format_string(format, args);
-    StaticLayout layout(const_cast<char*>(buffer.c_str()), textPaint, width);
+    StaticLayout layout(_textLayoutCache.Get(format, ft, textPaint.SpriteBase, width), textPaint);
 
     if (textPaint.Alignment == TextAlignment::CENTRE)
     {
@@ -37,4 +37,39 @@ static constexpr const uint8_t SnowPattern[] =
 
 // clang-format on
 
+/**
+ * Calls fn(row, left, colour) for every row of the area that has drops of the weather pattern. The drops of a row start
+ * at left and are spaced by the width of the pattern. Rows are given relative to y and visited per pattern row, so the
+ * rows without drops, which are most of them, are never looked at.
+ */
+template<typename TFn>
+void ForEachWeatherPatternRow(
+    int32_t x, int32_t width, int32_t height, int32_t xStart, int32_t yStart, const uint8_t* weatherPattern, TFn&& fn)
+{
+    const uint8_t* pattern = weatherPattern;
+    auto patternXSpace = *pattern++;
+    auto patternYSpace = *pattern++;
+
+    uint8_t patternStartXOffset = xStart % patternXSpace;
+    uint8_t patternStartYOffset = yStart % patternYSpace;
+    uint8_t patternStartYPos = patternStartYOffset % patternYSpace;
+
+    for (int32_t patternYPos = 0; patternYPos < patternYSpace; patternYPos++)
+    {
+        auto patternX = pattern[patternYPos * 2];
+        if (patternX == 0xFF)
+            continue;
+
+        auto patternPixel = pattern[patternYPos * 2 + 1];
+        auto left = x + (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
+        if (left >= x + width)
+            continue;
+
+        for (auto row = (patternYPos - patternStartYPos + patternYSpace) % patternYSpace; row < height; row += patternYSpace)
+        {
+            fn(row, left, patternPixel);
+        }
+    }
+}
+
 void DrawWeather(rct_drawpixelinfo* dpi, OpenRCT2::Drawing::IWeatherDrawer* weatherDrawer);
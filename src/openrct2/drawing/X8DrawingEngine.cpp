@@ -47,49 +47,25 @@ void X8WeatherDrawer::Draw(
     rct_drawpixelinfo* dpi, int32_t x, int32_t y, int32_t width, int32_t height, int32_t xStart, int32_t yStart,
     const uint8_t* weatherpattern)
 {
-    const uint8_t* pattern = weatherpattern;
-    auto patternXSpace = *pattern++;
-    auto patternYSpace = *pattern++;
-
-    uint8_t patternStartXOffset = xStart % patternXSpace;
-    uint8_t patternStartYOffset = yStart % patternYSpace;
-
-    uint32_t pixelOffset = (dpi->pitch + dpi->width) * y + x;
-    uint8_t patternYPos = patternStartYOffset % patternYSpace;
-
+    const auto patternXSpace = weatherpattern[0];
+    const auto pitch = dpi->pitch + dpi->width;
     uint8_t* screenBits = dpi->bits;
-
-    // Stores the colours of changed pixels
-    WeatherPixel* newPixels = &_weatherPixels[_weatherPixelsCount];
-    for (; height != 0; height--)
-    {
-        auto patternX = pattern[patternYPos * 2];
-        if (patternX != 0xFF)
-        {
-            if (_weatherPixelsCount < (_weatherPixelsCapacity - static_cast<uint32_t>(width)))
+    ForEachWeatherPatternRow(
+        x, width, height, xStart, yStart, weatherpattern, [&](int32_t row, int32_t left, uint8_t patternPixel) {
+            if (_weatherPixelsCount >= (_weatherPixelsCapacity - static_cast<uint32_t>(width)))
+                return;
+
+            // Stores the colours of changed pixels
+            const uint32_t rowOffset = pitch * (y + row);
+            const uint32_t finalPixelOffset = rowOffset + x + width;
+            WeatherPixel* newPixels = &_weatherPixels[_weatherPixelsCount];
+            for (uint32_t xPixelOffset = rowOffset + left; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
             {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
-                auto patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
-                {
-                    uint8_t current_pixel = screenBits[xPixelOffset];
-                    screenBits[xPixelOffset] = patternPixel;
-                    _weatherPixelsCount++;
-
-                    // Store colour and position
-                    *newPixels++ = { xPixelOffset, current_pixel };
-                }
+                *newPixels++ = { xPixelOffset, screenBits[xPixelOffset] };
+                screenBits[xPixelOffset] = patternPixel;
             }
-        }
-
-        pixelOffset += dpi->pitch + dpi->width;
-        patternYPos++;
-        patternYPos %= patternYSpace;
-    }
+            _weatherPixelsCount = static_cast<uint32_t>(newPixels - _weatherPixels);
+        });
 }
 
 void X8WeatherDrawer::Restore(rct_drawpixelinfo* dpi)
@@ -131,7 +107,6 @@ X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiC
 X8DrawingEngine::~X8DrawingEngine()
 {
     delete _drawingContext;
-    delete[] _dirtyGrid.Blocks;
     delete[] _bits;
 }
 
@@ -156,34 +131,7 @@ void X8DrawingEngine::SetVSync([[maybe_unused]] bool vsync)
 
 void X8DrawingEngine::Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
-    left = std::max(left, 0);
-    top = std::max(top, 0);
-    right = std::min(right, static_cast<int32_t>(_width));
-    bottom = std::min(bottom, static_cast<int32_t>(_height));
-
-    if (left >= right)
-        return;
-    if (top >= bottom)
-        return;
-
-    right--;
-    bottom--;
-
-    left >>= _dirtyGrid.BlockShiftX;
-    right >>= _dirtyGrid.BlockShiftX;
-    top >>= _dirtyGrid.BlockShiftY;
-    bottom >>= _dirtyGrid.BlockShiftY;
-
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-    for (int16_t y = top; y <= bottom; y++)
-    {
-        uint32_t yOffset = y * dirtyBlockColumns;
-        for (int16_t x = left; x <= right; x++)
-        {
-            screenDirtyBlocks[yOffset + x] = 0xFF;
-        }
-    }
+    _dirtyGrid.Invalidate(left, top, right, bottom);
 }
 
 void X8DrawingEngine::BeginDraw()
@@ -208,6 +156,7 @@ void X8DrawingEngine::EndDraw()
 void X8DrawingEngine::PaintWindows()
 {
     window_reset_visibilities();
+    _dirtyGrid.BeginFrame();
 
     // Redraw dirty regions before updating the viewports, otherwise
     // when viewports get panned, they copy dirty pixels
@@ -276,6 +225,15 @@ rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
     return &_bitsDPI;
 }
 
+void X8DrawingEngine::BeginParallelDraw()
+{
+    // Every column draws straight into its own part of the bits.
+}
+
+void X8DrawingEngine::EndParallelDraw()
+{
+}
+
 DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
 {
     return static_cast<DRAWING_ENGINE_FLAGS>(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING);
@@ -286,6 +244,11 @@ void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
     // Not applicable for this engine
 }
 
+DirtyGridStats X8DrawingEngine::GetDirtyGridStats()
+{
+    return _dirtyGrid.GetStats();
+}
+
 rct_drawpixelinfo* X8DrawingEngine::GetDPI()
 {
     return &_bitsDPI;
@@ -340,7 +303,7 @@ void X8DrawingEngine::ConfigureBits(uint32_t width, uint32_t height, uint32_t pi
     dpi->height = height;
     dpi->pitch = _pitch - width;
 
-    ConfigureDirtyGrid();
+    _dirtyGrid.Configure(_width, _height);
 
 #ifdef __ENABLE_LIGHTFX__
     if (lightfx_is_available())
@@ -355,82 +318,16 @@ void X8DrawingEngine::OnDrawDirtyBlock(
 {
 }
 
-void X8DrawingEngine::ConfigureDirtyGrid()
-{
-    _dirtyGrid.BlockShiftX = 7;
-    _dirtyGrid.BlockShiftY = 6;
-    _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
-    _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
-    _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
-    _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
-
-    delete[] _dirtyGrid.Blocks;
-    _dirtyGrid.Blocks = new uint8_t[_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows];
-}
-
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
+    for (const auto& region : _dirtyGrid.TakeRegions())
     {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
-        {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
-            if (_dirtyGrid.Blocks[yOffset + x] == 0)
-            {
-                continue;
-            }
-
-            // Determine columns
-            uint32_t xx;
-            for (xx = x; xx < _dirtyGrid.BlockColumns; xx++)
-            {
-                if (_dirtyGrid.Blocks[yOffset + xx] == 0)
-                {
-                    break;
-                }
-            }
-
-            // Check rows
-            uint32_t columns = xx - x;
-            auto rows = GetNumDirtyRows(x, y, columns);
-            DrawDirtyBlocks(x, y, columns, rows);
-        }
+        DrawDirtyBlocks(region.X, region.Y, region.Columns, region.Rows);
     }
 }
 
-uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
-{
-    uint32_t yy = y;
-
-    for (yy = y; yy < _dirtyGrid.BlockRows; yy++)
-    {
-        uint32_t yyOffset = yy * _dirtyGrid.BlockColumns;
-        for (uint32_t xx = x; xx < x + columns; xx++)
-        {
-            if (_dirtyGrid.Blocks[yyOffset + xx] == 0)
-            {
-                return yy - y;
-            }
-        }
-    }
-    return yy - y;
-}
-
 void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
 {
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-
-    // Unset dirty blocks
-    for (uint32_t top = y; top < y + rows; top++)
-    {
-        uint32_t topOffset = top * dirtyBlockColumns;
-        for (uint32_t left = x; left < x + columns; left++)
-        {
-            screenDirtyBlocks[topOffset + left] = 0;
-        }
-    }
-
     // Determine region in pixels
     uint32_t left = std::max<uint32_t>(0, x * _dirtyGrid.BlockWidth);
     uint32_t top = std::max<uint32_t>(0, y * _dirtyGrid.BlockHeight);
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "DirtyGrid.h"
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 
@@ -24,17 +25,6 @@ namespace OpenRCT2
     {
         class X8DrawingContext;
 
-        struct DirtyGrid
-        {
-            uint32_t BlockShiftX;
-            uint32_t BlockShiftY;
-            uint32_t BlockWidth;
-            uint32_t BlockHeight;
-            uint32_t BlockColumns;
-            uint32_t BlockRows;
-            uint8_t* Blocks;
-        };
-
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
@@ -108,9 +98,12 @@ namespace OpenRCT2
             void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy) override;
             std::string Screenshot() override;
             IDrawingContext* GetDrawingContext() override;
+            void BeginParallelDraw() override;
+            void EndParallelDraw() override;
             rct_drawpixelinfo* GetDrawingPixelInfo() override;
             DRAWING_ENGINE_FLAGS GetFlags() override;
             void InvalidateImage(uint32_t image) override;
+            DirtyGridStats GetDirtyGridStats() override;
 
             rct_drawpixelinfo* GetDPI();
 
@@ -119,10 +112,8 @@ namespace OpenRCT2
             virtual void OnDrawDirtyBlock(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
 
         private:
-            void ConfigureDirtyGrid();
             static void ResetWindowVisbilities();
             void DrawAllDirtyBlocks();
-            uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
             void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
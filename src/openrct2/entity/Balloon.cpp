@@ -25,9 +25,9 @@ template<> bool EntityBase::Is<Balloon>() const
 
 void Balloon::Update()
 {
-    Invalidate();
     if (popped == 1)
     {
+        Invalidate();
         frame++;
         if (frame >= 5)
         {
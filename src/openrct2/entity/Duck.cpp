@@ -206,7 +206,6 @@ void Duck::UpdateSwim()
                 {
                     destination.z = waterZ;
                     MoveTo(destination);
-                    Invalidate();
                 }
             }
         }
@@ -253,8 +252,6 @@ void Duck::UpdateFlyAway()
             frame = 0;
         }
 
-        Invalidate();
-
         int32_t direction = sprite_direction >> 3;
         auto destination = CoordsXYZ{ x + (DuckMoveOffset[direction].x * 2), y + (DuckMoveOffset[direction].y * 2),
                                       std::min<int32_t>(z + 2, 496) };
@@ -10,6 +10,9 @@
 #include "EntityBase.h"
 
 #include "../core/DataSerialiser.h"
+#include "../world/Map.h"
+
+#include <algorithm>
 
 // Required for GetEntity to return a default
 template<> bool EntityBase::Is<EntityBase>() const
@@ -29,42 +32,62 @@ void EntityBase::SetLocation(const CoordsXYZ& newLocation)
     z = newLocation.z;
 }
 
-void EntityBase::Invalidate()
+static ZoomLevel GetEntityInvalidationZoom(EntityType type)
 {
-    if (x == LOCATION_NULL)
-        return;
-
-    ZoomLevel maxZoom{ 0 };
-    switch (Type)
+    switch (type)
     {
         case EntityType::Vehicle:
         case EntityType::Guest:
         case EntityType::Staff:
-            maxZoom = ZoomLevel{ 2 };
-            break;
-        case EntityType::CrashedVehicleParticle:
-        case EntityType::JumpingFountain:
-            maxZoom = ZoomLevel{ 0 };
-            break;
-        case EntityType::Duck:
-            maxZoom = ZoomLevel{ 1 };
-            break;
         case EntityType::SteamParticle:
         case EntityType::MoneyEffect:
         case EntityType::ExplosionCloud:
         case EntityType::CrashSplash:
         case EntityType::ExplosionFlare:
         case EntityType::Balloon:
-            maxZoom = ZoomLevel{ 2 };
-            break;
+            return ZoomLevel{ 2 };
+        case EntityType::Duck:
+            return ZoomLevel{ 1 };
+        case EntityType::CrashedVehicleParticle:
+        case EntityType::JumpingFountain:
         case EntityType::Litter:
-            maxZoom = ZoomLevel{ 0 };
-            break;
         default:
-            break;
+            return ZoomLevel{ 0 };
     }
+}
 
-    viewports_invalidate(SpriteRect, maxZoom);
+void EntityBase::Invalidate()
+{
+    if (x == LOCATION_NULL)
+        return;
+
+    map_invalidate_screen_rect(SpriteRect, GetEntityInvalidationZoom(Type));
+}
+
+void EntityBase::InvalidateMove(const ScreenRect& previousRect)
+{
+    const auto maxZoom = GetEntityInvalidationZoom(Type);
+    if (x == LOCATION_NULL)
+    {
+        map_invalidate_screen_rect(previousRect, maxZoom);
+        return;
+    }
+
+    // Entities mostly move by a pixel or two, a single rectangle covering both positions is barely any larger.
+    const ScreenRect merged = { { std::min(previousRect.GetLeft(), SpriteRect.GetLeft()),
+                                  std::min(previousRect.GetTop(), SpriteRect.GetTop()) },
+                                { std::max(previousRect.GetRight(), SpriteRect.GetRight()),
+                                  std::max(previousRect.GetBottom(), SpriteRect.GetBottom()) } };
+    const auto area = [](const ScreenRect& rect) { return static_cast<int64_t>(rect.GetWidth()) * rect.GetHeight(); };
+    if (area(merged) <= area(previousRect) + area(SpriteRect))
+    {
+        map_invalidate_screen_rect(merged, maxZoom);
+    }
+    else
+    {
+        map_invalidate_screen_rect(previousRect, maxZoom);
+        map_invalidate_screen_rect(SpriteRect, maxZoom);
+    }
 }
 
 void EntityBase::Serialise(DataSerialiser& stream)
@@ -58,7 +58,15 @@ struct EntityBase
      */
     CoordsXYZ GetLocation() const;
 
+    /**
+     * Invalidates the area covered by the entity when the next frame is drawn.
+     */
     void Invalidate();
+
+    /**
+     * Invalidates the area the entity covered before it moved together with the area it covers now.
+     */
+    void InvalidateMove(const ScreenRect& previousRect);
     template<typename T> bool Is() const;
     template<typename T> T* As()
     {
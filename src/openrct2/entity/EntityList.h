@@ -15,27 +15,38 @@
 #include "EntityBase.h"
 #include "EntityRegistry.h"
 
-#include <list>
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
-const std::list<uint16_t>& GetEntityList(const EntityType id);
+struct Vehicle;
+
+const std::vector<uint16_t>& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
 uint16_t GetNumFreeEntities();
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos);
+uint16_t GetFirstEntityOnTile(const CoordsXY& spritePos);
+uint16_t GetNextEntityOnTile(uint16_t spriteIndex);
+uint16_t GetFirstVehicleOnTile(const CoordsXY& spritePos);
+uint16_t GetNextVehicleOnTile(uint16_t spriteIndex);
+
+/**
+ * Collects the ids of all entities on the tiles covered by the given range in one pass.
+ * Ids are grouped per tile and are in sprite_index order within each tile.
+ */
+void GetEntitiesInRange(const MapRange& range, std::vector<uint16_t>& result);
 
 template<typename T> class EntityTileIterator
 {
 private:
-    std::vector<uint16_t>::const_iterator iter;
-    std::vector<uint16_t>::const_iterator end;
+    uint16_t next = SPRITE_INDEX_NULL;
     T* Entity = nullptr;
 
 public:
-    EntityTileIterator(std::vector<uint16_t>::const_iterator _iter, std::vector<uint16_t>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityTileIterator() = default;
+    explicit EntityTileIterator(uint16_t first)
+        : next(first)
     {
         ++(*this);
     }
@@ -43,9 +54,18 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        while (next != SPRITE_INDEX_NULL && Entity == nullptr)
         {
-            Entity = GetEntity<T>(*iter++);
+            const auto id = next;
+            if constexpr (std::is_same_v<T, Vehicle>)
+            {
+                next = GetNextVehicleOnTile(id);
+            }
+            else
+            {
+                next = GetNextEntityOnTile(id);
+            }
+            Entity = GetEntity<T>(id);
         }
         return *this;
     }
@@ -54,7 +74,7 @@ public:
     {
         EntityTileIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityTileIterator other) const
     {
@@ -76,38 +96,85 @@ public:
     using iterator_category = std::forward_iterator_tag;
 };
 
+/**
+ * Entities on a single tile. Vehicles have lists of their own, iterating the vehicles on a tile
+ * does not visit any other entity.
+ */
 template<typename T = EntityBase> class EntityTileList
 {
 private:
-    const std::vector<uint16_t>& vec;
+    uint16_t first;
 
 public:
     EntityTileList(const CoordsXY& loc)
-        : vec(GetEntityTileList(loc))
+        : first(std::is_same_v<T, Vehicle> ? GetFirstVehicleOnTile(loc) : GetFirstEntityOnTile(loc))
     {
     }
 
     EntityTileIterator<T> begin()
     {
-        return EntityTileIterator<T>(std::begin(vec), std::end(vec));
+        return EntityTileIterator<T>(first);
     }
     EntityTileIterator<T> end()
     {
-        return EntityTileIterator<T>(std::end(vec), std::end(vec));
+        return EntityTileIterator<T>();
+    }
+};
+
+/**
+ * Walks the sorted id vector of an entity list. Entities may be created or removed while
+ * iterating so instead of holding on to an iterator it remembers the id that followed the
+ * last visited one, entities inserted before that id are not visited.
+ */
+class EntityListCursor
+{
+private:
+    const std::vector<uint16_t>* vec = nullptr;
+    size_t index = 0;
+    uint16_t expected = SPRITE_INDEX_NULL;
+
+public:
+    EntityListCursor() = default;
+    explicit EntityListCursor(const std::vector<uint16_t>& _vec)
+        : vec(&_vec)
+        , expected(_vec.empty() ? SPRITE_INDEX_NULL : _vec.front())
+    {
+    }
+
+    uint16_t Next()
+    {
+        if (expected == SPRITE_INDEX_NULL)
+        {
+            return SPRITE_INDEX_NULL;
+        }
+
+        // Relocate the expected id if the list was modified since the last call
+        if (index >= vec->size() || (*vec)[index] != expected)
+        {
+            index = std::lower_bound(vec->begin(), vec->end(), expected) - vec->begin();
+            if (index >= vec->size())
+            {
+                expected = SPRITE_INDEX_NULL;
+                return SPRITE_INDEX_NULL;
+            }
+        }
+
+        const auto result = (*vec)[index++];
+        expected = index < vec->size() ? (*vec)[index] : SPRITE_INDEX_NULL;
+        return result;
     }
 };
 
 template<typename T> class EntityListIterator
 {
 private:
-    std::list<uint16_t>::const_iterator iter;
-    std::list<uint16_t>::const_iterator end;
+    EntityListCursor cursor;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityListIterator() = default;
+    explicit EntityListIterator(const std::vector<uint16_t>& vec)
+        : cursor(vec)
     {
         ++(*this);
     }
@@ -115,9 +182,10 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        uint16_t id;
+        while (Entity == nullptr && (id = cursor.Next()) != SPRITE_INDEX_NULL)
         {
-            Entity = GetEntity<T>(*iter++);
+            Entity = GetEntity<T>(id);
         }
         return *this;
     }
@@ -126,7 +194,7 @@ public:
     {
         EntityListIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityListIterator other) const
     {
@@ -152,7 +220,7 @@ template<typename T = EntityBase> class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<uint16_t>& vec;
+    const std::vector<uint16_t>& vec;
 
 public:
     EntityList()
@@ -162,10 +230,32 @@ public:
 
     EntityListIterator_t begin() const
     {
-        return EntityListIterator_t(std::cbegin(vec), std::cend(vec));
+        return EntityListIterator_t(vec);
     }
     EntityListIterator_t end() const
     {
-        return EntityListIterator_t(std::cend(vec), std::cend(vec));
+        return EntityListIterator_t();
     }
 };
+
+/**
+ * Calls fn for every entity of type T on the tiles within radius of the location. Entities are visited in sprite_index
+ * order, the same order as EntityList, so the result does not depend on how they are spread over the tiles. Only the
+ * tiles are checked, callers still have to test the exact distance.
+ */
+template<typename T, typename TFunc> void ForEachEntityInRadius(const CoordsXY& loc, int32_t radius, TFunc&& fn)
+{
+    static_assert(!std::is_same_v<T, Vehicle>, "Vehicles are not in the entity tile lists");
+
+    std::vector<uint16_t> ids;
+    GetEntitiesInRange({ loc.x - radius, loc.y - radius, loc.x + radius, loc.y + radius }, ids);
+    std::sort(ids.begin(), ids.end());
+    for (auto id : ids)
+    {
+        auto* entity = GetEntity<T>(id);
+        if (entity != nullptr)
+        {
+            fn(entity);
+        }
+    }
+}
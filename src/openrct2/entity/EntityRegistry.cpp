@@ -14,6 +14,8 @@
 #include "../core/Crypt.h"
 #include "../core/DataSerialiser.h"
 #include "../core/Guard.hpp"
+#include "../core/LargePageAllocator.h"
+#include "../core/MemoryAccounting.h"
 #include "../core/MemoryStream.h"
 #include "../entity/Peep.h"
 #include "../entity/Staff.h"
@@ -21,6 +23,7 @@
 #include "../peep/RideUseSystem.h"
 #include "../ride/Vehicle.h"
 #include "../scenario/Scenario.h"
+#include "../util/Util.h"
 #include "Balloon.h"
 #include "Duck.h"
 #include "EntityTweener.h"
@@ -30,8 +33,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
-#include <numeric>
+#include <memory>
 #include <vector>
 
 union Entity
@@ -44,16 +48,124 @@ union Entity
     }
 };
 
-static Entity _entities[MAX_ENTITIES]{};
-static std::array<std::list<uint16_t>, EnumValue(EntityType::Count)> gEntityLists;
-static std::vector<uint16_t> _freeIdList;
+static Entity* AllocateEntities()
+{
+    auto* entities = static_cast<Entity*>(OpenRCT2::LargePages::Allocate(sizeof(Entity) * MAX_ENTITIES));
+    std::uninitialized_default_construct_n(entities, MAX_ENTITIES);
+    return entities;
+}
+
+// Allocated before large pages can be enabled, moved onto them by the first reset after they are.
+static Entity* _entities = AllocateEntities();
+static bool _entitiesOnLargePages = false;
+static std::array<std::vector<uint16_t>, EnumValue(EntityType::Count)> gEntityLists;
+
+/**
+ * Two level bitmap of free entity ids. Allocation always hands out the lowest free id
+ * which keeps the id selection identical between clients.
+ */
+class EntityFreeIdSet
+{
+private:
+    static constexpr size_t WordCount = (MAX_ENTITIES + 63) / 64;
+    static constexpr size_t SummaryCount = (WordCount + 63) / 64;
+
+    // Bit n of _words[i] is set when id (i * 64 + n) is free.
+    std::array<uint64_t, WordCount> _words{};
+    // Bit n of _summary[i] is set when _words[i * 64 + n] has any free id.
+    std::array<uint64_t, SummaryCount> _summary{};
+    size_t _count{};
+
+public:
+    void Reset()
+    {
+        _words.fill(~0ULL);
+        _summary.fill(~0ULL);
+        // Clear the bits past the last valid id.
+        _words[WordCount - 1] = ~0ULL >> (WordCount * 64 - MAX_ENTITIES);
+        _summary[SummaryCount - 1] = ~0ULL >> (SummaryCount * 64 - WordCount);
+        _count = MAX_ENTITIES;
+    }
+
+    size_t GetCount() const
+    {
+        return _count;
+    }
+
+    bool Contains(uint16_t index) const
+    {
+        return index < MAX_ENTITIES && (_words[index / 64] & (1ULL << (index % 64))) != 0;
+    }
+
+    void Add(uint16_t index)
+    {
+        if (index >= MAX_ENTITIES || Contains(index))
+            return;
+
+        _words[index / 64] |= 1ULL << (index % 64);
+        _summary[index / 4096] |= 1ULL << ((index / 64) % 64);
+        _count++;
+    }
+
+    void Remove(uint16_t index)
+    {
+        if (!Contains(index))
+            return;
+
+        auto& word = _words[index / 64];
+        word &= ~(1ULL << (index % 64));
+        if (word == 0)
+        {
+            _summary[index / 4096] &= ~(1ULL << ((index / 64) % 64));
+        }
+        _count--;
+    }
+
+    uint16_t GetLowest() const
+    {
+        for (size_t i = 0; i < SummaryCount; i++)
+        {
+            if (_summary[i] != 0)
+            {
+                const auto wordIndex = i * 64 + bitscanforward(static_cast<int64_t>(_summary[i]));
+                const auto bit = bitscanforward(static_cast<int64_t>(_words[wordIndex]));
+                return static_cast<uint16_t>(wordIndex * 64 + bit);
+            }
+        }
+        return SPRITE_INDEX_NULL;
+    }
+};
+
+static EntityFreeIdSet _freeIds;
 
 static bool _entityFlashingList[MAX_ENTITIES];
 
+// Entities created while a batch is open, they are added to the entity lists once it is closed.
+static bool _entityBatchActive = false;
+static std::vector<std::pair<uint16_t, EntityType>> _entityBatchCreated;
+
 constexpr const uint32_t SPATIAL_INDEX_SIZE = (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) + 1;
 constexpr const uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
 
-static std::array<std::vector<uint16_t>, SPATIAL_INDEX_SIZE> gEntitySpatialIndex;
+// Intrusive singly linked list per tile, kept in sprite_index order.
+static std::array<uint16_t, SPATIAL_INDEX_SIZE> gEntitySpatialIndex;
+static std::array<uint16_t, MAX_ENTITIES> gEntitySpatialNext;
+// The same lists holding only the vehicles, so collision checks do not have to step over guests on busy tiles.
+static std::array<uint16_t, SPATIAL_INDEX_SIZE> gVehicleSpatialIndex;
+static std::array<uint16_t, MAX_ENTITIES> gVehicleSpatialNext;
+
+static OpenRCT2::MemoryAccounting::Registration _entitiesMemory("entities", [] {
+    size_t bytes = sizeof(Entity) * MAX_ENTITIES + sizeof(_freeIds) + sizeof(_entityFlashingList);
+    for (const auto& list : gEntityLists)
+    {
+        bytes += list.capacity() * sizeof(uint16_t);
+    }
+    return bytes;
+});
+static OpenRCT2::MemoryAccounting::Registration _entitySpatialIndexMemory("entitySpatialIndex", [] {
+    return sizeof(gEntitySpatialIndex) + sizeof(gEntitySpatialNext) + sizeof(gVehicleSpatialIndex)
+        + sizeof(gVehicleSpatialNext);
+});
 
 static void FreeEntity(EntityBase& entity);
 
@@ -98,7 +210,7 @@ uint16_t GetEntityListCount(EntityType type)
 
 uint16_t GetNumFreeEntities()
 {
-    return static_cast<uint16_t>(_freeIdList.size());
+    return static_cast<uint16_t>(_freeIds.GetCount());
 }
 
 std::string EntitiesChecksum::ToString() const
@@ -131,11 +243,52 @@ EntityBase* GetEntity(size_t entityIndex)
     return TryGetEntity(entityIndex);
 }
 
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos)
+uint16_t GetFirstEntityOnTile(const CoordsXY& spritePos)
 {
     return gEntitySpatialIndex[GetSpatialIndexOffset(spritePos)];
 }
 
+uint16_t GetNextEntityOnTile(uint16_t spriteIndex)
+{
+    return spriteIndex < MAX_ENTITIES ? gEntitySpatialNext[spriteIndex] : SPRITE_INDEX_NULL;
+}
+
+uint16_t GetFirstVehicleOnTile(const CoordsXY& spritePos)
+{
+    return gVehicleSpatialIndex[GetSpatialIndexOffset(spritePos)];
+}
+
+uint16_t GetNextVehicleOnTile(uint16_t spriteIndex)
+{
+    return spriteIndex < MAX_ENTITIES ? gVehicleSpatialNext[spriteIndex] : SPRITE_INDEX_NULL;
+}
+
+void GetEntitiesInRange(const MapRange& range, std::vector<uint16_t>& result)
+{
+    result.clear();
+
+    const auto normRange = range.Normalise();
+    if (normRange.GetRight() < 0 || normRange.GetBottom() < 0)
+        return;
+
+    const auto tileLeft = std::max(normRange.GetLeft(), 0) / COORDS_XY_STEP;
+    const auto tileTop = std::max(normRange.GetTop(), 0) / COORDS_XY_STEP;
+    const auto tileRight = std::min(normRange.GetRight() / COORDS_XY_STEP, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const auto tileBottom = std::min(normRange.GetBottom() / COORDS_XY_STEP, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+
+    for (auto tileX = tileLeft; tileX <= tileRight; tileX++)
+    {
+        const auto* column = &gEntitySpatialIndex[tileX * MAXIMUM_MAP_SIZE_TECHNICAL];
+        for (auto tileY = tileTop; tileY <= tileBottom; tileY++)
+        {
+            for (auto id = column[tileY]; id != SPRITE_INDEX_NULL; id = gEntitySpatialNext[id])
+            {
+                result.push_back(id);
+            }
+        }
+    }
+}
+
 static void ResetEntityLists()
 {
     for (auto& list : gEntityLists)
@@ -146,14 +299,10 @@ static void ResetEntityLists()
 
 static void ResetFreeIds()
 {
-    _freeIdList.clear();
-
-    _freeIdList.resize(MAX_ENTITIES);
-    // List needs to be back to front to simplify removing
-    std::iota(std::rbegin(_freeIdList), std::rend(_freeIdList), 0);
+    _freeIds.Reset();
 }
 
-const std::list<uint16_t>& GetEntityList(const EntityType id)
+const std::vector<uint16_t>& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -177,7 +326,14 @@ void ResetAllEntities()
         FreeEntity(*spr);
     }
 
-    std::fill(std::begin(_entities), std::end(_entities), Entity());
+    if (!_entitiesOnLargePages && OpenRCT2::LargePages::IsEnabled())
+    {
+        // Nothing refers to an entity once they have all been freed, so this is the time to move them.
+        OpenRCT2::LargePages::Free(_entities, sizeof(Entity) * MAX_ENTITIES);
+        _entities = AllocateEntities();
+        _entitiesOnLargePages = true;
+    }
+    std::fill(_entities, _entities + MAX_ENTITIES, Entity());
     OpenRCT2::RideUse::GetHistory().Clear();
     OpenRCT2::RideUse::GetTypeHistory().Clear();
     for (int32_t i = 0; i < MAX_ENTITIES; ++i)
@@ -192,12 +348,17 @@ void ResetAllEntities()
 
         _entityFlashingList[i] = false;
     }
+    // A load that failed part way through may have left a batch open.
+    _entityBatchActive = false;
+    _entityBatchCreated.clear();
+
     ResetEntityLists();
     ResetFreeIds();
     ResetEntitySpatialIndices();
 }
 
 static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc);
+static void EntityChecksumInvalidateAll();
 
 /**
  *
@@ -207,16 +368,28 @@ static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc);
  */
 void ResetEntitySpatialIndices()
 {
-    for (auto& vec : gEntitySpatialIndex)
-    {
-        vec.clear();
-    }
-    for (size_t i = 0; i < MAX_ENTITIES; i++)
+    // Called after entities were loaded or replaced wholesale.
+    EntityChecksumInvalidateAll();
+    gEntitySpatialIndex.fill(SPRITE_INDEX_NULL);
+    gEntitySpatialNext.fill(SPRITE_INDEX_NULL);
+    gVehicleSpatialIndex.fill(SPRITE_INDEX_NULL);
+    gVehicleSpatialNext.fill(SPRITE_INDEX_NULL);
+
+    // Pushing to the front in descending order leaves every list in sprite_index order without walking it.
+    for (size_t i = MAX_ENTITIES; i-- > 0;)
     {
         auto* spr = GetEntity(i);
-        if (spr != nullptr && spr->Type != EntityType::Null)
+        if (spr == nullptr || spr->Type == EntityType::Null)
         {
-            EntitySpatialInsert(spr, { spr->x, spr->y });
+            continue;
+        }
+        const auto spatialIndex = GetSpatialIndexOffset({ spr->x, spr->y });
+        gEntitySpatialNext[i] = gEntitySpatialIndex[spatialIndex];
+        gEntitySpatialIndex[spatialIndex] = static_cast<uint16_t>(i);
+        if (spr->Type == EntityType::Vehicle)
+        {
+            gVehicleSpatialNext[i] = gVehicleSpatialIndex[spatialIndex];
+            gVehicleSpatialIndex[spatialIndex] = static_cast<uint16_t>(i);
         }
     }
 }
@@ -246,6 +419,145 @@ EntitiesChecksum GetAllEntitiesChecksum()
 
     return checksum;
 }
+
+// Running hash per entity slot, the incremental checksum is the wrapping sum of all slots.
+static std::array<uint64_t, MAX_ENTITIES> _entitySlotChecksums;
+static std::array<bool, MAX_ENTITIES> _entitySlotChecksumDirty;
+static std::vector<uint16_t> _entitySlotChecksumDirtyList;
+static bool _entityChecksumsAllDirty = true;
+static uint64_t _entityChecksumTotal;
+
+template<typename T> static uint64_t SerialiseEntitySlotChecksum(T* entity)
+{
+    std::array<std::byte, 20> raw{};
+    OpenRCT2::ChecksumStream ms(raw);
+    DataSerialiser ds(true, ms);
+    entity->Serialise(ds);
+
+    uint64_t hash;
+    std::memcpy(&hash, raw.data(), sizeof(hash));
+    return hash;
+}
+
+static uint64_t ComputeEntitySlotChecksum(uint16_t index)
+{
+    auto* entity = GetEntity(index);
+    if (entity == nullptr)
+    {
+        return 0;
+    }
+
+    uint64_t hash;
+    switch (entity->Type)
+    {
+        case EntityType::Guest:
+            hash = SerialiseEntitySlotChecksum(entity->As<Guest>());
+            break;
+        case EntityType::Staff:
+            hash = SerialiseEntitySlotChecksum(entity->As<Staff>());
+            break;
+        case EntityType::Vehicle:
+            hash = SerialiseEntitySlotChecksum(entity->As<Vehicle>());
+            break;
+        case EntityType::Litter:
+            hash = SerialiseEntitySlotChecksum(entity->As<Litter>());
+            break;
+        default:
+            return 0;
+    }
+
+    // Mix in the slot so that entities swapping places changes the sum.
+    hash ^= (static_cast<uint64_t>(index) + 1) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+static void RefreshEntitySlotChecksums()
+{
+    if (_entityChecksumsAllDirty)
+    {
+        _entitySlotChecksums.fill(0);
+        _entityChecksumTotal = 0;
+        for (auto type : { EntityType::Guest, EntityType::Staff, EntityType::Vehicle, EntityType::Litter })
+        {
+            for (auto index : GetEntityList(type))
+            {
+                _entitySlotChecksums[index] = ComputeEntitySlotChecksum(index);
+                _entityChecksumTotal += _entitySlotChecksums[index];
+            }
+        }
+        _entityChecksumsAllDirty = false;
+    }
+    else
+    {
+        for (auto index : _entitySlotChecksumDirtyList)
+        {
+            _entityChecksumTotal -= _entitySlotChecksums[index];
+            _entitySlotChecksums[index] = ComputeEntitySlotChecksum(index);
+            _entityChecksumTotal += _entitySlotChecksums[index];
+        }
+    }
+
+    for (auto index : _entitySlotChecksumDirtyList)
+    {
+        _entitySlotChecksumDirty[index] = false;
+    }
+    _entitySlotChecksumDirtyList.clear();
+}
+
+#    ifdef DEBUG
+static uint64_t ComputeAllEntitySlotChecksums()
+{
+    uint64_t total = 0;
+    for (auto type : { EntityType::Guest, EntityType::Staff, EntityType::Vehicle, EntityType::Litter })
+    {
+        for (auto index : GetEntityList(type))
+        {
+            total += ComputeEntitySlotChecksum(index);
+        }
+    }
+    return total;
+}
+#    endif
+
+EntitiesChecksum GetAllEntitiesIncrementalChecksum()
+{
+    RefreshEntitySlotChecksums();
+
+#    ifdef DEBUG
+    // Catches entities that were modified without being invalidated.
+    if (ComputeAllEntitySlotChecksums() != _entityChecksumTotal)
+    {
+        openrct2_assert(false, "Incremental entity checksum out of sync, an entity was modified without invalidation");
+        _entityChecksumsAllDirty = true;
+        RefreshEntitySlotChecksums();
+    }
+#    endif
+
+    EntitiesChecksum checksum{};
+    std::memcpy(checksum.raw.data(), &_entityChecksumTotal, sizeof(_entityChecksumTotal));
+    return checksum;
+}
+
+void EntityChecksumInvalidate(const EntityBase* entity)
+{
+    const auto index = entity->sprite_index;
+    if (index >= MAX_ENTITIES || _entitySlotChecksumDirty[index])
+    {
+        return;
+    }
+    _entitySlotChecksumDirty[index] = true;
+    _entitySlotChecksumDirtyList.push_back(index);
+}
+
+static void EntityChecksumInvalidateAll()
+{
+    _entityChecksumsAllDirty = true;
+}
 #else
 
 EntitiesChecksum GetAllEntitiesChecksum()
@@ -253,6 +565,19 @@ EntitiesChecksum GetAllEntitiesChecksum()
     return EntitiesChecksum{};
 }
 
+EntitiesChecksum GetAllEntitiesIncrementalChecksum()
+{
+    return EntitiesChecksum{};
+}
+
+void EntityChecksumInvalidate(const EntityBase* entity)
+{
+}
+
+static void EntityChecksumInvalidateAll()
+{
+}
+
 #endif // DISABLE_NETWORK
 
 static void EntityReset(EntityBase* entity)
@@ -271,6 +596,7 @@ static void EntityReset(EntityBase* entity)
 static constexpr uint16_t MAX_MISC_SPRITES = 300;
 static void AddToEntityList(EntityBase* entity)
 {
+    EntityChecksumInvalidate(entity);
     auto& list = gEntityLists[EnumValue(entity->Type)];
     // Entity list must be in sprite_index order to prevent desync issues
     list.insert(std::lower_bound(std::begin(list), std::end(list), entity->sprite_index), entity->sprite_index);
@@ -278,12 +604,12 @@ static void AddToEntityList(EntityBase* entity)
 
 static void AddToFreeList(uint16_t index)
 {
-    // Free list must be in reverse sprite_index order to prevent desync issues
-    _freeIdList.insert(std::upper_bound(std::rbegin(_freeIdList), std::rend(_freeIdList), index).base(), index);
+    _freeIds.Add(index);
 }
 
 static void RemoveFromEntityList(EntityBase* entity)
 {
+    EntityChecksumInvalidate(entity);
     auto& list = gEntityLists[EnumValue(entity->Type)];
     auto ptr = std::lower_bound(std::begin(list), std::end(list), entity->sprite_index);
     if (ptr != std::end(list) && *ptr == entity->sprite_index)
@@ -311,7 +637,14 @@ static void PrepareNewEntity(EntityBase* base, const EntityType type)
     EntityReset(base);
 
     base->Type = type;
-    AddToEntityList(base);
+    if (_entityBatchActive)
+    {
+        _entityBatchCreated.emplace_back(base->sprite_index, type);
+    }
+    else
+    {
+        AddToEntityList(base);
+    }
 
     base->x = LOCATION_NULL;
     base->y = LOCATION_NULL;
@@ -321,12 +654,15 @@ static void PrepareNewEntity(EntityBase* base, const EntityType type)
     base->sprite_height_positive = 0x8;
     base->SpriteRect = {};
 
-    EntitySpatialInsert(base, { LOCATION_NULL, 0 });
+    if (!_entityBatchActive)
+    {
+        EntitySpatialInsert(base, { LOCATION_NULL, 0 });
+    }
 }
 
 EntityBase* CreateEntity(EntityType type)
 {
-    if (_freeIdList.size() == 0)
+    if (_freeIds.GetCount() == 0)
     {
         // No free sprites.
         return nullptr;
@@ -338,18 +674,20 @@ EntityBase* CreateEntity(EntityType type)
         // free it will fail to keep slots for more relevant sprites.
         // Also there can't be more than MAX_MISC_SPRITES sprites in this list.
         uint16_t miscSlotsRemaining = MAX_MISC_SPRITES - GetMiscEntityCount();
-        if (miscSlotsRemaining >= _freeIdList.size())
+        if (miscSlotsRemaining >= _freeIds.GetCount())
         {
             return nullptr;
         }
     }
 
-    auto* entity = GetEntity(_freeIdList.back());
+    // Always use the lowest free id to prevent desync issues
+    const auto index = _freeIds.GetLowest();
+    auto* entity = GetEntity(index);
     if (entity == nullptr)
     {
         return nullptr;
     }
-    _freeIdList.pop_back();
+    _freeIds.Remove(index);
 
     PrepareNewEntity(entity, type);
 
@@ -358,8 +696,7 @@ EntityBase* CreateEntity(EntityType type)
 
 EntityBase* CreateEntityAt(const uint16_t index, const EntityType type)
 {
-    auto id = std::lower_bound(std::rbegin(_freeIdList), std::rend(_freeIdList), index);
-    if (id == std::rend(_freeIdList) || *id != index)
+    if (!_freeIds.Contains(index))
     {
         return nullptr;
     }
@@ -370,12 +707,50 @@ EntityBase* CreateEntityAt(const uint16_t index, const EntityType type)
         return nullptr;
     }
 
-    _freeIdList.erase(std::next(id).base());
+    _freeIds.Remove(index);
 
     PrepareNewEntity(entity, type);
     return entity;
 }
 
+void EntityBatchBegin()
+{
+    Guard::Assert(!_entityBatchActive, "Entity batch already open");
+    _entityBatchActive = true;
+    _entityBatchCreated.clear();
+}
+
+void EntityBatchEnd()
+{
+    Guard::Assert(_entityBatchActive, "No entity batch open");
+    _entityBatchActive = false;
+
+    // Append every new entity to its list and merge the sorted tail back in, one pass per list.
+    std::array<size_t, EnumValue(EntityType::Count)> previousSizes;
+    for (size_t i = 0; i < gEntityLists.size(); i++)
+    {
+        previousSizes[i] = gEntityLists[i].size();
+    }
+    for (const auto& [index, type] : _entityBatchCreated)
+    {
+        gEntityLists[EnumValue(type)].push_back(index);
+    }
+    for (size_t i = 0; i < gEntityLists.size(); i++)
+    {
+        auto& list = gEntityLists[i];
+        if (list.size() == previousSizes[i])
+        {
+            continue;
+        }
+        const auto middle = list.begin() + previousSizes[i];
+        std::sort(middle, list.end());
+        std::inplace_merge(list.begin(), middle, list.end());
+    }
+    _entityBatchCreated.clear();
+
+    ResetEntitySpatialIndices();
+}
+
 template<typename T> void MiscUpdateAllType()
 {
     for (auto misc : EntityList<T>())
@@ -401,24 +776,52 @@ void UpdateAllMiscEntities()
 }
 
 // Performs a search to ensure that insert keeps next_in_quadrant in sprite_index order
+static void SpatialListInsert(uint16_t* head, uint16_t* next, uint16_t spriteIndex)
+{
+    auto* link = head;
+    while (*link != SPRITE_INDEX_NULL && *link < spriteIndex)
+    {
+        link = &next[*link];
+    }
+    next[spriteIndex] = *link;
+    *link = spriteIndex;
+}
+
+static bool SpatialListRemove(uint16_t* head, uint16_t* next, uint16_t spriteIndex)
+{
+    auto* link = head;
+    while (*link != SPRITE_INDEX_NULL && *link < spriteIndex)
+    {
+        link = &next[*link];
+    }
+    if (*link != spriteIndex)
+    {
+        return false;
+    }
+    *link = next[spriteIndex];
+    next[spriteIndex] = SPRITE_INDEX_NULL;
+    return true;
+}
+
 static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc)
 {
     size_t newIndex = GetSpatialIndexOffset(newLoc);
-    auto& spatialVector = gEntitySpatialIndex[newIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), entity->sprite_index);
-    spatialVector.insert(index, entity->sprite_index);
+    SpatialListInsert(&gEntitySpatialIndex[newIndex], gEntitySpatialNext.data(), entity->sprite_index);
+    if (entity->Type == EntityType::Vehicle)
+    {
+        SpatialListInsert(&gVehicleSpatialIndex[newIndex], gVehicleSpatialNext.data(), entity->sprite_index);
+    }
 }
 
 static void EntitySpatialRemove(EntityBase* entity)
 {
     size_t currentIndex = GetSpatialIndexOffset({ entity->x, entity->y });
-    auto& spatialVector = gEntitySpatialIndex[currentIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), entity->sprite_index);
-    if (index != std::end(spatialVector) && *index == entity->sprite_index)
+    bool removed = SpatialListRemove(&gEntitySpatialIndex[currentIndex], gEntitySpatialNext.data(), entity->sprite_index);
+    if (removed && entity->Type == EntityType::Vehicle)
     {
-        spatialVector.erase(index, index + 1);
+        removed = SpatialListRemove(&gVehicleSpatialIndex[currentIndex], gVehicleSpatialNext.data(), entity->sprite_index);
     }
-    else
+    if (!removed)
     {
         log_warning("Bad sprite spatial index. Rebuilding the spatial index...");
         ResetEntitySpatialIndices();
@@ -438,11 +841,10 @@ static void EntitySpatialMove(EntityBase* entity, const CoordsXY& newLoc)
 
 void EntityBase::MoveTo(const CoordsXYZ& newLocation)
 {
-    if (x != LOCATION_NULL)
-    {
-        // Invalidate old position.
-        Invalidate();
-    }
+    EntityChecksumInvalidate(this);
+
+    const bool wasOnMap = x != LOCATION_NULL;
+    const auto previousRect = SpriteRect;
 
     auto loc = newLocation;
     if (!map_is_location_valid(loc))
@@ -461,7 +863,15 @@ void EntityBase::MoveTo(const CoordsXYZ& newLocation)
     else
     {
         EntitySetCoordinates(loc, this);
-        Invalidate(); // Invalidate new position.
+    }
+
+    if (wasOnMap)
+    {
+        InvalidateMove(previousRect);
+    }
+    else
+    {
+        Invalidate();
     }
 }
 
@@ -501,6 +911,7 @@ static void FreeEntity(EntityBase& entity)
  */
 void EntityRemove(EntityBase* entity)
 {
+    Guard::Assert(!_entityBatchActive, "Entities can not be removed while an entity batch is open");
     FreeEntity(*entity);
 
     EntityTweener::Get().RemoveEntity(entity);
@@ -47,6 +47,11 @@ template<typename T> T* CreateEntityAt(const uint16_t index)
     return static_cast<T*>(CreateEntityAt(index, T::cEntityType));
 }
 
+// Defers adding entities made by CreateEntityAt to the entity lists and spatial index until EntityBatchEnd, which
+// places them by their current location. Lists must not be iterated and entities not moved or removed in between.
+void EntityBatchBegin();
+void EntityBatchEnd();
+
 void ResetAllEntities();
 void ResetEntitySpatialIndices();
 void UpdateAllMiscEntities();
@@ -64,5 +69,12 @@ struct EntitiesChecksum
 #pragma pack(pop)
 EntitiesChecksum GetAllEntitiesChecksum();
 
+/**
+ * Order independent checksum over the same entities as GetAllEntitiesChecksum, only entities
+ * invalidated since the last call are reserialised. Not compatible with the full checksum.
+ */
+EntitiesChecksum GetAllEntitiesIncrementalChecksum();
+void EntityChecksumInvalidate(const EntityBase* entity);
+
 void EntitySetFlashing(EntityBase* entity, bool flashing);
 bool EntityGetFlashing(EntityBase* entity);
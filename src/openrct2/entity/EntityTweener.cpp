@@ -14,23 +14,51 @@
 #include "EntityList.h"
 #include "EntityRegistry.h"
 
+#include <algorithm>
 #include <cmath>
+
+void EntityTweener::PositionArrays::Push(const CoordsXYZ& pos)
+{
+    X.push_back(pos.x);
+    Y.push_back(pos.y);
+    Z.push_back(pos.z);
+}
+
+CoordsXYZ EntityTweener::PositionArrays::Get(size_t index) const
+{
+    return { X[index], Y[index], Z[index] };
+}
+
+void EntityTweener::PositionArrays::Resize(size_t size)
+{
+    X.resize(size);
+    Y.resize(size);
+    Z.resize(size);
+}
+
+void EntityTweener::PositionArrays::Clear()
+{
+    X.clear();
+    Y.clear();
+    Z.clear();
+}
+
 void EntityTweener::PopulateEntities()
 {
     for (auto ent : EntityList<Guest>())
     {
         Entities.push_back(ent);
-        PrePos.emplace_back(ent->GetLocation());
+        PrePos.Push(ent->GetLocation());
     }
     for (auto ent : EntityList<Staff>())
     {
         Entities.push_back(ent);
-        PrePos.emplace_back(ent->GetLocation());
+        PrePos.Push(ent->GetLocation());
     }
     for (auto ent : EntityList<Vehicle>())
     {
         Entities.push_back(ent);
-        PrePos.emplace_back(ent->GetLocation());
+        PrePos.Push(ent->GetLocation());
     }
 }
 
@@ -48,11 +76,11 @@ void EntityTweener::PostTick()
         if (ent == nullptr)
         {
             // Sprite was removed, add a dummy position to keep the index aligned.
-            PostPos.emplace_back(0, 0, 0);
+            PostPos.Push({ 0, 0, 0 });
         }
         else
         {
-            PostPos.emplace_back(ent->GetLocation());
+            PostPos.Push(ent->GetLocation());
         }
     }
 }
@@ -70,27 +98,56 @@ void EntityTweener::RemoveEntity(EntityBase* entity)
         *it = nullptr;
 }
 
+/**
+ * Interpolates one axis of all positions. Kept free of branches and library calls so the compiler can vectorise it,
+ * values are rounded half away from zero.
+ */
+static void TweenAxis(const int32_t* pre, const int32_t* post, int32_t* result, size_t count, float alpha)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const float offset = static_cast<float>(post[i] - pre[i]) * alpha;
+        result[i] = pre[i] + static_cast<int32_t>(offset + std::copysign(0.5f, offset));
+    }
+}
+
+/**
+ * Moves the entity without touching the spatial index, the tick has already put it on the tile of its real position.
+ * Moves that do not change where the sprite is on the screen are not invalidated again.
+ */
+void EntityTweener::SetTweenedCoordinates(EntityBase* ent, const CoordsXYZ& pos)
+{
+    if (ent->GetLocation() == pos)
+        return;
+
+    const auto previousRect = ent->SpriteRect;
+    EntitySetCoordinates(pos, ent);
+    const auto& rect = ent->SpriteRect;
+    if (rect.GetLeft() != previousRect.GetLeft() || rect.GetTop() != previousRect.GetTop()
+        || rect.GetRight() != previousRect.GetRight() || rect.GetBottom() != previousRect.GetBottom())
+    {
+        ent->Invalidate();
+    }
+}
+
 void EntityTweener::Tween(float alpha)
 {
-    const float inv = (1.0f - alpha);
-    for (size_t i = 0; i < Entities.size(); ++i)
+    const auto count = std::min(Entities.size(), PostPos.X.size());
+    TweenPos.Resize(count);
+    TweenAxis(PrePos.X.data(), PostPos.X.data(), TweenPos.X.data(), count, alpha);
+    TweenAxis(PrePos.Y.data(), PostPos.Y.data(), TweenPos.Y.data(), count, alpha);
+    TweenAxis(PrePos.Z.data(), PostPos.Z.data(), TweenPos.Z.data(), count, alpha);
+
+    for (size_t i = 0; i < count; ++i)
     {
         auto* ent = Entities[i];
         if (ent == nullptr)
             continue;
 
-        auto& posA = PrePos[i];
-        auto& posB = PostPos[i];
-
-        if (posA == posB)
+        if (PrePos.Get(i) == PostPos.Get(i))
             continue;
 
-        EntitySetCoordinates(
-            { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
-              static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
-              static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) },
-            ent);
-        ent->Invalidate();
+        SetTweenedCoordinates(ent, TweenPos.Get(i));
     }
 }
 
@@ -102,16 +159,16 @@ void EntityTweener::Restore()
         if (ent == nullptr)
             continue;
 
-        EntitySetCoordinates(PostPos[i], ent);
-        ent->Invalidate();
+        SetTweenedCoordinates(ent, PostPos.Get(i));
     }
 }
 
 void EntityTweener::Reset()
 {
     Entities.clear();
-    PrePos.clear();
-    PostPos.clear();
+    PrePos.Clear();
+    PostPos.Clear();
+    TweenPos.Clear();
 }
 
 static EntityTweener tweener;
@@ -15,12 +15,29 @@
 
 class EntityTweener
 {
+    /**
+     * Positions of the tweened entities, one array per axis so the interpolation runs over plain arrays of integers.
+     */
+    struct PositionArrays
+    {
+        std::vector<int32_t> X;
+        std::vector<int32_t> Y;
+        std::vector<int32_t> Z;
+
+        void Push(const CoordsXYZ& pos);
+        CoordsXYZ Get(size_t index) const;
+        void Resize(size_t size);
+        void Clear();
+    };
+
     std::vector<EntityBase*> Entities;
-    std::vector<CoordsXYZ> PrePos;
-    std::vector<CoordsXYZ> PostPos;
+    PositionArrays PrePos;
+    PositionArrays PostPos;
+    PositionArrays TweenPos;
 
 private:
     void PopulateEntities();
+    static void SetTweenedCoordinates(EntityBase* ent, const CoordsXYZ& pos);
 
 public:
     static EntityTweener& Get();
@@ -16,6 +16,7 @@
 #include "../config/Config.h"
 #include "../core/DataSerialiser.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.h"
 #include "../core/Numerics.hpp"
 #include "../entity/Balloon.h"
 #include "../entity/EntityRegistry.h"
@@ -432,7 +433,7 @@ static void peep_update_ride_nausea_growth(Guest* peep, Ride* ride);
 static bool peep_should_go_on_ride_again(Guest* peep, Ride* ride);
 static bool peep_should_preferred_intensity_increase(Guest* peep);
 static bool peep_really_liked_ride(Guest* peep, Ride* ride);
-static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z);
+static PeepThoughtType peep_assess_surroundings(const Guest* peep);
 static void peep_update_hunger(Guest* peep);
 static void peep_decide_whether_to_leave_park(Guest* peep);
 static void peep_leave_park(Guest* peep);
@@ -958,7 +959,7 @@ void Guest::Tick128UpdateGuest(int32_t index)
                 SurroundingsThoughtTimeout = 0;
                 if (x != LOCATION_NULL)
                 {
-                    PeepThoughtType thought_type = peep_assess_surroundings(x & 0xFFE0, y & 0xFFE0, z);
+                    PeepThoughtType thought_type = peep_assess_surroundings(this);
 
                     if (thought_type != PeepThoughtType::None)
                     {
@@ -1746,7 +1747,7 @@ void Guest::OnExitRide(Ride* ride)
     if (PeepFlags & PEEP_FLAGS_RIDE_SHOULD_BE_MARKED_AS_FAVOURITE)
     {
         PeepFlags &= ~PEEP_FLAGS_RIDE_SHOULD_BE_MARKED_AS_FAVOURITE;
-        FavouriteRide = ride->id;
+        SetFavouriteRide(ride->id);
         // TODO fix this flag name or add another one
         WindowInvalidateFlags |= PEEP_INVALIDATE_STAFF_STATS;
     }
@@ -1830,24 +1831,231 @@ void Guest::PickRideToGoOn()
     }
 }
 
+/**
+ * Rides guests pick their next ride from. Neither the set of rides nor their ratings change while the peep update pass is
+ * running, so the lists are only collected once per pass instead of walking every ride slot for each guest.
+ * Both lists are in ascending ride order, which is the order rides have always been considered in.
+ */
+static struct
+{
+    bool Active = false;
+    std::vector<ride_id_t> Rides;
+    std::vector<ride_id_t> TallRides;
+} _guestRideCandidates;
+
+static void guest_ride_candidates_collect()
+{
+    _guestRideCandidates.Rides.clear();
+    _guestRideCandidates.TallRides.clear();
+    for (auto& ride : GetRideManager())
+    {
+        _guestRideCandidates.Rides.push_back(ride.id);
+        // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
+        if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+        {
+            _guestRideCandidates.TallRides.push_back(ride.id);
+        }
+    }
+}
+
+void GuestRideCandidatesBegin()
+{
+    guest_ride_candidates_collect();
+    _guestRideCandidates.Active = true;
+}
+
+void GuestRideCandidatesEnd()
+{
+    _guestRideCandidates.Active = false;
+    _guestRideCandidates.Rides.clear();
+    _guestRideCandidates.TallRides.clear();
+}
+
+namespace
+{
+    /**
+     * Counts of the map features around a guest that decide what they think of their surroundings.
+     */
+    struct SurroundingsAssessment
+    {
+        // The guest is below the surface or an addition is missing its entry, they have no opinion.
+        bool NoThought{};
+        uint16_t NumScenery{};
+        uint16_t NumFountains{};
+        uint16_t NearbyMusic{};
+        uint16_t NumBrokenAdditions{};
+    };
+
+    struct GuestTickPlan
+    {
+        uint16_t SpriteIndex{};
+        CoordsXYZ Loc;
+        bool HasSurroundings{};
+        SurroundingsAssessment Surroundings;
+        bool HasNearbyRides{};
+        std::vector<ride_id_t> NearbyRides;
+    };
+} // namespace
+
+static SurroundingsAssessment peep_assess_surrounding_tiles(int16_t centre_x, int16_t centre_y, int16_t centre_z);
+static void guest_find_nearby_rides(const CoordsXY& loc, BitSet<MAX_RIDES>& seen, std::vector<ride_id_t>& rides);
+
+/**
+ * Map scans of the guests doing their 128 tick update, planned on the job pool before the peep update loop. Guests do
+ * not change the map while updating apart from vandalising path additions, so a plan stays valid as long as the guest
+ * has not moved since and no addition near it has been broken. Everything with side effects still runs in the loop.
+ */
+static struct
+{
+    bool Active = false;
+    size_t Count = 0;
+    size_t Cursor = 0;
+    std::vector<GuestTickPlan> Plans;
+    std::vector<CoordsXY> VandalisedTiles;
+} _guestTickPlans;
+
+static std::unique_ptr<JobPool> _guestTickPlanJobs;
+
+static constexpr size_t GuestTickPlansPerTask = 16;
+
+static bool guest_tick_plan_needs_nearby_rides(Guest* peep)
+{
+    // Same conditions as PickRideToGoOn, guests with a map do not look at the rides around them.
+    return peep->State == PeepState::Walking && peep->GuestHeadingToRideId == RIDE_ID_NULL
+        && !(peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && !peep->HasFoodOrDrink() && !peep->HasItem(ShopItem::Map);
+}
+
+static void guest_tick_plan_run(GuestTickPlan& plan)
+{
+    if (plan.HasSurroundings)
+    {
+        plan.Surroundings = peep_assess_surrounding_tiles(plan.Loc.x & 0xFFE0, plan.Loc.y & 0xFFE0, plan.Loc.z);
+    }
+    plan.NearbyRides.clear();
+    if (plan.HasNearbyRides)
+    {
+        BitSet<MAX_RIDES> seen;
+        guest_find_nearby_rides(plan.Loc, seen, plan.NearbyRides);
+    }
+}
+
+void GuestTickPlansBegin()
+{
+    auto& plans = _guestTickPlans;
+    plans.Count = 0;
+    plans.Cursor = 0;
+    plans.VandalisedTiles.clear();
+    if (!gConfigGeneral.parallel_peep_updates)
+    {
+        _guestTickPlanJobs.reset();
+        return;
+    }
+
+    // Walk the guests the same way as peep_update_all to find the ones doing their 128 tick update.
+    int32_t i = 0;
+    for (auto* peep : EntityList<Guest>())
+    {
+        const auto index = i++;
+        if (static_cast<uint32_t>(index & 0x7F) != (gCurrentTicks & 0x7F) || peep->x == LOCATION_NULL)
+            continue;
+
+        bool hasSurroundings = static_cast<uint32_t>(index & 0x1FF) == (gCurrentTicks & 0x1FF)
+            && (peep->State == PeepState::Walking || peep->State == PeepState::Sitting)
+            && peep->SurroundingsThoughtTimeout >= 17;
+        bool hasNearbyRides = guest_tick_plan_needs_nearby_rides(peep);
+        if (!hasSurroundings && !hasNearbyRides)
+            continue;
+
+        if (plans.Count == plans.Plans.size())
+        {
+            plans.Plans.emplace_back();
+        }
+        auto& plan = plans.Plans[plans.Count++];
+        plan.SpriteIndex = peep->sprite_index;
+        plan.Loc = peep->GetLocation();
+        plan.HasSurroundings = hasSurroundings;
+        plan.HasNearbyRides = hasNearbyRides;
+    }
+
+    if (plans.Count == 0)
+        return;
+
+    if (_guestTickPlanJobs == nullptr)
+    {
+        _guestTickPlanJobs = std::make_unique<JobPool>(255, "Guest plan");
+    }
+    for (size_t begin = 0; begin < plans.Count; begin += GuestTickPlansPerTask)
+    {
+        auto end = std::min(begin + GuestTickPlansPerTask, plans.Count);
+        _guestTickPlanJobs->AddTask([begin, end]() {
+            for (size_t n = begin; n < end; n++)
+            {
+                guest_tick_plan_run(_guestTickPlans.Plans[n]);
+            }
+        });
+    }
+    _guestTickPlanJobs->Join();
+    plans.Active = true;
+}
+
+void GuestTickPlansEnd()
+{
+    _guestTickPlans.Active = false;
+    _guestTickPlans.Count = 0;
+    _guestTickPlans.Cursor = 0;
+    _guestTickPlans.VandalisedTiles.clear();
+}
+
+/**
+ * Finds the plan of the guest, guests are updated in the order they were planned in so the search continues from the
+ * last plan found. Returns nullptr if there is no plan or the guest has moved since it was made.
+ */
+static const GuestTickPlan* guest_get_tick_plan(const Guest* peep)
+{
+    auto& plans = _guestTickPlans;
+    if (!plans.Active)
+        return nullptr;
+
+    for (size_t i = plans.Cursor; i < plans.Count; i++)
+    {
+        const auto& plan = plans.Plans[i];
+        if (plan.SpriteIndex == peep->sprite_index)
+        {
+            plans.Cursor = i;
+            return plan.Loc == peep->GetLocation() ? &plan : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+static void guest_tick_plans_mark_vandalised(const CoordsXY& loc)
+{
+    if (_guestTickPlans.Active)
+    {
+        _guestTickPlans.VandalisedTiles.push_back(loc);
+    }
+}
+
 Ride* Guest::FindBestRideToGoOn()
 {
+    static std::vector<ride_id_t> rideConsideration;
+    FindRidesToGoOn(rideConsideration);
+
     // Pick the most exciting ride
-    auto rideConsideration = FindRidesToGoOn();
     Ride* mostExcitingRide = nullptr;
-    for (auto& ride : GetRideManager())
+    for (auto rideIndex : rideConsideration)
     {
-        const auto rideIndex = EnumValue(ride.id);
-        if (rideConsideration.size() > rideIndex && rideConsideration[rideIndex])
+        auto* ride = get_ride(rideIndex);
+        if (ride == nullptr)
+            continue;
+
+        if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL))
         {
-            if (!(ride.lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL))
+            if (ShouldGoOnRide(ride, 0, false, true) && ride_has_ratings(ride))
             {
-                if (ShouldGoOnRide(&ride, 0, false, true) && ride_has_ratings(&ride))
+                if (mostExcitingRide == nullptr || ride->excitement > mostExcitingRide->excitement)
                 {
-                    if (mostExcitingRide == nullptr || ride.excitement > mostExcitingRide->excitement)
-                    {
-                        mostExcitingRide = &ride;
-                    }
+                    mostExcitingRide = ride;
                 }
             }
         }
@@ -1855,9 +2063,45 @@ Ride* Guest::FindBestRideToGoOn()
     return mostExcitingRide;
 }
 
-BitSet<MAX_RIDES> Guest::FindRidesToGoOn()
+/**
+ * Adds the rides with track within 10 tiles of the location that are not in seen yet.
+ */
+static void guest_find_nearby_rides(const CoordsXY& loc, BitSet<MAX_RIDES>& seen, std::vector<ride_id_t>& rides)
 {
-    BitSet<MAX_RIDES> rideConsideration;
+    constexpr auto radius = 10 * 32;
+    int32_t cx = floor2(loc.x, 32);
+    int32_t cy = floor2(loc.y, 32);
+    for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
+    {
+        for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
+        {
+            auto location = CoordsXY{ tileX, tileY };
+            if (!map_is_location_valid(location))
+                continue;
+
+            for (auto* trackElement : TileElementsView<TrackElement>(location))
+            {
+                auto rideIndex = trackElement->GetRideIndex();
+                if (rideIndex != RIDE_ID_NULL && !seen[EnumValue(rideIndex)])
+                {
+                    seen[EnumValue(rideIndex)] = true;
+                    rides.push_back(rideIndex);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Collects the rides the guest may consider going on in ascending ride order.
+ */
+void Guest::FindRidesToGoOn(std::vector<ride_id_t>& rides)
+{
+    rides.clear();
+    if (!_guestRideCandidates.Active)
+    {
+        guest_ride_candidates_collect();
+    }
 
     // FIX  Originally checked for a toy, likely a mistake and should be a map,
     //      but then again this seems to only allow the peep to go on
@@ -1865,50 +2109,44 @@ BitSet<MAX_RIDES> Guest::FindRidesToGoOn()
     if (HasItem(ShopItem::Map))
     {
         // Consider rides that peep hasn't been on yet
-        for (auto& ride : GetRideManager())
+        for (auto rideIndex : _guestRideCandidates.Rides)
         {
-            if (!HasRidden(&ride))
+            auto* ride = get_ride(rideIndex);
+            if (ride != nullptr && !HasRidden(ride))
             {
-                rideConsideration[EnumValue(ride.id)] = true;
+                rides.push_back(rideIndex);
             }
         }
     }
     else
     {
+        BitSet<MAX_RIDES> rideConsideration;
+
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
+        const auto* plan = guest_get_tick_plan(this);
+        if (plan != nullptr && plan->HasNearbyRides)
         {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
+            for (auto rideIndex : plan->NearbyRides)
             {
-                auto location = CoordsXY{ tileX, tileY };
-                if (!map_is_location_valid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    if (rideIndex != RIDE_ID_NULL)
-                    {
-                        rideConsideration[EnumValue(rideIndex)] = true;
-                    }
-                }
+                rideConsideration[EnumValue(rideIndex)] = true;
+                rides.push_back(rideIndex);
             }
         }
+        else
+        {
+            guest_find_nearby_rides({ x, y }, rideConsideration, rides);
+        }
 
-        // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
-        for (auto& ride : GetRideManager())
+        for (auto rideIndex : _guestRideCandidates.TallRides)
         {
-            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+            if (!rideConsideration[EnumValue(rideIndex)])
             {
-                rideConsideration[EnumValue(ride.id)] = true;
+                rideConsideration[EnumValue(rideIndex)] = true;
+                rides.push_back(rideIndex);
             }
         }
+        std::sort(rides.begin(), rides.end());
     }
-
-    return rideConsideration;
 }
 
 /**
@@ -2314,6 +2552,28 @@ void Guest::SpendMoney(money16& peep_expend_type, money32 amount, ExpenditureTyp
     OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::Purchase, GetLocation());
 }
 
+void Guest::SetFavouriteRide(ride_id_t rideId)
+{
+    if (FavouriteRide == rideId)
+        return;
+
+    auto* oldRide = get_ride(FavouriteRide);
+    if (oldRide != nullptr && oldRide->guests_favourite > 0)
+    {
+        oldRide->guests_favourite--;
+        oldRide->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
+    }
+
+    FavouriteRide = rideId;
+
+    auto* newRide = get_ride(FavouriteRide);
+    if (newRide != nullptr)
+    {
+        newRide->guests_favourite++;
+        newRide->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_CUSTOMER;
+    }
+}
+
 void Guest::SetHasRidden(const Ride* ride)
 {
     OpenRCT2::RideUse::GetHistory().Add(sprite_index, ride->id);
@@ -2882,15 +3142,14 @@ static bool peep_really_liked_ride(Guest* peep, Ride* ride)
  *
  *  rct2: 0x0069BC9A
  */
-static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z)
+static SurroundingsAssessment peep_assess_surrounding_tiles(int16_t centre_x, int16_t centre_y, int16_t centre_z)
 {
+    SurroundingsAssessment result;
     if ((tile_element_height({ centre_x, centre_y })) > centre_z)
-        return PeepThoughtType::None;
-
-    uint16_t num_scenery = 0;
-    uint16_t num_fountains = 0;
-    uint16_t nearby_music = 0;
-    uint16_t num_rubbish = 0;
+    {
+        result.NoThought = true;
+        return result;
+    }
 
     int16_t initial_x = std::max(centre_x - 160, 0);
     int16_t initial_y = std::max(centre_y - 160, 0);
@@ -2915,25 +3174,26 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
                         auto* pathAddEntry = tileElement->AsPath()->GetAdditionEntry();
                         if (pathAddEntry == nullptr)
                         {
-                            return PeepThoughtType::None;
+                            result.NoThought = true;
+                            return result;
                         }
                         if (tileElement->AsPath()->AdditionIsGhost())
                             break;
 
                         if (pathAddEntry->flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
                         {
-                            num_fountains++;
+                            result.NumFountains++;
                             break;
                         }
                         if (tileElement->AsPath()->IsBroken())
                         {
-                            num_rubbish++;
+                            result.NumBrokenAdditions++;
                         }
                         break;
                     }
                     case TileElementType::LargeScenery:
                     case TileElementType::SmallScenery:
-                        num_scenery++;
+                        result.NumScenery++;
                         break;
                     case TileElementType::Track:
                         ride = get_ride(tileElement->AsTrack()->GetRideIndex());
@@ -2944,20 +3204,20 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
                             {
                                 if (ride->type == RIDE_TYPE_MERRY_GO_ROUND)
                                 {
-                                    nearby_music |= 1;
+                                    result.NearbyMusic |= 1;
                                     break;
                                 }
 
                                 if (ride->music == MUSIC_STYLE_ORGAN)
                                 {
-                                    nearby_music |= 1;
+                                    result.NearbyMusic |= 1;
                                     break;
                                 }
 
                                 if (ride->type == RIDE_TYPE_DODGEMS)
                                 {
                                     // Dodgems drown out music?
-                                    nearby_music |= 2;
+                                    result.NearbyMusic |= 2;
                                 }
                             }
                         }
@@ -2968,9 +3228,83 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
             }
         }
     }
+    return result;
+}
+
+/**
+ * Whether a path addition broken during the current peep update pass lies within the surroundings of the location.
+ */
+static bool guest_tick_plans_vandalised_near(int16_t centre_x, int16_t centre_y)
+{
+    for (const auto& loc : _guestTickPlans.VandalisedTiles)
+    {
+        if (loc.x >= centre_x - 160 && loc.x < centre_x + 160 && loc.y >= centre_y - 160 && loc.y < centre_y + 160)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+GuestStatistics GuestStatistics::Collect()
+{
+    GuestStatistics result;
+    for (auto peep : EntityList<Guest>())
+    {
+        if (peep->OutsideOfPark)
+            continue;
+
+        result.GuestsInPark++;
+        if (peep->Happiness > 128)
+        {
+            result.HappyGuests++;
+        }
+        if ((peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && (peep->GuestIsLostCountdown < 90))
+        {
+            result.LostGuests++;
+        }
+
+        const auto& thought = std::get<0>(peep->Thoughts);
+        if (thought.freshness <= 5)
+        {
+            result.FreshThoughts[EnumValue(thought.type)]++;
+        }
+    }
+    return result;
+}
+
+/**
+ *
+ *  rct2: 0x0069BC9A
+ */
+static PeepThoughtType peep_assess_surroundings(const Guest* peep)
+{
+    int16_t centre_x = peep->x & 0xFFE0;
+    int16_t centre_y = peep->y & 0xFFE0;
+
+    SurroundingsAssessment tiles;
+    const auto* plan = guest_get_tick_plan(peep);
+    if (plan != nullptr && plan->HasSurroundings && !guest_tick_plans_vandalised_near(centre_x, centre_y))
+    {
+        tiles = plan->Surroundings;
+    }
+    else
+    {
+        tiles = peep_assess_surrounding_tiles(centre_x, centre_y, peep->z);
+    }
+    if (tiles.NoThought)
+        return PeepThoughtType::None;
 
-    for (auto litter : EntityList<Litter>())
+    // Litter is dropped by the guests while updating so it is always counted here.
+    uint16_t num_rubbish = tiles.NumBrokenAdditions;
+    static std::vector<uint16_t> entities;
+    GetEntitiesInRange({ centre_x - 160, centre_y - 160, centre_x + 160, centre_y + 160 }, entities);
+    for (auto entityIndex : entities)
     {
+        auto* litter = GetEntity<Litter>(entityIndex);
+        if (litter == nullptr)
+            continue;
+
         int16_t dist_x = abs(litter->x - centre_x);
         int16_t dist_y = abs(litter->y - centre_y);
         if (std::max(dist_x, dist_y) <= 160)
@@ -2979,13 +3313,13 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
         }
     }
 
-    if (num_fountains >= 5 && num_rubbish < 20)
+    if (tiles.NumFountains >= 5 && num_rubbish < 20)
         return PeepThoughtType::Fountains;
 
-    if (num_scenery >= 40 && num_rubbish < 8)
+    if (tiles.NumScenery >= 40 && num_rubbish < 8)
         return PeepThoughtType::Scenery;
 
-    if (nearby_music == 1 && num_rubbish < 20)
+    if (tiles.NearbyMusic == 1 && num_rubbish < 20)
         return PeepThoughtType::Music;
 
     if (num_rubbish < 2 && !gCheatsDisableLittering)
@@ -5599,6 +5933,7 @@ void Guest::UpdateEnteringPark()
     decrement_guests_heading_for_park();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     context_broadcast_intent(&intent);
+    NotifyGuestList();
 }
 
 /**
@@ -5628,6 +5963,7 @@ void Guest::UpdateLeavingPark()
     decrement_guests_in_park();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     context_broadcast_intent(&intent);
+    NotifyGuestList();
     Var37 = 1;
 
     window_invalidate_by_class(WC_GUEST_LIST);
@@ -6113,25 +6449,31 @@ static void peep_update_walking_break_scenery(Guest* peep)
         return;
     }
 
-    for (auto inner_peep : EntityList<Staff>())
-    {
-        if (inner_peep->AssignedStaffType != StaffType::Security)
-            continue;
+    // The security guard with the lowest index nearby stops the vandal.
+    Staff* securityGuard = nullptr;
+    ForEachEntityInRadius<Staff>({ peep->x, peep->y }, 224, [peep, &securityGuard](Staff* inner_peep) {
+        if (securityGuard != nullptr || inner_peep->AssignedStaffType != StaffType::Security)
+            return;
 
         if (inner_peep->x == LOCATION_NULL)
-            continue;
+            return;
 
         int32_t x_diff = abs(inner_peep->x - peep->x);
         int32_t y_diff = abs(inner_peep->y - peep->y);
 
         if (std::max(x_diff, y_diff) < 224)
         {
-            inner_peep->StaffVandalsStopped++;
-            return;
+            securityGuard = inner_peep;
         }
+    });
+    if (securityGuard != nullptr)
+    {
+        securityGuard->StaffVandalsStopped++;
+        return;
     }
 
     tileElement->SetIsBroken(true);
+    guest_tick_plans_mark_vandalised(peep->NextLoc);
 
     map_invalidate_tile_zoom1({ peep->NextLoc, tileElement->GetBaseZ(), tileElement->GetBaseZ() + 32 });
 
@@ -6844,27 +7186,29 @@ void Guest::InsertNewThought(PeepThoughtType thoughtType, uint16_t thoughtArgume
         UpdateCurrentActionSpriteType();
     }
 
-    for (int32_t i = 0; i < PEEP_MAX_THOUGHTS; ++i)
+    // Number of thoughts to move down to make room at the top, by default the oldest thought drops off the end.
+    size_t numShifted = PEEP_MAX_THOUGHTS - 1;
+    for (size_t i = 0; i < PEEP_MAX_THOUGHTS; ++i)
     {
-        PeepThought* thought = &Thoughts[i];
-        // Remove the oldest thought by setting it to NONE.
-        if (thought->type == PeepThoughtType::None)
+        const auto& thought = Thoughts[i];
+        if (thought.type == PeepThoughtType::None)
             break;
 
-        if (thought->type == thoughtType && thought->item == thoughtArguments)
+        if (thought.type == thoughtType && thought.item == thoughtArguments)
         {
             // If the thought type has not changed then we need to move
-            // it to the top of the thought list. This is done by first removing the
-            // existing thought and placing it at the top.
+            // it to the top of the thought list. This is done by only moving
+            // the newer thoughts down, overwriting the existing thought.
+            // Thoughts in the last two slots are not moved, as in vanilla.
             if (i < PEEP_MAX_THOUGHTS - 2)
             {
-                memmove(thought, thought + 1, sizeof(PeepThought) * (PEEP_MAX_THOUGHTS - i - 1));
+                numShifted = i;
             }
             break;
         }
     }
 
-    memmove(&std::get<1>(Thoughts), &std::get<0>(Thoughts), sizeof(PeepThought) * (PEEP_MAX_THOUGHTS - 1));
+    memmove(&std::get<1>(Thoughts), &std::get<0>(Thoughts), sizeof(PeepThought) * numShifted);
 
     auto& thought = std::get<0>(Thoughts);
     thought.type = thoughtType;
@@ -6873,6 +7217,21 @@ void Guest::InsertNewThought(PeepThoughtType thoughtType, uint16_t thoughtArgume
     thought.fresh_timeout = 0;
 
     WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+    NotifyGuestList();
+}
+
+/**
+ * Notifies the guest list that this guest entered or left the park or had a new thought.
+ */
+void Guest::NotifyGuestList()
+{
+    // Guests think many times a second, do not build an intent nobody is listening for.
+    if (window_find_by_class(WC_GUEST_LIST) == nullptr)
+        return;
+
+    auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY);
+    intent.putExtra(INTENT_EXTRA_PEEP, this);
+    context_broadcast_intent(&intent);
 }
 
 // clang-format off
@@ -7325,34 +7684,7 @@ void Guest::RemoveFromQueue()
     if (ride == nullptr)
         return;
 
-    auto& station = ride->stations[CurrentRideStation];
-    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
-    // not yet left the queue.
-    if (station.QueueLength > 0)
-    {
-        station.QueueLength--;
-    }
-
-    if (sprite_index == station.LastPeepInQueue)
-    {
-        station.LastPeepInQueue = GuestNextInQueue;
-        return;
-    }
-
-    auto* otherGuest = GetEntity<Guest>(station.LastPeepInQueue);
-    if (otherGuest == nullptr)
-    {
-        log_error("Invalid Guest Queue list!");
-        return;
-    }
-    for (; otherGuest != nullptr; otherGuest = GetEntity<Guest>(otherGuest->GuestNextInQueue))
-    {
-        if (sprite_index == otherGuest->GuestNextInQueue)
-        {
-            otherGuest->GuestNextInQueue = GuestNextInQueue;
-            return;
-        }
-    }
+    ride->QueueRemoveGuest(CurrentRideStation, this);
 }
 
 uint64_t Guest::GetItemFlags() const
@@ -7459,7 +7791,7 @@ void Guest::RemoveRideFromMemory(ride_id_t rideId)
     }
     if (FavouriteRide == rideId)
     {
-        FavouriteRide = RIDE_ID_NULL;
+        SetFavouriteRide(RIDE_ID_NULL);
     }
 
     // Erase all thoughts that contain the ride.
@@ -262,6 +262,8 @@ struct Guest : Peep
 public:
     uint8_t GuestNumRides;
     uint16_t GuestNextInQueue;
+    // The guest behind in the queue, derived from GuestNextInQueue and not saved.
+    uint16_t GuestPrevInQueue;
     int32_t ParkEntryTime;
     ride_id_t GuestHeadingToRideId;
     uint8_t GuestIsLostCountdown;
@@ -343,6 +345,8 @@ public:
     void SpendMoney(money16& peep_expend_type, money32 amount, ExpenditureType type);
     void SpendMoney(money32 amount, ExpenditureType type);
     void SetHasRidden(const Ride* ride);
+    // Keeps the guests_favourite count of the old and new favourite ride up to date.
+    void SetFavouriteRide(ride_id_t rideId);
     bool HasRidden(const Ride* ride) const;
     void SetHasRiddenRideType(int32_t rideType);
     bool HasRiddenRideType(int32_t rideType) const;
@@ -377,6 +381,7 @@ public:
     void RemoveRideFromMemory(ride_id_t rideId);
 
 private:
+    void NotifyGuestList();
     void UpdateRide();
     void UpdateOnRide(){}; // TODO
     void UpdateWalking();
@@ -418,13 +423,33 @@ private:
     void MakePassingPeepsSick(Guest* passingPeep);
     void GivePassingPeepsIceCream(Guest* passingPeep);
     Ride* FindBestRideToGoOn();
-    OpenRCT2::BitSet<MAX_RIDES> FindRidesToGoOn();
+    void FindRidesToGoOn(std::vector<ride_id_t>& rides);
     bool FindVehicleToEnter(Ride* ride, std::vector<uint8_t>& car_array);
     void GoToRideEntrance(Ride* ride);
 };
 
 static_assert(sizeof(Guest) <= 512);
 
+/**
+ * Guest counts used by the park rating and the awards, collected in a single pass over the guests so each consumer
+ * does not have to walk all of them again.
+ */
+struct GuestStatistics
+{
+    uint32_t GuestsInPark{};
+    uint32_t HappyGuests{};
+    uint32_t LostGuests{};
+    // Guests in the park by the type of their most recent thought, counting only thoughts that are still fresh.
+    std::array<uint32_t, 256> FreshThoughts{};
+
+    static GuestStatistics Collect();
+
+    uint32_t GetFreshThoughtCount(PeepThoughtType type) const
+    {
+        return FreshThoughts[EnumValue(type)];
+    }
+};
+
 enum
 {
     EASTEREGG_PEEP_NAME_MICHAEL_SCHUMACHER,
@@ -473,3 +498,13 @@ void increment_guests_in_park();
 void increment_guests_heading_for_park();
 void decrement_guests_in_park();
 void decrement_guests_heading_for_park();
+
+// Collects the rides guests pick from once between the two calls instead of for every guest. Only use this around code
+// that does not create, remove or rate rides, such as the peep update loop.
+void GuestRideCandidatesBegin();
+void GuestRideCandidatesEnd();
+
+// Plans the map scans of the guests doing their 128 tick update on the job pool before the peep update loop, the results
+// are used by the loop in place of scanning the map again.
+void GuestTickPlansBegin();
+void GuestTickPlansEnd();
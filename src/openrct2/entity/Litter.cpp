@@ -94,7 +94,9 @@ void Litter::Create(const CoordsXYZD& litterPos, Type type)
  */
 void Litter::RemoveAt(const CoordsXYZ& litterPos)
 {
-    std::vector<Litter*> removals;
+    // Handymen sweep every few ticks, reuse the storage instead of allocating for each sweep.
+    static std::vector<Litter*> removals;
+    removals.clear();
     for (auto litter : EntityTileList<Litter>(litterPos))
     {
         if (abs(litter->z - litterPos.z) <= 16)
@@ -79,10 +79,11 @@ void VehicleCrashParticle::Create(rct_vehicle_colour colours, const CoordsXYZ& v
  */
 void VehicleCrashParticle::Update()
 {
-    Invalidate();
+    // MoveTo invalidates both the old and the new position, only removals need an explicit invalidation.
     time_to_live--;
     if (time_to_live == 0)
     {
+        Invalidate();
         EntityRemove(this);
         return;
     }
@@ -115,6 +116,7 @@ void VehicleCrashParticle::Update()
         // Splash
         OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::Water2, { x, y, waterZ });
         CrashSplashParticle::Create({ x, y, waterZ });
+        Invalidate();
         EntityRemove(this);
         return;
     }
@@ -235,13 +237,16 @@ void SteamParticle::Create(const CoordsXYZ& coords)
 void SteamParticle::Update()
 {
     // Move up 1 z every 3 ticks (Starts after 4 ticks)
-    Invalidate();
     time_to_move++;
     if (time_to_move >= 4)
     {
         time_to_move = 1;
         MoveTo({ x, y, z + 1 });
     }
+    else
+    {
+        Invalidate();
+    }
     frame += 64;
     if (frame >= (56 * 64))
     {
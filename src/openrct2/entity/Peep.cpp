@@ -19,6 +19,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/Profiler.h"
 #include "../drawing/LightFX.h"
 #include "../entity/Balloon.h"
 #include "../entity/EntityRegistry.h"
@@ -197,13 +198,20 @@ int32_t peep_get_staff_count()
  */
 void peep_update_all()
 {
+    PROFILE_ZONE(PeepUpdate);
+
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    PathfindJunctionCacheBegin();
+    GuestRideCandidatesBegin();
+    GuestTickPlansBegin();
+
     int32_t i = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
     {
+        EntityChecksumInvalidate(peep);
         if (static_cast<uint32_t>(i & 0x7F) != (gCurrentTicks & 0x7F))
         {
             peep->Update();
@@ -223,6 +231,7 @@ void peep_update_all()
 
     for (auto staff : EntityList<Staff>())
     {
+        EntityChecksumInvalidate(staff);
         if (static_cast<uint32_t>(i & 0x7F) != (gCurrentTicks & 0x7F))
         {
             staff->Update();
@@ -239,6 +248,13 @@ void peep_update_all()
 
         i++;
     }
+
+    GuestTickPlansEnd();
+    GuestRideCandidatesEnd();
+    PathfindJunctionCacheEnd();
+
+    // Staff have moved, the rides calling mechanics later in the tick need the new positions.
+    StaffIndex::Invalidate();
 }
 
 /**
@@ -328,7 +344,7 @@ PeepActionSpriteType Peep::GetActionSpriteType()
  */
 void Peep::UpdateCurrentActionSpriteType()
 {
-    if (EnumValue(SpriteType) >= std::size(g_peep_animation_entries))
+    if (EnumValue(SpriteType) >= g_peep_animations.size())
     {
         return;
     }
@@ -435,28 +451,27 @@ std::optional<CoordsXY> Peep::UpdateAction(int16_t& xy_distance)
         CoordsXY loc = { x, y };
         loc += word_981D7C[nextDirection / 8];
         WalkingFrameNum++;
-        const rct_peep_animation* peepAnimation = &GetPeepAnimation(SpriteType);
-        const uint8_t* imageOffset = peepAnimation[EnumValue(ActionSpriteType)].frame_offsets;
-        if (WalkingFrameNum >= peepAnimation[EnumValue(ActionSpriteType)].num_frames)
+        const rct_peep_animation& peepAnimation = GetPeepAnimation(SpriteType, ActionSpriteType);
+        if (WalkingFrameNum >= peepAnimation.num_frames)
         {
             WalkingFrameNum = 0;
         }
-        ActionSpriteImageOffset = imageOffset[WalkingFrameNum];
+        ActionSpriteImageOffset = peepAnimation.GetFrameOffset(WalkingFrameNum);
         return loc;
     }
 
-    const rct_peep_animation* peepAnimation = &GetPeepAnimation(SpriteType);
+    const rct_peep_animation& peepAnimation = GetPeepAnimation(SpriteType, ActionSpriteType);
     ActionFrame++;
 
     // If last frame of action
-    if (ActionFrame >= peepAnimation[EnumValue(ActionSpriteType)].num_frames)
+    if (ActionFrame >= peepAnimation.num_frames)
     {
         ActionSpriteImageOffset = 0;
         Action = PeepActionType::Walking;
         UpdateCurrentActionSpriteType();
         return { { x, y } };
     }
-    ActionSpriteImageOffset = peepAnimation[EnumValue(ActionSpriteType)].frame_offsets[ActionFrame];
+    ActionSpriteImageOffset = peepAnimation.GetFrameOffset(ActionFrame);
 
     auto* guest = As<Guest>();
     // If not throwing up and not at the frame where sick appears.
@@ -640,6 +655,7 @@ void peep_sprite_remove(Peep* peep)
     if (guest != nullptr)
     {
         guest->RemoveFromRide();
+        guest->SetFavouriteRide(RIDE_ID_NULL);
     }
     peep->Invalidate();
 
@@ -661,10 +677,21 @@ void peep_sprite_remove(Peep* peep)
 
         News::DisableNewsItems(News::ItemType::Peep, staff->sprite_index);
     }
+
+    if (wasGuest && window_find_by_class(WC_GUEST_LIST) != nullptr)
+    {
+        // Lets the guest list drop the entry without rebuilding the whole list
+        auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY);
+        intent.putExtra(INTENT_EXTRA_PEEP, peep);
+        context_broadcast_intent(&intent);
+    }
     EntityRemove(peep);
 
-    auto intent = Intent(wasGuest ? INTENT_ACTION_REFRESH_GUEST_LIST : INTENT_ACTION_REFRESH_STAFF_LIST);
-    context_broadcast_intent(&intent);
+    if (!wasGuest)
+    {
+        auto intent = Intent(INTENT_ACTION_REFRESH_STAFF_LIST);
+        context_broadcast_intent(&intent);
+    }
 }
 
 /**
@@ -1691,10 +1718,7 @@ static bool peep_interact_with_entrance(Peep* peep, const CoordsXYE& coords, uin
         guest->ActionSpriteImageOffset = _unk_F1AEF0;
         guest->InteractionRideIndex = rideIndex;
 
-        uint16_t previous_last = ride->stations[stationNum].LastPeepInQueue;
-        ride->stations[stationNum].LastPeepInQueue = guest->sprite_index;
-        guest->GuestNextInQueue = previous_last;
-        ride->stations[stationNum].QueueLength++;
+        ride->QueueAppendGuest(stationNum, guest);
 
         guest->CurrentRide = rideIndex;
         guest->CurrentRideStation = stationNum;
@@ -2116,10 +2140,7 @@ static void peep_interact_with_path(Peep* peep, const CoordsXYE& coords)
                     guest->InteractionRideIndex = rideIndex;
 
                     // Add the peep to the ride queue.
-                    uint16_t old_last_peep = ride->stations[stationNum].LastPeepInQueue;
-                    ride->stations[stationNum].LastPeepInQueue = guest->sprite_index;
-                    guest->GuestNextInQueue = old_last_peep;
-                    ride->stations[stationNum].QueueLength++;
+                    ride->QueueAppendGuest(stationNum, guest);
 
                     peep_decrement_num_riders(guest);
                     guest->CurrentRide = rideIndex;
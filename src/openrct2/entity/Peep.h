@@ -431,19 +431,26 @@ struct rct_sprite_bounds
     uint8_t sprite_height_positive; // 0x02
 };
 
+// Frame offsets of all the peep animations, each animation uses a range of them.
+extern const uint8_t g_peep_animation_frame_offsets[];
+
 struct rct_peep_animation
 {
-    uint32_t base_image; // 0x00
-    size_t num_frames;
-    const uint8_t* frame_offsets;
-};
+    uint32_t base_image;
+    uint16_t first_frame;
+    uint16_t num_frames;
 
-struct rct_peep_animation_entry
-{
-    const rct_peep_animation* sprite_animation; // 0x00
-    const rct_sprite_bounds* sprite_bounds;     // 0x04
+    uint8_t GetFrameOffset(size_t frame) const
+    {
+        return g_peep_animation_frame_offsets[first_frame + frame];
+    }
 };
 
+constexpr size_t PEEP_ACTION_SPRITE_TYPE_COUNT = EnumValue(PeepActionSpriteType::WithdrawMoney) + 1;
+
+using PeepAnimationTable = std::array<
+    std::array<rct_peep_animation, PEEP_ACTION_SPRITE_TYPE_COUNT>, EnumValue(PeepSpriteType::Count)>;
+
 enum
 {
     PATHING_DESTINATION_REACHED = 1 << 0,
@@ -453,7 +460,8 @@ enum
 };
 
 // rct2: 0x00982708
-extern const rct_peep_animation_entry g_peep_animation_entries[EnumValue(PeepSpriteType::Count)];
+extern const PeepAnimationTable g_peep_animations;
+extern const rct_sprite_bounds* const g_peep_sprite_bounds[EnumValue(PeepSpriteType::Count)];
 extern const bool gSpriteTypeToSlowWalkMap[48];
 
 extern uint8_t gPeepWarningThrottle[16];
@@ -482,11 +490,11 @@ rct_string_id get_real_name_string_id_from_id(uint32_t id);
 inline const rct_peep_animation& GetPeepAnimation(
     PeepSpriteType spriteType, PeepActionSpriteType actionSpriteType = PeepActionSpriteType::None)
 {
-    return g_peep_animation_entries[EnumValue(spriteType)].sprite_animation[EnumValue(actionSpriteType)];
+    return g_peep_animations[EnumValue(spriteType)][EnumValue(actionSpriteType)];
 };
 
 inline const rct_sprite_bounds& GetSpriteBounds(
     PeepSpriteType spriteType, PeepActionSpriteType actionSpriteType = PeepActionSpriteType::None)
 {
-    return g_peep_animation_entries[EnumValue(spriteType)].sprite_bounds[EnumValue(actionSpriteType)];
+    return g_peep_sprite_bounds[EnumValue(spriteType)][EnumValue(actionSpriteType)];
 };
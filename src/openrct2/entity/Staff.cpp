@@ -43,7 +43,10 @@
 #include "Peep.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <limits>
+#include <numeric>
 
 // clang-format off
 const rct_string_id StaffCostumeNames[] = {
@@ -388,28 +391,203 @@ bool Staff::HasPatrolArea() const
     return std::any_of(std::begin(PatrolInfo->Data), std::end(PatrolInfo->Data), hasData);
 }
 
+namespace StaffIndex
+{
+    static constexpr int32_t CellSize = 8 * COORDS_XY_STEP;
+    static constexpr int32_t Columns = (MAXIMUM_MAP_SIZE_TECHNICAL * COORDS_XY_STEP + CellSize - 1) / CellSize;
+
+    struct StaffTypeCells
+    {
+        // The ids in cell i are Ids[CellStarts[i]] to Ids[CellStarts[i + 1]], in sprite index order.
+        std::vector<uint32_t> CellStarts;
+        std::vector<uint16_t> Ids;
+    };
+
+    static bool _valid;
+    static uint32_t _builtTick;
+    // The staff entity list the index was built from, hiring or firing staff changes it.
+    static std::vector<uint16_t> _staffIds;
+    static std::array<StaffTypeCells, EnumValue(StaffType::Count)> _cells;
+
+    static int32_t GetCell(int32_t coord)
+    {
+        return std::clamp(coord / CellSize, 0, Columns - 1);
+    }
+
+    static void Build()
+    {
+        const auto& staffIds = GetEntityList(EntityType::Staff);
+        for (auto& cells : _cells)
+        {
+            cells.CellStarts.assign(Columns * Columns + 1, 0);
+            cells.Ids.clear();
+        }
+
+        // Count the staff in each cell, then place them, going through the staff in order keeps every cell sorted.
+        for (auto pass = 0; pass < 2; pass++)
+        {
+            for (auto id : staffIds)
+            {
+                auto* staff = GetEntity<Staff>(id);
+                if (staff == nullptr || staff->x == LOCATION_NULL || staff->AssignedStaffType >= StaffType::Count)
+                    continue;
+
+                auto& cells = _cells[EnumValue(staff->AssignedStaffType)];
+                const auto cell = GetCell(staff->y) * Columns + GetCell(staff->x);
+                if (pass == 0)
+                {
+                    cells.CellStarts[cell + 1]++;
+                }
+                else
+                {
+                    cells.Ids[cells.CellStarts[cell]++] = id;
+                }
+            }
+
+            for (auto& cells : _cells)
+            {
+                if (pass == 0)
+                {
+                    std::partial_sum(cells.CellStarts.begin(), cells.CellStarts.end(), cells.CellStarts.begin());
+                    cells.Ids.resize(cells.CellStarts.back());
+                }
+                else
+                {
+                    // Placing moved every start to the end of its cell, which is the start of the next one.
+                    std::copy_backward(cells.CellStarts.begin(), cells.CellStarts.end() - 1, cells.CellStarts.end());
+                    cells.CellStarts[0] = 0;
+                }
+            }
+        }
+
+        _staffIds = staffIds;
+        _builtTick = gCurrentTicks;
+        _valid = true;
+    }
+
+    void Invalidate()
+    {
+        _valid = false;
+    }
+
+    Staff* FindClosest(StaffType type, const CoordsXY& pos, const std::function<bool(const Staff&)>& isEligible)
+    {
+        if (type >= StaffType::Count)
+            return nullptr;
+
+        if (!_valid || _builtTick != gCurrentTicks || _staffIds != GetEntityList(EntityType::Staff))
+        {
+            Build();
+        }
+
+        const auto& cells = _cells[EnumValue(type)];
+        const auto cellX = GetCell(pos.x);
+        const auto cellY = GetCell(pos.y);
+        const bool posInGrid = pos.x >= 0 && pos.y >= 0 && pos.x < Columns * CellSize && pos.y < Columns * CellSize;
+
+        Staff* closest = nullptr;
+        uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
+        auto checkCell = [&](int32_t x, int32_t y) {
+            const auto cell = y * Columns + x;
+            for (auto i = cells.CellStarts[cell]; i < cells.CellStarts[cell + 1]; i++)
+            {
+                auto* staff = GetEntity<Staff>(cells.Ids[i]);
+                if (staff == nullptr || staff->x == LOCATION_NULL)
+                    continue;
+
+                const uint32_t distance = std::abs(staff->x - pos.x) + std::abs(staff->y - pos.y);
+                const bool isCloser = distance < closestDistance;
+                const bool isTieWithLowerIndex = distance == closestDistance && closest != nullptr
+                    && staff->sprite_index < closest->sprite_index;
+                if ((isCloser || isTieWithLowerIndex) && isEligible(*staff))
+                {
+                    closest = staff;
+                    closestDistance = distance;
+                }
+            }
+        };
+
+        // Go through the cells in rings around pos, until the rings are too far away to hold anything as close.
+        for (int32_t ring = 0; ring < Columns; ring++)
+        {
+            // Positions in a ring's cells are more than ring - 1 cells away from pos along at least one axis.
+            if (closest != nullptr && posInGrid && ring > 0 && static_cast<uint32_t>((ring - 1) * CellSize) >= closestDistance)
+                break;
+
+            for (auto y = std::max(cellY - ring, 0); y <= std::min(cellY + ring, Columns - 1); y++)
+            {
+                const bool isEdgeRow = y == cellY - ring || y == cellY + ring;
+                for (auto x = std::max(cellX - ring, 0); x <= std::min(cellX + ring, Columns - 1); x++)
+                {
+                    if (isEdgeRow || x == cellX - ring || x == cellX + ring)
+                    {
+                        checkCell(x, y);
+                    }
+                }
+            }
+        }
+        return closest;
+    }
+} // namespace StaffIndex
+
 /**
- *
- *  rct2: 0x006BFBE8
- *
- * Returns INVALID_DIRECTION when no nearby litter or unpathable litter
+ * Finds the litter closest to pos, on a tie the litter with the lowest sprite index wins as it would when scanning the
+ * entity list. Only the tiles that can contain litter within MAX_LITTER_DISTANCE are checked, which gives the same result
+ * for any litter close enough to be used.
  */
-Direction Staff::HandymanDirectionToNearestLitter() const
+static Litter* FindNearestLitter(const CoordsXYZ& pos, uint16_t& nearestLitterDist)
 {
-    uint16_t nearestLitterDist = 0xFFFF;
     Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>())
-    {
-        uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
-
-        if (distance < nearestLitterDist)
+    auto checkLitter = [&](Litter* litter) {
+        uint16_t distance = abs(litter->x - pos.x) + abs(litter->y - pos.y) + abs(litter->z - pos.z) * 4;
+        bool isCloser = distance < nearestLitterDist;
+        bool isTieWithLowerIndex = distance == nearestLitterDist && nearestLitter != nullptr
+            && litter->sprite_index < nearestLitter->sprite_index;
+        if (isCloser || isTieWithLowerIndex)
         {
             nearestLitterDist = distance;
             nearestLitter = litter;
         }
+    };
+
+    // The distance is truncated to 16 bits, on very large maps litter far away can wrap around into range so all of it
+    // has to be checked.
+    constexpr int32_t maxDistanceZ = 4 * MAX_ELEMENT_HEIGHT * COORDS_Z_STEP;
+    if (2 * gMapSize * COORDS_XY_STEP + maxDistanceZ > std::numeric_limits<uint16_t>::max())
+    {
+        for (auto litter : EntityList<Litter>())
+        {
+            checkLitter(litter);
+        }
+        return nearestLitter;
     }
 
-    if (nearestLitterDist > MAX_LITTER_DISTANCE)
+    static std::vector<uint16_t> entities;
+    GetEntitiesInRange(
+        { pos.x - MAX_LITTER_DISTANCE, pos.y - MAX_LITTER_DISTANCE, pos.x + MAX_LITTER_DISTANCE, pos.y + MAX_LITTER_DISTANCE },
+        entities);
+    for (auto entityIndex : entities)
+    {
+        auto* litter = GetEntity<Litter>(entityIndex);
+        if (litter != nullptr)
+        {
+            checkLitter(litter);
+        }
+    }
+    return nearestLitter;
+}
+
+/**
+ *
+ *  rct2: 0x006BFBE8
+ *
+ * Returns INVALID_DIRECTION when no nearby litter or unpathable litter
+ */
+Direction Staff::HandymanDirectionToNearestLitter() const
+{
+    uint16_t nearestLitterDist = 0xFFFF;
+    Litter* nearestLitter = FindNearestLitter({ x, y, z }, nearestLitterDist);
+    if (nearestLitter == nullptr || nearestLitterDist > MAX_LITTER_DISTANCE)
     {
         return INVALID_DIRECTION;
     }
@@ -935,23 +1113,22 @@ bool Staff::DoMiscPathFinding()
  */
 void Staff::EntertainerUpdateNearbyPeeps() const
 {
-    for (auto guest : EntityList<Guest>())
-    {
+    ForEachEntityInRadius<Guest>({ x, y }, 96, [this](Guest* guest) {
         if (guest->x == LOCATION_NULL)
-            continue;
+            return;
 
         int16_t z_dist = abs(z - guest->z);
         if (z_dist > 48)
-            continue;
+            return;
 
         int16_t x_dist = abs(x - guest->x);
         int16_t y_dist = abs(y - guest->y);
 
         if (x_dist > 96)
-            continue;
+            return;
 
         if (y_dist > 96)
-            continue;
+            return;
 
         if (guest->State == PeepState::Walking)
         {
@@ -962,7 +1139,7 @@ void Staff::EntertainerUpdateNearbyPeeps() const
             guest->TimeInQueue = std::max(0, guest->TimeInQueue - 200);
             guest->HappinessTarget = std::min(guest->HappinessTarget + 3, PEEP_MAX_HAPPINESS);
         }
-    }
+    });
 }
 
 /**
@@ -13,6 +13,8 @@
 #include "../world/Map.h"
 #include "Peep.h"
 
+#include <functional>
+
 class DataSerialiser;
 
 // The number of elements in the gStaffPatrolAreas array per staff member. Every bit in the array represents a 4x4 square.
@@ -167,3 +169,19 @@ money32 GetStaffWage(StaffType type);
 PeepSpriteType EntertainerCostumeToSprite(EntertainerCostume entertainerType);
 
 const PatrolArea& GetMergedPatrolArea(const StaffType type);
+
+/**
+ * The staff of each type bucketed by the area of the map they are in, for finding the closest eligible staff member to a
+ * position without checking every one of them. It is built on first use in a tick and kept while no staff are hired or
+ * fired, staff move in the peep update which invalidates it.
+ */
+namespace StaffIndex
+{
+    void Invalidate();
+
+    /**
+     * Finds the staff member of the given type closest to pos by Manhattan distance for which isEligible returns true, on a
+     * tie the one with the lowest sprite index wins as it would when scanning the entity list.
+     */
+    Staff* FindClosest(StaffType type, const CoordsXY& pos, const std::function<bool(const Staff&)>& isEligible);
+} // namespace StaffIndex
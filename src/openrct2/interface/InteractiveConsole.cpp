@@ -19,12 +19,15 @@
 #include "../actions/ClimateSetAction.h"
 #include "../actions/RideSetPriceAction.h"
 #include "../actions/RideSetSettingAction.h"
+#include "../actions/ScenarioSetSettingAction.h"
 #include "../actions/SetCheatAction.h"
 #include "../actions/StaffSetCostumeAction.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
+#include "../core/MemoryAccounting.h"
 #include "../core/Path.hpp"
+#include "../core/Profiler.h"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
@@ -69,6 +72,11 @@
 #    include "../drawing/TTF.h"
 #endif
 
+#ifdef ENABLE_SCRIPTING
+#    include "../scripting/HookEngine.h"
+#    include "../scripting/ScriptEngine.h"
+#endif
+
 using arguments_t = std::vector<std::string>;
 
 static constexpr const char* ClimateNames[] = {
@@ -602,6 +610,11 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
             console.WriteFormatLine(
                 "guest_prefer_more_intense_rides %d", (gParkFlags & PARK_FLAGS_PREF_MORE_INTENSE_RIDES) != 0);
         }
+        else if (argv[0] == "guest_flow_field_navigation")
+        {
+            console.WriteFormatLine(
+                "guest_flow_field_navigation %d", (gParkFlags & PARK_FLAGS_GUEST_FLOW_FIELD_NAVIGATION) != 0);
+        }
         else if (argv[0] == "forbid_marketing_campaigns")
         {
             console.WriteFormatLine("forbid_marketing_campaigns %d", (gParkFlags & PARK_FLAGS_FORBID_MARKETING_CAMPAIGN) != 0);
@@ -815,6 +828,17 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             SET_FLAG(gParkFlags, PARK_FLAGS_PREF_MORE_INTENSE_RIDES, int_val[0]);
             console.Execute("get guest_prefer_more_intense_rides");
         }
+        else if (argv[0] == "guest_flow_field_navigation" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            auto scenarioSetSetting = ScenarioSetSettingAction(ScenarioSetSetting::GuestsUseFlowFieldNavigation, int_val[0]);
+            scenarioSetSetting.SetCallback([&console](const GameAction*, const GameActions::Result* res) {
+                if (res->Error != GameActions::Status::Ok)
+                    console.WriteLineError("Network error: Permission denied!");
+                else
+                    console.Execute("get guest_flow_field_navigation");
+            });
+            GameActions::Execute(&scenarioSetSetting);
+        }
         else if (argv[0] == "forbid_marketing_campaigns" && invalidArguments(&invalidArgs, int_valid[0]))
         {
             SET_FLAG(gParkFlags, PARK_FLAGS_FORBID_MARKETING_CAMPAIGN, int_val[0]);
@@ -1537,6 +1561,33 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
     return 0;
 }
 
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <replay_tick>");
+        return 0;
+    }
+
+    uint32_t replayTick = atol(argv[0].c_str());
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (replayManager->SeekPlayback(replayTick))
+    {
+        console.WriteFormatLine("Replay moved to tick %u", replayTick);
+        return 1;
+    }
+
+    console.WriteFormatLine("Unable to move the replay to tick %u", replayTick);
+    return 0;
+}
+
 static int32_t cc_replay_stop(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1749,6 +1800,7 @@ static constexpr const utf8* console_variable_table[] = {
     "guest_initial_thirst",
     "guest_prefer_less_intense_rides",
     "guest_prefer_more_intense_rides",
+    "guest_flow_field_navigation",
     "forbid_marketing_campaigns",
     "forbid_landscape_changes",
     "forbid_tree_removal",
@@ -1785,6 +1837,108 @@ static constexpr const utf8* console_window_table[] = {
 };
 // clang-format on
 
+static int32_t cc_memory_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto entries = OpenRCT2::MemoryAccounting::Query();
+    for (const auto& entry : entries)
+    {
+        console.WriteFormatLine("%-20s %10zu KiB", entry.Name.c_str(), entry.Bytes / 1024);
+    }
+    console.WriteFormatLine("%-20s %10zu KiB", "total", OpenRCT2::MemoryAccounting::GetTotal(entries) / 1024);
+    return 0;
+}
+
+static int32_t cc_plugin_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+#ifdef ENABLE_SCRIPTING
+    using namespace OpenRCT2::Scripting;
+
+    auto& scriptEngine = GetContext()->GetScriptEngine();
+    if (!argv.empty() && argv[0] == "reset")
+    {
+        scriptEngine.ResetTimings();
+        console.WriteLine("Plugin timings reset.");
+        return 1;
+    }
+
+    console.WriteFormatLine("%-32s %10s %12s %14s %10s", "plugin", "calls", "total (ms)", "max tick (ms)", "deferred");
+    for (auto& plugin : scriptEngine.GetPlugins())
+    {
+        const auto& timings = plugin->GetTimings();
+        console.WriteFormatLine(
+            "%-32s %10llu %12.2f %14.3f %10llu", plugin->GetMetadata().Name.c_str(),
+            static_cast<unsigned long long>(timings.Calls), timings.Total.count() * 1000.0, timings.MaxTick.count() * 1000.0,
+            static_cast<unsigned long long>(timings.DeferredIntervals));
+    }
+
+    console.WriteLine("");
+    console.WriteFormatLine("%-32s %10s %12s", "hook", "calls", "total (ms)");
+    const auto& hookEngine = scriptEngine.GetHookEngine();
+    for (size_t i = 0; i < NUM_HOOK_TYPES; i++)
+    {
+        const auto type = static_cast<HOOK_TYPE>(i);
+        const auto& timings = hookEngine.GetTimings(type);
+        if (timings.Calls == 0)
+        {
+            continue;
+        }
+        console.WriteFormatLine(
+            "%-32s %10llu %12.2f", std::string(GetHookName(type)).c_str(), static_cast<unsigned long long>(timings.Calls),
+            timings.Total.count() * 1000.0);
+    }
+    return 0;
+#else
+    console.WriteLineError("Scripting is not available in this build.");
+    return 1;
+#endif
+}
+
+static int32_t cc_profiler(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty())
+    {
+        if (argv[0] == "start")
+        {
+            OpenRCT2::Profiler::SetEnabled(true);
+            console.WriteLine("Profiler started.");
+            return 1;
+        }
+        if (argv[0] == "stop")
+        {
+            OpenRCT2::Profiler::SetEnabled(false);
+            console.WriteLine("Profiler stopped.");
+            return 1;
+        }
+        if (argv[0] == "reset")
+        {
+            OpenRCT2::Profiler::Reset();
+            console.WriteLine("Profiler reset.");
+            return 1;
+        }
+        if (argv[0] == "dump")
+        {
+            if (argv.size() < 2)
+            {
+                console.WriteLineError("Parameters required <filename>");
+                return 0;
+            }
+            if (!OpenRCT2::Profiler::ExportChromeTrace(argv[1]))
+            {
+                console.WriteLineError("Unable to write trace.");
+                return 0;
+            }
+            console.WriteFormatLine("Wrote %zu zones to %s", OpenRCT2::Profiler::GetEventCount(), argv[1].c_str());
+            return 1;
+        }
+    }
+
+    console.WriteFormatLine(
+        "Profiler is %s, %zu zones recorded.", OpenRCT2::Profiler::IsEnabled() ? "running" : "stopped",
+        OpenRCT2::Profiler::GetEventCount());
+    console.WriteLine("Subcommands: start, stop, reset, dump <filename>");
+    return 0;
+}
+
 static constexpr const console_command console_command_table[] = {
     { "abort", cc_abort, "Calls std::abort(), for testing purposes only.", "abort" },
     { "add_news_item", cc_add_news_item, "Inserts a news item", "add_news_item [<type> <message> <assoc>]" },
@@ -1804,8 +1958,12 @@ static constexpr const console_command console_command_table[] = {
       "This is a safer method opposed to \"open object_selection\".",
       "load_object <objectfilenodat>" },
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
+    { "memory_stats", cc_memory_stats, "Shows the memory used by the larger subsystems.", "memory_stats" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+    { "plugin_stats", cc_plugin_stats, "Shows the time spent running each plugin and hook.", "plugin_stats [reset]" },
+    { "profiler", cc_profiler, "Records timings of the game loop and exports them as a Chrome trace.",
+      "profiler start|stop|reset|dump <filename>" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.",
@@ -1824,6 +1982,7 @@ static constexpr const console_command console_command_table[] = {
     { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks]" },
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>" },
+    { "replay_seek", cc_replay_seek, "Moves the replay to a tick, counted from its start", "replay_seek <replay_tick>" },
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop" },
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
@@ -19,6 +19,7 @@
 #include "../core/Console.hpp"
 #include "../core/File.h"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Formatter.h"
@@ -31,12 +32,17 @@
 #include "../world/Surface.h"
 #include "Viewport.h"
 
+#include <algorithm>
+#include <array>
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <exception>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 using namespace OpenRCT2;
@@ -378,9 +384,75 @@ static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& vi
     viewport_render(&dpi, &viewport, { { 0, 0 }, { viewport.width, viewport.height } });
 }
 
+/**
+ * Renders the viewport in horizontal strips and streams each finished strip into the
+ * PNG encoder while the next one is rendered, so memory use is bounded by the strip
+ * size rather than the size of the image.
+ */
+static void RenderViewportToFile(const rct_viewport& viewport, std::string_view path)
+{
+    constexpr size_t StripBytes = 32 * 1024 * 1024;
+
+    const auto width = static_cast<size_t>(viewport.width);
+    const auto stripHeight = static_cast<int32_t>(
+        std::clamp<size_t>(StripBytes / std::max<size_t>(width, 1), 1, std::max(viewport.height, 1)));
+    std::array<std::vector<uint8_t>, 2> strips;
+
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+    Imaging::PngRowWriter writer(path, viewport.width, viewport.height, gPalette);
+    JobPool encoder(1);
+    std::exception_ptr encodeError;
+
+    size_t stripIndex = 0;
+    for (int32_t top = 0; top < viewport.height; top += stripHeight, stripIndex ^= 1)
+    {
+        const auto height = std::min(stripHeight, viewport.height - top);
+        auto& pixels = strips[stripIndex];
+        pixels.resize(width * height);
+        if (viewport.flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+        {
+            std::fill(pixels.begin(), pixels.end(), PALETTE_INDEX_0);
+        }
+
+        rct_drawpixelinfo dpi;
+        dpi.DrawingEngine = &drawingEngine;
+        dpi.bits = pixels.data();
+        dpi.y = top;
+        dpi.width = viewport.width;
+        dpi.height = height;
+        viewport_render(&dpi, &viewport, { { 0, top }, { viewport.width, top + height } });
+
+        // The previous strip has to be written before this one, it also releases its buffer for the next strip.
+        encoder.Join();
+        if (encodeError != nullptr)
+        {
+            std::rethrow_exception(encodeError);
+        }
+        encoder.AddTask([&writer, &pixels, &encodeError, height, width]() {
+            try
+            {
+                writer.WriteRows(pixels.data(), height, static_cast<uint32_t>(width));
+            }
+            catch (const std::exception&)
+            {
+                encodeError = std::current_exception();
+            }
+        });
+    }
+
+    encoder.Join();
+    if (encodeError != nullptr)
+    {
+        std::rethrow_exception(encodeError);
+    }
+    writer.Finish();
+}
+
 void screenshot_giant()
 {
-    rct_drawpixelinfo dpi{};
     try
     {
         auto path = screenshot_get_next_path();
@@ -408,10 +480,7 @@ void screenshot_giant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path.value(), &dpi, gPalette);
+        RenderViewportToFile(viewport, path.value());
 
         // Show user that screenshot saved successfully
         Formatter ft;
@@ -424,8 +493,6 @@ void screenshot_giant()
         log_error("%s", e.what());
         context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 // TODO: Move this at some point into a more appropriate place.
@@ -471,45 +538,55 @@ static void benchgfx_render_screenshots(const char* inputPath, std::unique_ptr<I
 
     try
     {
-        double totalTime = 0.0;
-
-        std::array<double, NUM_ZOOM_LEVELS> zoomAverages;
+        const auto engineStringId = DrawingEngineStringIds[EnumValue(DrawingEngine::Software)];
+        const auto engineName = format_string(engineStringId, nullptr);
+        std::printf("Engine: %s\n", engineName.c_str());
+        std::printf("Render Count: %u\n", totalRenderCount);
 
-        // Render at every zoom.
-        for (int32_t zoom = 0; zoom < NUM_ZOOM_LEVELS; zoom++)
+        // Compare every set of drawing functions the CPU supports, starting with the scalar ones.
+        const auto bestSimd = drawing_simd_get_best();
+        for (auto simd = DrawingSimd::Scalar; simd <= bestSimd; simd = static_cast<DrawingSimd>(EnumValue(simd) + 1))
         {
-            double zoomLevelTime = 0.0;
+            drawing_simd_select(simd);
 
-            // Render at every rotation.
-            for (int32_t rotation = 0; rotation < NUM_ROTATIONS; rotation++)
+            double totalTime = 0.0;
+
+            std::array<double, NUM_ZOOM_LEVELS> zoomAverages;
+
+            // Render at every zoom.
+            for (int32_t zoom = 0; zoom < NUM_ZOOM_LEVELS; zoom++)
             {
-                // N iterations.
-                for (uint32_t i = 0; i < iterationCount; i++)
+                double zoomLevelTime = 0.0;
+
+                // Render at every rotation.
+                for (int32_t rotation = 0; rotation < NUM_ROTATIONS; rotation++)
                 {
-                    auto& dpi = dpis[zoom * NUM_ZOOM_LEVELS + rotation];
-                    auto& viewport = viewports[zoom * NUM_ZOOM_LEVELS + rotation];
-                    double elapsed = MeasureFunctionTime([&viewport, &dpi]() { RenderViewport(nullptr, viewport, dpi); });
-                    totalTime += elapsed;
-                    zoomLevelTime += elapsed;
+                    // N iterations.
+                    for (uint32_t i = 0; i < iterationCount; i++)
+                    {
+                        auto& dpi = dpis[zoom * NUM_ZOOM_LEVELS + rotation];
+                        auto& viewport = viewports[zoom * NUM_ZOOM_LEVELS + rotation];
+                        double elapsed = MeasureFunctionTime([&viewport, &dpi]() { RenderViewport(nullptr, viewport, dpi); });
+                        totalTime += elapsed;
+                        zoomLevelTime += elapsed;
+                    }
                 }
-            }
 
-            zoomAverages[zoom] = zoomLevelTime / static_cast<double>(NUM_ROTATIONS * iterationCount);
-        }
+                zoomAverages[zoom] = zoomLevelTime / static_cast<double>(NUM_ROTATIONS * iterationCount);
+            }
 
-        const double average = totalTime / static_cast<double>(totalRenderCount);
-        const auto engineStringId = DrawingEngineStringIds[EnumValue(DrawingEngine::Software)];
-        const auto engineName = format_string(engineStringId, nullptr);
-        std::printf("Engine: %s\n", engineName.c_str());
-        std::printf("Render Count: %u\n", totalRenderCount);
-        for (ZoomLevel zoom{ 0 }; zoom < ZoomLevel::max(); zoom++)
-        {
-            int32_t zoomIndex{ static_cast<int8_t>(zoom) };
-            const auto zoomAverage = zoomAverages[zoomIndex];
-            std::printf("Zoom[%d] average: %.06fs, %.f FPS\n", zoomIndex, zoomAverage, 1.0 / zoomAverage);
+            const double average = totalTime / static_cast<double>(totalRenderCount);
+            std::printf("Drawing functions: %s\n", drawing_simd_get_name(simd));
+            for (ZoomLevel zoom{ 0 }; zoom < ZoomLevel::max(); zoom++)
+            {
+                int32_t zoomIndex{ static_cast<int8_t>(zoom) };
+                const auto zoomAverage = zoomAverages[zoomIndex];
+                std::printf("Zoom[%d] average: %.06fs, %.f FPS\n", zoomIndex, zoomAverage, 1.0 / zoomAverage);
+            }
+            std::printf("Total average: %.06fs, %.f FPS\n", average, 1.0 / average);
+            std::printf("Time: %.05fs\n", totalTime);
         }
-        std::printf("Total average: %.06fs, %.f FPS\n", average, 1.0 / average);
-        std::printf("Time: %.05fs\n", totalTime);
+        drawing_simd_select(bestSimd);
     }
     catch (const std::exception& e)
     {
@@ -622,7 +699,6 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
     }
 
     int32_t exitCode = 1;
-    rct_drawpixelinfo dpi;
     try
     {
         core_init();
@@ -725,17 +801,13 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
 
         ApplyOptions(options, viewport);
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, &dpi, gPalette);
+        RenderViewportToFile(viewport, outputPath);
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
         exitCode = -1;
     }
-    ReleaseDPI(dpi);
 
     drawing_engine_dispose();
 
@@ -791,7 +863,7 @@ static std::string ResolveFilenameForCapture(const fs::path& filename)
     return screenshotPath.string();
 }
 
-void CaptureImage(const CaptureOptions& options)
+static rct_viewport GetCaptureViewport(const CaptureOptions& options)
 {
     rct_viewport viewport{};
     if (options.View.has_value())
@@ -813,19 +885,66 @@ void CaptureImage(const CaptureOptions& options)
         viewport = GetGiantViewport(gMapSize, options.Rotation, options.Zoom);
     }
 
-    auto backupRotation = gCurrentRotation;
-    gCurrentRotation = options.Rotation;
-
     if (options.Transparent)
     {
         viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
     }
+    return viewport;
+}
+
+void CaptureImage(const CaptureOptions& options)
+{
+    auto viewport = GetCaptureViewport(options);
+    auto outputPath = ResolveFilenameForCapture(options.Filename);
+
+    auto backupRotation = gCurrentRotation;
+    gCurrentRotation = options.Rotation;
+    try
+    {
+        RenderViewportToFile(viewport, outputPath);
+    }
+    catch (const std::exception&)
+    {
+        gCurrentRotation = backupRotation;
+        throw;
+    }
+
+    gCurrentRotation = backupRotation;
+}
 
+std::future<void> CaptureImageAsync(const CaptureOptions& options)
+{
+    auto viewport = GetCaptureViewport(options);
     auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto dpi = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, dpi);
-    WriteDpiToFile(outputPath, &dpi, gPalette);
-    ReleaseDPI(dpi);
 
+    // The whole image is kept in memory as it has to be rendered before the game state changes again
+    Image image;
+    image.Width = viewport.width;
+    image.Height = viewport.height;
+    image.Depth = 8;
+    image.Stride = viewport.width;
+    image.Palette = std::make_unique<GamePalette>(gPalette);
+    image.Pixels.resize(static_cast<size_t>(image.Stride) * image.Height, PALETTE_INDEX_0);
+
+    rct_drawpixelinfo dpi;
+    dpi.bits = image.Pixels.data();
+    dpi.width = viewport.width;
+    dpi.height = viewport.height;
+
+    auto backupRotation = gCurrentRotation;
+    gCurrentRotation = options.Rotation;
+    try
+    {
+        RenderViewport(nullptr, viewport, dpi);
+    }
+    catch (const std::exception&)
+    {
+        gCurrentRotation = backupRotation;
+        throw;
+    }
     gCurrentRotation = backupRotation;
+
+    return std::async(std::launch::async, [image = std::move(image), outputPath]() {
+        Imaging::WriteToFile(outputPath, image, IMAGE_FORMAT::PNG);
+    });
 }
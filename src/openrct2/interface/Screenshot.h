@@ -15,6 +15,7 @@
 #include "../world/Location.hpp"
 #include "ZoomLevel.h"
 
+#include <future>
 #include <optional>
 #include <string>
 
@@ -62,3 +63,9 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
 int32_t cmdline_for_gfxbench(const char** argv, int32_t argc);
 
 void CaptureImage(const CaptureOptions& options);
+
+/**
+ * Renders the capture on the calling thread and then encodes and writes it on a background thread.
+ * The returned future is ready once the file has been written, or holds the error if it could not be.
+ */
+std::future<void> CaptureImageAsync(const CaptureOptions& options);
@@ -22,6 +22,9 @@
 #include "../entity/Guest.h"
 #include "../entity/Staff.h"
 #include "../paint/Paint.h"
+#include "../paint/VirtualFloor.h"
+#include "../paint/tile_element/Paint.TileElement.h"
+#include "../platform/Platform2.h"
 #include "../ride/Ride.h"
 #include "../ride/TrackDesign.h"
 #include "../ride/Vehicle.h"
@@ -37,6 +40,7 @@
 #include <algorithm>
 #include <cstring>
 #include <list>
+#include <numeric>
 #include <unordered_map>
 
 using namespace OpenRCT2;
@@ -50,7 +54,23 @@ static std::list<rct_viewport> _viewports;
 rct_viewport* g_music_tracking_viewport;
 
 static std::unique_ptr<JobPool> _paintJobs;
+static size_t _paintThreadCount;
 static std::vector<paint_session*> _paintColumns;
+static std::vector<size_t> _paintColumnOrder;
+
+/**
+ * Number of paint structs each column of a viewport produced when it was last painted, keyed by the view x of the
+ * column. Used to hand the most expensive columns to the workers first so no worker is left with a dense column at the
+ * end of the frame.
+ */
+struct PaintColumnCosts
+{
+    ZoomLevel Zoom;
+    std::unordered_map<int32_t, size_t> Costs;
+};
+static std::unordered_map<const rct_viewport*, PaintColumnCosts> _paintColumnCosts;
+// Scrolling around the map keeps adding columns, start over once this many are known.
+static constexpr size_t MaxPaintColumnCosts = 4096;
 
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
@@ -60,6 +80,25 @@ paint_entry* gNextFreePaintStruct;
 uint8_t gCurrentRotation;
 
 static uint32_t _currentImageType;
+
+/**
+ * The sprites under the last pixel hit tested, tools and tooltips ask for the same pixel several times per frame with
+ * different filters. Only valid within the frame and tick it was painted in and until a game action is executed.
+ */
+struct InteractionHits
+{
+    const rct_viewport* Viewport{};
+    ScreenCoordsXY ViewLoc;
+    ZoomLevel Zoom;
+    uint32_t ViewportFlags{};
+    int32_t Rotation{};
+    uint32_t DrawCount{};
+    uint32_t Ticks{};
+    bool Valid{};
+    std::vector<InteractionInfo> Items;
+};
+static InteractionHits _interactionHits;
+
 InteractionInfo::InteractionInfo(const paint_struct* ps)
     : Loc(ps->map_x, ps->map_y)
     , Element(ps->tileElement)
@@ -215,6 +254,7 @@ void viewport_remove(rct_viewport* viewport)
         log_error("Unable to remove viewport: %p", viewport);
         return;
     }
+    _paintColumnCosts.erase(viewport);
     _viewports.erase(it);
 }
 
@@ -524,6 +564,13 @@ static void viewport_move(const ScreenCoordsXY& coords, rct_window* w, rct_viewp
         rct_drawpixelinfo* dpi = drawing_engine_get_dpi();
         viewport_shift_pixels(dpi, w, viewport, x_diff, y_diff);
     }
+    else
+    {
+        // Engines that can not shift pixels repaint the whole viewport.
+        gfx_set_dirty_blocks(
+            { { viewport->pos.x, viewport->pos.y },
+              { viewport->pos.x + viewport->width, viewport->pos.y + viewport->height } });
+    }
 
     *viewport = view_copy;
 }
@@ -857,10 +904,11 @@ static void record_session(
     {
         for (size_t i = 0; i < chain->Count; i++)
         {
-            auto& src = chain->PaintStructs[i];
-            auto& dst = recordedSession.Entries[paintIndex++];
+            auto& src = chain->Entries[i];
+            auto& dst = recordedSession.Entries[paintIndex];
             dst = src;
-            entryRemap[src.AsBasic()] = reinterpret_cast<paint_struct*>(i * sizeof(paint_entry));
+            entryRemap[src.AsBasic()] = reinterpret_cast<paint_struct*>(paintIndex * sizeof(paint_entry));
+            paintIndex++;
         }
         chain = chain->Next;
     }
@@ -988,10 +1036,16 @@ void viewport_paint(
 
     _paintColumns.clear();
 
+    // The map does not change until every column has been generated.
+    TileBlockVisibilityScope blockVisibility;
+    virtual_floor_prepare_paint();
+
     bool useMultithreading = gConfigGeneral.multithreading;
     if (useMultithreading && _paintJobs == nullptr)
     {
-        _paintJobs = std::make_unique<JobPool>();
+        auto paintCores = Platform::ParseCoreList(gConfigGeneral.paint_thread_cores);
+        auto maxThreads = _paintThreadCount == 0 ? 255 : _paintThreadCount - 1;
+        _paintJobs = std::make_unique<JobPool>(maxThreads, "Paint", std::move(paintCores));
     }
     else if (useMultithreading == false && _paintJobs != nullptr)
     {
@@ -1004,8 +1058,7 @@ void viewport_paint(
         useParallelDrawing = true;
     }
 
-    // Create space to record sessions and keep track which index is being drawn
-    size_t index = 0;
+    // Create space to record sessions, each column is recorded at its index
     if (recorded_sessions != nullptr)
     {
         auto columnSize = rightBorder - alignedX;
@@ -1014,7 +1067,7 @@ void viewport_paint(
     }
 
     // Generate and sort columns.
-    for (x = alignedX; x < rightBorder; x += 32, index++)
+    for (x = alignedX; x < rightBorder; x += 32)
     {
         paint_session* session = PaintSessionAlloc(&dpi1, viewFlags);
         _paintColumns.push_back(session);
@@ -1037,15 +1090,49 @@ void viewport_paint(
             dpi2.pitch += rightPitch / dpi2.zoom_level;
         }
         dpi2.width = paintRight - dpi2.x;
+    }
+
+    // Workers take the columns in this order, most expensive first by the previous frame's counts.
+    _paintColumnOrder.resize(_paintColumns.size());
+    std::iota(_paintColumnOrder.begin(), _paintColumnOrder.end(), 0);
+    if (_paintColumnCosts.size() > MAX_VIEWPORT_COUNT && _paintColumnCosts.count(viewport) == 0)
+    {
+        // Screenshots paint through temporary viewports that are never removed
+        _paintColumnCosts.clear();
+    }
+    auto& columnCosts = _paintColumnCosts[viewport];
+    if (columnCosts.Zoom != viewport->zoom || columnCosts.Costs.size() > MaxPaintColumnCosts)
+    {
+        columnCosts.Zoom = viewport->zoom;
+        columnCosts.Costs.clear();
+    }
+    if (useMultithreading)
+    {
+        std::vector<size_t> estimates(_paintColumns.size(), SIZE_MAX);
+        for (size_t i = 0; i < _paintColumns.size(); i++)
+        {
+            // Columns that were not painted before are started first as their cost is unknown
+            auto it = columnCosts.Costs.find(alignedX + static_cast<int32_t>(i) * 32);
+            if (it != columnCosts.Costs.end())
+                estimates[i] = it->second;
+        }
+        std::stable_sort(_paintColumnOrder.begin(), _paintColumnOrder.end(), [&estimates](size_t a, size_t b) {
+            return estimates[a] > estimates[b];
+        });
+    }
 
+    for (auto columnIndex : _paintColumnOrder)
+    {
+        auto* session = _paintColumns[columnIndex];
         if (useMultithreading)
         {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(*session, recorded_sessions, index); });
+            _paintJobs->AddTask([session, recorded_sessions, columnIndex]() -> void {
+                viewport_fill_column(*session, recorded_sessions, columnIndex);
+            });
         }
         else
         {
-            viewport_fill_column(*session, recorded_sessions, index);
+            viewport_fill_column(*session, recorded_sessions, columnIndex);
         }
     }
 
@@ -1054,9 +1141,19 @@ void viewport_paint(
         _paintJobs->Join();
     }
 
+    for (size_t i = 0; i < _paintColumns.size(); i++)
+    {
+        columnCosts.Costs[alignedX + static_cast<int32_t>(i) * 32] = _paintColumns[i]->PaintEntryChain.GetCount();
+    }
+
     // Paint columns.
-    for (auto* session : _paintColumns)
+    if (useParallelDrawing)
+    {
+        dpi->DrawingEngine->BeginParallelDraw();
+    }
+    for (auto columnIndex : _paintColumnOrder)
     {
+        auto* session = _paintColumns[columnIndex];
         if (useParallelDrawing)
         {
             _paintJobs->AddTask([session]() -> void { viewport_paint_column(*session); });
@@ -1069,6 +1166,7 @@ void viewport_paint(
     if (useParallelDrawing)
     {
         _paintJobs->Join();
+        dpi->DrawingEngine->EndParallelDraw();
     }
 
     // Release resources.
@@ -1078,6 +1176,15 @@ void viewport_paint(
     }
 }
 
+void viewport_set_paint_thread_count(size_t threadCount)
+{
+    if (threadCount != _paintThreadCount)
+    {
+        _paintThreadCount = threadCount;
+        _paintJobs.reset();
+    }
+}
+
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi)
 {
     auto paletteId = climate_get_weather_gloom_palette_id(gClimateCurrent);
@@ -1164,6 +1271,43 @@ CoordsXY viewport_coord_to_map_coord(const ScreenCoordsXY& coords, int32_t z)
     return ret.Rotate(inverseRotation);
 }
 
+/**
+ * Gets the part of the map each viewport up to the given zoom level can show, for elements at any height.
+ */
+std::vector<MapRange> viewports_get_visible_map_ranges(ZoomLevel maxZoom)
+{
+    std::vector<MapRange> result;
+    for (const auto& vp : _viewports)
+    {
+        if (vp.zoom > maxZoom)
+            continue;
+
+        const ScreenCoordsXY corners[] = {
+            vp.viewPos,
+            vp.viewPos + ScreenCoordsXY{ vp.view_width, 0 },
+            vp.viewPos + ScreenCoordsXY{ 0, vp.view_height },
+            vp.viewPos + ScreenCoordsXY{ vp.view_width, vp.view_height },
+        };
+        auto left = std::numeric_limits<int32_t>::max();
+        auto top = std::numeric_limits<int32_t>::max();
+        auto right = std::numeric_limits<int32_t>::min();
+        auto bottom = std::numeric_limits<int32_t>::min();
+        for (auto z : { 0, MAX_ELEMENT_HEIGHT * COORDS_Z_STEP })
+        {
+            for (const auto& corner : corners)
+            {
+                auto mapCoords = viewport_coord_to_map_coord(corner, z);
+                left = std::min(left, mapCoords.x);
+                top = std::min(top, mapCoords.y);
+                right = std::max(right, mapCoords.x);
+                bottom = std::max(bottom, mapCoords.y);
+            }
+        }
+        result.emplace_back(left, top, right, bottom);
+    }
+    return result;
+}
+
 /**
  *
  *  rct2: 0x00664689
@@ -1691,6 +1835,46 @@ InteractionInfo set_interaction_info_from_paint_session(paint_session* session,
     return info;
 }
 
+/**
+ * Collects every sprite under the pixel of the session that can be interacted with, in the order they are drawn.
+ */
+static void collect_interaction_hits_from_paint_session(paint_session* session, std::vector<InteractionInfo>& hits)
+{
+    paint_struct* ps = &session->PaintHead;
+    rct_drawpixelinfo* dpi = &session->DPI;
+
+    while ((ps = ps->next_quadrant_ps) != nullptr)
+    {
+        paint_struct* old_ps = ps;
+        paint_struct* next_ps = ps;
+        while (next_ps != nullptr)
+        {
+            ps = next_ps;
+            if (is_sprite_interacted_with(dpi, ps->image_id, { ps->x, ps->y }))
+            {
+                if (PSSpriteTypeIsInFilter(ps, ViewportInteractionItemAll))
+                {
+                    hits.emplace_back(ps);
+                }
+            }
+            next_ps = ps->children;
+        }
+
+        for (attached_paint_struct* attached_ps = ps->attached_ps; attached_ps != nullptr; attached_ps = attached_ps->next)
+        {
+            if (is_sprite_interacted_with(dpi, attached_ps->image_id, { (attached_ps->x + ps->x), (attached_ps->y + ps->y) }))
+            {
+                if (PSSpriteTypeIsInFilter(ps, ViewportInteractionItemAll))
+                {
+                    hits.emplace_back(ps);
+                }
+            }
+        }
+
+        ps = old_ps;
+    }
+}
+
 /**
  *
  *  rct2: 0x00685ADC
@@ -1738,15 +1922,48 @@ InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const Sc
         dpi.zoom_level = myviewport->zoom;
         dpi.width = 1;
 
-        paint_session* session = PaintSessionAlloc(&dpi, myviewport->flags);
-        PaintSessionGenerate(*session);
-        PaintSessionArrange(*session);
-        info = set_interaction_info_from_paint_session(session, flags & 0xFFFF);
-        PaintSessionFree(session);
+        auto& hits = _interactionHits;
+        if (!hits.Valid || hits.Viewport != myviewport || hits.ViewLoc != viewLoc || hits.Zoom != myviewport->zoom
+            || hits.ViewportFlags != myviewport->flags || hits.Rotation != get_current_rotation()
+            || hits.DrawCount != gCurrentDrawCount || hits.Ticks != gCurrentTicks)
+        {
+            hits.Items.clear();
+            TileBlockVisibilityScope blockVisibility;
+            paint_session* session = PaintSessionAlloc(&dpi, myviewport->flags);
+            PaintSessionGenerate(*session);
+            PaintSessionArrange(*session);
+            collect_interaction_hits_from_paint_session(session, hits.Items);
+            PaintSessionFree(session);
+
+            hits.Viewport = myviewport;
+            hits.ViewLoc = viewLoc;
+            hits.Zoom = myviewport->zoom;
+            hits.ViewportFlags = myviewport->flags;
+            hits.Rotation = get_current_rotation();
+            hits.DrawCount = gCurrentDrawCount;
+            hits.Ticks = gCurrentTicks;
+            hits.Valid = true;
+        }
+
+        // The topmost sprite in the filter wins, as it was the last one drawn
+        const auto filter = static_cast<uint16_t>(flags & 0xFFFF);
+        for (auto it = hits.Items.rbegin(); it != hits.Items.rend(); it++)
+        {
+            if (filter & EnumToFlag(it->SpriteType))
+            {
+                info = *it;
+                break;
+            }
+        }
     }
     return info;
 }
 
+void ViewportInteractionInvalidate()
+{
+    _interactionHits.Valid = false;
+}
+
 /**
  * screenRect represents 2D map coordinates at zoom 0.
  */
@@ -119,10 +119,16 @@ void viewport_render(
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, const ScreenRect& screenRect,
     std::vector<RecordedPaintSession>* sessions = nullptr);
+/**
+ * Limits how many threads viewport_paint uses when multithreading is enabled, including the calling thread.
+ * 0 uses every hardware thread.
+ */
+void viewport_set_paint_thread_count(size_t threadCount);
 
 CoordsXYZ viewport_adjust_for_map_height(const ScreenCoordsXY& startCoords);
 
 CoordsXY viewport_coord_to_map_coord(const ScreenCoordsXY& coords, int32_t z);
+std::vector<MapRange> viewports_get_visible_map_ranges(ZoomLevel maxZoom);
 std::optional<CoordsXY> screen_pos_to_map_pos(const ScreenCoordsXY& screenCoords, int32_t* direction);
 
 void show_gridlines();
@@ -137,6 +143,12 @@ InteractionInfo get_map_coordinates_from_pos(const ScreenCoordsXY& screenCoords,
 InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const ScreenCoordsXY& screenCoords, int32_t flags);
 
 InteractionInfo set_interaction_info_from_paint_session(paint_session* session, uint16_t filter);
+
+/**
+ * Forgets the sprites remembered for the last hit tested pixel, needed whenever the map or entities change outside of
+ * a game tick.
+ */
+void ViewportInteractionInvalidate();
 InteractionInfo ViewportInteractionGetItemLeft(const ScreenCoordsXY& screenCoords);
 bool ViewportInteractionLeftOver(const ScreenCoordsXY& screenCoords);
 bool ViewportInteractionLeftClick(const ScreenCoordsXY& screenCoords);
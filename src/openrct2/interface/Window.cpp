@@ -51,6 +51,7 @@ TextInputSession* gTextInput;
 uint16_t gWindowUpdateTicks;
 uint16_t gWindowMapFlashingFlags;
 colour_t gCurrentWindowColours[4];
+bool gShowWindowRepaints;
 
 // converted from uint16_t values at 0x009A41EC - 0x009A4230
 // these are percentage coordinates of the viewport to centre to, if a window is obscuring a location, the next is tried
@@ -85,6 +86,7 @@ namespace WindowCloseFlags
 
 static void window_draw_core(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom);
 static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom);
+static void window_draw_repaint_outline(rct_drawpixelinfo* dpi, rct_window* w);
 
 std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w)
 {
@@ -1241,6 +1243,36 @@ static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t le
     gCurrentWindowColours[3] = NOT_TRANSLUCENT(w->colours[3]);
 
     window_event_paint_call(w, dpi);
+
+    if (gShowWindowRepaints)
+    {
+        window_draw_repaint_outline(dpi, w);
+    }
+}
+
+/**
+ * Outlines the window in a colour that changes every frame the window is repainted in, windows that are repainted
+ * constantly flicker while windows that are up to date keep the same colour.
+ */
+static void window_draw_repaint_outline(rct_drawpixelinfo* dpi, rct_window* w)
+{
+    static constexpr const uint8_t OutlineColours[] = {
+        PALETTE_INDEX_21, PALETTE_INDEX_61, PALETTE_INDEX_102, PALETTE_INDEX_136, PALETTE_INDEX_162, PALETTE_INDEX_171,
+    };
+
+    if (w->last_repaint_draw_count != gCurrentDrawCount)
+    {
+        w->last_repaint_draw_count = gCurrentDrawCount;
+        w->repaint_count++;
+    }
+
+    const auto colour = OutlineColours[w->repaint_count % std::size(OutlineColours)];
+    const auto topLeft = w->windowPos;
+    const auto bottomRight = w->windowPos + ScreenCoordsXY{ w->width - 1, w->height - 1 };
+    gfx_fill_rect(dpi, { topLeft, { bottomRight.x, topLeft.y } }, colour);
+    gfx_fill_rect(dpi, { { topLeft.x, bottomRight.y }, bottomRight }, colour);
+    gfx_fill_rect(dpi, { topLeft, { topLeft.x, bottomRight.y } }, colour);
+    gfx_fill_rect(dpi, { { bottomRight.x, topLeft.y }, bottomRight }, colour);
 }
 
 /**
@@ -20,6 +20,7 @@
 #include <limits>
 #include <list>
 #include <memory>
+#include <type_traits>
 #include <variant>
 
 struct rct_drawpixelinfo;
@@ -462,6 +463,7 @@ enum
     WC_DEBUG_PAINT = 130,
     WC_VIEW_CLIPPING = 131,
     WC_OBJECT_LOAD_ERROR = 132,
+    WC_PERFORMANCE = 133,
 
     // Only used for colour schemes
     WC_STAFF = 220,
@@ -655,6 +657,48 @@ extern uint16_t gWindowMapFlashingFlags;
 extern colour_t gCurrentWindowColours[4];
 
 extern bool gDisableErrorWindowSound;
+extern bool gShowWindowRepaints;
+
+/**
+ * Accumulates the values a window displays, windows that would otherwise invalidate themselves every tick pass the
+ * result to rct_window::InvalidateIfChanged so they are only repainted when something they show has changed.
+ */
+class WindowContentHash
+{
+private:
+    uint64_t _value = 0xCBF29CE484222325;
+
+public:
+    WindowContentHash& AddBytes(const void* data, size_t length)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < length; i++)
+        {
+            _value = (_value ^ bytes[i]) * 0x100000001B3;
+        }
+        return *this;
+    }
+
+    template<typename T> WindowContentHash& Add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be hashed");
+        return AddBytes(&value, sizeof(T));
+    }
+
+    template<typename T, size_t TSize> WindowContentHash& Add(const T (&values)[TSize])
+    {
+        for (const auto& value : values)
+        {
+            Add(value);
+        }
+        return *this;
+    }
+
+    uint64_t GetValue() const
+    {
+        return _value;
+    }
+};
 
 std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w);
 void window_visit_each(std::function<void(rct_window*)> func);
@@ -27,6 +27,20 @@ void rct_window::Invalidate()
     gfx_set_dirty_blocks({ windowPos, windowPos + ScreenCoordsXY{ width, height } });
 }
 
+/**
+ * Invalidates the window if the hash of its contents differs from the one passed last time.
+ * @return true if the window was invalidated.
+ */
+bool rct_window::InvalidateIfChanged(const WindowContentHash& contentHash)
+{
+    if (contentHash.GetValue() == content_hash)
+        return false;
+
+    content_hash = contentHash.GetValue();
+    Invalidate();
+    return true;
+}
+
 void rct_window::RemoveViewport()
 {
     if (viewport == nullptr)
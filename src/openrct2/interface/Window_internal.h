@@ -103,10 +103,16 @@ struct rct_window
     colour_t colours[6]{};
     VisibilityCache visibility{};
     uint16_t viewport_smart_follow_sprite = SPRITE_INDEX_NULL; // Handles setting viewport target sprite etc
+    // Hash of the displayed values, see InvalidateIfChanged
+    uint64_t content_hash{};
+    // Used by the window repaint overlay
+    uint32_t last_repaint_draw_count{};
+    uint8_t repaint_count{};
 
     void SetLocation(const CoordsXYZ& coords);
     void ScrollToViewport();
     void Invalidate();
+    bool InvalidateIfChanged(const WindowContentHash& contentHash);
     void RemoveViewport();
 
     rct_window() = default;
@@ -9,14 +9,18 @@
 
 #include "Formatting.h"
 
+#include "../Context.h"
 #include "../config/Config.h"
 #include "../util/Util.h"
 #include "Formatter.h"
 #include "Localisation.h"
+#include "LocalisationService.h"
 #include "StringIds.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <unordered_map>
 
 namespace OpenRCT2
 {
@@ -87,8 +91,24 @@ namespace OpenRCT2
         update();
     }
 
+    FmtString::iterator::iterator(std::string_view s, size_t i, const std::vector<token>& t, size_t ti)
+        : str(s)
+        , index(i)
+        , tokens(t.data())
+        , tokenCount(t.size())
+        , tokenIndex(ti)
+    {
+        update();
+    }
+
     void FmtString::iterator::update()
     {
+        if (tokens != nullptr)
+        {
+            current = tokenIndex < tokenCount ? tokens[tokenIndex] : token();
+            return;
+        }
+
         auto i = index;
         if (i >= str.size())
         {
@@ -207,6 +227,7 @@ namespace OpenRCT2
         if (index < str.size())
         {
             index += current.text.size();
+            tokenIndex++;
             update();
         }
         return *this;
@@ -215,11 +236,7 @@ namespace OpenRCT2
     FmtString::iterator FmtString::iterator::operator++(int)
     {
         auto result = *this;
-        if (index < str.size())
-        {
-            index += current.text.size();
-            update();
-        }
+        ++*this;
         return result;
     }
 
@@ -244,13 +261,27 @@ namespace OpenRCT2
     {
     }
 
+    FmtString::FmtString(std::string_view s, const std::vector<token>& tokens)
+        : _str(s)
+        , _tokens(&tokens)
+    {
+    }
+
     FmtString::iterator FmtString::begin() const
     {
+        if (_tokens != nullptr)
+        {
+            return iterator(_str, 0, *_tokens, 0);
+        }
         return iterator(_str, 0);
     }
 
     FmtString::iterator FmtString::end() const
     {
+        if (_tokens != nullptr)
+        {
+            return iterator(_str, _str.size(), *_tokens, _tokens->size());
+        }
         return iterator(_str, _str.size());
     }
 
@@ -627,10 +658,42 @@ namespace OpenRCT2
         return id >= REAL_NAME_START && id <= REAL_NAME_END;
     }
 
+    /**
+     * Tokens of the text behind a string id, valid for as long as the strings version of the localisation service does
+     * not change.
+     */
+    struct TokenisedFmtString
+    {
+        const char* Source{};
+        uint32_t StringsVersion{};
+        std::vector<FmtString::token> Tokens;
+    };
+
     FmtString GetFmtStringById(rct_string_id id)
     {
-        auto fmtc = language_get_string(id);
-        return FmtString(fmtc);
+        const auto& localisationService = GetContext()->GetLocalisationService();
+        auto fmtc = localisationService.GetString(id);
+        if (fmtc == nullptr)
+        {
+            return FmtString(fmtc);
+        }
+
+        // Each thread keeps its own tokens so formatting does not need a lock. References to the entries stay valid
+        // when the map grows, so nested string ids can be formatted while an outer one is still being iterated.
+        thread_local std::unordered_map<rct_string_id, TokenisedFmtString> tokenCache;
+        auto& entry = tokenCache[id];
+        const auto stringsVersion = localisationService.GetStringsVersion();
+        if (entry.Source != fmtc || entry.StringsVersion != stringsVersion)
+        {
+            entry.Source = fmtc;
+            entry.StringsVersion = stringsVersion;
+            entry.Tokens.clear();
+            for (const auto& token : FmtString(fmtc))
+            {
+                entry.Tokens.push_back(token);
+            }
+        }
+        return FmtString(fmtc, entry.Tokens);
     }
 
     FormatBuffer& GetThreadFormatStream()
@@ -753,7 +816,8 @@ namespace OpenRCT2
         return value;
     }
 
-    static void BuildAnyArgListFromLegacyArgBuffer(const FmtString& fmt, std::vector<FormatArg_t>& anyArgs, const void*& args)
+    static void BuildAnyArgListFromLegacyArgBuffer(
+        const FmtString& fmt, std::vector<FormatArg_t>& anyArgs, const void*& args, uintptr_t* argsEnd = nullptr)
     {
         for (const auto& t : fmt)
         {
@@ -786,7 +850,7 @@ namespace OpenRCT2
                 {
                     auto stringId = ReadFromArgs<rct_string_id>(args);
                     anyArgs.push_back(stringId);
-                    BuildAnyArgListFromLegacyArgBuffer(GetFmtStringById(stringId), anyArgs, args);
+                    BuildAnyArgListFromLegacyArgBuffer(GetFmtStringById(stringId), anyArgs, args, argsEnd);
                     break;
                 }
                 case FormatToken::String:
@@ -804,6 +868,10 @@ namespace OpenRCT2
                 default:
                     break;
             }
+            if (argsEnd != nullptr)
+            {
+                *argsEnd = std::max(*argsEnd, reinterpret_cast<uintptr_t>(args));
+            }
         }
     }
 
@@ -816,6 +884,23 @@ namespace OpenRCT2
         return FormatStringAny(buffer, bufferLen, fmt, anyArgs);
     }
 
+    bool FormatStringLegacy(std::string& result, rct_string_id id, const void* args, size_t argsLength)
+    {
+        thread_local std::vector<FormatArg_t> anyArgs;
+        anyArgs.clear();
+        auto fmt = GetFmtStringById(id);
+        const auto argsStart = reinterpret_cast<uintptr_t>(args);
+        auto argsEnd = argsStart;
+        BuildAnyArgListFromLegacyArgBuffer(fmt, anyArgs, args, &argsEnd);
+        result = FormatStringAny(fmt, anyArgs);
+        if (argsEnd - argsStart > argsLength)
+        {
+            return false;
+        }
+        return std::none_of(
+            anyArgs.begin(), anyArgs.end(), [](const FormatArg_t& arg) { return std::holds_alternative<const char*>(arg); });
+    }
+
     static void FormatMonthYear(FormatBuffer& ss, int32_t month, int32_t year)
     {
         thread_local std::vector<FormatArg_t> tempArgs;
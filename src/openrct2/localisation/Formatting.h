@@ -149,9 +149,14 @@ namespace OpenRCT2
 
     class FmtString
     {
+    public:
+        struct token;
+
     private:
         std::string_view _str;
         std::string _strOwned;
+        // Tokens of _str when it has already been tokenised, see GetFmtStringById.
+        const std::vector<token>* _tokens{};
 
     public:
         struct token
@@ -172,12 +177,16 @@ namespace OpenRCT2
         private:
             std::string_view str;
             size_t index;
+            const token* tokens{};
+            size_t tokenCount{};
+            size_t tokenIndex{};
             token current;
 
             void update();
 
         public:
             iterator(std::string_view s, size_t i);
+            iterator(std::string_view s, size_t i, const std::vector<token>& t, size_t ti);
             bool operator==(iterator& rhs);
             bool operator!=(iterator& rhs);
             token CreateToken(size_t len);
@@ -192,6 +201,10 @@ namespace OpenRCT2
         FmtString(std::string&& s);
         FmtString(std::string_view s);
         FmtString(const char* s);
+        /**
+         * Uses tokens that were already read from s, they must stay alive for as long as the string is formatted.
+         */
+        FmtString(std::string_view s, const std::vector<token>& tokens);
         iterator begin() const;
         iterator end() const;
 
@@ -306,4 +319,11 @@ namespace OpenRCT2
     std::string FormatStringAny(const FmtString& fmt, const std::vector<FormatArg_t>& args);
     size_t FormatStringAny(char* buffer, size_t bufferLen, const FmtString& fmt, const std::vector<FormatArg_t>& args);
     size_t FormatStringLegacy(char* buffer, size_t bufferLen, rct_string_id id, const void* args);
+
+    /**
+     * Formats a legacy argument buffer into result.
+     * @return false if any argument is a string pointer or the format reads more than argsLength bytes, the text
+     *         then depends on more than the given argument bytes.
+     */
+    bool FormatStringLegacy(std::string& result, rct_string_id id, const void* args, size_t argsLength);
 } // namespace OpenRCT2
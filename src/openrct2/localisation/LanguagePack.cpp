@@ -10,12 +10,16 @@
 #include "LanguagePack.h"
 
 #include "../common.h"
+#include "../core/File.h"
 #include "../core/FileStream.h"
 #include "../core/Memory.hpp"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
 #include "../core/RTL.h"
 #include "../core/String.hpp"
 #include "../core/StringBuilder.h"
 #include "../core/StringReader.h"
+#include "../platform/Platform2.h"
 #include "Language.h"
 #include "Localisation.h"
 
@@ -35,6 +39,28 @@ constexpr int32_t ObjectOverrideMaxStringCount = 3;
 constexpr rct_string_id ScenarioOverrideBase = 0x7000;
 constexpr int32_t ScenarioOverrideMaxStringCount = 3;
 
+constexpr uint32_t LanguageCacheMagic = 0x4B43504C; // LPCK
+constexpr uint16_t LanguageCacheVersion = 1;
+
+#pragma pack(push, 1)
+/**
+ * Header of a compiled language pack. The cache is only used while the size and modification time of the language file
+ * it was compiled from still match.
+ */
+struct LanguageCacheHeader
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t LanguageId;
+    uint64_t SourceSize;
+    uint64_t SourceLastModified;
+    uint32_t NumStrings;
+    uint32_t NumObjectOverrides;
+    uint32_t NumScenarioOverrides;
+};
+assert_struct_size(LanguageCacheHeader, 36);
+#pragma pack(pop)
+
 struct ObjectOverride
 {
     char name[8] = { 0 };
@@ -97,11 +123,48 @@ public:
         return result;
     }
 
+    /**
+     * Loads the compiled form of the language file from the cache if it is still up to date, otherwise parses the
+     * language file and writes the result to the cache for the next launch.
+     */
+    static std::unique_ptr<LanguagePack> FromFile(uint16_t id, const utf8* path, const std::string& cachePath)
+    {
+        Guard::ArgumentNotNull(path);
+
+        uint64_t sourceSize = 0;
+        uint64_t sourceLastModified = 0;
+        try
+        {
+            sourceSize = Platform::GetFileSize(path);
+            sourceLastModified = File::GetLastModified(path);
+        }
+        catch (const std::exception&)
+        {
+            return FromFile(id, path);
+        }
+
+        auto result = FromCache(id, cachePath, sourceSize, sourceLastModified);
+        if (result == nullptr)
+        {
+            result = FromFile(id, path);
+            if (result != nullptr)
+            {
+                result->WriteCache(cachePath, sourceSize, sourceLastModified);
+            }
+        }
+        return result;
+    }
+
     static std::unique_ptr<LanguagePack> FromText(uint16_t id, const utf8* text)
     {
         return std::make_unique<LanguagePack>(id, text);
     }
 
+    explicit LanguagePack(uint16_t id)
+        : _id(id)
+    {
+    }
+
     LanguagePack(uint16_t id, const utf8* text)
         : _id(id)
     {
@@ -229,6 +292,129 @@ public:
     }
 
 private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Cache
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // The cache holds the strings exactly as they are after parsing, RTL strings already reordered, so loading it is a
+    // straight copy of each string.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    static std::unique_ptr<LanguagePack> FromCache(
+        uint16_t id, const std::string& cachePath, uint64_t sourceSize, uint64_t sourceLastModified)
+    {
+        if (!File::Exists(cachePath))
+        {
+            return nullptr;
+        }
+
+        try
+        {
+            auto data = File::ReadAllBytes(cachePath);
+            auto stream = OpenRCT2::MemoryStream(data.data(), data.size());
+            auto header = stream.ReadValue<LanguageCacheHeader>();
+            if (header.Magic != LanguageCacheMagic || header.Version != LanguageCacheVersion || header.LanguageId != id
+                || header.SourceSize != sourceSize || header.SourceLastModified != sourceLastModified
+                || header.NumObjectOverrides > MAX_OBJECT_OVERRIDES || header.NumScenarioOverrides > MAX_SCENARIO_OVERRIDES)
+            {
+                return nullptr;
+            }
+
+            auto result = std::make_unique<LanguagePack>(id);
+            result->_strings.resize(header.NumStrings);
+            for (auto& str : result->_strings)
+            {
+                str = ReadCacheString(stream);
+            }
+            result->_objectOverrides.resize(header.NumObjectOverrides);
+            for (auto& objectOverride : result->_objectOverrides)
+            {
+                stream.Read(objectOverride.name, sizeof(objectOverride.name));
+                for (auto& str : objectOverride.strings)
+                {
+                    str = ReadCacheString(stream);
+                }
+            }
+            result->_scenarioOverrides.resize(header.NumScenarioOverrides);
+            for (auto& scenarioOverride : result->_scenarioOverrides)
+            {
+                scenarioOverride.filename = ReadCacheString(stream);
+                for (auto& str : scenarioOverride.strings)
+                {
+                    str = ReadCacheString(stream);
+                }
+            }
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to read language cache %s: %s", cachePath.c_str(), e.what());
+            return nullptr;
+        }
+    }
+
+    void WriteCache(const std::string& cachePath, uint64_t sourceSize, uint64_t sourceLastModified) const
+    {
+        try
+        {
+            Path::CreateDirectory(Path::GetDirectory(cachePath));
+            auto fs = OpenRCT2::FileStream(cachePath, OpenRCT2::FILE_MODE_WRITE);
+
+            LanguageCacheHeader header{};
+            header.Magic = LanguageCacheMagic;
+            header.Version = LanguageCacheVersion;
+            header.LanguageId = _id;
+            header.SourceSize = sourceSize;
+            header.SourceLastModified = sourceLastModified;
+            header.NumStrings = static_cast<uint32_t>(_strings.size());
+            header.NumObjectOverrides = static_cast<uint32_t>(_objectOverrides.size());
+            header.NumScenarioOverrides = static_cast<uint32_t>(_scenarioOverrides.size());
+            fs.WriteValue(header);
+
+            for (const auto& str : _strings)
+            {
+                WriteCacheString(fs, str);
+            }
+            for (const auto& objectOverride : _objectOverrides)
+            {
+                fs.Write(objectOverride.name, sizeof(objectOverride.name));
+                for (const auto& str : objectOverride.strings)
+                {
+                    WriteCacheString(fs, str);
+                }
+            }
+            for (const auto& scenarioOverride : _scenarioOverrides)
+            {
+                WriteCacheString(fs, scenarioOverride.filename);
+                for (const auto& str : scenarioOverride.strings)
+                {
+                    WriteCacheString(fs, str);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to write language cache %s: %s", cachePath.c_str(), e.what());
+        }
+    }
+
+    static std::string ReadCacheString(OpenRCT2::IStream& stream)
+    {
+        auto length = stream.ReadValue<uint32_t>();
+        if (length > stream.GetLength() - stream.GetPosition())
+        {
+            throw IOException("Language cache is truncated.");
+        }
+        std::string result(length, '\0');
+        stream.Read(result.data(), length);
+        return result;
+    }
+
+    static void WriteCacheString(OpenRCT2::IStream& stream, const std::string& str)
+    {
+        stream.WriteValue(static_cast<uint32_t>(str.size()));
+        stream.Write(str.data(), str.size());
+    }
+
     ObjectOverride* GetObjectOverride(const std::string& objectIdentifier)
     {
         for (auto& oo : _objectOverrides)
@@ -580,6 +766,12 @@ namespace LanguagePackFactory
         return languagePack;
     }
 
+    std::unique_ptr<ILanguagePack> FromFile(uint16_t id, const utf8* path, const std::string& cachePath)
+    {
+        auto languagePack = LanguagePack::FromFile(id, path, cachePath);
+        return languagePack;
+    }
+
     std::unique_ptr<ILanguagePack> FromText(uint16_t id, const utf8* text)
     {
         auto languagePack = LanguagePack::FromText(id, text);
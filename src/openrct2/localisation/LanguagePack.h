@@ -32,5 +32,10 @@ struct ILanguagePack
 namespace LanguagePackFactory
 {
     std::unique_ptr<ILanguagePack> FromFile(uint16_t id, const utf8* path);
+    /**
+     * Same as FromFile, but loads a compiled copy of the language from cachePath when it matches the file, and writes
+     * one there when it does not.
+     */
+    std::unique_ptr<ILanguagePack> FromFile(uint16_t id, const utf8* path, const std::string& cachePath);
     std::unique_ptr<ILanguagePack> FromText(uint16_t id, const utf8* text);
 } // namespace LanguagePackFactory
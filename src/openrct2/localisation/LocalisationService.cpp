@@ -84,6 +84,14 @@ std::string LocalisationService::GetLanguagePath(uint32_t languageId) const
     return languagePath;
 }
 
+std::string LocalisationService::GetLanguageCachePath(uint32_t languageId) const
+{
+    // Kept next to the object index, which shares the same cache directory on every platform.
+    auto locale = std::string(LanguagesDescriptors[languageId].locale);
+    auto cacheDirectory = Path::GetDirectory(_env->GetFilePath(PATHID::CACHE_OBJECTS));
+    return Path::Combine(cacheDirectory, "languages", locale + ".idx");
+}
+
 void LocalisationService::OpenLanguage(int32_t id)
 {
     CloseLanguages();
@@ -96,11 +104,12 @@ void LocalisationService::OpenLanguage(int32_t id)
     if (id != LANGUAGE_ENGLISH_UK)
     {
         filename = GetLanguagePath(LANGUAGE_ENGLISH_UK);
-        _languageFallback = LanguagePackFactory::FromFile(LANGUAGE_ENGLISH_UK, filename.c_str());
+        _languageFallback = LanguagePackFactory::FromFile(
+            LANGUAGE_ENGLISH_UK, filename.c_str(), GetLanguageCachePath(LANGUAGE_ENGLISH_UK));
     }
 
     filename = GetLanguagePath(id);
-    _languageCurrent = LanguagePackFactory::FromFile(id, filename.c_str());
+    _languageCurrent = LanguagePackFactory::FromFile(id, filename.c_str(), GetLanguageCachePath(id));
     if (_languageCurrent != nullptr)
     {
         _currentLanguage = id;
@@ -117,6 +126,7 @@ void LocalisationService::CloseLanguages()
     _languageFallback = nullptr;
     _languageCurrent = nullptr;
     _currentLanguage = LANGUAGE_UNDEFINED;
+    _stringsVersion++;
 }
 
 std::tuple<rct_string_id, rct_string_id, rct_string_id> LocalisationService::GetLocalisedScenarioStrings(
@@ -153,6 +163,7 @@ rct_string_id LocalisationService::AllocateObjectString(const std::string& targe
         _objectStrings.resize(index + 1);
     }
     _objectStrings[index] = target;
+    _stringsVersion++;
 
     return stringId;
 }
@@ -167,6 +178,7 @@ void LocalisationService::FreeObjectString(rct_string_id stringId)
             _objectStrings[index] = {};
         }
         _availableObjectStringIds.push(stringId);
+        _stringsVersion++;
     }
 }
 
@@ -38,6 +38,7 @@ namespace OpenRCT2::Localisation
         std::unique_ptr<ILanguagePack> _languageCurrent;
         std::stack<rct_string_id> _availableObjectStringIds;
         std::vector<std::string> _objectStrings;
+        uint32_t _stringsVersion{};
 
     public:
         int32_t GetCurrentLanguage() const
@@ -51,6 +52,14 @@ namespace OpenRCT2::Localisation
         void UseTrueTypeFont(bool value)
         {
             _useTrueTypeFont = value;
+            _stringsVersion++;
+        }
+        /**
+         * Changes whenever the text behind a string id or the font used to draw it may have changed.
+         */
+        uint32_t GetStringsVersion() const
+        {
+            return _stringsVersion;
         }
 
         LocalisationService(const std::shared_ptr<IPlatformEnvironment>& env);
@@ -61,6 +70,7 @@ namespace OpenRCT2::Localisation
             const std::string& scenarioFilename) const;
         rct_string_id GetObjectOverrideStringId(std::string_view legacyIdentifier, uint8_t index) const;
         std::string GetLanguagePath(uint32_t languageId) const;
+        std::string GetLanguageCachePath(uint32_t languageId) const;
 
         void OpenLanguage(int32_t id);
         void CloseLanguages();
@@ -3922,6 +3922,23 @@ enum : uint16_t
     STR_TILE_INSPECTOR_DIRECTION_SHORT = 6460,
     STR_TILE_INSPECTOR_DIRECTION = 6461,
 
+    STR_DEBUG_PAINT_ENTRY_USAGE = 6462,
+
+    STR_MULTIPLAYER_CATCHING_UP = 6463,
+
+    STR_DEBUG_PAINT_SHOW_WINDOW_REPAINTS = 6464,
+
+    STR_SHORTCUT_DEBUG_PERFORMANCE_TOGGLE = 6465,
+    STR_DEBUG_DROPDOWN_PERFORMANCE = 6466,
+    STR_PERFORMANCE_TICK_TIMES = 6467,
+    STR_PERFORMANCE_FRAME_TIMES = 6468,
+    STR_PERFORMANCE_JOB_POOLS = 6469,
+    STR_PERFORMANCE_NETWORK = 6470,
+    STR_PERFORMANCE_TICK_PART = 6471,
+    STR_PERFORMANCE_ENTITY_COUNT = 6472,
+    STR_PERFORMANCE_DIRTY_BLOCKS = 6473,
+    STR_MULTIPLAYER_RESYNCHRONISING = 6474,
+
     // Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
     /* MAX_STR_COUNT = 32768 */ // MAX_STR_COUNT - upper limit for number of strings, not the current count strings
 };
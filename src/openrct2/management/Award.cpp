@@ -79,6 +79,14 @@ bool award_is_positive(AwardType type)
 
 #pragma region Award checks
 
+/** Guests in the park freshly thinking about litter, disgusting paths or vandalism. */
+static uint32_t award_count_untidy_thoughts(const GuestStatistics& guestStats)
+{
+    return guestStats.GetFreshThoughtCount(PeepThoughtType::BadLitter)
+        + guestStats.GetFreshThoughtCount(PeepThoughtType::PathDisgusting)
+        + guestStats.GetFreshThoughtCount(PeepThoughtType::Vandalism);
+}
+
 /** More than 1/16 of the total guests must be thinking untidy thoughts. */
 static bool award_is_deserved_most_untidy(int32_t activeAwardTypes)
 {
@@ -89,22 +97,8 @@ static bool award_is_deserved_most_untidy(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(AwardType::MostTidy))
         return false;
 
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness > 5)
-            continue;
-
-        if (thought.type == PeepThoughtType::BadLitter || thought.type == PeepThoughtType::PathDisgusting
-            || thought.type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
+    auto guestStats = GuestStatistics::Collect();
+    uint32_t negativeCount = award_count_untidy_thoughts(guestStats);
 
     return (negativeCount > gNumGuestsInPark / 16);
 }
@@ -117,26 +111,9 @@ static bool award_is_deserved_most_tidy(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(AwardType::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness > 5)
-            continue;
-
-        if (thought.type == PeepThoughtType::VeryClean)
-            positiveCount++;
-
-        if (thought.type == PeepThoughtType::BadLitter || thought.type == PeepThoughtType::PathDisgusting
-            || thought.type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
+    auto guestStats = GuestStatistics::Collect();
+    uint32_t positiveCount = guestStats.GetFreshThoughtCount(PeepThoughtType::VeryClean);
+    uint32_t negativeCount = award_count_untidy_thoughts(guestStats);
 
     return (negativeCount <= 5 && positiveCount > gNumGuestsInPark / 64);
 }
@@ -197,27 +174,9 @@ static bool award_is_deserved_most_beautiful(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(AwardType::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    auto list = EntityList<Guest>();
-    for (auto peep : list)
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness > 5)
-            continue;
-
-        if (thought.type == PeepThoughtType::Scenery)
-            positiveCount++;
-
-        if (thought.type == PeepThoughtType::BadLitter || thought.type == PeepThoughtType::PathDisgusting
-            || thought.type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
+    auto guestStats = GuestStatistics::Collect();
+    uint32_t positiveCount = guestStats.GetFreshThoughtCount(PeepThoughtType::Scenery);
+    uint32_t negativeCount = award_count_untidy_thoughts(guestStats);
 
     return (negativeCount <= 15 && positiveCount > gNumGuestsInPark / 128);
 }
@@ -241,16 +200,7 @@ static bool award_is_deserved_worst_value(int32_t activeAwardTypes)
 /** No more than 2 people who think the vandalism is bad and no crashes. */
 static bool award_is_deserved_safest([[maybe_unused]] int32_t activeAwardTypes)
 {
-    auto peepsWhoDislikeVandalism = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Vandalism)
-            peepsWhoDislikeVandalism++;
-    }
+    auto peepsWhoDislikeVandalism = GuestStatistics::Collect().GetFreshThoughtCount(PeepThoughtType::Vandalism);
 
     if (peepsWhoDislikeVandalism > 2)
         return false;
@@ -311,16 +261,7 @@ static bool award_is_deserved_best_food(int32_t activeAwardTypes)
         return false;
 
     // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Hungry)
-            hungryPeeps++;
-    }
+    auto hungryPeeps = GuestStatistics::Collect().GetFreshThoughtCount(PeepThoughtType::Hungry);
     return (hungryPeeps <= 12);
 }
 
@@ -356,16 +297,7 @@ static bool award_is_deserved_worst_food(int32_t activeAwardTypes)
         return false;
 
     // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Hungry)
-            hungryPeeps++;
-    }
+    auto hungryPeeps = GuestStatistics::Collect().GetFreshThoughtCount(PeepThoughtType::Hungry);
     return (hungryPeeps > 15);
 }
 
@@ -387,16 +319,7 @@ static bool award_is_deserved_best_restrooms([[maybe_unused]] int32_t activeAwar
         return false;
 
     // Count number of guests who are thinking they need the restroom
-    auto guestsWhoNeedRestroom = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Toilet)
-            guestsWhoNeedRestroom++;
-    }
+    auto guestsWhoNeedRestroom = GuestStatistics::Collect().GetFreshThoughtCount(PeepThoughtType::Toilet);
     return (guestsWhoNeedRestroom <= 16);
 }
 
@@ -518,18 +441,10 @@ static bool award_is_deserved_most_dazzling_ride_colours(int32_t activeAwardType
 /** At least 10 peeps and more than 1/64 of total guests are lost or can't find something. */
 static bool award_is_deserved_most_confusing_layout([[maybe_unused]] int32_t activeAwardTypes)
 {
-    uint32_t peepsCounted = 0;
-    uint32_t peepsLost = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        peepsCounted++;
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && (thought.type == PeepThoughtType::Lost || thought.type == PeepThoughtType::CantFind))
-            peepsLost++;
-    }
+    auto guestStats = GuestStatistics::Collect();
+    uint32_t peepsCounted = guestStats.GuestsInPark;
+    uint32_t peepsLost = guestStats.GetFreshThoughtCount(PeepThoughtType::Lost)
+        + guestStats.GetFreshThoughtCount(PeepThoughtType::CantFind);
 
     return (peepsLost >= 10 && peepsLost >= peepsCounted / 64);
 }
@@ -45,9 +45,9 @@ money64 gCurrentProfit;
 money64 gHistoricalProfit;
 money64 gWeeklyProfitAverageDividend;
 uint16_t gWeeklyProfitAverageDivisor;
-money64 gCashHistory[FINANCE_GRAPH_SIZE];
-money64 gWeeklyProfitHistory[FINANCE_GRAPH_SIZE];
-money64 gParkValueHistory[FINANCE_GRAPH_SIZE];
+MoneyHistory gCashHistory;
+MoneyHistory gWeeklyProfitHistory;
+MoneyHistory gParkValueHistory;
 money64 gExpenditureTable[EXPENDITURE_TABLE_MONTH_COUNT][static_cast<int32_t>(ExpenditureType::Count)];
 
 /**
@@ -184,12 +184,9 @@ void finance_pay_ride_upkeep()
 
 void finance_reset_history()
 {
-    for (int32_t i = 0; i < FINANCE_GRAPH_SIZE; i++)
-    {
-        gCashHistory[i] = MONEY64_UNDEFINED;
-        gWeeklyProfitHistory[i] = MONEY64_UNDEFINED;
-        gParkValueHistory[i] = MONEY64_UNDEFINED;
-    }
+    gCashHistory.Fill(MONEY64_UNDEFINED);
+    gWeeklyProfitHistory.Fill(MONEY64_UNDEFINED);
+    gParkValueHistory.Fill(MONEY64_UNDEFINED);
 }
 
 /**
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/HistoryBuffer.h"
 #include "Research.h"
 
 enum class ExpenditureType : int32_t
@@ -33,6 +34,8 @@ enum class ExpenditureType : int32_t
 
 #define EXPENDITURE_TABLE_MONTH_COUNT 16
 #define FINANCE_GRAPH_SIZE 128
+// Only the most recent part of the history is shown by the finance graphs
+#define FINANCE_GRAPH_VISIBLE_SIZE 64
 
 extern const money32 research_cost_table[RESEARCH_FUNDING_COUNT];
 
@@ -52,9 +55,11 @@ extern money64 gHistoricalProfit;
 
 extern money64 gWeeklyProfitAverageDividend;
 extern uint16_t gWeeklyProfitAverageDivisor;
-extern money64 gCashHistory[FINANCE_GRAPH_SIZE];
-extern money64 gWeeklyProfitHistory[FINANCE_GRAPH_SIZE];
-extern money64 gParkValueHistory[FINANCE_GRAPH_SIZE];
+using MoneyHistory = HistoryBuffer<money64, FINANCE_GRAPH_SIZE, MONEY64_UNDEFINED, FINANCE_GRAPH_VISIBLE_SIZE>;
+
+extern MoneyHistory gCashHistory;
+extern MoneyHistory gWeeklyProfitHistory;
+extern MoneyHistory gParkValueHistory;
 extern money64 gExpenditureTable[EXPENDITURE_TABLE_MONTH_COUNT][static_cast<int32_t>(ExpenditureType::Count)];
 
 bool finance_check_money_required(uint32_t flags);
@@ -56,7 +56,10 @@ News::Item* News::GetItem(int32_t index)
 
 News::Item& News::ItemQueues::operator[](size_t index)
 {
-    return const_cast<News::Item&>(const_cast<const News::ItemQueues&>(*this)[index]);
+    if (index < Recent.capacity())
+        return Recent[index];
+
+    return Archived[index - Recent.capacity()];
 }
 
 const News::Item& News::ItemQueues::operator[](size_t index) const
@@ -69,7 +72,12 @@ const News::Item& News::ItemQueues::operator[](size_t index) const
 
 News::Item* News::ItemQueues::At(int32_t index)
 {
-    return const_cast<News::Item*>(const_cast<const News::ItemQueues&>(*this).At(index));
+    if (News::IsValidIndex(index))
+    {
+        return &(*this)[index];
+    }
+
+    return nullptr;
 }
 
 const News::Item* News::ItemQueues::At(int32_t index) const
@@ -289,13 +297,12 @@ News::Item* News::ItemQueues::FirstOpenOrNewSlot()
         ArchiveCurrent();
     }
 
-    auto res = Recent.end();
+    auto index = Recent.size();
     // The for loop above guarantees there is always an extra element to use
-    assert(Recent.capacity() - Recent.size() >= 2);
-    auto newsItem = res + 1;
-    newsItem->Type = News::ItemType::Null;
+    assert(Recent.capacity() - index >= 2);
+    Recent[index + 1].Type = News::ItemType::Null;
 
-    return &*res;
+    return &Recent[index];
 }
 
 /**
@@ -116,43 +116,95 @@ namespace News
     constexpr int32_t MaxItemsArchive = 50;
     constexpr int32_t MaxItems = News::ItemHistoryStart + News::MaxItemsArchive;
 
+    /**
+     * A fixed size ring buffer of news items. Like the original array, the items are read up to the first empty one,
+     * but archiving the front item moves the start of the buffer instead of shifting every item down.
+     */
     template<std::size_t N> class ItemQueue
     {
+        template<typename TQueue, typename TItem> class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = News::Item;
+            using difference_type = std::ptrdiff_t;
+            using pointer = TItem*;
+            using reference = TItem&;
+
+            Iterator(TQueue* queue, size_t index)
+                : _queue(queue)
+                , _index(index)
+            {
+            }
+
+            reference operator*() const
+            {
+                return _queue->Queue[(_queue->Head + _index) % N];
+            }
+            pointer operator->() const
+            {
+                return &**this;
+            }
+            Iterator& operator++()
+            {
+                _index++;
+                return *this;
+            }
+            Iterator operator++(int)
+            {
+                auto result = *this;
+                _index++;
+                return result;
+            }
+            bool operator==(const Iterator& rhs) const
+            {
+                return _index == rhs._index;
+            }
+            bool operator!=(const Iterator& rhs) const
+            {
+                return _index != rhs._index;
+            }
+
+        private:
+            TQueue* _queue;
+            size_t _index;
+        };
+
     public:
         static_assert(N > 0, "Cannot instantiate News::ItemQueue with size=0");
 
-        using value_type = typename std::array<News::Item, N>::value_type;
+        using value_type = News::Item;
         using pointer = value_type*;
         using const_pointer = const value_type*;
         using reference = value_type&;
         using const_reference = const value_type&;
-        using iterator = typename std::array<News::Item, N>::iterator;
-        using const_iterator = typename std::array<News::Item, N>::const_iterator;
+        using iterator = Iterator<ItemQueue, News::Item>;
+        using const_iterator = Iterator<const ItemQueue, const News::Item>;
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
-        using reverse_iterator = std::reverse_iterator<iterator>;
-        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
         ItemQueue()
         {
-            std::get<0>(Queue).Type = News::ItemType::Null;
+            clear();
         }
 
-        constexpr iterator begin() noexcept
+        iterator begin() noexcept
         {
-            return std::begin(Queue);
+            // Items may be edited through the iterator, including being emptied.
+            CountValid = false;
+            return iterator(this, 0);
         }
-        constexpr const_iterator begin() const noexcept
+        const_iterator begin() const noexcept
         {
             return cbegin();
         }
-        constexpr const_iterator cbegin() const noexcept
+        const_iterator cbegin() const noexcept
         {
-            return std::cbegin(Queue);
+            return const_iterator(this, 0);
         }
         iterator end() noexcept
         {
-            return std::find_if(std::begin(Queue), std::end(Queue), [](const_reference item) { return item.IsEmpty(); });
+            return iterator(this, size());
         }
         const_iterator end() const noexcept
         {
@@ -160,67 +212,72 @@ namespace News
         }
         const_iterator cend() const noexcept
         {
-            return std::find_if(std::cbegin(Queue), std::cend(Queue), [](const_reference item) { return item.IsEmpty(); });
+            return const_iterator(this, size());
         }
 
-        constexpr bool empty() const noexcept
+        bool empty() const noexcept
         {
-            return std::get<0>(Queue).IsEmpty();
+            return (*this)[0].IsEmpty();
         }
 
         size_type size() const noexcept
         {
-            return std::distance(cbegin(), cend());
+            if (!CountValid)
+            {
+                Count = 0;
+                while (Count < N && !(*this)[Count].IsEmpty())
+                {
+                    Count++;
+                }
+                CountValid = true;
+            }
+            return Count;
         }
 
         reference front() noexcept
         {
-            return *begin();
+            return Queue[Head];
         }
         const_reference front() const noexcept
         {
-            return *cbegin();
-        }
-        reference back() noexcept
-        {
-            return *end();
-        }
-        const_reference back() const noexcept
-        {
-            return *cend();
+            return (*this)[0];
         }
 
         void pop_front()
         {
-            std::move(std::begin(Queue) + 1, std::end(Queue), std::begin(Queue));
-            Queue[N - 1].Type = News::ItemType::Null;
+            Queue[Head].Type = News::ItemType::Null;
+            Head = (Head + 1) % N;
+            if (CountValid && Count > 0)
+            {
+                Count--;
+            }
         }
 
         void push_back(const_reference item)
         {
-            auto it = end();
-            if (!std::distance(it, std::end(Queue)))
+            if (size() == N)
             {
                 // Reached queue max size, need to free some space
                 pop_front();
-                Queue[N - 1] = item;
             }
-            else
+            auto index = size();
+            Queue[(Head + index) % N] = item;
+            if (index + 1 < N)
             {
-                *it = item;
-                ++it;
-                if (std::distance(it, std::end(Queue)))
-                    it->Type = News::ItemType::Null;
+                Queue[(Head + index + 1) % N].Type = News::ItemType::Null;
             }
+            Count = index + 1;
         }
 
         reference operator[](size_type n) noexcept
         {
-            return Queue[n];
+            // The item may be filled in or emptied by the caller.
+            CountValid = false;
+            return Queue[(Head + n) % N];
         }
         const_reference operator[](size_type n) const noexcept
         {
-            return Queue[n];
+            return Queue[(Head + n) % N];
         }
 
         constexpr size_type capacity() const noexcept
@@ -230,11 +287,21 @@ namespace News
 
         void clear() noexcept
         {
-            front().Type = News::ItemType::Null;
+            for (auto& item : Queue)
+            {
+                item.Type = News::ItemType::Null;
+            }
+            Head = 0;
+            Count = 0;
+            CountValid = true;
         }
 
     private:
         std::array<News::Item, N> Queue;
+        size_type Head{};
+        // Number of items before the first empty one, recounted after an item was handed out for editing.
+        mutable size_type Count{};
+        mutable bool CountValid{};
     };
 
     struct ItemQueues
@@ -35,7 +35,9 @@
 #include "NewsItem.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <unordered_set>
 
 using namespace OpenRCT2;
 
@@ -67,6 +69,59 @@ static bool _researchedSceneryItems[SCENERY_TYPE_COUNT][UINT16_MAX];
 
 bool gSilentResearch = false;
 
+// Indexes of the two research lists, so checking whether an item is listed or whether a scenery group is still
+// uninvented does not need to walk them. Changes made by this file keep them up to date item by item, anything that
+// edits the lists in bulk or from outside marks them stale and they are rebuilt on the next lookup.
+static std::unordered_set<uint32_t> _researchItemKeys;
+static std::array<uint16_t, MAX_SCENERY_GROUP_OBJECTS> _uninventedSceneryGroupCounts;
+static bool _researchIndexValid = false;
+
+static uint32_t ResearchItemKey(const ResearchItem& item)
+{
+    return (EnumValue(item.type) << 24) | (item.baseRideType << 16) | item.entryIndex;
+}
+
+static void ResearchIndexAdd(const ResearchItem& item, bool researched)
+{
+    _researchItemKeys.insert(ResearchItemKey(item));
+    if (!researched && item.type == Research::EntryType::Scenery && item.entryIndex < MAX_SCENERY_GROUP_OBJECTS)
+    {
+        _uninventedSceneryGroupCounts[item.entryIndex]++;
+    }
+}
+
+static void ResearchIndexMarkResearched(const ResearchItem& item)
+{
+    if (item.type == Research::EntryType::Scenery && item.entryIndex < MAX_SCENERY_GROUP_OBJECTS
+        && _uninventedSceneryGroupCounts[item.entryIndex] > 0)
+    {
+        _uninventedSceneryGroupCounts[item.entryIndex]--;
+    }
+}
+
+static void ResearchEnsureIndex()
+{
+    if (_researchIndexValid)
+        return;
+
+    _researchItemKeys.clear();
+    _uninventedSceneryGroupCounts.fill(0);
+    for (const auto& researchItem : gResearchItemsUninvented)
+    {
+        ResearchIndexAdd(researchItem, false);
+    }
+    for (const auto& researchItem : gResearchItemsInvented)
+    {
+        ResearchIndexAdd(researchItem, true);
+    }
+    _researchIndexValid = true;
+}
+
+void ResearchInvalidateIndex()
+{
+    _researchIndexValid = false;
+}
+
 /**
  *
  *  rct2: 0x006671AD, part of 0x00667132
@@ -75,6 +130,7 @@ void research_reset_items()
 {
     gResearchItemsUninvented.clear();
     gResearchItemsInvented.clear();
+    ResearchInvalidateIndex();
 }
 
 /**
@@ -181,6 +237,7 @@ static void research_next_design()
     gResearchProgressStage = RESEARCH_STAGE_DESIGNING;
 
     gResearchItemsUninvented.erase(it);
+    ResearchIndexMarkResearched(researchItem);
     gResearchItemsInvented.push_back(std::move(researchItem));
 
     research_invalidate_related_windows();
@@ -404,6 +461,7 @@ static void research_insert_unresearched(ResearchItem&& item)
         return;
     }
 
+    ResearchIndexAdd(item, false);
     gResearchItemsUninvented.push_back(std::move(item));
 }
 
@@ -419,6 +477,7 @@ static void research_insert_researched(ResearchItem&& item)
         return;
     }
 
+    ResearchIndexAdd(item, true);
     gResearchItemsInvented.push_back(std::move(item));
 }
 
@@ -428,6 +487,8 @@ static void research_insert_researched(ResearchItem&& item)
  */
 void ResearchRemove(const ResearchItem& researchItem)
 {
+    // The item may be listed more than once, so the index is rebuilt rather than updated.
+    ResearchInvalidateIndex();
     for (auto it = gResearchItemsUninvented.begin(); it != gResearchItemsUninvented.end(); it++)
     {
         auto& researchItem2 = *it;
@@ -618,10 +679,8 @@ bool scenery_group_is_invented(int32_t sgIndex)
         return true;
     }
 
-    return std::none_of(
-        std::begin(gResearchItemsUninvented), std::end(gResearchItemsUninvented), [sgIndex](const ResearchItem& item) {
-            return item.type == Research::EntryType::Scenery && item.entryIndex == sgIndex;
-        });
+    ResearchEnsureIndex();
+    return sgIndex < 0 || sgIndex >= MAX_SCENERY_GROUP_OBJECTS || _uninventedSceneryGroupCounts[sgIndex] == 0;
 }
 
 void scenery_group_set_invented(int32_t sgIndex)
@@ -747,6 +806,7 @@ static void ResearchRemoveNullItems(std::vector<ResearchItem>& items)
         }
     });
     items.erase(it, std::end(items));
+    ResearchInvalidateIndex();
 }
 
 static void research_mark_item_as_researched(const ResearchItem& item)
@@ -825,6 +885,9 @@ static void ResearchAddAllMissingItems(bool isResearched)
 
 void ResearchFix()
 {
+    // The lists may have been replaced by loading a park.
+    ResearchInvalidateIndex();
+
     // Remove null entries from the research list
     ResearchRemoveNullItems(gResearchItemsInvented);
     ResearchRemoveNullItems(gResearchItemsUninvented);
@@ -844,6 +907,7 @@ void research_items_make_all_unresearched()
         gResearchItemsUninvented.end(), std::make_move_iterator(gResearchItemsInvented.begin()),
         std::make_move_iterator(gResearchItemsInvented.end()));
     gResearchItemsInvented.clear();
+    ResearchInvalidateIndex();
 }
 
 void research_items_make_all_researched()
@@ -852,6 +916,7 @@ void research_items_make_all_researched()
         gResearchItemsInvented.end(), std::make_move_iterator(gResearchItemsUninvented.begin()),
         std::make_move_iterator(gResearchItemsUninvented.end()));
     gResearchItemsUninvented.clear();
+    ResearchInvalidateIndex();
 }
 
 /**
@@ -880,21 +945,8 @@ void ResearchItem::SetNull()
 
 bool ResearchItem::Exists() const
 {
-    for (auto const& researchItem : gResearchItemsUninvented)
-    {
-        if (researchItem == *this)
-        {
-            return true;
-        }
-    }
-    for (auto const& researchItem : gResearchItemsInvented)
-    {
-        if (researchItem == *this)
-        {
-            return true;
-        }
-    }
-    return false;
+    ResearchEnsureIndex();
+    return _researchItemKeys.find(ResearchItemKey(*this)) != _researchItemKeys.end();
 }
 
 // clang-format off
@@ -132,6 +132,8 @@ void research_populate_list_random();
 void research_finish_item(ResearchItem* researchItem);
 void research_insert(ResearchItem&& item, bool researched);
 void ResearchRemove(const ResearchItem& researchItem);
+// Must be called after editing gResearchItemsUninvented or gResearchItemsInvented directly.
+void ResearchInvalidateIndex();
 
 bool research_insert_ride_entry(uint8_t rideType, ObjectEntryIndex entryIndex, ResearchCategory category, bool researched);
 void research_insert_ride_entry(ObjectEntryIndex entryIndex, bool researched);
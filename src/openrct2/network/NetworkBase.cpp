@@ -20,6 +20,7 @@
 #include "../core/File.h"
 #include "../core/Guard.hpp"
 #include "../core/Json.hpp"
+#include "../core/Profiler.h"
 #include "../entity/EntityList.h"
 #include "../entity/EntityRegistry.h"
 #include "../entity/EntityTweener.h"
@@ -42,7 +43,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "10"
+#define NETWORK_STREAM_VERSION "15"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -58,12 +59,23 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 // This limit is per connection, the current value was determined by tests with fuzzing.
 static constexpr uint32_t MaxPacketsPerUpdate = 100;
 
+// Spectators of a relay are not players of the server, their number is only limited by the relay.
+static constexpr size_t MaxRelaySpectators = 1024;
+
+// Exporting the park for a resynchronisation takes a while on large parks, a client can only ask for one this often.
+static constexpr uint32_t ResyncCooldownMilliseconds = 10000;
+
+// The pieces a client asks for have to fit in one packet, past this many ranges it might as well ask for all of them.
+static constexpr size_t MaxResyncPieceRanges = 4096;
+
 #    include "../Cheats.h"
 #    include "../ParkImporter.h"
 #    include "../Version.h"
 #    include "../actions/GameAction.h"
 #    include "../config/Config.h"
 #    include "../core/Console.hpp"
+#    include "../core/ContentSplitter.h"
+#    include "../core/Crypt.h"
 #    include "../core/FileStream.h"
 #    include "../core/MemoryStream.h"
 #    include "../core/Path.hpp"
@@ -91,13 +103,15 @@ static constexpr uint32_t MaxPacketsPerUpdate = 100;
 #    include <array>
 #    include <cerrno>
 #    include <cmath>
-#    include <fstream>
+#    include <cstring>
 #    include <functional>
 #    include <list>
 #    include <map>
 #    include <memory>
+#    include <optional>
 #    include <set>
 #    include <string>
+#    include <unordered_map>
 #    include <vector>
 
 using namespace OpenRCT2;
@@ -135,6 +149,8 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     client_command_handlers[NetworkCommand::ObjectsList] = &NetworkBase::Client_Handle_OBJECTS_LIST;
     client_command_handlers[NetworkCommand::Scripts] = &NetworkBase::Client_Handle_SCRIPTS;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::ResyncManifest] = &NetworkBase::Client_Handle_RESYNC_MANIFEST;
+    client_command_handlers[NetworkCommand::ResyncPieces] = &NetworkBase::Client_Handle_RESYNC_PIECES;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::Server_Handle_AUTH;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::Server_Handle_CHAT;
@@ -145,9 +161,16 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Server_Handle_MAPREQUEST;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::Server_Handle_REQUEST_GAMESTATE;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
+    server_command_handlers[NetworkCommand::ResyncRequest] = &NetworkBase::Server_Handle_RESYNC_REQUEST;
+    server_command_handlers[NetworkCommand::ResyncPieceRequest] = &NetworkBase::Server_Handle_RESYNC_PIECE_REQUEST;
+
+    relay_command_handlers[NetworkCommand::Auth] = &NetworkBase::Relay_Handle_AUTH;
+    relay_command_handlers[NetworkCommand::GameAction] = &NetworkBase::Relay_Handle_GAME_ACTION;
+    relay_command_handlers[NetworkCommand::GameInfo] = &NetworkBase::Relay_Handle_GAMEINFO;
+    relay_command_handlers[NetworkCommand::Token] = &NetworkBase::Server_Handle_TOKEN;
+    relay_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Relay_Handle_MAPREQUEST;
+    relay_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
 
-    _chat_log_fs << std::unitbuf;
-    _server_log_fs << std::unitbuf;
 }
 
 bool NetworkBase::Init()
@@ -174,7 +197,10 @@ void NetworkBase::Reconnect()
         _requireReconnect = true;
         return;
     }
-    BeginClient(_host, _port);
+    if (BeginClient(_host, _port) && _relayPort != 0)
+    {
+        BeginRelay(_relayPort, _relayAddress);
+    }
 }
 
 void NetworkBase::Close()
@@ -192,7 +218,9 @@ void NetworkBase::Close()
 
         CloseChatLog();
         CloseServerLog();
+        diagnostic_set_async_output(false);
         CloseConnection();
+        CloseRelay();
 
         client_connection_list.clear();
         GameActions::ClearQueue();
@@ -202,6 +230,7 @@ void NetworkBase::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        _packedObjectDataCache.clear();
 
         gfx_invalidate_screen();
 
@@ -266,6 +295,7 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
     status = NETWORK_STATUS_CONNECTING;
     _lastConnectStatus = SocketStatus::Closed;
     _clientMapLoaded = false;
+    _resyncing = false;
     _serverTickData.clear();
 
     BeginChatLog();
@@ -380,6 +410,12 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
     BeginChatLog();
     BeginServerLog();
 
+    // Dedicated servers log every join and action, writing to the console must not hold up the game.
+    if (gOpenRCT2Headless)
+    {
+        diagnostic_set_async_output(true);
+    }
+
     NetworkPlayer* player = AddPlayer(gConfigNetwork.player_name, "");
     player->Flags |= NETWORK_PLAYER_FLAG_ISSERVER;
     player->Group = 0;
@@ -471,6 +507,10 @@ void NetworkBase::Update()
             break;
         case NETWORK_MODE_CLIENT:
             UpdateClient();
+            if (_relayListenSocket != nullptr)
+            {
+                UpdateRelay();
+            }
             break;
     }
 
@@ -491,6 +531,10 @@ void NetworkBase::Flush()
     if (GetMode() == NETWORK_MODE_CLIENT)
     {
         _serverConnection->SendQueuedPackets();
+        for (auto& spectator : _spectatorConnections)
+        {
+            spectator->SendQueuedPackets();
+        }
     }
     else
     {
@@ -503,13 +547,25 @@ void NetworkBase::Flush()
 
 void NetworkBase::UpdateServer()
 {
+    // Only receive from the connections that have something pending.
+    _clientSockets.clear();
     for (auto& connection : client_connection_list)
     {
+        _clientSockets.push_back(connection->Socket.get());
+    }
+    GetReadableTcpSockets(_clientSockets, _clientSocketsReadable);
+
+    _shareMapSnapshots = true;
+    size_t connectionIndex = 0;
+    for (auto& connection : client_connection_list)
+    {
+        const bool socketReadable = _clientSocketsReadable[connectionIndex++];
+
         // This can be called multiple times before the connection is removed.
         if (!connection->IsValid())
             continue;
 
-        if (!ProcessConnection(*connection))
+        if (!ProcessConnection(*connection, socketReadable))
         {
             connection->Disconnect();
         }
@@ -518,6 +574,8 @@ void NetworkBase::UpdateServer()
             DecayCooldown(connection->Player);
         }
     }
+    _shareMapSnapshots = false;
+    _mapSnapshots.clear();
 
     uint32_t ticks = platform_get_ticks();
     if (ticks > last_ping_sent_time + 3000)
@@ -716,6 +774,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Serialised once, every connection queues the same buffer.
+    auto buffer = packet.CreateBuffer();
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -729,8 +789,7 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        auto packetCopy = packet;
-        client_connection->QueuePacket(std::move(packetCopy), front);
+        client_connection->QueuePacket(buffer, front);
     }
 }
 
@@ -755,7 +814,7 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 
     if (!storedTick.spriteHash.empty())
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
+        EntitiesChecksum checksum = GetAllEntitiesIncrementalChecksum();
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
@@ -788,7 +847,13 @@ bool NetworkBase::CheckDesynchronizaton()
         intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
         context_open_intent(&intent);
 
-        if (!gConfigNetwork.stay_connected)
+        // Servers that can resynchronise the client only send the parts of the park that differ, so the game goes on
+        // without reconnecting.
+        if (_serverConnection->Capabilities & NETWORK_CAPABILITY_RESYNC)
+        {
+            Client_Send_RESYNC_REQUEST();
+        }
+        else if (!gConfigNetwork.stay_connected)
         {
             Close();
         }
@@ -1070,13 +1135,8 @@ std::string NetworkBase::BeginLog(const std::string& directory, const std::strin
     return Path::Combine(directory, midName, filename);
 }
 
-void NetworkBase::AppendLog(std::ostream& fs, std::string_view s)
+void NetworkBase::AppendLog(AsyncLogTarget* target, std::string_view s)
 {
-    if (fs.fail())
-    {
-        log_error("bad ostream failed to append log");
-        return;
-    }
     try
     {
         utf8 buffer[1024];
@@ -1088,7 +1148,7 @@ void NetworkBase::AppendLog(std::ostream& fs, std::string_view s)
             String::Append(buffer, sizeof(buffer), std::string(s).c_str());
             String::Append(buffer, sizeof(buffer), PLATFORM_NEWLINE);
 
-            fs.write(buffer, strlen(buffer));
+            AsyncLogWriter::GetShared().Write(target, buffer);
         }
     }
     catch (const std::exception& ex)
@@ -1102,26 +1162,25 @@ void NetworkBase::BeginChatLog()
     auto env = GetContext().GetPlatformEnvironment();
     auto directory = env->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_CHAT);
     _chatLogPath = BeginLog(directory, "", _chatLogFilenameFormat);
-
-#    if defined(_WIN32) && !defined(__MINGW32__)
-    auto pathW = String::ToWideChar(_chatLogPath.c_str());
-    _chat_log_fs.open(pathW.c_str(), std::ios::out | std::ios::app);
-#    else
-    _chat_log_fs.open(_chatLogPath, std::ios::out | std::ios::app);
-#    endif
+    _chatLog = AsyncLogWriter::GetShared().OpenFile(_chatLogPath);
+    if (_chatLog == nullptr)
+    {
+        log_error("Unable to open chat log '%s'", _chatLogPath.c_str());
+    }
 }
 
 void NetworkBase::AppendChatLog(std::string_view s)
 {
-    if (gConfigNetwork.log_chat && _chat_log_fs.is_open())
+    if (gConfigNetwork.log_chat && _chatLog != nullptr)
     {
-        AppendLog(_chat_log_fs, s);
+        AppendLog(_chatLog, s);
     }
 }
 
 void NetworkBase::CloseChatLog()
 {
-    _chat_log_fs.close();
+    AsyncLogWriter::GetShared().Close(_chatLog);
+    _chatLog = nullptr;
 }
 
 void NetworkBase::BeginServerLog()
@@ -1129,13 +1188,11 @@ void NetworkBase::BeginServerLog()
     auto env = GetContext().GetPlatformEnvironment();
     auto directory = env->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_SERVER);
     _serverLogPath = BeginLog(directory, ServerName, _serverLogFilenameFormat);
-
-#    if defined(_WIN32) && !defined(__MINGW32__)
-    auto pathW = String::ToWideChar(_serverLogPath.c_str());
-    _server_log_fs.open(pathW.c_str(), std::ios::out | std::ios::app | std::ios::binary);
-#    else
-    _server_log_fs.open(_serverLogPath, std::ios::out | std::ios::app | std::ios::binary);
-#    endif
+    _serverLog = AsyncLogWriter::GetShared().OpenFile(_serverLogPath, true);
+    if (_serverLog == nullptr)
+    {
+        log_error("Unable to open server log '%s'", _serverLogPath.c_str());
+    }
 
     // Log server start event
     utf8 logMessage[256];
@@ -1157,9 +1214,9 @@ void NetworkBase::BeginServerLog()
 
 void NetworkBase::AppendServerLog(const std::string& s)
 {
-    if (gConfigNetwork.log_server_actions && _server_log_fs.is_open())
+    if (gConfigNetwork.log_server_actions && _serverLog != nullptr)
     {
-        AppendLog(_server_log_fs, s);
+        AppendLog(_serverLog, s);
     }
 }
 
@@ -1181,7 +1238,8 @@ void NetworkBase::CloseServerLog()
         Guard::Assert(false, "Unknown network mode!");
     }
     AppendServerLog(logMessage);
-    _server_log_fs.close();
+    AsyncLogWriter::GetShared().Close(_serverLog);
+    _serverLog = nullptr;
 }
 
 void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
@@ -1218,6 +1276,7 @@ void NetworkBase::Client_Send_AUTH(
     assert(signature.size() <= static_cast<size_t>(UINT32_MAX));
     packet << static_cast<uint32_t>(signature.size());
     packet.Write(signature.data(), signature.size());
+    packet << static_cast<uint32_t>(NETWORK_CAPABILITY_COMPRESSION | NETWORK_CAPABILITY_RESYNC);
     _serverConnection->AuthStatus = NetworkAuth::Requested;
     _serverConnection->QueuePacket(std::move(packet));
 }
@@ -1372,7 +1431,17 @@ void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
     {
         packet.WriteString(network_get_version().c_str());
     }
+    // Accept every capability the client offered that the server has as well.
+    const uint32_t capabilities = connection.Capabilities & (NETWORK_CAPABILITY_COMPRESSION | NETWORK_CAPABILITY_RESYNC);
+    if (connection.AuthStatus == NetworkAuth::Ok)
+    {
+        packet << capabilities;
+    }
     connection.QueuePacket(std::move(packet));
+    if (connection.AuthStatus == NetworkAuth::Ok && (capabilities & NETWORK_CAPABILITY_COMPRESSION))
+    {
+        connection.EnableCompression();
+    }
     if (connection.AuthStatus != NetworkAuth::Ok && connection.AuthStatus != NetworkAuth::RequirePassword)
     {
         connection.Disconnect();
@@ -1395,8 +1464,33 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         objects = objManager.GetPackableObjects();
     }
 
-    auto header = save_for_network(objects);
-    if (header.empty())
+    const std::vector<uint8_t>* snapshot = nullptr;
+    std::vector<uint8_t> header;
+    if (_shareMapSnapshots)
+    {
+        auto it = std::find_if(_mapSnapshots.begin(), _mapSnapshots.end(), [&objects](const MapSnapshot& item) {
+            return item.Objects == objects;
+        });
+        if (it == _mapSnapshots.end())
+        {
+            auto data = save_for_network(objects);
+            if (!data.empty())
+            {
+                it = _mapSnapshots.insert(_mapSnapshots.end(), MapSnapshot{ objects, std::move(data) });
+            }
+        }
+        if (it != _mapSnapshots.end())
+        {
+            snapshot = &it->Data;
+        }
+    }
+    else
+    {
+        header = save_for_network(objects);
+        snapshot = &header;
+    }
+
+    if (snapshot == nullptr || snapshot->empty())
     {
         if (connection != nullptr)
         {
@@ -1405,13 +1499,14 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         }
         return;
     }
+    const auto& data = *snapshot;
     size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+    for (size_t i = 0; i < data.size(); i += chunksize)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
+        size_t datasize = std::min(chunksize, data.size() - i);
         NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
-        packet.Write(&header[i], datasize);
+        packet << static_cast<uint32_t>(data.size()) << static_cast<uint32_t>(i);
+        packet.Write(&data[i], datasize);
         if (connection != nullptr)
         {
             connection->QueuePacket(std::move(packet));
@@ -1423,14 +1518,13 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
     }
 }
 
-std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
+std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects)
 {
     std::vector<uint8_t> result;
     auto ms = OpenRCT2::MemoryStream();
     if (SaveMap(&ms, objects))
     {
-        result.resize(ms.GetLength());
-        std::memcpy(result.data(), ms.GetData(), result.size());
+        result = ms.TakeBuffer();
     }
     else
     {
@@ -1484,6 +1578,7 @@ void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
     }
 
     DataSerialiser stream(true);
+    stream.SetCompactIntegers(true);
     action->Serialise(stream);
 
     packet << gCurrentTicks << action->GetType() << stream;
@@ -1495,6 +1590,7 @@ void NetworkBase::Server_Send_GAME_ACTION(const GameAction* action)
     NetworkPacket packet(NetworkCommand::GameAction);
 
     DataSerialiser stream(true);
+    stream.SetCompactIntegers(true);
     action->Serialise(stream);
 
     packet << gCurrentTicks << action->GetType() << stream;
@@ -1522,8 +1618,8 @@ void NetworkBase::Server_Send_TICK()
     packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        packet.WriteString(checksum.ToString().c_str());
+        EntitiesChecksum checksum = GetAllEntitiesIncrementalChecksum();
+        packet.Write(checksum.raw.data(), checksum.raw.size());
     }
 
     SendPacketToClients(packet);
@@ -1572,9 +1668,22 @@ void NetworkBase::Server_Send_PING()
 
 void NetworkBase::Server_Send_PINGLIST()
 {
-    NetworkPacket packet(NetworkCommand::PingList);
-    packet << static_cast<uint8_t>(player_list.size());
+    std::vector<const NetworkPlayer*> changedPlayers;
     for (auto& player : player_list)
+    {
+        auto it = _sentPings.find(player->Id);
+        if (it == _sentPings.end() || it->second != player->Ping)
+        {
+            changedPlayers.push_back(player.get());
+            _sentPings[player->Id] = player->Ping;
+        }
+    }
+    if (changedPlayers.empty())
+        return;
+
+    NetworkPacket packet(NetworkCommand::PingList);
+    packet << static_cast<uint8_t>(changedPlayers.size());
+    for (auto* player : changedPlayers)
     {
         packet << player->Id << player->Ping;
     }
@@ -1656,12 +1765,13 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
     SendPacketToClients(packet);
 }
 
-bool NetworkBase::ProcessConnection(NetworkConnection& connection)
+bool NetworkBase::ProcessConnection(NetworkConnection& connection, bool socketReadable)
 {
-    NetworkReadPacket packetStatus;
+    // Sockets with nothing pending are skipped, the timeout below still applies to them.
+    NetworkReadPacket packetStatus = socketReadable ? NetworkReadPacket::Success : NetworkReadPacket::NoData;
 
     uint32_t countProcessed = 0;
-    do
+    while (packetStatus == NetworkReadPacket::Success && countProcessed < MaxPacketsPerUpdate)
     {
         countProcessed++;
         packetStatus = connection.ReadPacket();
@@ -1689,7 +1799,7 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NetworkReadPacket::Success && countProcessed < MaxPacketsPerUpdate);
+    }
 
     if (!connection.ReceivedPacketRecently())
     {
@@ -1705,10 +1815,18 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 
 void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet)
 {
-    const auto& handlerList = GetMode() == NETWORK_MODE_SERVER ? server_command_handlers : client_command_handlers;
+    const auto* handlerList = &client_command_handlers;
+    if (GetMode() == NETWORK_MODE_SERVER)
+    {
+        handlerList = &server_command_handlers;
+    }
+    else if (&connection != _serverConnection.get())
+    {
+        handlerList = &relay_command_handlers;
+    }
 
-    auto it = handlerList.find(packet.GetCommand());
-    if (it != handlerList.end())
+    auto it = handlerList->find(packet.GetCommand());
+    if (it != handlerList->end())
     {
         auto commandHandler = it->second;
         if (connection.AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
@@ -1724,6 +1842,11 @@ void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& pa
         }
     }
 
+    if (_relayListenSocket != nullptr && &connection == _serverConnection.get())
+    {
+        RelayServerPacket(packet);
+    }
+
     packet.Clear();
 }
 
@@ -1825,6 +1948,9 @@ void NetworkBase::ProcessPlayerList()
         {
             _playerListInvalidated = false;
             Server_Send_PLAYERLIST();
+
+            // Players that joined have not been sent any pings yet
+            _sentPings.clear();
         }
     }
     else
@@ -1863,8 +1989,10 @@ void NetworkBase::ProcessPlayerList()
                 }
                 else
                 {
-                    // Update.
+                    // Update, the server only sends pings when they change.
+                    auto ping = player->Ping;
                     *player = pendingPlayer;
+                    player->Ping = ping;
                 }
             }
 
@@ -2230,8 +2358,18 @@ void NetworkBase::Client_Handle_AUTH(NetworkConnection& connection, NetworkPacke
     switch (connection.AuthStatus)
     {
         case NetworkAuth::Ok:
+        {
+            // Servers that did not take up any capability leave them out.
+            uint32_t capabilities;
+            packet >> capabilities;
+            connection.Capabilities = capabilities;
+            if (capabilities & NETWORK_CAPABILITY_COMPRESSION)
+            {
+                connection.EnableCompression();
+            }
             Client_Send_GAMEINFO();
             break;
+        }
         case NetworkAuth::BadName:
             connection.SetLastDisconnectReason(STR_MULTIPLAYER_BAD_PLAYER_NAME);
             connection.Disconnect();
@@ -2485,7 +2623,7 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
     }
 }
 
-void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+bool NetworkBase::ReadRequestedObjects(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size;
     packet >> size;
@@ -2501,7 +2639,7 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
         std::string text = std::string("Player ") + playerName + std::string(" requested invalid amount of objects");
         AppendServerLog(text);
         log_warning(text.c_str());
-        return;
+        return false;
     }
     log_verbose("Client requested %u objects", size);
     auto& repo = GetContext().GetObjectRepository();
@@ -2535,6 +2673,13 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
             connection.RequestedObjects.push_back(item);
         }
     }
+    return true;
+}
+
+void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (!ReadRequestedObjects(connection, packet))
+        return;
 
     auto player_name = connection.Player->Name.c_str();
     Server_Send_MAP(&connection);
@@ -2553,6 +2698,8 @@ void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacke
         auto pubkey = packet.ReadString();
         uint32_t sigsize;
         packet >> sigsize;
+        const uint8_t* signatureData = packet.Read(sigsize);
+        packet >> connection.Capabilities;
         if (pubkey.empty())
         {
             connection.AuthStatus = NetworkAuth::VerificationFailure;
@@ -2573,7 +2720,6 @@ void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacke
                 std::vector<uint8_t> signature;
                 signature.resize(sigsize);
 
-                const uint8_t* signatureData = packet.Read(sigsize);
                 if (signatureData == nullptr)
                 {
                     throw std::runtime_error("Failed to read packet.");
@@ -2774,7 +2920,7 @@ bool NetworkBase::LoadMap(IStream* stream)
     return result;
 }
 
-bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const
+bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects, bool compress)
 {
     bool result = false;
     viewport_set_saved_view();
@@ -2782,6 +2928,8 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
     {
         auto exporter = std::make_unique<ParkFileExporter>();
         exporter->ExportObjectsList = objects;
+        exporter->ExportObjectsDataCache = &_packedObjectDataCache;
+        exporter->Compress = compress;
         exporter->Export(*stream);
         result = true;
     }
@@ -2792,6 +2940,360 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
     return result;
 }
 
+// Sends data too large for one packet as <total><offset><bytes> chunks, empty data still takes one packet.
+static void QueueChunkedData(NetworkConnection& connection, NetworkCommand command, const uint8_t* data, size_t size)
+{
+    size_t offset = 0;
+    do
+    {
+        const auto chunkSize = std::min<size_t>(CHUNK_SIZE, size - offset);
+        NetworkPacket packet(command);
+        packet << static_cast<uint32_t>(size) << static_cast<uint32_t>(offset);
+        packet.Write(data + offset, chunkSize);
+        connection.QueuePacket(std::move(packet));
+        offset += chunkSize;
+    } while (offset < size);
+}
+
+// @return true once the last chunk has been received, received is set to the number of bytes received so far.
+static bool ReceiveChunkedData(NetworkPacket& packet, std::vector<uint8_t>& buffer, size_t& received)
+{
+    uint32_t size, offset;
+    packet >> size >> offset;
+    const size_t chunkSize = packet.Header.Size - packet.BytesRead;
+    if (offset == 0)
+    {
+        buffer.resize(size);
+    }
+    if (buffer.size() != size || offset + chunkSize > size)
+    {
+        buffer.clear();
+        return false;
+    }
+    if (chunkSize != 0)
+    {
+        std::memcpy(buffer.data() + offset, packet.Read(chunkSize), chunkSize);
+    }
+    received = offset + chunkSize;
+    return received == size;
+}
+
+void NetworkBase::Server_Handle_RESYNC_REQUEST(NetworkConnection& connection, [[maybe_unused]] NetworkPacket& packet)
+{
+    const auto ticks = platform_get_ticks();
+    if (connection.Player == nullptr || !(connection.Capabilities & NETWORK_CAPABILITY_RESYNC)
+        || (connection.LastResyncTime != 0 && ticks - connection.LastResyncTime < ResyncCooldownMilliseconds))
+    {
+        // An empty manifest tells the client to give up on resynchronising.
+        QueueChunkedData(connection, NetworkCommand::ResyncManifest, nullptr, 0);
+        return;
+    }
+    connection.LastResyncTime = ticks;
+
+    log_verbose("Client %s asked to be resynchronised", connection.Socket->GetHostName());
+    Server_Send_RESYNC_MANIFEST(connection);
+}
+
+void NetworkBase::Server_Send_RESYNC_MANIFEST(NetworkConnection& connection)
+{
+    // Both sides export the park uncompressed, the same state then gives the same bytes.
+    MemoryStream parkStream;
+    if (!SaveMap(&parkStream, {}, false))
+    {
+        QueueChunkedData(connection, NetworkCommand::ResyncManifest, nullptr, 0);
+        return;
+    }
+    connection.ResyncPark = parkStream.TakeBuffer();
+    connection.ResyncPieces = ContentSplitter::Split(connection.ResyncPark.data(), connection.ResyncPark.size());
+
+    DataSerialiser manifest(true);
+    auto checksum = Crypt::SHA1(connection.ResyncPark.data(), connection.ResyncPark.size());
+    manifest << static_cast<uint32_t>(connection.ResyncPark.size()) << checksum;
+    manifest << static_cast<uint32_t>(connection.ResyncPieces.size());
+    for (const auto& piece : connection.ResyncPieces)
+    {
+        manifest << piece.Length << piece.Hash;
+    }
+
+    auto& manifestStream = manifest.GetStream();
+    QueueChunkedData(
+        connection, NetworkCommand::ResyncManifest, static_cast<const uint8_t*>(manifestStream.GetData()),
+        static_cast<size_t>(manifestStream.GetLength()));
+}
+
+void NetworkBase::Server_Handle_RESYNC_PIECE_REQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.ResyncPark.empty())
+    {
+        return;
+    }
+
+    std::vector<uint8_t> data;
+    uint32_t numRanges;
+    packet >> numRanges;
+    for (uint32_t i = 0; i < numRanges; i++)
+    {
+        uint32_t first, count;
+        packet >> first >> count;
+        if (first >= connection.ResyncPieces.size() || count > connection.ResyncPieces.size() - first)
+        {
+            log_warning("Client %s asked for resync pieces that do not exist", connection.Socket->GetHostName());
+            data.clear();
+            break;
+        }
+        const auto& firstPiece = connection.ResyncPieces[first];
+        const auto& lastPiece = connection.ResyncPieces[first + count - 1];
+        const auto* begin = connection.ResyncPark.data() + firstPiece.Offset;
+        const auto* end = connection.ResyncPark.data() + lastPiece.Offset + lastPiece.Length;
+        data.insert(data.end(), begin, end);
+    }
+
+    // The client only asks once, the park can go.
+    connection.ResyncPark = {};
+    connection.ResyncPieces = {};
+
+    QueueChunkedData(connection, NetworkCommand::ResyncPieces, data.data(), data.size());
+}
+
+void NetworkBase::Client_Send_RESYNC_REQUEST()
+{
+    log_info("Asking the server to resynchronise");
+    _resyncing = true;
+    _resyncReceived.clear();
+    NetworkPacket packet(NetworkCommand::ResyncRequest);
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Client_Handle_RESYNC_MANIFEST([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (!_resyncing)
+    {
+        return;
+    }
+
+    if (_clientMapLoaded)
+    {
+        // The server exported its park before sending the actions that follow it, those have to wait for it to be
+        // loaded just like they do for a map download.
+        GameActions::ClearQueue();
+        GameActions::SuspendQueue();
+
+        _serverTickData.clear();
+        _clientMapLoaded = false;
+    }
+
+    size_t received;
+    if (!ReceiveChunkedData(packet, _resyncReceived, received))
+    {
+        return;
+    }
+    if (_resyncReceived.empty())
+    {
+        AbandonResync();
+        return;
+    }
+
+    std::vector<ContentPiece> serverPieces;
+    uint32_t parkSize = 0;
+    try
+    {
+        MemoryStream manifestStream(_resyncReceived.data(), _resyncReceived.size());
+        DataSerialiser manifest(false, manifestStream);
+        uint32_t numPieces;
+        manifest << parkSize << _resyncChecksum << numPieces;
+        serverPieces.resize(numPieces);
+        uint32_t offset = 0;
+        for (auto& piece : serverPieces)
+        {
+            manifest << piece.Length << piece.Hash;
+            piece.Offset = offset;
+            offset += piece.Length;
+        }
+        if (offset != parkSize)
+        {
+            throw std::runtime_error("pieces do not add up to the park");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Invalid resync manifest: %s", e.what());
+        AbandonResync();
+        return;
+    }
+    _resyncReceived.clear();
+
+    // Pieces that are the same in the client's park can be copied from there, wherever they ended up.
+    MemoryStream parkStream;
+    if (!SaveMap(&parkStream, {}, false))
+    {
+        AbandonResync();
+        return;
+    }
+    const auto localPark = parkStream.TakeBuffer();
+    std::unordered_map<uint64_t, ContentPiece> localPieces;
+    for (const auto& piece : ContentSplitter::Split(localPark.data(), localPark.size()))
+    {
+        localPieces.emplace(piece.Hash, piece);
+    }
+
+    _resyncPark.resize(parkSize);
+    _resyncMissingPieces.clear();
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (uint32_t i = 0; i < serverPieces.size(); i++)
+    {
+        const auto& piece = serverPieces[i];
+        auto it = localPieces.find(piece.Hash);
+        if (it != localPieces.end() && it->second.Length == piece.Length)
+        {
+            std::memcpy(_resyncPark.data() + piece.Offset, localPark.data() + it->second.Offset, piece.Length);
+            continue;
+        }
+
+        _resyncMissingPieces.push_back(piece);
+        if (!ranges.empty() && ranges.back().first + ranges.back().second == i)
+        {
+            ranges.back().second++;
+        }
+        else
+        {
+            ranges.emplace_back(i, 1);
+        }
+    }
+
+    log_info(
+        "Resynchronising %u of %u pieces of the park", static_cast<uint32_t>(_resyncMissingPieces.size()),
+        static_cast<uint32_t>(serverPieces.size()));
+    if (_resyncMissingPieces.empty())
+    {
+        FinishResync();
+        return;
+    }
+    if (ranges.size() > MaxResyncPieceRanges)
+    {
+        ranges = { { 0, static_cast<uint32_t>(serverPieces.size()) } };
+        _resyncMissingPieces = std::move(serverPieces);
+    }
+
+    NetworkPacket request(NetworkCommand::ResyncPieceRequest);
+    request << static_cast<uint32_t>(ranges.size());
+    for (const auto& range : ranges)
+    {
+        request << range.first << range.second;
+    }
+    _serverConnection->QueuePacket(std::move(request));
+}
+
+void NetworkBase::Client_Handle_RESYNC_PIECES([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (!_resyncing || _resyncMissingPieces.empty())
+    {
+        return;
+    }
+
+    size_t received = 0;
+    const bool complete = ReceiveChunkedData(packet, _resyncReceived, received);
+
+    char str_resynchronising[256];
+    uint32_t resynchronising_args[2] = {
+        static_cast<uint32_t>(received / 1024),
+        static_cast<uint32_t>(_resyncReceived.size() / 1024),
+    };
+    format_string(str_resynchronising, 256, STR_MULTIPLAYER_RESYNCHRONISING, resynchronising_args);
+
+    auto intent = Intent(WC_NETWORK_STATUS);
+    intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_resynchronising });
+    intent.putExtra(INTENT_EXTRA_CALLBACK, []() -> void { ::GetContext()->GetNetwork().Close(); });
+    context_open_intent(&intent);
+
+    if (!complete)
+    {
+        return;
+    }
+
+    size_t expected = 0;
+    for (const auto& piece : _resyncMissingPieces)
+    {
+        if (expected + piece.Length > _resyncReceived.size())
+        {
+            break;
+        }
+        std::memcpy(_resyncPark.data() + piece.Offset, _resyncReceived.data() + expected, piece.Length);
+        expected += piece.Length;
+    }
+    if (expected != _resyncReceived.size())
+    {
+        log_warning("Received %zu bytes of resync pieces, expected %zu", _resyncReceived.size(), expected);
+        AbandonResync();
+        return;
+    }
+    FinishResync();
+}
+
+void NetworkBase::FinishResync()
+{
+    const bool valid = Crypt::SHA1(_resyncPark.data(), _resyncPark.size()) == _resyncChecksum;
+    if (!valid)
+    {
+        log_warning("Resynchronised park does not match the server's");
+        AbandonResync();
+        return;
+    }
+
+    // The player is still looking at the same park, keep the view they had rather than the one the server saved.
+    const auto savedView = gSavedView;
+    const auto savedViewZoom = gSavedViewZoom;
+    const auto savedViewRotation = gSavedViewRotation;
+
+    GameActions::ResumeQueue();
+    context_force_close_window_by_class(WC_NETWORK_STATUS);
+
+    auto ms = MemoryStream(_resyncPark.data(), _resyncPark.size());
+    if (LoadMap(&ms))
+    {
+        gSavedView = savedView;
+        gSavedViewZoom = savedViewZoom;
+        gSavedViewRotation = savedViewRotation;
+        gLoadKeepWindowsOpen = true;
+        game_load_init();
+        gLoadKeepWindowsOpen = false;
+
+        _serverState.tick = gCurrentTicks;
+        _serverState.state = NetworkServerState::Ok;
+        _clientMapLoaded = true;
+
+        fix_invalid_vehicle_sprite_sizes();
+        ProcessPlayerList();
+        log_info("Resynchronised with the server");
+    }
+    else
+    {
+        auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PromptMode::SaveBeforeQuit);
+        GameActions::Execute(&loadOrQuitAction);
+    }
+
+    _resyncing = false;
+    _resyncReceived = {};
+    _resyncPark = {};
+    _resyncMissingPieces = {};
+}
+
+void NetworkBase::AbandonResync()
+{
+    log_warning("Unable to resynchronise with the server");
+    GameActions::ResumeQueue();
+    _clientMapLoaded = true;
+
+    _resyncing = false;
+    _resyncReceived = {};
+    _resyncPark = {};
+    _resyncMissingPieces = {};
+
+    if (!gConfigNetwork.stay_connected)
+    {
+        Close();
+    }
+}
+
 void NetworkBase::Client_Handle_CHAT([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     auto text = packet.ReadString();
@@ -2879,6 +3381,7 @@ void NetworkBase::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection&
     stream.SetPosition(0);
 
     DataSerialiser ds(false, stream);
+    ds.SetCompactIntegers(true);
 
     GameAction::Ptr action = GameActions::Create(actionType);
     if (action == nullptr)
@@ -2964,6 +3467,7 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
     }
 
     DataSerialiser stream(false);
+    stream.SetCompactIntegers(true);
     const size_t size = packet.Header.Size - packet.BytesRead;
     stream.GetStream().WriteArray(packet.Read(size), size);
     stream.GetStream().SetPosition(0);
@@ -2989,10 +3493,12 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
 
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        auto text = packet.ReadString();
-        if (!text.empty())
+        const auto* raw = packet.Read(sizeof(EntitiesChecksum::raw));
+        if (raw != nullptr)
         {
-            tickData.spriteHash = text;
+            EntitiesChecksum checksum;
+            std::memcpy(checksum.raw.data(), raw, checksum.raw.size());
+            tickData.spriteHash = checksum.ToString();
         }
     }
 
@@ -3171,6 +3677,282 @@ void NetworkBase::Client_Handle_GAMEINFO([[maybe_unused]] NetworkConnection& con
     network_chat_show_server_greeting();
 }
 
+bool NetworkBase::BeginRelay(uint16_t port, const std::string& address)
+{
+    if (GetMode() != NETWORK_MODE_CLIENT)
+    {
+        return false;
+    }
+
+    CloseRelay();
+    auto listenSocket = CreateTcpSocket();
+    try
+    {
+        listenSocket->Listen(address, port);
+    }
+    catch (const std::exception& ex)
+    {
+        Console::Error::WriteLine(ex.what());
+        return false;
+    }
+    _relayListenSocket = std::move(listenSocket);
+    _relayPort = port;
+    _relayAddress = address;
+
+    auto* szAddress = address.empty() ? "*" : address.c_str();
+    Console::WriteLine("Relaying the server to spectators on %s:%hu", szAddress, port);
+    return true;
+}
+
+void NetworkBase::CloseRelay()
+{
+    for (auto& spectator : _spectatorConnections)
+    {
+        spectator->SendQueuedPackets();
+        spectator->Socket->Disconnect();
+    }
+    _spectatorConnections.clear();
+    _relayListenSocket.reset();
+    _relayBacklog.clear();
+}
+
+void NetworkBase::UpdateRelay()
+{
+    // The packets of the ticks the relay has run are part of every map it sends from now on.
+    _relayBacklog.erase(
+        std::remove_if(
+            _relayBacklog.begin(), _relayBacklog.end(), [](const RelayedPacket& item) { return item.Tick < gCurrentTicks; }),
+        _relayBacklog.end());
+
+    _shareMapSnapshots = true;
+    for (auto& spectator : _spectatorConnections)
+    {
+        if (spectator->IsValid() && !ProcessConnection(*spectator))
+        {
+            spectator->Disconnect();
+        }
+    }
+    _shareMapSnapshots = false;
+    _mapSnapshots.clear();
+
+    for (auto it = _spectatorConnections.begin(); it != _spectatorConnections.end();)
+    {
+        auto& spectator = *it;
+        if (spectator->IsValid())
+        {
+            it++;
+            continue;
+        }
+        spectator->SendQueuedPackets();
+        spectator->Socket->Disconnect();
+        it = _spectatorConnections.erase(it);
+    }
+
+    // Spectators are sent the game state of the relay, there is none until the relay has loaded the map itself.
+    if (_clientMapLoaded && _spectatorConnections.size() < MaxRelaySpectators)
+    {
+        std::unique_ptr<ITcpSocket> tcpSocket = _relayListenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            log_verbose("Spectator joined from %s", tcpSocket->GetHostName());
+            auto connection = std::make_unique<NetworkConnection>();
+            connection->Socket = std::move(tcpSocket);
+            _spectatorConnections.push_back(std::move(connection));
+        }
+    }
+}
+
+void NetworkBase::RelayServerPacket(const NetworkPacket& packet)
+{
+    std::optional<uint32_t> tick;
+    switch (packet.GetCommand())
+    {
+        case NetworkCommand::Tick:
+        case NetworkCommand::GameAction:
+        case NetworkCommand::PlayerList:
+        case NetworkCommand::PlayerInfo:
+        {
+            // These start with the tick they apply to.
+            uint32_t packetTick;
+            if (packet.Data.size() < sizeof(packetTick))
+            {
+                return;
+            }
+            std::memcpy(&packetTick, packet.GetData(), sizeof(packetTick));
+            tick = ByteSwapBE(packetTick);
+            break;
+        }
+        case NetworkCommand::Map:
+        {
+            // A map sent to every client replaces the game state the backlog applies to.
+            uint32_t offset;
+            if (packet.Data.size() < sizeof(uint32_t) + sizeof(offset))
+            {
+                return;
+            }
+            std::memcpy(&offset, packet.GetData() + sizeof(uint32_t), sizeof(offset));
+            if (ByteSwapBE(offset) == 0)
+            {
+                _relayBacklog.clear();
+            }
+            break;
+        }
+        case NetworkCommand::Chat:
+        case NetworkCommand::PingList:
+        case NetworkCommand::GroupList:
+        case NetworkCommand::Event:
+            break;
+        default:
+            // Everything else is part of the connection between the relay and the server.
+            return;
+    }
+
+    // Serialised once, every spectator queues the same buffer.
+    auto buffer = packet.CreateBuffer();
+    if (tick.has_value())
+    {
+        _relayBacklog.push_back({ *tick, buffer });
+    }
+    for (auto& spectator : _spectatorConnections)
+    {
+        if (spectator->MapSent)
+        {
+            spectator->QueuePacket(buffer);
+        }
+    }
+}
+
+void NetworkBase::Relay_Send_AUTH(NetworkConnection& connection)
+{
+    // Spectators see the game as the player of the relay, nothing they do is passed on to the server.
+    NetworkPacket packet(NetworkCommand::Auth);
+    packet << static_cast<uint32_t>(connection.AuthStatus) << player_id;
+    if (connection.AuthStatus == NetworkAuth::BadVersion)
+    {
+        packet.WriteString(network_get_version().c_str());
+    }
+    connection.QueuePacket(std::move(packet));
+    if (connection.AuthStatus != NetworkAuth::Ok)
+    {
+        connection.Disconnect();
+    }
+}
+
+void NetworkBase::Relay_Send_GAMEINFO(NetworkConnection& connection)
+{
+    NetworkPacket packet(NetworkCommand::GameInfo);
+#    ifndef DISABLE_HTTP
+    // The details of the server as the relay received them.
+    json_t jsonProvider = {
+        { "name", ServerProviderName },
+        { "email", ServerProviderEmail },
+        { "website", ServerProviderWebsite },
+    };
+    json_t jsonObj = {
+        { "name", ServerName },
+        { "description", ServerDescription },
+        { "greeting", ServerGreeting },
+        { "provider", jsonProvider },
+    };
+
+    packet.WriteString(jsonObj.dump().c_str());
+    // The relay does not keep game state snapshots for desync debugging.
+    packet << false;
+#    endif
+    connection.QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Relay_Send_PLAYERLIST(NetworkConnection& connection)
+{
+    NetworkPacket packet(NetworkCommand::PlayerList);
+    packet << gCurrentTicks << static_cast<uint8_t>(player_list.size());
+    for (auto& player : player_list)
+    {
+        player->Write(packet);
+    }
+    connection.QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus == NetworkAuth::Ok)
+    {
+        return;
+    }
+
+    // Spectators can not change the game, there is no need to verify who they are.
+    auto* hostName = connection.Socket->GetHostName();
+    auto gameversion = packet.ReadString();
+    auto name = packet.ReadString();
+    if (gameversion != network_get_version())
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+        log_info("Spectator %s: Bad version.", hostName);
+    }
+    else if (name.empty())
+    {
+        connection.AuthStatus = NetworkAuth::BadName;
+        log_info("Spectator %s: Bad name.", hostName);
+    }
+    else
+    {
+        connection.AuthStatus = NetworkAuth::Ok;
+        log_verbose("Spectator %s: Joined as %s.", hostName, std::string(name).c_str());
+    }
+    Relay_Send_AUTH(connection);
+
+    if (connection.AuthStatus == NetworkAuth::Ok)
+    {
+        auto& objManager = GetContext().GetObjectManager();
+        Server_Send_OBJECTS_LIST(connection, objManager.GetPackableObjects());
+        Server_Send_SCRIPTS(connection);
+    }
+}
+
+void NetworkBase::Relay_Handle_GAMEINFO(NetworkConnection& connection, [[maybe_unused]] NetworkPacket& packet)
+{
+    Relay_Send_GAMEINFO(connection);
+}
+
+void NetworkBase::Relay_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus != NetworkAuth::Ok || connection.MapSent)
+    {
+        return;
+    }
+    if (!_clientMapLoaded)
+    {
+        // The server is sending the relay a new map, the spectator can join again once it has been loaded.
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+        connection.Disconnect();
+        return;
+    }
+    if (!ReadRequestedObjects(connection, packet))
+    {
+        return;
+    }
+
+    Server_Send_MAP(&connection);
+    if (!connection.IsValid())
+    {
+        return;
+    }
+    Server_Send_GROUPLIST(connection);
+    Relay_Send_PLAYERLIST(connection);
+
+    // The relay has received these from the server but not run them yet, so they are not part of the map.
+    for (const auto& relayed : _relayBacklog)
+    {
+        connection.QueuePacket(relayed.Buffer);
+    }
+    connection.MapSent = true;
+}
+
+void NetworkBase::Relay_Handle_GAME_ACTION(NetworkConnection& connection, [[maybe_unused]] NetworkPacket& packet)
+{
+    Server_Send_SHOWERROR(connection, STR_CANT_DO_THIS, STR_PERMISSION_DENIED);
+}
+
 void network_reconnect()
 {
     OpenRCT2::GetContext()->GetNetwork().Reconnect();
@@ -3193,6 +3975,7 @@ int32_t network_begin_server(int32_t port, const std::string& address)
 
 void network_update()
 {
+    PROFILE_ZONE(Network);
     OpenRCT2::GetContext()->GetNetwork().Update();
 }
 
@@ -3203,6 +3986,7 @@ void network_process_pending()
 
 void network_flush()
 {
+    PROFILE_ZONE(Network);
     OpenRCT2::GetContext()->GetNetwork().Flush();
 }
 
@@ -2,7 +2,9 @@
 
 #include "../System.hpp"
 #include "../actions/GameAction.h"
+#include "../core/AsyncLogWriter.h"
 #include "../object/Object.h"
+#include "../park/ParkFile.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
 #include "NetworkPlayer.h"
@@ -10,7 +12,8 @@
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
-#include <fstream>
+#include <array>
+#include <deque>
 
 #ifndef DISABLE_NETWORK
 
@@ -44,13 +47,13 @@ public: // Common
     void SetPassword(const char* password);
     uint8_t GetDefaultGroup();
     std::string BeginLog(const std::string& directory, const std::string& midName, const std::string& filenameFormat);
-    void AppendLog(std::ostream& fs, std::string_view s);
+    void AppendLog(AsyncLogTarget* target, std::string_view s);
     void BeginChatLog();
     void AppendChatLog(std::string_view s);
     void CloseChatLog();
     NetworkStats_t GetStats() const;
     json_t GetServerInfoAsJson() const;
-    bool ProcessConnection(NetworkConnection& connection);
+    bool ProcessConnection(NetworkConnection& connection, bool socketReadable = true);
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
@@ -75,8 +78,8 @@ public: // Server
     void RemovePlayer(std::unique_ptr<NetworkConnection>& connection);
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
-    bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
-    std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects, bool compress = true);
+    std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects);
     std::string MakePlayerNameUnique(const std::string& name);
 
     // Packet dispatchers.
@@ -98,6 +101,7 @@ public: // Server
     void Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName, const char* reason);
     void Server_Send_OBJECTS_LIST(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
     void Server_Send_SCRIPTS(NetworkConnection& connection);
+    void Server_Send_RESYNC_MANIFEST(NetworkConnection& connection);
 
     // Handlers
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
@@ -110,6 +114,26 @@ public: // Server
     void Server_Handle_GAMEINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_RESYNC_REQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_RESYNC_PIECE_REQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    bool ReadRequestedObjects(NetworkConnection& connection, NetworkPacket& packet);
+
+public: // Relay
+    bool BeginRelay(uint16_t port, const std::string& address);
+    void CloseRelay();
+    void UpdateRelay();
+    void RelayServerPacket(const NetworkPacket& packet);
+
+    // Packet dispatchers.
+    void Relay_Send_AUTH(NetworkConnection& connection);
+    void Relay_Send_GAMEINFO(NetworkConnection& connection);
+    void Relay_Send_PLAYERLIST(NetworkConnection& connection);
+
+    // Handlers
+    void Relay_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_GAMEINFO(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Relay_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
 
 public: // Client
     void Reconnect();
@@ -129,6 +153,8 @@ public: // Client
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
     void UpdateClient();
+    void FinishResync();
+    void AbandonResync();
 
     // Packet dispatchers.
     void Client_Send_RequestGameState(uint32_t tick);
@@ -141,6 +167,7 @@ public: // Client
     void Client_Send_GAMEINFO();
     void Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor>& objects);
     void Client_Send_HEARTBEAT(NetworkConnection& connection) const;
+    void Client_Send_RESYNC_REQUEST();
 
     // Handlers.
     void Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
@@ -161,6 +188,8 @@ public: // Client
     void Client_Handle_OBJECTS_LIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNC_MANIFEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNC_PIECES(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
@@ -181,7 +210,7 @@ private: // Common Data
     using CommandHandler = void (NetworkBase::*)(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> chunk_buffer;
-    std::ofstream _chat_log_fs;
+    AsyncLogTarget* _chatLog = nullptr;
     uint32_t _lastUpdateTime = 0;
     uint32_t _currentDeltaTime = 0;
     int32_t mode = NETWORK_MODE_NONE;
@@ -195,11 +224,26 @@ private: // Server Data
     std::unique_ptr<ITcpSocket> _listenSocket;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    std::vector<const ITcpSocket*> _clientSockets;
+    std::vector<bool> _clientSocketsReadable;
+    struct MapSnapshot
+    {
+        std::vector<const ObjectRepositoryItem*> Objects;
+        std::vector<uint8_t> Data;
+    };
+    // Maps serialised while processing the clients of one server update, the game state can not change in
+    // between so clients joining together that need the same objects get the same data.
+    std::vector<MapSnapshot> _mapSnapshots;
+    bool _shareMapSnapshots = false;
+    // Custom objects sent to clients are read from disk once while the server is running
+    PackedObjectDataCache _packedObjectDataCache;
     std::string _serverLogPath;
     std::string _serverLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
-    std::ofstream _server_log_fs;
+    AsyncLogTarget* _serverLog = nullptr;
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
+    // Pings last sent to the clients by player id, only pings that changed since are sent again
+    std::unordered_map<uint8_t, uint16_t> _sentPings;
 
 private: // Client Data
     struct PlayerListUpdate
@@ -236,6 +280,30 @@ private: // Client Data
     SocketStatus _lastConnectStatus = SocketStatus::Closed;
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
+    // A desynchronised client asks the server for the park as it is now and only downloads the pieces of it that differ
+    // from its own park. The server's park is put together from both in _resyncPark.
+    bool _resyncing = false;
+    std::vector<uint8_t> _resyncReceived;
+    std::vector<uint8_t> _resyncPark;
+    std::vector<ContentPiece> _resyncMissingPieces;
+    std::array<uint8_t, 20> _resyncChecksum{};
+
+private: // Relay Data
+    struct RelayedPacket
+    {
+        uint32_t Tick;
+        std::shared_ptr<const NetworkPacketBuffer> Buffer;
+    };
+
+    // A relay is a client of the server that passes the packets it receives from it on to read-only spectators, the
+    // server only sends them once however many spectators there are.
+    std::unordered_map<NetworkCommand, CommandHandler> relay_command_handlers;
+    std::unique_ptr<ITcpSocket> _relayListenSocket;
+    std::list<std::unique_ptr<NetworkConnection>> _spectatorConnections;
+    // Packets for ticks the relay has not run yet, a spectator is sent them along with the map so it does not miss any.
+    std::deque<RelayedPacket> _relayBacklog;
+    std::string _relayAddress;
+    uint16_t _relayPort = 0;
 };
 
 #endif // DISABLE_NETWORK
@@ -17,16 +17,146 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <array>
+#    include <cstring>
+#    include <zlib.h>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
 
+// Larger packets are sent as they are, so the deflated packet always fits in the size field of the header.
+constexpr size_t MaxCompressedPacketSize = 1024 * 32;
+// A small window keeps the memory used per connection low, ticks and game actions mostly repeat recent packets.
+constexpr int32_t CompressionWindowBits = 12;
+constexpr int32_t CompressionMemLevel = 5;
+// Every packet ends with a sync flush, which always ends in these bytes. They are left out and added back when inflating.
+constexpr std::array<uint8_t, 4> SyncFlushTrailer = { 0x00, 0x00, 0xFF, 0xFF };
+
+struct NetworkCompression
+{
+    z_stream Deflate{};
+    z_stream Inflate{};
+    bool DeflateReady = false;
+    bool InflateReady = false;
+    // Holds the output of either stream, large enough for any packet.
+    std::vector<uint8_t> Buffer = std::vector<uint8_t>(sizeof(PacketHeader) + NetworkBufferSize);
+
+    NetworkCompression()
+    {
+        // Raw deflate streams, the connection already frames the packets.
+        DeflateReady = deflateInit2(
+                           &Deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -CompressionWindowBits, CompressionMemLevel,
+                           Z_DEFAULT_STRATEGY)
+            == Z_OK;
+        InflateReady = inflateInit2(&Inflate, -CompressionWindowBits) == Z_OK;
+    }
+
+    ~NetworkCompression()
+    {
+        if (DeflateReady)
+            deflateEnd(&Deflate);
+        if (InflateReady)
+            inflateEnd(&Inflate);
+    }
+
+    NetworkCompression(const NetworkCompression&) = delete;
+    NetworkCompression& operator=(const NetworkCompression&) = delete;
+};
+
+static bool IsCompressible(NetworkCommand command)
+{
+    switch (command)
+    {
+        case NetworkCommand::Tick:
+        case NetworkCommand::GameAction:
+            return true;
+        default:
+            return false;
+    }
+}
+
 NetworkConnection::NetworkConnection()
 {
     ResetLastPacketTime();
 }
 
-NetworkConnection::~NetworkConnection()
+NetworkConnection::~NetworkConnection() = default;
+
+void NetworkConnection::EnableCompression()
 {
+    auto compression = std::make_unique<NetworkCompression>();
+    if (!compression->DeflateReady || !compression->InflateReady)
+    {
+        log_error("Unable to initialise packet compression.");
+        return;
+    }
+    _compression = std::move(compression);
+}
+
+bool NetworkConnection::IsCompressionEnabled() const
+{
+    return _compression != nullptr;
+}
+
+std::shared_ptr<const NetworkPacketBuffer> NetworkConnection::Compress(const NetworkPacketBuffer& buffer)
+{
+    // The whole packet is deflated, header included, so the inflated bytes can be read like any other packet.
+    auto& strm = _compression->Deflate;
+    auto& output = _compression->Buffer;
+    strm.next_in = const_cast<uint8_t*>(buffer.Bytes.data());
+    strm.avail_in = static_cast<uInt>(buffer.Bytes.size());
+    strm.next_out = output.data();
+    strm.avail_out = static_cast<uInt>(output.size());
+    if (deflate(&strm, Z_SYNC_FLUSH) != Z_OK || strm.avail_in != 0 || strm.avail_out == 0)
+    {
+        // The stream is left in an unknown state, nothing can be sent compressed any more.
+        log_error("Unable to compress packet.");
+        Disconnect();
+        return nullptr;
+    }
+
+    NetworkPacket packet(NetworkCommand::Compressed);
+    packet.Write(output.data(), output.size() - strm.avail_out - SyncFlushTrailer.size());
+
+    // Statistics are recorded under the command that was compressed.
+    auto compressed = std::make_shared<NetworkPacketBuffer>(*packet.CreateBuffer());
+    compressed->Id = buffer.Id;
+    return compressed;
+}
+
+bool NetworkConnection::Decompress(NetworkPacket& packet)
+{
+    auto& strm = _compression->Inflate;
+    auto& output = _compression->Buffer;
+    packet.Write(SyncFlushTrailer.data(), SyncFlushTrailer.size());
+    strm.next_in = packet.GetData();
+    strm.avail_in = static_cast<uInt>(packet.Data.size());
+    strm.next_out = output.data();
+    strm.avail_out = static_cast<uInt>(output.size());
+    if (inflate(&strm, Z_SYNC_FLUSH) != Z_OK || strm.avail_in != 0 || strm.avail_out == 0)
+    {
+        return false;
+    }
+
+    const auto inflatedSize = output.size() - strm.avail_out;
+    PacketHeader header;
+    if (inflatedSize < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, output.data(), sizeof(header));
+    header.Size = Convert::NetworkToHost(header.Size);
+    header.Id = ByteSwapBE(header.Id);
+    const auto dataSize = inflatedSize - sizeof(header);
+    if (header.Size != dataSize + sizeof(header.Id) || !IsCompressible(header.Id))
+    {
+        return false;
+    }
+
+    packet.Header.Id = header.Id;
+    packet.Header.Size = static_cast<uint16_t>(dataSize);
+    packet.Data.assign(output.begin() + sizeof(header), output.begin() + inflatedSize);
+    return true;
 }
 
 NetworkReadPacket NetworkConnection::ReadPacket()
@@ -89,7 +219,14 @@ NetworkReadPacket NetworkConnection::ReadPacket()
             // Received complete packet.
             _lastPacketTime = platform_get_ticks();
 
-            RecordPacketStats(InboundPacket, false);
+            if (InboundPacket.GetCommand() == NetworkCommand::Compressed && _compression != nullptr
+                && !Decompress(InboundPacket))
+            {
+                log_error("Received a packet that could not be decompressed.");
+                return NetworkReadPacket::Disconnected;
+            }
+
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NetworkReadPacket::Success;
         }
@@ -98,61 +235,52 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
-
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
+    QueuePacket(static_cast<const NetworkPacket&>(packet), front);
+}
 
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    QueuePacket(packet.CreateBuffer(), front);
+}
 
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
-    {
-        packet.BytesTransferred += sent;
-    }
+void NetworkConnection::QueuePacket(const std::shared_ptr<const NetworkPacketBuffer>& buffer, bool front)
+{
+    if (AuthStatus != NetworkAuth::Ok && NetworkPacket::CommandRequiresAuth(buffer->Id))
+        return;
 
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+    if (_compression != nullptr && IsCompressible(buffer->Id) && buffer->Bytes.size() <= MaxCompressedPacketSize)
     {
-        RecordPacketStats(packet, true);
+        auto compressed = Compress(*buffer);
+        if (compressed == nullptr)
+            return;
+        QueueBuffer(compressed, front);
+        return;
     }
-    return sendComplete;
+    QueueBuffer(buffer, front);
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueueBuffer(const std::shared_ptr<const NetworkPacketBuffer>& buffer, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if (front)
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
-        if (front)
+        // If the first packet was already partially sent add new packet to second position
+        if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
         {
-            // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
-            {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
-            }
-            else
-            {
-                _outboundPackets.push_front(std::move(packet));
-            }
+            auto it = _outboundPackets.begin();
+            it++; // Second position
+            _outboundPackets.insert(it, OutboundPacket{ buffer });
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_front(OutboundPacket{ buffer });
         }
     }
+    else
+    {
+        _outboundPackets.push_back(OutboundPacket{ buffer });
+    }
 }
 
 void NetworkConnection::Disconnect()
@@ -167,9 +295,39 @@ bool NetworkConnection::IsValid() const
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    while (!_outboundPackets.empty())
     {
-        _outboundPackets.pop_front();
+        // Hand as many queued packets as possible to a single send call.
+        std::array<SocketSendBuffer, MaxSocketSendBuffers> buffers;
+        size_t count = 0;
+        size_t bytesQueued = 0;
+        for (auto it = _outboundPackets.begin(); it != _outboundPackets.end() && count < buffers.size(); it++)
+        {
+            const auto& bytes = it->Buffer->Bytes;
+            buffers[count++] = { bytes.data() + it->BytesTransferred, bytes.size() - it->BytesTransferred };
+            bytesQueued += bytes.size() - it->BytesTransferred;
+        }
+
+        size_t sent = Socket->SendData(buffers.data(), count);
+        const bool sentEverything = sent == bytesQueued;
+        while (sent > 0)
+        {
+            auto& packet = _outboundPackets.front();
+            const auto packetSize = packet.Buffer->Bytes.size();
+            const auto remaining = packetSize - packet.BytesTransferred;
+            if (sent < remaining)
+            {
+                packet.BytesTransferred += sent;
+                break;
+            }
+
+            sent -= remaining;
+            RecordPacketStats(packet.Buffer->Id, packetSize, true);
+            _outboundPackets.pop_front();
+        }
+
+        if (!sentEverything)
+            break;
     }
 }
 
@@ -206,12 +364,11 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
@@ -11,6 +11,7 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../core/ContentSplitter.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
@@ -22,6 +23,7 @@
 #    include <vector>
 
 class NetworkPlayer;
+struct NetworkCompression;
 struct ObjectRepositoryItem;
 
 class NetworkConnection final
@@ -37,17 +39,31 @@ public:
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool ShouldDisconnect = false;
+    // Spectators of a relay are only passed the packets of the server once they have been sent the map.
+    bool MapSent = false;
+    // The capabilities the other end announced during authentication.
+    uint32_t Capabilities = 0;
+    // Park a desynchronised client is being resynchronised to, kept until the client has asked for the pieces of it
+    // that it lacks.
+    std::vector<uint8_t> ResyncPark;
+    std::vector<ContentPiece> ResyncPieces;
+    uint32_t LastResyncTime = 0;
 
     NetworkConnection();
     ~NetworkConnection();
 
     NetworkReadPacket ReadPacket();
     void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(const std::shared_ptr<const NetworkPacketBuffer>& buffer, bool front = false);
+
+    /**
+     * From now on tick and game action packets are sent deflated and compressed packets are inflated when read. Each
+     * direction keeps one stream for the lifetime of the connection, so packets are compressed against the ones before.
+     * Both ends must enable it right after the packet that finished the negotiation.
+     */
+    void EnableCompression();
+    bool IsCompressionEnabled() const;
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
@@ -63,12 +79,21 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    struct OutboundPacket
+    {
+        std::shared_ptr<const NetworkPacketBuffer> Buffer;
+        size_t BytesTransferred = 0;
+    };
+
+    std::deque<OutboundPacket> _outboundPackets;
     uint32_t _lastPacketTime = 0;
     std::string _lastDisconnectReason;
+    std::unique_ptr<NetworkCompression> _compression;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void QueueBuffer(const std::shared_ptr<const NetworkPacketBuffer>& buffer, bool front);
+    std::shared_ptr<const NetworkPacketBuffer> Compress(const NetworkPacketBuffer& buffer);
+    bool Decompress(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t packetSize, bool sending);
 };
 
 #endif // DISABLE_NETWORK
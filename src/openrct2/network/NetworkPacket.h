@@ -25,6 +25,16 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * A packet in the form it is sent in, header included. It is not modified once created so the
+ * same buffer can be queued for every connection a packet is broadcast to.
+ */
+struct NetworkPacketBuffer
+{
+    NetworkCommand Id = NetworkCommand::Invalid;
+    std::vector<uint8_t> Bytes;
+};
+
 struct NetworkPacket final
 {
     NetworkPacket() = default;
@@ -36,7 +46,10 @@ struct NetworkPacket final
     NetworkCommand GetCommand() const;
 
     void Clear();
-    bool CommandRequiresAuth();
+    bool CommandRequiresAuth() const;
+    static bool CommandRequiresAuth(NetworkCommand id);
+
+    std::shared_ptr<const NetworkPacketBuffer> CreateBuffer() const;
 
     const uint8_t* Read(size_t size);
     std::string_view ReadString();
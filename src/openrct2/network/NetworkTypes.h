@@ -25,6 +25,12 @@ enum
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
 };
 
+enum
+{
+    NETWORK_CAPABILITY_COMPRESSION = 1 << 0,
+    NETWORK_CAPABILITY_RESYNC = 1 << 1,
+};
+
 enum
 {
     NETWORK_MODE_NONE,
@@ -83,6 +89,11 @@ enum class NetworkCommand : uint32_t
     GameState,
     Scripts,
     Heartbeat,
+    Compressed,
+    ResyncRequest,
+    ResyncManifest,
+    ResyncPieceRequest,
+    ResyncPieces,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -237,24 +237,42 @@ bool ServerList::WriteFavourites(const std::vector<ServerListEntry>& entries) co
     }
 }
 
-std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync(const INetworkEndpoint& broadcastEndpoint) const
+std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync() const
 {
-    auto broadcastAddress = broadcastEndpoint.GetHostname();
-    return std::async(std::launch::async, [broadcastAddress] {
+    return std::async(std::launch::async, [] {
         constexpr auto RECV_DELAY_MS = 10;
         constexpr auto RECV_WAIT_MS = 2000;
 
+        // Query every possible LAN broadcast address from the same socket, so the replies can all be collected
+        // together instead of waiting on a thread and socket per address.
         std::string_view msg = NETWORK_LAN_BROADCAST_MSG;
         auto udpSocket = CreateUdpSocket();
-
-        log_verbose("Broadcasting %zu bytes to the LAN (%s)", msg.size(), broadcastAddress.c_str());
-        auto len = udpSocket->SendData(broadcastAddress, NETWORK_LAN_BROADCAST_PORT, msg.data(), msg.size());
-        if (len != msg.size())
+        bool broadcastSent = false;
+        for (const auto& broadcastEndpoint : GetBroadcastAddresses())
         {
-            throw std::runtime_error("Unable to broadcast server query.");
+            try
+            {
+                auto broadcastAddress = broadcastEndpoint->GetHostname();
+                log_verbose("Broadcasting %zu bytes to the LAN (%s)", msg.size(), broadcastAddress.c_str());
+                auto len = udpSocket->SendData(broadcastAddress, NETWORK_LAN_BROADCAST_PORT, msg.data(), msg.size());
+                if (len == msg.size())
+                {
+                    broadcastSent = true;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                // Ignore any exceptions from a particular broadcast address
+                log_warning("Unable to broadcast server query: %s", e.what());
+            }
         }
 
         std::vector<ServerListEntry> entries;
+        if (!broadcastSent)
+        {
+            return entries;
+        }
+
         for (int i = 0; i < (RECV_WAIT_MS / RECV_DELAY_MS); i++)
         {
             try
@@ -293,38 +311,6 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync(
     });
 }
 
-std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync() const
-{
-    return std::async(std::launch::async, [&] {
-        // Get all possible LAN broadcast addresses
-        auto broadcastEndpoints = GetBroadcastAddresses();
-
-        // Spin off a fetch for each broadcast address
-        std::vector<std::future<std::vector<ServerListEntry>>> futures;
-        for (const auto& broadcastEndpoint : broadcastEndpoints)
-        {
-            auto f = FetchLocalServerListAsync(*broadcastEndpoint);
-            futures.push_back(std::move(f));
-        }
-
-        // Wait and merge all results
-        std::vector<ServerListEntry> mergedEntries;
-        for (auto& f : futures)
-        {
-            try
-            {
-                auto entries = f.get();
-                mergedEntries.insert(mergedEntries.begin(), entries.begin(), entries.end());
-            }
-            catch (...)
-            {
-                // Ignore any exceptions from a particular broadcast fetch
-            }
-        }
-        return mergedEntries;
-    });
-}
-
 std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync() const
 {
 #    ifdef DISABLE_HTTP
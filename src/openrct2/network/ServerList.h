@@ -53,7 +53,6 @@ private:
     void Sort();
     std::vector<ServerListEntry> ReadFavourites() const;
     bool WriteFavourites(const std::vector<ServerListEntry>& entries) const;
-    std::future<std::vector<ServerListEntry>> FetchLocalServerListAsync(const INetworkEndpoint& broadcastEndpoint) const;
 
 public:
     ServerListEntry& GetServer(size_t index);
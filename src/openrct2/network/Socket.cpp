@@ -9,6 +9,8 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
+#    include <array>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -41,6 +43,8 @@
         #define SHUT_RDWR SD_BOTH
     #endif
     #define FLAG_NO_PIPE 0
+    #define poll WSAPoll
+    using nfds_t = ULONG;
 #else
     #include <arpa/inet.h>
     #include <cerrno>
@@ -49,8 +53,10 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -273,6 +279,11 @@ public:
         return _status;
     }
 
+    SOCKET GetHandle() const
+    {
+        return _socket;
+    }
+
     const char* GetError() const override
     {
         return _error.empty() ? nullptr : _error.c_str();
@@ -563,6 +574,46 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketSendBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, MaxSocketSendBuffers);
+        size_t totalSent = 0;
+#    ifdef _WIN32
+        std::array<WSABUF, MaxSocketSendBuffers> wsaBuffers;
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers.data(), static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) != SOCKET_ERROR)
+        {
+            totalSent = sentBytes;
+        }
+#    else
+        std::array<iovec, MaxSocketSendBuffers> ioBuffers;
+        for (size_t i = 0; i < count; i++)
+        {
+            ioBuffers[i].iov_base = const_cast<void*>(buffers[i].Data);
+            ioBuffers[i].iov_len = buffers[i].Size;
+        }
+        msghdr message{};
+        message.msg_iov = ioBuffers.data();
+        message.msg_iovlen = count;
+        auto sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes != SOCKET_ERROR)
+        {
+            totalSent = static_cast<size_t>(sentBytes);
+        }
+#    endif
+        return totalSent;
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -887,6 +938,44 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+void GetReadableTcpSockets(const std::vector<const ITcpSocket*>& sockets, std::vector<bool>& readable)
+{
+    static std::vector<pollfd> fds;
+    static std::vector<size_t> fdSocketIndex;
+
+    // Anything that can not be polled counts as readable so the caller still tries to receive from it.
+    readable.assign(sockets.size(), true);
+    fds.clear();
+    fdSocketIndex.clear();
+    for (size_t i = 0; i < sockets.size(); i++)
+    {
+        const auto* tcpSocket = dynamic_cast<const TcpSocket*>(sockets[i]);
+        if (tcpSocket != nullptr && tcpSocket->GetStatus() == SocketStatus::Connected
+            && tcpSocket->GetHandle() != INVALID_SOCKET)
+        {
+            pollfd fd{};
+            fd.fd = tcpSocket->GetHandle();
+            fd.events = POLLIN;
+            fds.push_back(fd);
+            fdSocketIndex.push_back(i);
+        }
+    }
+    if (fds.empty())
+    {
+        return;
+    }
+
+    if (poll(fds.data(), static_cast<nfds_t>(fds.size()), 0) == SOCKET_ERROR)
+    {
+        return;
+    }
+    for (size_t i = 0; i < fds.size(); i++)
+    {
+        // Hang ups and errors are reported as readable so the receive picks up the disconnect.
+        readable[fdSocketIndex[i]] = fds[i].revents != 0;
+    }
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
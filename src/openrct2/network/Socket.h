@@ -45,6 +45,18 @@ struct INetworkEndpoint
     virtual std::string GetHostname() const abstract;
 };
 
+/**
+ * A block of memory to send, several can be passed to a single send call.
+ */
+struct SocketSendBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
+// Most buffers a single send call takes, any more are left for the next call.
+constexpr size_t MaxSocketSendBuffers = 64;
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -66,6 +78,8 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    // Sends the buffers in order with as few system calls as possible, returns the total number of bytes sent.
+    virtual size_t SendData(const SocketSendBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -102,6 +116,13 @@ public:
 [[nodiscard]] std::unique_ptr<IUdpSocket> CreateUdpSocket();
 [[nodiscard]] std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
+/**
+ * Finds out which of the given TCP sockets have something to receive, a disconnect or an error pending
+ * with a single poll call instead of one receive per socket. Sockets that can not be polled are always
+ * reported as readable.
+ */
+void GetReadableTcpSockets(const std::vector<const ITcpSocket*>& sockets, std::vector<bool>& readable);
+
 namespace Convert
 {
     uint16_t HostToNetwork(uint16_t value);
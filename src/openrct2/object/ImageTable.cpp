@@ -15,7 +15,9 @@
 #include "../core/File.h"
 #include "../core/FileScanner.h"
 #include "../core/IStream.hpp"
+#include "../core/JobPool.h"
 #include "../core/Json.hpp"
+#include "../core/MemoryAccounting.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/ImageImporter.h"
@@ -24,12 +26,57 @@
 #include "ObjectFactory.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stdexcept>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 
+// Image data can be loaded from paint threads, so the total is kept atomically rather than summing all tables.
+static std::atomic<size_t> _imageTablesMemory;
+static MemoryAccounting::Registration _imageTablesMemoryRegistration("imageTables", [] { return _imageTablesMemory.load(); });
+
+// Below this many images the cost of starting the pool threads outweighs decoding them in parallel.
+constexpr size_t MinParallelImageDecodes = 16;
+
+/**
+ * Runs decodeFn for every index, in parallel when there are enough images. decodeFn must not use the read context, as
+ * neither it nor the archive behind it are thread safe, so the data is read up front and errors are returned instead.
+ */
+template<typename TFn> static std::vector<std::string> DecodeImagesInParallel(size_t count, TFn decodeFn)
+{
+    std::vector<std::string> errors(count);
+    auto decode = [&decodeFn, &errors](size_t index) {
+        try
+        {
+            decodeFn(index);
+        }
+        catch (const std::exception& e)
+        {
+            errors[index] = e.what();
+        }
+    };
+
+    if (count < MinParallelImageDecodes)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            decode(i);
+        }
+    }
+    else
+    {
+        JobPool jobPool;
+        for (size_t i = 0; i < count; i++)
+        {
+            jobPool.AddTask([&decode, i]() { decode(i); });
+        }
+        jobPool.Join();
+    }
+    return errors;
+}
+
 struct ImageTable::RequiredImage
 {
     rct_g1_element g1{};
@@ -341,6 +388,7 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
 
 ImageTable::~ImageTable()
 {
+    _imageTablesMemory -= _memoryUsage;
     if (_data == nullptr)
     {
         for (auto& entry : _entries)
@@ -371,6 +419,32 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         auto dataSize = static_cast<size_t>(imageDataSize);
+
+        // Only read the image headers now if the object data can be read again when the images are needed
+        auto dataReader = _entries.empty() ? context->GetObjectDataReader() : nullptr;
+        if (dataReader != nullptr)
+        {
+            for (uint32_t i = 0; i < numImages; i++)
+            {
+                rct_g1_element g1Element{};
+                _pendingDataOffsets.push_back(stream->ReadValue<uint32_t>());
+                g1Element.width = stream->ReadValue<int16_t>();
+                g1Element.height = stream->ReadValue<int16_t>();
+                g1Element.x_offset = stream->ReadValue<int16_t>();
+                g1Element.y_offset = stream->ReadValue<int16_t>();
+                g1Element.flags = stream->ReadValue<uint16_t>();
+                g1Element.zoomed_offset = stream->ReadValue<uint16_t>();
+                _entries.push_back(g1Element);
+            }
+            AddMemoryUsage(numImages * sizeof(rct_g1_element));
+
+            _pendingDataPosition = static_cast<size_t>(stream->GetPosition());
+            _pendingDataSize = dataSize;
+            _pendingDataReader = std::move(dataReader);
+            stream->SetPosition(std::min<uint64_t>(stream->GetPosition() + dataSize, stream->GetLength()));
+            return;
+        }
+
         auto data = std::make_unique<uint8_t[]>(dataSize);
         if (data == nullptr)
         {
@@ -411,6 +485,7 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
 
         _data = std::move(data);
         _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
+        AddMemoryUsage(dataSize + newEntries.size() * sizeof(rct_g1_element));
     }
     catch (const std::exception&)
     {
@@ -419,9 +494,51 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
     }
 }
 
+void ImageTable::LoadPendingData() const
+{
+    if (_pendingDataReader == nullptr)
+    {
+        return;
+    }
+
+    auto data = std::make_unique<uint8_t[]>(_pendingDataSize);
+    try
+    {
+        auto objectData = _pendingDataReader();
+        size_t readBytes = 0;
+        if (_pendingDataPosition < objectData.size())
+        {
+            readBytes = std::min(objectData.size() - _pendingDataPosition, _pendingDataSize);
+            std::copy_n(objectData.data() + _pendingDataPosition, readBytes, data.get());
+        }
+        std::fill_n(data.get() + readBytes, _pendingDataSize - readBytes, 0);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to load object images: %s", e.what());
+        std::fill_n(data.get(), _pendingDataSize, 0);
+    }
+
+    for (size_t i = 0; i < _entries.size(); i++)
+    {
+        _entries[i].offset = data.get() + _pendingDataOffsets[i];
+    }
+    _data = std::move(data);
+    _pendingDataReader = nullptr;
+    AddMemoryUsage(_pendingDataSize);
+}
+
+void ImageTable::AddMemoryUsage(size_t bytes) const
+{
+    _memoryUsage += bytes;
+    _imageTablesMemory += bytes;
+}
+
 std::vector<std::pair<std::string, Image>> ImageTable::GetImageSources(IReadObjectContext* context, json_t& jsonImages)
 {
     std::vector<std::pair<std::string, Image>> result;
+    std::vector<std::vector<uint8_t>> imageData;
+    std::vector<IMAGE_FORMAT> imageFormats;
     for (auto& jsonImage : jsonImages)
     {
         if (jsonImage.is_object())
@@ -433,13 +550,74 @@ std::vector<std::pair<std::string, Image>> ImageTable::GetImageSources(IReadObje
             });
             if (itSource == result.end())
             {
-                auto imageData = context->GetData(path);
-                auto imageFormat = keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32;
-                auto image = Imaging::ReadFromBuffer(imageData, imageFormat);
-                auto pair = std::make_pair<std::string, Image>(std::move(path), std::move(image));
-                result.push_back(std::move(pair));
+                imageData.push_back(context->GetData(path));
+                imageFormats.push_back(keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32);
+                result.emplace_back(std::move(path), Image());
+            }
+        }
+    }
+
+    auto errors = DecodeImagesInParallel(result.size(), [&](size_t index) {
+        result[index].second = Imaging::ReadFromBuffer(imageData[index], imageFormats[index]);
+    });
+    for (size_t i = 0; i < errors.size(); i++)
+    {
+        if (!errors[i].empty())
+        {
+            throw std::runtime_error(errors[i]);
+        }
+    }
+    return result;
+}
+
+std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ImportImageFiles(
+    IReadObjectContext* context, json_t& jsonImages)
+{
+    std::vector<std::unique_ptr<RequiredImage>> result;
+    std::vector<std::string> paths;
+    std::vector<std::vector<uint8_t>> imageData;
+    std::vector<size_t> resultIndices;
+    for (auto& jsonImage : jsonImages)
+    {
+        if (jsonImage.is_string())
+        {
+            auto path = jsonImage.get<std::string>();
+            if (!path.empty() && path[0] != '$')
+            {
+                try
+                {
+                    imageData.push_back(context->GetData(path));
+                    paths.push_back(std::move(path));
+                    resultIndices.push_back(result.size());
+                }
+                catch (const std::exception& e)
+                {
+                    auto msg = String::StdFormat("Unable to load image '%s': %s", path.c_str(), e.what());
+                    context->LogWarning(ObjectError::BadImageTable, msg.c_str());
+                    result.push_back(std::make_unique<RequiredImage>());
+                    continue;
+                }
             }
         }
+        result.emplace_back();
+    }
+
+    auto errors = DecodeImagesInParallel(paths.size(), [&](size_t index) {
+        auto image = Imaging::ReadFromBuffer(imageData[index]);
+
+        ImageImporter importer;
+        auto importResult = importer.Import(image, 0, 0, ImageImporter::IMPORT_FLAGS::RLE);
+
+        result[resultIndices[index]] = std::make_unique<RequiredImage>(importResult.Element);
+    });
+    for (size_t i = 0; i < errors.size(); i++)
+    {
+        if (!errors[i].empty())
+        {
+            auto msg = String::StdFormat("Unable to load image '%s': %s", paths[i].c_str(), errors[i].c_str());
+            context->LogWarning(ObjectError::BadImageTable, msg.c_str());
+            result[resultIndices[i]] = std::make_unique<RequiredImage>();
+        }
     }
     return result;
 }
@@ -462,10 +640,17 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
         }
 
         auto imageSources = GetImageSources(context, jsonImages);
+        auto imageFiles = ImportImageFiles(context, jsonImages);
 
+        size_t index = 0;
         for (auto& jsonImage : jsonImages)
         {
-            if (jsonImage.is_string())
+            auto& imageFile = imageFiles[index++];
+            if (imageFile != nullptr)
+            {
+                allImages.push_back(std::move(imageFile));
+            }
+            else if (jsonImage.is_string())
             {
                 auto strImage = jsonImage.get<std::string>();
                 auto images = ParseImages(context, strImage);
@@ -533,4 +718,5 @@ void ImageTable::AddImage(const rct_g1_element* g1)
         std::copy_n(g1->offset, length, newg1.offset);
     }
     _entries.push_back(std::move(newg1));
+    AddMemoryUsage(length + sizeof(rct_g1_element));
 }
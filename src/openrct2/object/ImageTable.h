@@ -13,6 +13,7 @@
 #include "../core/JsonFwd.hpp"
 #include "../drawing/Drawing.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -26,14 +27,26 @@ namespace OpenRCT2
 class ImageTable
 {
 private:
-    std::unique_ptr<uint8_t[]> _data;
-    std::vector<rct_g1_element> _entries;
+    // Mutable as the image data of legacy objects is only read once the images are first requested.
+    mutable std::unique_ptr<uint8_t[]> _data;
+    mutable std::vector<rct_g1_element> _entries;
+    mutable std::function<std::vector<uint8_t>()> _pendingDataReader;
+    std::vector<uint32_t> _pendingDataOffsets;
+    size_t _pendingDataPosition{};
+    size_t _pendingDataSize{};
+    // Bytes of image data and headers owned by this table, reported to the memory accounting
+    mutable size_t _memoryUsage{};
 
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
      */
     struct RequiredImage;
     [[nodiscard]] std::vector<std::pair<std::string, Image>> GetImageSources(IReadObjectContext* context, json_t& jsonImages);
+    /**
+     * Imports every image that is given as a plain file path, returns one entry per image with null for the others.
+     */
+    [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImportImageFiles(
+        IReadObjectContext* context, json_t& jsonImages);
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> ParseImages(
         IReadObjectContext* context, std::string s);
     /**
@@ -45,6 +58,8 @@ private:
         IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range);
     [[nodiscard]] static std::vector<int32_t> ParseRange(std::string s);
     [[nodiscard]] static std::string FindLegacyObject(const std::string& name);
+    void LoadPendingData() const;
+    void AddMemoryUsage(size_t bytes) const;
 
 public:
     ImageTable() = default;
@@ -59,8 +74,20 @@ public:
     bool ReadJson(IReadObjectContext* context, json_t& root);
     const rct_g1_element* GetImages() const
     {
+        LoadPendingData();
         return _entries.data();
     }
+    /**
+     * Returns the images without loading any image data that is still pending, the offset of those images is null.
+     */
+    const rct_g1_element* GetImageHeaders() const
+    {
+        return _entries.data();
+    }
+    bool IsLoaded() const
+    {
+        return _pendingDataReader == nullptr;
+    }
     uint32_t GetCount() const
     {
         return static_cast<uint32_t>(_entries.size());
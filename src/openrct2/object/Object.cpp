@@ -116,6 +116,10 @@ void Object::ReadLegacy(IReadObjectContext* context, OpenRCT2::IStream* stream)
 void Object::PopulateTablesFromJson(IReadObjectContext* context, json_t& root)
 {
     _stringTable.ReadJson(root);
+    if (!context->ShouldLoadAllLanguages())
+    {
+        _stringTable.RemoveUnusedLanguages();
+    }
     _usesFallbackImages = _imageTable.ReadJson(context, root);
 }
 
@@ -154,7 +158,7 @@ std::string Object::GetString(ObjectStringID index) const
 
 std::string Object::GetString(int32_t language, ObjectStringID index) const
 {
-    return GetStringTable().GetString(language, index);
+    return std::string(GetStringTable().GetString(language, index));
 }
 
 ObjectEntryDescriptor Object::GetScgWallsHeader() const
@@ -15,6 +15,7 @@
 #include "ImageTable.h"
 #include "StringTable.h"
 
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -236,8 +237,14 @@ struct IReadObjectContext
     virtual std::string_view GetObjectIdentifier() abstract;
     virtual IObjectRepository& GetObjectRepository() abstract;
     virtual bool ShouldLoadImages() abstract;
+    virtual bool ShouldLoadAllLanguages() abstract;
     virtual std::vector<uint8_t> GetData(std::string_view path) abstract;
     virtual ObjectAsset GetAsset(std::string_view path) abstract;
+    /**
+     * Returns a function that reads the data of the object again, or nullptr if images have to be loaded straight
+     * away.
+     */
+    virtual std::function<std::vector<uint8_t>()> GetObjectDataReader() abstract;
 
     virtual void LogVerbose(ObjectError code, const utf8* text) abstract;
     virtual void LogWarning(ObjectError code, const utf8* text) abstract;
@@ -106,6 +106,7 @@ private:
 
     std::string _identifier;
     bool _loadImages;
+    std::function<std::vector<uint8_t>()> _objectDataReader;
     std::string _basePath;
     bool _wasVerbose = false;
     bool _wasWarning = false;
@@ -150,6 +151,12 @@ public:
         return _loadImages;
     }
 
+    bool ShouldLoadAllLanguages() override
+    {
+        // Headless instances only ever use object strings of the current language.
+        return !gOpenRCT2NoGraphics;
+    }
+
     std::vector<uint8_t> GetData(std::string_view path) override
     {
         if (_fileDataRetriever != nullptr)
@@ -168,6 +175,16 @@ public:
         return {};
     }
 
+    std::function<std::vector<uint8_t>()> GetObjectDataReader() override
+    {
+        return _objectDataReader;
+    }
+
+    void SetObjectDataReader(std::function<std::vector<uint8_t>()> reader)
+    {
+        _objectDataReader = std::move(reader);
+    }
+
     void LogVerbose(ObjectError code, const utf8* text) override
     {
         _wasVerbose = true;
@@ -241,7 +258,24 @@ namespace ObjectFactory
         }
     }
 
-    std::unique_ptr<Object> CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path, bool loadImages)
+    static std::vector<uint8_t> ReadLegacyFileData(const std::string& path, const rct_object_entry& expectedEntry)
+    {
+        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        auto chunkReader = SawyerChunkReader(&fs);
+
+        auto entry = fs.ReadValue<rct_object_entry>();
+        if (std::memcmp(&entry, &expectedEntry, sizeof(entry)) != 0)
+        {
+            throw std::runtime_error("Object file has changed.");
+        }
+
+        auto chunk = chunkReader.ReadChunk();
+        const auto* data = static_cast<const uint8_t*>(chunk->GetData());
+        return std::vector<uint8_t>(data, data + chunk->GetLength());
+    }
+
+    std::unique_ptr<Object> CreateObjectFromLegacyFile(
+        IObjectRepository& objectRepository, const utf8* path, bool loadImages, bool loadImagesOnDemand)
     {
         log_verbose("CreateObjectFromLegacyFile(..., \"%s\")", path);
 
@@ -267,6 +301,11 @@ namespace ObjectFactory
 
                 auto chunkStream = OpenRCT2::MemoryStream(chunk->GetData(), chunk->GetLength());
                 auto readContext = ReadObjectContext(objectRepository, objectName, loadImages, nullptr);
+                if (loadImages && loadImagesOnDemand)
+                {
+                    readContext.SetObjectDataReader(
+                        [filePath = std::string(path), entry]() { return ReadLegacyFileData(filePath, entry); });
+                }
                 ReadObjectLegacy(*result, &readContext, &chunkStream);
                 if (readContext.WasError())
                 {
@@ -408,6 +447,9 @@ namespace ObjectFactory
         return ObjectType::None;
     }
 
+    // Only read by the image table, so objects loaded without images (e.g. for the index) can skip parsing them.
+    static const std::initializer_list<std::string_view> ImageKeys = { "images", "noCsgImages" };
+
     std::unique_ptr<Object> CreateObjectFromZipFile(IObjectRepository& objectRepository, std::string_view path, bool loadImages)
     {
         try
@@ -419,7 +461,7 @@ namespace ObjectFactory
                 throw std::runtime_error("Unable to open object.json.");
             }
 
-            json_t jRoot = Json::FromVector(jsonBytes);
+            json_t jRoot = loadImages ? Json::FromVector(jsonBytes) : Json::FromVector(jsonBytes, ImageKeys);
 
             if (jRoot.is_object())
             {
@@ -441,7 +483,7 @@ namespace ObjectFactory
 
         try
         {
-            json_t jRoot = Json::ReadFromFile(path.c_str());
+            json_t jRoot = loadImages ? Json::ReadFromFile(path.c_str()) : Json::ReadFromFile(path.c_str(), ImageKeys);
             auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
             return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
         }
@@ -21,8 +21,11 @@ enum class ObjectType : uint8_t;
 
 namespace ObjectFactory
 {
+    /**
+     * @param loadImagesOnDemand Only read the image data from the file once the images are first requested.
+     */
     [[nodiscard]] std::unique_ptr<Object> CreateObjectFromLegacyFile(
-        IObjectRepository& objectRepository, const utf8* path, bool loadImages);
+        IObjectRepository& objectRepository, const utf8* path, bool loadImages, bool loadImagesOnDemand = false);
     [[nodiscard]] std::unique_ptr<Object> CreateObjectFromLegacyData(
         IObjectRepository& objectRepository, const rct_object_entry* entry, const void* data, size_t dataSize);
     [[nodiscard]] std::unique_ptr<Object> CreateObjectFromZipFile(
@@ -12,8 +12,10 @@
 #include "../Context.h"
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
+#include "../core/JobPool.h"
 #include "../core/Memory.hpp"
 #include "../localisation/StringIds.h"
+#include "../paint/tile_element/Paint.TileElement.h"
 #include "../ride/Ride.h"
 #include "../util/Util.h"
 #include "FootpathItemObject.h"
@@ -29,8 +31,6 @@
 #include <algorithm>
 #include <array>
 #include <memory>
-#include <mutex>
-#include <thread>
 #include <unordered_set>
 
 class ObjectManager final : public IObjectManager
@@ -178,6 +178,7 @@ public:
         // Update indices.
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        tile_element_paint_cache_clear();
     }
 
     void UnloadObjects(const std::vector<ObjectEntryDescriptor>& entries) override
@@ -205,6 +206,7 @@ public:
         {
             UpdateSceneryGroupIndexes();
             ResetTypeToRideEntryIndexMap();
+            tile_element_paint_cache_clear();
         }
     }
 
@@ -216,6 +218,7 @@ public:
         }
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        tile_element_paint_cache_clear();
     }
 
     void ResetObjects() override
@@ -230,6 +233,33 @@ public:
         }
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        tile_element_paint_cache_clear();
+    }
+
+    void ReloadObject(const ObjectRepositoryItem* ori) override
+    {
+        auto* oldObject = ori->LoadedObject.get();
+        if (oldObject == nullptr)
+            return;
+
+        // Load the new object first so the old one stays in use if the file is broken
+        auto newObject = _objectRepository.LoadObject(ori);
+        if (newObject == nullptr)
+        {
+            Console::Error::WriteLine("Unable to reload object: '%s'", ori->Path.c_str());
+            return;
+        }
+        newObject->Load();
+
+        auto* loadedObject = newObject.get();
+        oldObject->Unload();
+        std::replace(_loadedObjects.begin(), _loadedObjects.end(), oldObject, loadedObject);
+        _objectRepository.UnregisterLoadedObject(ori, oldObject);
+        _objectRepository.RegisterLoadedObject(ori, std::move(newObject));
+
+        UpdateSceneryGroupIndexes();
+        ResetTypeToRideEntryIndexMap();
+        tile_element_paint_cache_clear();
     }
 
     std::vector<const ObjectRepositoryItem*> GetPackableObjects() override
@@ -322,6 +352,7 @@ private:
                 _loadedObjects[slot.value()] = object;
                 UpdateSceneryGroupIndexes();
                 ResetTypeToRideEntryIndexMap();
+                tile_element_paint_cache_clear();
             }
         }
         return loadedObject;
@@ -504,30 +535,6 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
-    {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
-        {
-            t.join();
-        }
-    }
-
     void LoadObjects(std::vector<const ObjectRepositoryItem*>& requiredObjects)
     {
         std::vector<Object*> objects;
@@ -536,9 +543,26 @@ private:
         objects.resize(OBJECT_ENTRY_COUNT);
         newLoadedObjects.reserve(OBJECT_ENTRY_COUNT);
 
-        // Read objects
-        std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &newLoadedObjects](size_t i) {
+        // Read objects, each task only writes to its own slot so no locking is required.
+        std::vector<std::unique_ptr<Object>> readObjects(requiredObjects.size());
+        {
+            JobPool jobPool;
+            for (size_t i = 0; i < requiredObjects.size(); i++)
+            {
+                const auto* requiredObject = requiredObjects[i];
+                if (requiredObject != nullptr && requiredObject->LoadedObject == nullptr)
+                {
+                    jobPool.AddTask([this, requiredObject, &readObject = readObjects[i]]() {
+                        readObject = _objectRepository.LoadObject(requiredObject);
+                    });
+                }
+            }
+            jobPool.Join();
+        }
+
+        // Register objects in list order so the result does not depend on thread timing.
+        for (size_t i = 0; i < requiredObjects.size(); i++)
+        {
             auto* requiredObject = requiredObjects[i];
             Object* object = nullptr;
             if (requiredObject != nullptr)
@@ -548,8 +572,7 @@ private:
                 {
                     // Object requires to be loaded, if the object successfully loads it will register it
                     // as a loaded object otherwise placed into the badObjects list.
-                    auto newObject = _objectRepository.LoadObject(requiredObject);
-                    std::lock_guard<std::mutex> guard(commonMutex);
+                    auto& newObject = readObjects[i];
                     if (newObject == nullptr)
                     {
                         badObjects.push_back(ObjectEntryDescriptor(requiredObject->ObjectEntry));
@@ -569,7 +592,7 @@ private:
                 }
             }
             objects[i] = object;
-        });
+        }
 
         // Load objects
         for (auto* obj : newLoadedObjects)
@@ -41,6 +41,7 @@ struct IObjectManager
     virtual void UnloadAll() abstract;
 
     virtual void ResetObjects() abstract;
+    virtual void ReloadObject(const ObjectRepositoryItem* ori) abstract;
 
     virtual std::vector<const ObjectRepositoryItem*> GetPackableObjects() abstract;
     virtual const std::vector<ObjectEntryIndex>& GetAllRideEntries(uint8_t rideType) abstract;
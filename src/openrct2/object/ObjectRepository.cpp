@@ -271,7 +271,7 @@ public:
             return ObjectFactory::CreateObjectFromZipFile(*this, ori->Path, !gOpenRCT2NoGraphics);
         }
 
-        return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str(), !gOpenRCT2NoGraphics);
+        return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str(), !gOpenRCT2NoGraphics, true);
     }
 
     void RegisterLoadedObject(const ObjectRepositoryItem* ori, std::unique_ptr<Object>&& object) override
@@ -291,6 +291,46 @@ public:
         }
     }
 
+    const ObjectRepositoryItem* UpdateObjectFromFile(const std::string& path) override
+    {
+        auto language = LocalisationService_GetCurrentLanguage();
+        auto [isValid, newItem] = _fileIndex.Create(language, path);
+        if (!isValid)
+        {
+            Console::Error::WriteLine("Unable to read object: '%s'", path.c_str());
+            return nullptr;
+        }
+
+        auto it = std::find_if(
+            _items.begin(), _items.end(), [&path](const ObjectRepositoryItem& item) { return Path::Equals(item.Path, path); });
+        if (it == _items.end())
+        {
+            return AddItem(newItem) ? &_items.back() : nullptr;
+        }
+
+        auto& item = *it;
+        if (!item.Identifier.empty())
+        {
+            _newItemMap.erase(item.Identifier);
+        }
+        if (!item.ObjectEntry.IsEmpty())
+        {
+            _itemMap.erase(item.ObjectEntry);
+        }
+        newItem.Id = item.Id;
+        newItem.LoadedObject = std::move(item.LoadedObject);
+        item = std::move(newItem);
+        if (!item.Identifier.empty())
+        {
+            _newItemMap[item.Identifier] = item.Id;
+        }
+        if (!item.ObjectEntry.IsEmpty())
+        {
+            _itemMap[item.ObjectEntry] = item.Id;
+        }
+        return &item;
+    }
+
     void AddObject(const rct_object_entry* objectEntry, const void* data, size_t dataSize) override
     {
         utf8 objectName[9];
@@ -87,6 +87,13 @@ struct IObjectRepository
     virtual void RegisterLoadedObject(const ObjectRepositoryItem* ori, std::unique_ptr<Object>&& object) abstract;
     virtual void UnregisterLoadedObject(const ObjectRepositoryItem* ori, Object* object) abstract;
 
+    /**
+     * Rescans a single object file, replacing the entry with the same path or adding a new one.
+     * An object loaded from the file is kept until it is reloaded.
+     * @return the updated entry, or nullptr if the file is not a valid object.
+     */
+    virtual const ObjectRepositoryItem* UpdateObjectFromFile(const std::string& path) abstract;
+
     virtual void AddObject(const rct_object_entry* objectEntry, const void* data, size_t dataSize) abstract;
     virtual void AddObjectFromFile(
         ObjectGeneration generation, std::string_view objectName, const void* data, size_t dataSize) abstract;
@@ -0,0 +1,139 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PackedObjectRecorder.h"
+
+#include "../core/MemoryStream.h"
+#include "../rct12/SawyerChunkReader.h"
+#include "Object.h"
+
+using namespace OpenRCT2;
+
+PackedObjectRecorder::PackedObjectRecorder(IObjectRepository& objectRepository)
+    : _objectRepository(objectRepository)
+{
+}
+
+bool PackedObjectRecorder::HasPackedObjects() const
+{
+    return !_packedObjects.empty() || !_packedObjectFiles.empty();
+}
+
+void PackedObjectRecorder::AddPackedObjects()
+{
+    for (auto& data : _packedObjects)
+    {
+        MemoryStream ms(data.data(), data.size());
+        _objectRepository.ExportPackedObject(&ms);
+    }
+    _packedObjects.clear();
+
+    for (const auto& file : _packedObjectFiles)
+    {
+        // Another park may have added the same object since it was recorded.
+        const auto* existing = file.Generation == ObjectGeneration::DAT ? _objectRepository.FindObjectLegacy(file.Name)
+                                                                        : _objectRepository.FindObject(file.Name);
+        if (existing == nullptr)
+        {
+            _objectRepository.AddObjectFromFile(file.Generation, file.Name, file.Data.data(), file.Data.size());
+        }
+    }
+    _packedObjectFiles.clear();
+}
+
+void PackedObjectRecorder::LoadOrConstruct(int32_t language)
+{
+    _objectRepository.LoadOrConstruct(language);
+}
+
+void PackedObjectRecorder::Construct(int32_t language)
+{
+    _objectRepository.Construct(language);
+}
+
+size_t PackedObjectRecorder::GetNumObjects() const
+{
+    return _objectRepository.GetNumObjects();
+}
+
+const ObjectRepositoryItem* PackedObjectRecorder::GetObjects() const
+{
+    return _objectRepository.GetObjects();
+}
+
+const ObjectRepositoryItem* PackedObjectRecorder::FindObjectLegacy(std::string_view legacyIdentifier) const
+{
+    return _objectRepository.FindObjectLegacy(legacyIdentifier);
+}
+
+const ObjectRepositoryItem* PackedObjectRecorder::FindObject(std::string_view identifier) const
+{
+    return _objectRepository.FindObject(identifier);
+}
+
+const ObjectRepositoryItem* PackedObjectRecorder::FindObject(const rct_object_entry* objectEntry) const
+{
+    return _objectRepository.FindObject(objectEntry);
+}
+
+const ObjectRepositoryItem* PackedObjectRecorder::FindObject(const ObjectEntryDescriptor& oed) const
+{
+    return _objectRepository.FindObject(oed);
+}
+
+std::unique_ptr<Object> PackedObjectRecorder::LoadObject(const ObjectRepositoryItem* ori)
+{
+    return _objectRepository.LoadObject(ori);
+}
+
+void PackedObjectRecorder::RegisterLoadedObject(const ObjectRepositoryItem* ori, std::unique_ptr<Object>&& object)
+{
+    _objectRepository.RegisterLoadedObject(ori, std::move(object));
+}
+
+void PackedObjectRecorder::UnregisterLoadedObject(const ObjectRepositoryItem* ori, Object* object)
+{
+    _objectRepository.UnregisterLoadedObject(ori, object);
+}
+
+const ObjectRepositoryItem* PackedObjectRecorder::UpdateObjectFromFile(const std::string& path)
+{
+    return _objectRepository.UpdateObjectFromFile(path);
+}
+
+void PackedObjectRecorder::AddObject(const rct_object_entry* objectEntry, const void* data, size_t dataSize)
+{
+    _objectRepository.AddObject(objectEntry, data, dataSize);
+}
+
+void PackedObjectRecorder::AddObjectFromFile(
+    ObjectGeneration generation, std::string_view objectName, const void* data, size_t dataSize)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    _packedObjectFiles.push_back({ generation, std::string(objectName), std::vector<uint8_t>(bytes, bytes + dataSize) });
+}
+
+void PackedObjectRecorder::ExportPackedObject(IStream* stream)
+{
+    // Copy the entry and its chunk as they are, they are decoded once they are added to the repository.
+    const auto start = stream->GetPosition();
+    stream->Seek(sizeof(rct_object_entry), STREAM_SEEK_CURRENT);
+    SawyerChunkReader(stream).SkipChunk();
+    const auto length = stream->GetPosition() - start;
+
+    std::vector<uint8_t> data(length);
+    stream->SetPosition(start);
+    stream->Read(data.data(), length);
+    _packedObjects.push_back(std::move(data));
+}
+
+void PackedObjectRecorder::WritePackedObjects(IStream* stream, std::vector<const ObjectRepositoryItem*>& objects)
+{
+    _objectRepository.WritePackedObjects(stream, objects);
+}
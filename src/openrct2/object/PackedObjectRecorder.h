@@ -0,0 +1,65 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "ObjectRepository.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Object repository handed to importers running on a worker thread. Packed objects are recorded instead of being added
+ * straight away so the shared repository is only ever modified by the main thread, every other call is forwarded.
+ */
+class PackedObjectRecorder final : public IObjectRepository
+{
+private:
+    struct PackedObjectFile
+    {
+        ObjectGeneration Generation;
+        std::string Name;
+        std::vector<uint8_t> Data;
+    };
+
+    IObjectRepository& _objectRepository;
+    std::vector<std::vector<uint8_t>> _packedObjects;
+    std::vector<PackedObjectFile> _packedObjectFiles;
+
+public:
+    explicit PackedObjectRecorder(IObjectRepository& objectRepository);
+
+    bool HasPackedObjects() const;
+
+    /**
+     * Adds the recorded packed objects to the shared repository, must be called from the main thread.
+     */
+    void AddPackedObjects();
+
+    void LoadOrConstruct(int32_t language) override;
+    void Construct(int32_t language) override;
+    size_t GetNumObjects() const override;
+    const ObjectRepositoryItem* GetObjects() const override;
+    const ObjectRepositoryItem* FindObjectLegacy(std::string_view legacyIdentifier) const override;
+    const ObjectRepositoryItem* FindObject(std::string_view identifier) const override;
+    const ObjectRepositoryItem* FindObject(const rct_object_entry* objectEntry) const override;
+    const ObjectRepositoryItem* FindObject(const ObjectEntryDescriptor& oed) const override;
+
+    std::unique_ptr<Object> LoadObject(const ObjectRepositoryItem* ori) override;
+    void RegisterLoadedObject(const ObjectRepositoryItem* ori, std::unique_ptr<Object>&& object) override;
+    void UnregisterLoadedObject(const ObjectRepositoryItem* ori, Object* object) override;
+
+    const ObjectRepositoryItem* UpdateObjectFromFile(const std::string& path) override;
+    void AddObject(const rct_object_entry* objectEntry, const void* data, size_t dataSize) override;
+    void AddObjectFromFile(
+        ObjectGeneration generation, std::string_view objectName, const void* data, size_t dataSize) override;
+
+    void ExportPackedObject(OpenRCT2::IStream* stream) override;
+    void WritePackedObjects(OpenRCT2::IStream* stream, std::vector<const ObjectRepositoryItem*>& objects) override;
+};
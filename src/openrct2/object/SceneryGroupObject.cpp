@@ -46,7 +46,7 @@ void SceneryGroupObject::Load()
 {
     GetStringTable().Sort();
     _legacyType.name = language_allocate_object_string(GetName());
-    _legacyType.image = gfx_object_allocate_images(GetImageTable().GetImages(), GetImageTable().GetCount());
+    _legacyType.image = gfx_object_allocate_images(GetImageTable());
     _legacyType.entry_count = 0;
 }
 
@@ -78,6 +78,10 @@ void StringTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream, O
         throw;
     }
     Sort();
+    if (!context->ShouldLoadAllLanguages())
+    {
+        RemoveUnusedLanguages();
+    }
 }
 
 ObjectStringID StringTable::ParseStringId(const std::string& s)
@@ -119,19 +123,17 @@ void StringTable::ReadJson(json_t& root)
     Sort();
 }
 
-std::string StringTable::GetString(ObjectStringID id) const
+std::string_view StringTable::GetString(ObjectStringID id) const
 {
-    for (auto& string : _strings)
+    auto index = EnumValue(id);
+    if (index >= _preferredStrings.size())
     {
-        if (string.Id == id)
-        {
-            return string.Text;
-        }
+        return {};
     }
-    return std::string();
+    return _preferredStrings[index];
 }
 
-std::string StringTable::GetString(uint8_t language, ObjectStringID id) const
+std::string_view StringTable::GetString(uint8_t language, ObjectStringID id) const
 {
     for (auto& string : _strings)
     {
@@ -140,7 +142,7 @@ std::string StringTable::GetString(uint8_t language, ObjectStringID id) const
             return string.Text;
         }
     }
-    return std::string();
+    return {};
 }
 
 void StringTable::SetString(ObjectStringID id, uint8_t language, const std::string& text)
@@ -150,6 +152,31 @@ void StringTable::SetString(ObjectStringID id, uint8_t language, const std::stri
     entry.LanguageId = language;
     entry.Text = text;
     _strings.push_back(std::move(entry));
+    UpdatePreferredStrings();
+}
+
+void StringTable::UpdatePreferredStrings()
+{
+    // Adding strings may have moved the others, the first string of each id is the preferred one.
+    _preferredStrings = {};
+    for (auto it = _strings.rbegin(); it != _strings.rend(); it++)
+    {
+        auto index = EnumValue(it->Id);
+        if (index < _preferredStrings.size())
+        {
+            _preferredStrings[index] = it->Text;
+        }
+    }
+}
+
+void StringTable::RemoveUnusedLanguages()
+{
+    // Strings are sorted by preference, only the first string of each id is ever returned without a language.
+    auto last = std::unique(_strings.begin(), _strings.end(), [](const StringTableEntry& a, const StringTableEntry& b) {
+        return a.Id == b.Id;
+    });
+    _strings.erase(last, _strings.end());
+    UpdatePreferredStrings();
 }
 
 void StringTable::Sort()
@@ -185,4 +212,5 @@ void StringTable::Sort()
         }
         return a.Id < b.Id;
     });
+    UpdatePreferredStrings();
 }
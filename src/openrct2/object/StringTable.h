@@ -13,7 +13,9 @@
 #include "../core/JsonFwd.hpp"
 #include "../localisation/Language.h"
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct IReadObjectContext;
@@ -34,6 +36,8 @@ enum class ObjectStringID : uint8_t
     VEHICLE_NAME = 3,
 };
 
+constexpr size_t ObjectStringIDCount = 4;
+
 struct StringTableEntry
 {
     ObjectStringID Id = ObjectStringID::UNKNOWN;
@@ -45,7 +49,11 @@ class StringTable
 {
 private:
     std::vector<StringTableEntry> _strings;
+    // The string returned for each id without a language, pointing into _strings.
+    std::array<std::string_view, ObjectStringIDCount> _preferredStrings;
+
     static ObjectStringID ParseStringId(const std::string& s);
+    void UpdatePreferredStrings();
 
 public:
     StringTable() = default;
@@ -58,7 +66,11 @@ public:
      */
     void ReadJson(json_t& root);
     void Sort();
-    std::string GetString(ObjectStringID id) const;
-    std::string GetString(uint8_t language, ObjectStringID id) const;
+    /**
+     * Removes all strings that are not used for the current language, the table must be sorted.
+     */
+    void RemoveUnusedLanguages();
+    std::string_view GetString(ObjectStringID id) const;
+    std::string_view GetString(uint8_t language, ObjectStringID id) const;
     void SetString(ObjectStringID id, uint8_t language, const std::string& text);
 };
@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/Profiler.h"
 #include "../drawing/Drawing.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Localisation.h"
@@ -85,6 +86,12 @@ static int32_t RemapPositionToQuadrant(const paint_struct& ps, uint8_t rotation)
 
 static void PaintSessionAddPSToQuadrant(paint_session& session, paint_struct* ps)
 {
+    if (session.TileRecording != nullptr)
+    {
+        session.TileRecording->push_back(ps);
+        return;
+    }
+
     const auto positionHash = RemapPositionToQuadrant(*ps, session.CurrentRotation);
 
     // Values below zero or above MaxPaintQuadrants are void, corners also share the same quadrant as void.
@@ -117,6 +124,19 @@ static constexpr bool ImageWithinDPI(const ScreenCoordsXY& imagePos, const rct_g
     return true;
 }
 
+/**
+ * From 1:4 zoom every drawn pixel samples 4 or more image pixels in each direction, so with detail culling enabled
+ * images smaller than one drawn pixel in both directions are dropped rather than adding a struct for at most a dot.
+ */
+static bool ImageBelowDetailThreshold(const rct_g1_element& g1, const rct_drawpixelinfo& dpi)
+{
+    if (!gConfigGeneral.zoomed_out_detail_culling || dpi.zoom_level < ZoomLevel{ 2 })
+        return false;
+
+    const int32_t drawnPixelSize = 1 * dpi.zoom_level;
+    return g1.width < drawnPixelSize && g1.height < drawnPixelSize;
+}
+
 static constexpr CoordsXYZ RotateBoundBoxSize(const CoordsXYZ& bbSize, const uint8_t rotation)
 {
     auto output = bbSize;
@@ -162,7 +182,9 @@ static paint_struct* CreateNormalPaintStruct(
 
     const auto imagePos = translate_3d_to_2d_with_z(session.CurrentRotation, swappedRotCoord);
 
-    if (!ImageWithinDPI(imagePos, *g1, session.DPI))
+    // Recorded tiles are culled when they are replayed.
+    if (session.TileRecording == nullptr
+        && (!ImageWithinDPI(imagePos, *g1, session.DPI) || ImageBelowDetailThreshold(*g1, session.DPI)))
     {
         return nullptr;
     }
@@ -244,6 +266,8 @@ template<uint8_t direction> void PaintSessionGenerateRotate(paint_session& sessi
  */
 void PaintSessionGenerate(paint_session& session)
 {
+    PROFILE_ZONE(PaintSetup);
+
     session.CurrentRotation = get_current_rotation();
     switch (DirectionFlipXAxis(session.CurrentRotation))
     {
@@ -455,6 +479,11 @@ template<int TRotation> static void PaintSessionArrange(PaintSessionCore& sessio
         quadrantIndex = session.QuadrantBackIndex;
         while (++quadrantIndex < session.QuadrantFrontIndex)
         {
+            // A pass only reorders nodes of the quadrant and its front neighbour. When both are empty the
+            // pass can not change the list and the next pass finds the same entry node from the older cache.
+            if (session.Quadrants[quadrantIndex] == nullptr && session.Quadrants[quadrantIndex + 1] == nullptr)
+                continue;
+
             ps_cache = PaintArrangeStructsHelperRotation<TRotation>(ps_cache, quadrantIndex & 0xFFFF, PaintSortFlags::None);
         }
     }
@@ -466,6 +495,8 @@ template<int TRotation> static void PaintSessionArrange(PaintSessionCore& sessio
  */
 void PaintSessionArrange(PaintSessionCore& session)
 {
+    PROFILE_ZONE(PaintSort);
+
     switch (session.CurrentRotation)
     {
         case 0:
@@ -521,12 +552,109 @@ static void PaintDrawStruct(paint_session& session, paint_struct* ps)
     }
 }
 
+void PaintRecordTile(const std::vector<paint_struct*>& parents, RecordedTilePaint& recording)
+{
+    for (const auto* parent : parents)
+    {
+        bool startsGroup = true;
+        for (const auto* ps = parent; ps != nullptr; ps = ps->children)
+        {
+            auto& recorded = recording.Structs.emplace_back();
+            recorded.PS = *ps;
+            recorded.PS.attached_ps = nullptr;
+            recorded.PS.children = nullptr;
+            recorded.PS.next_quadrant_ps = nullptr;
+            recorded.StartsGroup = startsGroup;
+            recorded.NumAttached = 0;
+            startsGroup = false;
+
+            for (const auto* attachedPS = ps->attached_ps; attachedPS != nullptr; attachedPS = attachedPS->next)
+            {
+                auto& recordedAttached = recording.Attached.emplace_back(*attachedPS);
+                recordedAttached.next = nullptr;
+                recorded.NumAttached++;
+            }
+        }
+    }
+}
+
+/**
+ * Adds a recorded tile to the session, culling it against the session's view the same
+ * way as when the structs are created: if a parent is not visible the first visible
+ * child takes its place.
+ */
+void PaintSessionReplayTile(paint_session& session, const RecordedTilePaint& recording)
+{
+    paint_struct* parent = nullptr;
+    paint_struct* previous = nullptr;
+    size_t attachedIndex = 0;
+    for (const auto& recorded : recording.Structs)
+    {
+        if (recorded.StartsGroup)
+        {
+            parent = nullptr;
+            previous = nullptr;
+        }
+        const auto firstAttached = attachedIndex;
+        attachedIndex += recorded.NumAttached;
+
+        const auto* g1 = gfx_get_g1_element(recorded.PS.image_id);
+        if (g1 == nullptr || !ImageWithinDPI({ recorded.PS.x, recorded.PS.y }, *g1, session.DPI)
+            || ImageBelowDetailThreshold(*g1, session.DPI))
+        {
+            continue;
+        }
+
+        auto* ps = session.AllocateNormalPaintEntry();
+        if (ps == nullptr)
+        {
+            break;
+        }
+        *ps = recorded.PS;
+        if (parent == nullptr)
+        {
+            parent = ps;
+            PaintSessionAddPSToQuadrant(session, ps);
+        }
+        else
+        {
+            previous->children = ps;
+        }
+        previous = ps;
+
+        attached_paint_struct* previousAttached = nullptr;
+        for (auto i = firstAttached; i < attachedIndex; i++)
+        {
+            auto* attachedPS = session.AllocateAttachedPaintEntry();
+            if (attachedPS == nullptr)
+            {
+                break;
+            }
+            *attachedPS = recording.Attached[i];
+            if (previousAttached == nullptr)
+            {
+                ps->attached_ps = attachedPS;
+            }
+            else
+            {
+                previousAttached->next = attachedPS;
+            }
+            previousAttached = attachedPS;
+        }
+    }
+
+    session.LastPS = nullptr;
+    session.LastAttachedPS = nullptr;
+}
+
 /**
  *
  *  rct2: 0x00688485
  */
 void PaintDrawStructs(paint_session& session)
 {
+    PROFILE_ZONE(PaintDraw);
+
     paint_struct* ps = &session.PaintHead;
 
     for (ps = ps->next_quadrant_ps; ps != nullptr;)
@@ -991,132 +1119,136 @@ void PaintDrawMoneyStructs(rct_drawpixelinfo* dpi, paint_string_struct* ps)
     } while ((ps = ps->next) != nullptr);
 }
 
-PaintEntryPool::Chain::Chain(PaintEntryPool* pool)
-    : Pool(pool)
+PaintEntryArena::Chain::Chain(PaintEntryArena* arena)
+    : Arena(arena)
 {
 }
 
-PaintEntryPool::Chain::Chain(Chain&& chain)
+PaintEntryArena::Chain::Chain(Chain&& chain)
 {
     *this = std::move(chain);
 }
 
-PaintEntryPool::Chain::~Chain()
+PaintEntryArena::Chain::~Chain()
 {
     Clear();
 }
 
-PaintEntryPool::Chain& PaintEntryPool::Chain::operator=(Chain&& chain) noexcept
+PaintEntryArena::Chain& PaintEntryArena::Chain::operator=(Chain&& chain) noexcept
 {
-    Pool = chain.Pool;
+    Clear();
+    Arena = chain.Arena;
     Head = chain.Head;
     Current = chain.Current;
-    chain.Pool = nullptr;
+    SlabCount = chain.SlabCount;
+    chain.Arena = nullptr;
     chain.Head = nullptr;
     chain.Current = nullptr;
+    chain.SlabCount = 0;
     return *this;
 }
 
-paint_entry* PaintEntryPool::Chain::Allocate()
+paint_entry* PaintEntryArena::Chain::AllocateSlab()
 {
-    if (Pool == nullptr)
+    if (Arena == nullptr)
     {
         return nullptr;
     }
 
+    auto* slab = Arena->AcquireSlab();
+    if (slab == nullptr)
+    {
+        // Unable to allocate any more slabs
+        return nullptr;
+    }
+
     if (Current == nullptr)
     {
         assert(Head == nullptr);
-        Head = Pool->AllocateNode();
-        if (Head == nullptr)
-        {
-            // Unable to allocate any more nodes
-            return nullptr;
-        }
-        Current = Head;
+        Head = slab;
     }
-    else if (Current->Count >= NodeSize)
+    else
     {
-        // We need another node
-        Current->Next = Pool->AllocateNode();
-        if (Current->Next == nullptr)
-        {
-            // Unable to allocate any more nodes
-            return nullptr;
-        }
-        Current = Current->Next;
+        Current->Next = slab;
     }
+    Current = slab;
+    SlabCount++;
 
-    assert(Current->Count < NodeSize);
-    return &Current->PaintStructs[Current->Count++];
+    return &Current->Entries[Current->Count++];
 }
 
-void PaintEntryPool::Chain::Clear()
+void PaintEntryArena::Chain::Clear()
 {
-    if (Pool != nullptr)
+    if (Arena != nullptr)
     {
-        Pool->FreeNodes(Head);
-        Head = nullptr;
-        Current = nullptr;
+        Arena->ReleaseChain(*this);
+        Arena = nullptr;
     }
-    assert(Head == nullptr);
-    assert(Current == nullptr);
+    Head = nullptr;
+    Current = nullptr;
+    SlabCount = 0;
 }
 
-size_t PaintEntryPool::Chain::GetCount() const
+size_t PaintEntryArena::Chain::GetCount() const
 {
-    size_t count = 0;
-    auto current = Head;
-    while (current != nullptr)
+    // Every slab but the current one is always completely filled.
+    if (Current == nullptr)
     {
-        count += current->Count;
-        current = current->Next;
+        return 0;
     }
-    return count;
+    return ((SlabCount - 1) * SlabSize) + Current->Count;
 }
 
-PaintEntryPool::~PaintEntryPool()
+PaintEntryArena::Slab* PaintEntryArena::AcquireSlab()
 {
-    for (auto node : _available)
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_nextSlab >= _slabs.size())
     {
-        delete node;
+        auto* slab = new (std::nothrow) Slab();
+        if (slab == nullptr)
+        {
+            return nullptr;
+        }
+        _slabs.emplace_back(slab);
+        _stats.SlabCount = _slabs.size();
+        _stats.ReservedEntries = _slabs.size() * SlabSize;
     }
-    _available.clear();
+
+    // Slabs are recycled lazily, reset the header only when it is handed out again.
+    auto* result = _slabs[_nextSlab++].get();
+    result->Next = nullptr;
+    result->Count = 0;
+    return result;
 }
 
-PaintEntryPool::Node* PaintEntryPool::AllocateNode()
+void PaintEntryArena::ReleaseChain(const Chain& chain)
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    PaintEntryPool::Node* result;
-    if (_available.size() > 0)
-    {
-        result = _available.back();
-        _available.pop_back();
-    }
-    else
+    assert(_activeChains > 0);
+    _frameEntries += chain.GetCount();
+    if (--_activeChains == 0)
     {
-        result = new (std::nothrow) PaintEntryPool::Node();
+        // Last chain of the frame, rewind the whole arena.
+        _nextSlab = 0;
+        _stats.LastFrameEntries = _frameEntries;
+        _stats.PeakFrameEntries = std::max(_stats.PeakFrameEntries, _frameEntries);
+        _frameEntries = 0;
     }
-    return result;
 }
 
-PaintEntryPool::Chain PaintEntryPool::Create()
+PaintEntryArena::Chain PaintEntryArena::Create()
 {
-    return PaintEntryPool::Chain(this);
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _activeChains++;
+    return PaintEntryArena::Chain(this);
 }
 
-void PaintEntryPool::FreeNodes(PaintEntryPool::Node* head)
+PaintEntryArena::Stats PaintEntryArena::GetStats() const
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    auto node = head;
-    while (node != nullptr)
-    {
-        auto next = node->Next;
-        node->Next = nullptr;
-        node->Count = 0;
-        _available.push_back(node);
-        node = next;
-    }
+    return _stats;
 }
@@ -16,9 +16,13 @@
 #include "../world/Location.hpp"
 #include "../world/Map.h"
 
+#include <array>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
+struct SurfaceElement;
 struct TileElement;
 enum class RailingEntrySupportType : uint8_t;
 enum class ViewportInteractionItem : uint8_t;
@@ -134,53 +138,75 @@ static constexpr int32_t MaxPaintQuadrants = MAXIMUM_MAP_SIZE_TECHNICAL * 2;
 #define TUNNEL_MAX_COUNT 65
 
 /**
- * A pool of paint_entry instances that can be rented out.
- * The internal implementation uses an unrolled linked list so that each
- * paint session can quickly allocate a new paint entry until it requires
- * another node / block of paint entries. Only the node allocation needs to
- * be thread safe.
+ * A frame-scoped arena of paint_entry instances.
+ * Each paint session rents a chain that bumps through large slabs owned by
+ * the arena, so only fetching another slab needs to be thread safe. Slabs are
+ * never handed back individually; once the last chain of a frame is released
+ * the arena is rewound in constant time and every slab becomes reusable.
  */
-class PaintEntryPool
+class PaintEntryArena
 {
-    static constexpr size_t NodeSize = 512;
+    static constexpr size_t SlabSize = 4096;
 
 public:
-    struct Node
+    struct Slab
     {
-        Node* Next{};
+        Slab* Next{};
         size_t Count{};
-        paint_entry PaintStructs[NodeSize]{};
+        paint_entry Entries[SlabSize];
     };
 
     struct Chain
     {
-        PaintEntryPool* Pool{};
-        Node* Head{};
-        Node* Current{};
+        PaintEntryArena* Arena{};
+        Slab* Head{};
+        Slab* Current{};
+        size_t SlabCount{};
 
         Chain() = default;
-        Chain(PaintEntryPool* pool);
+        Chain(PaintEntryArena* arena);
         Chain(Chain&& chain);
         ~Chain();
 
         Chain& operator=(Chain&& chain) noexcept;
 
-        paint_entry* Allocate();
+        paint_entry* Allocate()
+        {
+            if (Current != nullptr && Current->Count < SlabSize)
+            {
+                return &Current->Entries[Current->Count++];
+            }
+            return AllocateSlab();
+        }
         void Clear();
         size_t GetCount() const;
+
+    private:
+        paint_entry* AllocateSlab();
+    };
+
+    struct Stats
+    {
+        size_t SlabCount{};
+        size_t ReservedEntries{};
+        size_t LastFrameEntries{};
+        size_t PeakFrameEntries{};
     };
 
 private:
-    std::vector<Node*> _available;
-    std::mutex _mutex;
+    std::vector<std::unique_ptr<Slab>> _slabs;
+    size_t _nextSlab{};
+    size_t _activeChains{};
+    size_t _frameEntries{};
+    Stats _stats;
+    mutable std::mutex _mutex;
 
-    Node* AllocateNode();
+    Slab* AcquireSlab();
+    void ReleaseChain(const Chain& chain);
 
 public:
-    ~PaintEntryPool();
-
     Chain Create();
-    void FreeNodes(Node* head);
+    Stats GetStats() const;
 };
 
 struct PaintSessionCore
@@ -219,7 +245,12 @@ struct PaintSessionCore
 struct paint_session : public PaintSessionCore
 {
     rct_drawpixelinfo DPI;
-    PaintEntryPool::Chain PaintEntryChain;
+    PaintEntryArena::Chain PaintEntryChain;
+    // When set, parent paint structs are collected here instead of being culled and sorted into quadrants.
+    std::vector<paint_struct*>* TileRecording{};
+    // Surfaces next to MapPosition, looked up once per tile, see PaintGetNeighbourSurface.
+    std::array<const ::SurfaceElement*, 4> NeighbourSurfaces{};
+    bool NeighbourSurfacesValid{};
 
     paint_struct* AllocateNormalPaintEntry() noexcept
     {
@@ -282,6 +313,23 @@ struct RecordedPaintSession
     std::vector<paint_entry> Entries;
 };
 
+/**
+ * The paint structs of a single tile without any pointers, each group is a parent
+ * followed by its children and the attached structs are stored in struct order.
+ */
+struct RecordedTilePaint
+{
+    struct Struct
+    {
+        paint_struct PS;
+        uint16_t NumAttached;
+        bool StartsGroup;
+    };
+
+    std::vector<Struct> Structs;
+    std::vector<attached_paint_struct> Attached;
+};
+
 extern paint_session gPaintSession;
 
 // Globals for paint clipping
@@ -354,6 +402,8 @@ paint_session* PaintSessionAlloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void PaintSessionFree(paint_session* session);
 void PaintSessionGenerate(paint_session& session);
 void PaintSessionArrange(PaintSessionCore& session);
+void PaintRecordTile(const std::vector<paint_struct*>& parents, RecordedTilePaint& recording);
+void PaintSessionReplayTile(paint_session& session, const RecordedTilePaint& recording);
 void PaintDrawStructs(paint_session& session);
 void PaintDrawMoneyStructs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
 
@@ -14,6 +14,7 @@
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
 #include "../config/Config.h"
+#include "../core/PerformanceCounters.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
@@ -24,6 +25,7 @@
 #include "../paint/Paint.h"
 #include "../title/TitleScreen.h"
 #include "../ui/UiContext.h"
+#include "../world/Map.h"
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -32,6 +34,9 @@ using namespace OpenRCT2::Ui;
 
 Painter::Painter(const std::shared_ptr<IUiContext>& uiContext)
     : _uiContext(uiContext)
+    , _paintSessionsMemory("paintSessions", [this] { return _paintSessionPool.size() * sizeof(paint_session); })
+    , _paintEntriesMemory(
+          "paintEntries", [this] { return _paintEntryArena.GetStats().SlabCount * sizeof(PaintEntryArena::Slab); })
 {
 }
 
@@ -44,6 +49,8 @@ void Painter::Paint(IDrawingEngine& de)
     }
     else
     {
+        // Pass the tile invalidations collected since the last frame on to the viewports before drawing dirty blocks.
+        map_invalidate_flush();
         de.PaintWindows();
 
         update_palette_effects();
@@ -78,6 +85,13 @@ void Painter::Paint(IDrawingEngine& de)
         PaintFPS(dpi);
     }
     gCurrentDrawCount++;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (_lastFrameTime != std::chrono::steady_clock::time_point{})
+    {
+        PerformanceCounters::RecordFrame(now - _lastFrameTime);
+    }
+    _lastFrameTime = now;
 }
 
 void Painter::PaintReplayNotice(rct_drawpixelinfo* dpi, const char* text)
@@ -151,7 +165,7 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     session->ViewFlags = viewFlags;
     session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
     session->QuadrantFrontIndex = 0;
-    session->PaintEntryChain = _paintStructPool.Create();
+    session->PaintEntryChain = _paintEntryArena.Create();
 
     std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
     session->LastPS = nullptr;
@@ -171,6 +185,11 @@ void Painter::ReleaseSession(paint_session* session)
     _freePaintSessions.push_back(session);
 }
 
+PaintEntryArena::Stats Painter::GetPaintEntryStats() const
+{
+    return _paintEntryArena.GetStats();
+}
+
 Painter::~Painter()
 {
     for (auto&& session : _paintSessionPool)
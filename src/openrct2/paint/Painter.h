@@ -10,8 +10,10 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/MemoryAccounting.h"
 #include "Paint.h"
 
+#include <chrono>
 #include <ctime>
 #include <memory>
 #include <vector>
@@ -38,10 +40,13 @@ namespace OpenRCT2
             std::shared_ptr<Ui::IUiContext> const _uiContext;
             std::vector<std::unique_ptr<paint_session>> _paintSessionPool;
             std::vector<paint_session*> _freePaintSessions;
-            PaintEntryPool _paintStructPool;
+            PaintEntryArena _paintEntryArena;
+            MemoryAccounting::Registration _paintSessionsMemory;
+            MemoryAccounting::Registration _paintEntriesMemory;
             time_t _lastSecond = 0;
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
+            std::chrono::steady_clock::time_point _lastFrameTime;
 
         public:
             explicit Painter(const std::shared_ptr<Ui::IUiContext>& uiContext);
@@ -49,6 +54,7 @@ namespace OpenRCT2
 
             paint_session* CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags);
             void ReleaseSession(paint_session* session);
+            PaintEntryArena::Stats GetPaintEntryStats() const;
             ~Painter();
 
         private:
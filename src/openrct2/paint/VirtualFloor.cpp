@@ -14,6 +14,7 @@
 #include "../config/Config.h"
 #include "../interface/Viewport.h"
 #include "../sprites.h"
+#include "../util/Math.hpp"
 #include "../util/Util.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
@@ -24,6 +25,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -40,6 +43,33 @@ enum VirtualFloorFlags
     VIRTUAL_FLOOR_FORCE_INVALIDATION = (1 << 2),
 };
 
+enum VirtualFloorTileFlags : uint8_t
+{
+    VIRTUAL_FLOOR_TILE_FLOOR = (1 << 0),
+    VIRTUAL_FLOOR_TILE_LIT = (1 << 1),
+};
+
+/**
+ * Which tiles around the map selection are part of the virtual floor and which are lit by the selection. Worked out
+ * once whenever the selection changes rather than for every painted tile and its neighbours.
+ */
+struct VirtualFloorMask
+{
+    // The selection the mask was built for.
+    uint16_t SelectFlags{};
+    CoordsXY SelectPositionA;
+    CoordsXY SelectPositionB;
+    std::vector<CoordsXY> SelectionTiles;
+
+    // The first tile and the number of tiles covered, empty when there is no floor.
+    TileCoordsXY Origin;
+    int32_t Width{};
+    int32_t Height{};
+    std::vector<uint8_t> Tiles;
+};
+
+static VirtualFloorMask _virtualFloorMask;
+
 bool virtual_floor_is_enabled()
 {
     return (_virtualFloorFlags & VIRTUAL_FLOOR_FLAG_ENABLED) != 0;
@@ -54,7 +84,10 @@ void virtual_floor_set_height(int16_t height)
 
     if (_virtualFloorHeight != height)
     {
+        // The whole floor is painted at the new height, not only the parts that moved.
+        _virtualFloorFlags |= VIRTUAL_FLOOR_FORCE_INVALIDATION;
         virtual_floor_invalidate();
+        _virtualFloorFlags &= ~VIRTUAL_FLOOR_FORCE_INVALIDATION;
         _virtualFloorHeight = height;
     }
 }
@@ -96,6 +129,39 @@ void virtual_floor_disable()
     virtual_floor_reset();
 }
 
+/**
+ * Invalidates the part of a region that is not covered by another region, as at most four strips.
+ */
+static void virtual_floor_invalidate_difference(
+    const CoordsXY& min, const CoordsXY& max, const CoordsXY& otherMin, const CoordsXY& otherMax)
+{
+    if (otherMax.x < min.x || otherMin.x > max.x || otherMax.y < min.y || otherMin.y > max.y)
+    {
+        map_invalidate_region(min, max);
+        return;
+    }
+
+    // The strips share their edges with the other region, the invalidation is rounded outwards anyway.
+    if (min.y < otherMin.y)
+    {
+        map_invalidate_region(min, { max.x, otherMin.y });
+    }
+    if (max.y > otherMax.y)
+    {
+        map_invalidate_region({ min.x, otherMax.y }, max);
+    }
+    const auto overlapMinY = std::max(min.y, otherMin.y);
+    const auto overlapMaxY = std::min(max.y, otherMax.y);
+    if (min.x < otherMin.x)
+    {
+        map_invalidate_region({ min.x, overlapMinY }, { otherMin.x, overlapMaxY });
+    }
+    if (max.x > otherMax.x)
+    {
+        map_invalidate_region({ otherMax.x, overlapMinY }, { max.x, overlapMaxY });
+    }
+}
+
 void virtual_floor_invalidate()
 {
     // First, let's figure out how big our selection is.
@@ -125,11 +191,38 @@ void virtual_floor_invalidate()
     max_position.x += _virtualFloorBaseSize + 16;
     max_position.y += _virtualFloorBaseSize + 16;
 
-    // Invalidate previous region if appropriate.
-    if (_virtualFloorLastMinPos.x != std::numeric_limits<int32_t>::max()
+    const bool lastRegionSet = _virtualFloorLastMinPos.x != std::numeric_limits<int32_t>::max()
         && _virtualFloorLastMinPos.y != std::numeric_limits<int32_t>::max()
         && _virtualFloorLastMaxPos.x != std::numeric_limits<int32_t>::lowest()
-        && _virtualFloorLastMaxPos.y != std::numeric_limits<int32_t>::lowest())
+        && _virtualFloorLastMaxPos.y != std::numeric_limits<int32_t>::lowest();
+    const bool regionSet = min_position.x != std::numeric_limits<int32_t>::max()
+        && min_position.y != std::numeric_limits<int32_t>::max()
+        && max_position.x != std::numeric_limits<int32_t>::lowest() && max_position.y != std::numeric_limits<int32_t>::lowest();
+
+    // When a floor of the same height has only moved, just the tiles it covers in one of the two regions look any
+    // different, along with the tiles lit by the old and new selection.
+    if (lastRegionSet && regionSet && (_virtualFloorFlags & VIRTUAL_FLOOR_FLAG_ENABLED)
+        && !(_virtualFloorFlags & VIRTUAL_FLOOR_FORCE_INVALIDATION) && _virtualFloorLastMinPos.z == _virtualFloorHeight
+        && (_virtualFloorLastMinPos != min_position || _virtualFloorLastMaxPos != max_position))
+    {
+        const CoordsXY lastMin = _virtualFloorLastMinPos;
+        const CoordsXY lastMax = _virtualFloorLastMaxPos;
+        virtual_floor_invalidate_difference(lastMin, lastMax, min_position, max_position);
+        virtual_floor_invalidate_difference(min_position, max_position, lastMin, lastMax);
+
+        // The lit tiles and the edges they put on their neighbours.
+        const CoordsXY selectionMargin = { _virtualFloorBaseSize + 16 - COORDS_XY_STEP,
+                                           _virtualFloorBaseSize + 16 - COORDS_XY_STEP };
+        map_invalidate_region(lastMin + selectionMargin, lastMax - selectionMargin);
+        map_invalidate_region(min_position + selectionMargin, max_position - selectionMargin);
+
+        _virtualFloorLastMinPos = { min_position, _virtualFloorHeight };
+        _virtualFloorLastMaxPos = { max_position, _virtualFloorHeight };
+        return;
+    }
+
+    // Invalidate previous region if appropriate.
+    if (lastRegionSet)
     {
         if (_virtualFloorLastMinPos != min_position || _virtualFloorLastMaxPos != max_position
             || (_virtualFloorFlags & VIRTUAL_FLOOR_FORCE_INVALIDATION) != 0)
@@ -155,8 +248,7 @@ void virtual_floor_invalidate()
     log_verbose("Min: %d %d, Max: %d %d", min_position.x, min_position.y, max_position.x, max_position.y);
 
     // Invalidate new region if coordinates are set.
-    if (min_position.x != std::numeric_limits<int32_t>::max() && min_position.y != std::numeric_limits<int32_t>::max()
-        && max_position.x != std::numeric_limits<int32_t>::lowest() && max_position.y != std::numeric_limits<int32_t>::lowest())
+    if (regionSet)
     {
         map_invalidate_region(min_position, max_position);
 
@@ -171,36 +263,139 @@ void virtual_floor_invalidate()
     }
 }
 
-bool virtual_floor_tile_is_floor(const CoordsXY& loc)
+static bool virtual_floor_mask_is_current()
 {
-    if (!virtual_floor_is_enabled())
+    const auto& mask = _virtualFloorMask;
+    if (mask.SelectFlags != (gMapSelectFlags & (MAP_SELECT_FLAG_ENABLE | MAP_SELECT_FLAG_ENABLE_CONSTRUCT)))
+    {
+        return false;
+    }
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE)
+        && (mask.SelectPositionA != gMapSelectPositionA || mask.SelectPositionB != gMapSelectPositionB))
     {
         return false;
     }
+    return !(gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT) || mask.SelectionTiles == gMapSelectionTiles;
+}
+
+// The tiles whose coordinates lie within [min, max] along one axis.
+static std::pair<int32_t, int32_t> virtual_floor_get_tile_range(int32_t min, int32_t max)
+{
+    return { ceil2(min, COORDS_XY_STEP) / COORDS_XY_STEP, floor2(max, COORDS_XY_STEP) / COORDS_XY_STEP };
+}
 
-    // Check if map selection (usually single tiles) are enabled
-    //  and if the current tile is near or on them
-    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE) && loc.x >= gMapSelectPositionA.x - _virtualFloorBaseSize
-        && loc.y >= gMapSelectPositionA.y - _virtualFloorBaseSize && loc.x <= gMapSelectPositionB.x + _virtualFloorBaseSize
-        && loc.y <= gMapSelectPositionB.y + _virtualFloorBaseSize)
+static void virtual_floor_mask_add(const CoordsXY& min, const CoordsXY& max, uint8_t flags)
+{
+    auto& mask = _virtualFloorMask;
+    const auto [minX, maxX] = virtual_floor_get_tile_range(min.x, max.x);
+    const auto [minY, maxY] = virtual_floor_get_tile_range(min.y, max.y);
+    for (int32_t y = std::max(minY, mask.Origin.y); y <= std::min(maxY, mask.Origin.y + mask.Height - 1); y++)
     {
-        return true;
+        for (int32_t x = std::max(minX, mask.Origin.x); x <= std::min(maxX, mask.Origin.x + mask.Width - 1); x++)
+        {
+            mask.Tiles[(y - mask.Origin.y) * mask.Width + (x - mask.Origin.x)] |= flags;
+        }
     }
+}
 
-    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+static void virtual_floor_build_mask()
+{
+    auto& mask = _virtualFloorMask;
+    mask.SelectFlags = gMapSelectFlags & (MAP_SELECT_FLAG_ENABLE | MAP_SELECT_FLAG_ENABLE_CONSTRUCT);
+    mask.SelectPositionA = gMapSelectPositionA;
+    mask.SelectPositionB = gMapSelectPositionB;
+    mask.SelectionTiles = gMapSelectionTiles;
+
+    // Every tile within the base size of the selection is part of the floor.
+    const CoordsXY baseSize = { _virtualFloorBaseSize, _virtualFloorBaseSize };
+    CoordsXY min = { std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+    CoordsXY max = { std::numeric_limits<int32_t>::lowest(), std::numeric_limits<int32_t>::lowest() };
+    if (mask.SelectFlags & MAP_SELECT_FLAG_ENABLE)
+    {
+        min = gMapSelectPositionA;
+        max = gMapSelectPositionB;
+    }
+    if (mask.SelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
     {
-        // Check if we are anywhere near the selection tiles (larger scenery / rides)
         for (const auto& tile : gMapSelectionTiles)
         {
-            if (loc.x >= tile.x - _virtualFloorBaseSize && loc.y >= tile.y - _virtualFloorBaseSize
-                && loc.x <= tile.x + _virtualFloorBaseSize && loc.y <= tile.y + _virtualFloorBaseSize)
-            {
-                return true;
-            }
+            min = { std::min(min.x, tile.x), std::min(min.y, tile.y) };
+            max = { std::max(max.x, tile.x), std::max(max.y, tile.y) };
+        }
+    }
+
+    mask.Tiles.clear();
+    mask.Width = 0;
+    mask.Height = 0;
+    if (min.x > max.x || min.y > max.y)
+    {
+        return;
+    }
+
+    const auto [minX, maxX] = virtual_floor_get_tile_range(min.x - baseSize.x, max.x + baseSize.x);
+    const auto [minY, maxY] = virtual_floor_get_tile_range(min.y - baseSize.y, max.y + baseSize.y);
+    mask.Origin = { minX, minY };
+    mask.Width = std::max(0, maxX - minX + 1);
+    mask.Height = std::max(0, maxY - minY + 1);
+    mask.Tiles.resize(mask.Width * mask.Height);
+
+    if (mask.SelectFlags & MAP_SELECT_FLAG_ENABLE)
+    {
+        virtual_floor_mask_add(gMapSelectPositionA - baseSize, gMapSelectPositionB + baseSize, VIRTUAL_FLOOR_TILE_FLOOR);
+        virtual_floor_mask_add(gMapSelectPositionA, gMapSelectPositionB, VIRTUAL_FLOOR_TILE_LIT);
+    }
+    if (mask.SelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+    {
+        for (const auto& tile : gMapSelectionTiles)
+        {
+            virtual_floor_mask_add(tile - baseSize, tile + baseSize, VIRTUAL_FLOOR_TILE_FLOOR);
+            virtual_floor_mask_add(tile, tile, VIRTUAL_FLOOR_TILE_LIT);
         }
     }
+}
 
-    return false;
+static uint8_t virtual_floor_get_mask(const CoordsXY& loc)
+{
+    const auto& mask = _virtualFloorMask;
+    const auto x = floor2(loc.x, COORDS_XY_STEP) / COORDS_XY_STEP - mask.Origin.x;
+    const auto y = floor2(loc.y, COORDS_XY_STEP) / COORDS_XY_STEP - mask.Origin.y;
+    if (x < 0 || y < 0 || x >= mask.Width || y >= mask.Height)
+    {
+        return 0;
+    }
+    return mask.Tiles[y * mask.Width + x];
+}
+
+void virtual_floor_prepare_paint()
+{
+    if (virtual_floor_is_enabled() && !virtual_floor_mask_is_current())
+    {
+        virtual_floor_build_mask();
+    }
+}
+
+bool virtual_floor_intersects(const CoordsXY& min, const CoordsXY& max)
+{
+    if (!virtual_floor_is_enabled())
+    {
+        return false;
+    }
+
+    const auto& mask = _virtualFloorMask;
+    const auto [minX, maxX] = virtual_floor_get_tile_range(min.x, max.x);
+    const auto [minY, maxY] = virtual_floor_get_tile_range(min.y, max.y);
+    return mask.Width > 0 && maxX >= mask.Origin.x && minX < mask.Origin.x + mask.Width && maxY >= mask.Origin.y
+        && minY < mask.Origin.y + mask.Height;
+}
+
+bool virtual_floor_tile_is_floor(const CoordsXY& loc)
+{
+    if (!virtual_floor_is_enabled())
+    {
+        return false;
+    }
+
+    return (virtual_floor_get_mask(loc) & VIRTUAL_FLOOR_TILE_FLOOR) != 0;
 }
 
 static void virtual_floor_get_tile_properties(
@@ -214,26 +409,10 @@ static void virtual_floor_get_tile_properties(
     *aboveGround = false;
     *tileOwned = false;
 
-    // See if we are a selected tile
-    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE))
+    // See if we are a selected tile or on top of the selection tiles
+    if (virtual_floor_get_mask(loc) & VIRTUAL_FLOOR_TILE_LIT)
     {
-        if (loc >= gMapSelectPositionA && loc <= gMapSelectPositionB)
-        {
-            *outLit = true;
-        }
-    }
-
-    // See if we are on top of the selection tiles
-    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
-    {
-        for (const auto& tile : gMapSelectionTiles)
-        {
-            if (tile == loc)
-            {
-                *outLit = true;
-                break;
-            }
-        }
+        *outLit = true;
     }
 
     *tileOwned = map_is_location_owned({ loc, height });
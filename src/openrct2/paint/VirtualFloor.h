@@ -31,6 +31,11 @@ void virtual_floor_enable();
 void virtual_floor_disable();
 void virtual_floor_invalidate();
 
+/**
+ * Brings the tiles of the virtual floor up to date with the map selection, must be called before painting a viewport.
+ */
+void virtual_floor_prepare_paint();
+bool virtual_floor_intersects(const CoordsXY& min, const CoordsXY& max);
 bool virtual_floor_tile_is_floor(const CoordsXY& loc);
 
 void virtual_floor_paint(paint_session& session);
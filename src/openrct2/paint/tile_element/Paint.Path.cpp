@@ -864,7 +864,9 @@ static FootpathPaintInfo GetFootpathPaintInfo(const PathElement& pathEl)
 
 static bool ShouldDrawSupports(paint_session& session, const PathElement& pathEl, uint16_t height)
 {
-    auto surface = map_get_surface_element_at(session.MapPosition);
+    // The surface was usually painted just before the path
+    const auto* surface = session.DidPassSurface ? session.SurfaceElement->AsSurface()
+                                                 : map_get_surface_element_at(session.MapPosition);
     if (surface == nullptr)
     {
         return true;
@@ -950,6 +950,19 @@ static std::pair<int32_t, int32_t> surface_get_height_above_water(
     return { localHeight, localSurfaceShape };
 }
 
+static const SurfaceElement* GetNeighbourSurface(paint_session& session, const CoordsXY& position)
+{
+    const auto offset = position - session.MapPosition;
+    for (size_t i = 0; i < std::size(PaintNeighbourOffsets); i++)
+    {
+        if (PaintNeighbourOffsets[i] == offset)
+        {
+            return PaintGetNeighbourSurface(session, i);
+        }
+    }
+    return map_is_location_valid(position) ? map_get_surface_element_at(position) : nullptr;
+}
+
 /**
  *  rct2: 0x0066062C
  */
@@ -992,12 +1005,7 @@ void PaintSurface(paint_session& session, uint8_t direction, uint16_t height, co
         tile_descriptor& descriptor = tileDescriptors[i + 1];
 
         descriptor.tile_element = nullptr;
-        if (!map_is_location_valid(position))
-        {
-            continue;
-        }
-
-        auto surfaceElement = map_get_surface_element_at(position);
+        const auto* surfaceElement = GetNeighbourSurface(session, position);
         if (surfaceElement == nullptr)
         {
             continue;
@@ -1008,7 +1016,7 @@ void PaintSurface(paint_session& session, uint8_t direction, uint16_t height, co
         const corner_height& ch = corner_heights[surfaceSlope];
 
         descriptor.tile_coords = TileCoordsXY{ position };
-        descriptor.tile_element = reinterpret_cast<TileElement*>(surfaceElement);
+        descriptor.tile_element = reinterpret_cast<const TileElement*>(surfaceElement);
         descriptor.terrain = surfaceElement->GetSurfaceStyle();
         descriptor.slope = surfaceSlope;
         descriptor.corner_heights.top = baseHeight + ch.top;
@@ -11,13 +11,17 @@
 
 #include "../../Game.h"
 #include "../../Input.h"
+#include "../../OpenRCT2.h"
 #include "../../config/Config.h"
 #include "../../core/Numerics.hpp"
 #include "../../drawing/Drawing.h"
+#include "../../drawing/LightFX.h"
+#include "../../entity/Staff.h"
 #include "../../interface/Viewport.h"
 #include "../../localisation/Localisation.h"
 #include "../../ride/RideData.h"
 #include "../../ride/TrackData.h"
+#include "../../ride/TrackDesign.h"
 #include "../../ride/TrackPaint.h"
 #include "../../sprites.h"
 #include "../../world/Banner.h"
@@ -25,6 +29,7 @@
 #include "../../world/Footpath.h"
 #include "../../world/Map.h"
 #include "../../world/Scenery.h"
+#include "../../world/SmallScenery.h"
 #include "../../world/Surface.h"
 #include "../Paint.h"
 #include "../Supports.h"
@@ -32,6 +37,12 @@
 #include "Paint.Surface.h"
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #ifdef __TESTPAINT__
 uint16_t testPaintVerticalTunnelHeight;
@@ -39,6 +50,9 @@ uint16_t testPaintVerticalTunnelHeight;
 
 static void blank_tiles_paint(paint_session& session, int32_t x, int32_t y);
 static void sub_68B3FB(paint_session& session, int32_t x, int32_t y);
+#ifndef __TESTPAINT__
+static bool TileBlockIsHidden(const paint_session& session, const CoordsXY& mapCoords);
+#endif // __TESTPAINT__
 
 const int32_t SEGMENTS_ALL = SEGMENT_B4 | SEGMENT_B8 | SEGMENT_BC | SEGMENT_C0 | SEGMENT_C4 | SEGMENT_C8 | SEGMENT_CC
     | SEGMENT_D0 | SEGMENT_D4;
@@ -51,6 +65,11 @@ void tile_element_paint_setup(paint_session& session, const CoordsXY& mapCoords,
 {
     if (!map_is_edge(mapCoords))
     {
+#ifndef __TESTPAINT__
+        if (!isTrackPiecePreview && TileBlockIsHidden(session, mapCoords))
+            return;
+#endif // __TESTPAINT__
+
         paint_util_set_segment_support_height(session, SEGMENTS_ALL, 0xFFFF, 0);
         paint_util_force_set_general_support_height(session, -1, 0);
         session.Unk141E9DB = isTrackPiecePreview ? PaintSessionFlags::IsTrackPiecePreview : 0;
@@ -110,6 +129,453 @@ static void blank_tiles_paint(paint_session& session, int32_t x, int32_t y)
 
 bool gShowSupportSegmentHeights = false;
 
+/**
+ * Paints every element of a tile, the session must already be set up for the tile.
+ * @return The last element of the tile.
+ */
+static const TileElement* PaintTileElements(paint_session& session, const TileElement* tileElement)
+{
+    const uint8_t rotation = session.CurrentRotation;
+    int32_t previousBaseZ = 0;
+    do
+    {
+        if (tileElement->IsInvisible())
+        {
+            continue;
+        }
+
+        // Only paint tile elements below the clip height.
+        if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tileElement->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
+            continue;
+
+        Direction direction = tileElement->GetDirectionWithOffset(rotation);
+        int32_t baseZ = tileElement->GetBaseZ();
+
+        // If we are on a new baseZ level, look through elements on the
+        //  same baseZ and store any types might be relevant to others
+        if (baseZ != previousBaseZ)
+        {
+            previousBaseZ = baseZ;
+            session.PathElementOnSameHeight = nullptr;
+            session.TrackElementOnSameHeight = nullptr;
+            const TileElement* tileElementSubIterator = tileElement;
+            while (!(tileElementSubIterator++)->IsLastForTile())
+            {
+                if (tileElement->IsInvisible())
+                {
+                    continue;
+                }
+
+                if (tileElementSubIterator->GetBaseZ() != tileElement->GetBaseZ())
+                {
+                    break;
+                }
+                auto type = tileElementSubIterator->GetType();
+                if (type == TileElementType::Path)
+                    session.PathElementOnSameHeight = tileElementSubIterator;
+                else if (type == TileElementType::Track)
+                    session.TrackElementOnSameHeight = tileElementSubIterator;
+            }
+        }
+
+        CoordsXY mapPosition = session.MapPosition;
+        session.CurrentlyDrawnItem = tileElement;
+        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
+        switch (tileElement->GetType())
+        {
+            case TileElementType::Surface:
+                PaintSurface(session, direction, baseZ, *(tileElement->AsSurface()));
+                break;
+            case TileElementType::Path:
+                PaintPath(session, baseZ, *(tileElement->AsPath()));
+                break;
+            case TileElementType::Track:
+                PaintTrack(session, direction, baseZ, *(tileElement->AsTrack()));
+                break;
+            case TileElementType::SmallScenery:
+                PaintSmallScenery(session, direction, baseZ, *(tileElement->AsSmallScenery()));
+                break;
+            case TileElementType::Entrance:
+                PaintEntrance(session, direction, baseZ, *(tileElement->AsEntrance()));
+                break;
+            case TileElementType::Wall:
+                PaintWall(session, direction, baseZ, *(tileElement->AsWall()));
+                break;
+            case TileElementType::LargeScenery:
+                PaintLargeScenery(session, direction, baseZ, *(tileElement->AsLargeScenery()));
+                break;
+            case TileElementType::Banner:
+                PaintBanner(session, direction, baseZ, *(tileElement->AsBanner()));
+                break;
+        }
+        session.MapPosition = mapPosition;
+    } while (!(tileElement++)->IsLastForTile());
+
+    return tileElement - 1;
+}
+
+const CoordsXY PaintNeighbourOffsets[4] = { { 32, 0 }, { -32, 0 }, { 0, 32 }, { 0, -32 } };
+
+const SurfaceElement* PaintGetNeighbourSurface(paint_session& session, size_t index)
+{
+    if (!session.NeighbourSurfacesValid)
+    {
+        for (size_t i = 0; i < std::size(PaintNeighbourOffsets); i++)
+        {
+            const auto position = session.MapPosition + PaintNeighbourOffsets[i];
+            session.NeighbourSurfaces[i] = map_is_location_valid(position) ? map_get_surface_element_at(position) : nullptr;
+        }
+        session.NeighbourSurfacesValid = true;
+    }
+    return session.NeighbourSurfaces[index];
+}
+
+#ifndef __TESTPAINT__
+/**
+ * Paint structs of static tiles are kept between frames so unchanged parts of the
+ * map do not have to run through the element painters again. Entries are keyed by
+ * tile, rotation and zoom and are validated against a hash of the tile's elements
+ * and the surfaces of its neighbours, as not every modification of the map goes
+ * through map_invalidate_tile. Recordings are not culled, the current view is only
+ * applied when they are replayed so a recording can be shared by all sessions.
+ */
+struct TilePaintCacheEntry
+{
+    const TileElement* FirstElement{};
+    uint64_t Hash{};
+    uint32_t ViewFlags{};
+    uint32_t Generation{};
+    bool LandscapeSmoothing{};
+    bool TransparentWater{};
+    RecordedTilePaint Paint;
+};
+
+static constexpr size_t TilePaintCacheMaxEntries = 32768;
+
+static std::mutex _tilePaintCacheMutex;
+static std::unordered_map<uint64_t, std::shared_ptr<const TilePaintCacheEntry>> _tilePaintCache;
+static std::atomic<uint32_t> _tilePaintCacheGeneration{};
+
+static uint64_t TilePaintCacheHashBytes(uint64_t hash, const void* data, size_t length)
+{
+    // FNV-1a
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static uint64_t TilePaintCacheHashTile(paint_session& session, const TileElement* tileElement)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    do
+    {
+        hash = TilePaintCacheHashBytes(hash, tileElement, sizeof(TileElement));
+    } while (!(tileElement++)->IsLastForTile());
+
+    // Surface edges are painted from the neighbouring surfaces.
+    for (size_t i = 0; i < std::size(PaintNeighbourOffsets); i++)
+    {
+        const auto& offset = PaintNeighbourOffsets[i];
+        const auto* surfaceElement = PaintGetNeighbourSurface(session, i);
+        if (surfaceElement != nullptr)
+        {
+            hash = TilePaintCacheHashBytes(hash, surfaceElement, sizeof(TileElement));
+        }
+        else
+        {
+            hash = TilePaintCacheHashBytes(hash, &offset, sizeof(offset));
+        }
+    }
+    return hash;
+}
+
+static bool TilePaintCacheIsElementStatic(const TileElement& tileElement)
+{
+    switch (tileElement.GetType())
+    {
+        case TileElementType::Surface:
+            return true;
+        case TileElementType::Path:
+            // Queue banners scroll the ride name.
+            return !tileElement.AsPath()->HasQueueBanner();
+        case TileElementType::SmallScenery:
+        {
+            const auto* entry = tileElement.AsSmallScenery()->GetEntry();
+            return entry != nullptr && !entry->HasFlag(SMALL_SCENERY_FLAG_ANIMATED);
+        }
+        case TileElementType::Wall:
+        {
+            const auto* entry = tileElement.AsWall()->GetEntry();
+            return entry != nullptr && !(entry->flags2 & WALL_SCENERY_2_ANIMATED)
+                && entry->scrolling_mode == SCROLLING_MODE_NONE;
+        }
+        case TileElementType::LargeScenery:
+        {
+            // 3D text is taken from the banner rather than the element.
+            const auto* entry = tileElement.AsLargeScenery()->GetEntry();
+            return entry != nullptr && !(entry->flags & (LARGE_SCENERY_FLAG_3D_TEXT | LARGE_SCENERY_FLAG_ANIMATED))
+                && entry->scrolling_mode == SCROLLING_MODE_NONE;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool TilePaintCacheIsUsable(const paint_session& session, const TileElement* tileElement, bool partOfVirtualFloor)
+{
+    constexpr uint32_t uncachedViewFlags = VIEWPORT_FLAG_CLIP_VIEW | VIEWPORT_FLAG_LAND_OWNERSHIP
+        | VIEWPORT_FLAG_CONSTRUCTION_RIGHTS | VIEWPORT_FLAG_LAND_HEIGHTS | VIEWPORT_FLAG_TRACK_HEIGHTS
+        | VIEWPORT_FLAG_PATH_HEIGHTS;
+    constexpr uint8_t uncachedScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER
+        | SCREEN_FLAGS_TRACK_MANAGER;
+
+    // Anything painted from global state rather than from the tile itself.
+    if (gMapSelectFlags != 0 || gTrackDesignSaveMode || gStaffDrawPatrolAreas != SPRITE_INDEX_NULL || gPaintWidePathsAsGhost
+        || gPaintBlockedTiles || gShowSupportSegmentHeights || (gScreenFlags & uncachedScreenFlags))
+    {
+        return false;
+    }
+#ifdef __ENABLE_LIGHTFX__
+    // Path lamps add their lights while being painted.
+    if (lightfx_is_available())
+    {
+        return false;
+    }
+#endif
+    if (session.Unk141E9DB != 0 || (session.ViewFlags & uncachedViewFlags) || partOfVirtualFloor)
+    {
+        return false;
+    }
+
+    do
+    {
+        if (!TilePaintCacheIsElementStatic(*tileElement))
+        {
+            return false;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return true;
+}
+
+static void TilePaintCachePaint(paint_session& session, const TileElement* tileElement)
+{
+    const auto zoom = static_cast<uint8_t>(static_cast<int8_t>(session.DPI.zoom_level));
+    const uint64_t key = static_cast<uint64_t>(session.MapPosition.x / COORDS_XY_STEP)
+        | (static_cast<uint64_t>(session.MapPosition.y / COORDS_XY_STEP) << 16)
+        | (static_cast<uint64_t>(session.CurrentRotation) << 32) | (static_cast<uint64_t>(zoom) << 40);
+    const auto hash = TilePaintCacheHashTile(session, tileElement);
+    const auto generation = _tilePaintCacheGeneration.load();
+
+    std::shared_ptr<const TilePaintCacheEntry> entry;
+    {
+        std::lock_guard<std::mutex> lock(_tilePaintCacheMutex);
+        auto it = _tilePaintCache.find(key);
+        if (it != _tilePaintCache.end())
+        {
+            entry = it->second;
+        }
+    }
+
+    if (entry != nullptr && entry->FirstElement == tileElement && entry->Hash == hash && entry->ViewFlags == session.ViewFlags
+        && entry->Generation == generation && entry->LandscapeSmoothing == gConfigGeneral.landscape_smoothing
+        && entry->TransparentWater == gConfigGeneral.transparent_water)
+    {
+        PaintSessionReplayTile(session, entry->Paint);
+        return;
+    }
+
+    auto newEntry = std::make_shared<TilePaintCacheEntry>();
+    newEntry->FirstElement = tileElement;
+    newEntry->Hash = hash;
+    newEntry->ViewFlags = session.ViewFlags;
+    newEntry->Generation = generation;
+    newEntry->LandscapeSmoothing = gConfigGeneral.landscape_smoothing;
+    newEntry->TransparentWater = gConfigGeneral.transparent_water;
+
+    // Supports can only be prepended to track pieces of the same tile, which are never cached.
+    std::vector<paint_struct*> parents;
+    auto* woodenSupportsPrependTo = session.WoodenSupportsPrependTo;
+    session.WoodenSupportsPrependTo = nullptr;
+    session.TileRecording = &parents;
+    PaintTileElements(session, tileElement);
+    session.TileRecording = nullptr;
+    session.WoodenSupportsPrependTo = woodenSupportsPrependTo;
+
+    PaintRecordTile(parents, newEntry->Paint);
+    PaintSessionReplayTile(session, newEntry->Paint);
+
+    std::lock_guard<std::mutex> lock(_tilePaintCacheMutex);
+    if (_tilePaintCache.size() >= TilePaintCacheMaxEntries)
+    {
+        _tilePaintCache.clear();
+    }
+    _tilePaintCache[key] = std::move(newEntry);
+}
+#endif // __TESTPAINT__
+
+void tile_element_paint_cache_clear()
+{
+#ifndef __TESTPAINT__
+    std::lock_guard<std::mutex> lock(_tilePaintCacheMutex);
+    _tilePaintCache.clear();
+    _tilePaintCacheGeneration++;
+#endif // __TESTPAINT__
+}
+
+static constexpr int32_t TileBlockSize = 8;
+
+// Per block of tiles, the scope the heights were gathered in, the lowest base z and the highest clearance z.
+static std::vector<std::atomic<uint64_t>> _tileBlockHeights;
+static int32_t _tileBlockColumns;
+static uint32_t _tileBlockScopeId;
+static int32_t _tileBlockScopeDepth;
+
+TileBlockVisibilityScope::TileBlockVisibilityScope()
+{
+    if (_tileBlockScopeDepth++ != 0)
+        return;
+
+    // Zero is the id of blocks that were never gathered.
+    if (++_tileBlockScopeId == 0)
+        _tileBlockScopeId++;
+
+    const auto columns = (gMapSize + TileBlockSize - 1) / TileBlockSize;
+    if (columns != _tileBlockColumns)
+    {
+        _tileBlockColumns = columns;
+        _tileBlockHeights = std::vector<std::atomic<uint64_t>>(static_cast<size_t>(columns) * columns);
+    }
+}
+
+TileBlockVisibilityScope::~TileBlockVisibilityScope()
+{
+    _tileBlockScopeDepth--;
+}
+
+#ifndef __TESTPAINT__
+static uint64_t TileBlockGetHeights(int32_t blockX, int32_t blockY)
+{
+    // Drawing threads may gather the same block at once, they all store the same value.
+    auto& entry = _tileBlockHeights[blockY * _tileBlockColumns + blockX];
+    auto packed = entry.load(std::memory_order_relaxed);
+    if ((packed >> 32) == _tileBlockScopeId)
+        return packed;
+
+    uint16_t minBaseZ = std::numeric_limits<uint16_t>::max();
+    uint16_t maxZ = 0;
+    const auto endX = std::min((blockX + 1) * TileBlockSize, static_cast<int32_t>(gMapSize));
+    const auto endY = std::min((blockY + 1) * TileBlockSize, static_cast<int32_t>(gMapSize));
+    for (auto y = blockY * TileBlockSize; y < endY; y++)
+    {
+        for (auto x = blockX * TileBlockSize; x < endX; x++)
+        {
+            const auto* element = map_get_first_element_at(TileCoordsXY{ x, y });
+            if (element == nullptr)
+                continue;
+            do
+            {
+                minBaseZ = std::min(minBaseZ, static_cast<uint16_t>(element->GetBaseZ()));
+                maxZ = std::max(maxZ, static_cast<uint16_t>(element->GetClearanceZ()));
+                if (element->GetType() == TileElementType::Surface)
+                {
+                    maxZ = std::max(maxZ, static_cast<uint16_t>(element->AsSurface()->GetWaterHeight()));
+                }
+            } while (!(element++)->IsLastForTile());
+        }
+    }
+
+    packed = (static_cast<uint64_t>(_tileBlockScopeId) << 32) | (static_cast<uint64_t>(minBaseZ) << 16) | maxZ;
+    entry.store(packed, std::memory_order_relaxed);
+    return packed;
+}
+
+// The same screen position sub_68B3FB culls each tile with.
+static int32_t TileGetScreenMinY(uint8_t rotation, CoordsXY pos)
+{
+    switch (rotation)
+    {
+        case 1:
+            pos.x += 32;
+            break;
+        case 2:
+            pos.x += 32;
+            pos.y += 32;
+            break;
+        case 3:
+            pos.y += 32;
+            break;
+    }
+    return translate_3d_to_2d_with_z(rotation, { pos, 0 }).y;
+}
+
+/**
+ * Whether sub_68B3FB would not paint anything for any tile of the block containing the given tile.
+ */
+static bool TileBlockIsHidden(const paint_session& session, const CoordsXY& mapCoords)
+{
+    if (_tileBlockScopeDepth == 0)
+        return false;
+
+    const auto blockX = mapCoords.x / COORDS_XY_STEP / TileBlockSize;
+    const auto blockY = mapCoords.y / COORDS_XY_STEP / TileBlockSize;
+    if (blockX < 0 || blockY < 0 || blockX >= _tileBlockColumns || blockY >= _tileBlockColumns)
+        return false;
+
+    const CoordsXY blockStart = { blockX * TileBlockSize * COORDS_XY_STEP, blockY * TileBlockSize * COORDS_XY_STEP };
+    const CoordsXY blockEnd = blockStart + CoordsXY{ (TileBlockSize - 1) * COORDS_XY_STEP, (TileBlockSize - 1) * COORDS_XY_STEP };
+
+    // The footpath arrow is painted regardless of the tile's elements.
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_ARROW) && gMapSelectArrowPosition.x >= blockStart.x
+        && gMapSelectArrowPosition.x <= blockEnd.x && gMapSelectArrowPosition.y >= blockStart.y
+        && gMapSelectArrowPosition.y <= blockEnd.y)
+    {
+        return false;
+    }
+
+    const auto packed = TileBlockGetHeights(blockX, blockY);
+    const int32_t minBaseZ = static_cast<uint16_t>(packed >> 16);
+    int32_t maxZ = static_cast<uint16_t>(packed);
+
+    // Tiles of the virtual floor are at least as tall as the floor and paint it whatever the clip height. The floor only
+    // covers the tiles around the selection, so blocks away from it are culled as usual.
+    const bool virtualFloor = gConfigGeneral.virtual_floor_style != VirtualFloorStyles::Off
+        && virtual_floor_intersects(blockStart, blockEnd);
+    if (virtualFloor)
+    {
+        maxZ = std::max<int32_t>(maxZ, virtual_floor_get_height());
+    }
+
+    if (session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+    {
+        if (blockEnd.x < gClipSelectionA.x || blockStart.x > gClipSelectionB.x || blockEnd.y < gClipSelectionA.y
+            || blockStart.y > gClipSelectionB.y)
+        {
+            return true;
+        }
+        if (!virtualFloor && !gShowSupportSegmentHeights && minBaseZ > gClipHeight * COORDS_Z_STEP)
+        {
+            return true;
+        }
+    }
+
+    // The screen position is linear in the tile position, so the corners of the block bound it.
+    const auto rotation = session.CurrentRotation;
+    const int32_t cornerScreenY[] = {
+        TileGetScreenMinY(rotation, blockStart),
+        TileGetScreenMinY(rotation, { blockEnd.x, blockStart.y }),
+        TileGetScreenMinY(rotation, { blockStart.x, blockEnd.y }),
+        TileGetScreenMinY(rotation, blockEnd),
+    };
+    const auto [minScreenY, maxScreenY] = std::minmax_element(std::begin(cornerScreenY), std::end(cornerScreenY));
+    const auto& dpi = session.DPI;
+    return *maxScreenY + 52 <= dpi.y || *minScreenY - (maxZ + 32) >= dpi.y + dpi.height;
+}
+#endif // __TESTPAINT__
+
 /**
  *
  *  rct2: 0x0068B3FB
@@ -133,6 +599,7 @@ static void sub_68B3FB(paint_session& session, int32_t x, int32_t y)
     session.VerticalTunnelHeight = 0xFF;
     session.MapPosition.x = x;
     session.MapPosition.y = y;
+    session.NeighbourSurfacesValid = false;
 
     const TileElement* tile_element = map_get_first_element_at(session.MapPosition);
     if (tile_element == nullptr)
@@ -213,80 +680,15 @@ static void sub_68B3FB(paint_session& session, int32_t x, int32_t y)
     session.SpritePosition.x = x;
     session.SpritePosition.y = y;
     session.DidPassSurface = false;
-    int32_t previousBaseZ = 0;
-    do
+#ifndef __TESTPAINT__
+    if (TilePaintCacheIsUsable(session, tile_element, partOfVirtualFloor))
     {
-        if (tile_element->IsInvisible())
-        {
-            continue;
-        }
-
-        // Only paint tile_elements below the clip height.
-        if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
-            continue;
-
-        Direction direction = tile_element->GetDirectionWithOffset(rotation);
-        int32_t baseZ = tile_element->GetBaseZ();
-
-        // If we are on a new baseZ level, look through elements on the
-        //  same baseZ and store any types might be relevant to others
-        if (baseZ != previousBaseZ)
-        {
-            previousBaseZ = baseZ;
-            session.PathElementOnSameHeight = nullptr;
-            session.TrackElementOnSameHeight = nullptr;
-            const TileElement* tile_element_sub_iterator = tile_element;
-            while (!(tile_element_sub_iterator++)->IsLastForTile())
-            {
-                if (tile_element->IsInvisible())
-                {
-                    continue;
-                }
-
-                if (tile_element_sub_iterator->GetBaseZ() != tile_element->GetBaseZ())
-                {
-                    break;
-                }
-                auto type = tile_element_sub_iterator->GetType();
-                if (type == TileElementType::Path)
-                    session.PathElementOnSameHeight = tile_element_sub_iterator;
-                else if (type == TileElementType::Track)
-                    session.TrackElementOnSameHeight = tile_element_sub_iterator;
-            }
-        }
+        TilePaintCachePaint(session, tile_element);
+        return;
+    }
+#endif // __TESTPAINT__
 
-        CoordsXY mapPosition = session.MapPosition;
-        session.CurrentlyDrawnItem = tile_element;
-        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
-        switch (tile_element->GetType())
-        {
-            case TileElementType::Surface:
-                PaintSurface(session, direction, baseZ, *(tile_element->AsSurface()));
-                break;
-            case TileElementType::Path:
-                PaintPath(session, baseZ, *(tile_element->AsPath()));
-                break;
-            case TileElementType::Track:
-                PaintTrack(session, direction, baseZ, *(tile_element->AsTrack()));
-                break;
-            case TileElementType::SmallScenery:
-                PaintSmallScenery(session, direction, baseZ, *(tile_element->AsSmallScenery()));
-                break;
-            case TileElementType::Entrance:
-                PaintEntrance(session, direction, baseZ, *(tile_element->AsEntrance()));
-                break;
-            case TileElementType::Wall:
-                PaintWall(session, direction, baseZ, *(tile_element->AsWall()));
-                break;
-            case TileElementType::LargeScenery:
-                PaintLargeScenery(session, direction, baseZ, *(tile_element->AsLargeScenery()));
-                break;
-            case TileElementType::Banner:
-                PaintBanner(session, direction, baseZ, *(tile_element->AsBanner()));
-                break;
-        }
-        session.MapPosition = mapPosition;
-    } while (!(tile_element++)->IsLastForTile());
+    const TileElement* lastElement = PaintTileElements(session, tile_element);
 
 #ifndef __TESTPAINT__
     if (gConfigGeneral.virtual_floor_style != VirtualFloorStyles::Off && partOfVirtualFloor)
@@ -300,7 +702,7 @@ static void sub_68B3FB(paint_session& session, int32_t x, int32_t y)
         return;
     }
 
-    if ((tile_element - 1)->GetType() == TileElementType::Surface)
+    if (lastElement->GetType() == TileElementType::Surface)
     {
         return;
     }
@@ -101,6 +101,30 @@ void paint_util_set_segment_support_height(paint_session& session, int32_t segme
 uint16_t paint_util_rotate_segments(uint16_t segments, uint8_t rotation);
 
 void tile_element_paint_setup(paint_session& session, const CoordsXY& mapCoords, bool isTrackPiecePreview = false);
+void tile_element_paint_cache_clear();
+
+extern const CoordsXY PaintNeighbourOffsets[4];
+
+/**
+ * The surface of the neighbour of the tile being painted at PaintNeighbourOffsets[index], or nullptr if there is none.
+ * The four neighbours are looked up together once per tile and shared by everything painting the tile.
+ */
+const SurfaceElement* PaintGetNeighbourSurface(paint_session& session, size_t index);
+
+/**
+ * While a scope is alive, tile_element_paint_setup skips whole 8x8 blocks of tiles that are outside the view, outside
+ * the clip selection or above the clip height, before walking the elements of any of their tiles. The element heights
+ * of each block are gathered once per scope, so the map must not change while a scope is alive.
+ */
+class TileBlockVisibilityScope
+{
+public:
+    TileBlockVisibilityScope();
+    ~TileBlockVisibilityScope();
+
+    TileBlockVisibilityScope(const TileBlockVisibilityScope&) = delete;
+    TileBlockVisibilityScope& operator=(const TileBlockVisibilityScope&) = delete;
+};
 
 void PaintEntrance(paint_session& session, uint8_t direction, int32_t height, const EntranceElement& entranceElement);
 void PaintBanner(paint_session& session, uint8_t direction, int32_t height, const BannerElement& bannerElement);
@@ -16,10 +16,13 @@
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../Version.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Crypt.h"
 #include "../core/DataSerialiser.h"
 #include "../core/File.h"
+#include "../core/HistoryBuffer.h"
+#include "../core/MemoryStream.h"
 #include "../core/OrcaStream.hpp"
 #include "../core/Path.hpp"
 #include "../drawing/Drawing.h"
@@ -52,13 +55,18 @@
 #include "../world/Map.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
+#include "../world/WorldState.h"
 #include "Legacy.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 using namespace OpenRCT2;
@@ -87,40 +95,366 @@ namespace OpenRCT2
         constexpr uint32_t CHEATS               = 0x36;
         constexpr uint32_t RESTRICTED_OBJECTS   = 0x37;
         constexpr uint32_t PACKED_OBJECTS       = 0x80;
+        constexpr uint32_t DELTA                = 0x90;
+        constexpr uint32_t TILES_DELTA          = 0x91;
         // clang-format on
     }; // namespace ParkFileChunkType
 
+    /**
+     * Autosaves that only hold what has changed since the last full autosave, the keyframe. A delta stores the chunks
+     * that differ from the keyframe and, for the tiles, only the blocks of tiles that differ. All deltas refer to the
+     * keyframe directly, so each can be loaded on its own as long as its keyframe is still there.
+     */
+    class ParkFileDelta
+    {
+    private:
+        using Hash = Crypt::FNV1aAlgorithm::Result;
+
+        static constexpr size_t TilesPerBlock = 1024;
+        // Map size x and y followed by the number of tile elements.
+        static constexpr size_t TilesChunkHeaderSize = 2 * sizeof(int32_t) + sizeof(uint32_t);
+
+        std::string _keyframePath;
+        Hash _keyframeChecksum{};
+        std::vector<uint32_t> _keyframeChunkIds;
+        std::unordered_map<uint32_t, Hash> _keyframeChunkHashes;
+        std::vector<uint8_t> _keyframeTilesHeader;
+        std::vector<Hash> _keyframeTileBlockHashes;
+        uint64_t _keyframeSize{};
+        int32_t _savesSinceKeyframe{};
+
+    public:
+        static bool IsDelta(OrcaStream& os)
+        {
+            return os.HasChunk(ParkFileChunkType::DELTA);
+        }
+
+        /**
+         * Writes the park, which has to be uncompressed, either as a new keyframe or as the changes since the last one.
+         */
+        void Write(const std::string& path, MemoryStream& park, int32_t keyframeInterval)
+        {
+            park.SetPosition(0);
+            OrcaStream full(park, OrcaStream::Mode::READING);
+            std::vector<uint32_t> chunkIds = full.GetChunkIds();
+            std::vector<std::vector<uint8_t>> chunks;
+            std::unordered_map<uint32_t, Hash> chunkHashes;
+            for (auto chunkId : chunkIds)
+            {
+                auto& data = chunks.emplace_back(*full.GetChunkData(chunkId));
+                chunkHashes[chunkId] = Crypt::FNV1a(data.data(), data.size());
+            }
+
+            std::vector<uint8_t> tilesHeader;
+            std::vector<size_t> tileBlockOffsets;
+            std::vector<Hash> tileBlockHashes;
+            auto tilesIt = std::find(chunkIds.begin(), chunkIds.end(), ParkFileChunkType::TILES);
+            const std::vector<uint8_t>* tiles = nullptr;
+            if (tilesIt != chunkIds.end())
+            {
+                tiles = &chunks[std::distance(chunkIds.begin(), tilesIt)];
+                if (tiles->size() >= TilesChunkHeaderSize)
+                {
+                    tilesHeader.assign(tiles->begin(), tiles->begin() + 2 * sizeof(int32_t));
+                    tileBlockOffsets = GetTileBlockOffsets(*tiles);
+                    for (size_t i = 0; i + 1 < tileBlockOffsets.size(); i++)
+                    {
+                        tileBlockHashes.push_back(
+                            Crypt::FNV1a(tiles->data() + tileBlockOffsets[i], tileBlockOffsets[i + 1] - tileBlockOffsets[i]));
+                    }
+                }
+            }
+
+            bool writeKeyframe = keyframeInterval <= 1 || _keyframePath.empty()
+                || _savesSinceKeyframe + 1 >= keyframeInterval
+                || Path::GetDirectory(path) != Path::GetDirectory(_keyframePath) || !File::Exists(_keyframePath);
+
+            // Chunks that are the same as in the keyframe are left out, the tiles are compared block by block unless
+            // the map has been resized.
+            std::vector<size_t> changedChunks;
+            std::vector<size_t> changedTileBlocks;
+            bool tilesAsBlocks = false;
+            uint64_t deltaSize = 0;
+            if (!writeKeyframe)
+            {
+                for (size_t i = 0; i < chunkIds.size(); i++)
+                {
+                    auto keyframeHash = _keyframeChunkHashes.find(chunkIds[i]);
+                    if (keyframeHash != _keyframeChunkHashes.end() && keyframeHash->second == chunkHashes[chunkIds[i]])
+                    {
+                        continue;
+                    }
+                    if (chunkIds[i] == ParkFileChunkType::TILES && tilesHeader == _keyframeTilesHeader
+                        && tileBlockHashes.size() == _keyframeTileBlockHashes.size())
+                    {
+                        tilesAsBlocks = true;
+                        for (size_t j = 0; j < tileBlockHashes.size(); j++)
+                        {
+                            if (tileBlockHashes[j] != _keyframeTileBlockHashes[j])
+                            {
+                                changedTileBlocks.push_back(j);
+                                deltaSize += tileBlockOffsets[j + 1] - tileBlockOffsets[j];
+                            }
+                        }
+                        continue;
+                    }
+                    changedChunks.push_back(i);
+                    deltaSize += chunks[i].size();
+                }
+
+                // A delta that is not much smaller than the keyframe is better off as the next keyframe.
+                writeKeyframe = deltaSize > _keyframeSize / 2;
+            }
+
+            FileStream fs(path, FILE_MODE_WRITE);
+            OrcaStream os(fs, OrcaStream::Mode::WRITING);
+            auto& header = os.GetHeader();
+            header.Magic = full.GetHeader().Magic;
+            header.TargetVersion = full.GetHeader().TargetVersion;
+            header.MinVersion = full.GetHeader().MinVersion;
+            header.Compression = OrcaStream::COMPRESSION_GZIP_CHUNKED;
+            if (writeKeyframe)
+            {
+                for (size_t i = 0; i < chunkIds.size(); i++)
+                {
+                    WriteRawChunk(os, chunkIds[i], chunks[i]);
+                }
+
+                _keyframePath = path;
+                // The keyframe holds the same data as the park, so it has the same checksum.
+                _keyframeChecksum = full.GetHeader().FNV1a;
+                _keyframeChunkIds = std::move(chunkIds);
+                _keyframeChunkHashes = std::move(chunkHashes);
+                _keyframeTilesHeader = std::move(tilesHeader);
+                _keyframeTileBlockHashes = std::move(tileBlockHashes);
+                _keyframeSize = full.GetHeader().UncompressedSize;
+                _savesSinceKeyframe = 0;
+                return;
+            }
+
+            // Older versions would load a delta as a park without most of its chunks.
+            header.MinVersion = std::max(header.MinVersion, PARK_FILE_DELTA_MIN_VERSION);
+
+            std::vector<uint32_t> removedChunkIds;
+            for (auto chunkId : _keyframeChunkIds)
+            {
+                if (chunkHashes.find(chunkId) == chunkHashes.end())
+                {
+                    removedChunkIds.push_back(chunkId);
+                }
+            }
+            os.ReadWriteChunk(ParkFileChunkType::DELTA, [this, &removedChunkIds](OrcaStream::ChunkStream& cs) {
+                cs.Write(Path::GetFileName(_keyframePath));
+                cs.Write(_keyframeChecksum.data(), _keyframeChecksum.size());
+                cs.ReadWriteVector(removedChunkIds, [&cs](uint32_t& chunkId) { cs.ReadWrite(chunkId); });
+            });
+            for (auto i : changedChunks)
+            {
+                WriteRawChunk(os, chunkIds[i], chunks[i]);
+            }
+            if (tilesAsBlocks)
+            {
+                os.ReadWriteChunk(ParkFileChunkType::TILES_DELTA, [&](OrcaStream::ChunkStream& cs) {
+                    cs.Write(tilesHeader.data(), tilesHeader.size());
+                    cs.Write(static_cast<uint32_t>(changedTileBlocks.size()));
+                    for (auto block : changedTileBlocks)
+                    {
+                        const auto length = tileBlockOffsets[block + 1] - tileBlockOffsets[block];
+                        cs.Write(static_cast<uint32_t>(block));
+                        cs.Write(static_cast<uint32_t>(length / sizeof(TileElement)));
+                        cs.Write(tiles->data() + tileBlockOffsets[block], length);
+                    }
+                });
+            }
+            _savesSinceKeyframe++;
+        }
+
+        /**
+         * Puts the park back together from the delta and its keyframe, which is looked for next to the delta.
+         * @return an uncompressed park file.
+         */
+        static std::unique_ptr<MemoryStream> Reconstruct(std::string_view deltaPath, OrcaStream& delta)
+        {
+            std::string keyframeName;
+            Hash keyframeChecksum{};
+            std::vector<uint32_t> removedChunkIds;
+            delta.ReadWriteChunk(ParkFileChunkType::DELTA, [&](OrcaStream::ChunkStream& cs) {
+                cs.ReadWrite(keyframeName);
+                cs.Read(keyframeChecksum.data(), keyframeChecksum.size());
+                cs.ReadWriteVector(removedChunkIds, [&cs](uint32_t& chunkId) { cs.ReadWrite(chunkId); });
+            });
+
+            auto keyframePath = Path::Combine(Path::GetDirectory(deltaPath), keyframeName);
+            if (!File::Exists(keyframePath))
+            {
+                throw std::runtime_error("The autosave this autosave is based on no longer exists: " + keyframeName);
+            }
+            FileStream keyframeStream(keyframePath, FILE_MODE_OPEN);
+            OrcaStream keyframe(keyframeStream, OrcaStream::Mode::READING, true);
+            if (keyframe.GetHeader().FNV1a != keyframeChecksum || IsDelta(keyframe))
+            {
+                throw std::runtime_error("The autosave this autosave is based on has been replaced: " + keyframeName);
+            }
+
+            auto park = std::make_unique<MemoryStream>();
+            {
+                OrcaStream os(*park, OrcaStream::Mode::WRITING);
+                auto& header = os.GetHeader();
+                header.Magic = delta.GetHeader().Magic;
+                header.TargetVersion = delta.GetHeader().TargetVersion;
+                header.MinVersion = keyframe.GetHeader().MinVersion;
+                header.Compression = OrcaStream::COMPRESSION_NONE;
+
+                auto keyframeChunkIds = keyframe.GetChunkIds();
+                for (auto chunkId : keyframeChunkIds)
+                {
+                    if (std::find(removedChunkIds.begin(), removedChunkIds.end(), chunkId) != removedChunkIds.end())
+                    {
+                        continue;
+                    }
+                    auto data = delta.GetChunkData(chunkId);
+                    if (!data.has_value())
+                    {
+                        data = keyframe.GetChunkData(chunkId);
+                        if (chunkId == ParkFileChunkType::TILES)
+                        {
+                            ApplyTileBlocks(delta, *data);
+                        }
+                    }
+                    WriteRawChunk(os, chunkId, *data);
+                }
+                for (auto chunkId : delta.GetChunkIds())
+                {
+                    if (chunkId != ParkFileChunkType::DELTA && chunkId != ParkFileChunkType::TILES_DELTA
+                        && std::find(keyframeChunkIds.begin(), keyframeChunkIds.end(), chunkId) == keyframeChunkIds.end())
+                    {
+                        WriteRawChunk(os, chunkId, *delta.GetChunkData(chunkId));
+                    }
+                }
+            }
+            park->SetPosition(0);
+            return park;
+        }
+
+    private:
+        static void WriteRawChunk(OrcaStream& os, uint32_t chunkId, const std::vector<uint8_t>& data)
+        {
+            os.ReadWriteChunk(chunkId, [&data](OrcaStream::ChunkStream& cs) { cs.Write(data.data(), data.size()); });
+        }
+
+        /**
+         * Splits the tile elements of a tiles chunk into blocks of whole tiles.
+         * @return the offset of each block followed by the end of the last one.
+         */
+        static std::vector<size_t> GetTileBlockOffsets(const std::vector<uint8_t>& tiles)
+        {
+            std::vector<size_t> offsets;
+            size_t numTiles = 0;
+            bool isTileStart = true;
+            size_t offset = TilesChunkHeaderSize;
+            for (; offset + sizeof(TileElement) <= tiles.size(); offset += sizeof(TileElement))
+            {
+                if (isTileStart && numTiles % TilesPerBlock == 0)
+                {
+                    offsets.push_back(offset);
+                }
+                TileElement element;
+                std::memcpy(&element, tiles.data() + offset, sizeof(element));
+                isTileStart = element.IsLastForTile();
+                if (isTileStart)
+                {
+                    numTiles++;
+                }
+            }
+            offsets.push_back(offset);
+            return offsets;
+        }
+
+        static void ApplyTileBlocks(OrcaStream& delta, std::vector<uint8_t>& tiles)
+        {
+            delta.ReadWriteChunk(ParkFileChunkType::TILES_DELTA, [&tiles](OrcaStream::ChunkStream& cs) {
+                // Blocks are only stored when the map size is unchanged.
+                cs.Ignore<int32_t>();
+                cs.Ignore<int32_t>();
+                auto offsets = GetTileBlockOffsets(tiles);
+                std::vector<std::vector<uint8_t>> blocks(offsets.size() - 1);
+                for (size_t i = 0; i < blocks.size(); i++)
+                {
+                    blocks[i].assign(tiles.begin() + offsets[i], tiles.begin() + offsets[i + 1]);
+                }
+
+                auto numChangedBlocks = cs.Read<uint32_t>();
+                for (uint32_t i = 0; i < numChangedBlocks; i++)
+                {
+                    auto block = cs.Read<uint32_t>();
+                    auto numElements = cs.Read<uint32_t>();
+                    if (block >= blocks.size())
+                    {
+                        throw std::runtime_error("Invalid tile block in autosave.");
+                    }
+                    blocks[block].resize(numElements * sizeof(TileElement));
+                    cs.Read(blocks[block].data(), blocks[block].size());
+                }
+
+                tiles.resize(TilesChunkHeaderSize);
+                for (const auto& block : blocks)
+                {
+                    tiles.insert(tiles.end(), block.begin(), block.end());
+                }
+                const auto numElements = static_cast<uint32_t>((tiles.size() - TilesChunkHeaderSize) / sizeof(TileElement));
+                std::memcpy(tiles.data() + 2 * sizeof(int32_t), &numElements, sizeof(numElements));
+            });
+        }
+    };
+
     class ParkFile
     {
     public:
         ObjectList RequiredObjects;
         std::vector<const ObjectRepositoryItem*> ExportObjectsList;
+        PackedObjectDataCache* ExportObjectsDataCache{};
+        bool Compress = true;
+        // Repository the packed objects are added to when loading, the context's repository if not set.
+        IObjectRepository* PackedObjectRepository{};
         bool OmitTracklessRides{};
 
     private:
+        std::unique_ptr<IStream> _stream;
         std::unique_ptr<OrcaStream> _os;
         ObjectEntryIndex _pathToSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToQueueSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToRailingsMap[MAX_PATH_OBJECTS];
+        std::vector<uint8_t> _packedObjectData;
 
     public:
         void Load(const std::string_view& path)
         {
-            FileStream fs(path, FILE_MODE_OPEN);
-            Load(fs);
+            Open(path);
+            LoadObjects();
         }
 
-        void Load(IStream& stream)
+        void Load(IStream& stream, bool readChunksOnDemand = false)
         {
-            _os = std::make_unique<OrcaStream>(stream, OrcaStream::Mode::READING);
-            RequiredObjects = {};
-            ReadWriteObjectsChunk(*_os);
-            ReadWritePackedObjectsChunk(*_os);
+            _os = std::make_unique<OrcaStream>(stream, OrcaStream::Mode::READING, readChunksOnDemand);
+            if (ParkFileDelta::IsDelta(*_os))
+            {
+                throw std::runtime_error("Delta autosaves can only be loaded from a file.");
+            }
+            LoadObjects();
+        }
+
+        /**
+         * Opens the park without reading the objects, for when only the scenario chunk is needed.
+         */
+        void LoadScenarioDetails(const std::string_view& path)
+        {
+            Open(path);
         }
 
         void Import()
         {
             auto& os = *_os;
+            os.LoadAllChunks();
             ReadWriteTilesChunk(os);
             ReadWriteBannersChunk(os);
             ReadWriteRidesChunk(os);
@@ -146,28 +480,11 @@ namespace OpenRCT2
         void Save(IStream& stream)
         {
             OrcaStream os(stream, OrcaStream::Mode::WRITING);
-
-            auto& header = os.GetHeader();
-            header.Magic = PARK_FILE_MAGIC;
-            header.TargetVersion = PARK_FILE_CURRENT_VERSION;
-            header.MinVersion = PARK_FILE_MIN_VERSION;
-
-            ReadWriteAuthoringChunk(os);
-            ReadWriteObjectsChunk(os);
-            ReadWriteTilesChunk(os);
-            ReadWriteBannersChunk(os);
-            ReadWriteRidesChunk(os);
-            ReadWriteEntitiesChunk(os);
-            ReadWriteScenarioChunk(os);
-            ReadWriteGeneralChunk(os);
-            ReadWriteParkChunk(os);
-            ReadWriteClimateChunk(os);
-            ReadWriteResearchChunk(os);
-            ReadWriteNotificationsChunk(os);
-            ReadWriteInterfaceChunk(os);
-            ReadWriteCheatsChunk(os);
-            ReadWriteRestrictedObjectsChunk(os);
-            ReadWritePackedObjectsChunk(os);
+            WriteChunks(os);
+            if (!Compress)
+            {
+                os.GetHeader().Compression = OrcaStream::COMPRESSION_NONE;
+            }
         }
 
         void Save(const std::string_view& path)
@@ -176,6 +493,37 @@ namespace OpenRCT2
             Save(fs);
         }
 
+        /**
+         * Captures the park into memory and returns a function that compresses and writes it to the file, this can
+         * be run on another thread while the game continues.
+         */
+        std::function<void()> SaveDeferred(const std::string_view& path)
+        {
+            auto fs = std::make_shared<FileStream>(path, FILE_MODE_WRITE);
+            OrcaStream os(*fs, OrcaStream::Mode::WRITING);
+            WriteChunks(os);
+            auto write = os.DeferWrite();
+            return [fs, write]() { write(); };
+        }
+
+        /**
+         * Same as SaveDeferred, but the park is written by the delta writer, as a keyframe or as a delta.
+         */
+        std::function<void()> SaveDeferredDelta(
+            const std::string_view& path, std::shared_ptr<ParkFileDelta> delta, int32_t keyframeInterval)
+        {
+            auto park = std::make_shared<MemoryStream>();
+            OrcaStream os(*park, OrcaStream::Mode::WRITING);
+            WriteChunks(os);
+            // The delta writer compares the chunks uncompressed, it compresses what it writes itself.
+            os.GetHeader().Compression = OrcaStream::COMPRESSION_NONE;
+            auto write = os.DeferWrite();
+            return [park, write, delta, pathStr = std::string(path), keyframeInterval]() {
+                write();
+                delta->Write(pathStr, *park, keyframeInterval);
+            };
+        }
+
         scenario_index_entry ReadScenarioChunk()
         {
             scenario_index_entry entry{};
@@ -206,6 +554,78 @@ namespace OpenRCT2
         }
 
     private:
+        void Open(const std::string_view& path)
+        {
+            // Chunks are only read from the file once they are needed, so it stays open with the park file.
+            auto fs = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+            auto os = std::make_unique<OrcaStream>(*fs, OrcaStream::Mode::READING, true);
+            if (!ParkFileDelta::IsDelta(*os))
+            {
+                _os = std::move(os);
+                _stream = std::move(fs);
+                return;
+            }
+
+            auto park = ParkFileDelta::Reconstruct(path, *os);
+            _os = std::make_unique<OrcaStream>(*park, OrcaStream::Mode::READING, true);
+            _stream = std::move(park);
+        }
+
+        void LoadObjects()
+        {
+            RequiredObjects = {};
+            ReadWriteObjectsChunk(*_os);
+            ReadWritePackedObjectsChunk(*_os);
+        }
+
+        void WriteChunks(OrcaStream& os)
+        {
+            auto& header = os.GetHeader();
+            header.Magic = PARK_FILE_MAGIC;
+            header.TargetVersion = PARK_FILE_CURRENT_VERSION;
+            header.MinVersion = PARK_FILE_MIN_VERSION;
+            header.Compression = OrcaStream::COMPRESSION_GZIP_CHUNKED;
+
+            ReadWriteAuthoringChunk(os);
+            ReadWriteObjectsChunk(os);
+            ReadWriteTilesChunk(os);
+            ReadWriteBannersChunk(os);
+            ReadWriteRidesChunk(os);
+            ReadWriteEntitiesChunk(os);
+            ReadWriteScenarioChunk(os);
+            ReadWriteGeneralChunk(os);
+            ReadWriteParkChunk(os);
+            ReadWriteClimateChunk(os);
+            ReadWriteResearchChunk(os);
+            ReadWriteNotificationsChunk(os);
+            ReadWriteInterfaceChunk(os);
+            ReadWriteCheatsChunk(os);
+            ReadWriteRestrictedObjectsChunk(os);
+            ReadWritePackedObjectsChunk(os);
+            os.FinishWritingChunks();
+        }
+
+        /**
+         * Reads or writes a chunk that only reads the game state when it is written, it is then written on another
+         * thread while the following chunks are written.
+         */
+        template<typename TFunc> static bool ReadWriteIndependentChunk(OrcaStream& os, const uint32_t chunkId, TFunc f)
+        {
+            if (os.GetMode() == OrcaStream::Mode::READING)
+            {
+                return os.ReadWriteChunk(chunkId, f);
+            }
+
+            // The chunk has to be written from the world of this thread.
+            os.WriteChunkAsync(chunkId, [worldState = &GetWorldState(), f](OrcaStream::ChunkStream& cs) mutable {
+                auto* previousWorldState = &GetWorldState();
+                SetCurrentWorldState(worldState);
+                f(cs);
+                SetCurrentWorldState(previousWorldState);
+            });
+            return true;
+        }
+
         static uint8_t GetMinCarsPerTrain(uint8_t value)
         {
             return value >> 4;
@@ -421,7 +841,7 @@ namespace OpenRCT2
 
         void ReadWriteGeneralChunk(OrcaStream& os)
         {
-            auto found = os.ReadWriteChunk(ParkFileChunkType::GENERAL, [this](OrcaStream::ChunkStream& cs) {
+            auto found = os.ReadWriteChunk(ParkFileChunkType::GENERAL, [this, &os](OrcaStream::ChunkStream& cs) {
                 cs.ReadWrite(gGamePaused);
                 cs.ReadWrite(gCurrentTicks);
                 cs.ReadWrite(gDateMonthTicks);
@@ -460,7 +880,7 @@ namespace OpenRCT2
                 cs.ReadWrite(gGrassSceneryTileLoopPosition);
                 cs.ReadWrite(gWidePathTileLoopPosition);
 
-                ReadWriteRideRatingCalculationData(cs, gRideRatingUpdateState);
+                ReadWriteRideRatingCalculationData(cs, gRideRatingUpdateState, os.GetHeader().TargetVersion);
             });
             if (!found)
             {
@@ -468,7 +888,8 @@ namespace OpenRCT2
             }
         }
 
-        void ReadWriteRideRatingCalculationData(OrcaStream::ChunkStream& cs, RideRatingUpdateState& calcData)
+        void ReadWriteRideRatingCalculationData(
+            OrcaStream::ChunkStream& cs, RideRatingUpdateState& calcData, uint32_t version)
         {
             cs.ReadWrite(calcData.AmountOfBrakes);
             cs.ReadWrite(calcData.Proximity);
@@ -485,6 +906,16 @@ namespace OpenRCT2
             cs.ReadWrite(calcData.AmountOfBrakes);
             cs.ReadWrite(calcData.AmountOfReversers);
             cs.ReadWrite(calcData.StationFlags);
+            if (version >= 0x9)
+            {
+                cs.ReadWrite(calcData.RoundRobinRide);
+                cs.ReadWriteVector(calcData.DirtyRides, [&cs](ride_id_t& rideId) { cs.ReadWrite(rideId); });
+            }
+            else if (cs.GetMode() == OrcaStream::Mode::READING)
+            {
+                calcData.RoundRobinRide = calcData.CurrentRide;
+                calcData.DirtyRides.clear();
+            }
         }
 
         void ReadWriteInterfaceChunk(OrcaStream& os)
@@ -537,6 +968,22 @@ namespace OpenRCT2
             });
         }
 
+        const std::vector<uint8_t>& ReadPackedObjectData(const std::string& path)
+        {
+            if (ExportObjectsDataCache == nullptr)
+            {
+                _packedObjectData = File::ReadAllBytes(path);
+                return _packedObjectData;
+            }
+
+            auto it = ExportObjectsDataCache->find(path);
+            if (it == ExportObjectsDataCache->end())
+            {
+                it = ExportObjectsDataCache->emplace(path, File::ReadAllBytes(path)).first;
+            }
+            return it->second;
+        }
+
         void ReadWritePackedObjectsChunk(OrcaStream& os)
         {
             static constexpr uint8_t DESCRIPTOR_DAT = 0;
@@ -551,7 +998,8 @@ namespace OpenRCT2
             os.ReadWriteChunk(ParkFileChunkType::PACKED_OBJECTS, [this](OrcaStream::ChunkStream& cs) {
                 if (cs.GetMode() == OrcaStream::Mode::READING)
                 {
-                    auto& objRepository = GetContext()->GetObjectRepository();
+                    auto& objRepository = PackedObjectRepository != nullptr ? *PackedObjectRepository
+                                                                            : GetContext()->GetObjectRepository();
                     auto numObjects = cs.Read<uint32_t>();
                     for (uint32_t i = 0; i < numObjects; i++)
                     {
@@ -619,7 +1067,7 @@ namespace OpenRCT2
                             continue;
                         }
 
-                        auto data = File::ReadAllBytes(ori->Path);
+                        const auto& data = ReadPackedObjectData(ori->Path);
                         cs.Write<uint32_t>(static_cast<uint32_t>(data.size()));
                         cs.Write(data.data(), data.size());
                         count++;
@@ -751,28 +1199,11 @@ namespace OpenRCT2
                     return true;
                 });
 
-                cs.ReadWriteArray(gParkRatingHistory, [&cs](uint8_t& value) {
-                    cs.ReadWrite(value);
-                    return true;
-                });
-
-                cs.ReadWriteArray(gGuestsInParkHistory, [&cs](uint32_t& value) {
-                    cs.ReadWrite(value);
-                    return true;
-                });
-
-                cs.ReadWriteArray(gCashHistory, [&cs](money64& value) {
-                    cs.ReadWrite(value);
-                    return true;
-                });
-                cs.ReadWriteArray(gWeeklyProfitHistory, [&cs](money64& value) {
-                    cs.ReadWrite(value);
-                    return true;
-                });
-                cs.ReadWriteArray(gParkValueHistory, [&cs](money64& value) {
-                    cs.ReadWrite(value);
-                    return true;
-                });
+                ReadWriteHistory(cs, gParkRatingHistory);
+                ReadWriteHistory(cs, gGuestsInParkHistory);
+                ReadWriteHistory(cs, gCashHistory);
+                ReadWriteHistory(cs, gWeeklyProfitHistory);
+                ReadWriteHistory(cs, gParkValueHistory);
             });
         }
 
@@ -792,6 +1223,7 @@ namespace OpenRCT2
                 // Invention list
                 cs.ReadWriteVector(gResearchItemsUninvented, [&cs](ResearchItem& item) { ReadWriteResearchItem(cs, item); });
                 cs.ReadWriteVector(gResearchItemsInvented, [&cs](ResearchItem& item) { ReadWriteResearchItem(cs, item); });
+                ResearchInvalidateIndex();
             });
         }
 
@@ -863,6 +1295,24 @@ namespace OpenRCT2
             });
         }
 
+        template<typename T, size_t TSize, T TUndefined, size_t TExtremaSize>
+        static void ReadWriteHistory(OrcaStream::ChunkStream& cs, HistoryBuffer<T, TSize, TUndefined, TExtremaSize>& history)
+        {
+            std::array<T, TSize> values;
+            std::copy(history.begin(), history.end(), values.begin());
+            cs.ReadWriteArray(values, [&cs](T& value) {
+                cs.ReadWrite(value);
+                return true;
+            });
+            if (cs.GetMode() == OrcaStream::Mode::READING)
+            {
+                for (size_t i = 0; i < TSize; i++)
+                {
+                    history.Set(i, values[i]);
+                }
+            }
+        }
+
         static void ReadWriteNewsItem(OrcaStream::ChunkStream& cs, News::Item& item)
         {
             cs.ReadWrite(item.Type);
@@ -888,8 +1338,8 @@ namespace OpenRCT2
             auto* pathToQueueSurfaceMap = _pathToQueueSurfaceMap;
             auto* pathToRailingsMap = _pathToRailingsMap;
 
-            auto found = os.ReadWriteChunk(
-                ParkFileChunkType::TILES,
+            auto found = ReadWriteIndependentChunk(
+                os, ParkFileChunkType::TILES,
                 [pathToSurfaceMap, pathToQueueSurfaceMap, pathToRailingsMap](OrcaStream::ChunkStream& cs) {
                     cs.ReadWrite(gMapSize); // x
                     cs.Write(gMapSize);     // y
@@ -900,7 +1350,7 @@ namespace OpenRCT2
 
                         auto numElements = cs.Read<uint32_t>();
 
-                        std::vector<TileElement> tileElements;
+                        TileElementVector tileElements;
                         tileElements.resize(numElements);
                         cs.Read(tileElements.data(), tileElements.size() * sizeof(TileElement));
                         SetTileElements(std::move(tileElements));
@@ -932,9 +1382,11 @@ namespace OpenRCT2
                     }
                     else
                     {
-                        auto tileElements = GetReorganisedTileElementsWithoutGhosts();
-                        cs.Write(static_cast<uint32_t>(tileElements.size()));
-                        cs.Write(tileElements.data(), tileElements.size() * sizeof(TileElement));
+                        // Stream the tile runs straight into the chunk rather than building a ghost free copy first
+                        cs.Write(static_cast<uint32_t>(CountTileElementsWithoutGhosts()));
+                        VisitTileElementsWithoutGhosts([&cs](const TileElement* elements, size_t count) {
+                            cs.Write(elements, count * sizeof(TileElement));
+                        });
                     }
                 });
             if (!found)
@@ -971,7 +1423,7 @@ namespace OpenRCT2
 
         void ReadWriteBannersChunk(OrcaStream& os)
         {
-            os.ReadWriteChunk(ParkFileChunkType::BANNERS, [&os](OrcaStream::ChunkStream& cs) {
+            ReadWriteIndependentChunk(os, ParkFileChunkType::BANNERS, [&os](OrcaStream::ChunkStream& cs) {
                 auto version = os.GetHeader().TargetVersion;
                 if (cs.GetMode() == OrcaStream::Mode::WRITING)
                 {
@@ -1050,7 +1502,7 @@ namespace OpenRCT2
         void ReadWriteRidesChunk(OrcaStream& os)
         {
             const auto version = os.GetHeader().TargetVersion;
-            os.ReadWriteChunk(ParkFileChunkType::RIDES, [this, &version](OrcaStream::ChunkStream& cs) {
+            ReadWriteIndependentChunk(os, ParkFileChunkType::RIDES, [this, version](OrcaStream::ChunkStream& cs) {
                 std::vector<ride_id_t> rideIds;
                 if (cs.GetMode() == OrcaStream::Mode::READING)
                 {
@@ -2186,7 +2638,7 @@ namespace OpenRCT2
 
     void ParkFile::ReadWriteEntitiesChunk(OrcaStream& os)
     {
-        os.ReadWriteChunk(ParkFileChunkType::ENTITIES, [this, &os](OrcaStream::ChunkStream& cs) {
+        ReadWriteIndependentChunk(os, ParkFileChunkType::ENTITIES, [this, &os](OrcaStream::ChunkStream& cs) {
             if (cs.GetMode() == OrcaStream::Mode::READING)
             {
                 ResetAllEntities();
@@ -2195,9 +2647,11 @@ namespace OpenRCT2
             std::vector<uint16_t> entityIndices;
             if (cs.GetMode() == OrcaStream::Mode::READING)
             {
+                EntityBatchBegin();
                 ReadEntitiesOfTypes<
                     Vehicle, Guest, Staff, Litter, SteamParticle, MoneyEffect, VehicleCrashParticle, ExplosionCloud,
                     CrashSplashParticle, ExplosionFlare, JumpingFountain, Balloon, Duck>(os, cs);
+                EntityBatchEnd();
             }
             else
             {
@@ -2219,6 +2673,8 @@ void ParkFileExporter::Export(IStream& stream)
 {
     auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
     parkFile->ExportObjectsList = ExportObjectsList;
+    parkFile->ExportObjectsDataCache = ExportObjectsDataCache;
+    parkFile->Compress = Compress;
     parkFile->Save(stream);
 }
 
@@ -2229,6 +2685,33 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
+// Autosave that is still being compressed and written to disk.
+static std::future<void> _autosaveWrite;
+// Keyframe the delta autosaves are written against, only used by the autosave being written.
+static std::shared_ptr<OpenRCT2::ParkFileDelta> _autosaveDelta = std::make_shared<OpenRCT2::ParkFileDelta>();
+
+bool OpenRCT2::IsParkFileDelta(std::string_view path)
+{
+    try
+    {
+        FileStream fs(path, FILE_MODE_OPEN);
+        OrcaStream os(fs, OrcaStream::Mode::READING, true);
+        return ParkFileDelta::IsDelta(os);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+void scenario_wait_for_autosave()
+{
+    if (_autosaveWrite.valid())
+    {
+        _autosaveWrite.get();
+    }
+}
+
 int32_t scenario_save(const utf8* path, int32_t flags)
 {
     if (flags & S6_SAVE_FLAG_SCENARIO)
@@ -2265,7 +2748,28 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         {
             // s6exporter->SaveGame(path);
         }
-        parkFile->Save(path);
+        if (flags & S6_SAVE_FLAG_AUTOMATIC)
+        {
+            // Only capturing the park holds up the game, compressing and writing the file happens in the background.
+            scenario_wait_for_autosave();
+            const auto keyframeInterval = gConfigGeneral.autosave_keyframe_interval;
+            auto write = keyframeInterval > 1 ? parkFile->SaveDeferredDelta(path, _autosaveDelta, keyframeInterval)
+                                              : parkFile->SaveDeferred(path);
+            _autosaveWrite = std::async(std::launch::async, [write, pathStr = std::string(path)]() {
+                try
+                {
+                    write();
+                }
+                catch (const std::exception& e)
+                {
+                    Console::Error::WriteLine("Could not write autosave '%s': %s", pathStr.c_str(), e.what());
+                }
+            });
+        }
+        else
+        {
+            parkFile->Save(path);
+        }
         result = true;
     }
     catch (const std::exception&)
@@ -2284,10 +2788,7 @@ int32_t scenario_save(const utf8* path, int32_t flags)
 class ParkFileImporter final : public IParkImporter
 {
 private:
-#ifdef __clang__
-    [[maybe_unused]]
-#endif
-    const IObjectRepository& _objectRepository;
+    IObjectRepository& _objectRepository;
     std::unique_ptr<OpenRCT2::ParkFile> _parkFile;
 
 public:
@@ -2299,6 +2800,7 @@ public:
     ParkLoadResult Load(const utf8* path) override
     {
         _parkFile = std::make_unique<OpenRCT2::ParkFile>();
+        _parkFile->PackedObjectRepository = &_objectRepository;
         _parkFile->Load(path);
         return ParkLoadResult(std::move(_parkFile->RequiredObjects));
     }
@@ -2317,6 +2819,7 @@ public:
         OpenRCT2::IStream* stream, bool isScenario, bool skipObjectCheck = false, const utf8* path = String::Empty) override
     {
         _parkFile = std::make_unique<OpenRCT2::ParkFile>();
+        _parkFile->PackedObjectRepository = &_objectRepository;
         _parkFile->Load(*stream);
         return ParkLoadResult(std::move(_parkFile->RequiredObjects));
     }
@@ -2332,6 +2835,13 @@ public:
         *dst = _parkFile->ReadScenarioChunk();
         return true;
     }
+
+    bool LoadScenarioDetails(const utf8* path, scenario_index_entry* dst) override
+    {
+        _parkFile = std::make_unique<OpenRCT2::ParkFile>();
+        _parkFile->LoadScenarioDetails(path);
+        return GetDetails(dst);
+    }
 };
 
 std::unique_ptr<IParkImporter> ParkImporter::CreateParkFile(IObjectRepository& objectRepository)
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 struct ObjectRepositoryItem;
@@ -8,20 +11,34 @@ struct ObjectRepositoryItem;
 namespace OpenRCT2
 {
     // Current version that is saved.
-    constexpr uint32_t PARK_FILE_CURRENT_VERSION = 0x8;
+    constexpr uint32_t PARK_FILE_CURRENT_VERSION = 0xB;
 
     // The minimum version that is forwards compatible with the current version.
-    constexpr uint32_t PARK_FILE_MIN_VERSION = 0x8;
+    constexpr uint32_t PARK_FILE_MIN_VERSION = 0xA;
+
+    // The minimum version of delta autosaves, which older versions can not put back together.
+    constexpr uint32_t PARK_FILE_DELTA_MIN_VERSION = 0xB;
 
     constexpr uint32_t PARK_FILE_MAGIC = 0x4B524150; // PARK
 
     struct IStream;
+
+    /**
+     * @return whether the park file is a delta autosave, which can only be loaded while its keyframe exists.
+     */
+    bool IsParkFileDelta(std::string_view path);
 } // namespace OpenRCT2
 
+// Contents of packed object files by path, used to only read them once when the same objects are exported repeatedly.
+using PackedObjectDataCache = std::unordered_map<std::string, std::vector<uint8_t>>;
+
 class ParkFileExporter
 {
 public:
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
+    PackedObjectDataCache* ExportObjectsDataCache{};
+    // Uncompressed parks are larger but can be compared byte by byte.
+    bool Compress = true;
 
     void Export(std::string_view path);
     void Export(OpenRCT2::IStream& stream);
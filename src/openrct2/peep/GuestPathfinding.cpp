@@ -10,6 +10,7 @@
 #include "GuestPathfinding.h"
 
 #include "../core/Guard.hpp"
+#include "../core/Profiler.h"
 #include "../entity/Guest.h"
 #include "../entity/Staff.h"
 #include "../ride/RideData.h"
@@ -19,9 +20,15 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/Park.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -558,6 +565,55 @@ static bool path_is_thin_junction(PathElement* path, const TileCoordsXYZ& loc)
     return thin_junction;
 }
 
+/**
+ * Whether a path element is a thin junction only depends on the surrounding map, but the
+ * check scans every neighbouring tile and is repeated by each peep searching through the
+ * same junction. Results are cached while a peep update pass is running, paths can not be
+ * changed by the peeps themselves so the cache can not go stale during the pass.
+ */
+static struct
+{
+    bool Active = false;
+    std::unordered_map<uint64_t, bool> ThinJunctions;
+} _pathFindJunctionCache;
+
+void PathfindJunctionCacheBegin()
+{
+    _pathFindJunctionCache.ThinJunctions.clear();
+    _pathFindJunctionCache.Active = true;
+}
+
+void PathfindJunctionCacheEnd()
+{
+    _pathFindJunctionCache.Active = false;
+    _pathFindJunctionCache.ThinJunctions.clear();
+}
+
+static bool path_is_thin_junction_cached(PathElement* path, const TileCoordsXYZ& loc)
+{
+    if (!_pathFindJunctionCache.Active)
+        return path_is_thin_junction(path, loc);
+
+    // The result depends on the location, the edges and the slope of the path.
+    uint64_t key = (static_cast<uint64_t>(loc.x & 0xFFFF) << 40) | (static_cast<uint64_t>(loc.y & 0xFFFF) << 24)
+        | (static_cast<uint64_t>(loc.z & 0xFF) << 16) | (path->GetEdges() << 4);
+    if (path->IsSloped())
+    {
+        key |= 0x8 | path->GetSlopeDirection();
+    }
+
+    auto it = _pathFindJunctionCache.ThinJunctions.find(key);
+    if (it == _pathFindJunctionCache.ThinJunctions.end())
+    {
+        it = _pathFindJunctionCache.ThinJunctions.emplace(key, path_is_thin_junction(path, loc)).first;
+    }
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    // Validate the cached result against the uncached check.
+    Guard::Assert(it->second == path_is_thin_junction(path, loc), "Stale thin junction cache entry");
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    return it->second;
+}
+
 static int32_t CalculateHeuristicPathingScore(const TileCoordsXYZ& loc1, const TileCoordsXYZ& loc2)
 {
     auto xDelta = abs(loc1.x - loc2.x) * 32;
@@ -1062,7 +1118,7 @@ static void peep_pathfind_heuristic_search(
         {
             /* Check if this is a thin junction. And perform additional
              * necessary checks. */
-            thin_junction = path_is_thin_junction(tileElement->AsPath(), loc);
+            thin_junction = path_is_thin_junction_cached(tileElement->AsPath(), loc);
 
             if (thin_junction)
             {
@@ -1252,6 +1308,251 @@ static void peep_pathfind_heuristic_search(
     }
 }
 
+/**
+ * Flow fields store, for one goal, the number of tiles a guest has to walk from every path
+ * element that can reach it. They are built with a breadth first search from the goal and
+ * shared by every guest heading to the same goal. A field only depends on the map (ghost
+ * elements are skipped) and the queue settings it was built for, so rebuilding it at any
+ * time gives the same result on every client.
+ */
+struct GuestFlowFieldKey
+{
+    TileCoordsXYZ Goal;
+    ride_id_t QueueRideIndex;
+    bool IgnoreForeignQueues;
+
+    bool operator==(const GuestFlowFieldKey& other) const
+    {
+        return Goal == other.Goal && QueueRideIndex == other.QueueRideIndex
+            && IgnoreForeignQueues == other.IgnoreForeignQueues;
+    }
+};
+
+struct GuestFlowField
+{
+    GuestFlowFieldKey Key;
+    std::unordered_map<uint32_t, uint16_t> Distances;
+};
+
+static constexpr size_t GuestFlowFieldMaxCount = 64;
+static std::vector<std::unique_ptr<GuestFlowField>> _guestFlowFields;
+
+// The end of the queue leading to each ride entrance guests have headed to, by entrance location. Like the flow fields
+// it only depends on the map, how many guests are queueing does not move the tile the queue ends on.
+static std::unordered_map<uint32_t, TileCoordsXYZ> _rideQueueEnds;
+
+void GuestFlowFieldInvalidate()
+{
+    _guestFlowFields.clear();
+    _rideQueueEnds.clear();
+}
+
+static uint32_t GuestFlowFieldNodeKey(const TileCoordsXYZ& loc)
+{
+    return (static_cast<uint32_t>(loc.x) << 18) | (static_cast<uint32_t>(loc.y) << 8) | static_cast<uint8_t>(loc.z);
+}
+
+static bool GuestFlowFieldIsPassable(const GuestFlowFieldKey& key, const PathElement* pathElement)
+{
+    if (!key.IgnoreForeignQueues || !pathElement->IsQueue())
+        return true;
+
+    const auto rideIndex = pathElement->GetRideIndex();
+    return rideIndex == RIDE_ID_NULL || rideIndex == key.QueueRideIndex;
+}
+
+/**
+ * Finds the path element a guest walks onto when leaving the path at loc in the given
+ * direction, the same way the heuristic search steps between tiles.
+ */
+static PathElement* GuestFlowFieldStep(
+    const TileCoordsXYZ& loc, const PathElement* pathElement, Direction direction, TileCoordsXYZ& nextLoc)
+{
+    nextLoc = loc;
+    if (pathElement->IsSloped() && pathElement->GetSlopeDirection() == direction)
+    {
+        nextLoc.z += 2;
+    }
+    nextLoc += TileDirectionDelta[direction];
+
+    TileElement* tileElement = map_get_first_element_at(nextLoc);
+    if (tileElement == nullptr)
+        return nullptr;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+            continue;
+        if (!IsValidPathZAndDirection(tileElement, nextLoc.z, direction))
+            continue;
+
+        nextLoc.z = tileElement->base_height;
+        return tileElement->AsPath();
+    } while (!(tileElement++)->IsLastForTile());
+
+    return nullptr;
+}
+
+template<typename TFunc> static void GuestFlowFieldForEachPath(const TileCoordsXYZ& loc, TFunc func)
+{
+    TileElement* tileElement = map_get_first_element_at(loc);
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+            continue;
+        if (tileElement->base_height != loc.z)
+            continue;
+        func(tileElement->AsPath());
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+static void GuestFlowFieldBuild(GuestFlowField& field)
+{
+    const auto& key = field.Key;
+    std::vector<TileCoordsXYZ> queue;
+
+    // Seed with every path that steps onto the goal.
+    for (Direction direction = 0; direction < NumOrthogonalDirections; direction++)
+    {
+        TileCoordsXYZ from = key.Goal;
+        from -= TileDirectionDelta[direction];
+        TileElement* tileElement = map_get_first_element_at(from);
+        if (tileElement == nullptr)
+            continue;
+        do
+        {
+            if (tileElement->IsGhost() || tileElement->GetType() != TileElementType::Path)
+                continue;
+
+            auto* pathElement = tileElement->AsPath();
+            if (!GuestFlowFieldIsPassable(key, pathElement) || !(path_get_permitted_edges(pathElement) & (1 << direction)))
+                continue;
+
+            TileCoordsXYZ pathLoc = { from.x, from.y, tileElement->base_height };
+            TileCoordsXYZ nextLoc;
+            if (GuestFlowFieldStep(pathLoc, pathElement, direction, nextLoc) == nullptr)
+            {
+                // Stepping onto something that is not a path, e.g. a ride entrance.
+                nextLoc = pathLoc;
+                if (pathElement->IsSloped() && pathElement->GetSlopeDirection() == direction)
+                {
+                    nextLoc.z += 2;
+                }
+                nextLoc += TileDirectionDelta[direction];
+            }
+            if (nextLoc != key.Goal)
+                continue;
+
+            if (field.Distances.emplace(GuestFlowFieldNodeKey(pathLoc), 1).second)
+            {
+                queue.push_back(pathLoc);
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+
+    // Walk backwards from the goal, path connections are symmetrical so the element reached
+    // by stepping in a direction is the one that can step back in the reverse direction.
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        const auto loc = queue[i];
+        const auto distance = field.Distances[GuestFlowFieldNodeKey(loc)];
+        if (distance == std::numeric_limits<uint16_t>::max() - 1)
+            continue;
+
+        GuestFlowFieldForEachPath(loc, [&](PathElement* pathElement) {
+            for (Direction direction = 0; direction < NumOrthogonalDirections; direction++)
+            {
+                TileCoordsXYZ prevLoc;
+                auto* prevElement = GuestFlowFieldStep(loc, pathElement, direction, prevLoc);
+                if (prevElement == nullptr || !GuestFlowFieldIsPassable(key, prevElement))
+                    continue;
+                if (!(path_get_permitted_edges(prevElement) & (1 << direction_reverse(direction))))
+                    continue;
+
+                if (field.Distances.emplace(GuestFlowFieldNodeKey(prevLoc), distance + 1).second)
+                {
+                    queue.push_back(prevLoc);
+                }
+            }
+        });
+    }
+}
+
+static const GuestFlowField& GuestFlowFieldGet(const GuestFlowFieldKey& key)
+{
+    // Most recently used fields are kept at the back.
+    auto it = std::find_if(
+        _guestFlowFields.begin(), _guestFlowFields.end(), [&key](const auto& field) { return field->Key == key; });
+    if (it != _guestFlowFields.end())
+    {
+        std::rotate(it, it + 1, _guestFlowFields.end());
+        return *_guestFlowFields.back();
+    }
+
+    if (_guestFlowFields.size() >= GuestFlowFieldMaxCount)
+    {
+        _guestFlowFields.erase(_guestFlowFields.begin());
+    }
+
+    auto field = std::make_unique<GuestFlowField>();
+    field->Key = key;
+    GuestFlowFieldBuild(*field);
+    _guestFlowFields.push_back(std::move(field));
+    return *_guestFlowFields.back();
+}
+
+/**
+ * Chooses the permitted edge leading to the neighbour closest to the goal.
+ * @return INVALID_DIRECTION if the goal can not be reached from this path.
+ */
+static Direction GuestFlowFieldChooseDirection(const TileCoordsXYZ& loc, PathElement* pathElement, uint8_t edges)
+{
+    const GuestFlowFieldKey key = { gPeepPathFindGoalPosition, gPeepPathFindQueueRideIndex,
+                                    gPeepPathFindIgnoreForeignQueues };
+    const auto& field = GuestFlowFieldGet(key);
+
+    Direction chosenDirection = INVALID_DIRECTION;
+    uint32_t bestDistance = std::numeric_limits<uint32_t>::max();
+    for (Direction direction = 0; direction < NumOrthogonalDirections; direction++)
+    {
+        if (!(edges & (1 << direction)))
+            continue;
+
+        TileCoordsXYZ nextLoc;
+        auto* nextElement = GuestFlowFieldStep(loc, pathElement, direction, nextLoc);
+        if (nextElement == nullptr)
+        {
+            nextLoc = loc;
+            if (pathElement->IsSloped() && pathElement->GetSlopeDirection() == direction)
+            {
+                nextLoc.z += 2;
+            }
+            nextLoc += TileDirectionDelta[direction];
+        }
+
+        uint32_t distance;
+        if (nextLoc == key.Goal)
+        {
+            distance = 0;
+        }
+        else
+        {
+            auto it = field.Distances.find(GuestFlowFieldNodeKey(nextLoc));
+            if (nextElement == nullptr || it == field.Distances.end())
+                continue;
+            distance = it->second;
+        }
+
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            chosenDirection = direction;
+        }
+    }
+    return chosenDirection;
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -1261,6 +1562,8 @@ static void peep_pathfind_heuristic_search(
  */
 Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
 {
+    PROFILE_ZONE(Pathfinding);
+
     // The max number of thin junctions searched - a per-search-path limit.
     _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
 
@@ -1323,7 +1626,7 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
          * check if the combination is 'thin'!
          * The junction is considered 'thin' simply if any of the
          * overlaid path elements there is a 'thin junction'. */
-        isThin = isThin || path_is_thin_junction(dest_tile_element->AsPath(), loc);
+        isThin = isThin || path_is_thin_junction_cached(dest_tile_element->AsPath(), loc);
 
         // Collect the permitted edges of ALL matching path elements at this location.
         permitted_edges |= path_get_permitted_edges(dest_tile_element->AsPath());
@@ -1418,6 +1721,14 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     }
 
+    // Guests heading somewhere reachable follow the goal's flow field instead of searching.
+    if ((gParkFlags & PARK_FLAGS_GUEST_FLOW_FIELD_NAVIGATION) && !_peepPathFindIsStaff)
+    {
+        Direction flowFieldDirection = GuestFlowFieldChooseDirection(loc, first_tile_element->AsPath(), permitted_edges);
+        if (flowFieldDirection != INVALID_DIRECTION)
+            return flowFieldDirection;
+    }
+
     // Peep has tried all edges.
     if (edges == 0)
         return INVALID_DIRECTION;
@@ -1790,7 +2101,7 @@ static int32_t GuestPathFindParkEntranceLeaving(Peep* peep, uint8_t edges)
  * In case where the map element at (x, y) is invalid or there is no entrance
  * or queue leading to it the function will not update its arguments.
  */
-static void get_ride_queue_end(TileCoordsXYZ& loc)
+static void get_ride_queue_end_uncached(TileCoordsXYZ& loc)
 {
     TileCoordsXY queueEnd = { 0, 0 };
     TileElement* tileElement = map_get_first_element_at(loc);
@@ -1925,6 +2236,25 @@ static void get_ride_queue_end(TileCoordsXYZ& loc)
     loc.z = tileElement->base_height;
 }
 
+static void get_ride_queue_end(TileCoordsXYZ& loc)
+{
+    const auto key = GuestFlowFieldNodeKey(loc);
+    auto it = _rideQueueEnds.find(key);
+    if (it == _rideQueueEnds.end())
+    {
+        auto queueEnd = loc;
+        get_ride_queue_end_uncached(queueEnd);
+        it = _rideQueueEnds.emplace(key, queueEnd).first;
+    }
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    // Validate the cached queue end against walking the queue again.
+    auto queueEnd = loc;
+    get_ride_queue_end_uncached(queueEnd);
+    Guard::Assert(it->second == queueEnd, "Stale ride queue end cache entry");
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    loc = it->second;
+}
+
 /*
  * If a ride has multiple entrance stations and is set to sync with
  * adjacent stations, cycle through the entrance stations (based on
@@ -51,6 +51,14 @@ bool IsValidPathZAndDirection(TileElement* tileElement, int32_t currentZ, int32_
 // Returns 0 if the guest has successfully had a new destination set up, nonzero otherwise.
 int32_t guest_path_finding(Guest* peep);
 
+// Discards the guest flow fields and ride queue ends, must be called whenever footpaths, entrances or rides may have changed.
+void GuestFlowFieldInvalidate();
+
+// Caches map-only pathfinding lookups between the two calls. Only use this around code that
+// does not modify footpaths, such as the peep update loop.
+void PathfindJunctionCacheBegin();
+void PathfindJunctionCacheEnd();
+
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 #    define PATHFIND_DEBUG                                                                                                     \
         0 // Set to 0 to disable pathfinding debugging;
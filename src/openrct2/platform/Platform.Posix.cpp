@@ -17,13 +17,24 @@
 #    include "Platform2.h"
 
 #    include <cerrno>
+#    include <cstdio>
 #    include <clocale>
 #    include <cstdlib>
 #    include <cstring>
 #    include <ctime>
 #    include <dirent.h>
+#    include <pthread.h>
 #    include <pwd.h>
+#    include <sys/mman.h>
 #    include <sys/stat.h>
+#    if defined(__linux__)
+#        include <sched.h>
+#        include <sys/resource.h>
+#        include <sys/syscall.h>
+#        include <unistd.h>
+#    elif defined(__FreeBSD__)
+#        include <pthread_np.h>
+#    endif
 
 #    define FILE_BUFFER_SIZE 4096
 
@@ -267,6 +278,134 @@ namespace Platform
         }
         return result;
     }
+
+    void SetCurrentThreadName(std::string_view name)
+    {
+        // Linux refuses names that do not fit in 16 bytes.
+        auto truncated = std::string(name.substr(0, 15));
+#    if defined(__APPLE__)
+        pthread_setname_np(truncated.c_str());
+#    elif defined(__FreeBSD__)
+        pthread_set_name_np(pthread_self(), truncated.c_str());
+#    elif defined(__linux__)
+        pthread_setname_np(pthread_self(), truncated.c_str());
+#    endif
+    }
+
+    bool SetCurrentThreadPriority(ThreadPriority priority)
+    {
+#    if defined(__linux__)
+        // Linux schedules threads individually, every thread has its own nice value.
+        int32_t niceValue = 0;
+        if (priority == ThreadPriority::Low)
+            niceValue = 5;
+        else if (priority == ThreadPriority::High)
+            niceValue = -5;
+        return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceValue) == 0;
+#    else
+        return false;
+#    endif
+    }
+
+    bool SetCurrentThreadAffinity(const std::vector<int32_t>& cores)
+    {
+#    if defined(__linux__)
+        static const cpu_set_t processSet = []() {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            sched_getaffinity(0, sizeof(set), &set);
+            return set;
+        }();
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto core : cores)
+        {
+            if (core >= 0 && core < CPU_SETSIZE)
+                CPU_SET(core, &set);
+        }
+        if (cores.empty())
+            set = processSet;
+        if (CPU_COUNT(&set) == 0)
+            return false;
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#    else
+        return false;
+#    endif
+    }
+
+#    if defined(__linux__)
+    // The page size transparent huge pages are made of, the same as that of explicit ones on all common systems.
+    static size_t GetHugePageSize()
+    {
+        size_t size = 0;
+        auto* meminfo = fopen("/proc/meminfo", "r");
+        if (meminfo != nullptr)
+        {
+            char line[256];
+            while (fgets(line, sizeof(line), meminfo) != nullptr)
+            {
+                unsigned long sizeKiB = 0;
+                if (sscanf(line, "Hugepagesize: %lu kB", &sizeKiB) == 1)
+                {
+                    size = static_cast<size_t>(sizeKiB) * 1024;
+                    break;
+                }
+            }
+            fclose(meminfo);
+        }
+        return size;
+    }
+#    endif
+
+    size_t InitialiseLargePages()
+    {
+#    if defined(__linux__) && defined(MADV_HUGEPAGE)
+        static const size_t pageSize = GetHugePageSize();
+        return pageSize;
+#    else
+        return 0;
+#    endif
+    }
+
+    void* AllocateLargePages(size_t size, LargePageKind& kind)
+    {
+#    if defined(__linux__) && defined(MADV_HUGEPAGE)
+#        if defined(MAP_HUGETLB)
+        // Explicit huge pages only exist if the administrator has reserved some.
+        auto* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED)
+        {
+            kind = LargePageKind::Explicit;
+            return ptr;
+        }
+#        endif
+
+        // The kernel only backs whole huge pages with huge pages, map more so the memory can start on one.
+        const auto pageSize = InitialiseLargePages();
+        auto* mapped = mmap(nullptr, size + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED)
+            return nullptr;
+
+        auto* start = static_cast<uint8_t*>(mapped);
+        auto* aligned = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(start) + pageSize - 1) & ~(pageSize - 1));
+        if (aligned != start)
+            munmap(start, aligned - start);
+        munmap(aligned + size, start + pageSize - aligned);
+
+        kind = madvise(aligned, size, MADV_HUGEPAGE) == 0 ? LargePageKind::Transparent : LargePageKind::None;
+        return aligned;
+#    else
+        return nullptr;
+#    endif
+    }
+
+    void FreeLargePages(void* ptr, size_t size)
+    {
+#    if defined(__linux__) && defined(MADV_HUGEPAGE)
+        munmap(ptr, size);
+#    endif
+    }
 } // namespace Platform
 
 #endif
@@ -707,6 +707,81 @@ namespace Platform
 
         return Platform::GetCurrencyValue(currCode);
     }
+
+    void SetCurrentThreadName(std::string_view name)
+    {
+        // Only available from Windows 10 version 1607.
+        using SetThreadDescriptionFn = HRESULT(WINAPI*)(HANDLE, PCWSTR);
+        static auto setThreadDescription = reinterpret_cast<SetThreadDescriptionFn>(
+            GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+        if (setThreadDescription != nullptr)
+        {
+            auto wname = String::ToWideChar(name);
+            setThreadDescription(GetCurrentThread(), wname.c_str());
+        }
+    }
+
+    bool SetCurrentThreadPriority(ThreadPriority priority)
+    {
+        int32_t value = THREAD_PRIORITY_NORMAL;
+        if (priority == ThreadPriority::Low)
+            value = THREAD_PRIORITY_BELOW_NORMAL;
+        else if (priority == ThreadPriority::High)
+            value = THREAD_PRIORITY_ABOVE_NORMAL;
+        return SetThreadPriority(GetCurrentThread(), value) != 0;
+    }
+
+    bool SetCurrentThreadAffinity(const std::vector<int32_t>& cores)
+    {
+        // Threads can only run on the cores of a single processor group, up to 64 of them.
+        DWORD_PTR mask = 0;
+        for (auto core : cores)
+        {
+            if (core >= 0 && core < static_cast<int32_t>(sizeof(mask) * 8))
+                mask |= static_cast<DWORD_PTR>(1) << core;
+        }
+        if (cores.empty())
+        {
+            // Windows threads start on the cores of the process, not of the thread that created them.
+            DWORD_PTR systemMask{};
+            GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask);
+        }
+        return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+    }
+
+    size_t InitialiseLargePages()
+    {
+        // Large pages can only be allocated by users that hold the lock pages in memory privilege.
+        HANDLE token{};
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+            return 0;
+
+        TOKEN_PRIVILEGES privileges{};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool enabled = false;
+        if (LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid))
+        {
+            // AdjustTokenPrivileges succeeds even when the privilege was not granted, only the last error tells.
+            enabled = AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr)
+                && GetLastError() == ERROR_SUCCESS;
+        }
+        CloseHandle(token);
+        return enabled ? GetLargePageMinimum() : 0;
+    }
+
+    void* AllocateLargePages(size_t size, LargePageKind& kind)
+    {
+        auto* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (ptr != nullptr)
+            kind = LargePageKind::Explicit;
+        return ptr;
+    }
+
+    void FreeLargePages(void* ptr, size_t /*size*/)
+    {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    }
 } // namespace Platform
 
 #endif
@@ -14,6 +14,7 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
 
 enum class SPECIAL_FOLDER
 {
@@ -25,6 +26,21 @@ enum class SPECIAL_FOLDER
     RCT2_DISCORD,
 };
 
+enum class ThreadPriority
+{
+    Low,
+    Normal,
+    High,
+};
+
+enum class LargePageKind
+{
+    // Mapped with regular pages as no large ones were available.
+    None,
+    Transparent,
+    Explicit,
+};
+
 namespace Platform
 {
     uint32_t GetTicks();
@@ -77,4 +93,43 @@ namespace Platform
     bool HandleSpecialCommandLineArgument(const char* argument);
     utf8* StrDecompToPrecomp(utf8* input);
     bool RequireNewWindow(bool openGL);
+
+    /**
+     * Names the calling thread, so it can be told apart in debuggers and profilers. Some platforms cut off long names,
+     * Linux after 15 characters.
+     */
+    void SetCurrentThreadName(std::string_view name);
+
+    /**
+     * Raising the priority may require privileges the process does not have.
+     * @return whether the priority has been changed.
+     */
+    bool SetCurrentThreadPriority(ThreadPriority priority);
+
+    /**
+     * Confines the calling thread to the given cores, unknown ones are ignored. An empty list restores the cores the
+     * process could run on when this was first called.
+     * @return whether the affinity has been changed.
+     */
+    bool SetCurrentThreadAffinity(const std::vector<int32_t>& cores);
+
+    /**
+     * Parses a list of cores such as "0-3,6" as used in the configuration, an empty list stands for all cores.
+     */
+    std::vector<int32_t> ParseCoreList(std::string_view list);
+
+    /**
+     * Prepares the process for large page allocations, on Windows this enables the privilege they require.
+     * @return the size of a large page, 0 if the system has none to give.
+     */
+    size_t InitialiseLargePages();
+
+    /**
+     * Maps memory backed by explicitly reserved large pages if there are any left, transparent ones otherwise. The size
+     * must be a multiple of the large page size.
+     * @return nullptr if no memory could be mapped.
+     */
+    void* AllocateLargePages(size_t size, LargePageKind& kind);
+
+    void FreeLargePages(void* ptr, size_t size);
 } // namespace Platform
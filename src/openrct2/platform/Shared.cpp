@@ -137,14 +137,59 @@ namespace Platform
         sanitised = String::Trim(sanitised);
         return sanitised;
     }
+
+    std::vector<int32_t> ParseCoreList(std::string_view list)
+    {
+        // Keeps typing mistakes such as "0-99999" from allocating a huge list.
+        constexpr int32_t MaxCore = 1023;
+
+        std::vector<int32_t> cores;
+        for (const auto& range : String::Split(list, ","))
+        {
+            auto trimmed = String::Trim(range);
+            if (trimmed.empty())
+                continue;
+
+            int32_t first = 0;
+            int32_t last = 0;
+            auto separator = trimmed.find('-');
+            if (separator == std::string::npos)
+            {
+                first = last = std::atoi(trimmed.c_str());
+            }
+            else
+            {
+                first = std::atoi(trimmed.substr(0, separator).c_str());
+                last = std::atoi(trimmed.substr(separator + 1).c_str());
+            }
+            for (auto core = std::max(first, 0); core <= std::min(last, MaxCore); core++)
+            {
+                cores.push_back(core);
+            }
+        }
+        std::sort(cores.begin(), cores.end());
+        cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+        return cores;
+    }
 } // namespace Platform
 
 GamePalette gPalette;
+uint32_t gPaletteGeneration;
+
+static bool PaletteColoursEqual(const PaletteBGRA& a, const PaletteBGRA& b)
+{
+    return a.Blue == b.Blue && a.Green == b.Green && a.Red == b.Red && a.Alpha == b.Alpha;
+}
 
 void platform_update_palette(const uint8_t* colours, int32_t start_index, int32_t num_colours)
 {
     colours += start_index * 4;
 
+    bool changed = gPaletteGeneration == 0;
+#ifdef __ENABLE_LIGHTFX__
+    // The light palette is derived from the filter state as well, it can change while the game palette does not.
+    changed |= lightfx_is_available();
+#endif
     for (int32_t i = start_index; i < num_colours + start_index; i++)
     {
         uint8_t r = colours[2];
@@ -168,19 +213,22 @@ void platform_update_palette(const uint8_t* colours, int32_t start_index, int32_
             }
         }
 
-        gPalette[i].Red = r;
-        gPalette[i].Green = g;
-        gPalette[i].Blue = b;
-        gPalette[i].Alpha = 0;
+        const PaletteBGRA colour = { b, g, r, 0 };
+        changed |= !PaletteColoursEqual(gPalette[i], colour);
+        gPalette[i] = colour;
         colours += 4;
     }
 
     // Fix #1749 and #6535: rainbow path, donut shop and pause button contain black spots that should be white.
-    gPalette[255].Alpha = 0;
-    gPalette[255].Red = 255;
-    gPalette[255].Green = 255;
-    gPalette[255].Blue = 255;
+    const PaletteBGRA white = { 255, 255, 255, 0 };
+    changed |= !PaletteColoursEqual(gPalette[255], white);
+    gPalette[255] = white;
+
+    // The animated colours are pushed every frame, most of the time without any of them changing.
+    if (!changed)
+        return;
 
+    gPaletteGeneration++;
     if (!gOpenRCT2Headless)
     {
         drawing_engine_set_palette(gPalette);
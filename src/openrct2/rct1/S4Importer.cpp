@@ -47,6 +47,7 @@
 #include "../object/ObjectRepository.h"
 #include "../peep/RideUseSystem.h"
 #include "../rct12/EntryList.h"
+#include "../rct12/TileImport.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -170,6 +171,16 @@ namespace RCT1
             return ParkLoadResult(GetRequiredObjects());
         }
 
+        bool LoadScenarioDetails(const utf8* path, scenario_index_entry* dst) override
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+            ReadS4Details(&fs, true);
+            _s4Path = path;
+            _isScenario = true;
+            _gameVersion = sawyercoding_detect_rct1_version(_s4.game_version) & FILE_VERSION_MASK;
+            return GetDetails(dst);
+        }
+
         void Import() override
         {
             Initialise();
@@ -315,6 +326,40 @@ namespace RCT1
             throw std::runtime_error("Unable to decode park.");
         }
 
+        /**
+         * Only decodes the end of the park, from the research list onwards, which holds everything GetDetails reads.
+         * The tiles, sprites and rides before it are skipped.
+         */
+        void ReadS4Details(IStream* stream, bool isScenario)
+        {
+            auto* s4Data = reinterpret_cast<uint8_t*>(&_s4);
+            auto* details = reinterpret_cast<uint8_t*>(&_s4.research_items);
+            const size_t detailsOffset = details - s4Data;
+            const size_t detailsLength = sizeof(S4) - detailsOffset;
+            // The SC4 scrambling works on words, so the range has to start on one
+            Guard::Assert((detailsOffset - 0x60018) % 4 == 0);
+
+            size_t dataSize = stream->GetLength() - stream->GetPosition();
+            auto data = stream->ReadArray<uint8_t>(dataSize);
+
+            std::memset(s4Data, 0, sizeof(S4));
+            size_t decodedSize;
+            int32_t fileType = sawyercoding_detect_file_type(data.get(), dataSize);
+            if (isScenario && (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1)
+            {
+                decodedSize = sawyercoding_decode_sc4_range(data.get(), details, dataSize, detailsOffset, detailsLength);
+            }
+            else
+            {
+                decodedSize = sawyercoding_decode_sv4_range(data.get(), details, dataSize, detailsOffset, detailsLength);
+            }
+
+            if (decodedSize != detailsLength)
+            {
+                throw std::runtime_error("Unable to decode park.");
+            }
+        }
+
         void Initialise()
         {
             // Avoid reusing the value used for last import
@@ -1408,9 +1453,9 @@ namespace RCT1
 
             for (size_t i = 0; i < Limits::FinanceGraphSize; i++)
             {
-                gCashHistory[i] = ToMoney64(_s4.cash_history[i]);
-                gParkValueHistory[i] = ToMoney64(CorrectRCT1ParkValue(_s4.park_value_history[i]));
-                gWeeklyProfitHistory[i] = ToMoney64(_s4.weekly_profit_history[i]);
+                gCashHistory.Set(i, ToMoney64(_s4.cash_history[i]));
+                gParkValueHistory.Set(i, ToMoney64(CorrectRCT1ParkValue(_s4.park_value_history[i])));
+                gWeeklyProfitHistory.Set(i, ToMoney64(_s4.weekly_profit_history[i]));
             }
 
             for (size_t i = 0; i < Limits::ExpenditureTableMonthCount; i++)
@@ -1506,52 +1551,72 @@ namespace RCT1
             auto tilePointerIndex = TilePointerIndex<RCT12TileElement>(
                 Limits::MaxMapSize, _s4.tile_elements, std::size(_s4.tile_elements));
 
-            std::vector<TileElement> tileElements;
             const auto maxSize = _s4.map_size == 0 ? Limits::MaxMapSize : _s4.map_size;
-            for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
-            {
-                for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+            auto tileElements = RCT12::ImportTiles([&](const TileCoordsXY& coords, std::vector<TileElement>& elements) {
+                auto tileAdded = false;
+                if (coords.x < maxSize && coords.y < maxSize)
                 {
-                    auto tileAdded = false;
-                    if (coords.x < maxSize && coords.y < maxSize)
+                    // This is the equivalent of map_get_first_element_at(x, y), but on S4 data.
+                    RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
+                    do
                     {
-                        // This is the equivalent of map_get_first_element_at(x, y), but on S4 data.
-                        RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
-                        do
-                        {
-                            if (srcElement->base_height == Limits::MaxElementHeight)
-                                continue;
-
-                            // Reserve 8 elements for import
-                            auto originalSize = tileElements.size();
-                            tileElements.resize(originalSize + 16);
-                            auto dstElement = tileElements.data() + originalSize;
-                            auto numAddedElements = ImportTileElement(dstElement, srcElement);
-                            tileElements.resize(originalSize + numAddedElements);
-                            tileAdded = true;
-                        } while (!(srcElement++)->IsLastForTile());
-                    }
+                        if (srcElement->base_height == Limits::MaxElementHeight)
+                            continue;
 
-                    if (!tileAdded)
-                    {
-                        // Add a default surface element, we always need at least one element per tile
-                        auto& dstElement = tileElements.emplace_back();
-                        dstElement.ClearAs(TileElementType::Surface);
-                        dstElement.SetLastForTile(true);
-                    }
+                        // Reserve 8 elements for import
+                        auto originalSize = elements.size();
+                        elements.resize(originalSize + 16);
+                        auto dstElement = elements.data() + originalSize;
+                        auto numAddedElements = ImportTileElement(dstElement, srcElement);
+                        elements.resize(originalSize + numAddedElements);
+                        tileAdded = true;
+                    } while (!(srcElement++)->IsLastForTile());
+                }
 
-                    // Set last element flag in case the original last element was never added
-                    if (tileElements.size() > 0)
-                    {
-                        tileElements.back().SetLastForTile(true);
-                    }
+                if (!tileAdded)
+                {
+                    // Add a default surface element, we always need at least one element per tile
+                    auto& dstElement = elements.emplace_back();
+                    dstElement.ClearAs(TileElementType::Surface);
+                    dstElement.SetLastForTile(true);
                 }
-            }
+
+                // Set last element flag in case the original last element was never added
+                elements.back().SetLastForTile(true);
+            });
+            ImportTileBanners(tileElements);
 
             SetTileElements(std::move(tileElements));
             FixEntrancePositions();
         }
 
+        /**
+         * Creates the banners of the imported banner elements, RCT1 walls and large scenery have none. The tiles are
+         * converted on several threads so this can only be done once they all are.
+         */
+        void ImportTileBanners(TileElementVector& tileElements)
+        {
+            for (auto& element : tileElements)
+            {
+                auto* bannerElement = element.AsBanner();
+                auto bannerIndex = bannerElement != nullptr ? bannerElement->GetIndex() : BannerIndex::GetNull();
+                if (bannerIndex.IsNull())
+                {
+                    continue;
+                }
+
+                auto dstBanner = GetOrCreateBanner(bannerIndex);
+                if (dstBanner == nullptr)
+                {
+                    bannerElement->SetIndex(BannerIndex::GetNull());
+                }
+                else
+                {
+                    ImportBanner(dstBanner, &_s4.banners[bannerIndex.ToUnderlying()]);
+                }
+            }
+        }
+
         size_t ImportTileElement(TileElement* dst, const RCT12TileElement* src)
         {
             const auto rct12type = src->GetType();
@@ -1825,20 +1890,11 @@ namespace RCT1
                     dst2->SetPosition(src2->GetPosition());
                     dst2->SetAllowedEdges(src2->GetAllowedEdges());
 
+                    // The banner itself is imported by ImportTileBanners
                     auto index = src2->GetIndex();
                     if (index < std::size(_s4.banners))
                     {
-                        auto srcBanner = &_s4.banners[index];
-                        auto dstBanner = GetOrCreateBanner(BannerIndex::FromUnderlying(index));
-                        if (dstBanner == nullptr)
-                        {
-                            dst2->SetIndex(BannerIndex::GetNull());
-                        }
-                        else
-                        {
-                            ImportBanner(dstBanner, srcBanner);
-                            dst2->SetIndex(BannerIndex::FromUnderlying(index));
-                        }
+                        dst2->SetIndex(BannerIndex::FromUnderlying(index));
                     }
                     else
                     {
@@ -2123,12 +2179,15 @@ namespace RCT1
 
             auto& park = OpenRCT2::GetContext()->GetGameState()->GetPark();
             park.ResetHistories();
-            std::copy(std::begin(_s4.park_rating_history), std::end(_s4.park_rating_history), gParkRatingHistory);
+            for (size_t i = 0; i < std::size(_s4.park_rating_history); i++)
+            {
+                gParkRatingHistory.Set(i, _s4.park_rating_history[i]);
+            }
             for (size_t i = 0; i < std::size(_s4.guests_in_park_history); i++)
             {
                 if (_s4.guests_in_park_history[i] != RCT12ParkHistoryUndefined)
                 {
-                    gGuestsInParkHistory[i] = _s4.guests_in_park_history[i] * RCT12GuestsInParkHistoryFactor;
+                    gGuestsInParkHistory.Set(i, _s4.guests_in_park_history[i] * RCT12GuestsInParkHistoryFactor);
                 }
             }
 
@@ -2143,12 +2202,12 @@ namespace RCT1
             }
 
             // Number of guests history
-            std::fill(std::begin(gGuestsInParkHistory), std::end(gGuestsInParkHistory), std::numeric_limits<uint32_t>::max());
+            gGuestsInParkHistory.Fill(std::numeric_limits<uint32_t>::max());
             for (size_t i = 0; i < std::size(_s4.guests_in_park_history); i++)
             {
                 if (_s4.guests_in_park_history[i] != std::numeric_limits<uint8_t>::max())
                 {
-                    gGuestsInParkHistory[i] = _s4.guests_in_park_history[i] * 20;
+                    gGuestsInParkHistory.Set(i, _s4.guests_in_park_history[i] * 20);
                 }
             }
 
@@ -2516,6 +2575,7 @@ namespace RCT1
                 const auto merryGoRoundId = static_cast<ride_id_t>(0);
 
                 // First, make the queuing peep exit
+                ride_rebuild_queues();
                 for (auto peep : EntityList<Guest>())
                 {
                     if (peep->State == PeepState::QueuingFront && peep->CurrentRide == merryGoRoundId)
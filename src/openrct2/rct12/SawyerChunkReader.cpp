@@ -10,7 +10,6 @@
 #include "SawyerChunkReader.h"
 
 #include "../core/IStream.hpp"
-#include "../core/Numerics.hpp"
 
 // malloc is very slow for large allocations in MSVC debug builds as it allocates
 // memory on a special debug heap and then initialises all the memory to 0xCC.
@@ -291,14 +290,7 @@ size_t SawyerChunkReader::DecodeChunkRotate(void* dst, size_t dstCapacity, const
         throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
     }
 
-    auto src8 = static_cast<const uint8_t*>(src);
-    auto dst8 = static_cast<uint8_t*>(dst);
-    uint8_t code = 1;
-    for (size_t i = 0; i < srcLength; i++)
-    {
-        dst8[i] = Numerics::ror8(src8[i], code);
-        code = (code + 2) % 8;
-    }
+    sawyercoding_decode_rotate(static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst), srcLength);
     return srcLength;
 }
 
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileImport.h"
+
+#include "../core/JobPool.h"
+#include "../world/Map.h"
+
+#include <algorithm>
+
+// Enough rows for a job to be worth its overhead on the largest legacy maps, which are 256 tiles across.
+static constexpr int32_t ImportRowsPerJob = 16;
+
+TileElementVector RCT12::ImportTiles(
+    const std::function<void(const TileCoordsXY& coords, std::vector<TileElement>& elements)>& importTile)
+{
+    std::vector<std::vector<TileElement>> bands((MAXIMUM_MAP_SIZE_TECHNICAL + ImportRowsPerJob - 1) / ImportRowsPerJob);
+    {
+        JobPool jobPool;
+        for (size_t i = 0; i < bands.size(); i++)
+        {
+            jobPool.AddTask([&importTile, &bands, i]() {
+                auto& elements = bands[i];
+                const auto startY = static_cast<int32_t>(i) * ImportRowsPerJob;
+                const auto endY = std::min(startY + ImportRowsPerJob, MAXIMUM_MAP_SIZE_TECHNICAL);
+                for (TileCoordsXY coords = { 0, startY }; coords.y < endY; coords.y++)
+                {
+                    for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+                    {
+                        importTile(coords, elements);
+                    }
+                }
+            });
+        }
+        jobPool.Join();
+    }
+
+    size_t numElements = 0;
+    for (const auto& band : bands)
+    {
+        numElements += band.size();
+    }
+
+    TileElementVector tileElements;
+    tileElements.reserve(numElements);
+    for (auto& band : bands)
+    {
+        tileElements.insert(tileElements.end(), band.begin(), band.end());
+        band = {};
+    }
+    return tileElements;
+}
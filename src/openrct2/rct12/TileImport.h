@@ -0,0 +1,28 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../world/Location.hpp"
+#include "../world/TileElement.h"
+
+#include <functional>
+#include <vector>
+
+namespace RCT12
+{
+    /**
+     * Converts the tiles of a map on the job pool, a band of rows per job, and joins the bands in tile order.
+     * @param importTile appends the elements of a tile, with at least one element and the last one flagged as such. It
+     *                   runs on several threads at once so it may only read shared state, anything like creating banners
+     *                   has to be done on the returned elements afterwards.
+     */
+    TileElementVector ImportTiles(
+        const std::function<void(const TileCoordsXY& coords, std::vector<TileElement>& elements)>& importTile);
+} // namespace RCT12
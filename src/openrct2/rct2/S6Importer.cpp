@@ -51,6 +51,7 @@
 #include "../rct12/RCT12.h"
 #include "../rct12/SawyerChunkReader.h"
 #include "../rct12/SawyerEncoding.h"
+#include "../rct12/TileImport.h"
 #include "../rct2/RCT2.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -215,6 +216,13 @@ namespace RCT2
             return false;
         }
 
+        bool LoadScenarioDetails(const utf8* path, scenario_index_entry* dst) override
+        {
+            // The scenario repository reads the header and info chunks of S6 files itself
+            *dst = {};
+            return false;
+        }
+
         void Import() override
         {
             Initialise();
@@ -287,12 +295,15 @@ namespace RCT2
 
             auto& park = OpenRCT2::GetContext()->GetGameState()->GetPark();
             park.ResetHistories();
-            std::copy(std::begin(_s6.park_rating_history), std::end(_s6.park_rating_history), gParkRatingHistory);
+            for (size_t i = 0; i < std::size(_s6.park_rating_history); i++)
+            {
+                gParkRatingHistory.Set(i, _s6.park_rating_history[i]);
+            }
             for (size_t i = 0; i < std::size(_s6.guests_in_park_history); i++)
             {
                 if (_s6.guests_in_park_history[i] != RCT12ParkHistoryUndefined)
                 {
-                    gGuestsInParkHistory[i] = _s6.guests_in_park_history[i] * RCT12GuestsInParkHistoryFactor;
+                    gGuestsInParkHistory.Set(i, _s6.guests_in_park_history[i] * RCT12GuestsInParkHistoryFactor);
                 }
             }
 
@@ -343,9 +354,9 @@ namespace RCT2
 
             for (size_t i = 0; i < Limits::FinanceGraphSize; i++)
             {
-                gCashHistory[i] = ToMoney64(_s6.balance_history[i]);
-                gWeeklyProfitHistory[i] = ToMoney64(_s6.weekly_profit_history[i]);
-                gParkValueHistory[i] = ToMoney64(_s6.park_value_history[i]);
+                gCashHistory.Set(i, ToMoney64(_s6.balance_history[i]));
+                gWeeklyProfitHistory.Set(i, ToMoney64(_s6.weekly_profit_history[i]));
+                gParkValueHistory.Set(i, ToMoney64(_s6.park_value_history[i]));
             }
 
             gScenarioCompletedCompanyValue = RCT12CompletedCompanyValueToOpenRCT2(_s6.completed_company_value);
@@ -937,6 +948,7 @@ namespace RCT2
             dst.Proximity = { src.proximity_x, src.proximity_y, src.proximity_z };
             dst.ProximityStart = { src.proximity_start_x, src.proximity_start_y, src.proximity_start_z };
             dst.CurrentRide = RCT12RideIdToOpenRCT2RideId(src.current_ride);
+            dst.RoundRobinRide = dst.CurrentRide;
             dst.State = src.state;
             if (src.current_ride < Limits::MaxRidesInPark && _s6.rides[src.current_ride].type < std::size(RideTypeDescriptors))
                 dst.ProximityTrackType = RCT2TrackTypeToOpenRCT2(
@@ -1008,6 +1020,7 @@ namespace RCT2
                 else
                     gResearchItemsUninvented.emplace_back(researchItem.ToResearchItem());
             }
+            ResearchInvalidateIndex();
         }
 
         void ImportBanner(Banner* dst, const RCT12Banner* src)
@@ -1115,71 +1128,88 @@ namespace RCT2
             auto tilePointerIndex = TilePointerIndex<RCT12TileElement>(
                 Limits::MaxMapSize, _s6.tile_elements, std::size(_s6.tile_elements));
 
-            std::vector<TileElement> tileElements;
-            bool nextElementInvisible = false;
-            bool restOfTileInvisible = false;
             const auto maxSize = std::min(Limits::MaxMapSize, _s6.map_size);
-            for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
-            {
-                for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
-                {
-                    nextElementInvisible = false;
-                    restOfTileInvisible = false;
+            auto tileElements = RCT12::ImportTiles([&](const TileCoordsXY& coords, std::vector<TileElement>& elements) {
+                bool nextElementInvisible = false;
+                bool restOfTileInvisible = false;
 
-                    auto tileAdded = false;
-                    if (coords.x < maxSize && coords.y < maxSize)
+                auto tileAdded = false;
+                if (coords.x < maxSize && coords.y < maxSize)
+                {
+                    const auto* srcElement = tilePointerIndex.GetFirstElementAt(coords);
+                    if (srcElement != nullptr)
                     {
-                        const auto* srcElement = tilePointerIndex.GetFirstElementAt(coords);
-                        if (srcElement != nullptr)
+                        do
                         {
-                            do
+                            if (srcElement->base_height == RCT12::Limits::MaxElementHeight)
                             {
-                                if (srcElement->base_height == RCT12::Limits::MaxElementHeight)
-                                {
-                                    continue;
-                                }
+                                continue;
+                            }
 
-                                auto tileElementType = srcElement->GetType();
-                                if (tileElementType == RCT12TileElementType::Corrupt)
-                                {
-                                    // One property of corrupt elements was to hide tops of tower tracks, and to avoid the next
-                                    // element from being hidden, multiple consecutive corrupt elements were sometimes used.
-                                    // This would essentially toggle the flag, so we inverse nextElementInvisible here instead
-                                    // of always setting it to true.
-                                    nextElementInvisible = !nextElementInvisible;
-                                    continue;
-                                }
-                                if (tileElementType == RCT12TileElementType::EightCarsCorrupt14
-                                    || tileElementType == RCT12TileElementType::EightCarsCorrupt15)
-                                {
-                                    restOfTileInvisible = true;
-                                    continue;
-                                }
+                            auto tileElementType = srcElement->GetType();
+                            if (tileElementType == RCT12TileElementType::Corrupt)
+                            {
+                                // One property of corrupt elements was to hide tops of tower tracks, and to avoid the next
+                                // element from being hidden, multiple consecutive corrupt elements were sometimes used.
+                                // This would essentially toggle the flag, so we inverse nextElementInvisible here instead
+                                // of always setting it to true.
+                                nextElementInvisible = !nextElementInvisible;
+                                continue;
+                            }
+                            if (tileElementType == RCT12TileElementType::EightCarsCorrupt14
+                                || tileElementType == RCT12TileElementType::EightCarsCorrupt15)
+                            {
+                                restOfTileInvisible = true;
+                                continue;
+                            }
 
-                                auto& dstElement = tileElements.emplace_back();
-                                ImportTileElement(&dstElement, srcElement, nextElementInvisible || restOfTileInvisible);
-                                nextElementInvisible = false;
-                                tileAdded = true;
-                            } while (!(srcElement++)->IsLastForTile());
-                        }
+                            auto& dstElement = elements.emplace_back();
+                            ImportTileElement(&dstElement, srcElement, nextElementInvisible || restOfTileInvisible);
+                            nextElementInvisible = false;
+                            tileAdded = true;
+                        } while (!(srcElement++)->IsLastForTile());
                     }
+                }
 
-                    if (!tileAdded)
-                    {
-                        // Add a default surface element, we always need at least one element per tile
-                        auto& dstElement = tileElements.emplace_back();
-                        dstElement.ClearAs(TileElementType::Surface);
-                        dstElement.SetLastForTile(true);
-                    }
+                if (!tileAdded)
+                {
+                    // Add a default surface element, we always need at least one element per tile
+                    auto& dstElement = elements.emplace_back();
+                    dstElement.ClearAs(TileElementType::Surface);
+                    dstElement.SetLastForTile(true);
+                }
 
-                    // Set last element flag in case the original last element was never added
-                    if (tileElements.size() > 0)
-                    {
-                        tileElements.back().SetLastForTile(true);
-                    }
+                // Set last element flag in case the original last element was never added
+                elements.back().SetLastForTile(true);
+            });
+            ImportTileBanners(tileElements);
+            SetTileElements(std::move(tileElements));
+        }
+
+        /**
+         * Creates the banners of the imported tile elements, the tiles are converted on several threads so this can
+         * only be done once they all are.
+         */
+        void ImportTileBanners(TileElementVector& tileElements)
+        {
+            for (auto& element : tileElements)
+            {
+                auto bannerIndex = element.GetBannerIndex();
+                if (bannerIndex.IsNull())
+                {
+                    continue;
+                }
+
+                auto dstBanner = GetOrCreateBanner(bannerIndex);
+                if (dstBanner == nullptr)
+                {
+                    element.SetBannerIndex(BannerIndex::GetNull());
+                }
+                else
+                {
+                    ImportBanner(dstBanner, &_s6.banners[bannerIndex.ToUnderlying()]);
                 }
             }
-            SetTileElements(std::move(tileElements));
         }
 
         void ImportTileElement(TileElement* dst, const RCT12TileElement* src, bool invisible)
@@ -1362,7 +1392,7 @@ namespace RCT2
                     dst2->SetAcrossTrack(src2->IsAcrossTrack());
                     dst2->SetAnimationIsBackwards(src2->AnimationIsBackwards());
 
-                    // Import banner information
+                    // The banner itself is imported by ImportTileBanners
                     dst2->SetBannerIndex(BannerIndex::GetNull());
                     auto entry = dst2->GetEntry();
                     if (entry != nullptr && entry->scrolling_mode != SCROLLING_MODE_NONE)
@@ -1370,17 +1400,7 @@ namespace RCT2
                         auto bannerIndex = src2->GetBannerIndex();
                         if (bannerIndex < std::size(_s6.banners))
                         {
-                            auto srcBanner = &_s6.banners[bannerIndex];
-                            auto dstBanner = GetOrCreateBanner(BannerIndex::FromUnderlying(bannerIndex));
-                            if (dstBanner == nullptr)
-                            {
-                                dst2->SetBannerIndex(BannerIndex::GetNull());
-                            }
-                            else
-                            {
-                                ImportBanner(dstBanner, srcBanner);
-                                dst2->SetBannerIndex(BannerIndex::FromUnderlying(src2->GetBannerIndex()));
-                            }
+                            dst2->SetBannerIndex(BannerIndex::FromUnderlying(bannerIndex));
                         }
                     }
                     break;
@@ -1395,7 +1415,7 @@ namespace RCT2
                     dst2->SetPrimaryColour(src2->GetPrimaryColour());
                     dst2->SetSecondaryColour(src2->GetSecondaryColour());
 
-                    // Import banner information
+                    // The banner itself is imported by ImportTileBanners
                     dst2->SetBannerIndex(BannerIndex::GetNull());
                     auto entry = dst2->GetEntry();
                     if (entry != nullptr && entry->scrolling_mode != SCROLLING_MODE_NONE)
@@ -1403,17 +1423,7 @@ namespace RCT2
                         auto bannerIndex = src2->GetBannerIndex();
                         if (bannerIndex < std::size(_s6.banners))
                         {
-                            auto srcBanner = &_s6.banners[bannerIndex];
-                            auto dstBanner = GetOrCreateBanner(BannerIndex::FromUnderlying(bannerIndex));
-                            if (dstBanner == nullptr)
-                            {
-                                dst2->SetBannerIndex(BannerIndex::GetNull());
-                            }
-                            else
-                            {
-                                ImportBanner(dstBanner, srcBanner);
-                                dst2->SetBannerIndex(BannerIndex::FromUnderlying(src2->GetBannerIndex()));
-                            }
+                            dst2->SetBannerIndex(BannerIndex::FromUnderlying(bannerIndex));
                         }
                     }
                     break;
@@ -1426,20 +1436,11 @@ namespace RCT2
                     dst2->SetPosition(src2->GetPosition());
                     dst2->SetAllowedEdges(src2->GetAllowedEdges());
 
+                    // The banner itself is imported by ImportTileBanners
                     auto bannerIndex = src2->GetIndex();
                     if (bannerIndex < std::size(_s6.banners))
                     {
-                        auto srcBanner = &_s6.banners[bannerIndex];
-                        auto dstBanner = GetOrCreateBanner(BannerIndex::FromUnderlying(bannerIndex));
-                        if (dstBanner == nullptr)
-                        {
-                            dst2->SetIndex(BannerIndex::GetNull());
-                        }
-                        else
-                        {
-                            ImportBanner(dstBanner, srcBanner);
-                            dst2->SetIndex(BannerIndex::FromUnderlying(bannerIndex));
-                        }
+                        dst2->SetIndex(BannerIndex::FromUnderlying(bannerIndex));
                     }
                     else
                     {
@@ -1517,10 +1518,12 @@ namespace RCT2
 
         void ImportEntities()
         {
+            EntityBatchBegin();
             for (int32_t i = 0; i < Limits::MaxEntities; i++)
             {
                 ImportEntity(_s6.sprites[i].unknown);
             }
+            EntityBatchEnd();
         }
 
         template<typename OpenRCT2_T> void ImportEntity(const RCT12SpriteBase& src);
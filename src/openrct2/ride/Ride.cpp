@@ -93,6 +93,21 @@ static constexpr const int32_t RideInspectionInterval[] = {
 
 static std::vector<Ride> _rides;
 
+/**
+ * Maintenance events are phased on the global tick counter rather than per ride, so they fall due for every ride on
+ * the same tick. Which of them are due is decided once per tick by Ride::UpdateAll instead of by each ride.
+ */
+struct RideMaintenanceSchedule
+{
+    bool BreakdownDue;
+    bool DowntimeHistoryDue;
+    bool InspectionDue;
+    // Only rides whose first id byte matches update their breakdown status on this tick.
+    uint8_t BreakdownStatusRideByte;
+};
+
+static RideMaintenanceSchedule _maintenanceSchedule;
+
 // Static function declarations
 Staff* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspection);
 static void ride_breakdown_status_update(Ride* ride);
@@ -102,6 +117,7 @@ static void ride_call_mechanic(Ride* ride, Peep* mechanic, int32_t forInspection
 static void ride_entrance_exit_connected(Ride* ride);
 static int32_t ride_get_new_breakdown_problem(Ride* ride);
 static void ride_inspection_update(Ride* ride);
+static RideMaintenanceSchedule ride_get_maintenance_schedule(uint32_t currentTicks);
 static void ride_mechanic_status_update(Ride* ride, int32_t mechanicStatus);
 static void ride_music_update(Ride* ride);
 static void ride_shop_connected(Ride* ride);
@@ -276,6 +292,13 @@ int32_t Ride::GetMaxQueueTime() const
 
 Guest* Ride::GetQueueHeadGuest(StationIndex stationIndex) const
 {
+    // The cached front is only stale if a guest in the queue was removed without leaving it.
+    auto* head = TryGetEntity<Guest>(stations[stationIndex].FirstPeepInQueue);
+    if (head != nullptr && TryGetEntity<Guest>(head->GuestNextInQueue) == nullptr)
+    {
+        return head;
+    }
+
     Guest* peep;
     Guest* result = nullptr;
     uint16_t spriteIndex = stations[stationIndex].LastPeepInQueue;
@@ -287,17 +310,27 @@ Guest* Ride::GetQueueHeadGuest(StationIndex stationIndex) const
     return result;
 }
 
-void Ride::UpdateQueueLength(StationIndex stationIndex)
+void Ride::QueueAppendGuest(StationIndex stationIndex, Guest* peep)
 {
-    uint16_t count = 0;
-    Guest* peep;
-    uint16_t spriteIndex = stations[stationIndex].LastPeepInQueue;
-    while ((peep = TryGetEntity<Guest>(spriteIndex)) != nullptr)
+    assert(stationIndex < MAX_STATIONS);
+    assert(peep != nullptr);
+
+    auto& station = stations[stationIndex];
+    auto* lastGuest = TryGetEntity<Guest>(station.LastPeepInQueue);
+    if (lastGuest != nullptr)
     {
-        spriteIndex = peep->GuestNextInQueue;
-        count++;
+        lastGuest->GuestPrevInQueue = peep->sprite_index;
     }
-    stations[stationIndex].QueueLength = count;
+    else
+    {
+        station.FirstPeepInQueue = peep->sprite_index;
+        station.QueueLinkedLength = 0;
+    }
+    peep->GuestNextInQueue = station.LastPeepInQueue;
+    peep->GuestPrevInQueue = SPRITE_INDEX_NULL;
+    station.LastPeepInQueue = peep->sprite_index;
+    station.QueueLinkedLength++;
+    station.QueueLength++;
 }
 
 void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep)
@@ -305,21 +338,128 @@ void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep)
     assert(stationIndex < MAX_STATIONS);
     assert(peep != nullptr);
 
+    auto& station = stations[peep->CurrentRideStation];
     peep->GuestNextInQueue = SPRITE_INDEX_NULL;
+    peep->GuestPrevInQueue = SPRITE_INDEX_NULL;
     auto* queueHeadGuest = GetQueueHeadGuest(peep->CurrentRideStation);
     if (queueHeadGuest == nullptr)
     {
-        stations[peep->CurrentRideStation].LastPeepInQueue = peep->sprite_index;
+        station.LastPeepInQueue = peep->sprite_index;
+        station.QueueLinkedLength = 0;
     }
     else
     {
         queueHeadGuest->GuestNextInQueue = peep->sprite_index;
+        peep->GuestPrevInQueue = queueHeadGuest->sprite_index;
+    }
+    station.FirstPeepInQueue = peep->sprite_index;
+    station.QueueLinkedLength++;
+    station.QueueLength = station.QueueLinkedLength;
+}
+
+void Ride::QueueRemoveGuest(StationIndex stationIndex, Guest* peep)
+{
+    auto& station = stations[stationIndex];
+    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
+    // not yet left the queue.
+    if (station.QueueLength > 0)
+    {
+        station.QueueLength--;
+    }
+
+    if (peep->sprite_index == station.LastPeepInQueue)
+    {
+        station.LastPeepInQueue = peep->GuestNextInQueue;
+    }
+    else
+    {
+        // Guests still walking in a queue that has been cleared are no longer linked into it.
+        auto* guestBehind = TryGetEntity<Guest>(peep->GuestPrevInQueue);
+        if (guestBehind == nullptr || guestBehind->GuestNextInQueue != peep->sprite_index)
+        {
+            if (GetEntity<Guest>(station.LastPeepInQueue) == nullptr)
+            {
+                log_error("Invalid Guest Queue list!");
+            }
+            return;
+        }
+        guestBehind->GuestNextInQueue = peep->GuestNextInQueue;
+    }
+
+    auto* guestAhead = TryGetEntity<Guest>(peep->GuestNextInQueue);
+    if (guestAhead != nullptr)
+    {
+        guestAhead->GuestPrevInQueue = peep->GuestPrevInQueue;
+    }
+    if (peep->sprite_index == station.FirstPeepInQueue)
+    {
+        station.FirstPeepInQueue = peep->GuestPrevInQueue;
+    }
+    peep->GuestPrevInQueue = SPRITE_INDEX_NULL;
+    if (station.QueueLinkedLength > 0)
+    {
+        station.QueueLinkedLength--;
+    }
+}
+
+void Ride::QueueClear(StationIndex stationIndex)
+{
+    // Only the derived links are cleared, guests that are still walking in the queue keep the guest they follow.
+    auto& station = stations[stationIndex];
+    Guest* peep;
+    uint16_t count = 0;
+    for (auto spriteIndex = station.LastPeepInQueue;
+         count < MAX_ENTITIES && (peep = TryGetEntity<Guest>(spriteIndex)) != nullptr; spriteIndex = peep->GuestNextInQueue)
+    {
+        peep->GuestPrevInQueue = SPRITE_INDEX_NULL;
+        count++;
+    }
+    station.LastPeepInQueue = SPRITE_INDEX_NULL;
+    station.FirstPeepInQueue = SPRITE_INDEX_NULL;
+    station.QueueLinkedLength = 0;
+    station.QueueLength = 0;
+}
+
+void Ride::RebuildQueues()
+{
+    for (auto& station : stations)
+    {
+        station.FirstPeepInQueue = SPRITE_INDEX_NULL;
+        station.QueueLinkedLength = 0;
+
+        // The length also stops the walk through links that loop in corrupted saves.
+        Guest* peep;
+        uint16_t guestBehind = SPRITE_INDEX_NULL;
+        for (auto spriteIndex = station.LastPeepInQueue;
+             station.QueueLinkedLength < MAX_ENTITIES && (peep = TryGetEntity<Guest>(spriteIndex)) != nullptr;
+             spriteIndex = peep->GuestNextInQueue)
+        {
+            peep->GuestPrevInQueue = guestBehind;
+            guestBehind = peep->sprite_index;
+            station.FirstPeepInQueue = peep->sprite_index;
+            station.QueueLinkedLength++;
+        }
     }
-    UpdateQueueLength(peep->CurrentRideStation);
 }
 
 /**
- *
+ * Rebuilds the links to the front of every queue, which are not saved.
+ */
+void ride_rebuild_queues()
+{
+    for (auto peep : EntityList<Guest>())
+    {
+        peep->GuestPrevInQueue = SPRITE_INDEX_NULL;
+    }
+    for (auto& ride : GetRideManager())
+    {
+        ride.RebuildQueues();
+    }
+}
+
+/**
+ * Recounts the guests who have each ride as their favourite. Guest::SetFavouriteRide keeps the counts up to date,
+ * this is only needed after loading a park.
  *  rct2: 0x006AC916
  */
 void ride_update_favourited_stat()
@@ -947,6 +1087,8 @@ void Ride::UpdateAll()
 
     window_update_viewport_ride_music();
 
+    _maintenanceSchedule = ride_get_maintenance_schedule(gCurrentTicks);
+
     // Update rides
     for (auto& ride : GetRideManager())
         ride.Update();
@@ -1026,20 +1168,18 @@ void Ride::Update()
     else if (type == RIDE_TYPE_SPIRAL_SLIDE)
         UpdateSpiralSlide();
 
-    ride_breakdown_update(this);
+    if (_maintenanceSchedule.BreakdownDue)
+        ride_breakdown_update(this);
 
     // Various things include news messages
-    if (lifecycle_flags & (RIDE_LIFECYCLE_BREAKDOWN_PENDING | RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_DUE_INSPECTION))
+    if ((lifecycle_flags & (RIDE_LIFECYCLE_BREAKDOWN_PENDING | RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_DUE_INSPECTION))
+        && _maintenanceSchedule.BreakdownStatusRideByte == static_cast<uint8_t>(id))
     {
-        // Breakdown updates originally were performed when (id == (gCurrentTicks / 2) & 0xFF)
-        // with the increased MAX_RIDES the update is tied to the first byte of the id this allows
-        // for identical balance with vanilla.
-        const auto updatingRideByte = static_cast<uint8_t>((gCurrentTicks / 2) & 0xFF);
-        if (updatingRideByte == static_cast<uint8_t>(id))
-            ride_breakdown_status_update(this);
+        ride_breakdown_status_update(this);
     }
 
-    ride_inspection_update(this);
+    if (_maintenanceSchedule.InspectionDue)
+        ride_inspection_update(this);
 
     // If ride is simulating but crashed, reset the vehicles
     if (status == RideStatus::Simulating && (lifecycle_flags & RIDE_LIFECYCLE_CRASHED))
@@ -1211,17 +1351,26 @@ static uint8_t _breakdownProblemProbabilities[] = {
     3,  // BREAKDOWN_CONTROL_FAILURE
 };
 
+static RideMaintenanceSchedule ride_get_maintenance_schedule(uint32_t currentTicks)
+{
+    RideMaintenanceSchedule schedule{};
+    const bool isTrackDesigner = (gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) != 0;
+    schedule.BreakdownDue = !isTrackDesigner && !(currentTicks & 255);
+    schedule.DowntimeHistoryDue = schedule.BreakdownDue && !(currentTicks & 8191);
+    schedule.InspectionDue = !isTrackDesigner && !(currentTicks & 2047);
+    // Breakdown updates originally were performed when (id == (gCurrentTicks / 2) & 0xFF)
+    // with the increased MAX_RIDES the update is tied to the first byte of the id this allows
+    // for identical balance with vanilla.
+    schedule.BreakdownStatusRideByte = static_cast<uint8_t>((currentTicks / 2) & 0xFF);
+    return schedule;
+}
+
 /**
  *
  *  rct2: 0x006AC7C2
  */
 static void ride_inspection_update(Ride* ride)
 {
-    if (gCurrentTicks & 2047)
-        return;
-    if (gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER)
-        return;
-
     ride->last_inspection++;
     if (ride->last_inspection == 0)
         ride->last_inspection--;
@@ -1282,16 +1431,10 @@ static int32_t get_age_penalty(Ride* ride)
  */
 static void ride_breakdown_update(Ride* ride)
 {
-    if (gCurrentTicks & 255)
-        return;
-
-    if (gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER)
-        return;
-
     if (ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED))
         ride->downtime_history[0]++;
 
-    if (!(gCurrentTicks & 8191))
+    if (_maintenanceSchedule.DowntimeHistoryDue)
     {
         int32_t totalDowntime = 0;
 
@@ -1688,51 +1831,31 @@ Staff* ride_find_closest_mechanic(Ride* ride, int32_t forInspection)
  */
 Staff* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspection)
 {
-    Staff* closestMechanic = nullptr;
-    uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
-
-    for (auto peep : EntityList<Staff>())
-    {
-        if (!peep->IsMechanic())
-            continue;
+    auto location = entrancePosition.ToTileStart();
+    const bool checkPatrol = map_is_location_in_park(location);
 
+    return StaffIndex::FindClosest(StaffType::Mechanic, entrancePosition, [&](const Staff& peep) {
         if (!forInspection)
         {
-            if (peep->State == PeepState::HeadingToInspection)
+            if (peep.State == PeepState::HeadingToInspection)
             {
-                if (peep->SubState >= 4)
-                    continue;
+                if (peep.SubState >= 4)
+                    return false;
             }
-            else if (peep->State != PeepState::Patrolling)
-                continue;
+            else if (peep.State != PeepState::Patrolling)
+                return false;
 
-            if (!(peep->StaffOrders & STAFF_ORDERS_FIX_RIDES))
-                continue;
+            if (!(peep.StaffOrders & STAFF_ORDERS_FIX_RIDES))
+                return false;
         }
         else
         {
-            if (peep->State != PeepState::Patrolling || !(peep->StaffOrders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
-        }
-
-        auto location = entrancePosition.ToTileStart();
-        if (map_is_location_in_park(location))
-            if (!peep->IsLocationInPatrol(location))
-                continue;
-
-        if (peep->x == LOCATION_NULL)
-            continue;
-
-        // Manhattan distance
-        uint32_t distance = std::abs(peep->x - entrancePosition.x) + std::abs(peep->y - entrancePosition.y);
-        if (distance < closestDistance)
-        {
-            closestDistance = distance;
-            closestMechanic = peep;
+            if (peep.State != PeepState::Patrolling || !(peep.StaffOrders & STAFF_ORDERS_INSPECT_RIDES))
+                return false;
         }
-    }
 
-    return closestMechanic;
+        return !checkPatrol || peep.IsLocationInPatrol(location);
+    });
 }
 
 Staff* ride_get_mechanic(Ride* ride)
@@ -65,6 +65,9 @@ struct RideStation
     uint8_t QueueTime;
     uint16_t QueueLength;
     uint16_t LastPeepInQueue;
+    // Front of the queue and the number of guests linked into it, rebuilt from the saved links after loading.
+    uint16_t FirstPeepInQueue = SPRITE_INDEX_NULL;
+    uint16_t QueueLinkedLength = 0;
 
     static constexpr uint8_t NO_TRAIN = std::numeric_limits<uint8_t>::max();
 
@@ -294,7 +297,6 @@ private:
     void Update();
     void UpdateChairlift();
     void UpdateSpiralSlide();
-    void UpdateQueueLength(StationIndex stationIndex);
     bool CreateVehicles(const CoordsXYE& element, bool isApplying);
     void MoveTrainsToBlockBrakes(TrackElement* firstBlock);
     money64 CalculateIncomePerHour() const;
@@ -345,7 +347,11 @@ public:
     int32_t GetTotalQueueLength() const;
     int32_t GetMaxQueueTime() const;
 
+    void QueueAppendGuest(StationIndex stationIndex, Guest* peep);
     void QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep);
+    void QueueRemoveGuest(StationIndex stationIndex, Guest* peep);
+    void QueueClear(StationIndex stationIndex);
+    void RebuildQueues();
     Guest* GetQueueHeadGuest(StationIndex stationIndex) const;
 
     void SetNameToDefault();
@@ -976,6 +982,7 @@ extern ObjectEntryIndex gLastEntranceStyle;
 
 int32_t ride_get_count();
 void ride_init_all();
+void ride_rebuild_queues();
 void reset_all_ride_build_dates();
 void ride_update_favourited_stat();
 void ride_check_all_reachable();
@@ -74,6 +74,27 @@ extern StationIndex gRideEntranceExitPlaceStationIndex;
 extern RideConstructionState gRideEntranceExitPlacePreviousRideConstructionState;
 extern uint8_t gRideEntranceExitPlaceDirection;
 
+/**
+ * A provisional track piece as passed to place_provisional_track_piece, together with the map revision it was tried
+ * against. Placements that failed are remembered so they are not tried again until something changes.
+ */
+struct ProvisionalTrackPlacement
+{
+    ride_id_t RideIndex{};
+    int32_t TrackType{};
+    int32_t TrackDirection{};
+    int32_t LiftHillAndAlternativeState{};
+    CoordsXYZ TrackPos{};
+    uint32_t MapRevision{};
+
+    bool operator==(const ProvisionalTrackPlacement& other) const
+    {
+        return RideIndex == other.RideIndex && TrackType == other.TrackType && TrackDirection == other.TrackDirection
+            && LiftHillAndAlternativeState == other.LiftHillAndAlternativeState && TrackPos == other.TrackPos
+            && MapRevision == other.MapRevision;
+    }
+};
+
 std::optional<CoordsXYZ> GetTrackElementOriginAndApplyChanges(
     const CoordsXYZD& location, track_type_t type, uint16_t extra_params, TileElement** output_element, uint16_t flags);
 
@@ -12,12 +12,15 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../OpenRCT2.h"
+#include "../core/JobPool.h"
+#include "../core/Profiler.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../scripting/ScriptEngine.h"
 #include "../world/Footpath.h"
 #include "../world/Map.h"
 #include "../world/Surface.h"
+#include "../world/TileElementsView.h"
 #include "Ride.h"
 #include "RideData.h"
 #include "Station.h"
@@ -112,12 +115,54 @@ void ride_ratings_update_ride(const Ride& ride)
     }
 }
 
+/**
+ * Calculates the ratings of all open rides at once rather than one step per tick, for headless tools that
+ * need the ratings of a whole park. The track walk only reads the map so every ride is walked on the job
+ * pool with its own state, calculating the ratings writes to the ride and runs plugin hooks so that part
+ * is done afterwards on the calling thread in ride id order.
+ */
+void ride_ratings_update_all_rides()
+{
+    std::vector<RideRatingUpdateState> states;
+    for (const auto& ride : GetRideManager())
+    {
+        if (ride.status != RideStatus::Closed)
+        {
+            auto& state = states.emplace_back();
+            state.CurrentRide = ride.id;
+            state.State = RIDE_RATINGS_STATE_INITIALISE;
+        }
+    }
+
+    JobPool jobs;
+    for (auto& state : states)
+    {
+        jobs.AddTask([&state]() {
+            while (state.State != RIDE_RATINGS_STATE_CALCULATE && state.State != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+            {
+                ride_ratings_update_state(state);
+            }
+        });
+    }
+    jobs.Join();
+
+    for (auto& state : states)
+    {
+        if (state.State == RIDE_RATINGS_STATE_CALCULATE)
+        {
+            ride_ratings_update_state(state);
+        }
+    }
+}
+
 /**
  *
  *  rct2: 0x006B5A2A
  */
 void ride_ratings_update_all()
 {
+    PROFILE_ZONE(RideRatings);
+
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
@@ -151,13 +196,73 @@ static void ride_ratings_update_state(RideRatingUpdateState& state)
     }
 }
 
+static bool ride_ratings_can_rate(ride_id_t rideIndex)
+{
+    auto ride = get_ride(rideIndex);
+    return ride != nullptr && ride->status != RideStatus::Closed && !(ride->lifecycle_flags & RIDE_LIFECYCLE_FIXED_RATINGS);
+}
+
+/**
+ * Queues a ride to be rated before the round robin continues, used when something changed that affects
+ * the ratings of the ride so they do not lag behind by a full cycle over all rides.
+ */
+void ride_ratings_invalidate(ride_id_t rideIndex)
+{
+    auto& dirtyRides = gRideRatingUpdateState.DirtyRides;
+    if (rideIndex == RIDE_ID_NULL || std::find(dirtyRides.begin(), dirtyRides.end(), rideIndex) != dirtyRides.end())
+        return;
+
+    dirtyRides.push_back(rideIndex);
+}
+
+/**
+ * Queues all rides with track on or next to the given tile, the proximity scores of a ride only take the
+ * neighbouring tiles of its track into account.
+ */
+void ride_ratings_invalidate_near(const CoordsXY& loc)
+{
+    if (loc.IsNull())
+        return;
+
+    for (int32_t y = loc.y - COORDS_XY_STEP; y <= loc.y + COORDS_XY_STEP; y += COORDS_XY_STEP)
+    {
+        for (int32_t x = loc.x - COORDS_XY_STEP; x <= loc.x + COORDS_XY_STEP; x += COORDS_XY_STEP)
+        {
+            const CoordsXY tileLoc{ x, y };
+            if (!map_is_location_valid(tileLoc))
+                continue;
+
+            for (auto* trackElement : TileElementsView<TrackElement>(tileLoc))
+            {
+                if (!trackElement->IsGhost())
+                {
+                    ride_ratings_invalidate(trackElement->GetRideIndex());
+                }
+            }
+        }
+    }
+}
+
 /**
  *
  *  rct2: 0x006B5A5C
  */
 static void ride_ratings_update_state_0(RideRatingUpdateState& state)
 {
-    ride_id_t currentRide = state.CurrentRide;
+    // Rides that changed are rated first, the round robin still visits every ride so values keep up with age.
+    while (!state.DirtyRides.empty())
+    {
+        auto dirtyRide = state.DirtyRides.front();
+        state.DirtyRides.erase(state.DirtyRides.begin());
+        if (ride_ratings_can_rate(dirtyRide))
+        {
+            state.CurrentRide = dirtyRide;
+            state.State = RIDE_RATINGS_STATE_INITIALISE;
+            return;
+        }
+    }
+
+    ride_id_t currentRide = state.RoundRobinRide;
 
     currentRide = static_cast<ride_id_t>(EnumValue(currentRide) + 1);
     if (currentRide >= static_cast<ride_id_t>(MAX_RIDES))
@@ -165,12 +270,12 @@ static void ride_ratings_update_state_0(RideRatingUpdateState& state)
         currentRide = {};
     }
 
-    auto ride = get_ride(currentRide);
-    if (ride != nullptr && ride->status != RideStatus::Closed && !(ride->lifecycle_flags & RIDE_LIFECYCLE_FIXED_RATINGS))
+    if (ride_ratings_can_rate(currentRide))
     {
         state.State = RIDE_RATINGS_STATE_INITIALISE;
     }
     state.CurrentRide = currentRide;
+    state.RoundRobinRide = currentRide;
 }
 
 /**
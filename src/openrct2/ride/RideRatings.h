@@ -13,6 +13,8 @@
 #include "../world/Location.hpp"
 #include "RideTypes.h"
 
+#include <vector>
+
 using ride_rating = fixed16_2dp;
 using track_type_t = uint16_t;
 
@@ -52,12 +54,18 @@ struct RideRatingUpdateState
     uint16_t AmountOfBrakes;
     uint16_t AmountOfReversers;
     uint16_t StationFlags;
+    // Position of the round robin over all rides, rides in DirtyRides are rated before it continues.
+    ride_id_t RoundRobinRide;
+    std::vector<ride_id_t> DirtyRides;
 };
 
 extern RideRatingUpdateState gRideRatingUpdateState;
 
 void ride_ratings_update_ride(const Ride& ride);
 void ride_ratings_update_all();
+void ride_ratings_update_all_rides();
+void ride_ratings_invalidate(ride_id_t rideIndex);
+void ride_ratings_invalidate_near(const CoordsXY& loc);
 
 using ride_ratings_calculation = void (*)(Ride* ride, RideRatingUpdateState& state);
 ride_ratings_calculation ride_ratings_get_calculate_func(uint8_t rideType);
@@ -5698,43 +5698,61 @@ static constexpr const rct_string_id RideConfigurationStringIds[] = {
     STR_EMPTY,                         // 266
 };
 
-namespace OpenRCT2
+static_assert(std::size(TrackSequenceProperties) == TrackElemType::Count);
+static_assert(std::size(RideConfigurationStringIds) == TrackElemType::Count);
+
+static constexpr std::array<TrackElementDescriptor, TrackElemType::Count> CreateTrackElementDescriptors()
 {
-    namespace TrackMetaData
+    std::array<TrackElementDescriptor, TrackElemType::Count> descriptors{};
+    for (size_t i = 0; i < TrackElemType::Count; i++)
+    {
+        auto& desc = descriptors[i];
+        desc.Block = TrackBlocks[i];
+        desc.Coordinates = TrackCoordinates[i];
+        desc.Flags = TrackFlags[i];
+        desc.CurveChain = gTrackCurveChain[i];
+        desc.Definition = TrackDefinitions[i];
+        desc.AlternativeType = AlternativeTrackTypes[i];
+        desc.MirrorElement = TrackElementMirrorMap[i];
+        desc.PieceLength = TrackPieceLengths[i];
+        desc.SpinFunction = TrackTypeToSpinFunction[i];
+        desc.Description = RideConfigurationStringIds[i];
+        desc.Price = TrackPricing[i];
+        desc.HeightMarkerPositions = TrackHeightMarkerPositions[i];
+        for (size_t j = 0; j < MaxSequencesPerPiece; j++)
+        {
+            desc.SequenceProperties[j] = TrackSequenceProperties[i][j];
+            desc.SequenceElementAllowedWallEdges[j] = TrackSequenceElementAllowedWallEdges[i][j];
+        }
+    }
+    return descriptors;
+}
+
+static constexpr auto TrackElementDescriptors = CreateTrackElementDescriptors();
+
+static constexpr bool TrackElementDescriptorsAreValid()
+{
+    for (size_t i = 0; i < TrackElemType::Count; i++)
     {
-        static std::vector<TrackElementDescriptor> _trackElementDescriptors;
-        void Init()
+        const auto& desc = TrackElementDescriptors[i];
+        if (desc.Block == nullptr || desc.MirrorElement >= TrackElemType::Count
+            || (desc.AlternativeType != TrackElemType::None && desc.AlternativeType >= TrackElemType::Count)
+            || desc.SpinFunction > R9_SPIN)
         {
-            _trackElementDescriptors.clear();
-            _trackElementDescriptors.reserve(TrackElemType::Count);
-
-            TrackElementDescriptor desc;
-            for (int i = 0; i < TrackElemType::Count; i++)
-            {
-                desc.Description = RideConfigurationStringIds[i];
-                desc.AlternativeType = AlternativeTrackTypes[i];
-                desc.Block = const_cast<rct_preview_track*>(TrackBlocks[i]);
-                desc.Coordinates = TrackCoordinates[i];
-                desc.CurveChain = gTrackCurveChain[i];
-                desc.Flags = TrackFlags[i];
-                desc.HeightMarkerPositions = TrackHeightMarkerPositions[i];
-                desc.MirrorElement = TrackElementMirrorMap[i];
-                desc.PieceLength = TrackPieceLengths[i];
-                desc.Price = TrackPricing[i];
-                desc.Definition = TrackDefinitions[i];
-                desc.SpinFunction = TrackTypeToSpinFunction[i];
-
-                for (uint8_t j = 0; j < MaxSequencesPerPiece; j++)
-                {
-                    desc.SequenceElementAllowedWallEdges[j] = TrackSequenceElementAllowedWallEdges[i][j];
-                    desc.SequenceProperties[j] = TrackSequenceProperties[i][j];
-                }
-                _trackElementDescriptors.push_back(desc);
-            }
+            return false;
         }
+    }
+    return true;
+}
+static_assert(TrackElementDescriptorsAreValid());
+
+namespace OpenRCT2
+{
+    namespace TrackMetaData
+    {
         const TrackElementDescriptor& GetTrackElementDescriptor(const uint32_t type)
         {
-            return _trackElementDescriptors[type];
+            return TrackElementDescriptors[type];
         }
     } // namespace TrackMetaData
 } // namespace OpenRCT2
@@ -13,6 +13,8 @@
 #include "Track.h"
 #include "TrackPaint.h"
 
+#include <cstddef>
+
 constexpr const uint8_t MaxSequencesPerPiece = 16;
 
 // 0x009968BB, 0x009968BC, 0x009968BD, 0x009968BF, 0x009968C1, 0x009968C3
@@ -72,32 +74,34 @@ constexpr const dodgems_track_size DodgemsTrackSize(track_type_t type)
     return { 0, 0, 0, 0 };
 }
 
-struct TrackElementDescriptor
+/**
+ * All static data of a track element type. The fields read while tracing, building and driving over track come first
+ * so they share the first cache line of the descriptor.
+ */
+struct alignas(64) TrackElementDescriptor
 {
-    rct_string_id Description;
+    const rct_preview_track* Block;
     rct_track_coordinates Coordinates;
-
-    rct_preview_track* Block;
-    uint8_t PieceLength;
+    uint16_t Flags;
     track_curve_chain CurveChain;
+    rct_trackdefinition Definition;
     track_type_t AlternativeType;
-    money32 Price;
     track_type_t MirrorElement;
-    uint32_t HeightMarkerPositions;
-    uint16_t Flags;
-
-    std::array<uint8_t, MaxSequencesPerPiece> SequenceElementAllowedWallEdges;
+    uint8_t PieceLength;
+    uint8_t SpinFunction;
     std::array<uint8_t, MaxSequencesPerPiece> SequenceProperties;
 
-    rct_trackdefinition Definition;
-    uint8_t SpinFunction;
+    rct_string_id Description;
+    money32 Price;
+    uint32_t HeightMarkerPositions;
+    std::array<uint8_t, MaxSequencesPerPiece> SequenceElementAllowedWallEdges;
 };
+static_assert(offsetof(TrackElementDescriptor, SequenceProperties) + MaxSequencesPerPiece <= 64);
 
 namespace OpenRCT2
 {
     namespace TrackMetaData
     {
-        void Init();
         const TrackElementDescriptor& GetTrackElementDescriptor(const uint32_t type);
     } // namespace TrackMetaData
 } // namespace OpenRCT2
@@ -1278,6 +1278,8 @@ static GameActions::Result TrackDesignPlaceAllScenery(
 
     money32 cost = 0;
 
+    // The paths are connected in the second pass, all of them at once.
+    FootpathConnectionBatch connectionBatch;
     for (uint8_t mode = 0; mode <= 1; mode++)
     {
         if (!sceneryList.empty())
@@ -2152,7 +2154,7 @@ static void TrackDesignPreviewClearMap()
     gMapSize = 256;
 
     // Reserve ~8 elements per tile
-    std::vector<TileElement> tileElements;
+    TileElementVector tileElements;
     tileElements.reserve(numTiles * 8);
 
     for (int32_t i = 0; i < numTiles; i++)
@@ -138,30 +138,14 @@ public:
      */
     size_t GetCountForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
-        size_t count = 0;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
+        auto [begin, end] = GetItemsForRideType(rideType);
+        if (entry.empty() && !GetRideTypeDescriptor(rideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY))
         {
-            if (item.RideType != rideType)
-            {
-                continue;
-            }
-
-            bool entryIsNotSeparate = false;
-            if (entry.empty())
-            {
-                const ObjectRepositoryItem* ori = repo.FindObjectLegacy(item.ObjectEntry.c_str());
-
-                if (ori == nullptr || !GetRideTypeDescriptor(rideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY))
-                    entryIsNotSeparate = true;
-            }
-
-            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
-            {
-                count++;
-            }
+            return static_cast<size_t>(end - begin);
         }
+
+        size_t count = 0;
+        ForEachItemForObjectEntry(rideType, entry, [&count](const TrackRepositoryItem&) { count++; });
         return count;
     }
 
@@ -173,33 +157,12 @@ public:
     std::vector<track_design_file_ref> GetItemsForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
         std::vector<track_design_file_ref> refs;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
-        {
-            if (item.RideType != rideType)
-            {
-                continue;
-            }
-
-            bool entryIsNotSeparate = false;
-            if (entry.empty())
-            {
-                const ObjectRepositoryItem* ori = repo.FindObjectLegacy(item.ObjectEntry.c_str());
-
-                if (ori == nullptr || !GetRideTypeDescriptor(rideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY))
-                    entryIsNotSeparate = true;
-            }
-
-            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
-            {
-                track_design_file_ref ref;
-                ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
-                ref.path = String::Duplicate(item.Path);
-                refs.push_back(ref);
-            }
-        }
-
+        ForEachItemForObjectEntry(rideType, entry, [&refs](const TrackRepositoryItem& item) {
+            track_design_file_ref ref;
+            ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
+            ref.path = String::Duplicate(item.Path);
+            refs.push_back(ref);
+        });
         return refs;
     }
 
@@ -278,6 +241,47 @@ public:
     }
 
 private:
+    /**
+     * Items are kept sorted by ride type, so the items of one ride type can be found with a binary search.
+     */
+    std::pair<std::vector<TrackRepositoryItem>::const_iterator, std::vector<TrackRepositoryItem>::const_iterator>
+        GetItemsForRideType(uint8_t rideType) const
+    {
+        struct RideTypeCompare
+        {
+            bool operator()(const TrackRepositoryItem& item, uint8_t type) const
+            {
+                return item.RideType < type;
+            }
+            bool operator()(uint8_t type, const TrackRepositoryItem& item) const
+            {
+                return type < item.RideType;
+            }
+        };
+        return std::equal_range(_items.begin(), _items.end(), rideType, RideTypeCompare());
+    }
+
+    template<typename TFn> void ForEachItemForObjectEntry(uint8_t rideType, const std::string& entry, TFn fn) const
+    {
+        auto [begin, end] = GetItemsForRideType(rideType);
+        const auto& repo = GetContext()->GetObjectRepository();
+        const bool listVehiclesSeparately = GetRideTypeDescriptor(rideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY);
+        for (auto it = begin; it != end; it++)
+        {
+            const auto& item = *it;
+            bool entryIsNotSeparate = false;
+            if (entry.empty())
+            {
+                entryIsNotSeparate = !listVehiclesSeparately || repo.FindObjectLegacy(item.ObjectEntry.c_str()) == nullptr;
+            }
+
+            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
+            {
+                fn(item);
+            }
+        }
+    }
+
     void SortItems()
     {
         std::sort(_items.begin(), _items.end(), [](const TrackRepositoryItem& a, const TrackRepositoryItem& b) -> bool {
@@ -28,6 +28,8 @@
 #include "TrackData.h"
 #include "TrackDesign.h"
 
+#include <array>
+
 using namespace OpenRCT2::TrackMetaData;
 
 /* rct2: 0x007667AC */
@@ -2183,6 +2185,40 @@ void track_paint_util_left_corkscrew_up_supports(paint_session& session, Directi
     }
 }
 
+/**
+ * The paint function of every ride and track type, taken from the getters once so painting a track element is a single
+ * table lookup rather than a switch over the track type.
+ */
+struct TrackPaintFunctionTable
+{
+    std::array<std::array<TRACK_PAINT_FUNCTION, TrackElemType::Count>, RIDE_TYPE_COUNT> Functions{};
+
+    TrackPaintFunctionTable()
+    {
+        for (size_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+        {
+            auto paintFunctionGetter = RideTypeDescriptors[rideType].TrackPaintFunction;
+            if (paintFunctionGetter != nullptr)
+            {
+                for (track_type_t trackType = 0; trackType < TrackElemType::Count; trackType++)
+                {
+                    Functions[rideType][trackType] = paintFunctionGetter(trackType);
+                }
+            }
+        }
+    }
+};
+
+static TRACK_PAINT_FUNCTION GetTrackPaintFunction(ObjectEntryIndex rideType, track_type_t trackType)
+{
+    static const TrackPaintFunctionTable table;
+    if (rideType >= RIDE_TYPE_COUNT || trackType >= TrackElemType::Count)
+    {
+        return nullptr;
+    }
+    return table.Functions[rideType][trackType];
+}
+
 /**
  *
  *  rct2: 0x006C4794
@@ -2263,15 +2299,10 @@ void PaintTrack(paint_session& session, Direction direction, int32_t height, con
             return;
         }
 
-        const auto& rtd = GetRideTypeDescriptor(trackElement.GetRideType());
-        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = rtd.TrackPaintFunction;
-        if (paintFunctionGetter != nullptr)
+        TRACK_PAINT_FUNCTION paintFunction = GetTrackPaintFunction(trackElement.GetRideType(), trackType);
+        if (paintFunction != nullptr)
         {
-            TRACK_PAINT_FUNCTION paintFunction = paintFunctionGetter(trackType);
-            if (paintFunction != nullptr)
-            {
-                paintFunction(session, *ride, trackSequence, direction, height, trackElement);
-            }
+            paintFunction(session, *ride, trackSequence, direction, height, trackElement);
         }
     }
 }
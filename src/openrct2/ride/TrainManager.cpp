@@ -19,9 +19,10 @@ namespace TrainManager
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        uint16_t id;
+        while (Entity == nullptr && (id = cursor.Next()) != SPRITE_INDEX_NULL)
         {
-            Entity = GetEntity<Vehicle>(*iter++);
+            Entity = GetEntity<Vehicle>(id);
             if (Entity != nullptr && !Entity->IsHead())
             {
                 Entity = nullptr;
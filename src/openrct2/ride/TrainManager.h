@@ -7,8 +7,10 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 #pragma once
+#include "../entity/EntityList.h"
+
 #include <cstdint>
-#include <list>
+#include <vector>
 
 struct Vehicle;
 
@@ -18,19 +20,18 @@ namespace TrainManager
     class View
     {
     private:
-        const std::list<uint16_t>* vec;
+        const std::vector<uint16_t>* vec;
 
         class Iterator
         {
         private:
-            std::list<uint16_t>::const_iterator iter;
-            std::list<uint16_t>::const_iterator end;
+            EntityListCursor cursor;
             Vehicle* Entity = nullptr;
 
         public:
-            Iterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
-                : iter(_iter)
-                , end(_end)
+            Iterator() = default;
+            explicit Iterator(const std::vector<uint16_t>& _vec)
+                : cursor(_vec)
             {
                 ++(*this);
             }
@@ -67,11 +68,11 @@ namespace TrainManager
 
         Iterator begin()
         {
-            return Iterator(std::cbegin(*vec), std::cend(*vec));
+            return Iterator(*vec);
         }
         Iterator end()
         {
-            return Iterator(std::cend(*vec), std::cend(*vec));
+            return Iterator();
         }
     };
 } // namespace TrainManager
@@ -18,6 +18,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Memory.hpp"
+#include "../core/Profiler.h"
 #include "../entity/EntityRegistry.h"
 #include "../entity/Particle.h"
 #include "../interface/Viewport.h"
@@ -72,6 +73,8 @@ int32_t _vehicleUnkF64E10;
 uint8_t _vehicleF64E2C;
 Vehicle* _vehicleFrontVehicle;
 CoordsXYZ unk_F64E20;
+// Cars of the train being moved by UpdateTrackMotion, head first.
+static std::vector<Vehicle*> _vehicleTrainCars;
 
 static constexpr const OpenRCT2::Audio::SoundId _screamSet0[] = {
     OpenRCT2::Audio::SoundId::Scream8,
@@ -587,72 +590,29 @@ static void InvokeVehicleCrashHook(const uint16_t vehicleId, const std::string_v
 }
 #endif
 
-static bool vehicle_move_info_valid(
-    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
+static const rct_vehicle_info_list* vehicle_get_move_info_list(
+    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
 {
     uint16_t typeAndDirection = (type << 2) | (direction & 3);
 
-    if (trackSubposition >= VehicleTrackSubposition{ std::size(gTrackVehicleInfo) })
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (trackSubposition)
-    {
-        case VehicleTrackSubposition::Default:
-            size = VehicleTrackSubpositionSizeDefault;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingOut:
-            size = 692;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingBack:
-        case VehicleTrackSubposition::ChairliftEndBullwheel:
-        case VehicleTrackSubposition::ChairliftStartBullwheel:
-            size = 404;
-            break;
-        case VehicleTrackSubposition::GoKartsLeftLane:
-        case VehicleTrackSubposition::GoKartsRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToLeftLane:
-            size = 208;
-            break;
-        case VehicleTrackSubposition::MiniGolfPathA9: // VehicleTrackSubposition::MiniGolfStart9
-        case VehicleTrackSubposition::MiniGolfBallPathA10:
-        case VehicleTrackSubposition::MiniGolfPathB11:
-        case VehicleTrackSubposition::MiniGolfBallPathB12:
-        case VehicleTrackSubposition::MiniGolfPathC13:
-        case VehicleTrackSubposition::MiniGolfBallPathC14:
-            size = 824;
-            break;
-        case VehicleTrackSubposition::ReverserRCFrontBogie:
-        case VehicleTrackSubposition::ReverserRCRearBogie:
-            size = 868;
-            break;
-        default:
-            break;
-    }
-    if (typeAndDirection >= size)
-    {
-        return false;
-    }
-    if (offset >= gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size)
+    const auto subposition = static_cast<uint8_t>(trackSubposition);
+    if (subposition >= std::size(gTrackVehicleInfo) || typeAndDirection >= gTrackVehicleInfoSize[subposition])
     {
-        return false;
+        return nullptr;
     }
-    return true;
+    return gTrackVehicleInfo[subposition][typeAndDirection];
 }
 
 static const rct_vehicle_info* vehicle_get_move_info(
     VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, offset))
+    const auto* list = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (list == nullptr || offset < 0 || offset >= list->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->info[offset];
+    return &list->info[offset];
 }
 
 const rct_vehicle_info* Vehicle::GetMoveInfo() const
@@ -662,13 +622,12 @@ const rct_vehicle_info* Vehicle::GetMoveInfo() const
 
 static uint16_t vehicle_get_move_info_size(VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, 0))
+    const auto* list = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (list == nullptr)
     {
         return 0;
     }
-    return gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size;
+    return list->size;
 }
 
 uint16_t Vehicle::GetTrackProgress() const
@@ -906,39 +865,19 @@ OpenRCT2::Audio::VehicleSoundParams Vehicle::CreateSoundParam(uint16_t priority)
 }
 
 /**
- *
+ * Adds the train to the candidates for a vehicle sound slot if it can be heard from the tracking viewport. Only the
+ * priority is worked out here, the full params are created once the candidates that get a slot are known.
  *  rct2: 0x006BB9FF
  */
-void Vehicle::UpdateSoundParams(std::vector<OpenRCT2::Audio::VehicleSoundParams>& vehicleSoundParamsList) const
+void Vehicle::AddSoundCandidate(std::vector<OpenRCT2::Audio::VehicleSoundParams>& candidates) const
 {
     if (!SoundCanPlay())
         return;
 
-    uint16_t soundPriority = GetSoundPriority();
-    // Find a sound param of lower priority to use
-    auto soundParamIter = std::find_if(
-        vehicleSoundParamsList.begin(), vehicleSoundParamsList.end(),
-        [soundPriority](const auto& param) { return soundPriority > param.priority; });
-
-    if (soundParamIter == std::end(vehicleSoundParamsList))
-    {
-        if (vehicleSoundParamsList.size() < OpenRCT2::Audio::MaxVehicleSounds)
-        {
-            vehicleSoundParamsList.push_back(CreateSoundParam(soundPriority));
-        }
-    }
-    else
-    {
-        if (vehicleSoundParamsList.size() < OpenRCT2::Audio::MaxVehicleSounds)
-        {
-            // Shift all sound params down one if using a free space
-            vehicleSoundParamsList.insert(soundParamIter, CreateSoundParam(soundPriority));
-        }
-        else
-        {
-            *soundParamIter = CreateSoundParam(soundPriority);
-        }
-    }
+    OpenRCT2::Audio::VehicleSoundParams candidate{};
+    candidate.id = sprite_index;
+    candidate.priority = GetSoundPriority();
+    candidates.push_back(candidate);
 }
 
 static void vehicle_sounds_update_window_setup()
@@ -1142,14 +1081,37 @@ void vehicle_sounds_update()
     if (!OpenRCT2::Audio::IsAvailable())
         return;
 
-    std::vector<OpenRCT2::Audio::VehicleSoundParams> vehicleSoundParamsList;
-    vehicleSoundParamsList.reserve(OpenRCT2::Audio::MaxVehicleSounds);
+    // Reused between ticks so the update does not allocate once the park has been running for a while.
+    static std::vector<OpenRCT2::Audio::VehicleSoundParams> vehicleSoundParamsList;
+    vehicleSoundParamsList.clear();
 
     vehicle_sounds_update_window_setup();
 
-    for (auto vehicle : TrainManager::View())
+    if (g_music_tracking_viewport != nullptr)
+    {
+        for (auto vehicle : TrainManager::View())
+        {
+            vehicle->AddSoundCandidate(vehicleSoundParamsList);
+        }
+    }
+
+    // Keep the highest priority candidates, earlier trains win ties. Sounds that are already playing get a priority
+    // boost so the selection does not flip between trains of similar priority every tick.
+    std::stable_sort(
+        vehicleSoundParamsList.begin(), vehicleSoundParamsList.end(),
+        [](const auto& a, const auto& b) { return a.priority > b.priority; });
+    if (vehicleSoundParamsList.size() > OpenRCT2::Audio::MaxVehicleSounds)
+    {
+        vehicleSoundParamsList.resize(OpenRCT2::Audio::MaxVehicleSounds);
+    }
+
+    for (auto& vehicleSoundParams : vehicleSoundParamsList)
     {
-        vehicle->UpdateSoundParams(vehicleSoundParamsList);
+        auto* vehicle = GetEntity<Vehicle>(vehicleSoundParams.id);
+        if (vehicle != nullptr)
+        {
+            vehicleSoundParams = vehicle->CreateSoundParam(vehicleSoundParams.priority);
+        }
     }
 
     // Stop all playing sounds that no longer have priority to play after vehicle_update_sound_params
@@ -1224,12 +1186,20 @@ void vehicle_sounds_update()
  */
 void vehicle_update_all()
 {
+    PROFILE_ZONE(VehicleUpdate);
+
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gEditorStep != EditorStep::RollercoasterDesigner)
         return;
 
+    // Trains update all of their cars and are modified by boarding guests.
+    for (auto vehicle : EntityList<Vehicle>())
+    {
+        EntityChecksumInvalidate(vehicle);
+    }
+
     for (auto vehicle : TrainManager::View())
     {
         vehicle->Update();
@@ -2932,6 +2902,7 @@ static void test_finish(Ride& ride)
 
     totalTime = std::max(totalTime, 1u);
     ride.average_speed = ride.average_speed / totalTime;
+    ride_ratings_invalidate(ride.id);
     window_invalidate_by_number(WC_RIDE, EnumValue(ride.id));
 }
 
@@ -9360,23 +9331,23 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
     CheckAndApplyBlockSectionStopSite();
     UpdateVelocity();
 
-    Vehicle* vehicle = this;
-    if (_vehicleVelocityF64E08 < 0)
+    // Look the cars up once, every pass below walks the same train.
+    auto& cars = _vehicleTrainCars;
+    cars.clear();
+    for (Vehicle* car = this; car != nullptr; car = GetEntity<Vehicle>(car->next_vehicle_on_train))
     {
-        vehicle = vehicle->TrainTail();
+        cars.push_back(car);
     }
+
+    const bool travellingBackwards = _vehicleVelocityF64E08 < 0;
     // This will be the front vehicle even when traveling
     // backwards.
-    _vehicleFrontVehicle = vehicle;
+    _vehicleFrontVehicle = travellingBackwards ? cars.back() : this;
 
-    uint16_t spriteId = vehicle->sprite_index;
-    while (spriteId != SPRITE_INDEX_NULL)
+    const auto numCars = cars.size();
+    for (size_t i = 0; i < numCars; i++)
     {
-        Vehicle* car = GetEntity<Vehicle>(spriteId);
-        if (car == nullptr)
-        {
-            break;
-        }
+        Vehicle* car = cars[travellingBackwards ? numCars - 1 - i : i];
         vehicleEntry = car->Entry();
         if (vehicleEntry == nullptr)
         {
@@ -9466,21 +9437,9 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
                 *outStation = _vehicleStationIndex;
             return _vehicleMotionTrackFlags;
         }
-        if (_vehicleVelocityF64E08 >= 0)
-        {
-            spriteId = car->next_vehicle_on_train;
-        }
-        else
-        {
-            if (car == gCurrentVehicle)
-            {
-                break;
-            }
-            spriteId = car->prev_vehicle_on_ride;
-        }
     }
     // loc_6DC144
-    vehicle = gCurrentVehicle;
+    Vehicle* vehicle = gCurrentVehicle;
 
     vehicleEntry = vehicle->Entry();
     // eax
@@ -9488,16 +9447,14 @@ int32_t Vehicle::UpdateTrackMotion(int32_t* outStation)
     // ebp
     int32_t totalMass = 0;
     // ebx
-    int32_t numVehicles = 0;
+    int32_t numVehicles = static_cast<int32_t>(numCars);
 
-    for (; vehicle != nullptr; vehicle = GetEntity<Vehicle>(vehicle->next_vehicle_on_train))
+    for (const auto* car : cars)
     {
-        numVehicles++;
-        totalMass += vehicle->mass;
-        totalAcceleration += vehicle->acceleration;
+        totalMass += car->mass;
+        totalAcceleration += car->acceleration;
     }
 
-    vehicle = gCurrentVehicle;
     int32_t newAcceleration = (totalAcceleration / numVehicles) * 21;
     if (newAcceleration < 0)
     {
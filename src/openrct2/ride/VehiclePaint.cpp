@@ -19,6 +19,8 @@
 #include "../ride/Vehicle.h"
 #include "Track.h"
 
+#include <array>
+#include <atomic>
 #include <iterator>
 
 // 0x0098E52C:
@@ -960,11 +962,49 @@ static void PaintVehicleRiders(
     }
 }
 
+/**
+ * The image and bound box chosen by vehicle_visual_default for every vehicle. Picking them walks several levels of
+ * pitch and bank functions, yet they only change when one of the inputs packed into the key changes. Columns painted
+ * at the same time always resolve the same selection for a vehicle, so concurrent stores write identical values.
+ */
+struct VehicleSpriteSelection
+{
+    std::atomic<uint64_t> Key;
+    std::atomic<uint64_t> Value;
+};
+static std::array<VehicleSpriteSelection, MAX_ENTITIES> _vehicleSpriteSelections;
+
+// Set by vehicle_visual_default when the selection has to be resolved, vehicle_sprite_paint stores the result in it.
+static thread_local VehicleSpriteSelection* _pendingSpriteSelection;
+static thread_local uint64_t _pendingSpriteSelectionKey;
+
+static uint64_t GetVehicleSpriteSelectionKey(const Vehicle* vehicle, int32_t imageDirection)
+{
+    return (1ULL << 63) | vehicle->Pitch | (vehicle->bank_rotation << 8) | ((imageDirection & 0xFF) << 16)
+        | (static_cast<uint64_t>(vehicle->SwingSprite) << 24) | (static_cast<uint64_t>(vehicle->restraints_position) << 32)
+        | (static_cast<uint64_t>(vehicle->HasUpdateFlag(VEHICLE_UPDATE_FLAG_USE_INVERTED_SPRITES)) << 40)
+        | (static_cast<uint64_t>(vehicle->GetTrackType() & 0xFFFF) << 41);
+}
+
+// The base image of the entry tells apart vehicle entries that reuse the same slot after objects are reloaded.
+static uint64_t PackVehicleSpriteSelection(int32_t ebx, int32_t ecx, const rct_ride_entry_vehicle* vehicleEntry)
+{
+    return static_cast<uint32_t>(ebx) | (static_cast<uint64_t>(ecx & 0xFF) << 32)
+        | (static_cast<uint64_t>(vehicleEntry->base_image_id & 0xFFFFFF) << 40);
+}
+
 // 6D5214
 static void vehicle_sprite_paint(
     paint_session& session, const Vehicle* vehicle, int32_t ebx, int32_t ecx, int32_t z,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
+    if (_pendingSpriteSelection != nullptr)
+    {
+        _pendingSpriteSelection->Value.store(PackVehicleSpriteSelection(ebx, ecx, vehicleEntry), std::memory_order_relaxed);
+        _pendingSpriteSelection->Key.store(_pendingSpriteSelectionKey, std::memory_order_release);
+        _pendingSpriteSelection = nullptr;
+    }
+
     if (vehicleEntry->draw_order >= std::size(VehicleBoundboxes))
     {
         return;
@@ -3167,10 +3207,34 @@ void vehicle_visual_default(
     paint_session& session, int32_t imageDirection, int32_t z, const Vehicle* vehicle,
     const rct_ride_entry_vehicle* vehicleEntry)
 {
-    if (vehicle->Pitch < std::size(vehicle_sprite_funcs))
+    if (vehicle->Pitch >= std::size(vehicle_sprite_funcs))
+    {
+        return;
+    }
+
+    if (vehicle->sprite_index >= _vehicleSpriteSelections.size())
     {
         vehicle_sprite_funcs[vehicle->Pitch](session, vehicle, imageDirection, z, vehicleEntry);
+        return;
     }
+
+    auto& selection = _vehicleSpriteSelections[vehicle->sprite_index];
+    const auto key = GetVehicleSpriteSelectionKey(vehicle, imageDirection);
+    if (selection.Key.load(std::memory_order_acquire) == key)
+    {
+        const auto value = selection.Value.load(std::memory_order_relaxed);
+        if ((value >> 40) == (vehicleEntry->base_image_id & 0xFFFFFF))
+        {
+            vehicle_sprite_paint(
+                session, vehicle, static_cast<int32_t>(value & 0xFFFFFFFF), (value >> 32) & 0xFF, z, vehicleEntry);
+            return;
+        }
+    }
+
+    _pendingSpriteSelection = &selection;
+    _pendingSpriteSelectionKey = key;
+    vehicle_sprite_funcs[vehicle->Pitch](session, vehicle, imageDirection, z, vehicleEntry);
+    _pendingSpriteSelection = nullptr;
 }
 
 void Vehicle::Paint(paint_session& session, int32_t imageDirection) const
@@ -50,3 +50,4 @@ struct rct_vehicle_info_list
 };
 
 extern const rct_vehicle_info_list* const* const gTrackVehicleInfo[EnumValue(VehicleTrackSubposition::Count)];
+extern const uint16_t gTrackVehicleInfoSize[EnumValue(VehicleTrackSubposition::Count)];
@@ -328,7 +328,6 @@ static void scenario_week_update()
     marketing_update();
     peep_problem_warnings_update();
     ride_check_all_reachable();
-    ride_update_favourited_stat();
 
     auto water_type = static_cast<rct_water_type*>(object_entry_get_chunk(ObjectType::Water, 0));
 
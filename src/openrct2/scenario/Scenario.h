@@ -180,6 +180,7 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
+void scenario_wait_for_autosave();
 void scenario_failure();
 void scenario_success();
 void scenario_success_submit_name(const char* name);
@@ -176,12 +176,8 @@ private:
     {
         if (String::Equals(Path::GetExtension(path), ".sea", true))
         {
-            auto data = DecryptSea(u8path(path));
-            auto ms = std::make_unique<MemoryStream>();
-            // Need to copy the data into MemoryStream as the overload will borrow instead of copy.
-            ms->Write(data.data(), data.size());
-            ms->SetPosition(0);
-            return ms;
+            // The stream takes over the decrypted data, borrowing it would leave the stream dangling.
+            return std::make_unique<MemoryStream>(DecryptSea(u8path(path)));
         }
 
         auto fs = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
@@ -205,8 +201,7 @@ private:
                 {
                     auto& objRepository = OpenRCT2::GetContext()->GetObjectRepository();
                     auto importer = ParkImporter::CreateParkFile(objRepository);
-                    importer->LoadScenario(path.c_str(), true);
-                    if (importer->GetDetails(entry))
+                    if (importer->LoadScenarioDetails(path.c_str(), entry))
                     {
                         String::Set(entry->path, sizeof(entry->path), path.c_str());
                         entry->timestamp = timestamp;
@@ -226,8 +221,7 @@ private:
                 try
                 {
                     auto s4Importer = ParkImporter::CreateS4();
-                    s4Importer->LoadScenario(path.c_str(), true);
-                    if (s4Importer->GetDetails(entry))
+                    if (s4Importer->LoadScenarioDetails(path.c_str(), entry))
                     {
                         String::Set(entry->path, sizeof(entry->path), path.c_str());
                         entry->timestamp = timestamp;
@@ -39,6 +39,11 @@ HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
     return (result != HooksLookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
 }
 
+std::string_view OpenRCT2::Scripting::GetHookName(HOOK_TYPE type)
+{
+    return HooksLookupTable[type];
+}
+
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
     : _scriptEngine(scriptEngine)
 {
@@ -49,11 +54,12 @@ HookEngine::HookEngine(ScriptEngine& scriptEngine)
     }
 }
 
-uint32_t HookEngine::Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function)
+uint32_t HookEngine::Subscribe(
+    HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function, std::vector<std::string> actionFilter)
 {
     auto& hookList = GetHookList(type);
     auto cookie = _nextCookie++;
-    hookList.Hooks.emplace_back(cookie, owner, function);
+    hookList.Hooks.emplace_back(cookie, owner, function, std::move(actionFilter));
     return cookie;
 }
 
@@ -96,12 +102,18 @@ bool HookEngine::HasSubscriptions(HOOK_TYPE type) const
     return !hookList.Hooks.empty();
 }
 
+bool HookEngine::HasSubscriptions(HOOK_TYPE type, std::string_view action) const
+{
+    const auto& hooks = GetHookList(type).Hooks;
+    return std::any_of(hooks.begin(), hooks.end(), [action](const Hook& hook) { return hook.IsCalledForAction(action); });
+}
+
 void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 {
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        CallHook(type, hook, {}, isGameStateMutable);
     }
 }
 
@@ -110,7 +122,19 @@ void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutab
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        CallHook(type, hook, { arg }, isGameStateMutable);
+    }
+}
+
+void HookEngine::Call(HOOK_TYPE type, std::string_view action, const DukValue& arg, bool isGameStateMutable)
+{
+    auto& hookList = GetHookList(type);
+    for (auto& hook : hookList.Hooks)
+    {
+        if (hook.IsCalledForAction(action))
+        {
+            CallHook(type, hook, { arg }, isGameStateMutable);
+        }
     }
 }
 
@@ -145,10 +169,30 @@ void HookEngine::Call(
 
         std::vector<DukValue> dukArgs;
         dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+        CallHook(type, hook, dukArgs, isGameStateMutable);
     }
 }
 
+void HookEngine::CallHook(HOOK_TYPE type, const Hook& hook, const std::vector<DukValue>& args, bool isGameStateMutable)
+{
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, args, isGameStateMutable);
+
+    auto& timings = _hookTimings[static_cast<size_t>(type)];
+    timings.Total += std::chrono::high_resolution_clock::now() - startTime;
+    timings.Calls++;
+}
+
+const HookTimings& HookEngine::GetTimings(HOOK_TYPE type) const
+{
+    return _hookTimings[static_cast<size_t>(type)];
+}
+
+void HookEngine::ResetTimings()
+{
+    _hookTimings.fill({});
+}
+
 HookList& HookEngine::GetHookList(HOOK_TYPE type)
 {
     auto index = static_cast<size_t>(type);
@@ -14,9 +14,13 @@
 #    include "../common.h"
 #    include "Duktape.hpp"
 
+#    include <algorithm>
 #    include <any>
+#    include <array>
+#    include <chrono>
 #    include <memory>
 #    include <string>
+#    include <string_view>
 #    include <tuple>
 #    include <vector>
 
@@ -45,20 +49,35 @@ namespace OpenRCT2::Scripting
     };
     constexpr size_t NUM_HOOK_TYPES = static_cast<size_t>(HOOK_TYPE::COUNT);
     HOOK_TYPE GetHookType(const std::string& name);
+    std::string_view GetHookName(HOOK_TYPE type);
 
     struct Hook
     {
         uint32_t Cookie;
         std::shared_ptr<Plugin> Owner;
         DukValue Function;
+        // Names of the actions the hook is called for, empty to be called for all of them.
+        std::vector<std::string> ActionFilter;
 
         Hook() = default;
-        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function)
+        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function, std::vector<std::string>&& actionFilter)
             : Cookie(cookie)
             , Owner(owner)
             , Function(function)
+            , ActionFilter(std::move(actionFilter))
         {
         }
+
+        bool IsCalledForAction(std::string_view action) const
+        {
+            return ActionFilter.empty() || std::find(ActionFilter.begin(), ActionFilter.end(), action) != ActionFilter.end();
+        }
+    };
+
+    struct HookTimings
+    {
+        std::chrono::duration<double> Total{};
+        uint64_t Calls{};
     };
 
     struct HookList
@@ -76,22 +95,31 @@ namespace OpenRCT2::Scripting
     private:
         ScriptEngine& _scriptEngine;
         std::vector<HookList> _hookMap;
+        std::array<HookTimings, NUM_HOOK_TYPES> _hookTimings{};
         uint32_t _nextCookie = 1;
 
     public:
         HookEngine(ScriptEngine& scriptEngine);
         HookEngine(const HookEngine&) = delete;
-        uint32_t Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function);
+        uint32_t Subscribe(
+            HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function,
+            std::vector<std::string> actionFilter = {});
         void Unsubscribe(HOOK_TYPE type, uint32_t cookie);
         void UnsubscribeAll(std::shared_ptr<const Plugin> owner);
         void UnsubscribeAll();
         bool HasSubscriptions(HOOK_TYPE type) const;
+        bool HasSubscriptions(HOOK_TYPE type, std::string_view action) const;
         void Call(HOOK_TYPE type, bool isGameStateMutable);
         void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
+        void Call(HOOK_TYPE type, std::string_view action, const DukValue& arg, bool isGameStateMutable);
         void Call(
             HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
 
+        const HookTimings& GetTimings(HOOK_TYPE type) const;
+        void ResetTimings();
+
     private:
+        void CallHook(HOOK_TYPE type, const Hook& hook, const std::vector<DukValue>& args, bool isGameStateMutable);
         HookList& GetHookList(HOOK_TYPE type);
         const HookList& GetHookList(HOOK_TYPE type) const;
     };
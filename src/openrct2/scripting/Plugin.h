@@ -13,6 +13,8 @@
 
 #    include "Duktape.hpp"
 
+#    include <chrono>
+#    include <cstdint>
 #    include <memory>
 #    include <string>
 #    include <string_view>
@@ -46,6 +48,20 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    /**
+     * Time spent running the callbacks of a plugin, excluding callbacks of other plugins they triggered.
+     */
+    struct PluginTimings
+    {
+        std::chrono::duration<double> Total{};
+        uint64_t Calls{};
+        // Time spent since the start of the current script engine tick, compared against the interval budget.
+        std::chrono::duration<double> CurrentTick{};
+        std::chrono::duration<double> MaxTick{};
+        uint64_t DeferredIntervals{};
+        bool OverBudget{};
+    };
+
     class Plugin
     {
     private:
@@ -54,6 +70,7 @@ namespace OpenRCT2::Scripting
         PluginMetadata _metadata{};
         std::string _code;
         bool _hasStarted{};
+        PluginTimings _timings{};
 
     public:
         std::string GetPath() const
@@ -81,6 +98,11 @@ namespace OpenRCT2::Scripting
             return _hasStarted;
         }
 
+        PluginTimings& GetTimings()
+        {
+            return _timings;
+        }
+
         int32_t GetTargetAPIVersion() const;
 
         Plugin() = default;
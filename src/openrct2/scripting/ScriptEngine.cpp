@@ -20,6 +20,7 @@
 #    include "../core/EnumMap.hpp"
 #    include "../core/File.h"
 #    include "../core/FileScanner.h"
+#    include "../core/MemoryAccounting.h"
 #    include "../core/Path.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform2.h"
@@ -34,6 +35,7 @@
 #    include "bindings/game/ScConsole.hpp"
 #    include "bindings/game/ScContext.hpp"
 #    include "bindings/game/ScDisposable.hpp"
+#    include "bindings/game/ScWorker.hpp"
 #    include "bindings/network/ScNetwork.hpp"
 #    include "bindings/network/ScPlayer.hpp"
 #    include "bindings/network/ScPlayerGroup.hpp"
@@ -50,6 +52,13 @@
 #    include "bindings/world/ScTile.hpp"
 #    include "bindings/world/ScTileElement.hpp"
 
+#    include <algorithm>
+#    include <array>
+#    include <atomic>
+#    include <chrono>
+#    include <cstddef>
+#    include <cstdlib>
+#    include <cstring>
 #    include <iostream>
 #    include <stdexcept>
 
@@ -362,9 +371,181 @@ public:
     }
 };
 
+// Every heap allocation is prefixed with its size so the heap usage can be reported to the memory accounting.
+static constexpr size_t DukAllocationHeaderSize = alignof(std::max_align_t);
+static std::atomic<size_t> _dukHeapSize;
+static MemoryAccounting::Registration _dukHeapMemory("scriptHeap", [] { return _dukHeapSize.load(); });
+
+/**
+ * Small allocations, which make up most of the duktape heap (strings, objects, property tables), are served from
+ * free lists per size class so hooks building many short lived values do not go through the system allocator.
+ * Blocks are carved from chunks that are kept for the lifetime of the game. Only used by the plugin heap, which
+ * is only accessed from the game thread.
+ */
+class DukHeapPool
+{
+public:
+    static constexpr size_t Granularity = alignof(std::max_align_t);
+    static constexpr size_t MaxPooledSize = 256;
+
+private:
+    static constexpr size_t NumSizeClasses = MaxPooledSize / Granularity;
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    std::array<FreeBlock*, NumSizeClasses> _freeLists{};
+    std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+    uint8_t* _chunkPosition{};
+    uint8_t* _chunkEnd{};
+    std::atomic<size_t> _freeBytes{};
+
+public:
+    static bool IsPooled(size_t size)
+    {
+        return size != 0 && size <= MaxPooledSize;
+    }
+
+    static size_t GetClassSize(size_t size)
+    {
+        return (size + Granularity - 1) & ~(Granularity - 1);
+    }
+
+    uint8_t* Allocate(size_t size)
+    {
+        const auto classSize = GetClassSize(size);
+        auto& freeList = _freeLists[(classSize / Granularity) - 1];
+        if (freeList != nullptr)
+        {
+            auto* block = freeList;
+            freeList = block->Next;
+            _freeBytes -= DukAllocationHeaderSize + classSize;
+            return reinterpret_cast<uint8_t*>(block);
+        }
+
+        const auto blockSize = DukAllocationHeaderSize + classSize;
+        if (static_cast<size_t>(_chunkEnd - _chunkPosition) < blockSize)
+        {
+            // The tail of the previous chunk is too small for this class, it is left unused.
+            _chunks.push_back(std::make_unique<uint8_t[]>(ChunkSize));
+            _chunkPosition = _chunks.back().get();
+            _chunkEnd = _chunkPosition + ChunkSize;
+        }
+        auto* block = _chunkPosition;
+        _chunkPosition += blockSize;
+        return block;
+    }
+
+    void Free(uint8_t* block, size_t size)
+    {
+        const auto classSize = GetClassSize(size);
+        auto& freeList = _freeLists[(classSize / Granularity) - 1];
+        auto* freeBlock = reinterpret_cast<FreeBlock*>(block);
+        freeBlock->Next = freeList;
+        freeList = freeBlock;
+        _freeBytes += DukAllocationHeaderSize + classSize;
+    }
+
+    size_t GetFreeBytes() const
+    {
+        return _freeBytes;
+    }
+};
+
+static DukHeapPool _dukHeapPool;
+static MemoryAccounting::Registration _dukHeapPoolMemory("scriptHeapPoolFree", [] { return _dukHeapPool.GetFreeBytes(); });
+
+static void* DukAlloc(void*, duk_size_t size)
+{
+    uint8_t* block;
+    if (DukHeapPool::IsPooled(size))
+    {
+        block = _dukHeapPool.Allocate(size);
+    }
+    else
+    {
+        block = static_cast<uint8_t*>(std::malloc(DukAllocationHeaderSize + size));
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    _dukHeapSize += size;
+    return block + DukAllocationHeaderSize;
+}
+
+static void DukFree(void*, void* ptr)
+{
+    if (ptr != nullptr)
+    {
+        auto* block = static_cast<uint8_t*>(ptr) - DukAllocationHeaderSize;
+        const auto size = *reinterpret_cast<size_t*>(block);
+        _dukHeapSize -= size;
+        if (DukHeapPool::IsPooled(size))
+        {
+            _dukHeapPool.Free(block, size);
+        }
+        else
+        {
+            std::free(block);
+        }
+    }
+}
+
+static void* DukRealloc(void* udata, void* ptr, duk_size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return DukAlloc(udata, size);
+    }
+    if (size == 0)
+    {
+        DukFree(udata, ptr);
+        return nullptr;
+    }
+
+    auto* block = static_cast<uint8_t*>(ptr) - DukAllocationHeaderSize;
+    const auto oldSize = *reinterpret_cast<size_t*>(block);
+    if (DukHeapPool::IsPooled(oldSize) || DukHeapPool::IsPooled(size))
+    {
+        if (DukHeapPool::IsPooled(oldSize) && DukHeapPool::IsPooled(size)
+            && DukHeapPool::GetClassSize(oldSize) == DukHeapPool::GetClassSize(size))
+        {
+            // Still fits the same size class
+            *reinterpret_cast<size_t*>(block) = size;
+            _dukHeapSize += size;
+            _dukHeapSize -= oldSize;
+            return ptr;
+        }
+
+        auto* newPtr = DukAlloc(udata, size);
+        if (newPtr == nullptr)
+        {
+            return nullptr;
+        }
+        std::memcpy(newPtr, ptr, std::min<size_t>(oldSize, size));
+        DukFree(udata, ptr);
+        return newPtr;
+    }
+
+    auto* newBlock = static_cast<uint8_t*>(std::realloc(block, DukAllocationHeaderSize + size));
+    if (newBlock == nullptr)
+    {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(newBlock) = size;
+    _dukHeapSize += size;
+    _dukHeapSize -= oldSize;
+    return newBlock + DukAllocationHeaderSize;
+}
+
 DukContext::DukContext()
 {
-    _context = duk_create_heap_default();
+    _context = duk_create_heap(DukAlloc, DukRealloc, DukFree, nullptr, nullptr);
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
@@ -420,6 +601,7 @@ void ScriptEngine::Initialise()
     ScScenario::Register(ctx);
     ScScenarioObjective::Register(ctx);
     ScStaff::Register(ctx);
+    ScWorker::Register(ctx);
 
     dukglue_register_global(ctx, std::make_shared<ScCheats>(), "cheats");
     dukglue_register_global(ctx, std::make_shared<ScClimate>(), "climate");
@@ -509,6 +691,8 @@ void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
         RemoveCustomGameActions(plugin);
         RemoveIntervals(plugin);
         RemoveSockets(plugin);
+        RemoveWorkers(plugin);
+        RemovePendingCaptures(plugin);
         _hookEngine.UnsubscribeAll(plugin);
         for (const auto& callback : _pluginStoppedSubscriptions)
         {
@@ -539,10 +723,6 @@ void ScriptEngine::SetupHotReloading()
     {
         auto base = _env.GetDirectoryPath(DIRBASE::USER, DIRID::PLUGIN);
         _pluginFileWatcher = std::make_unique<FileWatcher>(base);
-        _pluginFileWatcher->OnFileChanged = [this](const std::string& path) {
-            std::lock_guard<std::mutex> guard(_changedPluginFilesMutex);
-            _changedPluginFiles.emplace(path);
-        };
     }
     catch (const std::exception& e)
     {
@@ -552,33 +732,32 @@ void ScriptEngine::SetupHotReloading()
 
 void ScriptEngine::AutoReloadPlugins()
 {
-    if (_changedPluginFiles.size() > 0)
+    if (_pluginFileWatcher == nullptr)
+        return;
+
+    // Only the plugins whose file changed are reloaded, the others keep running undisturbed.
+    for (const auto& path : _pluginFileWatcher->GetChangedFiles())
     {
-        std::lock_guard<std::mutex> guard(_changedPluginFilesMutex);
-        for (auto& path : _changedPluginFiles)
+        auto findResult = std::find_if(_plugins.begin(), _plugins.end(), [&path](const std::shared_ptr<Plugin>& plugin) {
+            return Path::Equals(path, plugin->GetPath());
+        });
+        if (findResult != _plugins.end())
         {
-            auto findResult = std::find_if(_plugins.begin(), _plugins.end(), [&path](const std::shared_ptr<Plugin>& plugin) {
-                return Path::Equals(path, plugin->GetPath());
-            });
-            if (findResult != _plugins.end())
+            auto& plugin = *findResult;
+            try
             {
-                auto& plugin = *findResult;
-                try
-                {
-                    StopPlugin(plugin);
+                StopPlugin(plugin);
 
-                    ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-                    plugin->Load();
-                    LogPluginInfo(plugin, "Reloaded");
-                    plugin->Start();
-                }
-                catch (const std::exception& e)
-                {
-                    _console.WriteLineError(e.what());
-                }
+                ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
+                plugin->Load();
+                LogPluginInfo(plugin, "Reloaded");
+                plugin->Start();
+            }
+            catch (const std::exception& e)
+            {
+                _console.WriteLineError(e.what());
             }
         }
-        _changedPluginFiles.clear();
     }
 }
 
@@ -672,7 +851,10 @@ void ScriptEngine::Tick()
 
     UpdateIntervals();
     UpdateSockets();
+    UpdateWorkers();
+    UpdatePendingCaptures();
     ProcessREPL();
+    EndTimingsTick();
 }
 
 void ScriptEngine::ProcessREPL()
@@ -729,7 +911,22 @@ DukValue ScriptEngine::ExecutePluginCall(
         {
             arg.push();
         }
+
+        const auto outerNestedCallTime = _nestedCallTime;
+        _nestedCallTime = {};
+        const auto startTime = std::chrono::high_resolution_clock::now();
         auto result = duk_pcall_method(_context, static_cast<duk_idx_t>(args.size()));
+        const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+        if (plugin != nullptr)
+        {
+            auto& timings = plugin->GetTimings();
+            const auto selfTime = elapsed - _nestedCallTime;
+            timings.Total += selfTime;
+            timings.CurrentTick += selfTime;
+            timings.Calls++;
+        }
+        _nestedCallTime = outerNestedCallTime + elapsed;
+
         if (result == DUK_EXEC_SUCCESS)
         {
             return DukValue::take_from_stack(_context);
@@ -755,6 +952,30 @@ void ScriptEngine::LogPluginInfo(const std::shared_ptr<Plugin>& plugin, std::str
     }
 }
 
+void ScriptEngine::ResetTimings()
+{
+    for (auto& plugin : _plugins)
+    {
+        plugin->GetTimings() = {};
+    }
+    _hookEngine.ResetTimings();
+}
+
+void ScriptEngine::EndTimingsTick()
+{
+    const auto budget = std::chrono::duration<double, std::milli>(gConfigPlugin.interval_time_budget);
+    for (auto& plugin : _plugins)
+    {
+        auto& timings = plugin->GetTimings();
+        timings.MaxTick = std::max(timings.MaxTick, timings.CurrentTick);
+        if (timings.OverBudget && timings.CurrentTick < budget)
+        {
+            timings.OverBudget = false;
+        }
+        timings.CurrentTick = {};
+    }
+}
+
 void ScriptEngine::AddNetworkPlugin(std::string_view code)
 {
     auto plugin = std::make_shared<Plugin>(_context, std::string());
@@ -770,10 +991,7 @@ GameActions::Result ScriptEngine::QueryOrExecuteCustomGameAction(std::string_vie
     {
         const auto& customAction = kvp->second;
 
-        // Deserialise the JSON args
-        std::string argsz(args);
-
-        auto dukArgs = DuktapeTryParseJson(_context, argsz);
+        auto dukArgs = DecodeCustomActionArgs(args);
         if (!dukArgs)
         {
             auto action = GameActions::Result();
@@ -801,6 +1019,41 @@ GameActions::Result ScriptEngine::QueryOrExecuteCustomGameAction(std::string_vie
     return action;
 }
 
+std::optional<DukValue> ScriptEngine::DecodeCustomActionArgs(std::string_view json)
+{
+#    if DUK_VERSION >= 20500L
+    auto it = _customActionArgsCache.find(std::string(json));
+    if (it != _customActionArgsCache.end())
+    {
+        const auto& cbor = it->second;
+        auto buffer = duk_push_fixed_buffer(_context, cbor.size());
+        std::memcpy(buffer, cbor.data(), cbor.size());
+        duk_cbor_decode(_context, -1, 0);
+        return DukValue::take_from_stack(_context);
+    }
+#    endif
+
+    auto dukArgs = DuktapeTryParseJson(_context, json);
+#    if DUK_VERSION >= 20500L
+    if (dukArgs)
+    {
+        constexpr size_t MaxCachedCustomActionArgs = 256;
+        if (_customActionArgsCache.size() >= MaxCachedCustomActionArgs)
+        {
+            _customActionArgsCache.clear();
+        }
+
+        dukArgs->push();
+        duk_cbor_encode(_context, -1, 0);
+        duk_size_t size{};
+        auto data = static_cast<const uint8_t*>(duk_get_buffer_data(_context, -1, &size));
+        _customActionArgsCache.emplace(std::string(json), std::vector<uint8_t>(data, data + size));
+        duk_pop(_context);
+    }
+#    endif
+    return dukArgs;
+}
+
 GameActions::Result ScriptEngine::DukToGameActionResult(const DukValue& d)
 {
     auto result = GameActions::Result();
@@ -1078,12 +1331,12 @@ const static EnumMap<GameCommand> ActionNameToType = {
 };
 // clang-format on
 
-static std::string GetActionName(GameCommand commandId)
+static std::string_view GetActionName(GameCommand commandId)
 {
     auto it = ActionNameToType.find(commandId);
     if (it != ActionNameToType.end())
     {
-        return std::string{ it->first };
+        return it->first;
     }
     return {};
 }
@@ -1103,17 +1356,35 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, GameActions::Res
     DukStackFrame frame(_context);
 
     auto hookType = isExecute ? HOOK_TYPE::ACTION_EXECUTE : HOOK_TYPE::ACTION_QUERY;
-    if (_hookEngine.HasSubscriptions(hookType))
+    if (!_hookEngine.HasSubscriptions(hookType))
+    {
+        return;
+    }
+
+    // Check the action filters of the subscribers before building any of the event arguments.
+    auto actionId = action.GetType();
+    std::string customActionId;
+    std::string_view actionName;
+    if (actionId == GameCommand::Custom)
+    {
+        customActionId = static_cast<const CustomAction&>(action).GetId();
+        actionName = customActionId;
+    }
+    else
+    {
+        actionName = GetActionName(actionId);
+    }
+
+    if (_hookEngine.HasSubscriptions(hookType, actionName))
     {
         DukObject obj(_context);
 
-        auto actionId = action.GetType();
-        if (action.GetType() == GameCommand::Custom)
+        if (actionId == GameCommand::Custom)
         {
-            auto customAction = static_cast<const CustomAction&>(action);
-            obj.Set("action", customAction.GetId());
+            const auto& customAction = static_cast<const CustomAction&>(action);
+            obj.Set("action", actionName);
 
-            auto dukArgs = DuktapeTryParseJson(_context, customAction.GetJson());
+            auto dukArgs = DecodeCustomActionArgs(customAction.GetJson());
             if (dukArgs)
             {
                 obj.Set("args", *dukArgs);
@@ -1126,7 +1397,6 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, GameActions::Res
         }
         else
         {
-            auto actionName = GetActionName(actionId);
             if (!actionName.empty())
             {
                 obj.Set("action", actionName);
@@ -1148,7 +1418,7 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, GameActions::Res
         obj.Set("result", GameActionResultToDuk(action, result));
         auto dukEventArgs = obj.Take();
 
-        _hookEngine.Call(hookType, dukEventArgs, false);
+        _hookEngine.Call(hookType, actionName, dukEventArgs, false);
 
         if (!isExecute)
         {
@@ -1288,6 +1558,35 @@ void ScriptEngine::RemoveInterval(const std::shared_ptr<Plugin>& plugin, Interva
     }
 }
 
+/**
+ * Intervals can not modify the game state, so deferring them to a later tick once their plugin used up its time
+ * budget does not affect network play.
+ */
+bool ScriptEngine::IsOverIntervalBudget(const std::shared_ptr<Plugin>& plugin)
+{
+    if (plugin == nullptr || gConfigPlugin.interval_time_budget <= 0)
+    {
+        return false;
+    }
+
+    auto& timings = plugin->GetTimings();
+    const auto budget = std::chrono::duration<double, std::milli>(gConfigPlugin.interval_time_budget);
+    if (timings.CurrentTick < budget)
+    {
+        return false;
+    }
+
+    if (!timings.OverBudget)
+    {
+        timings.OverBudget = true;
+        log_warning(
+            "Plugin '%s' exceeded its time budget of %d ms, deferring its intervals.", plugin->GetMetadata().Name.c_str(),
+            gConfigPlugin.interval_time_budget);
+    }
+    timings.DeferredIntervals++;
+    return true;
+}
+
 void ScriptEngine::UpdateIntervals()
 {
     uint32_t timestamp = platform_get_ticks();
@@ -1311,6 +1610,11 @@ void ScriptEngine::UpdateIntervals()
         {
             if (timestamp >= interval.LastTimestamp + interval.Delay)
             {
+                if (IsOverIntervalBudget(interval.Owner))
+                {
+                    continue;
+                }
+
                 ExecutePluginCall(interval.Owner, interval.Callback, {}, false);
 
                 interval.LastTimestamp = timestamp;
@@ -1382,6 +1686,96 @@ void ScriptEngine::RemoveSockets(const std::shared_ptr<Plugin>& plugin)
 #    endif
 }
 
+void ScriptEngine::AddWorker(const std::shared_ptr<ScWorker>& worker)
+{
+    _workers.push_back(worker);
+}
+
+void ScriptEngine::UpdateWorkers()
+{
+    // Update calls can add or terminate workers
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = *it;
+        worker->Update();
+        if (worker->IsTerminated())
+        {
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void ScriptEngine::RemoveWorkers(const std::shared_ptr<Plugin>& plugin)
+{
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = it->get();
+        if (worker->GetPlugin() == plugin)
+        {
+            worker->Terminate();
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void ScriptEngine::AddPendingCapture(
+    const std::shared_ptr<Plugin>& plugin, std::future<void>&& result, const DukValue& callback)
+{
+    _pendingCaptures.push_back({ plugin, std::move(result), callback });
+}
+
+void ScriptEngine::UpdatePendingCaptures()
+{
+    auto it = _pendingCaptures.begin();
+    while (it != _pendingCaptures.end())
+    {
+        if (it->Result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            it++;
+            continue;
+        }
+
+        // Erase before calling back as the callback may start another capture
+        auto capture = std::move(*it);
+        _pendingCaptures.erase(it);
+
+        auto dukError = ToDuk(_context, undefined);
+        try
+        {
+            capture.Result.get();
+        }
+        catch (const std::exception& e)
+        {
+            dukError = ToDuk(_context, std::string(e.what()));
+        }
+        ExecutePluginCall(capture.Owner, capture.Callback, { dukError }, false);
+        it = _pendingCaptures.begin();
+    }
+}
+
+void ScriptEngine::RemovePendingCaptures(const std::shared_ptr<Plugin>& plugin)
+{
+    // The files are still written, only the callbacks are dropped
+    for (auto& capture : _pendingCaptures)
+    {
+        if (capture.Owner == plugin)
+        {
+            capture.Owner = nullptr;
+            capture.Callback = {};
+        }
+    }
+}
+
 std::string OpenRCT2::Scripting::Stringify(const DukValue& val)
 {
     return ExpressionStringifier::StringifyExpression(val);
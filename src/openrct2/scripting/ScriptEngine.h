@@ -18,10 +18,12 @@
 #    include "HookEngine.h"
 #    include "Plugin.h"
 
+#    include <chrono>
 #    include <future>
 #    include <list>
 #    include <memory>
 #    include <mutex>
+#    include <optional>
 #    include <queue>
 #    include <string>
 #    include <unordered_map>
@@ -46,13 +48,14 @@ namespace OpenRCT2
 
 namespace OpenRCT2::Scripting
 {
-    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 42;
+    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 49;
 
     // Versions marking breaking changes.
     static constexpr int32_t API_VERSION_33_PEEP_DEPRECATION = 33;
 
 #    ifndef DISABLE_NETWORK
     class ScSocketBase;
+    class ScWorker;
 #    endif
 
     class ScriptExecutionInfo
@@ -156,10 +159,10 @@ namespace OpenRCT2::Scripting
 
         uint32_t _lastIntervalTimestamp{};
         std::vector<ScriptInterval> _intervals;
+        // Time spent in plugin calls made from within the current plugin call, so it is not counted twice.
+        std::chrono::duration<double> _nestedCallTime{};
 
         std::unique_ptr<FileWatcher> _pluginFileWatcher;
-        std::unordered_set<std::string> _changedPluginFiles;
-        std::mutex _changedPluginFilesMutex;
         std::vector<std::function<void(std::shared_ptr<Plugin>)>> _pluginStoppedSubscriptions;
 
         struct CustomActionInfo
@@ -171,9 +174,22 @@ namespace OpenRCT2::Scripting
         };
 
         std::unordered_map<std::string, CustomActionInfo> _customActions;
+        // Custom action arguments travel as JSON, every payload that has been parsed once is kept in CBOR form which
+        // decodes faster. Each use still decodes a new object so handlers can not see each other's changes.
+        std::unordered_map<std::string, std::vector<uint8_t>> _customActionArgsCache;
 #    ifndef DISABLE_NETWORK
         std::list<std::shared_ptr<ScSocketBase>> _sockets;
 #    endif
+        std::list<std::shared_ptr<ScWorker>> _workers;
+
+        struct PendingCapture
+        {
+            std::shared_ptr<Plugin> Owner;
+            std::future<void> Result;
+            DukValue Callback;
+        };
+
+        std::vector<PendingCapture> _pendingCaptures;
 
     public:
         ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env);
@@ -213,6 +229,8 @@ namespace OpenRCT2::Scripting
 
         void LogPluginInfo(const std::shared_ptr<Plugin>& plugin, std::string_view message);
 
+        void ResetTimings();
+
         void SubscribeToPluginStoppedEvent(std::function<void(std::shared_ptr<Plugin>)> callback)
         {
             _pluginStoppedSubscriptions.push_back(callback);
@@ -236,6 +254,10 @@ namespace OpenRCT2::Scripting
         void AddSocket(const std::shared_ptr<ScSocketBase>& socket);
 #    endif
 
+        void AddWorker(const std::shared_ptr<ScWorker>& worker);
+
+        void AddPendingCapture(const std::shared_ptr<Plugin>& plugin, std::future<void>&& result, const DukValue& callback);
+
     private:
         void Initialise();
         void StartPlugins();
@@ -249,6 +271,7 @@ namespace OpenRCT2::Scripting
         void AutoReloadPlugins();
         void ProcessREPL();
         void RemoveCustomGameActions(const std::shared_ptr<Plugin>& plugin);
+        std::optional<DukValue> DecodeCustomActionArgs(std::string_view json);
         [[nodiscard]] GameActions::Result DukToGameActionResult(const DukValue& d);
         [[nodiscard]] DukValue GameActionResultToDuk(const GameAction& action, const GameActions::Result& result);
         static std::string_view ExpenditureTypeToString(ExpenditureType expenditureType);
@@ -258,11 +281,19 @@ namespace OpenRCT2::Scripting
         void LoadSharedStorage();
 
         IntervalHandle AllocateHandle();
+        bool IsOverIntervalBudget(const std::shared_ptr<Plugin>& plugin);
         void UpdateIntervals();
+        void EndTimingsTick();
         void RemoveIntervals(const std::shared_ptr<Plugin>& plugin);
 
         void UpdateSockets();
         void RemoveSockets(const std::shared_ptr<Plugin>& plugin);
+
+        void UpdateWorkers();
+        void RemoveWorkers(const std::shared_ptr<Plugin>& plugin);
+
+        void UpdatePendingCaptures();
+        void RemovePendingCaptures(const std::shared_ptr<Plugin>& plugin);
     };
 
     bool IsGameStateMutable();
@@ -12,6 +12,7 @@
 #ifdef ENABLE_SCRIPTING
 
 #    include "../../../actions/GameAction.h"
+#    include "../../../core/MemoryAccounting.h"
 #    include "../../../interface/Screenshot.h"
 #    include "../../../localisation/Formatting.h"
 #    include "../../../object/ObjectManager.h"
@@ -21,6 +22,7 @@
 #    include "../../ScriptEngine.h"
 #    include "../game/ScConfiguration.hpp"
 #    include "../game/ScDisposable.hpp"
+#    include "../game/ScWorker.hpp"
 #    include "../object/ScObject.hpp"
 
 #    include <cstdio>
@@ -58,9 +60,23 @@ namespace OpenRCT2::Scripting
             return std::make_shared<ScConfiguration>(scriptEngine.GetSharedStorage());
         }
 
-        void captureImage(const DukValue& options)
+        DukValue memoryStats_get() const
         {
             auto ctx = GetContext()->GetScriptEngine().GetContext();
+            auto entries = MemoryAccounting::Query();
+            DukObject obj(ctx);
+            for (const auto& entry : entries)
+            {
+                obj.Set(entry.Name.c_str(), static_cast<uint64_t>(entry.Bytes));
+            }
+            obj.Set("total", static_cast<uint64_t>(MemoryAccounting::GetTotal(entries)));
+            return obj.Take();
+        }
+
+        void captureImage(const DukValue& options, const DukValue& callback)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
             try
             {
                 CaptureOptions captureOptions;
@@ -80,7 +96,15 @@ namespace OpenRCT2::Scripting
                     captureOptions.View = view;
                 }
 
-                CaptureImage(captureOptions);
+                if (callback.is_function())
+                {
+                    auto plugin = scriptEngine.GetExecInfo().GetCurrentPlugin();
+                    scriptEngine.AddPendingCapture(plugin, CaptureImageAsync(captureOptions), callback);
+                }
+                else
+                {
+                    CaptureImage(captureOptions);
+                }
             }
             catch (const DukException&)
             {
@@ -204,7 +228,7 @@ namespace OpenRCT2::Scripting
             return 1;
         }
 
-        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback)
+        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback, const DukValue& options)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
             auto ctx = scriptEngine.GetContext();
@@ -226,7 +250,29 @@ namespace OpenRCT2::Scripting
                 duk_error(ctx, DUK_ERR_ERROR, "Not in a plugin context");
             }
 
-            auto cookie = _hookEngine.Subscribe(hookType, owner, callback);
+            std::vector<std::string> actionFilter;
+            if (options.type() == DukValue::Type::OBJECT)
+            {
+                if (hookType != HOOK_TYPE::ACTION_QUERY && hookType != HOOK_TYPE::ACTION_EXECUTE)
+                {
+                    duk_error(ctx, DUK_ERR_ERROR, "Options are only supported for action.query and action.execute");
+                }
+
+                auto dukActions = options["actions"];
+                if (dukActions.is_array())
+                {
+                    for (const auto& dukAction : dukActions.as_array())
+                    {
+                        if (dukAction.type() != DukValue::Type::STRING)
+                        {
+                            duk_error(ctx, DUK_ERR_ERROR, "Expected action names for actions");
+                        }
+                        actionFilter.push_back(dukAction.as_string());
+                    }
+                }
+            }
+
+            auto cookie = _hookEngine.Subscribe(hookType, owner, callback, std::move(actionFilter));
             return std::make_shared<ScDisposable>([this, hookType, cookie]() { _hookEngine.Unsubscribe(hookType, cookie); });
         }
 
@@ -375,12 +421,22 @@ namespace OpenRCT2::Scripting
             ClearIntervalOrTimeout(handle);
         }
 
+        std::shared_ptr<ScWorker> createWorker(const std::string& code)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto plugin = scriptEngine.GetExecInfo().GetCurrentPlugin();
+            auto worker = std::make_shared<ScWorker>(plugin, code);
+            scriptEngine.AddWorker(worker);
+            return worker;
+        }
+
     public:
         static void Register(duk_context* ctx)
         {
             dukglue_register_property(ctx, &ScContext::apiVersion_get, nullptr, "apiVersion");
             dukglue_register_property(ctx, &ScContext::configuration_get, nullptr, "configuration");
             dukglue_register_property(ctx, &ScContext::sharedStorage_get, nullptr, "sharedStorage");
+            dukglue_register_property(ctx, &ScContext::memoryStats_get, nullptr, "memoryStats");
             dukglue_register_method(ctx, &ScContext::captureImage, "captureImage");
             dukglue_register_method(ctx, &ScContext::getObject, "getObject");
             dukglue_register_method(ctx, &ScContext::getAllObjects, "getAllObjects");
@@ -394,6 +450,7 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScContext::setTimeout, "setTimeout");
             dukglue_register_method(ctx, &ScContext::clearInterval, "clearInterval");
             dukglue_register_method(ctx, &ScContext::clearTimeout, "clearTimeout");
+            dukglue_register_method(ctx, &ScContext::createWorker, "createWorker");
         }
     };
 } // namespace OpenRCT2::Scripting
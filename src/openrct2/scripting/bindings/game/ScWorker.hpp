@@ -0,0 +1,294 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../../../Context.h"
+#    include "../../Duktape.hpp"
+#    include "../../ScriptEngine.h"
+
+#    include <condition_variable>
+#    include <deque>
+#    include <memory>
+#    include <mutex>
+#    include <string>
+#    include <thread>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * Runs plugin supplied code in its own duktape heap on a background thread. The worker heap has no access to the
+     * game, the only way in or out is postMessage. Messages are copied between the heaps as JSON.
+     */
+    class ScWorker
+    {
+    private:
+        struct SharedState
+        {
+            std::mutex Mutex;
+            std::condition_variable Condition;
+            std::deque<std::string> Inbox;
+            std::deque<std::string> Outbox;
+            std::deque<std::string> Errors;
+            bool Terminated{};
+        };
+
+        static constexpr const char* StashKey = "worker";
+
+        std::shared_ptr<Plugin> _plugin;
+        std::shared_ptr<SharedState> _state = std::make_shared<SharedState>();
+        DukValue _onMessage;
+        DukValue _onError;
+        bool _terminated{};
+
+    public:
+        ScWorker(const std::shared_ptr<Plugin>& plugin, const std::string& code)
+            : _plugin(plugin)
+        {
+            std::thread(&ScWorker::Run, _state, code).detach();
+        }
+
+        ~ScWorker()
+        {
+            Terminate();
+        }
+
+        const std::shared_ptr<Plugin>& GetPlugin() const
+        {
+            return _plugin;
+        }
+
+        bool IsTerminated() const
+        {
+            return _terminated;
+        }
+
+        /**
+         * Delivers messages and errors raised by the worker since the last update, called every tick.
+         */
+        void Update()
+        {
+            if (_terminated)
+                return;
+
+            std::deque<std::string> messages;
+            std::deque<std::string> errors;
+            {
+                std::lock_guard<std::mutex> lock(_state->Mutex);
+                messages.swap(_state->Outbox);
+                errors.swap(_state->Errors);
+            }
+
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto ctx = scriptEngine.GetContext();
+            for (const auto& message : messages)
+            {
+                if (_terminated)
+                    return;
+                if (_onMessage.is_function())
+                {
+                    auto value = DuktapeTryParseJson(ctx, message);
+                    if (value)
+                    {
+                        scriptEngine.ExecutePluginCall(_plugin, _onMessage, { *value }, false);
+                    }
+                }
+            }
+            for (const auto& error : errors)
+            {
+                if (_terminated)
+                    return;
+                if (_onError.is_function())
+                {
+                    scriptEngine.ExecutePluginCall(_plugin, _onError, { ToDuk(ctx, error) }, false);
+                }
+                else
+                {
+                    scriptEngine.LogPluginInfo(_plugin, "[worker] " + error);
+                }
+            }
+        }
+
+        void Terminate()
+        {
+            if (_terminated)
+                return;
+
+            _terminated = true;
+            _onMessage = {};
+            _onError = {};
+            {
+                std::lock_guard<std::mutex> lock(_state->Mutex);
+                _state->Terminated = true;
+                _state->Inbox.clear();
+                _state->Outbox.clear();
+                _state->Errors.clear();
+            }
+            _state->Condition.notify_all();
+        }
+
+    private:
+        DukValue onMessage_get() const
+        {
+            return _onMessage;
+        }
+
+        void onMessage_set(const DukValue& value)
+        {
+            _onMessage = value;
+        }
+
+        DukValue onError_get() const
+        {
+            return _onError;
+        }
+
+        void onError_set(const DukValue& value)
+        {
+            _onError = value;
+        }
+
+        void postMessage(const DukValue& message)
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            if (_terminated)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Worker has been terminated.");
+            }
+
+            message.push();
+            auto json = EncodeMessage(ctx, -1);
+            duk_pop(ctx);
+            {
+                std::lock_guard<std::mutex> lock(_state->Mutex);
+                _state->Inbox.push_back(std::move(json));
+            }
+            _state->Condition.notify_one();
+        }
+
+        void terminate()
+        {
+            Terminate();
+        }
+
+        /**
+         * Encodes the value at the given stack index, values JSON can not represent are sent as null.
+         */
+        static std::string EncodeMessage(duk_context* ctx, duk_idx_t index)
+        {
+            duk_dup(ctx, index);
+            auto json = duk_json_encode(ctx, -1);
+            std::string result = json != nullptr && duk_is_string(ctx, -1) ? json : "null";
+            duk_pop(ctx);
+            return result;
+        }
+
+        static SharedState* GetSharedState(duk_context* ctx)
+        {
+            duk_push_heap_stash(ctx);
+            duk_get_prop_string(ctx, -1, StashKey);
+            auto state = static_cast<SharedState*>(duk_get_pointer(ctx, -1));
+            duk_pop_2(ctx);
+            return state;
+        }
+
+        static duk_ret_t WorkerPostMessage(duk_context* ctx)
+        {
+            auto json = EncodeMessage(ctx, 0);
+            auto state = GetSharedState(ctx);
+            std::lock_guard<std::mutex> lock(state->Mutex);
+            if (!state->Terminated)
+            {
+                state->Outbox.push_back(std::move(json));
+            }
+            return 0;
+        }
+
+        static void PushError(SharedState& state, duk_context* ctx)
+        {
+            std::string message = duk_safe_to_string(ctx, -1);
+            std::lock_guard<std::mutex> lock(state.Mutex);
+            if (!state.Terminated)
+            {
+                state.Errors.push_back(std::move(message));
+            }
+        }
+
+        /**
+         * Worker thread, the state is shared so the thread can outlive the binding if the script does not return.
+         */
+        static void Run(std::shared_ptr<SharedState> state, std::string code)
+        {
+            auto ctx = duk_create_heap_default();
+            if (ctx == nullptr)
+            {
+                std::lock_guard<std::mutex> lock(state->Mutex);
+                state->Errors.push_back("Unable to create worker context.");
+                return;
+            }
+
+            duk_push_heap_stash(ctx);
+            duk_push_pointer(ctx, state.get());
+            duk_put_prop_string(ctx, -2, StashKey);
+            duk_pop(ctx);
+
+            duk_push_c_function(ctx, WorkerPostMessage, 1);
+            duk_put_global_string(ctx, "postMessage");
+
+            bool running = true;
+            if (duk_peval_lstring(ctx, code.data(), code.size()) != 0)
+            {
+                PushError(*state, ctx);
+                running = false;
+            }
+            duk_pop(ctx);
+
+            while (running)
+            {
+                std::string message;
+                {
+                    std::unique_lock<std::mutex> lock(state->Mutex);
+                    state->Condition.wait(lock, [&state]() { return state->Terminated || !state->Inbox.empty(); });
+                    if (state->Terminated)
+                        break;
+                    message = std::move(state->Inbox.front());
+                    state->Inbox.pop_front();
+                }
+
+                duk_get_global_string(ctx, "onmessage");
+                if (duk_is_function(ctx, -1))
+                {
+                    duk_push_lstring(ctx, message.data(), message.size());
+                    duk_json_decode(ctx, -1);
+                    if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                    {
+                        PushError(*state, ctx);
+                    }
+                }
+                duk_pop(ctx);
+            }
+
+            duk_destroy_heap(ctx);
+        }
+
+    public:
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_property(ctx, &ScWorker::onMessage_get, &ScWorker::onMessage_set, "onmessage");
+            dukglue_register_property(ctx, &ScWorker::onError_get, &ScWorker::onError_set, "onerror");
+            dukglue_register_method(ctx, &ScWorker::postMessage, "postMessage");
+            dukglue_register_method(ctx, &ScWorker::terminate, "terminate");
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
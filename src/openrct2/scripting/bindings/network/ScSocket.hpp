@@ -134,8 +134,12 @@ namespace OpenRCT2::Scripting
         static constexpr uint32_t EVENT_CONNECT_ONCE = 2;
         static constexpr uint32_t EVENT_ERROR = 3;
 
+        // Bound on the data delivered per tick, the rest stays in the socket buffer for the next tick.
+        static constexpr size_t MaxReceiveSizePerTick = 256 * 1024;
+
         EventList _eventList;
         std::unique_ptr<ITcpSocket> _socket;
+        std::string _receiveBuffer;
         bool _disposed{};
         bool _connecting{};
         bool _wasConnected{};
@@ -215,7 +219,8 @@ namespace OpenRCT2::Scripting
             {
                 if (data.type() == DukValue::Type::STRING)
                 {
-                    write(data.as_string());
+                    const auto& str = data.as_string();
+                    SendData(str.data(), str.size());
                     _socket->Finish();
                 }
                 else
@@ -228,19 +233,40 @@ namespace OpenRCT2::Scripting
             return this;
         }
 
-        bool write(const std::string& data)
+        duk_ret_t write(duk_context* ctx)
         {
             if (_disposed)
             {
-                auto ctx = GetContext()->GetScriptEngine().GetContext();
                 duk_error(ctx, DUK_ERR_ERROR, "Socket is disposed.");
             }
-            else if (_socket != nullptr)
+
+            // Send straight from the duktape string or buffer rather than copying it first
+            duk_size_t size{};
+            const void* data{};
+            if (duk_is_string(ctx, 0))
+            {
+                data = duk_get_lstring(ctx, 0, &size);
+            }
+            else if (duk_is_buffer_data(ctx, 0))
+            {
+                data = duk_get_buffer_data(ctx, 0, &size);
+            }
+            else
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Only sending strings or buffers is supported.");
+            }
+            duk_push_boolean(ctx, SendData(data, size));
+            return 1;
+        }
+
+        bool SendData(const void* data, size_t size)
+        {
+            if (_socket != nullptr)
             {
                 try
                 {
-                    auto sentBytes = _socket->SendData(data.c_str(), data.size());
-                    return sentBytes != data.size();
+                    auto sentBytes = _socket->SendData(data, size);
+                    return sentBytes != size;
                 }
                 catch (const std::exception&)
                 {
@@ -343,21 +369,28 @@ namespace OpenRCT2::Scripting
                 }
                 else if (status == SocketStatus::Connected)
                 {
-                    char buffer[2048];
-                    size_t bytesRead{};
-                    auto result = _socket->ReceiveData(buffer, sizeof(buffer), &bytesRead);
-                    switch (result)
+                    // Drain everything that arrived since the last tick so listeners get a single data event
+                    _receiveBuffer.clear();
+                    bool disconnected = false;
+                    while (_receiveBuffer.size() < MaxReceiveSizePerTick)
                     {
-                        case NetworkReadPacket::Success:
-                            RaiseOnData(std::string(buffer, bytesRead));
-                            break;
-                        case NetworkReadPacket::NoData:
-                            break;
-                        case NetworkReadPacket::MoreData:
-                            break;
-                        case NetworkReadPacket::Disconnected:
-                            CloseSocket();
+                        char buffer[2048];
+                        size_t bytesRead{};
+                        auto result = _socket->ReceiveData(buffer, sizeof(buffer), &bytesRead);
+                        if (result != NetworkReadPacket::Success)
+                        {
+                            disconnected = result == NetworkReadPacket::Disconnected;
                             break;
+                        }
+                        _receiveBuffer.append(buffer, bytesRead);
+                    }
+                    if (!_receiveBuffer.empty())
+                    {
+                        RaiseOnData(_receiveBuffer);
+                    }
+                    if (disconnected)
+                    {
+                        CloseSocket();
                     }
                 }
                 else
@@ -384,7 +417,7 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScSocket::setNoDelay, "setNoDelay");
             dukglue_register_method(ctx, &ScSocket::connect, "connect");
             dukglue_register_method(ctx, &ScSocket::end, "end");
-            dukglue_register_method(ctx, &ScSocket::write, "write");
+            dukglue_register_method_varargs(ctx, &ScSocket::write, "write");
             dukglue_register_method(ctx, &ScSocket::on, "on");
             dukglue_register_method(ctx, &ScSocket::off, "off");
         }
@@ -33,6 +33,8 @@
 #    include "../ride/ScRide.hpp"
 #    include "../world/ScTile.hpp"
 
+#    include <algorithm>
+
 namespace OpenRCT2::Scripting
 {
     ScMap::ScMap(duk_context* ctx)
@@ -167,6 +169,210 @@ namespace OpenRCT2::Scripting
         return result;
     }
 
+    template<typename T> static void CollectEntities(std::vector<const EntityBase*>& entities)
+    {
+        for (auto* entity : EntityList<T>())
+        {
+            entities.push_back(entity);
+        }
+    }
+
+    struct EntityFieldDescriptor
+    {
+        const char* Name;
+        bool PeepsOnly;
+        bool GuestsOnly;
+        int32_t (*Get)(const EntityBase& entity);
+    };
+
+    // Only peeps are collected for peep fields and only guests for guest fields, so the casts below are safe.
+    static constexpr EntityFieldDescriptor EntityFields[] = {
+        { "id", false, false, [](const EntityBase& entity) -> int32_t { return entity.sprite_index; } },
+        { "x", false, false, [](const EntityBase& entity) -> int32_t { return entity.x; } },
+        { "y", false, false, [](const EntityBase& entity) -> int32_t { return entity.y; } },
+        { "z", false, false, [](const EntityBase& entity) -> int32_t { return entity.z; } },
+        { "happiness", true, true,
+          [](const EntityBase& entity) -> int32_t { return static_cast<const Guest&>(entity).Happiness; } },
+        { "energy", true, false, [](const EntityBase& entity) -> int32_t { return static_cast<const Peep&>(entity).Energy; } },
+        { "cash", true, true,
+          [](const EntityBase& entity) -> int32_t { return static_cast<const Guest&>(entity).CashInPocket; } },
+        { "state", true, false,
+          [](const EntityBase& entity) -> int32_t { return EnumValue(static_cast<const Peep&>(entity).State); } },
+    };
+
+    DukValue ScMap::getEntityFields(const std::string& type, std::vector<std::string> fields) const
+    {
+        static std::vector<const EntityBase*> entities;
+        entities.clear();
+
+        bool isPeepType = false;
+        bool isGuestType = false;
+        if (type == "balloon")
+        {
+            CollectEntities<Balloon>(entities);
+        }
+        else if (type == "car")
+        {
+            for (auto trainHead : TrainManager::View())
+            {
+                for (auto* car = trainHead; car != nullptr; car = GetEntity<Vehicle>(car->next_vehicle_on_train))
+                {
+                    entities.push_back(car);
+                }
+            }
+        }
+        else if (type == "litter")
+        {
+            CollectEntities<Litter>(entities);
+        }
+        else if (type == "duck")
+        {
+            CollectEntities<Duck>(entities);
+        }
+        else if (type == "peep")
+        {
+            CollectEntities<Guest>(entities);
+            CollectEntities<Staff>(entities);
+            isPeepType = true;
+        }
+        else if (type == "guest")
+        {
+            CollectEntities<Guest>(entities);
+            isPeepType = true;
+            isGuestType = true;
+        }
+        else if (type == "staff")
+        {
+            CollectEntities<Staff>(entities);
+            isPeepType = true;
+        }
+        else
+        {
+            duk_error(_context, DUK_ERR_ERROR, "Invalid entity type.");
+        }
+
+        // Look up every field before allocating anything so invalid requests do not leave buffers on the stack.
+        std::vector<const EntityFieldDescriptor*> descriptors;
+        for (const auto& field : fields)
+        {
+            auto it = std::find_if(std::begin(EntityFields), std::end(EntityFields), [&field](const auto& descriptor) {
+                return field == descriptor.Name;
+            });
+            if (it == std::end(EntityFields))
+            {
+                duk_error(_context, DUK_ERR_ERROR, "Invalid entity field.");
+            }
+            if ((it->PeepsOnly && !isPeepType) || (it->GuestsOnly && !isGuestType))
+            {
+                duk_error(_context, DUK_ERR_ERROR, "Entity field is not available for this entity type.");
+            }
+            descriptors.push_back(it);
+        }
+
+        const auto dataLen = entities.size() * sizeof(int32_t);
+        duk_push_object(_context);
+        for (const auto* descriptor : descriptors)
+        {
+            auto* data = static_cast<int32_t*>(duk_push_fixed_buffer(_context, dataLen));
+            for (size_t i = 0; i < entities.size(); i++)
+            {
+                data[i] = descriptor->Get(*entities[i]);
+            }
+            duk_push_buffer_object(_context, -1, 0, dataLen, DUK_BUFOBJ_INT32ARRAY);
+            duk_remove(_context, -2);
+            duk_put_prop_string(_context, -2, descriptor->Name);
+        }
+        return DukValue::take_from_stack(_context);
+    }
+
+    struct TileFieldDescriptor
+    {
+        const char* Name;
+        int32_t (*Get)(const TileCoordsXY& coords, const SurfaceElement* surface);
+    };
+
+    static constexpr TileFieldDescriptor TileFields[] = {
+        { "surfaceHeight",
+          [](const TileCoordsXY&, const SurfaceElement* surface) -> int32_t {
+              return surface != nullptr ? surface->GetBaseZ() : 0;
+          } },
+        { "waterHeight",
+          [](const TileCoordsXY&, const SurfaceElement* surface) -> int32_t {
+              return surface != nullptr ? surface->GetWaterHeight() : 0;
+          } },
+        { "ownership",
+          [](const TileCoordsXY&, const SurfaceElement* surface) -> int32_t {
+              return surface != nullptr ? surface->GetOwnership() : 0;
+          } },
+        { "elementTypes",
+          [](const TileCoordsXY& coords, const SurfaceElement*) -> int32_t {
+              int32_t mask = 0;
+              for (auto* element = map_get_first_element_at(coords.ToCoordsXY()); element != nullptr; element++)
+              {
+                  mask |= 1 << EnumValue(element->GetType());
+                  if (element->IsLastForTile())
+                  {
+                      break;
+                  }
+              }
+              return mask;
+          } },
+        { "hasPath",
+          [](const TileCoordsXY& coords, const SurfaceElement*) -> int32_t {
+              return MapTileHasElementType(coords, TileElementType::Path) ? 1 : 0;
+          } },
+    };
+
+    DukValue ScMap::getTileData(const DukValue& range, std::vector<std::string> fields) const
+    {
+        std::vector<const TileFieldDescriptor*> descriptors;
+        for (const auto& field : fields)
+        {
+            auto it = std::find_if(std::begin(TileFields), std::end(TileFields), [&field](const auto& descriptor) {
+                return field == descriptor.Name;
+            });
+            if (it == std::end(TileFields))
+            {
+                duk_error(_context, DUK_ERR_ERROR, "Invalid tile field.");
+            }
+            descriptors.push_back(it);
+        }
+
+        // The range is in game coordinates like everywhere else in the API, clamp it to the tiles of the map.
+        const auto leftTop = TileCoordsXY(FromDuk<CoordsXY>(range["leftTop"]));
+        const auto rightBottom = TileCoordsXY(FromDuk<CoordsXY>(range["rightBottom"]));
+        const int32_t left = std::max(0, std::min(leftTop.x, rightBottom.x));
+        const int32_t top = std::max(0, std::min(leftTop.y, rightBottom.y));
+        const int32_t right = std::min<int32_t>(gMapSize - 1, std::max(leftTop.x, rightBottom.x));
+        const int32_t bottom = std::min<int32_t>(gMapSize - 1, std::max(leftTop.y, rightBottom.y));
+        const size_t width = right >= left ? right - left + 1 : 0;
+        const size_t height = bottom >= top ? bottom - top + 1 : 0;
+        const auto dataLen = width * height * sizeof(int32_t);
+
+        duk_push_object(_context);
+        duk_push_uint(_context, static_cast<duk_uint_t>(width));
+        duk_put_prop_string(_context, -2, "width");
+        duk_push_uint(_context, static_cast<duk_uint_t>(height));
+        duk_put_prop_string(_context, -2, "height");
+        for (const auto* descriptor : descriptors)
+        {
+            auto* data = static_cast<int32_t*>(duk_push_fixed_buffer(_context, dataLen));
+            for (size_t y = 0; y < height; y++)
+            {
+                for (size_t x = 0; x < width; x++)
+                {
+                    const auto coords = TileCoordsXY(left + static_cast<int32_t>(x), top + static_cast<int32_t>(y));
+                    const auto* surface = map_get_surface_element_at(coords.ToCoordsXY());
+                    *data++ = descriptor->Get(coords, surface);
+                }
+            }
+            duk_push_buffer_object(_context, -1, 0, dataLen, DUK_BUFOBJ_INT32ARRAY);
+            duk_remove(_context, -2);
+            duk_put_prop_string(_context, -2, descriptor->Name);
+        }
+        return DukValue::take_from_stack(_context);
+    }
+
     template<typename TEntityType, typename TScriptType>
     DukValue createEntityType(duk_context* ctx, const DukValue& initializer)
     {
@@ -250,8 +456,10 @@ namespace OpenRCT2::Scripting
         dukglue_register_property(ctx, &ScMap::rides_get, nullptr, "rides");
         dukglue_register_method(ctx, &ScMap::getRide, "getRide");
         dukglue_register_method(ctx, &ScMap::getTile, "getTile");
+        dukglue_register_method(ctx, &ScMap::getTileData, "getTileData");
         dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
         dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
+        dukglue_register_method(ctx, &ScMap::getEntityFields, "getEntityFields");
         dukglue_register_method(ctx, &ScMap::createEntity, "createEntity");
     }
 
@@ -38,10 +38,14 @@ namespace OpenRCT2::Scripting
 
         std::shared_ptr<ScTile> getTile(int32_t x, int32_t y) const;
 
+        DukValue getTileData(const DukValue& range, std::vector<std::string> fields) const;
+
         DukValue getEntity(int32_t id) const;
 
         std::vector<DukValue> getAllEntities(const std::string& type) const;
 
+        DukValue getEntityFields(const std::string& type, std::vector<std::string> fields) const;
+
         DukValue createEntity(const std::string& type, const DukValue& initializer);
 
         static void Register(duk_context* ctx);
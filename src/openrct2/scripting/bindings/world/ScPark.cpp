@@ -43,6 +43,7 @@ namespace OpenRCT2::Scripting
         { "difficultParkRating", PARK_FLAGS_DIFFICULT_PARK_RATING },
         { "noMoney", PARK_FLAGS_NO_MONEY_SCENARIO },
         { "unlockAllPrices", PARK_FLAGS_UNLOCK_ALL_PRICES },
+        { "guestFlowFieldNavigation", PARK_FLAGS_GUEST_FLOW_FIELD_NAVIGATION },
     });
 
     money64 ScPark::cash_get() const
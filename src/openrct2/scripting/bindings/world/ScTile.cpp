@@ -125,7 +125,9 @@ namespace OpenRCT2::Scripting
                     first[numElements - 1].SetLastForTile(true);
                 }
             }
+            MapUpdateTileSummary(TileCoordsXY(_coords));
             map_invalidate_tile_full(_coords);
+            footpath_mark_wide_flags_dirty(_coords);
         }
     }
 
@@ -177,7 +179,9 @@ namespace OpenRCT2::Scripting
                     first[i].SetLastForTile(false);
                 }
                 first[origNumElements].SetLastForTile(true);
+                MapUpdateTileSummary(TileCoordsXY(_coords));
                 map_invalidate_tile_full(_coords);
+                footpath_mark_wide_flags_dirty(_coords);
                 result = std::make_shared<ScTileElement>(_coords, &first[index]);
             }
         }
@@ -197,6 +201,7 @@ namespace OpenRCT2::Scripting
         {
             tile_element_remove(&first[index]);
             map_invalidate_tile_full(_coords);
+            footpath_mark_wide_flags_dirty(_coords);
         }
     }
 
@@ -84,6 +84,8 @@ namespace OpenRCT2::Scripting
             return;
         }
 
+        MapUpdateTileSummary(TileCoordsXY{ _coords });
+        footpath_mark_wide_flags_dirty(_coords);
         Invalidate();
     }
 
@@ -1153,6 +1155,7 @@ namespace OpenRCT2::Scripting
         if (el != nullptr)
         {
             el->SetEdgesAndCorners(value);
+            footpath_mark_wide_flags_dirty(_coords);
             Invalidate();
         }
     }
@@ -1174,6 +1177,7 @@ namespace OpenRCT2::Scripting
         if (el != nullptr)
         {
             el->SetEdges(value);
+            footpath_mark_wide_flags_dirty(_coords);
             Invalidate();
         }
     }
@@ -17,8 +17,17 @@
 #include <algorithm>
 #include <cstring>
 
+// SSE2 is always available on x64, other targets use the scalar versions
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define SAWYERCODING_SSE2
+#    include <emmintrin.h>
+#endif
+
 static size_t decode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length, size_t dstSize);
+static size_t decode_chunk_rle_range(
+    const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length, size_t offset, size_t dstSize);
+static void decode_sc4_scramble(uint8_t* dst, size_t offset, size_t length);
 
 static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
@@ -29,12 +38,132 @@ bool gUseRLE = true;
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
 {
     uint32_t checksum = 0;
-    for (size_t i = 0; i < length; i++)
+    size_t i = 0;
+#ifdef SAWYERCODING_SSE2
+    // Sum 16 bytes at a time, the sums of absolute differences against zero are the byte sums of each half
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = zero;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(bytes, zero));
+    }
+    checksum = static_cast<uint32_t>(_mm_cvtsi128_si32(sums))
+        + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+#endif
+    for (; i < length; i++)
         checksum += buffer[i];
 
     return checksum;
 }
 
+/**
+ * Rotates each byte left, byte i by amounts[i % 4]. Reading and writing the same buffer is allowed.
+ */
+static void rotate_bytes_left(const uint8_t* src, uint8_t* dst, size_t length, const uint8_t (&amounts)[4])
+{
+    size_t i = 0;
+#ifdef SAWYERCODING_SSE2
+    // Every 32-bit lane holds four bytes with the four different amounts. Shifting the whole lane and masking out the
+    // bits that crossed into a neighbouring byte rotates each byte by the amount for its position.
+    __m128i leftMasks[4];
+    __m128i rightMasks[4];
+    __m128i leftShifts[4];
+    __m128i rightShifts[4];
+    for (int32_t k = 0; k < 4; k++)
+    {
+        const int32_t amount = amounts[k] & 7;
+        leftMasks[k] = _mm_set1_epi32(static_cast<int32_t>(((0xFFu << amount) & 0xFFu) << (8 * k)));
+        rightMasks[k] = _mm_set1_epi32(static_cast<int32_t>((0xFFu >> (8 - amount)) << (8 * k)));
+        leftShifts[k] = _mm_cvtsi32_si128(amount);
+        rightShifts[k] = _mm_cvtsi32_si128(8 - amount);
+    }
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i result = _mm_setzero_si128();
+        for (int32_t k = 0; k < 4; k++)
+        {
+            result = _mm_or_si128(result, _mm_and_si128(_mm_sll_epi32(bytes, leftShifts[k]), leftMasks[k]));
+            result = _mm_or_si128(result, _mm_and_si128(_mm_srl_epi32(bytes, rightShifts[k]), rightMasks[k]));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+    }
+#endif
+    for (; i < length; i++)
+    {
+        dst[i] = Numerics::rol8(src[i], amounts[i % 4]);
+    }
+}
+
+// The rotate encoding rotates byte i left by 1, 3, 5 or 7 bits in turn
+static constexpr const uint8_t RotateEncodeAmounts[4] = { 1, 3, 5, 7 };
+static constexpr const uint8_t RotateDecodeAmounts[4] = { 7, 5, 3, 1 };
+
+void sawyercoding_decode_rotate(const uint8_t* src, uint8_t* dst, size_t length)
+{
+    rotate_bytes_left(src, dst, length, RotateDecodeAmounts);
+}
+
+/**
+ * Counts how many bytes from src onwards, up to maxCount, are the same as the first one.
+ */
+static size_t count_repeated_bytes(const uint8_t* src, size_t maxCount)
+{
+    size_t count = 0;
+#ifdef SAWYERCODING_SSE2
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(*src));
+    for (; count + 16 <= maxCount; count += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count));
+        const auto different = static_cast<uint32_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, needle))) & 0xFFFF;
+        if (different != 0)
+        {
+            return count + bitscanforward(static_cast<int32_t>(different));
+        }
+    }
+#endif
+    for (; count < maxCount; count++)
+    {
+        if (*src != src[count])
+            break;
+    }
+    return count;
+}
+
+/**
+ * Counts how many positions from src onwards, up to limit, do not start a pair of equal bytes.
+ * src[limit - src] must still be readable.
+ */
+static size_t count_unpaired_bytes(const uint8_t* src, const uint8_t* limit)
+{
+    // Most literal runs are short, so check the first few positions one at a time
+    const uint8_t* position = src;
+    for (const auto* scalarEnd = std::min(src + 8, limit); position < scalarEnd; position++)
+    {
+        if (position[0] == position[1])
+            return position - src;
+    }
+#ifdef SAWYERCODING_SSE2
+    for (; position + 16 <= limit; position += 16)
+    {
+        const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+        const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position + 1));
+        const auto pairs = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(current, next)));
+        if (pairs != 0)
+        {
+            return (position - src) + bitscanforward(static_cast<int32_t>(pairs));
+        }
+    }
+#endif
+    for (; position < limit; position++)
+    {
+        if (position[0] == position[1])
+            break;
+    }
+    return position - src;
+}
+
 /**
  *
  *  rct2: 0x006762E1
@@ -109,17 +238,20 @@ size_t sawyercoding_decode_sc4(const uint8_t* src, uint8_t* dst, size_t length,
     size_t decodedLength = decode_chunk_rle_with_size(src, dst, length - 4, bufferLength);
 
     // Decode
-    for (size_t i = 0x60018; i <= std::min(decodedLength - 1, static_cast<size_t>(0x1F8353)); i++)
-        dst[i] = dst[i] ^ 0x9C;
+    decode_sc4_scramble(dst, 0, decodedLength);
 
-    for (size_t i = 0x60018; i <= std::min(decodedLength - 1, static_cast<size_t>(0x1F8350)); i += 4)
-    {
-        dst[i + 1] = Numerics::ror8(dst[i + 1], 3);
+    return decodedLength;
+}
 
-        uint32_t* code = reinterpret_cast<uint32_t*>(&dst[i]);
-        *code = Numerics::rol32(*code, 9);
-    }
+size_t sawyercoding_decode_sv4_range(const uint8_t* src, uint8_t* dst, size_t length, size_t offset, size_t bufferLength)
+{
+    return decode_chunk_rle_range(src, dst, length - 4, offset, bufferLength);
+}
 
+size_t sawyercoding_decode_sc4_range(const uint8_t* src, uint8_t* dst, size_t length, size_t offset, size_t bufferLength)
+{
+    size_t decodedLength = decode_chunk_rle_range(src, dst, length - 4, offset, bufferLength);
+    decode_sc4_scramble(dst, offset, decodedLength);
     return decodedLength;
 }
 
@@ -255,6 +387,79 @@ static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst
     return dst - dst_buffer;
 }
 
+/**
+ * Decodes an RLE chunk but only keeps the bytes from offset to offset + dstSize of the output, everything before
+ * that is skipped without being written.
+ * @returns the number of bytes written to dst_buffer.
+ */
+static size_t decode_chunk_rle_range(
+    const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length, size_t offset, size_t dstSize)
+{
+    size_t position = 0;
+    size_t written = 0;
+    const size_t end = offset + dstSize;
+    for (size_t i = 0; i < length && position < end; i++)
+    {
+        uint8_t rleCodeByte = src_buffer[i];
+        const uint8_t* run = nullptr;
+        size_t count;
+        if (rleCodeByte & 128)
+        {
+            i++;
+            if (i >= length)
+                break;
+            count = 257 - rleCodeByte;
+        }
+        else
+        {
+            count = rleCodeByte + 1;
+            if (i + count >= length)
+                break;
+            run = src_buffer + i + 1;
+            i += count;
+        }
+
+        // Copy the part of this run that overlaps the requested range
+        const size_t copyStart = std::max(position, offset);
+        const size_t copyEnd = std::min(position + count, end);
+        if (copyStart < copyEnd)
+        {
+            auto* dst = dst_buffer + (copyStart - offset);
+            if (run == nullptr)
+                std::fill_n(dst, copyEnd - copyStart, src_buffer[i]);
+            else
+                std::memcpy(dst, run + (copyStart - position), copyEnd - copyStart);
+            written = copyEnd - offset;
+        }
+        position += count;
+    }
+    return written;
+}
+
+/**
+ * Undoes the scrambling of SC4 files, dst holds length bytes of the decoded file starting at offset.
+ * The offset must be word aligned relative to the start of the scrambled area when it lies inside it.
+ */
+static void decode_sc4_scramble(uint8_t* dst, size_t offset, size_t length)
+{
+    constexpr size_t scrambleStart = 0x60018;
+    if (length == 0)
+        return;
+
+    const size_t start = std::max(offset, scrambleStart);
+    const size_t last = offset + length - 1;
+    for (size_t i = start; i <= std::min(last, static_cast<size_t>(0x1F8353)); i++)
+        dst[i - offset] = dst[i - offset] ^ 0x9C;
+
+    for (size_t i = start; i <= std::min(last, static_cast<size_t>(0x1F8350)); i += 4)
+    {
+        dst[i - offset + 1] = Numerics::ror8(dst[i - offset + 1], 3);
+
+        uint32_t* code = reinterpret_cast<uint32_t*>(&dst[i - offset]);
+        *code = Numerics::rol32(*code, 9);
+    }
+}
+
 #pragma endregion
 
 #pragma region Encoding
@@ -283,11 +488,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         if (*src == src[1])
         {
-            for (; (count < 125) && ((src + count) < end_src); count++)
-            {
-                if (*src != src[count])
-                    break;
-            }
+            count = static_cast<uint8_t>(count_repeated_bytes(src, std::min<size_t>(125, end_src - src)));
             *dst++ = 257 - count;
             *dst++ = *src;
             src += count;
@@ -296,8 +497,10 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         else
         {
-            count++;
-            src++;
+            // Skip straight to the next pair of equal bytes, stopping early when the literal run is full
+            auto unpaired = std::min<size_t>(count_unpaired_bytes(src, end_src - 1), 126 - count);
+            count += static_cast<uint8_t>(unpaired);
+            src += unpaired;
         }
     }
     if (src == end_src - 1)
@@ -329,10 +532,27 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
         size_t searchIndex = (i < 32) ? 0 : (i - 32);
         size_t searchEnd = i - 1;
 
+        // Only positions starting with the same byte can give a repeat, find them all at once when the whole window
+        // is available
+        uint32_t candidates = ~0u;
+#ifdef SAWYERCODING_SSE2
+        if (i >= 32)
+        {
+            const __m128i needle = _mm_set1_epi8(static_cast<char>(src_buffer[i]));
+            const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_buffer + searchIndex));
+            const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_buffer + searchIndex + 16));
+            candidates = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(low, needle)))
+                | (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(high, needle))) << 16);
+        }
+#endif
+
         size_t bestRepeatIndex = 0;
         size_t bestRepeatCount = 0;
         for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
         {
+            if (!(candidates & (1u << (repeatIndex - searchIndex))) || src_buffer[repeatIndex] != src_buffer[i])
+                continue;
+
             size_t repeatCount = 0;
             size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
             // maxRepeatCount should not exceed length
@@ -380,13 +600,7 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
 
 static void encode_chunk_rotate(uint8_t* buffer, size_t length)
 {
-    size_t i;
-    uint8_t code = 1;
-    for (i = 0; i < length; i++)
-    {
-        buffer[i] = Numerics::rol8(buffer[i], code);
-        code = (code + 2) % 8;
-    }
+    rotate_bytes_left(buffer, buffer, length, RotateEncodeAmounts);
 }
 
 #pragma endregion
@@ -114,4 +114,5 @@ enum
     INTENT_ACTION_TRACK_DESIGN_REMOVE_PROVISIONAL,
     INTENT_ACTION_TRACK_DESIGN_RESTORE_PROVISIONAL,
     INTENT_ACTION_SET_MAP_TOOLTIP,
+    INTENT_ACTION_UPDATE_GUEST_LIST_ENTRY,
 };
@@ -23,10 +23,12 @@
 #include "../ride/TrackData.h"
 #include "../util/Math.hpp"
 #include "../world/Banner.h"
+#include "../world/Map.h"
 #include "../world/Scenery.h"
 #include "Intent.h"
 
 #include <iterator>
+#include <optional>
 #include <tuple>
 
 using namespace OpenRCT2::TrackMetaData;
@@ -40,6 +42,9 @@ RideConstructionState _rideConstructionState2;
 bool _stationConstructed;
 bool _deferClose;
 
+// The construction window asks for the same piece every update while it is blocked, only try again once the map changed.
+static std::optional<ProvisionalTrackPlacement> _lastFailedProvisionalPiece;
+
 /**
  *
  *  rct2: 0x006CA162
@@ -53,13 +58,26 @@ money32 place_provisional_track_piece(
         return MONEY32_UNDEFINED;
 
     ride_construction_remove_ghosts();
+
+    ProvisionalTrackPlacement placement{
+        rideIndex, trackType, trackDirection, liftHillAndAlternativeState, trackPos, MapGetRevision(),
+    };
+    if (_lastFailedProvisionalPiece == placement)
+        return MONEY32_UNDEFINED;
+
+    auto placementFailed = [&placement]() {
+        placement.MapRevision = MapGetRevision();
+        _lastFailedProvisionalPiece = placement;
+        return MONEY32_UNDEFINED;
+    };
+
     if (ride->type == RIDE_TYPE_MAZE)
     {
         int32_t flags = GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND
             | GAME_COMMAND_FLAG_GHOST; // 105
         auto result = maze_set_track(CoordsXYZD{ trackPos, 0 }, flags, true, rideIndex, GC_SET_MAZE_TRACK_BUILD);
         if (result == MONEY32_UNDEFINED)
-            return result;
+            return placementFailed();
 
         _unkF440C5 = { trackPos, static_cast<Direction>(trackDirection) };
         _currentTrackSelectionFlags |= TRACK_SELECTION_FLAG_TRACK;
@@ -86,7 +104,7 @@ money32 place_provisional_track_piece(
     // This command must not be sent over the network
     auto res = GameActions::Execute(&trackPlaceAction);
     if (res.Error != GameActions::Status::Ok)
-        return MONEY32_UNDEFINED;
+        return placementFailed();
 
     int16_t z_begin, z_end;
     const auto& ted = GetTrackElementDescriptor(trackType);
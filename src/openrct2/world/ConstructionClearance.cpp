@@ -19,6 +19,10 @@
 #include "SmallScenery.h"
 #include "Surface.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 static int32_t map_place_clear_func(
     TileElement** tile_element, const CoordsXY& coords, uint8_t flags, money32* price, bool is_scenery)
 {
@@ -105,6 +109,209 @@ static bool MapLoc68BABCShouldContinue(
     return false;
 }
 
+/**
+ * Checks whether the surface of a tile allows construction of pos.
+ * @return True if construction may continue, otherwise res holds the error.
+ */
+static bool MapCheckSurfaceClearance(
+    TileElement** tileElementPtr, const CoordsXYRangedZ& pos, CLEAR_FUNC clearFunc, QuarterTile quarterTile, uint8_t flags,
+    uint8_t crossingMode, bool isTree, uint8_t& groundFlags, bool& canBuildCrossing, GameActions::Result& res)
+{
+    auto* tileElement = *tileElementPtr;
+    const auto waterHeight = tileElement->AsSurface()->GetWaterHeight();
+    if (waterHeight && waterHeight > pos.baseZ && tileElement->GetBaseZ() < pos.clearanceZ)
+    {
+        groundFlags |= ELEMENT_IS_UNDERWATER;
+        if (waterHeight < pos.clearanceZ)
+        {
+            if (clearFunc != nullptr && clearFunc(tileElementPtr, pos, flags, &res.Cost))
+            {
+                res.Error = GameActions::Status::NoClearance;
+                res.ErrorMessage = STR_CANNOT_BUILD_PARTLY_ABOVE_AND_PARTLY_BELOW_WATER;
+                return false;
+            }
+        }
+    }
+
+    if (gParkFlags & PARK_FLAGS_FORBID_HIGH_CONSTRUCTION && !isTree)
+    {
+        const auto heightFromGround = pos.clearanceZ - tileElement->GetBaseZ();
+
+        if (heightFromGround > (18 * COORDS_Z_STEP))
+        {
+            res.Error = GameActions::Status::Disallowed;
+            res.ErrorMessage = STR_LOCAL_AUTHORITY_WONT_ALLOW_CONSTRUCTION_ABOVE_TREE_HEIGHT;
+            return false;
+        }
+    }
+
+    // Only allow building crossings directly on a flat surface tile.
+    if (tileElement->GetType() == TileElementType::Surface
+        && (tileElement->AsSurface()->GetSlope()) == TILE_ELEMENT_SLOPE_FLAT && tileElement->GetBaseZ() == pos.baseZ)
+    {
+        canBuildCrossing = true;
+    }
+
+    if (quarterTile.GetZQuarterOccupied() != 0b1111)
+    {
+        if (tileElement->GetBaseZ() >= pos.clearanceZ)
+        {
+            // loc_68BA81
+            groundFlags |= ELEMENT_IS_UNDERGROUND;
+            groundFlags &= ~ELEMENT_IS_ABOVE_GROUND;
+        }
+        else
+        {
+            auto northZ = tileElement->GetBaseZ();
+            auto eastZ = northZ;
+            auto southZ = northZ;
+            auto westZ = northZ;
+            const auto slope = tileElement->AsSurface()->GetSlope();
+            if (slope & TILE_ELEMENT_SLOPE_N_CORNER_UP)
+            {
+                northZ += LAND_HEIGHT_STEP;
+                if (slope == (TILE_ELEMENT_SLOPE_S_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
+                    northZ += LAND_HEIGHT_STEP;
+            }
+            if (slope & TILE_ELEMENT_SLOPE_E_CORNER_UP)
+            {
+                eastZ += LAND_HEIGHT_STEP;
+                if (slope == (TILE_ELEMENT_SLOPE_W_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
+                    eastZ += LAND_HEIGHT_STEP;
+            }
+            if (slope & TILE_ELEMENT_SLOPE_S_CORNER_UP)
+            {
+                southZ += LAND_HEIGHT_STEP;
+                if (slope == (TILE_ELEMENT_SLOPE_N_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
+                    southZ += LAND_HEIGHT_STEP;
+            }
+            if (slope & TILE_ELEMENT_SLOPE_W_CORNER_UP)
+            {
+                westZ += LAND_HEIGHT_STEP;
+                if (slope == (TILE_ELEMENT_SLOPE_E_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
+                    westZ += LAND_HEIGHT_STEP;
+            }
+            const auto baseHeight = pos.baseZ + (4 * COORDS_Z_STEP);
+            const auto baseQuarter = quarterTile.GetBaseQuarterOccupied();
+            const auto zQuarter = quarterTile.GetZQuarterOccupied();
+            if ((!(baseQuarter & 0b0001) || ((zQuarter & 0b0001 || pos.baseZ >= northZ) && baseHeight >= northZ))
+                && (!(baseQuarter & 0b0010) || ((zQuarter & 0b0010 || pos.baseZ >= eastZ) && baseHeight >= eastZ))
+                && (!(baseQuarter & 0b0100) || ((zQuarter & 0b0100 || pos.baseZ >= southZ) && baseHeight >= southZ))
+                && (!(baseQuarter & 0b1000) || ((zQuarter & 0b1000 || pos.baseZ >= westZ) && baseHeight >= westZ)))
+            {
+                return true;
+            }
+
+            if (MapLoc68BABCShouldContinue(tileElementPtr, pos, clearFunc, flags, res.Cost, crossingMode, canBuildCrossing))
+            {
+                return true;
+            }
+
+            map_obstruction_set_error_text(*tileElementPtr, res);
+            res.Error = GameActions::Status::NoClearance;
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace
+{
+    struct ClearanceEntry
+    {
+        int32_t BaseZ;
+        int32_t ClearanceZ;
+        uint8_t OccupiedQuadrants;
+    };
+
+    /**
+     * Height index of a single tile, the non-surface elements that can obstruct construction sorted by base height
+     * with the running maximum of their clearance height, so a query can rule out any obstruction with a binary search.
+     */
+    struct TileClearance
+    {
+        std::vector<ClearanceEntry> Entries;
+        std::vector<int32_t> MaxClearanceZ;
+        std::vector<TileElement*> Surfaces;
+
+        bool MayObstruct(const CoordsXYRangedZ& pos, uint8_t quadrants) const
+        {
+            auto end = std::lower_bound(
+                Entries.begin(), Entries.end(), pos.clearanceZ,
+                [](const ClearanceEntry& entry, int32_t z) { return entry.BaseZ < z; });
+            auto count = static_cast<size_t>(end - Entries.begin());
+            if (count == 0 || MaxClearanceZ[count - 1] <= pos.baseZ)
+            {
+                return false;
+            }
+            return std::any_of(Entries.begin(), end, [&pos, quadrants](const ClearanceEntry& entry) {
+                return entry.ClearanceZ > pos.baseZ && (entry.OccupiedQuadrants & quadrants);
+            });
+        }
+    };
+} // namespace
+
+static int32_t _clearanceQueryScopeDepth;
+static std::unordered_map<uint32_t, TileClearance> _clearanceCache;
+
+static const TileClearance& GetTileClearance(const CoordsXY& loc, TileElement* firstElement)
+{
+    const auto tileLoc = TileCoordsXY{ loc };
+    const auto key = static_cast<uint32_t>(tileLoc.x + tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL);
+    auto it = _clearanceCache.find(key);
+    if (it != _clearanceCache.end())
+    {
+        return it->second;
+    }
+
+    TileClearance tileClearance;
+    auto* tileElement = firstElement;
+    do
+    {
+        if (tileElement->GetType() == TileElementType::Surface)
+        {
+            tileClearance.Surfaces.push_back(tileElement);
+        }
+        else if (!tileElement->IsGhost())
+        {
+            tileClearance.Entries.push_back(
+                { tileElement->GetBaseZ(), tileElement->GetClearanceZ(), tileElement->GetOccupiedQuadrants() });
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    std::sort(tileClearance.Entries.begin(), tileClearance.Entries.end(), [](const auto& a, const auto& b) {
+        return a.BaseZ < b.BaseZ;
+    });
+    int32_t maxClearanceZ = 0;
+    for (const auto& entry : tileClearance.Entries)
+    {
+        maxClearanceZ = std::max(maxClearanceZ, entry.ClearanceZ);
+        tileClearance.MaxClearanceZ.push_back(maxClearanceZ);
+    }
+    return _clearanceCache.emplace(key, std::move(tileClearance)).first->second;
+}
+
+ConstructionClearanceQueryScope::ConstructionClearanceQueryScope()
+{
+    _clearanceQueryScopeDepth++;
+}
+
+ConstructionClearanceQueryScope::~ConstructionClearanceQueryScope()
+{
+    if (--_clearanceQueryScopeDepth == 0)
+    {
+        _clearanceCache.clear();
+    }
+}
+
+void ConstructionClearanceInvalidateCache()
+{
+    if (!_clearanceCache.empty())
+    {
+        _clearanceCache.clear();
+    }
+}
+
 /**
  *
  *  rct2: 0x0068B932
@@ -145,6 +352,31 @@ GameActions::Result MapCanConstructWithClearAt(
         return res;
     }
 
+    // Queries can not remove anything, if no element is in the way only the surfaces need to be checked.
+    if (flags & GAME_COMMAND_FLAG_APPLY)
+    {
+        // The caller is about to change the tile, possibly without inserting or removing elements.
+        ConstructionClearanceInvalidateCache();
+    }
+    else if (_clearanceQueryScopeDepth > 0)
+    {
+        const auto& tileClearance = GetTileClearance(pos, tileElement);
+        if (!tileClearance.MayObstruct(pos, quarterTile.GetBaseQuarterOccupied()))
+        {
+            for (auto* surfaceElement : tileClearance.Surfaces)
+            {
+                if (!MapCheckSurfaceClearance(
+                        &surfaceElement, pos, clearFunc, quarterTile, flags, crossingMode, isTree, groundFlags,
+                        canBuildCrossing, res))
+                {
+                    return res;
+                }
+            }
+            res.SetData(ConstructClearResult{ groundFlags });
+            return res;
+        }
+    }
+
     do
     {
         if (tileElement->GetType() != TileElementType::Surface)
@@ -168,99 +400,10 @@ GameActions::Result MapCanConstructWithClearAt(
             continue;
         }
 
-        const auto waterHeight = tileElement->AsSurface()->GetWaterHeight();
-        if (waterHeight && waterHeight > pos.baseZ && tileElement->GetBaseZ() < pos.clearanceZ)
+        if (!MapCheckSurfaceClearance(
+                &tileElement, pos, clearFunc, quarterTile, flags, crossingMode, isTree, groundFlags, canBuildCrossing, res))
         {
-            groundFlags |= ELEMENT_IS_UNDERWATER;
-            if (waterHeight < pos.clearanceZ)
-            {
-                if (clearFunc != nullptr && clearFunc(&tileElement, pos, flags, &res.Cost))
-                {
-                    res.Error = GameActions::Status::NoClearance;
-                    res.ErrorMessage = STR_CANNOT_BUILD_PARTLY_ABOVE_AND_PARTLY_BELOW_WATER;
-                    return res;
-                }
-            }
-        }
-
-        if (gParkFlags & PARK_FLAGS_FORBID_HIGH_CONSTRUCTION && !isTree)
-        {
-            const auto heightFromGround = pos.clearanceZ - tileElement->GetBaseZ();
-
-            if (heightFromGround > (18 * COORDS_Z_STEP))
-            {
-                res.Error = GameActions::Status::Disallowed;
-                res.ErrorMessage = STR_LOCAL_AUTHORITY_WONT_ALLOW_CONSTRUCTION_ABOVE_TREE_HEIGHT;
-                return res;
-            }
-        }
-
-        // Only allow building crossings directly on a flat surface tile.
-        if (tileElement->GetType() == TileElementType::Surface
-            && (tileElement->AsSurface()->GetSlope()) == TILE_ELEMENT_SLOPE_FLAT && tileElement->GetBaseZ() == pos.baseZ)
-        {
-            canBuildCrossing = true;
-        }
-
-        if (quarterTile.GetZQuarterOccupied() != 0b1111)
-        {
-            if (tileElement->GetBaseZ() >= pos.clearanceZ)
-            {
-                // loc_68BA81
-                groundFlags |= ELEMENT_IS_UNDERGROUND;
-                groundFlags &= ~ELEMENT_IS_ABOVE_GROUND;
-            }
-            else
-            {
-                auto northZ = tileElement->GetBaseZ();
-                auto eastZ = northZ;
-                auto southZ = northZ;
-                auto westZ = northZ;
-                const auto slope = tileElement->AsSurface()->GetSlope();
-                if (slope & TILE_ELEMENT_SLOPE_N_CORNER_UP)
-                {
-                    northZ += LAND_HEIGHT_STEP;
-                    if (slope == (TILE_ELEMENT_SLOPE_S_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
-                        northZ += LAND_HEIGHT_STEP;
-                }
-                if (slope & TILE_ELEMENT_SLOPE_E_CORNER_UP)
-                {
-                    eastZ += LAND_HEIGHT_STEP;
-                    if (slope == (TILE_ELEMENT_SLOPE_W_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
-                        eastZ += LAND_HEIGHT_STEP;
-                }
-                if (slope & TILE_ELEMENT_SLOPE_S_CORNER_UP)
-                {
-                    southZ += LAND_HEIGHT_STEP;
-                    if (slope == (TILE_ELEMENT_SLOPE_N_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
-                        southZ += LAND_HEIGHT_STEP;
-                }
-                if (slope & TILE_ELEMENT_SLOPE_W_CORNER_UP)
-                {
-                    westZ += LAND_HEIGHT_STEP;
-                    if (slope == (TILE_ELEMENT_SLOPE_E_CORNER_DN | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT))
-                        westZ += LAND_HEIGHT_STEP;
-                }
-                const auto baseHeight = pos.baseZ + (4 * COORDS_Z_STEP);
-                const auto baseQuarter = quarterTile.GetBaseQuarterOccupied();
-                const auto zQuarter = quarterTile.GetZQuarterOccupied();
-                if ((!(baseQuarter & 0b0001) || ((zQuarter & 0b0001 || pos.baseZ >= northZ) && baseHeight >= northZ))
-                    && (!(baseQuarter & 0b0010) || ((zQuarter & 0b0010 || pos.baseZ >= eastZ) && baseHeight >= eastZ))
-                    && (!(baseQuarter & 0b0100) || ((zQuarter & 0b0100 || pos.baseZ >= southZ) && baseHeight >= southZ))
-                    && (!(baseQuarter & 0b1000) || ((zQuarter & 0b1000 || pos.baseZ >= westZ) && baseHeight >= westZ)))
-                {
-                    continue;
-                }
-
-                if (MapLoc68BABCShouldContinue(&tileElement, pos, clearFunc, flags, res.Cost, crossingMode, canBuildCrossing))
-                {
-                    continue;
-                }
-
-                map_obstruction_set_error_text(tileElement, res);
-                res.Error = GameActions::Status::NoClearance;
-                return res;
-            }
+            return res;
         }
     } while (!(tileElement++)->IsLastForTile());
 
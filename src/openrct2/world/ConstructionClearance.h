@@ -37,3 +37,20 @@ struct ConstructClearResult
 [[nodiscard]] GameActions::Result MapCanConstructAt(const CoordsXYRangedZ& pos, QuarterTile bl);
 
 void map_obstruction_set_error_text(TileElement* tileElement, GameActions::Result& res);
+
+/**
+ * While a scope is alive, clearance checks that do not apply any changes cache a height index per tile so repeated
+ * queries over the same tiles, such as trying a track design at several heights, do not walk every element again.
+ * Elements must only be added or removed with tile_element_insert and tile_element_remove while a scope is alive.
+ */
+class ConstructionClearanceQueryScope
+{
+public:
+    ConstructionClearanceQueryScope();
+    ~ConstructionClearanceQueryScope();
+
+    ConstructionClearanceQueryScope(const ConstructionClearanceQueryScope&) = delete;
+    ConstructionClearanceQueryScope& operator=(const ConstructionClearanceQueryScope&) = delete;
+};
+
+void ConstructionClearanceInvalidateCache();
@@ -37,9 +37,12 @@
 #include "Park.h"
 #include "Scenery.h"
 #include "Surface.h"
+#include "TileElementsView.h"
 
 #include <algorithm>
 #include <iterator>
+#include <unordered_set>
+#include <vector>
 
 using namespace OpenRCT2::TrackMetaData;
 void footpath_update_queue_entrance_banner(const CoordsXY& footpathPos, TileElement* tileElement);
@@ -54,6 +57,16 @@ uint8_t gFootpathGroundFlags;
 static ride_id_t* _footpathQueueChainNext;
 static ride_id_t _footpathQueueChain[64];
 
+struct FootpathPendingConnection
+{
+    CoordsXYZ Position;
+    int32_t Flags;
+};
+
+static int32_t _footpathConnectionBatchDepth;
+static std::vector<FootpathPendingConnection> _footpathPendingConnections;
+static std::unordered_set<uint64_t> _footpathPendingConnectionKeys;
+
 // This is the coordinates that a user of the bin should move to
 // rct2: 0x00992A4C
 const CoordsXY BinUseOffsets[4] = {
@@ -402,7 +415,8 @@ CoordsXY footpath_bridge_get_info_from_pos(const ScreenCoordsXY& screenCoords, i
  */
 void footpath_remove_litter(const CoordsXYZ& footpathPos)
 {
-    std::vector<Litter*> removals;
+    static std::vector<Litter*> removals;
+    removals.clear();
     for (auto litter : EntityTileList<Litter>(footpathPos))
     {
         int32_t distanceZ = abs(litter->z - footpathPos.z);
@@ -593,22 +607,12 @@ struct rct_neighbour_list
     size_t count;
 };
 
-static int32_t rct_neighbour_compare(const void* a, const void* b)
+static bool rct_neighbour_compare(const rct_neighbour& a, const rct_neighbour& b)
 {
-    uint8_t va = (static_cast<const rct_neighbour*>(a))->order;
-    uint8_t vb = (static_cast<const rct_neighbour*>(b))->order;
-    if (va < vb)
-        return 1;
-    if (va > vb)
-        return -1;
-
-    uint8_t da = (static_cast<const rct_neighbour*>(a))->direction;
-    uint8_t db = (static_cast<const rct_neighbour*>(b))->direction;
-    if (da < db)
-        return -1;
-    if (da > db)
-        return 1;
-    return 0;
+    // Highest order first, there is at most one neighbour per direction
+    if (a.order != b.order)
+        return a.order > b.order;
+    return a.direction < b.direction;
 }
 
 static void neighbour_list_init(rct_neighbour_list* neighbourList)
@@ -652,7 +656,7 @@ static void neighbour_list_remove(rct_neighbour_list* neighbourList, size_t inde
 
 static void neighbour_list_sort(rct_neighbour_list* neighbourList)
 {
-    qsort(neighbourList->items, neighbourList->count, sizeof(rct_neighbour), rct_neighbour_compare);
+    std::sort(neighbourList->items, neighbourList->items + neighbourList->count, rct_neighbour_compare);
 }
 
 static TileElement* footpath_get_element(const CoordsXYRangedZ& footpathPos, int32_t direction)
@@ -1015,16 +1019,37 @@ static void loc_6A6C85(
     loc_6A6D7E(pos, direction, tileElementPos.element, flags, query, neighbourList);
 }
 
+static void footpath_connect_edges_of_element(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags);
+
 /**
  *
  *  rct2: 0x006A6C66
  */
 void footpath_connect_edges(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags)
+{
+    if (_footpathConnectionBatchDepth > 0 && tileElement->GetType() == TileElementType::Path)
+    {
+        // Elements may move until the batch ends, the path is found again by its position.
+        auto position = CoordsXYZ{ footpathPos, tileElement->GetBaseZ() };
+        auto key = (static_cast<uint64_t>(position.x) << 40) | (static_cast<uint64_t>(position.y) << 16)
+            | static_cast<uint16_t>(position.z);
+        if (_footpathPendingConnectionKeys.insert(key).second)
+        {
+            _footpathPendingConnections.push_back({ position, flags });
+        }
+        return;
+    }
+
+    footpath_update_queue_chains();
+    footpath_connect_edges_of_element(footpathPos, tileElement, flags);
+}
+
+static void footpath_connect_edges_of_element(const CoordsXY& footpathPos, TileElement* tileElement, int32_t flags)
 {
     rct_neighbour_list neighbourList;
     rct_neighbour neighbour;
 
-    footpath_update_queue_chains();
+    footpath_mark_wide_flags_dirty(footpathPos);
 
     neighbour_list_init(&neighbourList);
 
@@ -1214,6 +1239,10 @@ void footpath_queue_chain_push(ride_id_t rideIndex)
 {
     if (rideIndex != RIDE_ID_NULL)
     {
+        // Chaining a queue walks all of it, every ride only needs to be chained once.
+        if (std::find(_footpathQueueChain, _footpathQueueChainNext, rideIndex) != _footpathQueueChainNext)
+            return;
+
         auto* lastSlot = _footpathQueueChain + std::size(_footpathQueueChain) - 1;
         if (_footpathQueueChainNext <= lastSlot)
         {
@@ -1222,6 +1251,35 @@ void footpath_queue_chain_push(ride_id_t rideIndex)
     }
 }
 
+FootpathConnectionBatch::FootpathConnectionBatch()
+{
+    _footpathConnectionBatchDepth++;
+}
+
+FootpathConnectionBatch::~FootpathConnectionBatch()
+{
+    if (--_footpathConnectionBatchDepth > 0)
+        return;
+
+    auto pendingConnections = std::move(_footpathPendingConnections);
+    _footpathPendingConnections.clear();
+    _footpathPendingConnectionKeys.clear();
+    if (pendingConnections.empty())
+        return;
+
+    footpath_queue_chain_reset();
+    for (const auto& pending : pendingConnections)
+    {
+        // The path may have been removed again within the batch.
+        auto* tileElement = map_get_footpath_element(pending.Position);
+        if (tileElement != nullptr)
+        {
+            footpath_connect_edges_of_element(pending.Position, tileElement, pending.Flags);
+        }
+    }
+    footpath_update_queue_chains();
+}
+
 /**
  *
  *  rct2: 0x006A759F
@@ -1833,6 +1891,101 @@ static TileElement* footpath_can_be_wide(const CoordsXYZ& footpathPos)
     return nullptr;
 }
 
+// Wide flags of paths are only recalculated for tiles around footpath changes, see footpath_mark_wide_flags_dirty.
+static constexpr int32_t MaxWideFlagUpdateRounds = 4;
+static std::vector<bool> _wideFlagsDirtyTiles;
+static std::vector<TileCoordsXY> _wideFlagsDirtyList;
+
+static void footpath_mark_tiles_wide_flags_dirty(const TileCoordsXY& centre, int32_t radius)
+{
+    if (_wideFlagsDirtyTiles.empty())
+    {
+        _wideFlagsDirtyTiles.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+    }
+
+    for (int32_t y = centre.y - radius; y <= centre.y + radius; y++)
+    {
+        for (int32_t x = centre.x - radius; x <= centre.x + radius; x++)
+        {
+            if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                continue;
+
+            const auto index = y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+            if (!_wideFlagsDirtyTiles[index])
+            {
+                _wideFlagsDirtyTiles[index] = true;
+                _wideFlagsDirtyList.push_back({ x, y });
+            }
+        }
+    }
+}
+
+/**
+ * Marks the wide flags around the given tile for recalculation on the next update. The wide flag of a tile depends on
+ * the edges of its neighbours, so changing the edges of a tile and its neighbours affects every tile within two tiles.
+ */
+void footpath_mark_wide_flags_dirty(const CoordsXY& footpathPos)
+{
+    footpath_mark_tiles_wide_flags_dirty(TileCoordsXY{ footpathPos }, 2);
+}
+
+bool footpath_has_dirty_wide_flags()
+{
+    return !_wideFlagsDirtyList.empty();
+}
+
+static uint32_t footpath_get_wide_mask(const CoordsXY& footpathPos)
+{
+    uint32_t mask = 0;
+    uint32_t bit = 1;
+    for (auto* pathElement : OpenRCT2::TileElementsView<PathElement>(footpathPos))
+    {
+        if (pathElement->IsWide())
+            mask |= bit;
+        bit <<= 1;
+    }
+    return mask;
+}
+
+/**
+ * Recalculates the wide flags of all tiles marked dirty, in the same order the full map sweep used to visit them.
+ * Tiles whose flags change mark their neighbours for another round. The list is always emptied so no pending state is
+ * carried over to the next tick.
+ */
+void footpath_update_dirty_wide_flags()
+{
+    static std::vector<TileCoordsXY> tiles;
+    for (int32_t round = 0; round < MaxWideFlagUpdateRounds && !_wideFlagsDirtyList.empty(); round++)
+    {
+        tiles.clear();
+        std::swap(tiles, _wideFlagsDirtyList);
+        for (const auto& tile : tiles)
+        {
+            _wideFlagsDirtyTiles[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x] = false;
+        }
+        std::sort(tiles.begin(), tiles.end(), [](const TileCoordsXY& a, const TileCoordsXY& b) {
+            return a.y != b.y ? a.y < b.y : a.x < b.x;
+        });
+
+        for (const auto& tile : tiles)
+        {
+            const auto footpathPos = tile.ToCoordsXY();
+            const auto before = footpath_get_wide_mask(footpathPos);
+            footpath_update_path_wide_flags(footpathPos);
+            if (footpath_get_wide_mask(footpathPos) != before)
+            {
+                footpath_mark_tiles_wide_flags_dirty(tile, 1);
+            }
+        }
+    }
+
+    for (const auto& tile : _wideFlagsDirtyList)
+    {
+        _wideFlagsDirtyTiles[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x] = false;
+    }
+    _wideFlagsDirtyList.clear();
+}
+
 /**
  *
  *  rct2: 0x006A87BB
@@ -2301,6 +2454,7 @@ void footpath_remove_edges_at(const CoordsXY& footpathPos, TileElement* tileElem
     }
 
     footpath_update_queue_entrance_banner(footpathPos, tileElement);
+    footpath_mark_wide_flags_dirty(footpathPos);
 
     bool fixCorners = false;
     for (uint8_t direction = 0; direction < 4; direction++)
@@ -247,6 +247,9 @@ bool fence_in_the_way(const CoordsXYRangedZ& fencePos, int32_t direction);
 void footpath_chain_ride_queue(
     ride_id_t rideIndex, int32_t entranceIndex, const CoordsXY& footpathPos, TileElement* tileElement, int32_t direction);
 void footpath_update_path_wide_flags(const CoordsXY& footpathPos);
+void footpath_mark_wide_flags_dirty(const CoordsXY& footpathPos);
+bool footpath_has_dirty_wide_flags();
+void footpath_update_dirty_wide_flags();
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position);
 
 int32_t footpath_is_connected_to_map_edge(const CoordsXYZ& footpathPos, int32_t direction, int32_t flags);
@@ -258,3 +261,17 @@ const FootpathRailingsObject* GetPathRailingsEntry(ObjectEntryIndex entryIndex);
 
 void footpath_queue_chain_reset();
 void footpath_queue_chain_push(ride_id_t rideIndex);
+
+/**
+ * Defers connecting the edges of path elements while a batch of them is placed. Every path is connected once when the
+ * outermost batch ends, in the order it was first placed, and the queues of the rides it touched are chained once.
+ * Entrances and track are still connected right away.
+ */
+class FootpathConnectionBatch
+{
+public:
+    FootpathConnectionBatch();
+    FootpathConnectionBatch(const FootpathConnectionBatch&) = delete;
+    FootpathConnectionBatch& operator=(const FootpathConnectionBatch&) = delete;
+    ~FootpathConnectionBatch();
+};
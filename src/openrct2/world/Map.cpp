@@ -21,12 +21,16 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.h"
+#include "../core/MemoryAccounting.h"
 #include "../interface/Cursors.h"
 #include "../interface/Window.h"
+#include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
 #include "../network/network.h"
+#include "../peep/GuestPathfinding.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
 #include "../ride/RideConstruction.h"
@@ -37,12 +41,13 @@
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
-#include "../world/TilePointerIndex.hpp"
 #include "Banner.h"
 #include "Climate.h"
+#include "ConstructionClearance.h"
 #include "Footpath.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
+#include "MapOwnership.h"
 #include "Park.h"
 #include "Scenery.h"
 #include "SmallScenery.h"
@@ -50,8 +55,10 @@
 #include "TileElementsView.h"
 #include "TileInspector.h"
 #include "Wall.h"
+#include "WorldState.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <memory>
 
@@ -106,43 +113,67 @@ uint32_t gLandRemainingConstructionSales;
 
 bool gMapLandRightsUpdateSuccess;
 
-static TilePointerIndex<TileElement> _tileIndex;
-static std::vector<TileElement> _tileElements;
-static TilePointerIndex<TileElement> _tileIndexStash;
-static std::vector<TileElement> _tileElementsStash;
-static size_t _tileElementsInUse;
-static size_t _tileElementsInUseStash;
-static int32_t _mapSizeStash;
-static int32_t _currentRotationStash;
+static uint32_t _mapRevision = 0;
+
+static MemoryAccounting::Registration _tileElementsMemory("tileElements", [] {
+    const auto& worldState = GetWorldState();
+    return worldState.Tiles.GetMemoryUsage() + worldState.TilesStash.GetMemoryUsage();
+});
 
 void StashMap()
 {
-    _tileIndexStash = std::move(_tileIndex);
-    _tileElementsStash = std::move(_tileElements);
-    _mapSizeStash = gMapSize;
-    _currentRotationStash = gCurrentRotation;
-    _tileElementsInUseStash = _tileElementsInUse;
+    auto& worldState = GetWorldState();
+    worldState.TilesStash = std::move(worldState.Tiles);
+    worldState.MapSizeStash = gMapSize;
+    worldState.CurrentRotationStash = gCurrentRotation;
+    MapOwnershipChanged();
+    MapChanged();
 }
 
 void UnstashMap()
 {
-    _tileIndex = std::move(_tileIndexStash);
-    _tileElements = std::move(_tileElementsStash);
-    gMapSize = _mapSizeStash;
-    gCurrentRotation = _currentRotationStash;
-    _tileElementsInUse = _tileElementsInUseStash;
+    auto& worldState = GetWorldState();
+    worldState.Tiles = std::move(worldState.TilesStash);
+    gMapSize = worldState.MapSizeStash;
+    gCurrentRotation = worldState.CurrentRotationStash;
+    MapOwnershipChanged();
+    MapChanged();
+}
+
+uint32_t MapGetRevision()
+{
+    return _mapRevision;
 }
 
-const std::vector<TileElement>& GetTileElements()
+void MapChanged()
 {
-    return _tileElements;
+    _mapRevision++;
 }
 
-void SetTileElements(std::vector<TileElement>&& tileElements)
+const TileElementVector& GetTileElements()
 {
-    _tileElements = std::move(tileElements);
-    _tileIndex = TilePointerIndex<TileElement>(MAXIMUM_MAP_SIZE_TECHNICAL, _tileElements.data(), _tileElements.size());
-    _tileElementsInUse = _tileElements.size();
+    return GetWorldState().Tiles.Elements;
+}
+
+void SetTileElements(TileElementVector&& tileElements)
+{
+    auto& tiles = GetWorldState().Tiles;
+    tiles.Elements = std::move(tileElements);
+    tiles.Free.assign(tiles.Elements.size(), false);
+    tiles.Index = TilePointerIndex<TileElement>(MAXIMUM_MAP_SIZE_TECHNICAL, tiles.Elements.data(), tiles.Elements.size());
+    tiles.Summaries = TileSummaryIndex(MAXIMUM_MAP_SIZE_TECHNICAL);
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            tiles.Summaries.Update({ x, y }, tiles.Index.GetFirstElementAt({ x, y }));
+        }
+    }
+    tiles.ElementsInUse = tiles.Elements.size();
+    GuestFlowFieldInvalidate();
+    ViewportInteractionInvalidate();
+    MapOwnershipChanged();
+    MapChanged();
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -162,41 +193,117 @@ static TileElement GetDefaultSurfaceElement()
     return el;
 }
 
-std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts()
+/**
+ * Returns the number of elements at the start of a tile run up to and including the last element of the tile.
+ * Sets hasGhosts if any of them is a ghost.
+ */
+static size_t GetTileElementRunLength(const TileElement* element, bool& hasGhosts)
 {
-    std::vector<TileElement> newElements;
-    newElements.reserve(std::max(MIN_TILE_ELEMENTS, _tileElements.size()));
+    const auto* first = element;
+    hasGhosts = false;
+    do
+    {
+        hasGhosts |= element->IsGhost();
+    } while (!(element++)->IsLastForTile());
+    return element - first;
+}
+
+size_t CountTileElementsWithoutGhosts()
+{
+    size_t count = 0;
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
         for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
         {
-            auto oldSize = newElements.size();
-
-            // Add all non-ghost elements
-            const auto* element = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            const auto* element = map_get_first_element_at(TileCoordsXY{ x, y });
+            size_t tileCount = 0;
             if (element != nullptr)
             {
                 do
                 {
                     if (!element->IsGhost())
                     {
-                        newElements.push_back(*element);
+                        tileCount++;
                     }
                 } while (!(element++)->IsLastForTile());
             }
+            // Tiles without any elements get a default surface
+            count += std::max<size_t>(tileCount, 1);
+        }
+    }
+    return count;
+}
+
+void VisitTileElementsWithoutGhosts(const std::function<void(const TileElement* elements, size_t count)>& fn)
+{
+    static const TileElement defaultSurface = GetDefaultSurfaceElement();
+    std::vector<TileElement> scratch;
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            const auto* element = map_get_first_element_at(TileCoordsXY{ x, y });
+            if (element == nullptr)
+            {
+                fn(&defaultSurface, 1);
+                continue;
+            }
 
-            // Insert default surface element if no elements were added
-            auto newSize = newElements.size();
-            if (oldSize == newSize)
+            bool hasGhosts;
+            auto runLength = GetTileElementRunLength(element, hasGhosts);
+            if (!hasGhosts)
             {
-                newElements.push_back(GetDefaultSurfaceElement());
+                // Common case, the run can be passed on as it is stored
+                fn(element, runLength);
+                continue;
+            }
+
+            scratch.clear();
+            for (size_t i = 0; i < runLength; i++)
+            {
+                if (!element[i].IsGhost())
+                {
+                    scratch.push_back(element[i]);
+                }
+            }
+            if (scratch.empty())
+            {
+                scratch.push_back(defaultSurface);
             }
 
             // Ensure last element of tile has last flag set
-            auto& lastEl = newElements.back();
-            lastEl.SetLastForTile(true);
+            scratch.back().SetLastForTile(true);
+            fn(scratch.data(), scratch.size());
         }
     }
+}
+
+void VisitAllTileElements(const std::function<void(const TileElement* elements, size_t count)>& fn)
+{
+    auto& tiles = GetWorldState().Tiles;
+    // Walk the storage in order rather than tile by tile, passing on every run of slots in use
+    size_t runStart = 0;
+    for (size_t i = 0; i <= tiles.Elements.size(); i++)
+    {
+        if (i == tiles.Elements.size() || tiles.Free[i])
+        {
+            if (i > runStart)
+            {
+                fn(&tiles.Elements[runStart], i - runStart);
+            }
+            runStart = i + 1;
+        }
+    }
+}
+
+std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts()
+{
+    auto& tiles = GetWorldState().Tiles;
+    std::vector<TileElement> newElements;
+    newElements.reserve(std::max(MIN_TILE_ELEMENTS, tiles.Elements.size()));
+    VisitTileElementsWithoutGhosts([&newElements](const TileElement* elements, size_t count) {
+        newElements.insert(newElements.end(), elements, elements + count);
+    });
     return newElements;
 }
 
@@ -204,7 +311,7 @@ static void ReorganiseTileElements(size_t capacity)
 {
     context_setcurrentcursor(CursorID::ZZZ);
 
-    std::vector<TileElement> newElements;
+    TileElementVector newElements;
     newElements.reserve(std::max(MIN_TILE_ELEMENTS, capacity));
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
     {
@@ -230,30 +337,31 @@ static void ReorganiseTileElements(size_t capacity)
 
 void ReorganiseTileElements()
 {
-    ReorganiseTileElements(_tileElements.size());
+    ReorganiseTileElements(GetWorldState().Tiles.Elements.size());
 }
 
 static bool map_check_free_elements_and_reorganise(size_t numElementsOnTile, size_t numNewElements)
 {
-    // Check hard cap on num in use tiles (this would be the size of _tileElements immediately after a reorg)
-    if (_tileElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
+    auto& tiles = GetWorldState().Tiles;
+    // Check hard cap on num in use tiles (this would be the size of tiles.Elements immediately after a reorg)
+    if (tiles.ElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
     {
         return false;
     }
 
     auto totalElementsRequired = numElementsOnTile + numNewElements;
-    auto freeElements = _tileElements.capacity() - _tileElements.size();
+    auto freeElements = tiles.Elements.capacity() - tiles.Elements.size();
     if (freeElements >= totalElementsRequired)
     {
         return true;
     }
 
     // if space issue is due to fragmentation then Reorg Tiles without increasing capacity
-    if (_tileElements.size() > totalElementsRequired + _tileElementsInUse)
+    if (tiles.Elements.size() > totalElementsRequired + tiles.ElementsInUse)
     {
         ReorganiseTileElements();
         // This check is not expected to fail
-        freeElements = _tileElements.capacity() - _tileElements.size();
+        freeElements = tiles.Elements.capacity() - tiles.Elements.size();
         if (freeElements >= totalElementsRequired)
         {
             return true;
@@ -261,13 +369,20 @@ static bool map_check_free_elements_and_reorganise(size_t numElementsOnTile, siz
     }
 
     // Capacity must increase to handle the space (Note capacity can go above MAX_TILE_ELEMENTS)
-    auto newCapacity = _tileElements.capacity() * 2;
+    auto newCapacity = tiles.Elements.capacity() * 2;
     ReorganiseTileElements(newCapacity);
     return true;
 }
 
 static size_t CountElementsOnTile(const CoordsXY& loc);
 
+static void FreeTileElement(TileElement* tileElement)
+{
+    auto& tiles = GetWorldState().Tiles;
+    tileElement->base_height = MAX_ELEMENT_HEIGHT;
+    tiles.Free[tileElement - tiles.Elements.data()] = true;
+}
+
 bool MapCheckCapacityAndReorganise(const CoordsXY& loc, size_t numElements)
 {
     auto numElementsOnTile = CountElementsOnTile(loc);
@@ -330,12 +445,13 @@ static bool IsTileLocationValid(const TileCoordsXY& coords)
 
 TileElement* map_get_first_element_at(const TileCoordsXY& tilePos)
 {
+    auto& tiles = GetWorldState().Tiles;
     if (!IsTileLocationValid(tilePos))
     {
         log_verbose("Trying to access element outside of range");
         return nullptr;
     }
-    return _tileIndex.GetFirstElementAt(tilePos);
+    return tiles.Index.GetFirstElementAt(tilePos);
 }
 
 TileElement* map_get_first_element_at(const CoordsXY& elementPos)
@@ -372,19 +488,70 @@ TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n)
 
 void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
 {
+    auto& tiles = GetWorldState().Tiles;
     if (!map_is_location_valid(tilePos.ToCoordsXY()))
     {
         log_error("Trying to access element outside of range");
         return;
     }
-    _tileIndex.SetTile(tilePos, elements);
+    tiles.Index.SetTile(tilePos, elements);
+    tiles.Summaries.Update(tilePos, elements);
+    MapOwnershipChanged();
+}
+
+bool MapTileHasElementType(const TileCoordsXY& tilePos, TileElementType type)
+{
+    auto& tiles = GetWorldState().Tiles;
+    if (!IsTileLocationValid(tilePos))
+    {
+        return false;
+    }
+    return tiles.Summaries.HasElementType(tilePos, type);
+}
+
+void MapUpdateTileSummary(const TileCoordsXY& tilePos)
+{
+    auto& tiles = GetWorldState().Tiles;
+    if (IsTileLocationValid(tilePos))
+    {
+        tiles.Summaries.Update(tilePos, tiles.Index.GetFirstElementAt(tilePos));
+    }
 }
 
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
 {
-    auto view = TileElementsView<SurfaceElement>(coords);
+    auto& tiles = GetWorldState().Tiles;
+    const auto tilePos = TileCoordsXY{ coords };
+    auto* element = map_get_first_element_at(tilePos);
+    if (element == nullptr)
+    {
+        return nullptr;
+    }
 
-    return *view.begin();
+    // Removals do not refresh the summary as elements do not know their tile, only trust the offset if it is still
+    // within the tile and points at a surface.
+    auto offset = tiles.Summaries.GetSurfaceOffset(tilePos);
+    if (offset != TileSummaryIndex::NoSurface)
+    {
+        bool isWithinTile = true;
+        for (uint16_t i = 0; i < offset; i++)
+        {
+            if (element[i].IsLastForTile())
+            {
+                isWithinTile = false;
+                break;
+            }
+        }
+        if (isWithinTile)
+        {
+            auto* surfaceElement = element[offset].AsSurface();
+            if (surfaceElement != nullptr)
+            {
+                return surfaceElement;
+            }
+        }
+    }
+    return OpenRCT2::Detail::NextMatchingTile<SurfaceElement>(element);
 }
 
 PathElement* map_get_path_element_at(const TileCoordsXYZ& loc)
@@ -422,7 +589,7 @@ void map_init(int32_t size)
 {
     auto numTiles = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL;
 
-    std::vector<TileElement> tileElements;
+    TileElementVector tileElements;
     tileElements.resize(numTiles);
     for (int32_t i = 0; i < numTiles; i++)
     {
@@ -459,38 +626,9 @@ void map_init(int32_t size)
  */
 void map_count_remaining_land_rights()
 {
-    gLandRemainingOwnershipSales = 0;
-    gLandRemainingConstructionSales = 0;
-
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
-    {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
-        {
-            auto* surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-            // Surface elements are sometimes hacked out to save some space for other map elements
-            if (surfaceElement == nullptr)
-            {
-                continue;
-            }
-
-            uint8_t flags = surfaceElement->GetOwnership();
-
-            // Do not combine this condition with (flags & OWNERSHIP_AVAILABLE)
-            // As some RCT1 parks have owned tiles with the 'construction rights available' flag also set
-            if (!(flags & OWNERSHIP_OWNED))
-            {
-                if (flags & OWNERSHIP_AVAILABLE)
-                {
-                    gLandRemainingOwnershipSales++;
-                }
-                else if (
-                    (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE) && (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED) == 0)
-                {
-                    gLandRemainingConstructionSales++;
-                }
-            }
-        }
-    }
+    auto& ownershipLayer = GetMapOwnershipLayer();
+    gLandRemainingOwnershipSales = ownershipLayer.CountRemainingOwnershipSales();
+    gLandRemainingConstructionSales = ownershipLayer.CountRemainingConstructionSales();
 }
 
 /**
@@ -504,7 +642,8 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : _tileElements)
+    auto& tiles = GetWorldState().Tiles;
+    for (auto& element : tiles.Elements)
     {
         element.SetGhost(false);
     }
@@ -732,29 +871,9 @@ void map_update_path_wide_flags()
         return;
     }
 
-    // Presumably update_path_wide_flags is too computationally expensive to call for every
-    // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
-    // progress. A maximum of 128 calls is done per update.
-    auto x = gWidePathTileLoopPosition.x;
-    auto y = gWidePathTileLoopPosition.y;
-    for (int32_t i = 0; i < 128; i++)
-    {
-        footpath_update_path_wide_flags({ x, y });
-
-        // Next x, y tile
-        x += COORDS_XY_STEP;
-        if (x >= MAXIMUM_MAP_SIZE_BIG)
-        {
-            x = 0;
-            y += COORDS_XY_STEP;
-            if (y >= MAXIMUM_MAP_SIZE_BIG)
-            {
-                y = 0;
-            }
-        }
-    }
-    gWidePathTileLoopPosition.x = x;
-    gWidePathTileLoopPosition.y = y;
+    // Only tiles around footpath changes need their wide flags recalculated, gWidePathTileLoopPosition is kept for
+    // save compatibility but no longer advanced.
+    footpath_update_dirty_wide_flags();
 }
 
 /**
@@ -1078,6 +1197,7 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    auto& tiles = GetWorldState().Tiles;
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1091,11 +1211,15 @@ void tile_element_remove(TileElement* tileElement)
 
     // Mark the latest element with the last element flag.
     (tileElement - 1)->SetLastForTile(true);
-    tileElement->base_height = MAX_ELEMENT_HEIGHT;
-    _tileElementsInUse--;
-    if (tileElement == &_tileElements.back())
+    FreeTileElement(tileElement);
+    tiles.ElementsInUse--;
+    ConstructionClearanceInvalidateCache();
+
+    // Trailing free slots can be given back, the run before them can still grow into the vector's spare capacity.
+    while (!tiles.Free.empty() && tiles.Free.back())
     {
-        _tileElements.pop_back();
+        tiles.Elements.pop_back();
+        tiles.Free.pop_back();
     }
 }
 
@@ -1203,8 +1327,9 @@ void map_invalidate_selection_rect()
 
 static size_t CountElementsOnTile(const CoordsXY& loc)
 {
+    auto& tiles = GetWorldState().Tiles;
     size_t count = 0;
-    auto* element = _tileIndex.GetFirstElementAt(TileCoordsXY(loc));
+    auto* element = tiles.Index.GetFirstElementAt(TileCoordsXY(loc));
     do
     {
         count++;
@@ -1212,38 +1337,116 @@ static size_t CountElementsOnTile(const CoordsXY& loc)
     return count;
 }
 
+/**
+ * Number of extra slots to reserve after a relocated tile so it can grow in place. Runs are rounded up to the next
+ * power of two, a tile that keeps getting new elements is therefore only moved a logarithmic number of times.
+ */
+static size_t GetTileElementSlack(size_t numElements)
+{
+    size_t sizeClass = 4;
+    while (sizeClass < numElements)
+    {
+        sizeClass <<= 1;
+    }
+    return sizeClass - numElements;
+}
+
 static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNewElements)
 {
+    auto& tiles = GetWorldState().Tiles;
     if (!map_check_free_elements_and_reorganise(numElementsOnTile, numNewElements))
     {
         log_error("Cannot insert new element");
         return nullptr;
     }
 
-    auto oldSize = _tileElements.size();
-    _tileElements.resize(_tileElements.size() + numElementsOnTile + numNewElements);
-    _tileElementsInUse += numNewElements;
-    return &_tileElements[oldSize];
+    // Slack is only taken from spare capacity, it must never cause a reallocation that
+    // MapCheckCapacityAndReorganise did not account for.
+    auto numElements = numElementsOnTile + numNewElements;
+    auto numSpare = tiles.Elements.capacity() - tiles.Elements.size() - numElements;
+    auto numSlack = std::min(GetTileElementSlack(numElements), numSpare);
+
+    auto oldSize = tiles.Elements.size();
+    tiles.Elements.resize(oldSize + numElements + numSlack);
+    tiles.Free.resize(tiles.Elements.size(), false);
+    for (auto i = oldSize + numElements; i < tiles.Elements.size(); i++)
+    {
+        FreeTileElement(&tiles.Elements[i]);
+    }
+    tiles.ElementsInUse += numNewElements;
+    return &tiles.Elements[oldSize];
 }
 
 /**
- *
- *  rct2: 0x0068B1F6
+ * Inserts an element into a tile by growing its run into the free slot directly after it. The elements above the
+ * insert height are shifted up by one.
+ * @return The slot for the new element or nullptr if the slot after the run is in use.
  */
-TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type)
+static TileElement* InsertTileElementInPlace(TileElement* firstElement, size_t numElementsOnTile, int32_t z)
 {
-    const auto& tileLoc = TileCoordsXYZ(loc);
+    auto& tiles = GetWorldState().Tiles;
+    if (firstElement == nullptr)
+    {
+        return nullptr;
+    }
 
-    auto numElementsOnTileOld = CountElementsOnTile(loc);
-    auto* newTileElement = AllocateTileElements(numElementsOnTileOld, 1);
-    auto* originalTileElement = _tileIndex.GetFirstElementAt(tileLoc);
+    auto nextIndex = static_cast<size_t>(firstElement - tiles.Elements.data()) + numElementsOnTile;
+    if (nextIndex == tiles.Elements.size())
+    {
+        // Growing into spare capacity must not reallocate, that would invalidate every element pointer.
+        if (tiles.Elements.size() == tiles.Elements.capacity())
+        {
+            return nullptr;
+        }
+        tiles.Elements.emplace_back();
+        tiles.Free.push_back(false);
+    }
+    else if (tiles.Free[nextIndex])
+    {
+        tiles.Free[nextIndex] = false;
+    }
+    else
+    {
+        return nullptr;
+    }
+    tiles.ElementsInUse++;
+
+    auto* end = firstElement + numElementsOnTile;
+    auto* insertedElement = firstElement;
+    while (insertedElement != end && z >= insertedElement->GetBaseZ())
+    {
+        insertedElement++;
+    }
+
+    bool isLastForTile = insertedElement == end;
+    if (isLastForTile)
+    {
+        (end - 1)->SetLastForTile(false);
+    }
+    else
+    {
+        std::copy_backward(insertedElement, end, end + 1);
+    }
+    insertedElement->SetLastForTile(isLastForTile);
+    return insertedElement;
+}
+
+/**
+ * Inserts an element into a tile by copying the tile to a new run at the end of the element storage.
+ * @return The slot for the new element or nullptr if the element limit has been reached.
+ */
+static TileElement* InsertTileElementRelocated(const TileCoordsXYZ& tileLoc, size_t numElementsOnTile, int32_t z)
+{
+    auto& tiles = GetWorldState().Tiles;
+    auto* newTileElement = AllocateTileElements(numElementsOnTile, 1);
+    auto* originalTileElement = tiles.Index.GetFirstElementAt(tileLoc);
     if (newTileElement == nullptr)
     {
         return nullptr;
     }
 
     // Set tile index pointer to point to new element block
-    _tileIndex.SetTile(tileLoc, newTileElement);
+    tiles.Index.SetTile(tileLoc, newTileElement);
 
     bool isLastForTile = false;
     if (originalTileElement == nullptr)
@@ -1253,11 +1456,11 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
     else
     {
         // Copy all elements that are below the insert height
-        while (loc.z >= originalTileElement->GetBaseZ())
+        while (z >= originalTileElement->GetBaseZ())
         {
             // Copy over map element
             *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
+            FreeTileElement(originalTileElement);
             originalTileElement++;
             newTileElement++;
 
@@ -1271,18 +1474,8 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
         }
     }
 
-    // Insert new map element
     auto* insertedElement = newTileElement;
-    newTileElement->type = 0;
-    newTileElement->SetType(type);
-    newTileElement->SetBaseZ(loc.z);
-    newTileElement->Flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->SetClearanceZ(loc.z);
-    newTileElement->owner = 0;
-    std::memset(&newTileElement->pad_05, 0, sizeof(newTileElement->pad_05));
-    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
+    insertedElement->SetLastForTile(isLastForTile);
     newTileElement++;
 
     // Insert rest of map elements above insert height
@@ -1292,7 +1485,7 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
         {
             // Copy over map element
             *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
+            FreeTileElement(originalTileElement);
             originalTileElement++;
             newTileElement++;
         } while (!((newTileElement - 1)->IsLastForTile()));
@@ -1301,6 +1494,132 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
     return insertedElement;
 }
 
+/**
+ *
+ *  rct2: 0x0068B1F6
+ */
+TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type)
+{
+    auto& tiles = GetWorldState().Tiles;
+    const auto& tileLoc = TileCoordsXYZ(loc);
+
+    auto numElementsOnTileOld = CountElementsOnTile(loc);
+    TileElement* newTileElement = nullptr;
+    if (tiles.ElementsInUse < MAX_TILE_ELEMENTS)
+    {
+        newTileElement = InsertTileElementInPlace(tiles.Index.GetFirstElementAt(tileLoc), numElementsOnTileOld, loc.z);
+    }
+    if (newTileElement == nullptr)
+    {
+        newTileElement = InsertTileElementRelocated(tileLoc, numElementsOnTileOld, loc.z);
+        if (newTileElement == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    // Insert new map element
+    bool isLastForTile = newTileElement->IsLastForTile();
+    newTileElement->type = 0;
+    newTileElement->SetType(type);
+    newTileElement->SetBaseZ(loc.z);
+    newTileElement->Flags = 0;
+    newTileElement->SetLastForTile(isLastForTile);
+    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
+    newTileElement->SetClearanceZ(loc.z);
+    newTileElement->owner = 0;
+    std::memset(&newTileElement->pad_05, 0, sizeof(newTileElement->pad_05));
+    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
+    tiles.Summaries.Update(tileLoc, tiles.Index.GetFirstElementAt(tileLoc));
+    ConstructionClearanceInvalidateCache();
+    MapOwnershipChanged();
+    return newTileElement;
+}
+
+namespace
+{
+    struct TileUpdatePlan
+    {
+        CoordsXY Pos;
+        SurfaceElement* Surface;
+        GrassUpdate Grass;
+        size_t AgeUpdatesBegin;
+    };
+
+    struct BlockUpdatePlan
+    {
+        TileCoordsXY Origin;
+        std::vector<TileUpdatePlan> Tiles;
+        std::vector<SmallSceneryAgeUpdate> AgeUpdates;
+    };
+} // namespace
+
+static constexpr size_t MapUpdateTilesPerBlock = 43;
+
+static std::unique_ptr<JobPool> _tileUpdateJobs;
+static std::vector<BlockUpdatePlan> _blockUpdatePlans;
+
+static void map_plan_block_update(BlockUpdatePlan& block, const std::array<TileCoordsXY, MapUpdateTilesPerBlock>& positions)
+{
+    block.Tiles.clear();
+    block.AgeUpdates.clear();
+    for (const auto& position : positions)
+    {
+        auto& tile = block.Tiles.emplace_back();
+        tile.Pos = TileCoordsXY{ block.Origin.x + position.x, block.Origin.y + position.y }.ToCoordsXY();
+        tile.Surface = map_get_surface_element_at(tile.Pos);
+        tile.AgeUpdatesBegin = block.AgeUpdates.size();
+        if (tile.Surface != nullptr)
+        {
+            tile.Grass = tile.Surface->GetGrassUpdate(tile.Pos);
+            scenery_plan_tile_update(tile.Pos, block.AgeUpdates);
+        }
+    }
+}
+
+/**
+ * Plans the update of every 256x256 block on the job pool. The plans only read the tiles of their own block, anything
+ * that draws random numbers, invalidates the viewports or creates entities is applied afterwards on the calling thread
+ * in the same order as the sequential update, so both produce the same game state.
+ */
+static void map_update_tiles_parallel(const std::array<TileCoordsXY, MapUpdateTilesPerBlock>& positions)
+{
+    if (_tileUpdateJobs == nullptr)
+    {
+        _tileUpdateJobs = std::make_unique<JobPool>(255, "Tile update");
+    }
+
+    size_t numBlocks = 0;
+    for (int32_t blockY = 0; blockY < gMapSize; blockY += 256)
+    {
+        for (int32_t blockX = 0; blockX < gMapSize; blockX += 256)
+        {
+            if (numBlocks == _blockUpdatePlans.size())
+            {
+                _blockUpdatePlans.emplace_back();
+            }
+            auto& block = _blockUpdatePlans[numBlocks++];
+            block.Origin = { blockX, blockY };
+            _tileUpdateJobs->AddTask([&block, &positions]() { map_plan_block_update(block, positions); });
+        }
+    }
+    _tileUpdateJobs->Join();
+
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        for (size_t blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+        {
+            const auto& block = _blockUpdatePlans[blockIndex];
+            const auto& tile = block.Tiles[i];
+            if (tile.Surface != nullptr)
+            {
+                tile.Surface->ApplyGrassUpdate(tile.Grass, tile.Pos);
+                scenery_apply_tile_update(tile.Pos, block.AgeUpdates.data() + tile.AgeUpdatesBegin);
+            }
+        }
+    }
+}
+
 /**
  * Updates grass length, scenery age and jumping fountains.
  *
@@ -1313,7 +1632,8 @@ void map_update_tiles()
         return;
 
     // Update 43 more tiles (for each 256x256 block)
-    for (int32_t j = 0; j < 43; j++)
+    std::array<TileCoordsXY, MapUpdateTilesPerBlock> positions;
+    for (auto& position : positions)
     {
         int32_t x = 0;
         int32_t y = 0;
@@ -1326,13 +1646,26 @@ void map_update_tiles()
             y = (y << 1) | (interleaved_xy & 1);
             interleaved_xy >>= 1;
         }
+        position = { x, y };
+
+        gGrassSceneryTileLoopPosition++;
+        gGrassSceneryTileLoopPosition &= 0xFFFF;
+    }
+
+    if (gConfigGeneral.parallel_tile_updates)
+    {
+        map_update_tiles_parallel(positions);
+        return;
+    }
 
+    for (const auto& position : positions)
+    {
         // Repeat for each 256x256 block on the map
         for (int32_t blockY = 0; blockY < gMapSize; blockY += 256)
         {
             for (int32_t blockX = 0; blockX < gMapSize; blockX += 256)
             {
-                auto mapPos = TileCoordsXY{ blockX + x, blockY + y }.ToCoordsXY();
+                auto mapPos = TileCoordsXY{ blockX + position.x, blockY + position.y }.ToCoordsXY();
                 auto* surfaceElement = map_get_surface_element_at(mapPos);
                 if (surfaceElement != nullptr)
                 {
@@ -1341,9 +1674,6 @@ void map_update_tiles()
                 }
             }
         }
-
-        gGrassSceneryTileLoopPosition++;
-        gGrassSceneryTileLoopPosition &= 0xFFFF;
     }
 }
 
@@ -1834,23 +2164,230 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
     return ScreenCoordsXY{ rotated.y - rotated.x, ((rotated.x + rotated.y) >> 1) - pos.z };
 }
 
+static bool _dirtyTilesTracking;
+static std::vector<uint8_t> _dirtyTileFlags;
+static std::vector<TileCoordsXY> _dirtyTiles;
+
+void map_dirty_tiles_set_tracking(bool enabled)
+{
+    _dirtyTilesTracking = enabled;
+    _dirtyTiles.clear();
+    if (enabled)
+    {
+        _dirtyTileFlags.assign(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL, 0);
+    }
+    else
+    {
+        _dirtyTileFlags.clear();
+        _dirtyTileFlags.shrink_to_fit();
+    }
+}
+
+void map_dirty_tiles_take(std::vector<TileCoordsXY>& tiles)
+{
+    tiles.clear();
+    std::swap(tiles, _dirtyTiles);
+    for (const auto& tile : tiles)
+    {
+        _dirtyTileFlags[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x] = 0;
+    }
+}
+
+static void map_dirty_tiles_mark(const CoordsXY& tilePos)
+{
+    if (!_dirtyTilesTracking || !map_is_location_valid(tilePos))
+        return;
+
+    const auto tile = TileCoordsXY(tilePos);
+    auto& flag = _dirtyTileFlags[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x];
+    if (flag == 0)
+    {
+        flag = 1;
+        _dirtyTiles.push_back(tile);
+    }
+}
+
+/**
+ * Tile invalidations are collected per tile until the next frame is drawn, repeated invalidations of the same tile only
+ * widen its height range. The pending tiles are then turned into screen rectangles, merged with the other pending
+ * screen rectangles such as those of moving entities and passed on to the viewports in one go.
+ */
+struct PendingTileInvalidation
+{
+    TileCoordsXY Tile;
+    int32_t BaseZ;
+    int32_t ClearanceZ;
+    ZoomLevel MaxZoom;
+};
+
+struct PendingScreenInvalidation
+{
+    ScreenRect Rect;
+    ZoomLevel MaxZoom;
+};
+
+// Pending screen rectangles are flushed early past this, in case no frame is drawn for a while.
+static constexpr size_t MaxPendingScreenInvalidations = 32768;
+static constexpr uint32_t NoPendingTileInvalidation = UINT32_MAX;
+
+static std::vector<uint32_t> _pendingTileInvalidationIndex;
+static std::vector<PendingTileInvalidation> _pendingTileInvalidations;
+static std::vector<PendingScreenInvalidation> _pendingScreenInvalidations;
+
+static ZoomLevel GetWidestInvalidationZoom(ZoomLevel a, ZoomLevel b)
+{
+    if (a == ZoomLevel{ -1 } || b == ZoomLevel{ -1 })
+        return ZoomLevel{ -1 };
+    return std::max(a, b);
+}
+
+static ScreenRect GetTileInvalidationRect(const PendingTileInvalidation& invalidation)
+{
+    auto pos = invalidation.Tile.ToCoordsXY() + CoordsXY{ 16, 16 };
+    auto screenCoord = translate_3d_to_2d(get_current_rotation(), pos);
+    return { { screenCoord.x - 32, screenCoord.y - 32 - invalidation.ClearanceZ },
+             { screenCoord.x + 32, screenCoord.y + 32 - invalidation.BaseZ } };
+}
+
+static int64_t GetScreenRectArea(const ScreenRect& rect)
+{
+    return static_cast<int64_t>(rect.GetWidth()) * rect.GetHeight();
+}
+
+static ScreenRect GetScreenRectUnion(const ScreenRect& a, const ScreenRect& b)
+{
+    return { { std::min(a.GetLeft(), b.GetLeft()), std::min(a.GetTop(), b.GetTop()) },
+             { std::max(a.GetRight(), b.GetRight()), std::max(a.GetBottom(), b.GetBottom()) } };
+}
+
+/**
+ * Merges overlapping rectangles when their union does not cover more than the two rectangles do on their own, so the
+ * merged result never invalidates noticeably more of the screen than the original set.
+ */
+static void MergeScreenInvalidations(std::vector<ScreenRect>& rects)
+{
+    if (rects.size() < 2)
+        return;
+
+    std::sort(rects.begin(), rects.end(), [](const ScreenRect& a, const ScreenRect& b) {
+        return a.GetTop() != b.GetTop() ? a.GetTop() < b.GetTop() : a.GetLeft() < b.GetLeft();
+    });
+
+    size_t count = 1;
+    for (size_t i = 1; i < rects.size(); i++)
+    {
+        auto& last = rects[count - 1];
+        const auto& rect = rects[i];
+        auto merged = GetScreenRectUnion(last, rect);
+        if (GetScreenRectArea(merged) <= GetScreenRectArea(last) + GetScreenRectArea(rect))
+        {
+            last = merged;
+        }
+        else
+        {
+            rects[count++] = rect;
+        }
+    }
+    rects.resize(count);
+}
+
+void map_invalidate_screen_rect(const ScreenRect& rect, ZoomLevel maxZoom)
+{
+    if (gOpenRCT2Headless)
+        return;
+
+    if (maxZoom != ZoomLevel{ -1 } && (maxZoom < ZoomLevel{ 0 } || maxZoom > ZoomLevel{ 2 }))
+    {
+        // Not one of the zoom limits the pending rectangles are grouped by.
+        viewports_invalidate(rect, maxZoom);
+        return;
+    }
+
+    if (_pendingScreenInvalidations.size() >= MaxPendingScreenInvalidations)
+    {
+        map_invalidate_flush();
+    }
+    _pendingScreenInvalidations.push_back({ rect, maxZoom });
+}
+
+void map_invalidate_flush()
+{
+    if (_pendingTileInvalidations.empty() && _pendingScreenInvalidations.empty())
+        return;
+
+    // Rectangles are merged separately for each zoom limit as they go to different sets of viewports.
+    static std::vector<ScreenRect> rects;
+    for (auto maxZoom : { ZoomLevel{ -1 }, ZoomLevel{ 2 }, ZoomLevel{ 1 }, ZoomLevel{ 0 } })
+    {
+        rects.clear();
+        for (const auto& invalidation : _pendingScreenInvalidations)
+        {
+            if (invalidation.MaxZoom == maxZoom)
+            {
+                rects.push_back(invalidation.Rect);
+            }
+        }
+        for (const auto& invalidation : _pendingTileInvalidations)
+        {
+            if (invalidation.MaxZoom == maxZoom)
+            {
+                rects.push_back(GetTileInvalidationRect(invalidation));
+            }
+        }
+
+        MergeScreenInvalidations(rects);
+        for (const auto& rect : rects)
+        {
+            viewports_invalidate(rect, maxZoom);
+        }
+    }
+
+    for (const auto& invalidation : _pendingTileInvalidations)
+    {
+        _pendingTileInvalidationIndex[invalidation.Tile.y * gMapSize + invalidation.Tile.x] = NoPendingTileInvalidation;
+    }
+    _pendingTileInvalidations.clear();
+    _pendingScreenInvalidations.clear();
+}
+
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, ZoomLevel maxZoom)
 {
     if (gOpenRCT2Headless)
         return;
 
-    int32_t x1, y1, x2, y2;
+    map_dirty_tiles_mark({ x, y });
 
-    x += 16;
-    y += 16;
-    auto screenCoord = translate_3d_to_2d(get_current_rotation(), { x, y });
+    const auto tile = TileCoordsXY(CoordsXY{ x, y });
+    if (x < 0 || y < 0 || (x % COORDS_XY_STEP) != 0 || (y % COORDS_XY_STEP) != 0 || tile.x >= gMapSize
+        || tile.y >= gMapSize)
+    {
+        // Not a tile in the index, pass it on to the viewports straight away.
+        auto screenCoord = translate_3d_to_2d(get_current_rotation(), { x + 16, y + 16 });
+        viewports_invalidate(
+            { { screenCoord.x - 32, screenCoord.y - 32 - z1 }, { screenCoord.x + 32, screenCoord.y + 32 - z0 } }, maxZoom);
+        return;
+    }
 
-    x1 = screenCoord.x - 32;
-    y1 = screenCoord.y - 32 - z1;
-    x2 = screenCoord.x + 32;
-    y2 = screenCoord.y + 32 - z0;
+    const auto indexSize = static_cast<size_t>(gMapSize) * gMapSize;
+    if (_pendingTileInvalidationIndex.size() != indexSize)
+    {
+        // Map size changed, the pending entries refer to the old layout.
+        map_invalidate_flush();
+        _pendingTileInvalidationIndex.assign(indexSize, NoPendingTileInvalidation);
+    }
 
-    viewports_invalidate({ { x1, y1 }, { x2, y2 } }, maxZoom);
+    auto& index = _pendingTileInvalidationIndex[tile.y * gMapSize + tile.x];
+    if (index == NoPendingTileInvalidation)
+    {
+        index = static_cast<uint32_t>(_pendingTileInvalidations.size());
+        _pendingTileInvalidations.push_back({ tile, z0, z1, maxZoom });
+        return;
+    }
+
+    auto& pending = _pendingTileInvalidations[index];
+    pending.BaseZ = std::min(pending.BaseZ, z0);
+    pending.ClearanceZ = std::max(pending.ClearanceZ, z1);
+    pending.MaxZoom = GetWidestInvalidationZoom(pending.MaxZoom, maxZoom);
 }
 
 /**
@@ -1911,7 +2448,7 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
     bottom += 32;
     top -= 32 + 2080;
 
-    viewports_invalidate({ { left, top }, { right, bottom } });
+    map_invalidate_screen_rect({ { left, top }, { right, bottom } }, ZoomLevel{ -1 });
 }
 
 int32_t map_get_tile_side(const CoordsXY& mapPos)
@@ -10,9 +10,11 @@
 #pragma once
 
 #include "../common.h"
+#include "../interface/ZoomLevel.h"
 #include "Location.hpp"
 #include "TileElement.h"
 
+#include <functional>
 #include <initializer_list>
 #include <vector>
 
@@ -145,11 +147,23 @@ extern const uint8_t tile_element_lower_styles[9][32];
 extern const uint8_t tile_element_raise_styles[9][32];
 
 void ReorganiseTileElements();
-const std::vector<TileElement>& GetTileElements();
-void SetTileElements(std::vector<TileElement>&& tileElements);
+
+/**
+ * Counts the changes made to the map by game actions and map loads. Tools remembering where something could not be
+ * built compare it to know when to try again.
+ */
+uint32_t MapGetRevision();
+void MapChanged();
+
+const TileElementVector& GetTileElements();
+void SetTileElements(TileElementVector&& tileElements);
 void StashMap();
 void UnstashMap();
 std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts();
+size_t CountTileElementsWithoutGhosts();
+void VisitTileElementsWithoutGhosts(const std::function<void(const TileElement* elements, size_t count)>& fn);
+// Visits the elements of all tiles, ghosts included, in storage order without regard to which tile they are on.
+void VisitAllTileElements(const std::function<void(const TileElement* elements, size_t count)>& fn);
 
 void map_init(int32_t size);
 
@@ -159,6 +173,8 @@ TileElement* map_get_first_element_at(const CoordsXY& tilePos);
 TileElement* map_get_first_element_at(const TileCoordsXY& tilePos);
 TileElement* map_get_nth_element_at(const CoordsXY& coords, int32_t n);
 void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements);
+bool MapTileHasElementType(const TileCoordsXY& tilePos, TileElementType type);
+void MapUpdateTileSummary(const TileCoordsXY& tilePos);
 int32_t map_height_from_slope(const CoordsXY& coords, int32_t slopeDirection, bool isSloped);
 BannerElement* map_get_banner_element_at(const CoordsXYZ& bannerPos, uint8_t direction);
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords);
@@ -230,6 +246,19 @@ void map_invalidate_tile_zoom0(const CoordsXYRangedZ& tilePos);
 void map_invalidate_tile_full(const CoordsXY& tilePos);
 void map_invalidate_element(const CoordsXY& elementPos, TileElement* tileElement);
 void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs);
+// Queues the screen rectangle to be invalidated in the viewports shown at most at maxZoom when the next frame is drawn.
+void map_invalidate_screen_rect(const ScreenRect& rect, ZoomLevel maxZoom);
+void map_invalidate_flush();
+
+/**
+ * While tracking is enabled every tile passed to the tile invalidation functions is remembered, so that views
+ * of the whole map such as the minimap only have to update the tiles that changed.
+ */
+void map_dirty_tiles_set_tracking(bool enabled);
+/**
+ * Moves the tiles invalidated since the last call into tiles, every tile is listed once.
+ */
+void map_dirty_tiles_take(std::vector<TileCoordsXY>& tiles);
 
 int32_t map_get_tile_side(const CoordsXY& mapPos);
 int32_t map_get_tile_quadrant(const CoordsXY& mapPos);
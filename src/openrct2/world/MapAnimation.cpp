@@ -26,17 +26,66 @@
 #include "Scenery.h"
 #include "SmallScenery.h"
 
-using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
+#include <algorithm>
 
-static std::vector<MapAnimation> _mapAnimations;
+using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
 constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
 
+// Animations that only redraw their tile are bucketed by blocks of tiles so only the blocks that can be seen have to be
+// updated, the rest are only checked for being stale every PruneInterval ticks.
+constexpr int32_t BlockSize = 8;
+constexpr int32_t BlocksPerRow = (MAXIMUM_MAP_SIZE_TECHNICAL + BlockSize - 1) / BlockSize;
+constexpr uint32_t PruneInterval = 64;
+
+// Animations that change the game state and have to be updated every tick, in creation order.
+static std::vector<MapAnimation> _stateAnimations;
+static std::vector<std::vector<MapAnimation>> _visualAnimationBlocks;
+static size_t _numMapAnimations;
+
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
+static bool IsVisualOnlyAnimation(int32_t type)
+{
+    switch (type)
+    {
+        case MAP_ANIMATION_TYPE_RIDE_ENTRANCE:
+        case MAP_ANIMATION_TYPE_QUEUE_BANNER:
+        // Clocks make guests check the time, but only every 1024 ticks which is always a prune tick.
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+        case MAP_ANIMATION_TYPE_PARK_ENTRANCE:
+        case MAP_ANIMATION_TYPE_TRACK_WATERFALL:
+        case MAP_ANIMATION_TYPE_TRACK_RAPIDS:
+        case MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL:
+        case MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL:
+        case MAP_ANIMATION_TYPE_BANNER:
+        case MAP_ANIMATION_TYPE_LARGE_SCENERY:
+        case MAP_ANIMATION_TYPE_WALL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static std::vector<MapAnimation>& GetAnimationList(int32_t type, const CoordsXY& location)
+{
+    if (!IsVisualOnlyAnimation(type))
+    {
+        return _stateAnimations;
+    }
+
+    if (_visualAnimationBlocks.empty())
+    {
+        _visualAnimationBlocks.resize(BlocksPerRow * BlocksPerRow);
+    }
+    auto blockX = std::clamp(location.x / COORDS_XY_STEP / BlockSize, 0, BlocksPerRow - 1);
+    auto blockY = std::clamp(location.y / COORDS_XY_STEP / BlockSize, 0, BlocksPerRow - 1);
+    return _visualAnimationBlocks[blockX + blockY * BlocksPerRow];
+}
+
 static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
 {
-    for (const auto& a : _mapAnimations)
+    for (const auto& a : GetAnimationList(type, location))
     {
         if (a.type == type && a.location == location)
         {
@@ -51,10 +100,11 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
 {
     if (!DoesAnimationExist(type, loc))
     {
-        if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
+        if (_numMapAnimations < MAX_ANIMATED_OBJECTS)
         {
             // Create new animation
-            _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            GetAnimationList(type, loc).push_back({ static_cast<uint8_t>(type), loc });
+            _numMapAnimations++;
         }
         else
         {
@@ -64,18 +114,19 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
 }
 
 /**
- *
- *  rct2: 0x0068AFAD
+ * Updates the animations of a list.
+ * @param prune Whether finished animations should be removed, if not their result is ignored.
  */
-void map_animation_invalidate_all()
+static void InvalidateMapAnimations(std::vector<MapAnimation>& animations, bool prune)
 {
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    auto it = animations.begin();
+    while (it != animations.end())
     {
-        if (InvalidateMapAnimation(*it))
+        if (InvalidateMapAnimation(*it) && prune)
         {
             // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
+            it = animations.erase(it);
+            _numMapAnimations--;
         }
         else
         {
@@ -84,6 +135,45 @@ void map_animation_invalidate_all()
     }
 }
 
+/**
+ *
+ *  rct2: 0x0068AFAD
+ */
+void map_animation_invalidate_all()
+{
+    InvalidateMapAnimations(_stateAnimations, true);
+
+    // Visual animations do not affect the game state, so skipping them is fine as long as pruning, which decides
+    // whether new animations can be created, happens on the same ticks for every client.
+    if ((gCurrentTicks % PruneInterval) == 0)
+    {
+        for (auto& block : _visualAnimationBlocks)
+        {
+            InvalidateMapAnimations(block, true);
+        }
+        return;
+    }
+
+    if (_visualAnimationBlocks.empty())
+        return;
+
+    // All visual animations only invalidate viewports up to zoom level 1.
+    for (const auto& range : viewports_get_visible_map_ranges(ZoomLevel{ 1 }))
+    {
+        auto left = std::clamp(range.GetLeft() / COORDS_XY_STEP / BlockSize - 1, 0, BlocksPerRow - 1);
+        auto top = std::clamp(range.GetTop() / COORDS_XY_STEP / BlockSize - 1, 0, BlocksPerRow - 1);
+        auto right = std::clamp(range.GetRight() / COORDS_XY_STEP / BlockSize + 1, 0, BlocksPerRow - 1);
+        auto bottom = std::clamp(range.GetBottom() / COORDS_XY_STEP / BlockSize + 1, 0, BlocksPerRow - 1);
+        for (auto blockY = top; blockY <= bottom; blockY++)
+        {
+            for (auto blockX = left; blockX <= right; blockX++)
+            {
+                InvalidateMapAnimations(_visualAnimationBlocks[blockX + blockY * BlocksPerRow], false);
+            }
+        }
+    }
+}
+
 /**
  *
  *  rct2: 0x00666670
@@ -599,12 +689,20 @@ static bool InvalidateMapAnimation(const MapAnimation& a)
 
 const std::vector<MapAnimation>& GetMapAnimations()
 {
-    return _mapAnimations;
+    static std::vector<MapAnimation> animations;
+    animations = _stateAnimations;
+    for (const auto& block : _visualAnimationBlocks)
+    {
+        animations.insert(animations.end(), block.begin(), block.end());
+    }
+    return animations;
 }
 
 static void ClearMapAnimations()
 {
-    _mapAnimations.clear();
+    _stateAnimations.clear();
+    _visualAnimationBlocks.clear();
+    _numMapAnimations = 0;
 }
 
 void AutoCreateMapAnimations()
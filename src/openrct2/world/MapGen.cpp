@@ -28,10 +28,10 @@
 #include "Scenery.h"
 #include "SmallScenery.h"
 #include "Surface.h"
+#include "SurfaceLayer.h"
 
 #include <algorithm>
 #include <cmath>
-#include <cstring>
 #include <iterator>
 #include <vector>
 
@@ -91,9 +91,9 @@ static constexpr const std::string_view BaseTerrain[] = {
 };
 
 static void mapgen_place_trees();
-static void mapgen_set_water_level(int32_t waterLevel);
+static void mapgen_set_water_level(SurfaceLayer& layer, int32_t waterLevel);
 static void mapgen_smooth_height(int32_t iterations);
-static void mapgen_set_height();
+static void mapgen_set_height(SurfaceLayer& layer);
 
 static void mapgen_simplex(mapgen_settings* settings);
 
@@ -129,13 +129,18 @@ void mapgen_generate_blank(mapgen_settings* settings)
             {
                 surfaceElement->SetSurfaceStyle(settings->floor);
                 surfaceElement->SetEdgeStyle(settings->wall);
-                surfaceElement->base_height = settings->height;
-                surfaceElement->clearance_height = settings->height;
             }
         }
     }
 
-    mapgen_set_water_level(settings->water_level);
+    SurfaceLayer layer;
+    layer.Build();
+    for (y = 1; y < settings->mapSize - 1; y++)
+    {
+        layer.FillHeight(1, settings->mapSize - 1, y, settings->height);
+    }
+    mapgen_set_water_level(layer, settings->water_level);
+    layer.Apply();
 }
 
 void mapgen_generate(mapgen_settings* settings)
@@ -177,12 +182,18 @@ void mapgen_generate(mapgen_settings* settings)
             {
                 surfaceElement->SetSurfaceStyle(floorTextureId);
                 surfaceElement->SetEdgeStyle(edgeTextureId);
-                surfaceElement->base_height = settings->height;
-                surfaceElement->clearance_height = settings->height;
             }
         }
     }
 
+    // The height passes below work on a dense copy of the surfaces that is written back once they are done
+    SurfaceLayer layer;
+    layer.Build();
+    for (auto y = 1; y < mapSize - 1; y++)
+    {
+        layer.FillHeight(1, mapSize - 1, y, settings->height);
+    }
+
     // Create the temporary height map and initialise
     _heightSize = mapSize * 2;
     _height = new uint8_t[_heightSize * _heightSize];
@@ -192,16 +203,16 @@ void mapgen_generate(mapgen_settings* settings)
     mapgen_smooth_height(2 + (util_rand() % 6));
 
     // Set the game map to the height map
-    mapgen_set_height();
+    mapgen_set_height(layer);
     delete[] _height;
 
     // Set the tile slopes so that there are no cliffs
-    while (map_smooth(1, 1, mapSize - 1, mapSize - 1))
+    while (map_smooth(layer, 1, 1, mapSize - 1, mapSize - 1))
     {
     }
 
     // Add the water
-    mapgen_set_water_level(waterLevel);
+    mapgen_set_water_level(layer, waterLevel);
 
     // Add sandy beaches
     std::string beachTexture = std::string(floorTexture);
@@ -223,12 +234,11 @@ void mapgen_generate(mapgen_settings* settings)
     {
         for (auto x = 1; x < mapSize - 1; x++)
         {
-            auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-
-            if (surfaceElement != nullptr && surfaceElement->base_height < waterLevel + 6)
-                surfaceElement->SetSurfaceStyle(beachTextureId);
+            if (layer.HasSurface(x, y) && layer.BaseHeight(x, y) < waterLevel + 6)
+                layer.GetElement(x, y)->SetSurfaceStyle(beachTextureId);
         }
     }
+    layer.Apply();
 
     // Place the trees
     if (settings->trees != 0)
@@ -407,20 +417,13 @@ static void mapgen_place_trees()
 /**
  * Sets each tile's water level to the specified water level if underneath that water level.
  */
-static void mapgen_set_water_level(int32_t waterLevel)
+static void mapgen_set_water_level(SurfaceLayer& layer, int32_t waterLevel)
 {
-    int32_t x, y, mapSize;
-
-    mapSize = gMapSize;
-
-    for (y = 1; y < mapSize - 1; y++)
+    const auto mapSize = layer.GetMapSize();
+    const auto waterHeight = static_cast<uint8_t>((waterLevel * COORDS_Z_STEP) / 16);
+    for (int32_t y = 1; y < mapSize - 1; y++)
     {
-        for (x = 1; x < mapSize - 1; x++)
-        {
-            auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-            if (surfaceElement != nullptr && surfaceElement->base_height < waterLevel)
-                surfaceElement->SetWaterHeight(waterLevel * COORDS_Z_STEP);
-        }
+        layer.FillWater(1, mapSize - 1, y, waterLevel, waterHeight);
     }
 }
 
@@ -429,38 +432,40 @@ static void mapgen_set_water_level(int32_t waterLevel)
  */
 static void mapgen_smooth_height(int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
-    int32_t arraySize = _heightSize * _heightSize * sizeof(uint8_t);
-    uint8_t* copyHeight = new uint8_t[arraySize];
+    // The 3x3 box filter is split into a horizontal and a vertical pass over whole rows, the sums are the same as
+    // adding up all nine values so the result does not change.
+    const size_t arraySize = static_cast<size_t>(_heightSize) * _heightSize;
+    std::vector<uint16_t> rowSums(arraySize);
 
-    for (i = 0; i < iterations; i++)
+    for (int32_t i = 0; i < iterations; i++)
     {
-        std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize - 1; y++)
+        for (int32_t y = 0; y < _heightSize; y++)
         {
-            for (x = 1; x < _heightSize - 1; x++)
+            const auto* row = &_height[y * _heightSize];
+            auto* sums = &rowSums[y * _heightSize];
+            for (int32_t x = 1; x < _heightSize - 1; x++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
-                {
-                    for (xx = -1; xx <= 1; xx++)
-                    {
-                        avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
-                    }
-                }
-                avg /= 9;
-                set_height(x, y, avg);
+                sums[x] = row[x - 1] + row[x] + row[x + 1];
+            }
+        }
+        for (int32_t y = 1; y < _heightSize - 1; y++)
+        {
+            const auto* above = &rowSums[(y - 1) * _heightSize];
+            const auto* centre = &rowSums[y * _heightSize];
+            const auto* below = &rowSums[(y + 1) * _heightSize];
+            auto* row = &_height[y * _heightSize];
+            for (int32_t x = 1; x < _heightSize - 1; x++)
+            {
+                row[x] = static_cast<uint8_t>((above[x] + centre[x] + below[x]) / 9);
             }
         }
     }
-
-    delete[] copyHeight;
 }
 
 /**
  * Sets the height of the actual game map tiles to the height map.
  */
-static void mapgen_set_height()
+static void mapgen_set_height(SurfaceLayer& layer)
 {
     int32_t x, y, heightX, heightY, mapSize;
 
@@ -479,13 +484,12 @@ static void mapgen_set_height()
 
             uint8_t baseHeight = (q00 + q01 + q10 + q11) / 4;
 
-            auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-            if (surfaceElement == nullptr)
+            if (!layer.HasSurface(x, y))
                 continue;
-            surfaceElement->base_height = std::max(2, baseHeight * 2);
-            surfaceElement->clearance_height = surfaceElement->base_height;
+            layer.BaseHeight(x, y) = std::max(2, baseHeight * 2);
+            layer.ClearanceHeight(x, y) = layer.BaseHeight(x, y);
 
-            uint8_t currentSlope = surfaceElement->GetSlope();
+            uint8_t currentSlope = layer.Slope(x, y);
 
             if (q00 > baseHeight)
                 currentSlope |= TILE_ELEMENT_SLOPE_S_CORNER_UP;
@@ -496,7 +500,7 @@ static void mapgen_set_height()
             if (q11 > baseHeight)
                 currentSlope |= TILE_ELEMENT_SLOPE_N_CORNER_UP;
 
-            surfaceElement->SetSlope(currentSlope);
+            layer.Slope(x, y) = currentSlope;
         }
     }
 }
@@ -830,30 +834,32 @@ void mapgen_generate_from_heightmap(mapgen_settings* settings)
     const uint8_t rangeIn = maxValue - minValue;
     const uint8_t rangeOut = settings->simplex_high - settings->simplex_low;
 
+    SurfaceLayer layer;
+    layer.Build();
+
     for (uint32_t y = 0; y < _heightMapData.height; y++)
     {
         for (uint32_t x = 0; x < _heightMapData.width; x++)
         {
             // The x and y axis are flipped in the world, so this uses y for x and x for y.
-            auto* const surfaceElement = map_get_surface_element_at(
-                TileCoordsXY{ static_cast<int32_t>(y + 1), static_cast<int32_t>(x + 1) }.ToCoordsXY());
-            if (surfaceElement == nullptr)
+            const auto tileX = static_cast<int32_t>(y + 1);
+            const auto tileY = static_cast<int32_t>(x + 1);
+            if (!layer.HasSurface(tileX, tileY))
                 continue;
 
             // Read value from bitmap, and convert its range
             uint8_t value = dest[x + y * _heightMapData.width];
             value = static_cast<uint8_t>(static_cast<float>(value - minValue) / rangeIn * rangeOut) + settings->simplex_low;
-            surfaceElement->base_height = value;
 
             // Floor to even number
-            surfaceElement->base_height /= 2;
-            surfaceElement->base_height *= 2;
-            surfaceElement->clearance_height = surfaceElement->base_height;
+            auto& baseHeight = layer.BaseHeight(tileX, tileY);
+            baseHeight = (value / 2) * 2;
+            layer.ClearanceHeight(tileX, tileY) = baseHeight;
 
             // Set water level
-            if (surfaceElement->base_height < settings->water_level)
+            if (baseHeight < settings->water_level)
             {
-                surfaceElement->SetWaterHeight(settings->water_level * COORDS_Z_STEP);
+                layer.WaterHeight(tileX, tileY) = (settings->water_level * COORDS_Z_STEP) / 16;
             }
         }
     }
@@ -869,7 +875,7 @@ void mapgen_generate_from_heightmap(mapgen_settings* settings)
             {
                 for (uint32_t x = 1; x <= _heightMapData.width; x++)
                 {
-                    numTilesChanged += tile_smooth(x, y);
+                    numTilesChanged += tile_smooth(layer, x, y);
                 }
             }
 
@@ -877,6 +883,7 @@ void mapgen_generate_from_heightmap(mapgen_settings* settings)
                 break;
         }
     }
+    layer.Apply();
 }
 
 #pragma endregion
@@ -11,19 +11,14 @@
 
 #include "Map.h"
 #include "Surface.h"
+#include "SurfaceLayer.h"
 
 #include <algorithm>
 
-static uint8_t getBaseHeightOrZero(int32_t x, int32_t y)
-{
-    auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-    return surfaceElement != nullptr ? surfaceElement->base_height : 0;
-}
-
 /**
  * Not perfect, this still leaves some particular tiles unsmoothed.
  */
-int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
+int32_t map_smooth(SurfaceLayer& layer, int32_t l, int32_t t, int32_t r, int32_t b)
 {
     int32_t i, x, y, count, doubleCorner, raisedLand = 0;
     uint8_t highest, cornerHeights[4];
@@ -31,34 +26,36 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
     {
         for (x = l; x < r; x++)
         {
-            auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-            if (surfaceElement == nullptr)
+            if (!layer.HasSurface(x, y))
                 continue;
-            surfaceElement->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
+            auto& baseHeight = layer.BaseHeight(x, y);
+            auto& clearanceHeight = layer.ClearanceHeight(x, y);
+            auto& tileSlope = layer.Slope(x, y);
+            tileSlope = TILE_ELEMENT_SLOPE_FLAT;
 
             // Raise to edge height - 2
-            highest = surfaceElement->base_height;
-            highest = std::max(highest, getBaseHeightOrZero(x - 1, y + 0));
-            highest = std::max(highest, getBaseHeightOrZero(x + 1, y + 0));
-            highest = std::max(highest, getBaseHeightOrZero(x + 0, y - 1));
-            highest = std::max(highest, getBaseHeightOrZero(x + 0, y + 1));
-            if (surfaceElement->base_height < highest - 2)
+            highest = baseHeight;
+            highest = std::max(highest, layer.GetBaseHeightOrZero(x - 1, y + 0));
+            highest = std::max(highest, layer.GetBaseHeightOrZero(x + 1, y + 0));
+            highest = std::max(highest, layer.GetBaseHeightOrZero(x + 0, y - 1));
+            highest = std::max(highest, layer.GetBaseHeightOrZero(x + 0, y + 1));
+            if (baseHeight < highest - 2)
             {
                 raisedLand = 1;
-                surfaceElement->base_height = surfaceElement->clearance_height = highest - 2;
+                baseHeight = clearanceHeight = highest - 2;
             }
 
             // Check corners
             doubleCorner = -1;
-            cornerHeights[0] = getBaseHeightOrZero(x - 1, y - 1);
-            cornerHeights[1] = getBaseHeightOrZero(x + 1, y - 1);
-            cornerHeights[2] = getBaseHeightOrZero(x + 1, y + 1);
-            cornerHeights[3] = getBaseHeightOrZero(x - 1, y + 1);
-            highest = surfaceElement->base_height;
+            cornerHeights[0] = layer.GetBaseHeightOrZero(x - 1, y - 1);
+            cornerHeights[1] = layer.GetBaseHeightOrZero(x + 1, y - 1);
+            cornerHeights[2] = layer.GetBaseHeightOrZero(x + 1, y + 1);
+            cornerHeights[3] = layer.GetBaseHeightOrZero(x - 1, y + 1);
+            highest = baseHeight;
             for (i = 0; i < 4; i++)
                 highest = std::max(highest, cornerHeights[i]);
 
-            if (highest >= surfaceElement->base_height + 4)
+            if (highest >= baseHeight + 4)
             {
                 count = 0;
                 int32_t canCompensate = 1;
@@ -75,22 +72,26 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
                         {
                             default:
                             case 0:
-                                highestOnLowestSide = std::max(getBaseHeightOrZero(x + 1, y), getBaseHeightOrZero(x, y + 1));
+                                highestOnLowestSide = std::max(
+                                    layer.GetBaseHeightOrZero(x + 1, y), layer.GetBaseHeightOrZero(x, y + 1));
                                 break;
                             case 1:
-                                highestOnLowestSide = std::max(getBaseHeightOrZero(x - 1, y), getBaseHeightOrZero(x, y + 1));
+                                highestOnLowestSide = std::max(
+                                    layer.GetBaseHeightOrZero(x - 1, y), layer.GetBaseHeightOrZero(x, y + 1));
                                 break;
                             case 2:
-                                highestOnLowestSide = std::max(getBaseHeightOrZero(x - 1, y), getBaseHeightOrZero(x, y - 1));
+                                highestOnLowestSide = std::max(
+                                    layer.GetBaseHeightOrZero(x - 1, y), layer.GetBaseHeightOrZero(x, y - 1));
                                 break;
                             case 3:
-                                highestOnLowestSide = std::max(getBaseHeightOrZero(x + 1, y), getBaseHeightOrZero(x, y - 1));
+                                highestOnLowestSide = std::max(
+                                    layer.GetBaseHeightOrZero(x + 1, y), layer.GetBaseHeightOrZero(x, y - 1));
                                 break;
                         }
 
-                        if (highestOnLowestSide > surfaceElement->base_height)
+                        if (highestOnLowestSide > baseHeight)
                         {
-                            surfaceElement->base_height = surfaceElement->clearance_height = highestOnLowestSide;
+                            baseHeight = clearanceHeight = highestOnLowestSide;
                             raisedLand = 1;
                             canCompensate = 0;
                         }
@@ -98,9 +99,9 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
 
                 if (count == 1 && canCompensate)
                 {
-                    if (surfaceElement->base_height < highest - 4)
+                    if (baseHeight < highest - 4)
                     {
-                        surfaceElement->base_height = surfaceElement->clearance_height = highest - 4;
+                        baseHeight = clearanceHeight = highest - 4;
                         raisedLand = 1;
                     }
                     if (cornerHeights[0] == highest && cornerHeights[2] <= cornerHeights[0] - 4)
@@ -114,9 +115,9 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
                 }
                 else
                 {
-                    if (surfaceElement->base_height < highest - 2)
+                    if (baseHeight < highest - 2)
                     {
-                        surfaceElement->base_height = surfaceElement->clearance_height = highest - 2;
+                        baseHeight = clearanceHeight = highest - 2;
                         raisedLand = 1;
                     }
                 }
@@ -124,7 +125,7 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
 
             if (doubleCorner != -1)
             {
-                uint8_t slope = surfaceElement->GetSlope() | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT;
+                uint8_t slope = tileSlope | TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT;
                 switch (doubleCorner)
                 {
                     case 0:
@@ -140,52 +141,44 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
                         slope |= TILE_ELEMENT_SLOPE_E_CORNER_DN;
                         break;
                 }
-                surfaceElement->SetSlope(slope);
+                tileSlope = slope;
             }
             else
             {
-                uint8_t slope = surfaceElement->GetSlope();
+                uint8_t slope = tileSlope;
                 // Corners
-                auto surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x + 1, y + 1 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x + 1, y + 1) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_N_CORNER_UP;
 
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x - 1, y + 1 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x - 1, y + 1) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_W_CORNER_UP;
 
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x + 1, y - 1 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x + 1, y - 1) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_E_CORNER_UP;
 
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x - 1, y - 1 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x - 1, y - 1) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_S_CORNER_UP;
 
                 // Sides
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x + 1, y + 0 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x + 1, y + 0) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_NE_SIDE_UP;
 
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x - 1, y + 0 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x - 1, y + 0) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_SW_SIDE_UP;
 
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x + 0, y - 1 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x + 0, y - 1) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_SE_SIDE_UP;
 
-                surfaceElement2 = map_get_surface_element_at(TileCoordsXY{ x + 0, y + 1 }.ToCoordsXY());
-                if (surfaceElement2 != nullptr && surfaceElement2->base_height > surfaceElement->base_height)
+                if (layer.GetBaseHeightOrZero(x + 0, y + 1) > baseHeight)
                     slope |= TILE_ELEMENT_SLOPE_NW_SIDE_UP;
 
                 // Raise
                 if (slope == TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
                 {
                     slope = TILE_ELEMENT_SLOPE_FLAT;
-                    surfaceElement->base_height = surfaceElement->clearance_height += 2;
+                    baseHeight = clearanceHeight += 2;
                 }
-                surfaceElement->SetSlope(slope);
+                tileSlope = slope;
             }
         }
     }
@@ -198,11 +191,13 @@ int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b)
  * This does not change the base height, unless all corners have been raised.
  * @returns 0 if no edits were made, 1 otherwise
  */
-int32_t tile_smooth(int32_t x, int32_t y)
+int32_t tile_smooth(SurfaceLayer& layer, int32_t x, int32_t y)
 {
-    auto* const surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-    if (surfaceElement == nullptr)
+    if (!layer.HasSurface(x, y))
         return 0;
+    auto& baseHeight = layer.BaseHeight(x, y);
+    auto& clearanceHeight = layer.ClearanceHeight(x, y);
+    auto& tileSlope = layer.Slope(x, y);
 
     // +-----+-----+-----+
     // |  W  | NW  |  N  |
@@ -241,12 +236,12 @@ int32_t tile_smooth(int32_t x, int32_t y)
                 continue;
 
             // Get neighbour height. If the element is not valid (outside of map) assume the same height
-            auto* neighbourSurfaceElement = map_get_surface_element_at(TileCoordsXY{ x + x_offset, y + y_offset }.ToCoordsXY());
-            neighbourHeightOffset.baseheight[index] = neighbourSurfaceElement != nullptr ? neighbourSurfaceElement->base_height
-                                                                                         : surfaceElement->base_height;
+            neighbourHeightOffset.baseheight[index] = layer.HasSurface(x + x_offset, y + y_offset)
+                ? layer.BaseHeight(x + x_offset, y + y_offset)
+                : baseHeight;
 
             // Make the height relative to the current surface element
-            neighbourHeightOffset.baseheight[index] -= surfaceElement->base_height;
+            neighbourHeightOffset.baseheight[index] -= baseHeight;
 
             index++;
         }
@@ -278,7 +273,7 @@ int32_t tile_smooth(int32_t x, int32_t y)
     }
 
     // Check if the calculated slope is the same already
-    uint8_t currentSlope = surfaceElement->GetSlope();
+    uint8_t currentSlope = tileSlope;
     if (currentSlope == slope)
     {
         return 0;
@@ -287,23 +282,24 @@ int32_t tile_smooth(int32_t x, int32_t y)
     if ((slope & TILE_ELEMENT_SLOPE_ALL_CORNERS_UP) == TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
     {
         // All corners are raised, raise the entire tile instead.
-        surfaceElement->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-        surfaceElement->base_height = (surfaceElement->clearance_height += 2);
-        if (surfaceElement->GetWaterHeight() <= surfaceElement->GetBaseZ())
+        tileSlope = TILE_ELEMENT_SLOPE_FLAT;
+        baseHeight = (clearanceHeight += 2);
+        auto& waterHeight = layer.WaterHeight(x, y);
+        if (waterHeight * 16 <= baseHeight * COORDS_Z_STEP)
         {
-            surfaceElement->SetWaterHeight(0);
+            waterHeight = 0;
         }
     }
     else
     {
         // Apply the slope to this tile
-        surfaceElement->SetSlope(slope);
+        tileSlope = slope;
 
         // Set correct clearance height
         if (slope & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT)
-            surfaceElement->clearance_height = surfaceElement->base_height + 4;
+            clearanceHeight = baseHeight + 4;
         else if (slope & TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
-            surfaceElement->clearance_height = surfaceElement->base_height + 2;
+            clearanceHeight = baseHeight + 2;
     }
 
     return 1;
@@ -19,5 +19,7 @@ enum
     SLOPE_E_THRESHOLD_FLAGS = (1 << 3)
 };
 
-int32_t map_smooth(int32_t l, int32_t t, int32_t r, int32_t b);
-int32_t tile_smooth(int32_t x, int32_t y);
+class SurfaceLayer;
+
+int32_t map_smooth(SurfaceLayer& layer, int32_t l, int32_t t, int32_t r, int32_t b);
+int32_t tile_smooth(SurfaceLayer& layer, int32_t x, int32_t y);
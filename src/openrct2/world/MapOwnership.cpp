@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MapOwnership.h"
+
+#include "Surface.h"
+
+#include <algorithm>
+
+static MapOwnershipLayer _mapOwnershipLayer;
+static uint32_t _mapOwnershipChanges = 0;
+
+MapOwnershipLayer& GetMapOwnershipLayer()
+{
+    return _mapOwnershipLayer;
+}
+
+void MapOwnershipChanged()
+{
+    _mapOwnershipChanges++;
+}
+
+void MapOwnershipLayer::Refresh()
+{
+    if (!_built || _changes != _mapOwnershipChanges || _mapSize != gMapSize)
+    {
+        Rebuild();
+    }
+}
+
+void MapOwnershipLayer::Rebuild()
+{
+    for (auto* rows : { &_owned, &_available, &_constructionRightsOwned, &_constructionRightsAvailable })
+    {
+        for (auto& row : *rows)
+        {
+            row.reset();
+        }
+    }
+
+    // Tiles outside of the map have no ownership
+    _mapSize = std::clamp(gMapSize, 0, MAXIMUM_MAP_SIZE_TECHNICAL);
+    for (int32_t y = 0; y < _mapSize; y++)
+    {
+        for (int32_t x = 0; x < _mapSize; x++)
+        {
+            // Surface elements are sometimes hacked out to save some space for other map elements
+            auto* surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (surfaceElement != nullptr)
+            {
+                SetTile(x, y, surfaceElement->GetOwnership());
+            }
+        }
+    }
+    _changes = _mapOwnershipChanges;
+    _built = true;
+}
+
+void MapOwnershipLayer::SetTile(int32_t x, int32_t y, uint8_t ownership)
+{
+    _owned[y].set(x, (ownership & OWNERSHIP_OWNED) != 0);
+    _available[y].set(x, (ownership & OWNERSHIP_AVAILABLE) != 0);
+    _constructionRightsOwned[y].set(x, (ownership & OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED) != 0);
+    _constructionRightsAvailable[y].set(x, (ownership & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE) != 0);
+}
+
+void MapOwnershipLayer::UpdateTile(const TileCoordsXY& coords)
+{
+    if (coords.x < 0 || coords.y < 0 || coords.x >= _mapSize || coords.y >= _mapSize)
+        return;
+
+    auto* surfaceElement = map_get_surface_element_at(coords.ToCoordsXY());
+    SetTile(coords.x, coords.y, surfaceElement != nullptr ? surfaceElement->GetOwnership() : OWNERSHIP_UNOWNED);
+}
+
+void MapOwnershipLayer::MarkUpToDate()
+{
+    if (_built && _mapSize == gMapSize)
+    {
+        _changes = _mapOwnershipChanges;
+    }
+}
+
+uint32_t MapOwnershipLayer::CountRemainingOwnershipSales()
+{
+    Refresh();
+
+    size_t count = 0;
+    for (int32_t y = 0; y < _mapSize; y++)
+    {
+        count += (_available[y] & ~_owned[y]).count();
+    }
+    return static_cast<uint32_t>(count);
+}
+
+uint32_t MapOwnershipLayer::CountRemainingConstructionSales()
+{
+    Refresh();
+
+    // Do not combine the owned and available conditions, some RCT1 parks have owned tiles with the 'construction
+    // rights available' flag also set. Tiles with land for sale are counted as ownership sales instead.
+    size_t count = 0;
+    for (int32_t y = 0; y < _mapSize; y++)
+    {
+        count += (_constructionRightsAvailable[y] & ~(_owned[y] | _available[y] | _constructionRightsOwned[y])).count();
+    }
+    return static_cast<uint32_t>(count);
+}
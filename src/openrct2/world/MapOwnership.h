@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../core/BitSet.hpp"
+#include "Location.hpp"
+#include "Map.h"
+
+#include <array>
+
+/**
+ * Dense bitmaps of the ownership flags of the surface elements, one bit per tile for each flag, so questions about the
+ * ownership of the whole map are answered with bulk bit operations on whole rows instead of visiting every tile.
+ * Any change to the ownership or the tile elements of the map marks the layer as out of date, Refresh rebuilds it.
+ */
+class MapOwnershipLayer
+{
+private:
+    using Row = OpenRCT2::BitSet<MAXIMUM_MAP_SIZE_TECHNICAL>;
+    using Rows = std::array<Row, MAXIMUM_MAP_SIZE_TECHNICAL>;
+
+    Rows _owned;
+    Rows _available;
+    Rows _constructionRightsOwned;
+    Rows _constructionRightsAvailable;
+    int32_t _mapSize{};
+    // The value of the map ownership change counter the layer was built for.
+    uint32_t _changes{};
+    bool _built{};
+
+public:
+    /**
+     * Rebuilds the layer from the surface elements if the ownership of the map changed since it was last built.
+     */
+    void Refresh();
+
+    /**
+     * Copies the ownership of the surface element of the tile into the layer.
+     */
+    void UpdateTile(const TileCoordsXY& coords);
+
+    /**
+     * Marks the layer as up to date after the changes since the last Refresh were all copied with UpdateTile.
+     */
+    void MarkUpToDate();
+
+    /**
+     * @return the number of tiles that are not owned yet but can be bought.
+     */
+    uint32_t CountRemainingOwnershipSales();
+
+    /**
+     * @return the number of tiles whose construction rights are not owned yet but can be bought.
+     */
+    uint32_t CountRemainingConstructionSales();
+
+private:
+    void Rebuild();
+    void SetTile(int32_t x, int32_t y, uint8_t ownership);
+};
+
+MapOwnershipLayer& GetMapOwnershipLayer();
+
+/**
+ * Records that the ownership of the map may have changed, called whenever surface ownership or tile elements change.
+ */
+void MapOwnershipChanged();
@@ -19,6 +19,7 @@
 #include "../config/Config.h"
 #include "../core/Memory.hpp"
 #include "../core/String.hpp"
+#include "../entity/Guest.h"
 #include "../entity/Litter.h"
 #include "../entity/Peep.h"
 #include "../entity/Staff.h"
@@ -59,8 +60,8 @@ money64 gParkValue;
 money64 gCompanyValue;
 
 int16_t gParkRatingCasualtyPenalty;
-uint8_t gParkRatingHistory[32];
-uint32_t gGuestsInParkHistory[32];
+HistoryBuffer<uint8_t, 32, ParkRatingHistoryUndefined> gParkRatingHistory;
+HistoryBuffer<uint32_t, 32, GuestsInParkHistoryUndefined> gGuestsInParkHistory;
 
 // If this value is more than or equal to 0, the park rating is forced to this value. Used for cheat
 static int32_t _forcedParkRating = -1;
@@ -307,10 +308,19 @@ void Park::Initialise()
 
 void Park::Update(const Date& date)
 {
+    // The park rating and its history are both calculated from the same guest statistics.
+    bool isRatingUpdate = gCurrentTicks % 512 == 0;
+    bool isWeekStart = date.IsWeekStart();
+    GuestStatistics guestStats;
+    if (isRatingUpdate || isWeekStart)
+    {
+        guestStats = GuestStatistics::Collect();
+    }
+
     // Every ~13 seconds
-    if (gCurrentTicks % 512 == 0)
+    if (isRatingUpdate)
     {
-        gParkRating = CalculateParkRating();
+        gParkRating = CalculateParkRating(guestStats);
         gParkValue = CalculateParkValue();
         gCompanyValue = CalculateCompanyValue();
         gTotalRideValueForMoney = CalculateTotalRideValueForMoney();
@@ -328,9 +338,9 @@ void Park::Update(const Date& date)
         window_invalidate_by_class(WC_PARK_INFORMATION);
     }
     // Every new week
-    if (date.IsWeekStart())
+    if (isWeekStart)
     {
-        UpdateHistories();
+        UpdateHistories(guestStats);
     }
     GenerateGuests();
 }
@@ -361,6 +371,15 @@ int32_t Park::CalculateParkSize() const
 }
 
 int32_t Park::CalculateParkRating() const
+{
+    if (_forcedParkRating >= 0)
+    {
+        return _forcedParkRating;
+    }
+    return CalculateParkRating(GuestStatistics::Collect());
+}
+
+int32_t Park::CalculateParkRating(const GuestStatistics& guestStats) const
 {
     if (_forcedParkRating >= 0)
     {
@@ -378,23 +397,9 @@ int32_t Park::CalculateParkRating() const
         // -150 to +3 based on a range of guests from 0 to 2000
         result -= 150 - (std::min<int16_t>(2000, gNumGuestsInPark) / 13);
 
-        // Find the number of happy peeps and the number of peeps who can't find the park exit
-        uint32_t happyGuestCount = 0;
-        uint32_t lostGuestCount = 0;
-        for (auto peep : EntityList<Guest>())
-        {
-            if (!peep->OutsideOfPark)
-            {
-                if (peep->Happiness > 128)
-                {
-                    happyGuestCount++;
-                }
-                if ((peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && (peep->GuestIsLostCountdown < 90))
-                {
-                    lostGuestCount++;
-                }
-            }
-        }
+        // The number of happy peeps and the number of peeps who can't find the park exit
+        uint32_t happyGuestCount = guestStats.HappyGuests;
+        uint32_t lostGuestCount = guestStats.LostGuests;
 
         // Peep happiness -500 to +0
         result -= 500;
@@ -721,22 +726,13 @@ Guest* Park::GenerateGuest()
     return peep;
 }
 
-template<typename T, size_t TSize> static void HistoryPushRecord(T history[TSize], T newItem)
-{
-    for (size_t i = TSize - 1; i > 0; i--)
-    {
-        history[i] = history[i - 1];
-    }
-    history[0] = newItem;
-}
-
 void Park::ResetHistories()
 {
-    std::fill(std::begin(gParkRatingHistory), std::end(gParkRatingHistory), ParkRatingHistoryUndefined);
-    std::fill(std::begin(gGuestsInParkHistory), std::end(gGuestsInParkHistory), GuestsInParkHistoryUndefined);
+    gParkRatingHistory.Fill(ParkRatingHistoryUndefined);
+    gGuestsInParkHistory.Fill(GuestsInParkHistoryUndefined);
 }
 
-void Park::UpdateHistories()
+void Park::UpdateHistories(const GuestStatistics& guestStats)
 {
     uint8_t guestChangeModifier = 1;
     int32_t changeInGuestsInPark = static_cast<int32_t>(gNumGuestsInPark) - static_cast<int32_t>(gNumGuestsInParkLastWeek);
@@ -752,9 +748,9 @@ void Park::UpdateHistories()
     gNumGuestsInParkLastWeek = gNumGuestsInPark;
 
     // Update park rating, guests in park and current cash history
-    HistoryPushRecord<uint8_t, 32>(gParkRatingHistory, CalculateParkRating() / 4);
-    HistoryPushRecord<uint32_t, 32>(gGuestsInParkHistory, gNumGuestsInPark);
-    HistoryPushRecord<money64, std::size(gCashHistory)>(gCashHistory, finance_get_current_cash() - gBankLoan);
+    gParkRatingHistory.Push(CalculateParkRating(guestStats) / 4);
+    gGuestsInParkHistory.Push(gNumGuestsInPark);
+    gCashHistory.Push(finance_get_current_cash() - gBankLoan);
 
     // Update weekly profit history
     auto currentWeeklyProfit = gWeeklyProfitAverageDividend;
@@ -762,12 +758,12 @@ void Park::UpdateHistories()
     {
         currentWeeklyProfit /= gWeeklyProfitAverageDivisor;
     }
-    HistoryPushRecord<money64, std::size(gWeeklyProfitHistory)>(gWeeklyProfitHistory, currentWeeklyProfit);
+    gWeeklyProfitHistory.Push(currentWeeklyProfit);
     gWeeklyProfitAverageDividend = 0;
     gWeeklyProfitAverageDivisor = 0;
 
     // Update park value history
-    HistoryPushRecord<money64, std::size(gParkValueHistory)>(gParkValueHistory, gParkValue);
+    gParkValueHistory.Push(gParkValue);
 
     // Invalidate relevant windows
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/HistoryBuffer.h"
 #include "Map.h"
 
 #define MAX_ENTRANCE_FEE MONEY(200, 00)
@@ -37,10 +38,12 @@ enum : uint32_t
     PARK_FLAGS_NO_MONEY_SCENARIO = (1 << 17),                 // equivalent to PARK_FLAGS_NO_MONEY, but used in scenario editor
     PARK_FLAGS_SPRITES_INITIALISED = (1 << 18),  // After a scenario is loaded this prevents edits in the scenario editor
     PARK_FLAGS_SIX_FLAGS_DEPRECATED = (1 << 19), // Not used anymore
+    PARK_FLAGS_GUEST_FLOW_FIELD_NAVIGATION = (1 << 20), // OpenRCT2 only!
     PARK_FLAGS_UNLOCK_ALL_PRICES = (1u << 31),   // OpenRCT2 only!
 };
 
 struct Guest;
+struct GuestStatistics;
 struct rct_ride;
 
 namespace OpenRCT2
@@ -66,6 +69,7 @@ namespace OpenRCT2
 
         int32_t CalculateParkSize() const;
         int32_t CalculateParkRating() const;
+        int32_t CalculateParkRating(const GuestStatistics& guestStats) const;
         money64 CalculateParkValue() const;
         money64 CalculateCompanyValue() const;
         static uint8_t CalculateGuestInitialHappiness(uint8_t percentage);
@@ -73,7 +77,7 @@ namespace OpenRCT2
         Guest* GenerateGuest();
 
         void ResetHistories();
-        void UpdateHistories();
+        void UpdateHistories(const GuestStatistics& guestStats);
 
     private:
         money64 CalculateRideValue(const Ride* ride) const;
@@ -100,8 +104,8 @@ extern money64 gParkValue;
 extern money64 gCompanyValue;
 
 extern int16_t gParkRatingCasualtyPenalty;
-extern uint8_t gParkRatingHistory[32];
-extern uint32_t gGuestsInParkHistory[32];
+extern HistoryBuffer<uint8_t, 32, ParkRatingHistoryUndefined> gParkRatingHistory;
+extern HistoryBuffer<uint32_t, 32, GuestsInParkHistoryUndefined> gGuestsInParkHistory;
 extern int32_t _guestGenerationProbability;
 extern uint32_t _suggestedGuestMaximum;
 
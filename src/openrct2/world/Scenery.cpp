@@ -122,24 +122,51 @@ int32_t LargeSceneryText::MeasureHeight(std::string_view text) const
 
 void scenery_update_tile(const CoordsXY& sceneryPos)
 {
-    TileElement* tileElement;
+    static std::vector<SmallSceneryAgeUpdate> ageUpdates;
+    ageUpdates.clear();
+    scenery_plan_tile_update(sceneryPos, ageUpdates);
+    scenery_apply_tile_update(sceneryPos, ageUpdates.data());
+}
 
-    tileElement = map_get_first_element_at(sceneryPos);
+// Ghosts are purely this-client-side and should not cause any interaction,
+// as that may lead to a desync.
+static bool scenery_update_should_skip(const TileElement* tileElement)
+{
+    return network_get_mode() != NETWORK_MODE_NONE && tileElement->IsGhost();
+}
+
+void scenery_plan_tile_update(const CoordsXY& sceneryPos, std::vector<SmallSceneryAgeUpdate>& ageUpdates)
+{
+    const auto* tileElement = map_get_first_element_at(sceneryPos);
     if (tileElement == nullptr)
         return;
     do
     {
-        // Ghosts are purely this-client-side and should not cause any interaction,
-        // as that may lead to a desync.
-        if (network_get_mode() != NETWORK_MODE_NONE)
+        if (scenery_update_should_skip(tileElement))
+            continue;
+
+        if (tileElement->GetType() == TileElementType::SmallScenery)
         {
-            if (tileElement->IsGhost())
-                continue;
+            ageUpdates.push_back(tileElement->AsSmallScenery()->GetAgeUpdate());
         }
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+void scenery_apply_tile_update(const CoordsXY& sceneryPos, const SmallSceneryAgeUpdate* ageUpdates)
+{
+    TileElement* tileElement;
+
+    tileElement = map_get_first_element_at(sceneryPos);
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        if (scenery_update_should_skip(tileElement))
+            continue;
 
         if (tileElement->GetType() == TileElementType::SmallScenery)
         {
-            tileElement->AsSmallScenery()->UpdateAge(sceneryPos);
+            tileElement->AsSmallScenery()->ApplyAgeUpdate(*ageUpdates++, sceneryPos);
         }
         else if (tileElement->GetType() == TileElementType::Path)
         {
@@ -168,25 +195,31 @@ void scenery_update_tile(const CoordsXY& sceneryPos)
  */
 void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
 {
+    ApplyAgeUpdate(GetAgeUpdate(), sceneryPos);
+}
+
+SmallSceneryAgeUpdate SmallSceneryElement::GetAgeUpdate() const
+{
+    SmallSceneryAgeUpdate result;
     auto* sceneryEntry = GetEntry();
     if (sceneryEntry == nullptr)
     {
-        return;
+        return result;
     }
 
     if (gCheatsDisablePlantAging && sceneryEntry->HasFlag(SMALL_SCENERY_FLAG_CAN_BE_WATERED))
     {
-        return;
+        return result;
     }
 
+    result.Action = SmallSceneryAgeUpdate::ActionType::IncreaseAge;
     if (!sceneryEntry->HasFlag(SMALL_SCENERY_FLAG_CAN_BE_WATERED) || WeatherIsDry(gClimateCurrent.Weather) || GetAge() < 5)
     {
-        IncreaseAge(sceneryPos);
-        return;
+        return result;
     }
 
     // Check map elements above, presumably to see if map element is blocked from weather
-    TileElement* tileElementAbove = reinterpret_cast<TileElement*>(this);
+    const TileElement* tileElementAbove = reinterpret_cast<const TileElement*>(this);
     // Change from original: RCT2 only checked for the first three quadrants, which was very likely to be a bug.
     while (!(tileElementAbove->GetOccupiedQuadrants()))
     {
@@ -202,15 +235,13 @@ void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
             case TileElementType::LargeScenery:
             case TileElementType::Entrance:
             case TileElementType::Path:
-                map_invalidate_tile_zoom1({ sceneryPos, tileElementAbove->GetBaseZ(), tileElementAbove->GetClearanceZ() });
-                IncreaseAge(sceneryPos);
-                return;
+                result.Shelter = tileElementAbove;
+                return result;
             case TileElementType::SmallScenery:
                 sceneryEntry = tileElementAbove->AsSmallScenery()->GetEntry();
                 if (sceneryEntry->HasFlag(SMALL_SCENERY_FLAG_VOFFSET_CENTRE))
                 {
-                    IncreaseAge(sceneryPos);
-                    return;
+                    return result;
                 }
                 break;
             default:
@@ -219,8 +250,28 @@ void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
     }
 
     // Reset age / water plant
-    SetAge(0);
-    map_invalidate_tile_zoom1({ sceneryPos, GetBaseZ(), GetClearanceZ() });
+    result.Action = SmallSceneryAgeUpdate::ActionType::Water;
+    return result;
+}
+
+void SmallSceneryElement::ApplyAgeUpdate(const SmallSceneryAgeUpdate& update, const CoordsXY& sceneryPos)
+{
+    switch (update.Action)
+    {
+        case SmallSceneryAgeUpdate::ActionType::None:
+            break;
+        case SmallSceneryAgeUpdate::ActionType::IncreaseAge:
+            if (update.Shelter != nullptr)
+            {
+                map_invalidate_tile_zoom1({ sceneryPos, update.Shelter->GetBaseZ(), update.Shelter->GetClearanceZ() });
+            }
+            IncreaseAge(sceneryPos);
+            break;
+        case SmallSceneryAgeUpdate::ActionType::Water:
+            SetAge(0);
+            map_invalidate_tile_zoom1({ sceneryPos, GetBaseZ(), GetClearanceZ() });
+            break;
+    }
 }
 
 /**
@@ -16,6 +16,7 @@
 
 #include <limits>
 #include <string_view>
+#include <vector>
 
 #define SCENERY_WITHER_AGE_THRESHOLD_1 0x28
 #define SCENERY_WITHER_AGE_THRESHOLD_2 0x37
@@ -275,6 +276,8 @@ extern money64 gClearSceneryCost;
 
 void init_scenery();
 void scenery_update_tile(const CoordsXY& sceneryPos);
+void scenery_plan_tile_update(const CoordsXY& sceneryPos, std::vector<SmallSceneryAgeUpdate>& ageUpdates);
+void scenery_apply_tile_update(const CoordsXY& sceneryPos, const SmallSceneryAgeUpdate* ageUpdates);
 void scenery_set_default_placement_configuration();
 void scenery_remove_ghost_tool_placement();
 
@@ -16,6 +16,7 @@
 #include "../scenario/Scenario.h"
 #include "Location.hpp"
 #include "Map.h"
+#include "MapOwnership.h"
 
 uint32_t SurfaceElement::GetSurfaceStyle() const
 {
@@ -114,21 +115,19 @@ void SurfaceElement::SetGrassLengthAndInvalidate(uint8_t length, const CoordsXY&
  *  rct2: 0x006647A1
  */
 void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
+{
+    ApplyGrassUpdate(GetGrassUpdate(coords), coords);
+}
+
+GrassUpdate SurfaceElement::GetGrassUpdate(const CoordsXY& coords) const
 {
     // Check if tile is grass
     if (!CanGrassGrow())
-        return;
-
-    uint8_t grassLengthTmp = GrassLength & 7;
+        return GrassUpdate::None;
 
     // Check if grass is underwater or outside park
     if (GetWaterHeight() > GetBaseZ() || !map_is_location_in_park(coords))
-    {
-        if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
-            SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
-
-        return;
-    }
+        return GrassUpdate::Clear;
 
     // Grass can't grow any further than CLUMPS_2 but this code also cuts grass
     // if there is an object placed on top of it.
@@ -139,13 +138,38 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
         clearZ += LAND_HEIGHT_STEP;
 
     // Check objects above grass
-    TileElement* tileElementAbove = reinterpret_cast<TileElement*>(this);
-    for (;;)
+    const TileElement* tileElementAbove = reinterpret_cast<const TileElement*>(this);
+    while (!tileElementAbove->IsLastForTile())
     {
-        if (tileElementAbove->IsLastForTile())
-        {
-            // Grow grass
+        tileElementAbove++;
+        if (tileElementAbove->GetType() == TileElementType::Wall)
+            continue;
+        // Grass should not be affected by ghost elements.
+        if (tileElementAbove->IsGhost())
+            continue;
+        if (baseZ >= tileElementAbove->GetClearanceZ())
+            continue;
+        if (clearZ < tileElementAbove->GetBaseZ())
+            continue;
+
+        return GrassUpdate::Clear;
+    }
+    return GrassUpdate::Grow;
+}
 
+void SurfaceElement::ApplyGrassUpdate(GrassUpdate update, const CoordsXY& coords)
+{
+    uint8_t grassLengthTmp = GrassLength & 7;
+    switch (update)
+    {
+        case GrassUpdate::None:
+            break;
+        case GrassUpdate::Clear:
+            if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
+                SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
+            break;
+        case GrassUpdate::Grow:
+        {
             // Check interim grass lengths
             uint8_t lengthNibble = (GetGrassLength() & 0xF0) >> 4;
             if (lengthNibble < 0xF)
@@ -169,24 +193,8 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
                         SetGrassLengthAndInvalidate(grassLengthTmp + 1, coords);
                 }
             }
+            break;
         }
-        else
-        {
-            tileElementAbove++;
-            if (tileElementAbove->GetType() == TileElementType::Wall)
-                continue;
-            // Grass should not be affected by ghost elements.
-            if (tileElementAbove->IsGhost())
-                continue;
-            if (baseZ >= tileElementAbove->GetClearanceZ())
-                continue;
-            if (clearZ < tileElementAbove->GetBaseZ())
-                continue;
-
-            if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
-                SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
-        }
-        break;
     }
 }
 
@@ -199,6 +207,7 @@ void SurfaceElement::SetOwnership(uint8_t newOwnership)
 {
     Ownership &= ~TILE_ELEMENT_SURFACE_OWNERSHIP_MASK;
     Ownership |= (newOwnership & TILE_ELEMENT_SURFACE_OWNERSHIP_MASK);
+    MapOwnershipChanged();
 }
 
 uint8_t SurfaceElement::GetParkFences() const
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SurfaceLayer.h"
+
+#include "Map.h"
+#include "Surface.h"
+
+void SurfaceLayer::Build()
+{
+    _mapSize = gMapSize;
+    const auto numTiles = static_cast<size_t>(_mapSize) * _mapSize;
+    _elements.resize(numTiles);
+    _baseHeight.assign(numTiles, 0);
+    _clearanceHeight.assign(numTiles, 0);
+    _slope.assign(numTiles, 0);
+    _waterHeight.assign(numTiles, 0);
+
+    for (int32_t y = 0; y < _mapSize; y++)
+    {
+        for (int32_t x = 0; x < _mapSize; x++)
+        {
+            const auto index = GetIndex(x, y);
+            auto* surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            _elements[index] = surfaceElement;
+            if (surfaceElement != nullptr)
+            {
+                _baseHeight[index] = surfaceElement->base_height;
+                _clearanceHeight[index] = surfaceElement->clearance_height;
+                _slope[index] = surfaceElement->GetSlope();
+                _waterHeight[index] = surfaceElement->GetWaterHeight() / 16;
+            }
+        }
+    }
+}
+
+void SurfaceLayer::Apply() const
+{
+    for (size_t index = 0; index < _elements.size(); index++)
+    {
+        auto* surfaceElement = _elements[index];
+        if (surfaceElement != nullptr)
+        {
+            surfaceElement->base_height = _baseHeight[index];
+            surfaceElement->clearance_height = _clearanceHeight[index];
+            surfaceElement->SetSlope(_slope[index]);
+            surfaceElement->SetWaterHeight(_waterHeight[index] * 16);
+        }
+    }
+}
+
+void SurfaceLayer::FillHeight(int32_t left, int32_t right, int32_t y, uint8_t height)
+{
+    const auto rowStart = GetIndex(0, y);
+    for (int32_t x = left; x < right; x++)
+    {
+        const auto index = rowStart + x;
+        if (_elements[index] != nullptr)
+        {
+            _baseHeight[index] = height;
+            _clearanceHeight[index] = height;
+        }
+    }
+}
+
+void SurfaceLayer::FillWater(int32_t left, int32_t right, int32_t y, uint8_t waterLevel, uint8_t waterHeight)
+{
+    const auto rowStart = GetIndex(0, y);
+    const auto* baseHeight = &_baseHeight[rowStart];
+    auto* water = &_waterHeight[rowStart];
+    for (int32_t x = left; x < right; x++)
+    {
+        // Branch free so the compiler can vectorise the row
+        water[x] = baseHeight[x] < waterLevel ? waterHeight : water[x];
+    }
+}
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <vector>
+
+struct SurfaceElement;
+
+/**
+ * Dense copy of the surface elements of the map, each property is kept in its own array so passes over the whole map
+ * only touch the bytes they need and rows can be processed as contiguous runs.
+ * The layer is a snapshot of the tiles within the map size, changes are only written back to the surface elements by
+ * Apply. Tile elements must not be inserted or removed while a layer is in use as it keeps pointers to the surfaces.
+ */
+class SurfaceLayer
+{
+private:
+    int32_t _mapSize{};
+    std::vector<SurfaceElement*> _elements;
+    std::vector<uint8_t> _baseHeight;
+    std::vector<uint8_t> _clearanceHeight;
+    std::vector<uint8_t> _slope;
+    // Water height in the same units as the surface element, see SurfaceElement::GetWaterHeight.
+    std::vector<uint8_t> _waterHeight;
+
+public:
+    void Build();
+    void Apply() const;
+
+    int32_t GetMapSize() const
+    {
+        return _mapSize;
+    }
+
+    bool HasSurface(int32_t x, int32_t y) const
+    {
+        return x >= 0 && y >= 0 && x < _mapSize && y < _mapSize && _elements[GetIndex(x, y)] != nullptr;
+    }
+
+    uint8_t GetBaseHeightOrZero(int32_t x, int32_t y) const
+    {
+        return HasSurface(x, y) ? _baseHeight[GetIndex(x, y)] : 0;
+    }
+
+    uint8_t& BaseHeight(int32_t x, int32_t y)
+    {
+        return _baseHeight[GetIndex(x, y)];
+    }
+
+    uint8_t& ClearanceHeight(int32_t x, int32_t y)
+    {
+        return _clearanceHeight[GetIndex(x, y)];
+    }
+
+    uint8_t& Slope(int32_t x, int32_t y)
+    {
+        return _slope[GetIndex(x, y)];
+    }
+
+    uint8_t& WaterHeight(int32_t x, int32_t y)
+    {
+        return _waterHeight[GetIndex(x, y)];
+    }
+
+    SurfaceElement* GetElement(int32_t x, int32_t y) const
+    {
+        return _elements[GetIndex(x, y)];
+    }
+
+    /**
+     * Sets the base and clearance height of the tiles in [left, right) on row y, tiles without a surface are skipped.
+     */
+    void FillHeight(int32_t left, int32_t right, int32_t y, uint8_t height);
+
+    /**
+     * Raises the water of the tiles in [left, right) on row y to waterHeight where the land is below waterLevel.
+     */
+    void FillWater(int32_t left, int32_t right, int32_t y, uint8_t waterLevel, uint8_t waterHeight);
+
+private:
+    size_t GetIndex(int32_t x, int32_t y) const
+    {
+        return static_cast<size_t>(x) + static_cast<size_t>(y) * _mapSize;
+    }
+};
@@ -10,14 +10,18 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/LargePageAllocator.h"
 #include "../ride/RideTypes.h"
 #include "../ride/Station.h"
 #include "Banner.h"
 #include "Footpath.h"
 #include "tile_element/TileElementType.h"
 
+#include <vector>
+
 struct Banner;
 struct CoordsXY;
+struct TileElement;
 struct LargeSceneryEntry;
 struct SmallSceneryEntry;
 struct WallSceneryEntry;
@@ -35,6 +39,33 @@ using track_type_t = uint16_t;
 constexpr const uint8_t MAX_ELEMENT_HEIGHT = 255;
 constexpr const uint8_t OWNER_MASK = 0b00001111;
 
+/**
+ * Outcome of a grass length update, decided from the tile alone so it can be worked out off the game thread.
+ */
+enum class GrassUpdate : uint8_t
+{
+    None,
+    Clear,
+    Grow,
+};
+
+/**
+ * Outcome of a small scenery age update, decided from the tile alone so it can be worked out off the game thread.
+ */
+struct SmallSceneryAgeUpdate
+{
+    enum class ActionType : uint8_t
+    {
+        None,
+        IncreaseAge,
+        Water,
+    };
+
+    ActionType Action = ActionType::None;
+    // Element above that shelters the scenery from the weather, redrawn when the scenery ages.
+    const TileElement* Shelter = nullptr;
+};
+
 #pragma pack(push, 1)
 
 struct TileElement;
@@ -216,6 +247,8 @@ public:
     void SetGrassLength(uint8_t newLength);
     void SetGrassLengthAndInvalidate(uint8_t newLength, const CoordsXY& coords);
     void UpdateGrassLength(const CoordsXY& coords);
+    GrassUpdate GetGrassUpdate(const CoordsXY& coords) const;
+    void ApplyGrassUpdate(GrassUpdate update, const CoordsXY& coords);
 
     uint8_t GetOwnership() const;
     void SetOwnership(uint8_t newOwnership);
@@ -452,6 +485,8 @@ public:
     bool NeedsSupports() const;
     void SetNeedsSupports();
     void UpdateAge(const CoordsXY& sceneryPos);
+    SmallSceneryAgeUpdate GetAgeUpdate() const;
+    void ApplyAgeUpdate(const SmallSceneryAgeUpdate& update, const CoordsXY& sceneryPos);
 };
 assert_struct_size(SmallSceneryElement, 16);
 
@@ -705,3 +740,6 @@ enum
 };
 
 bool tile_element_is_underground(TileElement* tileElement);
+
+// Storage for the tile elements of a map, large enough to be worth backing with large pages.
+using TileElementVector = std::vector<TileElement, OpenRCT2::LargePageAllocator<TileElement>>;
@@ -12,6 +12,7 @@
 #include "TileElement.h"
 
 #include <iterator>
+#include <type_traits>
 
 namespace OpenRCT2
 {
@@ -115,6 +116,11 @@ namespace OpenRCT2
 
             if constexpr (!std::is_same_v<T, TileElement>)
             {
+                // Skip the walk entirely if the tile has never had an element of this type.
+                if (!MapTileHasElementType(TileCoordsXY{ _loc }, std::remove_const_t<T>::ElementType))
+                {
+                    return end();
+                }
                 element = Detail::NextMatchingTile<T>(element);
             }
 
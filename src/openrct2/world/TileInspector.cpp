@@ -71,6 +71,7 @@ namespace OpenRCT2::TileInspector
             secondElement->SetLastForTile(!secondElement->IsLastForTile());
         }
 
+        MapUpdateTileSummary(TileCoordsXY{ loc });
         return true;
     }
 
@@ -165,6 +166,7 @@ namespace OpenRCT2::TileInspector
 
             tile_element_remove(tileElement);
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -196,6 +198,7 @@ namespace OpenRCT2::TileInspector
                 return GameActions::Result(GameActions::Status::Unknown, STR_NONE, STR_NONE);
             }
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -287,6 +290,7 @@ namespace OpenRCT2::TileInspector
             }
 
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -355,8 +359,10 @@ namespace OpenRCT2::TileInspector
             bool lastForTile = pastedElement->IsLastForTile();
             *pastedElement = element;
             pastedElement->SetLastForTile(lastForTile);
+            MapUpdateTileSummary(TileCoordsXY{ loc });
 
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -421,6 +427,7 @@ namespace OpenRCT2::TileInspector
             }
 
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -497,6 +504,7 @@ namespace OpenRCT2::TileInspector
             tileElement->clearance_height += heightOffset;
 
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -622,6 +630,7 @@ namespace OpenRCT2::TileInspector
             pathElement->AsPath()->SetSloped(sloped);
 
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -667,6 +676,7 @@ namespace OpenRCT2::TileInspector
             pathElement->AsPath()->SetEdgesAndCorners(newEdges);
 
             map_invalidate_tile_full(loc);
+            footpath_mark_wide_flags_dirty(loc);
 
             if (auto* inspector = GetTileInspectorWithPos(loc); inspector != nullptr)
             {
@@ -52,4 +52,9 @@ public:
     {
         TilePointers[coords.x + (coords.y * MapSize)] = tileElement;
     }
+
+    size_t GetMemoryUsage() const
+    {
+        return TilePointers.capacity() * sizeof(T*);
+    }
 };
@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+#include "TileElement.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Per tile summary kept next to the TilePointerIndex, so lookups for a single element type can skip tiles that do not
+ * have one and surface lookups can jump straight to the element.
+ * The summary must be refreshed whenever the elements of a tile are added, removed or reordered.
+ */
+class TileSummaryIndex
+{
+public:
+    static constexpr uint16_t NoSurface = UINT16_MAX;
+
+private:
+    struct TileSummary
+    {
+        // Offset of the first surface element from the first element of the tile.
+        uint16_t SurfaceOffset = NoSurface;
+        uint8_t TypeMask = 0;
+    };
+
+    std::vector<TileSummary> Summaries;
+    uint16_t MapSize{};
+
+public:
+    TileSummaryIndex() = default;
+
+    explicit TileSummaryIndex(const uint16_t mapSize)
+    {
+        MapSize = mapSize;
+        Summaries.resize(MapSize * MapSize);
+    }
+
+    void Update(TileCoordsXY coords, const TileElement* firstElement)
+    {
+        TileSummary summary;
+        if (firstElement != nullptr)
+        {
+            const auto* element = firstElement;
+            do
+            {
+                auto type = element->GetType();
+                summary.TypeMask |= 1 << static_cast<uint8_t>(type);
+                if (type == TileElementType::Surface && summary.SurfaceOffset == NoSurface)
+                {
+                    summary.SurfaceOffset = static_cast<uint16_t>(element - firstElement);
+                }
+            } while (!(element++)->IsLastForTile());
+        }
+        Summaries[coords.x + (coords.y * MapSize)] = summary;
+    }
+
+    bool HasElementType(TileCoordsXY coords, TileElementType type) const
+    {
+        return (Summaries[coords.x + (coords.y * MapSize)].TypeMask & (1 << static_cast<uint8_t>(type))) != 0;
+    }
+
+    uint16_t GetSurfaceOffset(TileCoordsXY coords) const
+    {
+        return Summaries[coords.x + (coords.y * MapSize)].SurfaceOffset;
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return Summaries.capacity() * sizeof(TileSummary);
+    }
+};
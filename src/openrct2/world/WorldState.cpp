@@ -0,0 +1,26 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "WorldState.h"
+
+namespace OpenRCT2
+{
+    static WorldState _defaultWorldState;
+    static thread_local WorldState* _currentWorldState = nullptr;
+
+    WorldState& GetWorldState()
+    {
+        return _currentWorldState != nullptr ? *_currentWorldState : _defaultWorldState;
+    }
+
+    void SetCurrentWorldState(WorldState* worldState)
+    {
+        _currentWorldState = worldState;
+    }
+} // namespace OpenRCT2
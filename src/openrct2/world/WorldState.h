@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "TileElement.h"
+#include "TilePointerIndex.hpp"
+#include "TileSummaryIndex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OpenRCT2
+{
+    /**
+     * The tile elements of a map and the indices over them.
+     */
+    struct TileStorage
+    {
+        TileElementVector Elements;
+        // Slots in Elements that do not belong to any tile, either left behind by a relocated tile or reserved as slack.
+        std::vector<bool> Free;
+        TilePointerIndex<TileElement> Index;
+        TileSummaryIndex Summaries;
+        size_t ElementsInUse{};
+
+        size_t GetMemoryUsage() const
+        {
+            return Elements.capacity() * sizeof(TileElement) + Index.GetMemoryUsage() + Summaries.GetMemoryUsage();
+        }
+    };
+
+    /**
+     * The state of a single park. Most of the game state is still held in globals, subsystems are moved in here one at a
+     * time.
+     *
+     * Every thread works on the world state that is current on it, the process wide default one unless another has been
+     * made current. Parks held in separate world states can therefore be run on separate threads, sharing the loaded
+     * assets. Jobs a thread hands to other threads must make the same world state current on them.
+     */
+    struct WorldState
+    {
+        TileStorage Tiles;
+        // The map stashed away while another one is loaded temporarily, e.g. to preview a track design.
+        TileStorage TilesStash;
+        int32_t MapSizeStash{};
+        int32_t CurrentRotationStash{};
+    };
+
+    /**
+     * @return the world state current on the calling thread.
+     */
+    WorldState& GetWorldState();
+
+    /**
+     * Makes the given world state current on the calling thread, nullptr makes the default one current again.
+     */
+    void SetCurrentWorldState(WorldState* worldState);
+} // namespace OpenRCT2
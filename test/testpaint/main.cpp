@@ -8,14 +8,18 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cerrno>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 #if defined(__unix__)
+#    include <poll.h>
 #    include <sys/mman.h>
+#    include <sys/wait.h>
 #    include <unistd.h>
 #endif // defined(__unix__)
 
@@ -36,6 +40,12 @@ struct TestCase
     std::vector<uint8_t> trackTypes;
 };
 
+struct TestResult
+{
+    uint8_t retVal = TEST_FAILED;
+    std::string out;
+};
+
 enum CLIColour
 {
     DEFAULT,
@@ -449,6 +459,173 @@ static void TestGeneralSupportHeightCall()
     assert(!success);
 }
 
+#if defined(__unix__)
+
+static bool WriteAll(int fd, const void* data, size_t length)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    while (length > 0)
+    {
+        auto written = write(fd, bytes, length);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        bytes += written;
+        length -= written;
+    }
+    return true;
+}
+
+/**
+ * Runs the tests in worker processes, each running every jobs-th test. The original game code keeps its state at
+ * fixed addresses so tests cannot run on several threads of one process, but every forked worker has its own copy.
+ * The results are returned in the order of the tests, whatever order the workers finish them in. Tests of a worker
+ * that crashed are reported as failed.
+ */
+static std::vector<TestResult> RunTestsInWorkers(const std::vector<std::pair<uint8_t, uint8_t>>& tests, int jobs)
+{
+    std::vector<TestResult> results(tests.size());
+    for (auto& result : results)
+    {
+        result.out = "Worker process exited before running the test\n";
+    }
+
+    struct Worker
+    {
+        pid_t pid;
+        int fd;
+        std::vector<uint8_t> buffer;
+    };
+    std::vector<Worker> workers;
+
+    fflush(stdout);
+    for (int job = 0; job < jobs; job++)
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            perror("pipe");
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            perror("fork");
+            close(fds[0]);
+            close(fds[1]);
+            break;
+        }
+        if (pid == 0)
+        {
+            close(fds[0]);
+            for (size_t i = job; i < tests.size(); i += jobs)
+            {
+                std::string out;
+                const uint8_t retVal = TestTrack::TestPaintTrackElement(tests[i].first, tests[i].second, &out);
+                const uint32_t header[3] = { static_cast<uint32_t>(i), retVal, static_cast<uint32_t>(out.size()) };
+                if (!WriteAll(fds[1], header, sizeof(header)) || !WriteAll(fds[1], out.data(), out.size()))
+                {
+                    _exit(1);
+                }
+            }
+            _exit(0);
+        }
+
+        close(fds[1]);
+        workers.push_back({ pid, fds[0], {} });
+    }
+
+    // Every test is run by the worker of its index, if fewer workers were started they run in here instead.
+    const auto startedJobs = static_cast<int>(workers.size());
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        if (static_cast<int>(i % jobs) >= startedJobs)
+        {
+            results[i].out.clear();
+            results[i].retVal = TestTrack::TestPaintTrackElement(tests[i].first, tests[i].second, &results[i].out);
+        }
+    }
+
+    // Read all the pipes at the same time, so no worker blocks on a full pipe.
+    std::vector<pollfd> fds;
+    for (auto& worker : workers)
+    {
+        fds.push_back({ worker.fd, POLLIN, 0 });
+    }
+    size_t openPipes = fds.size();
+    while (openPipes > 0)
+    {
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("poll");
+            break;
+        }
+
+        for (size_t w = 0; w < workers.size(); w++)
+        {
+            if (fds[w].fd < 0 || fds[w].revents == 0)
+                continue;
+
+            uint8_t chunk[4096];
+            auto bytesRead = read(fds[w].fd, chunk, sizeof(chunk));
+            if (bytesRead < 0 && errno == EINTR)
+                continue;
+            if (bytesRead <= 0)
+            {
+                close(fds[w].fd);
+                fds[w].fd = -1;
+                openPipes--;
+                continue;
+            }
+
+            auto& buffer = workers[w].buffer;
+            buffer.insert(buffer.end(), chunk, chunk + bytesRead);
+
+            // Take every complete result off the front of the buffer.
+            size_t offset = 0;
+            uint32_t header[3];
+            while (buffer.size() - offset >= sizeof(header))
+            {
+                std::memcpy(header, buffer.data() + offset, sizeof(header));
+                if (buffer.size() - offset - sizeof(header) < header[2])
+                    break;
+
+                auto& result = results[header[0]];
+                result.retVal = static_cast<uint8_t>(header[1]);
+                const auto text = reinterpret_cast<const char*>(buffer.data() + offset + sizeof(header));
+                result.out.assign(text, header[2]);
+                offset += sizeof(header) + header[2];
+            }
+            buffer.erase(buffer.begin(), buffer.begin() + offset);
+        }
+    }
+
+    for (auto& worker : workers)
+    {
+        int status;
+        waitpid(worker.pid, &status, 0);
+    }
+    return results;
+}
+
+static int GetDefaultJobCount()
+{
+    return std::max(1, static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN)));
+}
+
+#else
+
+static int GetDefaultJobCount()
+{
+    return 1;
+}
+
+#endif // defined(__unix__)
+
 int main(int argc, char* argv[])
 {
 #if !defined(__i386__)
@@ -461,6 +638,7 @@ int main(int argc, char* argv[])
 
     bool generate = false;
     uint8_t specificRideType = 0xFF;
+    int jobs = GetDefaultJobCount();
     for (int i = 0; i < argc; ++i)
     {
         char* arg = argv[i];
@@ -489,6 +667,11 @@ int main(int argc, char* argv[])
         {
             generate = true;
         }
+        else if (strcmp(arg, "--jobs") == 0 && i + 1 < argc)
+        {
+            i++;
+            jobs = std::max(1, atoi(argv[i]));
+        }
     }
 
     if (generate)
@@ -553,7 +736,24 @@ int main(int argc, char* argv[])
     openrct2_setup_rct2_segment();
     PaintIntercept::InitHooks();
 
+    std::vector<TestResult> results;
+#if defined(__unix__)
+    if (jobs > 1)
+    {
+        std::vector<std::pair<uint8_t, uint8_t>> tests;
+        for (auto&& tc : testCases)
+        {
+            for (auto&& trackType : tc.trackTypes)
+            {
+                tests.emplace_back(tc.rideType, trackType);
+            }
+        }
+        results = RunTestsInWorkers(tests, jobs);
+    }
+#endif // defined(__unix__)
+
     int successCount = 0;
+    size_t testIndex = 0;
     std::vector<utf8string> failures;
     for (auto&& tc : testCases)
     {
@@ -576,10 +776,19 @@ int main(int argc, char* argv[])
             Write(CLIColour::GREEN, "[ RUN      ] ");
             Write("%s.%s\n", rideTypeName, trackTypeName);
 
-            std::string out;
-            int retVal = TestTrack::TestPaintTrackElement(tc.rideType, trackType, &out);
-            Write("%s", out.c_str());
-            switch (retVal)
+            TestResult result;
+            if (results.empty())
+            {
+                result.retVal = TestTrack::TestPaintTrackElement(tc.rideType, trackType, &result.out);
+            }
+            else
+            {
+                result = std::move(results[testIndex]);
+            }
+            testIndex++;
+
+            Write("%s", result.out.c_str());
+            switch (result.retVal)
             {
                 case TEST_SUCCESS:
                     Write(CLIColour::GREEN, "[       OK ] ");
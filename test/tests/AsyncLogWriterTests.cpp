@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/AsyncLogWriter.h>
+#include <openrct2/core/File.h>
+#include <openrct2/core/FileSystem.hpp>
+#include <openrct2/core/String.hpp>
+#include <openrct2/platform/platform.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+class AsyncLogWriterTests : public testing::Test
+{
+protected:
+    std::string _path;
+
+    void SetUp() override
+    {
+        const auto* testInfo = testing::UnitTest::GetInstance()->current_test_info();
+        _path = (fs::temp_directory_path() / (std::string("openrct2_asynclog_") + testInfo->name() + ".txt")).u8string();
+        File::Delete(_path);
+    }
+
+    void TearDown() override
+    {
+        File::Delete(_path);
+    }
+};
+
+TEST_F(AsyncLogWriterTests, lines_are_written_in_order)
+{
+    AsyncLogWriter writer;
+    auto* target = writer.OpenFile(_path, true);
+    ASSERT_NE(target, nullptr);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(writer.Write(target, String::StdFormat("line %d\n", i)));
+    }
+    writer.Flush();
+
+    std::string expected;
+    for (int i = 0; i < 100; i++)
+    {
+        expected += String::StdFormat("line %d\n", i);
+    }
+    ASSERT_EQ(File::ReadAllText(_path), expected);
+    ASSERT_EQ(writer.GetStats().WrittenLines, 100U);
+    writer.Close(target);
+}
+
+TEST_F(AsyncLogWriterTests, close_writes_queued_lines)
+{
+    {
+        AsyncLogWriter writer;
+        auto* target = writer.OpenFile(_path, true);
+        ASSERT_NE(target, nullptr);
+        writer.Write(target, "first\n");
+        writer.Write(target, "second\n");
+        writer.Close(target);
+    }
+    ASSERT_EQ(File::ReadAllText(_path), "first\nsecond\n");
+}
+
+TEST_F(AsyncLogWriterTests, lines_over_budget_are_dropped)
+{
+    AsyncLogWriter writer(8);
+    auto* target = writer.OpenFile(_path, true);
+    ASSERT_NE(target, nullptr);
+    ASSERT_FALSE(writer.Write(target, "this line does not fit\n"));
+    ASSERT_FALSE(writer.Write(target, "neither does this one\n"));
+    ASSERT_TRUE(writer.Write(target, "fits\n"));
+    writer.Flush();
+
+    auto stats = writer.GetStats();
+    ASSERT_EQ(stats.WrittenLines, 1U);
+    ASSERT_EQ(stats.DroppedLines, 2U);
+    ASSERT_EQ(File::ReadAllText(_path), std::string("(2 log lines dropped)") + PLATFORM_NEWLINE + "fits\n");
+    writer.Close(target);
+}
+
+TEST_F(AsyncLogWriterTests, concurrent_writers_keep_their_order)
+{
+    constexpr int Threads = 4;
+    constexpr int LinesPerThread = 2000;
+
+    AsyncLogWriter writer;
+    auto* target = writer.OpenFile(_path, true);
+    ASSERT_NE(target, nullptr);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; t++)
+    {
+        threads.emplace_back([&writer, target, t]() {
+            for (int i = 0; i < LinesPerThread; i++)
+            {
+                writer.Write(target, String::StdFormat("%d %d\n", t, i));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    writer.Flush();
+
+    std::vector<int> next(Threads, 0);
+    std::istringstream lines(File::ReadAllText(_path));
+    int t = 0;
+    int i = 0;
+    while (lines >> t >> i)
+    {
+        ASSERT_EQ(i, next[t]);
+        next[t]++;
+    }
+    for (int count : next)
+    {
+        ASSERT_EQ(count, LinesPerThread);
+    }
+    writer.Close(target);
+}
@@ -199,6 +199,20 @@ TEST(BitTest, test_count)
     ASSERT_EQ(bits1.count(), 10u);
 }
 
+TEST(BitTest, test_count_large)
+{
+    BitSet<1001u> bits1;
+    size_t expected = 0;
+    for (size_t i = 0; i < bits1.size(); i += 3)
+    {
+        bits1.set(i, true);
+        expected++;
+    }
+    ASSERT_EQ(bits1.count(), expected);
+    ASSERT_EQ((~bits1).count(), bits1.size() - expected);
+    ASSERT_EQ((bits1 & ~bits1).count(), 0u);
+}
+
 TEST(BitTest, test_iterator)
 {
     BitSet<31u> bits1({ 0u, 2u, 4u, 7u, 9u, 12u, 16u, 19u, 22u, 29u });
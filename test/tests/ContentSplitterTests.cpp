@@ -0,0 +1,73 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/ContentSplitter.h>
+#include <random>
+#include <set>
+#include <vector>
+
+static std::vector<uint8_t> CreateData(size_t length)
+{
+    std::vector<uint8_t> data(length);
+    std::mt19937 random(1234);
+    for (auto& value : data)
+    {
+        value = static_cast<uint8_t>(random());
+    }
+    return data;
+}
+
+TEST(ContentSplitterTests, pieces_cover_data)
+{
+    auto data = CreateData(1024 * 1024);
+    auto pieces = ContentSplitter::Split(data.data(), data.size());
+    ASSERT_GT(pieces.size(), 1U);
+
+    size_t offset = 0;
+    for (const auto& piece : pieces)
+    {
+        ASSERT_EQ(piece.Offset, offset);
+        ASSERT_LE(piece.Length, ContentSplitter::MaxPieceSize);
+        ASSERT_EQ(piece.Hash, ContentSplitter::Hash(data.data() + piece.Offset, piece.Length));
+        offset += piece.Length;
+    }
+    ASSERT_EQ(offset, data.size());
+}
+
+TEST(ContentSplitterTests, empty_data_has_no_pieces)
+{
+    ASSERT_TRUE(ContentSplitter::Split(nullptr, 0).empty());
+}
+
+TEST(ContentSplitterTests, inserted_bytes_only_change_nearby_pieces)
+{
+    auto data = CreateData(1024 * 1024);
+    auto pieces = ContentSplitter::Split(data.data(), data.size());
+
+    auto changed = data;
+    changed.insert(changed.begin() + changed.size() / 2, 100, 0xAB);
+    auto changedPieces = ContentSplitter::Split(changed.data(), changed.size());
+
+    std::set<uint64_t> hashes;
+    for (const auto& piece : pieces)
+    {
+        hashes.insert(piece.Hash);
+    }
+    size_t differing = 0;
+    for (const auto& piece : changedPieces)
+    {
+        if (hashes.count(piece.Hash) == 0)
+        {
+            differing++;
+        }
+    }
+    ASSERT_GE(differing, 1U);
+    ASSERT_LE(differing, 2U);
+}
@@ -120,6 +120,30 @@ TEST_F(CryptTests, SHA1_Many)
     AssertHash("ac46948f97d69fa766706e932ce82562b4f73aa7", alg->Finish());
 }
 
+TEST_F(CryptTests, FNV1a_Basic)
+{
+    std::string input = "The quick brown fox jumped over the lazy dog.";
+    AssertHash("a170f7d6dfbbc855", Crypt::FNV1a(input.data(), input.size()));
+}
+
+TEST_F(CryptTests, FNV1a_SplitUpdates)
+{
+    std::string input = "The quick brown fox jumped over the lazy dog.";
+    auto expected = Crypt::FNV1a(input.data(), input.size());
+
+    // Splitting the input anywhere, including inside a word, must give the same hash.
+    auto alg = Crypt::CreateFNV1a();
+    for (size_t split = 0; split <= input.size(); split++)
+    {
+        alg->Clear();
+        alg->Update(input.data(), 3);
+        alg->Clear();
+        alg->Update(input.data(), split);
+        alg->Update(input.data() + split, input.size() - split);
+        ASSERT_EQ(expected, alg->Finish());
+    }
+}
+
 TEST_F(CryptTests, RSA_Basic)
 {
     std::vector<uint8_t> data = { 0, 1, 2, 3, 4, 5, 6, 7 };
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <array>
+#include <gtest/gtest.h>
+#include <openrct2/core/DataSerialiser.h>
+#include <openrct2/core/MemoryStream.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+template<typename T> static std::vector<uint8_t> Serialise(const T& value)
+{
+    MemoryStream ms;
+    DataSerialiser ds(true, ms);
+    ds << value;
+    return ms.TakeBuffer();
+}
+
+template<typename T> static T Deserialise(const std::vector<uint8_t>& data)
+{
+    MemoryStream ms(data.data(), data.size());
+    DataSerialiser ds(false, ms);
+    T value{};
+    ds << value;
+    EXPECT_EQ(ms.GetPosition(), data.size());
+    return value;
+}
+
+TEST(DataSerialiserTest, IntegerArraysAreBigEndian)
+{
+    uint16_t values[3] = { 0x0102, 0x0304, 0x0506 };
+    auto data = Serialise(values);
+    ASSERT_EQ(data, (std::vector<uint8_t>{ 0x00, 0x03, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 }));
+
+    std::array<uint32_t, 2> array = { 0x01020304, 0xA0B0C0D0 };
+    data = Serialise(array);
+    ASSERT_EQ(data, (std::vector<uint8_t>{ 0x00, 0x02, 0x01, 0x02, 0x03, 0x04, 0xA0, 0xB0, 0xC0, 0xD0 }));
+    ASSERT_EQ(Deserialise<decltype(array)>(data), array);
+}
+
+TEST(DataSerialiserTest, LargeVectorRoundTrip)
+{
+    // Larger than the swap buffer, so the range is written in more than one block.
+    std::vector<int32_t> values(1000);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = static_cast<int32_t>(i * 2654435761u);
+    }
+    auto data = Serialise(values);
+    ASSERT_EQ(data.size(), sizeof(uint16_t) + values.size() * sizeof(int32_t));
+    ASSERT_EQ(data[2], static_cast<uint8_t>(static_cast<uint32_t>(values[0]) >> 24));
+    ASSERT_EQ(Deserialise<std::vector<int32_t>>(data), values);
+}
+
+TEST(DataSerialiserTest, ByteArraysAreCopied)
+{
+    std::array<uint8_t, 4> bytes = { 1, 2, 3, 4 };
+    auto data = Serialise(bytes);
+    ASSERT_EQ(data, (std::vector<uint8_t>{ 0, 4, 1, 2, 3, 4 }));
+    ASSERT_EQ(Deserialise<decltype(bytes)>(data), bytes);
+}
+
+TEST(DataSerialiserTest, TileElementsMatchFieldOrder)
+{
+    std::vector<TileElement> elements(2);
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+        auto* raw = reinterpret_cast<uint8_t*>(&elements[i]);
+        for (size_t j = 0; j < sizeof(TileElement); j++)
+        {
+            raw[j] = static_cast<uint8_t>(i * 16 + j);
+        }
+    }
+
+    auto data = Serialise(elements);
+    ASSERT_EQ(data.size(), sizeof(uint16_t) + 2 * sizeof(TileElement));
+
+    // Compare with the element by element encoding.
+    MemoryStream expected;
+    uint16_t count = ByteSwapBE(static_cast<uint16_t>(elements.size()));
+    expected.WriteValue(count);
+    for (const auto& element : elements)
+    {
+        DataSerializerTraits<TileElement>::encode(&expected, element);
+    }
+    ASSERT_EQ(data, expected.TakeBuffer());
+
+    auto decoded = Deserialise<std::vector<TileElement>>(data);
+    ASSERT_EQ(decoded.size(), elements.size());
+    ASSERT_EQ(std::memcmp(decoded.data(), elements.data(), sizeof(TileElement) * elements.size()), 0);
+}
+
+TEST(DataSerialiserTest, CompactIntegers)
+{
+    MemoryStream ms;
+    DataSerialiser ds(true, ms);
+    ds.SetCompactIntegers(true);
+    uint32_t small = 5;
+    uint32_t large = 0xFFFFFFFF;
+    int16_t negative = -3;
+    int32_t smallest = INT32_MIN;
+    uint8_t byte = 0xAB;
+    GameCommand command = GameCommand::Custom;
+    ds << small << large << negative << smallest << byte << DS_TAG(command);
+    auto data = ms.TakeBuffer();
+    ASSERT_EQ(data[0], 5);
+    ASSERT_EQ(data[6], 5); // Zigzag encoded -3
+    ASSERT_EQ(data[12], 0xAB);
+
+    MemoryStream in(data.data(), data.size());
+    DataSerialiser dsIn(false, in);
+    dsIn.SetCompactIntegers(true);
+    uint32_t smallIn{}, largeIn{};
+    int16_t negativeIn{};
+    int32_t smallestIn{};
+    uint8_t byteIn{};
+    GameCommand commandIn{};
+    dsIn << smallIn << largeIn << negativeIn << smallestIn << byteIn << DS_TAG(commandIn);
+    ASSERT_EQ(in.GetPosition(), data.size());
+    ASSERT_EQ(smallIn, small);
+    ASSERT_EQ(largeIn, large);
+    ASSERT_EQ(negativeIn, negative);
+    ASSERT_EQ(smallestIn, smallest);
+    ASSERT_EQ(byteIn, byte);
+    ASSERT_EQ(commandIn, command);
+}
@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/drawing/DirtyGrid.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2::Drawing;
+
+class DirtyGridTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        bitcount_init();
+    }
+
+    static DirtyGrid CreateCleanGrid(uint32_t width, uint32_t height)
+    {
+        DirtyGrid grid;
+        grid.Configure(width, height);
+        grid.TakeRegions();
+        return grid;
+    }
+};
+
+TEST_F(DirtyGridTests, starts_dirty)
+{
+    DirtyGrid grid;
+    grid.Configure(1920, 1080);
+    const auto& regions = grid.TakeRegions();
+    ASSERT_EQ(regions.size(), 1U);
+    ASSERT_EQ(regions[0].Columns, grid.BlockColumns);
+    ASSERT_EQ(regions[0].Rows, grid.BlockRows);
+    ASSERT_TRUE(grid.TakeRegions().empty());
+}
+
+TEST_F(DirtyGridTests, invalidate_marks_covering_blocks)
+{
+    auto grid = CreateCleanGrid(1920, 1080);
+    grid.Invalidate(grid.BlockWidth - 1, grid.BlockHeight, grid.BlockWidth + 1, grid.BlockHeight + 1);
+    const auto& regions = grid.TakeRegions();
+    ASSERT_EQ(regions.size(), 1U);
+    ASSERT_EQ(regions[0].X, 0U);
+    ASSERT_EQ(regions[0].Y, 1U);
+    ASSERT_EQ(regions[0].Columns, 2U);
+    ASSERT_EQ(regions[0].Rows, 1U);
+}
+
+TEST_F(DirtyGridTests, invalidate_outside_is_ignored)
+{
+    auto grid = CreateCleanGrid(640, 480);
+    grid.Invalidate(-100, -100, 0, 0);
+    grid.Invalidate(640, 0, 800, 480);
+    grid.Invalidate(10, 10, 10, 20);
+    ASSERT_TRUE(grid.TakeRegions().empty());
+}
+
+TEST_F(DirtyGridTests, close_regions_are_merged)
+{
+    auto grid = CreateCleanGrid(1920, 1080);
+    // Two blocks with a clean block between them are cheaper to draw as one region.
+    grid.Invalidate(0, 0, 1, 1);
+    grid.Invalidate(grid.BlockWidth * 2, 0, grid.BlockWidth * 2 + 1, 1);
+    const auto& regions = grid.TakeRegions();
+    ASSERT_EQ(regions.size(), 1U);
+    ASSERT_EQ(regions[0].Columns, 3U);
+    ASSERT_EQ(regions[0].Rows, 1U);
+}
+
+TEST_F(DirtyGridTests, distant_regions_are_kept_apart)
+{
+    auto grid = CreateCleanGrid(1920, 1080);
+    grid.Invalidate(0, 0, 1, 1);
+    grid.Invalidate(1900, 1000, 1901, 1001);
+    ASSERT_EQ(grid.TakeRegions().size(), 2U);
+}
+
+TEST_F(DirtyGridTests, regions_cover_every_dirty_block_once)
+{
+    std::mt19937 rng(42);
+    for (int32_t iteration = 0; iteration < 200; iteration++)
+    {
+        const uint32_t width = 64 + rng() % 9000;
+        const uint32_t height = 64 + rng() % 3000;
+        auto grid = CreateCleanGrid(width, height);
+
+        std::vector<uint8_t> expected(grid.BlockColumns * grid.BlockRows);
+        const auto invalidations = rng() % 40;
+        for (uint32_t i = 0; i < invalidations; i++)
+        {
+            const int32_t left = static_cast<int32_t>(rng() % width);
+            const int32_t top = static_cast<int32_t>(rng() % height);
+            const int32_t right = left + 1 + static_cast<int32_t>(rng() % 300);
+            const int32_t bottom = top + 1 + static_cast<int32_t>(rng() % 200);
+            grid.Invalidate(left, top, right, bottom);
+            for (int32_t y = top; y < std::min<int32_t>(bottom, height); y++)
+            {
+                for (int32_t x = left; x < std::min<int32_t>(right, width); x++)
+                {
+                    expected[(y >> grid.BlockShiftY) * grid.BlockColumns + (x >> grid.BlockShiftX)] = 1;
+                }
+            }
+        }
+
+        std::vector<uint8_t> drawn(expected.size());
+        for (const auto& region : grid.TakeRegions())
+        {
+            ASSERT_LE(region.X + region.Columns, grid.BlockColumns);
+            ASSERT_LE(region.Y + region.Rows, grid.BlockRows);
+            for (uint32_t y = region.Y; y < region.Y + region.Rows; y++)
+            {
+                for (uint32_t x = region.X; x < region.X + region.Columns; x++)
+                {
+                    ASSERT_EQ(drawn[y * grid.BlockColumns + x], 0) << "block drawn twice";
+                    drawn[y * grid.BlockColumns + x] = 1;
+                }
+            }
+        }
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            if (expected[i] != 0)
+            {
+                ASSERT_EQ(drawn[i], 1) << "dirty block not drawn";
+            }
+        }
+        ASSERT_TRUE(grid.TakeRegions().empty());
+    }
+}
+
+TEST_F(DirtyGridTests, stats_are_per_frame)
+{
+    auto grid = CreateCleanGrid(1920, 1080);
+    grid.BeginFrame();
+    grid.Invalidate(0, 0, 1, 1);
+    grid.Invalidate(grid.BlockWidth * 2, 0, grid.BlockWidth * 2 + 1, 1);
+    grid.TakeRegions();
+    grid.BeginFrame();
+
+    auto stats = grid.GetStats();
+    ASSERT_EQ(stats.DirtyBlocks, 2U);
+    ASSERT_EQ(stats.DrawnBlocks, 3U);
+    ASSERT_EQ(stats.Regions, 1U);
+
+    grid.BeginFrame();
+    stats = grid.GetStats();
+    ASSERT_EQ(stats.DirtyBlocks, 0U);
+}
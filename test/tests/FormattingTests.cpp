@@ -58,6 +58,30 @@ TEST_F(FmtStringTests, iteration_escaped)
     ASSERT_EQ("[1:This is an ][2:{{][1:ESCAPED][2:}}][1: string.]", actual);
 }
 
+TEST_F(FmtStringTests, iteration_pretokenised)
+{
+    std::string_view str = "{BLACK}Guests: {INT32}{NEWLINE}{{ESCAPED}}";
+    std::vector<FmtString::token> tokens;
+    for (const auto& t : FmtString(str))
+    {
+        tokens.push_back(t);
+    }
+
+    std::string expected;
+    for (const auto& t : FmtString(str))
+    {
+        expected += String::StdFormat("[%d:%s]", t.kind, std::string(t.text).c_str());
+    }
+    std::string actual;
+    for (const auto& t : FmtString(str, tokens))
+    {
+        actual += String::StdFormat("[%d:%s]", t.kind, std::string(t.text).c_str());
+    }
+
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(FormatString(FmtString(str, tokens), 42), FormatString(FmtString(str), 42));
+}
+
 TEST_F(FmtStringTests, without_format_tokens)
 {
     auto fmt = FmtString("{BLACK}Guests: {INT32}");
@@ -340,6 +364,26 @@ TEST_F(FormattingTests, using_legacy_buffer_args)
     ASSERT_STREQ("Queuing for Boat Hire 2", buffer);
 }
 
+TEST_F(FormattingTests, using_legacy_buffer_args_cacheable)
+{
+    auto ft = Formatter();
+    ft.Add<rct_string_id>(STR_RIDE_NAME_DEFAULT);
+    ft.Add<rct_string_id>(STR_RIDE_NAME_BOAT_HIRE);
+    ft.Add<uint16_t>(2);
+
+    std::string result;
+    ASSERT_TRUE(FormatStringLegacy(result, STR_QUEUING_FOR, ft.Data(), ft.NumBytes()));
+    ASSERT_EQ("Queuing for Boat Hire 2", result);
+
+    // Reading past the added arguments or taking a string pointer depends on more than the argument bytes
+    ASSERT_FALSE(FormatStringLegacy(result, STR_QUEUING_FOR, ft.Data(), ft.NumBytes() - 2));
+
+    auto ftString = Formatter();
+    ftString.Add<const char*>("Boat Hire");
+    ASSERT_FALSE(FormatStringLegacy(result, STR_STRING, ftString.Data(), ftString.NumBytes()));
+    ASSERT_EQ("Boat Hire", result);
+}
+
 TEST_F(FormattingTests, format_number_basic)
 {
     FormatBuffer ss;
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/HistoryBuffer.h>
+#include <vector>
+
+using TestHistory = HistoryBuffer<int32_t, 4, -1>;
+
+static std::vector<int32_t> GetValues(const TestHistory& history)
+{
+    return std::vector<int32_t>(history.begin(), history.end());
+}
+
+TEST(HistoryBufferTest, StartsUndefined)
+{
+    TestHistory history;
+    ASSERT_EQ(GetValues(history), (std::vector<int32_t>{ -1, -1, -1, -1 }));
+    ASSERT_EQ(history.GetMinimum(), -1);
+    ASSERT_EQ(history.GetMaximum(), -1);
+}
+
+TEST(HistoryBufferTest, PushKeepsMostRecentFirst)
+{
+    TestHistory history;
+    for (int32_t i = 1; i <= 6; i++)
+    {
+        history.Push(i);
+    }
+    ASSERT_EQ(GetValues(history), (std::vector<int32_t>{ 6, 5, 4, 3 }));
+    ASSERT_EQ(history[0], 6);
+    ASSERT_EQ(history.data()[3], 3);
+}
+
+TEST(HistoryBufferTest, ExtremaFollowDroppedValues)
+{
+    TestHistory history;
+    history.Push(10);
+    history.Push(2);
+    history.Push(5);
+    ASSERT_EQ(history.GetMinimum(), 2);
+    ASSERT_EQ(history.GetMaximum(), 10);
+
+    history.Push(7);
+    history.Push(4);
+    ASSERT_EQ(history.GetMinimum(), 2);
+    ASSERT_EQ(history.GetMaximum(), 7);
+
+    history.Push(3);
+    ASSERT_EQ(history.GetMinimum(), 3);
+    ASSERT_EQ(history.GetMaximum(), 7);
+}
+
+TEST(HistoryBufferTest, SetAndFill)
+{
+    TestHistory history;
+    history.Push(1);
+    history.Push(2);
+    history.Set(3, 9);
+    ASSERT_EQ(GetValues(history), (std::vector<int32_t>{ 2, 1, -1, 9 }));
+    ASSERT_EQ(history.GetMaximum(), 9);
+
+    history.Fill(-1);
+    ASSERT_EQ(history.GetMaximum(), -1);
+}
+
+TEST(HistoryBufferTest, ExtremaCoverMostRecentValues)
+{
+    HistoryBuffer<int32_t, 4, -1, 2> history;
+    history.Push(8);
+    history.Push(1);
+    history.Push(2);
+    ASSERT_EQ(history.GetMinimum(), 1);
+    ASSERT_EQ(history.GetMaximum(), 2);
+
+    history.Set(3, 20);
+    ASSERT_EQ(history.GetMaximum(), 2);
+}
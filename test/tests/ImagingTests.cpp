@@ -0,0 +1,63 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/Imaging.h>
+#include <openrct2/drawing/Drawing.h>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+TEST(ImagingTests, PngRowWriter_RoundTrip)
+{
+    constexpr uint32_t width = 5;
+    constexpr uint32_t height = 6;
+    constexpr uint32_t stride = 8;
+
+    GamePalette palette;
+    std::vector<uint8_t> pixels(stride * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            pixels[y * stride + x] = static_cast<uint8_t>(y * width + x);
+        }
+    }
+
+    // Write the image in strips the way the giant screenshot does
+    std::ostringstream stream;
+    Imaging::PngRowWriter writer(stream, width, height, 8, &palette);
+    writer.WriteRows(pixels.data(), 2, stride);
+    writer.WriteRows(pixels.data() + 2 * stride, 4, stride);
+    writer.Finish();
+
+    auto data = stream.str();
+    auto image = Imaging::ReadFromBuffer(std::vector<uint8_t>(data.begin(), data.end()), IMAGE_FORMAT::PNG);
+    ASSERT_EQ(image.Width, width);
+    ASSERT_EQ(image.Height, height);
+    ASSERT_EQ(image.Depth, 8U);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            ASSERT_EQ(image.Pixels[y * image.Stride + x], pixels[y * stride + x]);
+        }
+    }
+}
+
+TEST(ImagingTests, PngRowWriter_RejectsIncompleteImage)
+{
+    GamePalette palette;
+    std::vector<uint8_t> pixels(4 * 4);
+    std::ostringstream stream;
+    Imaging::PngRowWriter writer(stream, 4, 4, 8, &palette);
+    writer.WriteRows(pixels.data(), 3, 4);
+    ASSERT_THROW(writer.WriteRows(pixels.data(), 2, 4), std::runtime_error);
+    ASSERT_THROW(writer.Finish(), std::runtime_error);
+}
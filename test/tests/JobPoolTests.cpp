@@ -0,0 +1,102 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/JobPool.h>
+#include <thread>
+#include <vector>
+
+TEST(JobPoolTest, RunsAllTasks)
+{
+    JobPool pool;
+    std::vector<int> results(10000);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        pool.AddTask([&results, i]() { results[i] = static_cast<int>(i) * 2; });
+    }
+    pool.Join();
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        ASSERT_EQ(results[i], static_cast<int>(i) * 2);
+    }
+}
+
+TEST(JobPoolTest, CompletionRunsOnJoiningThread)
+{
+    JobPool pool;
+    const auto joinThread = std::this_thread::get_id();
+    std::atomic<int> work = 0;
+    int completed = 0;
+    bool sameThread = true;
+    for (int i = 0; i < 500; i++)
+    {
+        pool.AddTask(
+            [&work]() { work++; },
+            [&]() {
+                completed++;
+                sameThread &= std::this_thread::get_id() == joinThread;
+            });
+    }
+
+    int reports = 0;
+    pool.Join([&reports]() { reports++; });
+
+    ASSERT_EQ(work, 500);
+    ASSERT_EQ(completed, 500);
+    ASSERT_TRUE(sameThread);
+    ASSERT_GT(reports, 0);
+}
+
+TEST(JobPoolTest, ReusedAfterJoin)
+{
+    JobPool pool;
+    std::atomic<int> counter = 0;
+    for (int batch = 0; batch < 50; batch++)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            pool.AddTask([&counter]() { counter++; });
+        }
+        pool.Join();
+        ASSERT_EQ(counter, (batch + 1) * 1000);
+        ASSERT_EQ(pool.CountPending(), 0U);
+    }
+}
+
+TEST(JobPoolTest, TasksCanAddTasks)
+{
+    JobPool pool;
+    std::atomic<int> counter = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        pool.AddTask([&pool, &counter]() {
+            for (int j = 0; j < 10; j++)
+            {
+                pool.AddTask([&counter]() { counter++; });
+            }
+            counter++;
+        });
+    }
+    pool.Join();
+    ASSERT_EQ(counter, 100 * 11);
+}
+
+TEST(JobPoolTest, NoWorkerThreads)
+{
+    JobPool pool(0);
+    int counter = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        pool.AddTask([&counter]() { counter++; });
+    }
+    pool.Join();
+    ASSERT_EQ(counter, 100);
+}
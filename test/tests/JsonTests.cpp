@@ -0,0 +1,44 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/Json.hpp>
+#include <string_view>
+
+static std::vector<uint8_t> ToVector(std::string_view s)
+{
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+TEST(JsonTest, FromVectorSkipsRootMembers)
+{
+    auto data = ToVector(R"({
+        "id": "rct2.ride.test",
+        "images": [ "$CSG1", { "path": "a.png", "x": 1 }, [ 1, 2, 3 ] ],
+        "properties": { "images": 4, "name": "kept" },
+        "noCsgImages": { "nested": { "images": [] } },
+        "authors": [ "a", "b" ]
+    })");
+
+    auto jRoot = Json::FromVector(data, { "images", "noCsgImages" });
+    ASSERT_TRUE(jRoot.is_object());
+    ASSERT_EQ(jRoot.size(), 3U);
+    ASSERT_FALSE(jRoot.contains("images"));
+    ASSERT_FALSE(jRoot.contains("noCsgImages"));
+    ASSERT_EQ(Json::GetString(jRoot["id"]), "rct2.ride.test");
+    ASSERT_EQ(jRoot["properties"]["images"], 4);
+    ASSERT_EQ(Json::GetString(jRoot["properties"]["name"]), "kept");
+    ASSERT_EQ(jRoot["authors"].size(), 2U);
+}
+
+TEST(JsonTest, FromVectorSkipKeysMatchesFullParse)
+{
+    auto data = ToVector(R"({ "a": [ { "b": 1 } ], "c": { "d": [ true, null ] }, "e": "f" })");
+    ASSERT_EQ(Json::FromVector(data, { "images" }), Json::FromVector(data));
+}
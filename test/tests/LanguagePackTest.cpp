@@ -9,9 +9,12 @@
 
 #include "openrct2/localisation/LanguagePack.h"
 
+#include "openrct2/core/File.h"
+#include "openrct2/core/FileSystem.hpp"
 #include "openrct2/localisation/Language.h"
 #include "openrct2/localisation/StringIds.h"
 
+#include <cstring>
 #include <gtest/gtest.h>
 
 class LanguagePackTest : public testing::Test
@@ -69,6 +72,34 @@ TEST_F(LanguagePackTest, language_pack_multibyte)
     ASSERT_STREQ(lang->GetString(0x6000), u8"神鷹暢遊");
 }
 
+TEST_F(LanguagePackTest, language_pack_cache)
+{
+    auto directory = fs::temp_directory_path() / "openrct2-language-pack-test";
+    fs::create_directories(directory);
+    auto path = (directory / "en-GB.txt").u8string();
+    auto cachePath = (directory / "cache" / "en-GB.idx").u8string();
+    fs::remove(u8path(cachePath));
+    File::WriteAllBytes(path, LanguageEnGB, std::strlen(LanguageEnGB));
+
+    // The first load parses the text and writes the cache, the second one is read back from the cache.
+    for (int i = 0; i < 2; i++)
+    {
+        auto lang = LanguagePackFactory::FromFile(0, path.c_str(), cachePath);
+        ASSERT_NE(lang, nullptr);
+        ASSERT_TRUE(File::Exists(cachePath));
+        ASSERT_EQ(lang->GetCount(), 4U);
+        ASSERT_STREQ(lang->GetString(1), "{STRINGID} {COMMA16}");
+        ASSERT_STREQ(lang->GetString(2), "Spiral Roller Coaster");
+        ASSERT_EQ(lang->GetScenarioOverrideStringId("Arid Heights", 0), 0x7000);
+        ASSERT_STREQ(lang->GetString(0x7002), "Free of any financial limits, your challenge is to develop "
+                                              "this desert park while keeping the guests happy");
+        ASSERT_EQ(lang->GetObjectOverrideStringId("CONDORRD", 2), 0x6002);
+        ASSERT_STREQ(lang->GetString(0x6002), "ride capacity");
+    }
+
+    fs::remove_all(directory);
+}
+
 const utf8* LanguagePackTest::LanguageEnGB = "# STR_XXXX part is read and XXXX becomes the string id number.\n"
                                              "# Everything after the colon and before the new line will be saved as the "
                                              "string.\n"
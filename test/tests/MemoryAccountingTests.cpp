@@ -0,0 +1,65 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryAccounting.h>
+#include <optional>
+#include <string>
+
+using namespace OpenRCT2;
+
+static std::optional<size_t> FindEntry(const std::string& name)
+{
+    auto entries = MemoryAccounting::Query();
+    auto it = std::find_if(
+        entries.begin(), entries.end(), [&name](const MemoryAccounting::Entry& entry) { return entry.Name == name; });
+    if (it == entries.end())
+        return std::nullopt;
+    return it->Bytes;
+}
+
+TEST(MemoryAccountingTest, SumsRegistrationsWithTheSameName)
+{
+    size_t first = 100;
+    MemoryAccounting::Registration a("testSubsystem", [&first] { return first; });
+    {
+        MemoryAccounting::Registration b("testSubsystem", [] { return size_t{ 20 }; });
+        ASSERT_EQ(FindEntry("testSubsystem"), 120U);
+
+        first = 200;
+        ASSERT_EQ(FindEntry("testSubsystem"), 220U);
+    }
+    ASSERT_EQ(FindEntry("testSubsystem"), 200U);
+}
+
+TEST(MemoryAccountingTest, MovedRegistrationStaysRegistered)
+{
+    MemoryAccounting::Registration moved;
+    {
+        MemoryAccounting::Registration original("testMoved", [] { return size_t{ 64 }; });
+        moved = std::move(original);
+    }
+    ASSERT_EQ(FindEntry("testMoved"), 64U);
+
+    moved = MemoryAccounting::Registration();
+    ASSERT_EQ(FindEntry("testMoved"), std::nullopt);
+}
+
+TEST(MemoryAccountingTest, SortsBySize)
+{
+    MemoryAccounting::Registration small("testSmall", [] { return size_t{ 1 }; });
+    MemoryAccounting::Registration large("testLarge", [] { return size_t{ 1 } << 40; });
+
+    auto entries = MemoryAccounting::Query();
+    ASSERT_FALSE(entries.empty());
+    ASSERT_EQ(entries.front().Name, "testLarge");
+    ASSERT_TRUE(std::is_sorted(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.Bytes > b.Bytes; }));
+    ASSERT_GE(MemoryAccounting::GetTotal(entries), (size_t{ 1 } << 40) + 1);
+}
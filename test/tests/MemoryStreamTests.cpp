@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+TEST(MemoryStreamTest, GrowsWhileWriting)
+{
+    MemoryStream ms;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        ms.WriteValue(i);
+    }
+    ASSERT_EQ(ms.GetLength(), 1000 * sizeof(uint32_t));
+
+    ms.SetPosition(0);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(ms.ReadValue<uint32_t>(), i);
+    }
+}
+
+TEST(MemoryStreamTest, ReserveKeepsData)
+{
+    MemoryStream ms;
+    ms.WriteValue<uint32_t>(0x12345678);
+    const auto* data = ms.GetData();
+    ms.Reserve(4096);
+    ASSERT_NE(ms.GetData(), data);
+    ASSERT_EQ(ms.GetLength(), 4u);
+    ASSERT_EQ(ms.GetPosition(), 4u);
+
+    // Writing within the reserved space must not move the buffer again.
+    data = ms.GetData();
+    std::vector<uint8_t> block(4000, 0xAB);
+    ms.Write(block.data(), block.size());
+    ASSERT_EQ(ms.GetData(), data);
+
+    ms.SetPosition(0);
+    ASSERT_EQ(ms.ReadValue<uint32_t>(), 0x12345678u);
+}
+
+TEST(MemoryStreamTest, TakeVectorWithoutCopy)
+{
+    std::vector<uint8_t> source{ 1, 2, 3, 4, 5 };
+    const auto* sourceData = source.data();
+
+    MemoryStream ms(std::move(source));
+    ASSERT_EQ(ms.GetData(), sourceData);
+    ASSERT_EQ(ms.GetLength(), 5u);
+    ASSERT_EQ(ms.ReadValue<uint8_t>(), 1);
+
+    ms.SetPosition(5);
+    ms.WriteValue<uint8_t>(6);
+    auto buffer = ms.TakeBuffer();
+    ASSERT_EQ(buffer, (std::vector<uint8_t>{ 1, 2, 3, 4, 5, 6 }));
+    ASSERT_EQ(ms.GetLength(), 0u);
+}
+
+TEST(MemoryStreamTest, TakeBufferDoesNotCopy)
+{
+    MemoryStream ms;
+    ms.WriteValue<uint64_t>(42);
+    const auto* data = ms.GetData();
+
+    auto buffer = ms.TakeBuffer();
+    ASSERT_EQ(buffer.data(), data);
+    ASSERT_EQ(buffer.size(), sizeof(uint64_t));
+
+    // The stream can be used again afterwards.
+    ms.WriteValue<uint8_t>(1);
+    ASSERT_EQ(ms.GetLength(), 1u);
+}
+
+TEST(MemoryStreamTest, ReadOnlyView)
+{
+    const uint8_t data[] = { 10, 20, 30 };
+    MemoryStream view(data, sizeof(data));
+    ASSERT_EQ(view.GetData(), data);
+    ASSERT_TRUE(view.CanRead());
+    ASSERT_FALSE(view.CanWrite());
+    ASSERT_EQ(view.ReadValue<uint8_t>(), 10);
+
+    view.SetPosition(0);
+    ASSERT_THROW(view.WriteValue<uint8_t>(0), IOException);
+    ASSERT_THROW(view.Reserve(16), IOException);
+    ASSERT_EQ(data[0], 10);
+
+    auto copy = view.TakeBuffer();
+    ASSERT_EQ(copy, (std::vector<uint8_t>{ 10, 20, 30 }));
+    ASSERT_EQ(view.GetData(), data);
+}
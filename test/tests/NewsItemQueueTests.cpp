@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/management/NewsItem.h>
+#include <vector>
+
+static News::Item MakeItem(uint32_t assoc)
+{
+    News::Item item{};
+    item.Type = News::ItemType::Blank;
+    item.Assoc = assoc;
+    return item;
+}
+
+static std::vector<uint32_t> GetAssocs(const News::ItemQueue<4>& queue)
+{
+    std::vector<uint32_t> result;
+    for (const auto& item : queue)
+    {
+        result.push_back(item.Assoc);
+    }
+    return result;
+}
+
+TEST(NewsItemQueueTest, PushAndPopInOrder)
+{
+    News::ItemQueue<4> queue;
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.size(), 0u);
+
+    queue.push_back(MakeItem(1));
+    queue.push_back(MakeItem(2));
+    queue.push_back(MakeItem(3));
+    ASSERT_EQ(queue.size(), 3u);
+    ASSERT_EQ(GetAssocs(queue), (std::vector<uint32_t>{ 1, 2, 3 }));
+
+    queue.pop_front();
+    ASSERT_EQ(queue.front().Assoc, 2u);
+    ASSERT_EQ(GetAssocs(queue), (std::vector<uint32_t>{ 2, 3 }));
+}
+
+TEST(NewsItemQueueTest, FullQueueDropsOldest)
+{
+    News::ItemQueue<4> queue;
+    for (uint32_t i = 1; i <= 6; i++)
+    {
+        queue.push_back(MakeItem(i));
+    }
+    ASSERT_EQ(queue.size(), 4u);
+    ASSERT_EQ(GetAssocs(queue), (std::vector<uint32_t>{ 3, 4, 5, 6 }));
+    ASSERT_EQ(queue[0].Assoc, 3u);
+    ASSERT_EQ(queue[3].Assoc, 6u);
+}
+
+TEST(NewsItemQueueTest, EditsThroughIndexAreCounted)
+{
+    News::ItemQueue<4> queue;
+    queue.push_back(MakeItem(1));
+    queue.pop_front();
+    queue.push_back(MakeItem(2));
+    queue.push_back(MakeItem(3));
+
+    queue[2] = MakeItem(4);
+    ASSERT_EQ(queue.size(), 3u);
+
+    queue[1].Type = News::ItemType::Null;
+    ASSERT_EQ(queue.size(), 1u);
+    ASSERT_EQ(GetAssocs(queue), (std::vector<uint32_t>{ 2 }));
+}
+
+TEST(NewsItemQueueTest, ClearEmptiesQueue)
+{
+    News::ItemQueue<4> queue;
+    queue.push_back(MakeItem(1));
+    queue.push_back(MakeItem(2));
+    queue.clear();
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.size(), 0u);
+}
@@ -22,3 +22,12 @@ TEST(platform, sanitise_filename)
     ASSERT_EQ("forbidden_______chars", Platform::SanitiseFilename("forbidden/\\:\"|?*chars"));
 #endif
 }
+
+TEST(platform, parse_core_list)
+{
+    ASSERT_EQ(std::vector<int32_t>{}, Platform::ParseCoreList(""));
+    ASSERT_EQ((std::vector<int32_t>{ 2 }), Platform::ParseCoreList("2"));
+    ASSERT_EQ((std::vector<int32_t>{ 0, 1, 2, 3, 6 }), Platform::ParseCoreList("6, 0-3"));
+    ASSERT_EQ((std::vector<int32_t>{ 1, 2, 3 }), Platform::ParseCoreList("1-2,2-3"));
+    ASSERT_EQ(1024u, Platform::ParseCoreList("0-99999").size());
+}
@@ -17,15 +17,19 @@
 #include <openrct2/ParkImporter.h>
 #include <openrct2/actions/ParkSetParameterAction.h>
 #include <openrct2/actions/RideSetPriceAction.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/entity/EntityTweener.h>
 #include <openrct2/entity/Peep.h>
 #include <openrct2/object/ObjectManager.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/scenario/Scenario.h>
+#include <openrct2/world/Map.h>
 #include <openrct2/world/MapAnimation.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Scenery.h>
+#include <cstring>
 #include <string>
 
 using namespace OpenRCT2;
@@ -193,3 +197,42 @@ TEST_F(PlayTests, CarRideWithOneCarOnlyAcceptsTwoGuests)
         gs->UpdateLogic();
     }
 }
+
+TEST_F(PlayTests, ParallelTileUpdatesMatchSequentialTileUpdates)
+{
+    // This test verifies that updating the map tiles on the job pool results in the same game state as
+    // updating them on the game thread, the big map has more than one 256x256 block to update.
+    std::string initStateFile = TestData::GetParkPath("BigMapTest.sv6");
+
+    auto runTicks = [&](bool parallel, TileElementVector& tileElements, random_engine_t::state_type& randState) {
+        auto context = localStartGame(initStateFile);
+        ASSERT_NE(context.get(), nullptr);
+
+        auto gs = context->GetGameState();
+        ASSERT_NE(gs, nullptr);
+
+        gConfigGeneral.parallel_tile_updates = parallel;
+        for (int i = 0; i < 2000; i++)
+        {
+            gs->UpdateLogic();
+        }
+        gConfigGeneral.parallel_tile_updates = false;
+
+        tileElements = GetTileElements();
+        randState = scenario_rand_state();
+    };
+
+    TileElementVector sequentialElements;
+    random_engine_t::state_type sequentialRandState;
+    runTicks(false, sequentialElements, sequentialRandState);
+
+    TileElementVector parallelElements;
+    random_engine_t::state_type parallelRandState;
+    runTicks(true, parallelElements, parallelRandState);
+
+    ASSERT_EQ(sequentialElements.size(), parallelElements.size());
+    ASSERT_EQ(
+        std::memcmp(sequentialElements.data(), parallelElements.data(), sequentialElements.size() * sizeof(TileElement)), 0);
+    ASSERT_EQ(sequentialRandState.s0, parallelRandState.s0);
+    ASSERT_EQ(sequentialRandState.s1, parallelRandState.s1);
+}
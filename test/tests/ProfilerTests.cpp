@@ -0,0 +1,62 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <openrct2/core/Profiler.h>
+#include <string>
+#include <thread>
+
+using namespace OpenRCT2;
+
+TEST(ProfilerTest, RecordsOnlyWhileEnabled)
+{
+    Profiler::Reset();
+    {
+        PROFILE_ZONE(PeepUpdate);
+    }
+    ASSERT_EQ(Profiler::GetEventCount(), 0U);
+
+    Profiler::SetEnabled(true);
+    {
+        PROFILE_ZONE(PeepUpdate);
+        PROFILE_ZONE(Pathfinding);
+    }
+    std::thread([]() { PROFILE_ZONE(PaintSetup); }).join();
+    Profiler::SetEnabled(false);
+    ASSERT_EQ(Profiler::GetEventCount(), 3U);
+
+    Profiler::Reset();
+    ASSERT_EQ(Profiler::GetEventCount(), 0U);
+}
+
+TEST(ProfilerTest, ExportsChromeTrace)
+{
+    Profiler::Reset();
+    Profiler::SetEnabled(true);
+    {
+        PROFILE_ZONE(VehicleUpdate);
+    }
+
+    const char* path = "test_profiler_trace.json";
+    ASSERT_TRUE(Profiler::ExportChromeTrace(path));
+    ASSERT_TRUE(Profiler::IsEnabled());
+    Profiler::SetEnabled(false);
+
+    std::ifstream file(path);
+    std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path);
+
+    ASSERT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0U);
+    ASSERT_NE(trace.find("{\"name\":\"VehicleUpdate\",\"cat\":\"openrct2\",\"ph\":\"X\""), std::string::npos);
+    ASSERT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
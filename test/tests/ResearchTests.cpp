@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/management/Research.h>
+
+static ResearchItem MakeRideItem(ObjectEntryIndex entryIndex, uint8_t rideType)
+{
+    return ResearchItem(Research::EntryType::Ride, entryIndex, rideType, ResearchCategory::Rollercoaster, 0);
+}
+
+static ResearchItem MakeSceneryItem(ObjectEntryIndex entryIndex)
+{
+    return ResearchItem(Research::EntryType::Scenery, entryIndex, 0, ResearchCategory::SceneryGroup, 0);
+}
+
+class ResearchTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        research_reset_items();
+    }
+
+    void TearDown() override
+    {
+        research_reset_items();
+    }
+};
+
+TEST_F(ResearchTest, InsertedItemsExist)
+{
+    research_insert(MakeRideItem(3, 7), false);
+    research_insert(MakeSceneryItem(5), true);
+
+    ASSERT_TRUE(MakeRideItem(3, 7).Exists());
+    ASSERT_TRUE(MakeSceneryItem(5).Exists());
+    ASSERT_FALSE(MakeRideItem(3, 8).Exists());
+    ASSERT_FALSE(MakeRideItem(5, 0).Exists());
+    ASSERT_FALSE(MakeSceneryItem(3).Exists());
+}
+
+TEST_F(ResearchTest, DuplicatesAreNotInserted)
+{
+    research_insert(MakeRideItem(3, 7), false);
+    research_insert(MakeRideItem(3, 7), false);
+    research_insert(MakeRideItem(3, 7), true);
+
+    ASSERT_EQ(gResearchItemsUninvented.size(), 1u);
+    ASSERT_TRUE(gResearchItemsInvented.empty());
+}
+
+TEST_F(ResearchTest, RemovedItemsDoNotExist)
+{
+    research_insert(MakeRideItem(3, 7), false);
+    research_insert(MakeRideItem(4, 7), true);
+    ResearchRemove(MakeRideItem(3, 7));
+
+    ASSERT_FALSE(MakeRideItem(3, 7).Exists());
+    ASSERT_TRUE(MakeRideItem(4, 7).Exists());
+
+    research_insert(MakeRideItem(3, 7), true);
+    ASSERT_TRUE(MakeRideItem(3, 7).Exists());
+    ASSERT_EQ(gResearchItemsInvented.size(), 2u);
+}
+
+TEST_F(ResearchTest, ResetClearsItems)
+{
+    research_insert(MakeRideItem(3, 7), false);
+    research_reset_items();
+
+    ASSERT_FALSE(MakeRideItem(3, 7).Exists());
+}
+
+TEST_F(ResearchTest, DirectEditsAreSeenAfterInvalidating)
+{
+    research_insert(MakeRideItem(3, 7), false);
+    ASSERT_FALSE(MakeSceneryItem(9).Exists());
+
+    gResearchItemsInvented.push_back(MakeSceneryItem(9));
+    ResearchInvalidateIndex();
+
+    ASSERT_TRUE(MakeSceneryItem(9).Exists());
+    ASSERT_TRUE(MakeRideItem(3, 7).Exists());
+}
@@ -44,6 +44,23 @@ protected:
         }
     }
 
+    void CheckRatings()
+    {
+        // Load expected ratings
+        auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
+        auto expectedRatings = File::ReadAllLines(expectedDataPath);
+
+        int expI = 0;
+        for (const auto& ride : GetRideManager())
+        {
+            auto actual = FormatRatings(ride);
+            auto expected = expectedRatings[expI];
+            ASSERT_STREQ(actual.c_str(), expected.c_str());
+
+            expI++;
+        }
+    }
+
     std::string FormatRatings(const Ride& ride)
     {
         RatingTuple ratings = ride.ratings;
@@ -73,18 +90,25 @@ TEST_F(RideRatings, all)
 
     CalculateRatingsForAllRides();
 
-    // Load expected ratings
-    auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
-    auto expectedRatings = File::ReadAllLines(expectedDataPath);
+    CheckRatings();
+}
 
-    // Check ride ratings
-    int expI = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        auto actual = FormatRatings(ride);
-        auto expected = expectedRatings[expI];
-        ASSERT_STREQ(actual.c_str(), expected.c_str());
+TEST_F(RideRatings, all_rides_at_once)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
 
-        expI++;
-    }
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(path.c_str());
+    ASSERT_EQ(ride_get_count(), 134);
+
+    ride_ratings_update_all_rides();
+
+    CheckRatings();
 }
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <openrct2/drawing/SpriteMipCache.h>
+#include <openrct2/sprites.h>
+#include <random>
+#include <vector>
+
+// Builds an RLE sprite with random runs of non zero pixels.
+static std::vector<uint8_t> CreateRLESprite(std::mt19937& rng, int32_t width, int32_t height)
+{
+    std::vector<uint8_t> data(static_cast<size_t>(height) * 2);
+    for (int32_t y = 0; y < height; y++)
+    {
+        data[y * 2] = static_cast<uint8_t>(data.size() & 0xFF);
+        data[y * 2 + 1] = static_cast<uint8_t>(data.size() >> 8);
+
+        std::vector<std::pair<int32_t, int32_t>> runs;
+        int32_t x = static_cast<int32_t>(rng() % 8);
+        while (x < width)
+        {
+            auto length = std::min<int32_t>(1 + static_cast<int32_t>(rng() % 40), width - x);
+            runs.emplace_back(x, length);
+            x += length + 1 + static_cast<int32_t>(rng() % 6);
+        }
+        if (runs.empty())
+        {
+            runs.emplace_back(0, 0);
+        }
+        for (size_t i = 0; i < runs.size(); i++)
+        {
+            auto [start, length] = runs[i];
+            data.push_back(static_cast<uint8_t>(length | (i == runs.size() - 1 ? 0x80 : 0)));
+            data.push_back(static_cast<uint8_t>(start));
+            for (int32_t p = 0; p < length; p++)
+            {
+                data.push_back(static_cast<uint8_t>(1 + rng() % 255));
+            }
+        }
+    }
+    return data;
+}
+
+static std::vector<uint8_t> Draw(
+    ImageId image, const rct_g1_element& g1, int32_t zoomShift, int32_t srcX, int32_t srcY, int32_t width, int32_t height,
+    const PaletteMap& paletteMap)
+{
+    constexpr int32_t bufferWidth = 160;
+    constexpr int32_t bufferHeight = 160;
+    std::vector<uint8_t> buffer(bufferWidth * bufferHeight, 0x11);
+
+    rct_drawpixelinfo dpi{};
+    dpi.bits = buffer.data();
+    dpi.width = bufferWidth << zoomShift;
+    dpi.height = bufferHeight << zoomShift;
+    dpi.pitch = 0;
+    dpi.zoom_level = ZoomLevel{ static_cast<int8_t>(zoomShift) };
+
+    DrawSpriteArgs args(image, paletteMap, g1, srcX, srcY, width, height, buffer.data() + bufferWidth + 2);
+    gfx_rle_sprite_to_buffer(dpi, args);
+    return buffer;
+}
+
+TEST(SpriteMipCacheTest, DrawsSamePixelsAsFullSprite)
+{
+    std::mt19937 rng(1234);
+    uint8_t remap[256];
+    std::iota(std::begin(remap), std::end(remap), static_cast<uint8_t>(7));
+    remap[40] = 0;
+    const auto remapPalette = PaletteMap(remap);
+
+    for (int32_t iteration = 0; iteration < 300; iteration++)
+    {
+        const int32_t width = 1 + static_cast<int32_t>(rng() % 200);
+        const int32_t height = 1 + static_cast<int32_t>(rng() % 200);
+        auto data = CreateRLESprite(rng, width, height);
+
+        rct_g1_element g1{};
+        g1.offset = data.data();
+        g1.width = static_cast<int16_t>(width);
+        g1.height = static_cast<int16_t>(height);
+        g1.flags = G1_FLAG_RLE_COMPRESSION;
+
+        const int32_t zoomShift = 1 + static_cast<int32_t>(rng() % 3);
+        const int32_t zoom = 1 << zoomShift;
+        const int32_t srcX = (static_cast<int32_t>(rng() % width) >> zoomShift) << zoomShift;
+        const int32_t srcY = static_cast<int32_t>(rng() % (height + zoom - 1)) - (zoom - 1);
+        const int32_t drawWidth = 1 + static_cast<int32_t>(rng() % (width - srcX));
+        const int32_t drawHeight = 1 + static_cast<int32_t>(rng() % (height - std::max(srcY, 0)));
+
+        // The temporary image is never cached, so it is drawn by sampling the full size sprite.
+        const auto cachedIndex = static_cast<ImageIndex>(SPR_IMAGE_LIST_BEGIN + iteration);
+        const bool remapped = (iteration & 1) != 0;
+        const auto& paletteMap = remapped ? remapPalette : PaletteMap::GetDefault();
+        auto cachedImage = remapped ? ImageId(cachedIndex, COLOUR_BLACK) : ImageId(cachedIndex);
+        auto fullImage = remapped ? ImageId(SPR_TEMP, COLOUR_BLACK) : ImageId(SPR_TEMP);
+
+        auto expected = Draw(fullImage, g1, zoomShift, srcX, srcY, drawWidth, drawHeight, paletteMap);
+        auto actual = Draw(cachedImage, g1, zoomShift, srcX, srcY, drawWidth, drawHeight, paletteMap);
+        ASSERT_EQ(expected, actual) << "iteration " << iteration;
+
+        // Drawn again from the cache
+        actual = Draw(cachedImage, g1, zoomShift, srcX, srcY, drawWidth, drawHeight, paletteMap);
+        ASSERT_EQ(expected, actual) << "iteration " << iteration;
+        SpriteMipCacheInvalidate(cachedIndex);
+    }
+}
+
+TEST(SpriteMipCacheTest, ReplacedImageIsNotDrawnFromCache)
+{
+    std::mt19937 rng(42);
+    auto first = CreateRLESprite(rng, 64, 64);
+    auto second = CreateRLESprite(rng, 64, 64);
+
+    rct_g1_element g1{};
+    g1.width = 64;
+    g1.height = 64;
+    g1.flags = G1_FLAG_RLE_COMPRESSION;
+
+    const auto index = static_cast<ImageIndex>(SPR_IMAGE_LIST_BEGIN);
+    g1.offset = first.data();
+    auto firstZoomed = SpriteMipCacheGet(index, g1, 1, 0);
+    ASSERT_NE(firstZoomed, nullptr);
+    ASSERT_EQ(SpriteMipCacheGet(index, g1, 1, 0), firstZoomed);
+
+    g1.offset = second.data();
+    auto secondZoomed = SpriteMipCacheGet(index, g1, 1, 0);
+    ASSERT_NE(secondZoomed, nullptr);
+    ASSERT_NE(secondZoomed, firstZoomed);
+    ASSERT_EQ(secondZoomed->Element.width, 32);
+    ASSERT_EQ(secondZoomed->Element.height, 32);
+
+    ASSERT_EQ(SpriteMipCacheGet(SPR_TEMP, g1, 1, 0), nullptr);
+    SpriteMipCacheClear();
+}
@@ -0,0 +1,88 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/SpscRing.h>
+#include <thread>
+
+TEST(SpscRingTest, PushPopInOrder)
+{
+    SpscRing<int, 8> ring;
+    ASSERT_TRUE(ring.IsEmpty());
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(ring.TryPush(i));
+    }
+    ASSERT_FALSE(ring.IsEmpty());
+
+    int value = -1;
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(ring.TryPop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(ring.TryPop(value));
+    ASSERT_TRUE(ring.IsEmpty());
+}
+
+TEST(SpscRingTest, FailsWhenFull)
+{
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(ring.TryPush(i));
+    }
+    ASSERT_FALSE(ring.TryPush(4));
+
+    // Freeing one slot allows one more push, wrapping around the end.
+    int value = -1;
+    ASSERT_TRUE(ring.TryPop(value));
+    ASSERT_EQ(value, 0);
+    ASSERT_TRUE(ring.TryPush(4));
+    ASSERT_FALSE(ring.TryPush(5));
+
+    for (int i = 1; i <= 4; i++)
+    {
+        ASSERT_TRUE(ring.TryPop(value));
+        ASSERT_EQ(value, i);
+    }
+}
+
+TEST(SpscRingTest, ProducerConsumerThreads)
+{
+    constexpr int count = 100000;
+    SpscRing<int, 64> ring;
+
+    std::thread producer([&ring]() {
+        for (int i = 0; i < count; i++)
+        {
+            while (!ring.TryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < count)
+    {
+        int value;
+        if (ring.TryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(ring.IsEmpty());
+}
@@ -0,0 +1,49 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/rct12/TileImport.h>
+#include <openrct2/world/Map.h>
+
+static size_t GetNumElements(const TileCoordsXY& coords)
+{
+    return (coords.x + coords.y) % 3 + 1;
+}
+
+TEST(TileImportTests, tiles_are_joined_in_order)
+{
+    auto tileElements = RCT12::ImportTiles([](const TileCoordsXY& coords, std::vector<TileElement>& elements) {
+        for (size_t i = 0; i < GetNumElements(coords); i++)
+        {
+            auto& element = elements.emplace_back();
+            element.ClearAs(TileElementType::Surface);
+            element.base_height = static_cast<uint8_t>(coords.x);
+            element.clearance_height = static_cast<uint8_t>(coords.y);
+        }
+        elements.back().SetLastForTile(true);
+    });
+
+    size_t index = 0;
+    for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
+    {
+        for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+        {
+            const auto numElements = GetNumElements(coords);
+            for (size_t i = 0; i < numElements; i++)
+            {
+                ASSERT_LT(index, tileElements.size());
+                const auto& element = tileElements[index++];
+                ASSERT_EQ(element.base_height, static_cast<uint8_t>(coords.x));
+                ASSERT_EQ(element.clearance_height, static_cast<uint8_t>(coords.y));
+                ASSERT_EQ(element.IsLastForTile(), i == numElements - 1);
+            }
+        }
+    }
+    ASSERT_EQ(index, tileElements.size());
+}
@@ -11,6 +11,8 @@
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <cstring>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
@@ -114,6 +116,76 @@ TEST_F(SawyerCodingTest, decode_chunk_rotate)
     test_decode(rotatedata, sizeof(rotatedata));
 }
 
+TEST_F(SawyerCodingTest, encode_matches_reference_data)
+{
+    // The encoders must keep producing exactly what the original game did
+    auto test_encode = [](uint8_t encoding, const uint8_t* expected, size_t expectedSize) {
+        sawyercoding_chunk_header header;
+        header.encoding = encoding;
+        header.length = sizeof(randomdata);
+        std::vector<uint8_t> encoded(BUFFER_SIZE);
+        auto encodedSize = sawyercoding_write_chunk_buffer(encoded.data(), randomdata, header);
+        ASSERT_EQ(encodedSize, expectedSize);
+        ASSERT_EQ(std::memcmp(encoded.data(), expected, expectedSize), 0);
+    };
+    test_encode(CHUNK_ENCODING_NONE, nonedata, sizeof(nonedata));
+    test_encode(CHUNK_ENCODING_RLE, rledata, sizeof(rledata));
+    test_encode(CHUNK_ENCODING_RLECOMPRESSED, rlecompresseddata, sizeof(rlecompresseddata));
+    test_encode(CHUNK_ENCODING_ROTATE, rotatedata, sizeof(rotatedata));
+}
+
+TEST_F(SawyerCodingTest, checksum_and_rotate_odd_lengths)
+{
+    for (size_t length = 0; length <= 70; length++)
+    {
+        uint32_t expectedChecksum = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            expectedChecksum += randomdata[i];
+        }
+        ASSERT_EQ(sawyercoding_calculate_checksum(randomdata, length), expectedChecksum);
+
+        std::vector<uint8_t> decoded(length);
+        sawyercoding_decode_rotate(rotatedata + sizeof(sawyercoding_chunk_header), decoded.data(), length);
+        ASSERT_TRUE(std::equal(decoded.begin(), decoded.end(), randomdata));
+    }
+}
+
+TEST_F(SawyerCodingTest, decode_sc4_range)
+{
+    // Big enough to cover the scrambled area of SC4 files, with both repeated and literal runs
+    constexpr size_t length = 0x1F850C;
+    std::vector<uint8_t> original(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        original[i] = (i / 300) % 2 == 0 ? randomdata[i % sizeof(randomdata)] : static_cast<uint8_t>(i / 300);
+    }
+    std::vector<uint8_t> encoded(length * 2);
+    auto encodedLength = sawyercoding_encode_sv4(original.data(), encoded.data(), length);
+
+    std::vector<uint8_t> full(length);
+    ASSERT_EQ(sawyercoding_decode_sv4(encoded.data(), full.data(), encodedLength, length), length);
+    ASSERT_EQ(full, original);
+    ASSERT_EQ(sawyercoding_decode_sc4(encoded.data(), full.data(), encodedLength, length), length);
+
+    for (size_t offset : { size_t(0), size_t(0x199150), size_t(length - 1000) })
+    {
+        std::vector<uint8_t> range(length - offset);
+        auto decodedLength = sawyercoding_decode_sv4_range(encoded.data(), range.data(), encodedLength, offset, range.size());
+        ASSERT_EQ(decodedLength, range.size());
+        ASSERT_TRUE(std::equal(range.begin(), range.end(), original.begin() + offset));
+    }
+
+    // The scrambling works on words from the start of the scrambled area, so SC4 ranges must start on one
+    for (size_t offset : { size_t(0), size_t(0x199150) })
+    {
+        std::vector<uint8_t> range(length - offset);
+        auto decodedLength = sawyercoding_decode_sc4_range(encoded.data(), range.data(), encodedLength, offset, range.size());
+        ASSERT_EQ(decodedLength, range.size());
+        ASSERT_TRUE(std::equal(range.begin(), range.end(), full.begin() + offset));
+    }
+}
+
 TEST_F(SawyerCodingTest, invalid1)
 {
     OpenRCT2::MemoryStream ms(invalid1, sizeof(invalid1));